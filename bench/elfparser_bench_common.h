@@ -0,0 +1,222 @@
+/**
+ * @file elfparser_bench_common.h
+ * @brief Shared helpers for the libelfparser benchmarks
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header provides the small amount of infrastructure shared by the
+ * benchmark programs in bench/: a monotonic clock, a deterministic pseudo
+ * random generator, a builder for synthetic, name-resolved symbol tables and
+ * writers for raw symbol and section header tables in any class/endianness.
+ * It is header-only so every benchmark stays a single translation unit that
+ * is compiled together with the library sources.
+ */
+
+#ifndef _IG_ELFPARSER_BENCH_COMMON_H_
+#define _IG_ELFPARSER_BENCH_COMMON_H_
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../inc_pub/elfparser_symtable.h"
+
+#define BENCH_TABLE_LEN_MAX INT32_MAX /**< Largest table_len accepted in elfparser_symtable_t */
+
+/**
+ * @brief Returns a monotonic timestamp in nanoseconds
+ * @return uint64_t Current time in nanoseconds
+ */
+static inline uint64_t Bench_nowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Advances a xorshift64 generator and returns the next value
+ * @param[in,out] state Generator state, must be non-zero
+ * @return uint64_t Next pseudo random value
+ */
+static inline uint64_t Bench_rand(uint64_t *state)
+{
+    uint64_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+/**
+ * @brief Builds a synthetic symbol table with arena-resolved names
+ *
+ * Names look like mangled C++ identifiers of varying length so hashing and
+ * comparison costs are realistic. Every dup_every-th symbol reuses the name of
+ * an earlier one (0 disables duplicates).
+ *
+ * @param[out] symbol_table Table to populate; release with ElfParser_SymTable_free()
+ * @param[in] sym_num Number of symbols
+ * @param[in] dup_every Duplicate-name period
+ * @return int 0 on success, -1 on allocation failure or if sym_num does not fit table_len
+ */
+static inline int Bench_symTableBuild(elfparser_symtable_t *symbol_table, size_t sym_num, size_t dup_every)
+{
+    uint64_t seed = 0x9E3779B97F4A7C15ull;
+    size_t arena_cap = sym_num * 48 + 1;
+    size_t arena_len = 0;
+
+    if (sym_num > BENCH_TABLE_LEN_MAX)
+    {
+        return -1;
+    }
+    memset(symbol_table, 0, sizeof(*symbol_table));
+    symbol_table->table = calloc(sym_num ? sym_num : 1, sizeof(elfparser_symtable_entry_t));
+    symbol_table->name_arena = malloc(arena_cap);
+    if (!symbol_table->table || !symbol_table->name_arena)
+    {
+        free(symbol_table->table);
+        free(symbol_table->name_arena);
+        return -1;
+    }
+    symbol_table->table_len = sym_num;
+    symbol_table->elf_class = ELFPARSER_HEADER_CLASS_64_BIT;
+    symbol_table->elf_data = ELFPARSER_HEADER_DATA_LITTLE_ENDIANNESS;
+    symbol_table->name_mode = ELFPARSER_NAME_MODE_ARENA;
+    for (size_t i = 0; i < sym_num; i++)
+    {
+        elfparser_symtable_entry_t *entry = &symbol_table->table[i];
+        if (dup_every && i >= dup_every && i % dup_every == 0)
+        {
+            size_t src = Bench_rand(&seed) % i;  // Reuse an earlier name
+            entry->sym_name = symbol_table->table[src].sym_name;
+            entry->sym_name_len = symbol_table->table[src].sym_name_len;
+        }
+        else
+        {
+            char *dst = symbol_table->name_arena + arena_len;
+            int len = snprintf(dst, arena_cap - arena_len, "_ZN%uns%zu%.*sE",
+                               (unsigned)(Bench_rand(&seed) % 90 + 10), i,
+                               (int)(Bench_rand(&seed) % 16), "functionhelperxx");
+            entry->sym_name = dst;
+            entry->sym_name_len = (uint32_t)len;
+            arena_len += (size_t)len + 1;
+        }
+        entry->sym_name_idx = (uint32_t)i;
+        entry->sym_type = ELFPARSER_SYMTABLE_TYPE_FUNC;
+        entry->sym_bind = ELFPARSER_SYMTABLE_BIND_GLOBAL;
+        entry->sym_value = 0x400000u + i * 32u;
+        entry->sym_size = 16u + (i % 16u);
+    }
+    return 0;
+}
+
+/**
+ * @brief Stores an unsigned value with the given width and endianness
+ * @param[out] dst Destination bytes
+ * @param[in] value Value to store
+ * @param[in] size Width in bytes (at most 8)
+ * @param[in] big_endian Non-zero to store big-endian
+ */
+static inline void Bench_store(uint8_t *dst, uint64_t value, size_t size, int big_endian)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        dst[big_endian ? size - 1 - i : i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+/**
+ * @brief Returns the raw size of one symbol table entry
+ * @param[in] is_64bit Non-zero for the 64-bit layout
+ * @return size_t Entry size in bytes
+ */
+static inline size_t Bench_symEntrySize(int is_64bit)
+{
+    return is_64bit ? 24u : 16u;
+}
+
+/**
+ * @brief Returns the raw size of one section header entry
+ * @param[in] is_64bit Non-zero for the 64-bit layout
+ * @return size_t Entry size in bytes
+ */
+static inline size_t Bench_sectEntrySize(int is_64bit)
+{
+    return is_64bit ? 64u : 40u;
+}
+
+/**
+ * @brief Writes raw symbol table entries with varied field values
+ * @param[out] dst Destination buffer of sym_num * Bench_symEntrySize(is_64bit) bytes
+ * @param[in] sym_num Number of entries
+ * @param[in] is_64bit Non-zero for the 64-bit layout
+ * @param[in] big_endian Non-zero for big-endian data
+ * @param[in] name_span st_name values are drawn from [0, name_span)
+ */
+static inline void Bench_rawSymTableFill(uint8_t *dst, size_t sym_num, int is_64bit, int big_endian, uint32_t name_span)
+{
+    uint64_t seed = 0xD1B54A32D192ED03ull;
+    size_t entry_size = Bench_symEntrySize(is_64bit);
+
+    for (size_t i = 0; i < sym_num; i++, dst += entry_size)
+    {
+        uint64_t value = 0x400000u + i * 32u;
+        uint64_t size = Bench_rand(&seed) % 512u;
+        uint8_t info = (uint8_t)(((Bench_rand(&seed) % 3u) << 4) | (Bench_rand(&seed) % 7u));
+        Bench_store(dst, name_span ? Bench_rand(&seed) % name_span : 0, 4, big_endian);  // st_name
+        if (is_64bit)
+        {
+            dst[4] = info;                                          // st_info
+            dst[5] = (uint8_t)(i % 4u);                             // st_other
+            Bench_store(dst + 6, 1u + i % 40u, 2, big_endian);      // st_shndx
+            Bench_store(dst + 8, value, 8, big_endian);             // st_value
+            Bench_store(dst + 16, size, 8, big_endian);             // st_size
+        }
+        else
+        {
+            Bench_store(dst + 4, value, 4, big_endian);             // st_value
+            Bench_store(dst + 8, size, 4, big_endian);              // st_size
+            dst[12] = info;                                         // st_info
+            dst[13] = (uint8_t)(i % 4u);                            // st_other
+            Bench_store(dst + 14, 1u + i % 40u, 2, big_endian);     // st_shndx
+        }
+    }
+}
+
+/**
+ * @brief Writes raw section header entries with varied field values
+ * @param[out] dst Destination buffer of sect_num * Bench_sectEntrySize(is_64bit) bytes
+ * @param[in] sect_num Number of entries
+ * @param[in] is_64bit Non-zero for the 64-bit layout
+ * @param[in] big_endian Non-zero for big-endian data
+ * @param[in] name_span sh_name values are drawn from [0, name_span)
+ */
+static inline void Bench_rawSectHeadFill(uint8_t *dst, size_t sect_num, int is_64bit, int big_endian, uint32_t name_span)
+{
+    uint64_t seed = 0x2545F4914F6CDD1Dull;
+    size_t word = is_64bit ? 8u : 4u;
+    size_t entry_size = Bench_sectEntrySize(is_64bit);
+
+    for (size_t i = 0; i < sect_num; i++, dst += entry_size)
+    {
+        size_t off = 0;
+        Bench_store(dst + off, name_span ? Bench_rand(&seed) % name_span : 0, 4, big_endian); off += 4;  // sh_name
+        Bench_store(dst + off, 1u + i % 11u, 4, big_endian); off += 4;                                  // sh_type
+        Bench_store(dst + off, i % 8u, word, big_endian); off += word;                                  // sh_flags
+        Bench_store(dst + off, 0x400000u + i * 0x1000u, word, big_endian); off += word;                 // sh_addr
+        Bench_store(dst + off, 0x1000u + i * 0x1000u, word, big_endian); off += word;                   // sh_offset
+        Bench_store(dst + off, Bench_rand(&seed) % 0x1000u, word, big_endian); off += word;             // sh_size
+        Bench_store(dst + off, (uint32_t)(i % 7u), 4, big_endian); off += 4;                            // sh_link
+        Bench_store(dst + off, (uint32_t)(i % 5u), 4, big_endian); off += 4;                            // sh_info
+        Bench_store(dst + off, 16u, word, big_endian); off += word;                                      // sh_addralign
+        Bench_store(dst + off, (i % 3u) ? 0u : 24u, word, big_endian);                                  // sh_entsize
+    }
+}
+
+#endif /* _IG_ELFPARSER_BENCH_COMMON_H_ */
@@ -0,0 +1,255 @@
+/**
+ * @file elfparser_bench_decode.c
+ * @brief Benchmark of the per-layout symbol and section header decoders
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * Measures decode throughput (entries per second) of ElfParser_SymTable_parse()
+ * and ElfParser_SectHead_parse() for each of the four class/endianness layouts,
+ * next to the previous generic decoder that walked runtime offset/size tables
+ * and copied every field byte by byte (kept here verbatim as the baseline).
+ * Both decoders' outputs are compared so the numbers are only reported for
+ * identical results.
+ *
+ * Build and run from the repository root:
+ *   cc -O2 -Iinc_pub bench/elfparser_bench_decode.c src/elfparser_*.c -o bench_decode && ./bench_decode
+ */
+
+#include "elfparser_bench_common.h"
+#include "../inc_pub/elfparser_secthead.h"
+#include "../inc_priv/elfparser_symtable_priv.h"
+#include "../inc_priv/elfparser_secthead_priv.h"
+#include "../inc_priv/elfparser_memmanip_priv.h"
+
+#define BENCH_SYM_NUM   60000u  /**< Symbols per table */
+#define BENCH_SECT_NUM  60000u  /**< Section headers per table */
+#define BENCH_ROUNDS    40u     /**< Decodes timed per layout and decoder */
+
+/**
+ * @brief Previous generic symbol decoder, used as the baseline
+ * @param[out] entries Destination array
+ * @param[in] map Raw entries
+ * @param[in] count Number of entries
+ * @param[in] entry_size Raw entry size
+ * @param[in] is_64bit Non-zero for the 64-bit layout
+ * @param[in] big_endian Non-zero for big-endian data
+ */
+static void Bench_legacySymDecode(elfparser_symtable_entry_t *entries, const uint8_t *map, size_t count, size_t entry_size,
+                                  int is_64bit, int big_endian)
+{
+    const uint64_t mem_off_32bit[] = { SYMTABLE_ENTRY_NAMEIDX_OFF, SYMTABLE_ENTRY_INFO_OFF_32BIT, SYMTABLE_ENTRY_OTHER_OFF_32BIT,
+                                       SYMTABLE_ENTRY_SECTIDX_OFF_32BIT, SYMTABLE_ENTRY_VALUE_OFF_32BIT, SYMTABLE_ENTRY_SIZE_OFF_32BIT };
+    const uint64_t mem_off_64bit[] = { SYMTABLE_ENTRY_NAMEIDX_OFF, SYMTABLE_ENTRY_INFO_OFF_64BIT, SYMTABLE_ENTRY_OTHER_OFF_64BIT,
+                                       SYMTABLE_ENTRY_SECTIDX_OFF_64BIT, SYMTABLE_ENTRY_VALUE_OFF_64BIT, SYMTABLE_ENTRY_SIZE_OFF_64BIT };
+    const uint64_t mem_size_32bit[] = { SYMTABLE_ENTRY_NAMEIDX_SIZE, SYMTABLE_ENTRY_INFO_SIZE, SYMTABLE_ENTRY_OTHER_SIZE,
+                                        SYMTABLE_ENTRY_SECTIDX_SIZE, SYMTABLE_ENTRY_VALUE_SIZE_32BIT, SYMTABLE_ENTRY_SIZE_SIZE_32BIT };
+    const uint64_t mem_size_64bit[] = { SYMTABLE_ENTRY_NAMEIDX_SIZE, SYMTABLE_ENTRY_INFO_SIZE, SYMTABLE_ENTRY_OTHER_SIZE,
+                                        SYMTABLE_ENTRY_SECTIDX_SIZE, SYMTABLE_ENTRY_VALUE_SIZE_64BIT, SYMTABLE_ENTRY_SIZE_SIZE_64BIT };
+    const uint64_t *mem_off = is_64bit ? mem_off_64bit : mem_off_32bit;
+    const uint64_t *mem_size = is_64bit ? mem_size_64bit : mem_size_32bit;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        void *const ret_dest[SYMTABLE_ENTRY_LEN] = {
+            &(entries[i].sym_name_idx), &(entries[i].sym_type), &(entries[i].sym_visibility),
+            &(entries[i].sym_sect_idx), &(entries[i].sym_value), &(entries[i].sym_size)
+        };
+        entries[i].sym_name = NULL;
+        for (uint8_t j = 0; j < SYMTABLE_ENTRY_LEN; j++)
+        {
+            size_t offset = i * entry_size + mem_off[j];
+            if (big_endian)
+            {
+                ElfParser_memRevCpy(ret_dest[j], map + offset, mem_size[j]);
+            }
+            else
+            {
+                ElfParser_memCpy(ret_dest[j], map + offset, mem_size[j]);
+            }
+        }
+        entries[i].sym_bind = entries[i].sym_type >> 4u;
+        entries[i].sym_type &= 0x0f;
+    }
+}
+
+/**
+ * @brief Previous generic section header decoder, used as the baseline
+ * @param[out] entries Destination array
+ * @param[in] map Raw entries
+ * @param[in] count Number of entries
+ * @param[in] entry_size Raw entry size
+ * @param[in] is_64bit Non-zero for the 64-bit layout
+ * @param[in] big_endian Non-zero for big-endian data
+ */
+static void Bench_legacySectDecode(elfparser_secthead_entry_t *entries, const uint8_t *map, size_t count, size_t entry_size,
+                                   int is_64bit, int big_endian)
+{
+    const uint64_t mem_off_32bit[] = { SECTHEADER_ENTRY_NAMEIDX_OFF, SECTHEADER_ENTRY_TYPE_OFF, SECTHEADER_ENTRY_FLAGS_OFF,
+                                       SECTHEADER_ENTRY_SECTADDR_OFF_32BIT, SECTHEADER_ENTRY_SECTOFF_OFF_32BIT, SECTHEADER_ENTRY_SECTSIZE_OFF_32BIT,
+                                       SECTHEADER_ENTRY_LINK_OFF_32BIT, SECTHEADER_ENTRY_INFO_OFF_32BIT, SECTHEADER_ENTRY_ADDRALIGN_OFF_32BIT,
+                                       SECTHEADER_ENTRY_ENTRYSIZE_OFF_32BIT };
+    const uint64_t mem_off_64bit[] = { SECTHEADER_ENTRY_NAMEIDX_OFF, SECTHEADER_ENTRY_TYPE_OFF, SECTHEADER_ENTRY_FLAGS_OFF,
+                                       SECTHEADER_ENTRY_SECTADDR_OFF_64BIT, SECTHEADER_ENTRY_SECTOFF_OFF_64BIT, SECTHEADER_ENTRY_SECTSIZE_OFF_64BIT,
+                                       SECTHEADER_ENTRY_LINK_OFF_64BIT, SECTHEADER_ENTRY_INFO_OFF_64BIT, SECTHEADER_ENTRY_ADDRALIGN_OFF_64BIT,
+                                       SECTHEADER_ENTRY_ENTRYSIZE_OFF_64BIT };
+    const uint64_t mem_size_32bit[] = { SECTHEADER_ENTRY_NAMEIDX_SIZE, SECTHEADER_ENTRY_TYPE_SIZE, SECTHEADER_ENTRY_FLAGS_SIZE_32BIT,
+                                        SECTHEADER_ENTRY_SECTADDR_SIZE_32BIT, SECTHEADER_ENTRY_SECTOFF_SIZE_32BIT, SECTHEADER_ENTRY_SECTSIZE_SIZE_32BIT,
+                                        SECTHEADER_ENTRY_LINK_SIZE, SECTHEADER_ENTRY_INFO_SIZE, SECTHEADER_ENTRY_ADDRALIGN_SIZE_32BIT,
+                                        SECTHEADER_ENTRY_ENTRYSIZE_SIZE_32BIT };
+    const uint64_t mem_size_64bit[] = { SECTHEADER_ENTRY_NAMEIDX_SIZE, SECTHEADER_ENTRY_TYPE_SIZE, SECTHEADER_ENTRY_FLAGS_SIZE_64BIT,
+                                        SECTHEADER_ENTRY_SECTADDR_SIZE_64BIT, SECTHEADER_ENTRY_SECTOFF_SIZE_64BIT, SECTHEADER_ENTRY_SECTSIZE_SIZE_64BIT,
+                                        SECTHEADER_ENTRY_LINK_SIZE, SECTHEADER_ENTRY_INFO_SIZE, SECTHEADER_ENTRY_ADDRALIGN_SIZE_64BIT,
+                                        SECTHEADER_ENTRY_ENTRYSIZE_SIZE_64BIT };
+    const uint64_t *mem_off = is_64bit ? mem_off_64bit : mem_off_32bit;
+    const uint64_t *mem_size = is_64bit ? mem_size_64bit : mem_size_32bit;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        void *const ret_dest[SECTHEADER_ENTRY_LEN] = {
+            &(entries[i].sh_name_idx), &(entries[i].sh_type), &(entries[i].sh_flags),
+            &(entries[i].sh_addr), &(entries[i].sh_offset), &(entries[i].sh_size),
+            &(entries[i].sh_link), &(entries[i].sh_info), &(entries[i].sh_addralign),
+            &(entries[i].sh_entsize)
+        };
+        entries[i].sh_name = NULL;
+        for (uint8_t j = 0; j < SECTHEADER_ENTRY_LEN; j++)
+        {
+            size_t offset = i * entry_size + mem_off[j];
+            if (big_endian)
+            {
+                ElfParser_memRevCpy(ret_dest[j], map + offset, mem_size[j]);
+            }
+            else
+            {
+                ElfParser_memCpy(ret_dest[j], map + offset, mem_size[j]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Compares the decoded fields of two symbol tables
+ * @return int 0 if identical
+ */
+static int Bench_symCompare(const elfparser_symtable_entry_t *a, const elfparser_symtable_entry_t *b, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (a[i].sym_name_idx != b[i].sym_name_idx || a[i].sym_bind != b[i].sym_bind || a[i].sym_type != b[i].sym_type ||
+            a[i].sym_visibility != b[i].sym_visibility || a[i].sym_sect_idx != b[i].sym_sect_idx ||
+            a[i].sym_value != b[i].sym_value || a[i].sym_size != b[i].sym_size)
+        {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Compares the decoded fields of two section header tables
+ * @return int 0 if identical
+ */
+static int Bench_sectCompare(const elfparser_secthead_entry_t *a, const elfparser_secthead_entry_t *b, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (a[i].sh_name_idx != b[i].sh_name_idx || a[i].sh_type != b[i].sh_type || a[i].sh_flags != b[i].sh_flags ||
+            a[i].sh_addr != b[i].sh_addr || a[i].sh_offset != b[i].sh_offset || a[i].sh_size != b[i].sh_size ||
+            a[i].sh_link != b[i].sh_link || a[i].sh_info != b[i].sh_info || a[i].sh_addralign != b[i].sh_addralign ||
+            a[i].sh_entsize != b[i].sh_entsize)
+        {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int main(void)
+{
+    static const char *const layout_name[4] = { "32-bit LE", "32-bit BE", "64-bit LE", "64-bit BE" };
+    int status = 0;
+
+    printf("%-10s %-8s %16s %16s %8s\n", "layout", "table", "before_Mentry/s", "after_Mentry/s", "speedup");
+    for (int layout = 0; layout < 4; layout++)
+    {
+        int is_64bit = layout >= 2;
+        int big_endian = layout & 1;
+        size_t sym_entry = Bench_symEntrySize(is_64bit);
+        size_t sect_entry = Bench_sectEntrySize(is_64bit);
+        uint8_t *sym_raw = malloc(BENCH_SYM_NUM * sym_entry);
+        uint8_t *sect_raw = malloc(BENCH_SECT_NUM * sect_entry);
+        elfparser_symtable_entry_t *sym_legacy = calloc(BENCH_SYM_NUM, sizeof(elfparser_symtable_entry_t));
+        elfparser_secthead_entry_t *sect_legacy = calloc(BENCH_SECT_NUM, sizeof(elfparser_secthead_entry_t));
+        elfparser_symtable_t symbol_table = { 0 };
+        elfparser_secthead_t sect_head = { 0 };
+
+        symbol_table.table = calloc(BENCH_SYM_NUM, sizeof(elfparser_symtable_entry_t));
+        symbol_table.table_len = BENCH_SYM_NUM;
+        symbol_table.entry_size = (uint16_t)sym_entry;
+        symbol_table.elf_class = is_64bit ? ELFPARSER_HEADER_CLASS_64_BIT : ELFPARSER_HEADER_CLASS_32_BIT;
+        symbol_table.elf_data = big_endian ? ELFPARSER_HEADER_DATA_BIG_ENDIANNESS : ELFPARSER_HEADER_DATA_LITTLE_ENDIANNESS;
+        sect_head.table = calloc(BENCH_SECT_NUM, sizeof(elfparser_secthead_entry_t));
+        sect_head.table_len = BENCH_SECT_NUM;
+        sect_head.entry_size = (uint16_t)sect_entry;
+        sect_head.elf_class = symbol_table.elf_class;
+        sect_head.elf_data = symbol_table.elf_data;
+        if (!sym_raw || !sect_raw || !sym_legacy || !sect_legacy || !symbol_table.table || !sect_head.table)
+        {
+            fprintf(stderr, "out of memory\n");
+            return 1;
+        }
+        Bench_rawSymTableFill(sym_raw, BENCH_SYM_NUM, is_64bit, big_endian, 1u << 20);
+        Bench_rawSectHeadFill(sect_raw, BENCH_SECT_NUM, is_64bit, big_endian, 1u << 16);
+
+        uint64_t t0 = Bench_nowNs();
+        for (uint32_t r = 0; r < BENCH_ROUNDS; r++)
+        {
+            Bench_legacySymDecode(sym_legacy, sym_raw, BENCH_SYM_NUM, sym_entry, is_64bit, big_endian);
+        }
+        uint64_t before_ns = Bench_nowNs() - t0;
+        t0 = Bench_nowNs();
+        for (uint32_t r = 0; r < BENCH_ROUNDS; r++)
+        {
+            ElfParser_SymTable_parse(&symbol_table, sym_raw, BENCH_SYM_NUM * sym_entry);
+        }
+        uint64_t after_ns = Bench_nowNs() - t0;
+        if (Bench_symCompare(sym_legacy, symbol_table.table, BENCH_SYM_NUM) != 0)
+        {
+            fprintf(stderr, "%s: symbol decoders disagree\n", layout_name[layout]);
+            status = 1;
+        }
+        double entries = (double)BENCH_SYM_NUM * BENCH_ROUNDS;
+        printf("%-10s %-8s %16.1f %16.1f %7.1fx\n", layout_name[layout], "symtab",
+               entries / (before_ns / 1e3), entries / (after_ns / 1e3), (double)before_ns / (double)after_ns);
+
+        t0 = Bench_nowNs();
+        for (uint32_t r = 0; r < BENCH_ROUNDS; r++)
+        {
+            Bench_legacySectDecode(sect_legacy, sect_raw, BENCH_SECT_NUM, sect_entry, is_64bit, big_endian);
+        }
+        before_ns = Bench_nowNs() - t0;
+        t0 = Bench_nowNs();
+        for (uint32_t r = 0; r < BENCH_ROUNDS; r++)
+        {
+            ElfParser_SectHead_parse(&sect_head, sect_raw, BENCH_SECT_NUM * sect_entry);
+        }
+        after_ns = Bench_nowNs() - t0;
+        if (Bench_sectCompare(sect_legacy, sect_head.table, BENCH_SECT_NUM) != 0)
+        {
+            fprintf(stderr, "%s: section header decoders disagree\n", layout_name[layout]);
+            status = 1;
+        }
+        entries = (double)BENCH_SECT_NUM * BENCH_ROUNDS;
+        printf("%-10s %-8s %16.1f %16.1f %7.1fx\n", layout_name[layout], "secthead",
+               entries / (before_ns / 1e3), entries / (after_ns / 1e3), (double)before_ns / (double)after_ns);
+
+        free(sym_raw);
+        free(sect_raw);
+        free(sym_legacy);
+        free(sect_legacy);
+        ElfParser_SymTable_free(&symbol_table);
+        ElfParser_SectHead_free(&sect_head);
+    }
+    return status;
+}
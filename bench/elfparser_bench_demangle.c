@@ -0,0 +1,198 @@
+/**
+ * @file elfparser_bench_demangle.c
+ * @brief Benchmark of bulk C++ symbol demangling
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * For each file given on the command line (libLLVM when it is installed,
+ * this executable otherwise), loads the default symbol table and demangles
+ * all of it: one name at a time with ElfParser_Demangle_name(), which is the
+ * per-name allocating baseline, then in bulk on a fresh demangler with one
+ * thread and with one thread per CPU, and once more on a warm demangler where
+ * every name is a memo hit. Prints nanoseconds per symbol, the number of
+ * distinct mangled names and the arena size, and checks that the threaded run
+ * produced the same names as the single-threaded one. Before any file, a few
+ * names whose c++filt output is known are demangled and compared.
+ *
+ * Build and run from the repository root:
+ *   cc -O2 -pthread -Iinc_pub bench/elfparser_bench_demangle.c src/elfparser_*.c -o bench_demangle && ./bench_demangle [elf files...]
+ */
+
+#include "elfparser_bench_common.h"
+#include <unistd.h>
+#include "../inc_pub/elfparser_file.h"
+#include "../inc_pub/elfparser_demangle.h"
+
+#define BENCH_RUN_NUM   5       /**< Timed repetitions per measurement */
+#define BENCH_OUT_SIZE  (1u << 16) /**< Output buffer of the per-name baseline */
+
+/**
+ * @brief Mangled names and their c++filt output
+ */
+static const struct
+{
+    const char* mangled;    /**< Input */
+    const char* expected;   /**< Output of c++filt */
+} Bench_known[] =
+{
+    { "_ZN4llvm10checkedAddIiEENSt9enable_ifIXsr3std9is_signedIT_EE5valueENS_8OptionalIS2_EEE4typeES2_S2_",
+      "std::enable_if<std::is_signed<int>::value, llvm::Optional<int> >::type llvm::checkedAdd<int>(int, int)" },
+    { "_ZN5boost8functionIFvRKNS_5debug16dbg_startup_infoEEEaSIPS5_EENS_10enable_if_IXntsrNS_11is_integralIT_EE5valueERS6_E4typeESB_",
+      "boost::enable_if_<!boost::is_integral<void (*)(boost::debug::dbg_startup_info const&)>::value, "
+      "boost::function<void (boost::debug::dbg_startup_info const&)>&>::type "
+      "boost::function<void (boost::debug::dbg_startup_info const&)>::operator=<void (*)(boost::debug::dbg_startup_info const&)>"
+      "(void (*)(boost::debug::dbg_startup_info const&))" },  // Prefixes of an srN name are substitution candidates
+};
+
+/**
+ * @brief Demangles the names of Bench_known and compares them with c++filt
+ * @return int 0 if all match, 1 otherwise
+ */
+static int Bench_knownCheck(void)
+{
+    static char out[BENCH_OUT_SIZE];
+    int ret = 0;
+
+    for (size_t i = 0; i < sizeof(Bench_known) / sizeof(Bench_known[0]); i++)
+    {
+        if (ElfParser_Demangle_name(Bench_known[i].mangled, out, sizeof(out), NULL) != ELFPARSER_SUCCESS ||
+            strcmp(out, Bench_known[i].expected) != 0)
+        {
+            fprintf(stderr, "%s:\n  got      %s\n  expected %s\n", Bench_known[i].mangled, out, Bench_known[i].expected);
+            ret = 1;
+        }
+    }
+    return ret;
+}
+
+/**
+ * @brief Times one symbol table
+ * @param[in] table Pointer to a loaded symbol table
+ * @param[out] names Array of table_len names
+ * @param[out] names_mt Array of table_len names for the threaded run
+ * @return int 0 on success, 1 if demangling fails or the threaded run disagrees
+ */
+static int Bench_tableTime(const elfparser_symtable_t *table, const char **names, const char **names_mt)
+{
+    static char out[BENCH_OUT_SIZE];
+    elfparser_demangle_t demangle;
+    elfparser_demangle_t demangle_mt;
+    uint64_t naive_ns = UINT64_MAX;
+    uint64_t cold_ns = UINT64_MAX;
+    uint64_t cold_mt_ns = UINT64_MAX;
+    uint64_t warm_ns = UINT64_MAX;
+    size_t mangled_num = 0;
+    int ret = 0;
+
+    for (uint32_t i = 0; i < table->table_len; i++)
+    {
+        const char *name = table->table[i].sym_name;
+        mangled_num += (name && name[0] == '_' && name[1] == 'Z');
+    }
+    for (int run = 0; run < BENCH_RUN_NUM; run++)
+    {
+        uint64_t t0 = Bench_nowNs();
+        for (uint32_t i = 0; i < table->table_len; i++)
+        {
+            const char *name = table->table[i].sym_name;
+            if (name && name[0] == '_' && name[1] == 'Z')
+            {
+                (void)ElfParser_Demangle_name(name, out, sizeof(out), NULL);
+            }
+        }
+        uint64_t t1 = Bench_nowNs();
+        naive_ns = (t1 - t0 < naive_ns) ? t1 - t0 : naive_ns;
+    }
+    for (int run = 0; run < BENCH_RUN_NUM && ret == 0; run++)
+    {
+        if (run)
+        {
+            ElfParser_Demangle_free(&demangle);
+            ElfParser_Demangle_free(&demangle_mt);
+        }
+        if (ElfParser_Demangle_init(&demangle) != ELFPARSER_SUCCESS)
+        {
+            return 1;
+        }
+        if (ElfParser_Demangle_init(&demangle_mt) != ELFPARSER_SUCCESS)
+        {
+            ElfParser_Demangle_free(&demangle);
+            return 1;
+        }
+        uint64_t t0 = Bench_nowNs();
+        ret |= (ElfParser_Demangle_symTable(&demangle, table, 1, names) != ELFPARSER_SUCCESS);
+        uint64_t t1 = Bench_nowNs();
+        ret |= (ElfParser_Demangle_symTable(&demangle_mt, table, 0, names_mt) != ELFPARSER_SUCCESS);
+        uint64_t t2 = Bench_nowNs();
+        ret |= (ElfParser_Demangle_symTable(&demangle, table, 1, names) != ELFPARSER_SUCCESS);
+        uint64_t t3 = Bench_nowNs();
+        cold_ns = (t1 - t0 < cold_ns) ? t1 - t0 : cold_ns;
+        cold_mt_ns = (t2 - t1 < cold_mt_ns) ? t2 - t1 : cold_mt_ns;
+        warm_ns = (t3 - t2 < warm_ns) ? t3 - t2 : warm_ns;
+    }
+    for (uint32_t i = 0; i < table->table_len && ret == 0; i++)
+    {
+        ret |= (strcmp(names[i], names_mt[i]) != 0);
+    }
+
+    double sym_num = (double)(table->table_len ? table->table_len : 1);
+    printf("symbols %" PRIu32 ", mangled %zu, distinct %" PRIu32 ", demangled %" PRIu64 ", failed %" PRIu64 ", arena %zu KiB\n",
+           table->table_len, mangled_num, demangle.entry_num, demangle.stats.demangled, demangle.stats.failed,
+           demangle.arena_size >> 10);
+    printf("%-22s %10s %10s\n", "mode", "ms", "ns/sym");
+    printf("%-22s %10.2f %10.1f\n", "per name", (double)naive_ns / 1e6, (double)naive_ns / sym_num);
+    printf("%-22s %10.2f %10.1f\n", "bulk cold, 1 thread", (double)cold_ns / 1e6, (double)cold_ns / sym_num);
+    printf("%-22s %10.2f %10.1f\n", "bulk cold, all CPUs", (double)cold_mt_ns / 1e6, (double)cold_mt_ns / sym_num);
+    printf("%-22s %10.2f %10.1f\n", "bulk warm (memo)", (double)warm_ns / 1e6, (double)warm_ns / sym_num);
+    ElfParser_Demangle_free(&demangle);
+    ElfParser_Demangle_free(&demangle_mt);
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    const char *llvm[] = { "/usr/lib/x86_64-linux-gnu/libLLVM-15.so.1" };
+    const char *self[] = { "/proc/self/exe" };
+    const char **paths = (argc > 1) ? (const char **)&argv[1] : (access(llvm[0], R_OK) == 0) ? llvm : self;
+    int path_num = (argc > 1) ? argc - 1 : 1;
+    int ret = Bench_knownCheck();
+
+    for (int i = 0; i < path_num; i++)
+    {
+        elfparser_file_t file;
+        elfparser_symtable_t table;
+        uint32_t sym_sect_idx;
+        if (ElfParser_File_open(&file, paths[i], ELFPARSER_FILE_FLAG_POPULATE) != ELFPARSER_SUCCESS)
+        {
+            fprintf(stderr, "%s: cannot open\n", paths[i]);
+            ret = 1;
+            continue;
+        }
+        if (ElfParser_File_symTableDefaultLoad(&file, &table, &sym_sect_idx) != ELFPARSER_SUCCESS)
+        {
+            fprintf(stderr, "%s: no symbol table\n", paths[i]);
+            ElfParser_File_close(&file);
+            ret = 1;
+            continue;
+        }
+        const char **names = malloc(((size_t)table.table_len ? table.table_len : 1) * sizeof(const char *));
+        const char **names_mt = malloc(((size_t)table.table_len ? table.table_len : 1) * sizeof(const char *));
+        printf("%s\n", paths[i]);
+        if (!names || !names_mt)
+        {
+            fprintf(stderr, "%s: out of memory\n", paths[i]);
+            ret = 1;
+        }
+        else if (Bench_tableTime(&table, names, names_mt))
+        {
+            fprintf(stderr, "%s: demangling failed or threaded results differ\n", paths[i]);
+            ret = 1;
+        }
+        free(names);
+        free(names_mt);
+        ElfParser_SymTable_free(&table);
+        ElfParser_File_close(&file);
+    }
+    return ret;
+}
@@ -0,0 +1,204 @@
+/**
+ * @file elfparser_bench_dwarfline.c
+ * @brief Benchmark of lazy DWARF line table lookups
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * For each file given on the command line (this executable by default, which
+ * needs -g), draws pseudo random addresses inside the function symbols of the
+ * file, then times ElfParser_DwarfLine_open(), a small batch on a fresh
+ * structure (only the units it touches get decoded), a full batch on a fresh
+ * structure, the same full batch again once everything is decoded, the batch
+ * sorted by address (the previous-hit path) and a loop of single lookups.
+ * Prints nanoseconds per address and how many units each batch had to decode.
+ *
+ * Build and run from the repository root:
+ *   cc -O2 -g -pthread -Iinc_pub bench/elfparser_bench_dwarfline.c src/elfparser_*.c -o bench_dwarfline && ./bench_dwarfline [elf files...]
+ */
+
+#include "elfparser_bench_common.h"
+#include "../inc_pub/elfparser_file.h"
+#include "../inc_pub/elfparser_dwarfline.h"
+
+#define BENCH_ADDR_NUM  100000 /**< Addresses per full batch */
+#define BENCH_SMALL_NUM 16     /**< Addresses per small batch */
+#define BENCH_RUN_NUM   7      /**< Timed repetitions per measurement */
+
+/**
+ * @brief Draws addresses inside the function symbols of a file
+ * @param[in,out] file Pointer to an open file structure
+ * @param[out] addrs Array of BENCH_ADDR_NUM addresses to fill
+ * @return int 0 on success, 1 if the file has no sized function symbols
+ */
+static int Bench_addrsDraw(elfparser_file_t *file, uint64_t *addrs)
+{
+    elfparser_symtable_t table;
+    uint32_t sym_sect_idx;
+    uint32_t func_num = 0;
+    uint64_t seed = 0x9E3779B97F4A7C15ull;
+
+    if (ElfParser_File_symTableDefaultLoad(file, &table, &sym_sect_idx) != ELFPARSER_SUCCESS)
+    {
+        return 1;
+    }
+    uint32_t *funcs = malloc(((size_t)table.table_len ? table.table_len : 1) * sizeof(uint32_t));
+    for (uint32_t i = 0; funcs && i < table.table_len; i++)
+    {
+        if (table.table[i].sym_type == ELFPARSER_SYMTABLE_TYPE_FUNC && table.table[i].sym_size)
+        {
+            funcs[func_num++] = i;
+        }
+    }
+    for (size_t i = 0; func_num && i < BENCH_ADDR_NUM; i++)
+    {
+        const elfparser_symtable_entry_t *sym = &table.table[funcs[Bench_rand(&seed) % func_num]];
+        addrs[i] = sym->sym_value + Bench_rand(&seed) % sym->sym_size;
+    }
+    free(funcs);
+    ElfParser_SymTable_free(&table);
+    return func_num ? 0 : 1;
+}
+
+/**
+ * @brief Orders addresses for qsort()
+ * @param[in] lhs First address
+ * @param[in] rhs Second address
+ * @return int Negative, zero or positive as for qsort()
+ */
+static int Bench_addrCompare(const void *lhs, const void *rhs)
+{
+    uint64_t a = *(const uint64_t *)lhs;
+    uint64_t b = *(const uint64_t *)rhs;
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief Times one file
+ * @param[in,out] file Pointer to an open file structure
+ * @param[in] addrs Array of BENCH_ADDR_NUM addresses
+ * @param[in] sorted The same addresses in ascending order
+ * @param[out] locs Array of BENCH_ADDR_NUM locations
+ * @param[out] status Array of BENCH_ADDR_NUM statuses
+ * @return int 0 on success, 1 if the line tables cannot be opened or looked up
+ */
+static int Bench_fileTime(elfparser_file_t *file, const uint64_t *addrs, const uint64_t *sorted, elfparser_dwarfline_loc_t *locs,
+                          int *status)
+{
+    uint64_t open_ns = UINT64_MAX;
+    uint64_t small_ns = UINT64_MAX;
+    uint64_t cold_ns = UINT64_MAX;
+    uint64_t warm_ns = UINT64_MAX;
+    uint64_t sorted_ns = UINT64_MAX;
+    uint64_t single_ns = UINT64_MAX;
+    uint32_t small_units = 0;
+    uint32_t cold_units = 0;
+    uint32_t unit_num = 0;
+    size_t found = 0;
+
+    for (int run = 0; run < BENCH_RUN_NUM; run++)
+    {
+        elfparser_dwarfline_t dwarf_line;
+        uint64_t t0 = Bench_nowNs();
+        if (ElfParser_DwarfLine_open(&dwarf_line, file) != ELFPARSER_SUCCESS)
+        {
+            return 1;
+        }
+        uint64_t t1 = Bench_nowNs();
+        int ret = ElfParser_DwarfLine_batchLookup(&dwarf_line, addrs, BENCH_SMALL_NUM, locs, status);
+        uint64_t t2 = Bench_nowNs();
+        small_units = dwarf_line.decoded_num;
+        ElfParser_DwarfLine_close(&dwarf_line);
+        if (ret != ELFPARSER_SUCCESS || ElfParser_DwarfLine_open(&dwarf_line, file) != ELFPARSER_SUCCESS)
+        {
+            return 1;
+        }
+        uint64_t t3 = Bench_nowNs();
+        ret = ElfParser_DwarfLine_batchLookup(&dwarf_line, addrs, BENCH_ADDR_NUM, locs, status);
+        uint64_t t4 = Bench_nowNs();
+        cold_units = dwarf_line.decoded_num;
+        ret = (ret == ELFPARSER_SUCCESS) ? ElfParser_DwarfLine_batchLookup(&dwarf_line, addrs, BENCH_ADDR_NUM, locs, status) : ret;
+        uint64_t t5 = Bench_nowNs();
+        ret = (ret == ELFPARSER_SUCCESS) ? ElfParser_DwarfLine_batchLookup(&dwarf_line, sorted, BENCH_ADDR_NUM, locs, status) : ret;
+        uint64_t t6 = Bench_nowNs();
+        for (size_t i = 0; i < BENCH_ADDR_NUM && ret == ELFPARSER_SUCCESS; i++)
+        {
+            (void)ElfParser_DwarfLine_lookup(&dwarf_line, addrs[i], &locs[i]);
+        }
+        uint64_t t7 = Bench_nowNs();
+        unit_num = dwarf_line.unit_num;
+        ElfParser_DwarfLine_close(&dwarf_line);
+        if (ret != ELFPARSER_SUCCESS)
+        {
+            return 1;
+        }
+        open_ns = (t1 - t0 < open_ns) ? t1 - t0 : open_ns;
+        small_ns = (t2 - t1 < small_ns) ? t2 - t1 : small_ns;
+        cold_ns = (t4 - t3 < cold_ns) ? t4 - t3 : cold_ns;
+        warm_ns = (t5 - t4 < warm_ns) ? t5 - t4 : warm_ns;
+        sorted_ns = (t6 - t5 < sorted_ns) ? t6 - t5 : sorted_ns;
+        single_ns = (t7 - t6 < single_ns) ? t7 - t6 : single_ns;
+    }
+    for (size_t i = 0; i < BENCH_ADDR_NUM; i++)
+    {
+        found += (status[i] == ELFPARSER_SUCCESS);
+    }
+    printf("open %.1f us, units %" PRIu32 "\n", (double)open_ns / 1e3, unit_num);
+    printf("%-14s %10s %10s %10s\n", "batch", "addrs", "ns/addr", "decoded");
+    printf("%-14s %10d %10.1f %10" PRIu32 "\n", "small cold", BENCH_SMALL_NUM, (double)small_ns / BENCH_SMALL_NUM, small_units);
+    printf("%-14s %10d %10.1f %10" PRIu32 "\n", "full cold", BENCH_ADDR_NUM, (double)cold_ns / BENCH_ADDR_NUM, cold_units);
+    printf("%-14s %10d %10.1f %10s\n", "full warm", BENCH_ADDR_NUM, (double)warm_ns / BENCH_ADDR_NUM, "-");
+    printf("%-14s %10d %10.1f %10s\n", "sorted warm", BENCH_ADDR_NUM, (double)sorted_ns / BENCH_ADDR_NUM, "-");
+    printf("%-14s %10d %10.1f %10s\n", "single warm", BENCH_ADDR_NUM, (double)single_ns / BENCH_ADDR_NUM, "-");
+    printf("resolved %zu of %d\n", found, BENCH_ADDR_NUM);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    const char *self[] = { "/proc/self/exe" };
+    const char **paths = (argc > 1) ? (const char **)&argv[1] : self;
+    int path_num = (argc > 1) ? argc - 1 : 1;
+    uint64_t *addrs = malloc(BENCH_ADDR_NUM * sizeof(uint64_t));
+    uint64_t *sorted = malloc(BENCH_ADDR_NUM * sizeof(uint64_t));
+    elfparser_dwarfline_loc_t *locs = malloc(BENCH_ADDR_NUM * sizeof(elfparser_dwarfline_loc_t));
+    int *status = malloc(BENCH_ADDR_NUM * sizeof(int));
+    int ret = 0;
+
+    if (!addrs || !sorted || !locs || !status)
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    for (int i = 0; i < path_num; i++)
+    {
+        elfparser_file_t file;
+        if (ElfParser_File_open(&file, paths[i], ELFPARSER_FILE_FLAG_POPULATE) != ELFPARSER_SUCCESS)
+        {
+            fprintf(stderr, "%s: cannot open\n", paths[i]);
+            ret = 1;
+            continue;
+        }
+        printf("%s\n", paths[i]);
+        if (Bench_addrsDraw(&file, addrs))
+        {
+            fprintf(stderr, "%s: no function symbols\n", paths[i]);
+            ElfParser_File_close(&file);
+            ret = 1;
+            continue;
+        }
+        memcpy(sorted, addrs, BENCH_ADDR_NUM * sizeof(uint64_t));
+        qsort(sorted, BENCH_ADDR_NUM, sizeof(uint64_t), Bench_addrCompare);
+        if (Bench_fileTime(&file, addrs, sorted, locs, status))
+        {
+            fprintf(stderr, "%s: no usable .debug_line\n", paths[i]);
+            ret = 1;
+        }
+        ElfParser_File_close(&file);
+    }
+    free(addrs);
+    free(sorted);
+    free(locs);
+    free(status);
+    return ret;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file elfparser_bench_scale.c
+ * @brief Benchmark of parse and index costs from 10k to 10M symbols
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * Measures per-symbol cost of ElfParser_SymTable_parse(), ElfParser_SymIndex_build()
+ * and ElfParser_AddrIndex_build(), and per-lookup cost of the two indices, on
+ * synthetic 64-bit tables of 10k, 100k, 1M and 10M symbols. Flat per-symbol
+ * columns mean the work grows linearly with the table size; lookups may rise
+ * slowly once the index no longer fits the caches.
+ *
+ * Build and run from the repository root:
+ *   cc -O2 -pthread -Iinc_pub bench/elfparser_bench_scale.c src/elfparser_*.c -o bench_scale && ./bench_scale
+ */
+
+#include "elfparser_bench_common.h"
+#include "../inc_pub/elfparser_symindex.h"
+#include "../inc_pub/elfparser_addrindex.h"
+
+#define BENCH_LOOKUPS       1000000u    /**< Lookups timed per index */
+#define BENCH_NAME_SPAN     (1u << 24)  /**< st_name values of the raw table are drawn below this */
+
+int main(void)
+{
+    const size_t sizes[] = { 10000u, 100000u, 1000000u, 10000000u };
+    size_t entry_size = Bench_symEntrySize(1);
+
+    printf("%10s %14s %14s %14s %14s %14s\n", "symbols", "parse_ns/sym", "symidx_ns/sym",
+           "name_ns/op", "addridx_ns/sym", "addr_ns/op");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+    {
+        size_t sym_num = sizes[s];
+        uint64_t seed = 7;
+        volatile int64_t sink = 0;
+
+        /* Raw decode */
+        uint8_t *raw = malloc(sym_num * entry_size);
+        elfparser_symtable_t parsed = { 0 };
+        parsed.table = malloc(sym_num * sizeof(elfparser_symtable_entry_t));
+        if (!raw || !parsed.table)
+        {
+            fprintf(stderr, "out of memory\n");
+            return 1;
+        }
+        Bench_rawSymTableFill(raw, sym_num, 1, 0, BENCH_NAME_SPAN);
+        parsed.table_len = (uint32_t)sym_num;
+        parsed.entry_size = (uint16_t)entry_size;
+        parsed.elf_class = ELFPARSER_HEADER_CLASS_64_BIT;
+        parsed.elf_data = ELFPARSER_HEADER_DATA_LITTLE_ENDIANNESS;
+        uint64_t t0 = Bench_nowNs();
+        if (ElfParser_SymTable_parse(&parsed, raw, sym_num * entry_size) != ELFPARSER_SUCCESS)
+        {
+            fprintf(stderr, "parse failed\n");
+            return 1;
+        }
+        double parse_ns = (double)(Bench_nowNs() - t0) / (double)sym_num;
+        free(raw);
+        ElfParser_SymTable_free(&parsed);
+
+        /* Name and address indices */
+        elfparser_symtable_t symbol_table;
+        elfparser_symindex_t symbol_index;
+        elfparser_addrindex_t addr_index;
+        if (Bench_symTableBuild(&symbol_table, sym_num, 20) != 0)
+        {
+            fprintf(stderr, "out of memory\n");
+            return 1;
+        }
+        t0 = Bench_nowNs();
+        if (ElfParser_SymIndex_build(&symbol_index, &symbol_table) != ELFPARSER_SUCCESS)
+        {
+            fprintf(stderr, "symbol index build failed\n");
+            return 1;
+        }
+        double symidx_ns = (double)(Bench_nowNs() - t0) / (double)sym_num;
+        t0 = Bench_nowNs();
+        for (uint32_t q = 0; q < BENCH_LOOKUPS; q++)
+        {
+            sink += ElfParser_SymIndex_byNameFind(&symbol_index, symbol_table.table[Bench_rand(&seed) % sym_num].sym_name, 0);
+        }
+        double name_ns = (double)(Bench_nowNs() - t0) / BENCH_LOOKUPS;
+
+        t0 = Bench_nowNs();
+        if (ElfParser_AddrIndex_build(&addr_index, &symbol_table) != ELFPARSER_SUCCESS)
+        {
+            fprintf(stderr, "address index build failed\n");
+            return 1;
+        }
+        double addridx_ns = (double)(Bench_nowNs() - t0) / (double)sym_num;
+        t0 = Bench_nowNs();
+        for (uint32_t q = 0; q < BENCH_LOOKUPS; q++)
+        {
+            sink += ElfParser_AddrIndex_lookup(&addr_index, 0x400000u + Bench_rand(&seed) % (sym_num * 32u));
+        }
+        double addr_ns = (double)(Bench_nowNs() - t0) / BENCH_LOOKUPS;
+
+        printf("%10zu %14.2f %14.2f %14.1f %14.2f %14.1f\n", sym_num, parse_ns, symidx_ns, name_ns, addridx_ns, addr_ns);
+        (void)sink;
+        ElfParser_AddrIndex_free(&addr_index);
+        ElfParser_SymIndex_free(&symbol_index);
+        ElfParser_SymTable_free(&symbol_table);
+    }
+    return 0;
+}
@@ -0,0 +1,212 @@
+/**
+ * @file elfparser_bench_sectcache.c
+ * @brief Benchmark of the decompressed section cache
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * For each file given on the command line (this executable by default, which
+ * needs compressed debug sections, hence -gz), times every SHF_COMPRESSED
+ * section twice: a get from an empty cache, which decompresses, and a get and
+ * release on a warm cache, which is the hit path. Then several threads, each
+ * with its own file handle, ask a cold cache for the largest section at once
+ * and the counters show how many of them decompressed it.
+ *
+ * Build and run from the repository root:
+ *   cc -O2 -g -gz=zlib -pthread -DELFPARSER_WITH_ZLIB -Iinc_pub bench/elfparser_bench_sectcache.c src/elfparser_*.c -lz -o bench_sectcache && ./bench_sectcache [elf files...]
+ */
+
+#include "elfparser_bench_common.h"
+#include <pthread.h>
+#include "../inc_pub/elfparser_file.h"
+#include "../inc_pub/elfparser_sectcache.h"
+
+#define BENCH_RUN_NUM       9        /**< Timed repetitions of the cold get */
+#define BENCH_HIT_NUM       100000   /**< Get and release pairs timed on the warm cache */
+#define BENCH_THREAD_NUM    4        /**< Threads racing for the same cold section */
+#define BENCH_CAPACITY      (256u << 20) /**< Cache capacity in bytes */
+
+/**
+ * @brief Work of one racing thread
+ */
+typedef struct bench_race_s
+{
+    elfparser_sectcache_t*  cache;      /**< Shared cache */
+    const char*             path;       /**< File to open a private handle on */
+    uint32_t                sect_idx;   /**< Section all threads ask for */
+    pthread_barrier_t*      start;      /**< Lines the threads up */
+    int                     ret;        /**< Result of the get */
+} bench_race_t;
+
+/**
+ * @brief Opens a private handle and gets the section once the others are ready
+ * @param[in,out] arg Pointer to the bench_race_t of this thread
+ * @return void* NULL
+ */
+static void *Bench_raceRun(void *arg)
+{
+    bench_race_t *race = arg;
+    elfparser_file_t file;
+    const elfparser_secthead_t *sect_head;
+    const void *data;
+    size_t size;
+
+    race->ret = ElfParser_File_open(&file, race->path, ELFPARSER_FILE_FLAG_POPULATE);
+    if (race->ret == ELFPARSER_SUCCESS)
+    {
+        race->ret = ElfParser_File_sectHeadGet(&file, &sect_head);  // Parsed before the race
+    }
+    pthread_barrier_wait(race->start);
+    if (race->ret == ELFPARSER_SUCCESS)
+    {
+        race->ret = ElfParser_SectCache_get(race->cache, &file, race->sect_idx, &data, &size);
+        if (race->ret == ELFPARSER_SUCCESS)
+        {
+            ElfParser_SectCache_release(race->cache, data);
+        }
+    }
+    if (file.reader.file_size)
+    {
+        ElfParser_File_close(&file);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Races several threads for one section of a cold cache
+ * @param[in] path File to open
+ * @param[in] sect_idx Section all threads ask for
+ * @return int 0 on success, 1 if a thread failed
+ */
+static int Bench_race(const char *path, uint32_t sect_idx)
+{
+    elfparser_sectcache_t cache;
+    elfparser_sectcache_stats_t stats;
+    pthread_barrier_t start;
+    pthread_t threads[BENCH_THREAD_NUM];
+    bench_race_t races[BENCH_THREAD_NUM];
+    int ret = 0;
+
+    ElfParser_SectCache_init(&cache, BENCH_CAPACITY);
+    pthread_barrier_init(&start, NULL, BENCH_THREAD_NUM);
+    for (int t = 0; t < BENCH_THREAD_NUM; t++)
+    {
+        races[t] = (bench_race_t){ &cache, path, sect_idx, &start, 0 };
+        pthread_create(&threads[t], NULL, Bench_raceRun, &races[t]);
+    }
+    for (int t = 0; t < BENCH_THREAD_NUM; t++)
+    {
+        pthread_join(threads[t], NULL);
+        ret |= (races[t].ret != ELFPARSER_SUCCESS);
+    }
+    ElfParser_SectCache_statsGet(&cache, &stats);
+    printf("%d threads on a cold section: %" PRIu64 " decompressed, %" PRIu64 " waited, %" PRIu64 " hit\n",
+           BENCH_THREAD_NUM, stats.misses, stats.waits, stats.hits);
+    pthread_barrier_destroy(&start);
+    ElfParser_SectCache_free(&cache);
+    return ret;
+}
+
+/**
+ * @brief Times the cold and warm paths of one compressed section
+ * @param[in,out] file Pointer to an open file structure
+ * @param[in] sect_head Pointer to the section headers of the file
+ * @param[in] sect_idx Index of the section
+ * @return int 0 on success, 1 if the section cannot be decompressed
+ */
+static int Bench_sectTime(elfparser_file_t *file, const elfparser_secthead_t *sect_head, uint32_t sect_idx)
+{
+    elfparser_sectcache_t cache;
+    const void *data;
+    size_t size = 0;
+    uint64_t cold_ns = UINT64_MAX;
+
+    for (int run = 0; run < BENCH_RUN_NUM; run++)
+    {
+        ElfParser_SectCache_init(&cache, BENCH_CAPACITY);
+        uint64_t t0 = Bench_nowNs();
+        int ret = ElfParser_SectCache_get(&cache, file, sect_idx, &data, &size);
+        uint64_t t1 = Bench_nowNs();
+        if (ret == ELFPARSER_SUCCESS)
+        {
+            ElfParser_SectCache_release(&cache, data);
+        }
+        ElfParser_SectCache_free(&cache);
+        if (ret != ELFPARSER_SUCCESS)
+        {
+            return 1;
+        }
+        cold_ns = (t1 - t0 < cold_ns) ? t1 - t0 : cold_ns;
+    }
+
+    ElfParser_SectCache_init(&cache, BENCH_CAPACITY);
+    ElfParser_SectCache_get(&cache, file, sect_idx, &data, &size);
+    ElfParser_SectCache_release(&cache, data);  // Warm and unpinned
+    uint64_t t0 = Bench_nowNs();
+    for (int i = 0; i < BENCH_HIT_NUM; i++)
+    {
+        ElfParser_SectCache_get(&cache, file, sect_idx, &data, &size);
+        ElfParser_SectCache_release(&cache, data);
+    }
+    uint64_t hit_ns = (Bench_nowNs() - t0) / BENCH_HIT_NUM;
+    ElfParser_SectCache_free(&cache);
+
+    printf("%-20s %10" PRIu64 " %10zu %12.1f %10" PRIu64 " %10.0fx\n", sect_head->table[sect_idx].sh_name,
+           sect_head->table[sect_idx].sh_size, size, (double)cold_ns / 1e3, hit_ns, (double)cold_ns / (double)(hit_ns ? hit_ns : 1));
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    const char *self[] = { "/proc/self/exe" };
+    const char **paths = (argc > 1) ? (const char **)&argv[1] : self;
+    int path_num = (argc > 1) ? argc - 1 : 1;
+    int ret = 0;
+
+    for (int i = 0; i < path_num; i++)
+    {
+        elfparser_file_t file;
+        const elfparser_secthead_t *sect_head;
+        if (ElfParser_File_open(&file, paths[i], ELFPARSER_FILE_FLAG_POPULATE) != ELFPARSER_SUCCESS)
+        {
+            fprintf(stderr, "%s: cannot open\n", paths[i]);
+            ret = 1;
+            continue;
+        }
+        if (ElfParser_File_sectHeadGet(&file, &sect_head) != ELFPARSER_SUCCESS)
+        {
+            fprintf(stderr, "%s: no section headers\n", paths[i]);
+            ElfParser_File_close(&file);
+            ret = 1;
+            continue;
+        }
+        printf("%s\n%-20s %10s %10s %12s %10s %11s\n", paths[i], "section", "packed", "size", "decomp_us", "hit_ns", "speedup");
+        uint32_t largest = UINT32_MAX;
+        for (uint32_t s = 0; s < sect_head->table_len; s++)
+        {
+            if (!(sect_head->table[s].sh_flags & ELFPARSER_SECTHEAD_FLAG_COMPRESSED))
+            {
+                continue;
+            }
+            if (Bench_sectTime(&file, sect_head, s))
+            {
+                fprintf(stderr, "%s: section %" PRIu32 " cannot be decompressed\n", paths[i], s);
+                ret = 1;
+                continue;
+            }
+            largest = (largest == UINT32_MAX || sect_head->table[s].sh_size > sect_head->table[largest].sh_size) ? s : largest;
+        }
+        ElfParser_File_close(&file);
+        if (largest == UINT32_MAX)
+        {
+            fprintf(stderr, "%s: no compressed sections\n", paths[i]);
+            ret = 1;
+        }
+        else if (Bench_race(paths[i], largest))
+        {
+            fprintf(stderr, "%s: a racing thread failed\n", paths[i]);
+            ret = 1;
+        }
+    }
+    return ret;
+}
@@ -0,0 +1,555 @@
+/**
+ * @file elfparser_bench_stages.c
+ * @brief Per-stage microbenchmark of the parse pipeline with JSON output
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * Times each parse stage on its own: ElfParser_Header_identParse() with
+ * ElfParser_Header_parse(), section header setup, parse and name resolve,
+ * symbol table setup, parse and name resolve, and the linear
+ * ElfParser_SectHead_byNameFind() and ElfParser_SymTable_byNameFind() lookups. Every stage runs on synthetic in-memory ELF images with small,
+ * medium and huge section and symbol tables in all four class/endianness
+ * combinations; the huge images have more than 0xff00 sections, so the
+ * header stage also covers extended numbering.
+ *
+ * Each case runs in its own forked process, so the reported peak RSS belongs
+ * to that case alone (it includes the input image). Allocations are counted
+ * by wrapping malloc, calloc and realloc at link time; without the --wrap
+ * flags below allocs_per_entry is reported as null. For the lookup stages an
+ * entry is one table entry compared, ns_per_op is the time of one lookup.
+ * The result is a single JSON document on stdout, meant to be stored per
+ * commit and compared.
+ *
+ * Build and run from the repository root:
+ *   cc -O2 -pthread -Iinc_pub -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc bench/elfparser_bench_stages.c src/elfparser_*.c -o bench_stages && ./bench_stages > stages.json
+ */
+
+#include "elfparser_bench_common.h"
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "../inc_pub/elfparser_header.h"
+#include "../inc_pub/elfparser_secthead.h"
+
+#define BENCH_RUN_NUM       5u          /**< Timed repetitions per case, the best one is reported */
+#define BENCH_BATCH_ENTRIES (1u << 16)  /**< Entries parsed per timed repetition of small tables (tables are repeated up to this) */
+#define BENCH_HEADER_REPS   200000u     /**< Header parses per timed repetition */
+#define BENCH_FIND_SCAN     (1u << 24)  /**< Entries compared per timed repetition of a lookup stage */
+#define BENCH_FIND_MIN      16u         /**< Fewest lookups per timed repetition */
+#define BENCH_FIND_MAX      (1u << 16)  /**< Most lookups per timed repetition */
+#define BENCH_SECT_FIXED    3u          /**< Null section, .symtab and .strtab precede the filler sections */
+
+/**
+ * @brief Parse stages, in pipeline order
+ */
+typedef enum bench_stage_e
+{
+    BENCH_STAGE_HEADER = 0,     /**< ElfParser_Header_identParse() and _parse() */
+    BENCH_STAGE_SECTHEAD,       /**< ElfParser_SectHead_structSetup(), _parse() and _nameResolve() */
+    BENCH_STAGE_SYMTABLE,       /**< ElfParser_SymTable_structSetup(), _parse() and _nameResolve() */
+    BENCH_STAGE_SECT_FIND,      /**< ElfParser_SectHead_byNameFind() */
+    BENCH_STAGE_SYM_FIND,       /**< ElfParser_SymTable_byNameFind() */
+    BENCH_STAGE_NUM             /**< Number of stages */
+} bench_stage_e;
+
+/**
+ * @brief Synthetic ELF image with one symbol table, one string table and filler sections
+ */
+typedef struct bench_image_s
+{
+    uint8_t*    data;       /**< Image bytes: header, string table, symbol table, section headers */
+    size_t      size;       /**< Image size in bytes */
+    size_t      strtab_off; /**< Offset of .strtab, shared by symbol and section names */
+    size_t      strtab_size; /**< Size of .strtab in bytes */
+    size_t      symtab_off; /**< Offset of .symtab */
+    size_t      shdr_off;   /**< Offset of the section header table */
+    uint32_t*   name_off;   /**< Offset in .strtab of the name of entry i */
+    size_t      entry_num;  /**< Number of sections, which is also the number of symbols */
+} bench_image_t;
+
+/**
+ * @brief Measurement of one case
+ */
+typedef struct bench_result_s
+{
+    uint64_t    best_ns;    /**< Fastest timed repetition */
+    uint64_t    entries;    /**< Entries handled per repetition */
+    uint64_t    ops;        /**< Calls (or pipelines) per repetition */
+    uint64_t    allocs;     /**< Allocations of one repetition */
+} bench_result_t;
+
+/* Allocation counting through -Wl,--wrap */
+static volatile uint64_t bench_alloc_num; /**< Allocations made since start (volatile: the compiler assumes malloc touches no globals) */
+void *__real_malloc(size_t size) __attribute__((weak));                 /**< Weak, so the bench also links without --wrap */
+void *__real_calloc(size_t num, size_t size) __attribute__((weak));     /**< Weak, so the bench also links without --wrap */
+void *__real_realloc(void *ptr, size_t size) __attribute__((weak));     /**< Weak, so the bench also links without --wrap */
+
+/**
+ * @brief Counting malloc, reached from every malloc call when linked with --wrap=malloc
+ */
+void *__wrap_malloc(size_t size)
+{
+    bench_alloc_num++;
+    return __real_malloc(size);
+}
+
+/**
+ * @brief Counting calloc, reached from every calloc call when linked with --wrap=calloc
+ */
+void *__wrap_calloc(size_t num, size_t size)
+{
+    bench_alloc_num++;
+    return __real_calloc(num, size);
+}
+
+/**
+ * @brief Counting realloc, reached from every realloc call when linked with --wrap=realloc
+ */
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    bench_alloc_num++;
+    return __real_realloc(ptr, size);
+}
+
+/**
+ * @brief Checks whether the allocation wrappers are linked in
+ * @return int 1 if allocations are counted, 0 otherwise
+ */
+static int Bench_allocCounted(void)
+{
+    uint64_t before = bench_alloc_num;
+    void *volatile probe = malloc(1);
+    free(probe);
+    return bench_alloc_num != before;
+}
+
+/**
+ * @brief Builds a synthetic ELF image
+ *
+ * Section i and symbol i are both named "entry_<i>", so every name is unique
+ * and a lookup of it scans exactly i + 1 entries.
+ *
+ * @param[out] image Image to build, released with Bench_imageFree()
+ * @param[in] entry_num Number of sections and of symbols (at least BENCH_SECT_FIXED)
+ * @param[in] is_64bit Non-zero for ELFCLASS64
+ * @param[in] big_endian Non-zero for ELFDATA2MSB
+ * @return int 0 on success, -1 on allocation failure
+ */
+static int Bench_imageBuild(bench_image_t *image, size_t entry_num, int is_64bit, int big_endian)
+{
+    size_t word = is_64bit ? 8u : 4u;
+    size_t header_size = is_64bit ? ELFPARSER_HEADER_SIZE_64BIT : ELFPARSER_HEADER_SIZE_32BIT;
+    size_t sym_entry = Bench_symEntrySize(is_64bit);
+    size_t sect_entry = Bench_sectEntrySize(is_64bit);
+    int extended = entry_num >= 0xff00u;
+
+    memset(image, 0, sizeof(*image));
+    image->entry_num = entry_num;
+    image->name_off = malloc(entry_num * sizeof(uint32_t));
+    if (!image->name_off)
+    {
+        return -1;
+    }
+    image->strtab_off = header_size;
+    image->strtab_size = 1;  // Leading empty name
+    for (size_t i = 0; i < entry_num; i++)
+    {
+        image->name_off[i] = (uint32_t)image->strtab_size;
+        image->strtab_size += (size_t)snprintf(NULL, 0, "entry_%zu", i) + 1;
+    }
+    image->symtab_off = (image->strtab_off + image->strtab_size + 7u) & ~(size_t)7u;
+    image->shdr_off = image->symtab_off + entry_num * sym_entry;
+    image->size = image->shdr_off + entry_num * sect_entry;
+    image->data = calloc(1, image->size);
+    if (!image->data)
+    {
+        free(image->name_off);
+        return -1;
+    }
+
+    /* ELF header */
+    uint8_t *h = image->data;
+    memcpy(h, "\x7f" "ELF", 4);
+    h[4] = is_64bit ? 2 : 1;        // EI_CLASS
+    h[5] = big_endian ? 2 : 1;      // EI_DATA
+    h[6] = 1;                       // EI_VERSION
+    Bench_store(h + 16, 1, 2, big_endian);                          // e_type (ET_REL)
+    Bench_store(h + 18, is_64bit ? 62 : 3, 2, big_endian);          // e_machine
+    Bench_store(h + 20, 1, 4, big_endian);                          // e_version
+    Bench_store(h + 24 + 2 * word, image->shdr_off, word, big_endian); // e_shoff
+    size_t tail = 24 + 3 * word + 4;                                // e_ehsize
+    Bench_store(h + tail, header_size, 2, big_endian);
+    Bench_store(h + tail + 6, sect_entry, 2, big_endian);           // e_shentsize
+    Bench_store(h + tail + 8, extended ? 0 : entry_num, 2, big_endian); // e_shnum (0 escapes to sh_size of section 0)
+    Bench_store(h + tail + 10, 2, 2, big_endian);                   // e_shstrndx (.strtab)
+
+    /* .strtab */
+    char *strtab = (char *)image->data + image->strtab_off;
+    for (size_t i = 0; i < entry_num; i++)
+    {
+        sprintf(strtab + image->name_off[i], "entry_%zu", i);
+    }
+
+    /* .symtab */
+    Bench_rawSymTableFill(image->data + image->symtab_off, entry_num, is_64bit, big_endian, 0);
+    for (size_t i = 0; i < entry_num; i++)
+    {
+        Bench_store(image->data + image->symtab_off + i * sym_entry, image->name_off[i], 4, big_endian);  // st_name
+    }
+
+    /* Section headers: filler entries, then the fixed ones on top */
+    uint8_t *shdr = image->data + image->shdr_off;
+    Bench_rawSectHeadFill(shdr, entry_num, is_64bit, big_endian, 0);
+    for (size_t i = 0; i < entry_num; i++)
+    {
+        Bench_store(shdr + i * sect_entry, image->name_off[i], 4, big_endian);  // sh_name
+    }
+    memset(shdr, 0, sect_entry);
+    Bench_store(shdr + 8 + 3 * word, extended ? entry_num : 0, word, big_endian);  // Section 0 sh_size: real e_shnum
+    uint8_t *sym_sect = shdr + sect_entry;
+    Bench_store(sym_sect + 4, ELFPARSER_SECTHEAD_TYPE_SYMTAB, 4, big_endian);                          // sh_type
+    Bench_store(sym_sect + 8 + 2 * word, image->symtab_off, word, big_endian);                          // sh_offset
+    Bench_store(sym_sect + 8 + 3 * word, entry_num * sym_entry, word, big_endian);                      // sh_size
+    Bench_store(sym_sect + 8 + 4 * word, 2, 4, big_endian);                                             // sh_link (.strtab)
+    Bench_store(sym_sect + 16 + 5 * word, sym_entry, word, big_endian);                                 // sh_entsize
+    uint8_t *str_sect = shdr + 2 * sect_entry;
+    Bench_store(str_sect + 4, ELFPARSER_SECTHEAD_TYPE_STRINGTAB, 4, big_endian);                       // sh_type
+    Bench_store(str_sect + 8 + 2 * word, image->strtab_off, word, big_endian);                          // sh_offset
+    Bench_store(str_sect + 8 + 3 * word, image->strtab_size, word, big_endian);                         // sh_size
+    for (size_t i = BENCH_SECT_FIXED; i < entry_num; i++)
+    {
+        Bench_store(shdr + i * sect_entry + 4, ELFPARSER_SECTHEAD_TYPE_PROGBITS, 4, big_endian);       // No stray symbol tables
+    }
+    return 0;
+}
+
+/**
+ * @brief Releases a synthetic ELF image
+ * @param[in,out] image Image to release
+ */
+static void Bench_imageFree(bench_image_t *image)
+{
+    free(image->data);
+    free(image->name_off);
+}
+
+/**
+ * @brief Parses the identification block and the rest of the ELF header of an image
+ * @param[in] image Synthetic image
+ * @param[out] header Parsed ELF header
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+static int Bench_headerLoad(const bench_image_t *image, elfparser_header_t *header)
+{
+    int ret = ElfParser_Header_identParse(header, image->data, image->size);
+    if (ret == ELFPARSER_SUCCESS)
+    {
+        ret = ElfParser_Header_parse(header, image->data, image->size);
+    }
+    return ret;
+}
+
+/**
+ * @brief Sets up, parses and name-resolves the section headers of an image
+ * @param[in] image Synthetic image
+ * @param[in] header Parsed ELF header
+ * @param[out] sect_head Section headers, released with ElfParser_SectHead_free()
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+static int Bench_sectHeadLoad(const bench_image_t *image, const elfparser_header_t *header, elfparser_secthead_t *sect_head)
+{
+    int ret = ElfParser_SectHead_structSetup(sect_head, header);
+    if (ret == ELFPARSER_SUCCESS)
+    {
+        ret = ElfParser_SectHead_parse(sect_head, image->data + image->shdr_off, image->size - image->shdr_off);
+        if (ret == ELFPARSER_SUCCESS)
+        {
+            ret = ElfParser_SectHead_nameResolve(sect_head, image->data + image->strtab_off, image->strtab_size);
+        }
+        if (ret != ELFPARSER_SUCCESS)
+        {
+            ElfParser_SectHead_free(sect_head);
+        }
+    }
+    return ret;
+}
+
+/**
+ * @brief Sets up, parses and name-resolves the symbol table of an image
+ * @param[in] image Synthetic image
+ * @param[in] header Parsed ELF header
+ * @param[in] sect_head Parsed section headers
+ * @param[out] table Symbol table, released with ElfParser_SymTable_free()
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+static int Bench_symTableLoad(const bench_image_t *image, const elfparser_header_t *header, const elfparser_secthead_t *sect_head,
+                              elfparser_symtable_t *table)
+{
+    int ret = ElfParser_SymTable_structSetup(table, sect_head, 1, header);
+    if (ret == ELFPARSER_SUCCESS)
+    {
+        ret = ElfParser_SymTable_parse(table, image->data + image->symtab_off, image->shdr_off - image->symtab_off);
+        if (ret == ELFPARSER_SUCCESS)
+        {
+            ret = ElfParser_SymTable_nameResolve(table, image->data + image->strtab_off, image->strtab_size);
+        }
+        if (ret != ELFPARSER_SUCCESS)
+        {
+            ElfParser_SymTable_free(table);
+        }
+    }
+    return ret;
+}
+
+/**
+ * @brief Runs one stage on one image
+ *
+ * Setup, parse and resolve stages are repeated on as many table copies as fit
+ * BENCH_BATCH_ENTRIES, so small tables are not timed below the clock
+ * resolution; the copies are freed outside the timed region. Lookup stages
+ * look up pseudo-random entries by name from index 0.
+ *
+ * @param[in] image Synthetic image
+ * @param[in] stage Stage to time
+ * @param[out] result Measurement
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+static int Bench_stageRun(const bench_image_t *image, bench_stage_e stage, bench_result_t *result)
+{
+    elfparser_header_t header;
+    elfparser_secthead_t sect_head;
+    elfparser_symtable_t sym_table;
+    size_t copies = (image->entry_num < BENCH_BATCH_ENTRIES) ? BENCH_BATCH_ENTRIES / image->entry_num : 1;
+    int sect_needed = (stage == BENCH_STAGE_SYMTABLE || stage == BENCH_STAGE_SECT_FIND || stage == BENCH_STAGE_SYM_FIND);
+    int ret = Bench_headerLoad(image, &header);
+
+    if (ret == ELFPARSER_SUCCESS && sect_needed)
+    {
+        ret = Bench_sectHeadLoad(image, &header, &sect_head);  // Input of the later stages, untimed
+    }
+    if (ret != ELFPARSER_SUCCESS)
+    {
+        return ret;
+    }
+    if (stage == BENCH_STAGE_SYM_FIND)
+    {
+        ret = Bench_symTableLoad(image, &header, &sect_head, &sym_table);
+        if (ret != ELFPARSER_SUCCESS)
+        {
+            ElfParser_SectHead_free(&sect_head);
+            return ret;
+        }
+    }
+
+    elfparser_secthead_t *sect_copies = calloc(copies, sizeof(elfparser_secthead_t));
+    elfparser_symtable_t *sym_copies = calloc(copies, sizeof(elfparser_symtable_t));
+    size_t find_num = BENCH_FIND_SCAN / image->entry_num;
+    uint32_t *find_idx = NULL;
+    uint64_t scanned = 0;
+    find_num = (find_num < BENCH_FIND_MIN) ? BENCH_FIND_MIN : (find_num > BENCH_FIND_MAX) ? BENCH_FIND_MAX : find_num;
+    find_idx = malloc(find_num * sizeof(uint32_t));
+    if (!sect_copies || !sym_copies || !find_idx)
+    {
+        ret = ELFPARSER_ERR_MALLOC;
+    }
+    else
+    {
+        uint64_t seed = 0x9E3779B97F4A7C15ull;
+        for (size_t i = 0; i < find_num; i++)
+        {
+            find_idx[i] = (uint32_t)(Bench_rand(&seed) % image->entry_num);
+            scanned += find_idx[i] + 1u;
+        }
+    }
+
+    result->best_ns = UINT64_MAX;
+    for (uint32_t run = 0; run < BENCH_RUN_NUM && ret == ELFPARSER_SUCCESS; run++)
+    {
+        volatile int64_t sink = 0;
+        size_t made = 0;
+        uint64_t alloc_before = bench_alloc_num;
+        uint64_t t0 = Bench_nowNs();
+        switch (stage)
+        {
+            case BENCH_STAGE_HEADER:
+                for (uint32_t i = 0; i < BENCH_HEADER_REPS && ret == ELFPARSER_SUCCESS; i++)
+                {
+                    ret = Bench_headerLoad(image, &header);
+                    sink += header.elf_section_header_entry_num;
+                }
+                result->entries = result->ops = BENCH_HEADER_REPS;
+                break;
+            case BENCH_STAGE_SECTHEAD:
+                for (; made < copies && ret == ELFPARSER_SUCCESS; made++)
+                {
+                    ret = Bench_sectHeadLoad(image, &header, &sect_copies[made]);
+                }
+                made -= (ret != ELFPARSER_SUCCESS);  // A failed load frees its own copy
+                result->ops = copies;
+                result->entries = (uint64_t)copies * image->entry_num;
+                break;
+            case BENCH_STAGE_SYMTABLE:
+                for (; made < copies && ret == ELFPARSER_SUCCESS; made++)
+                {
+                    ret = Bench_symTableLoad(image, &header, &sect_head, &sym_copies[made]);
+                }
+                made -= (ret != ELFPARSER_SUCCESS);
+                result->ops = copies;
+                result->entries = (uint64_t)copies * image->entry_num;
+                break;
+            case BENCH_STAGE_SECT_FIND:
+                for (size_t i = 0; i < find_num; i++)
+                {
+                    if (ElfParser_SectHead_byNameFind(&sect_head, sect_head.table[find_idx[i]].sh_name, 0) != (int32_t)find_idx[i])
+                    {
+                        ret = ELFPARSER_ERR_NOT_FOUND;  // Names are unique, so the first match is the entry itself
+                    }
+                }
+                result->ops = find_num;
+                result->entries = scanned;
+                break;
+            case BENCH_STAGE_SYM_FIND:
+                for (size_t i = 0; i < find_num; i++)
+                {
+                    if (ElfParser_SymTable_byNameFind(&sym_table, sym_table.table[find_idx[i]].sym_name, 0) != (int32_t)find_idx[i])
+                    {
+                        ret = ELFPARSER_ERR_NOT_FOUND;  // Names are unique, so the first match is the entry itself
+                    }
+                }
+                result->ops = find_num;
+                result->entries = scanned;
+                break;
+            default:
+                ret = ELFPARSER_ERR_RANGE;
+                break;
+        }
+        uint64_t elapsed = Bench_nowNs() - t0;
+        result->allocs = bench_alloc_num - alloc_before;
+        result->best_ns = (elapsed < result->best_ns) ? elapsed : result->best_ns;
+        for (size_t i = 0; i < made; i++)
+        {
+            if (stage == BENCH_STAGE_SECTHEAD)
+            {
+                ElfParser_SectHead_free(&sect_copies[i]);
+            }
+            else
+            {
+                ElfParser_SymTable_free(&sym_copies[i]);
+            }
+        }
+        (void)sink;
+    }
+
+    free(find_idx);
+    free(sym_copies);
+    free(sect_copies);
+    if (stage == BENCH_STAGE_SYM_FIND)
+    {
+        ElfParser_SymTable_free(&sym_table);
+    }
+    if (sect_needed)
+    {
+        ElfParser_SectHead_free(&sect_head);
+    }
+    return ret;
+}
+
+/**
+ * @brief Builds the image of one case, runs the stage and prints its JSON object
+ *
+ * Runs in a forked child, so ru_maxrss is the peak of this case only.
+ *
+ * @param[in] stage_name Name of the stage in the output
+ * @param[in] stage Stage to time
+ * @param[in] size_name Name of the input size in the output
+ * @param[in] entry_num Number of sections and symbols
+ * @param[in] layout 0 to 3: bit 1 selects ELFCLASS64, bit 0 big-endian
+ * @param[in] alloc_counted Non-zero if the allocation wrappers are linked in
+ * @return int 0 on success, 1 on failure
+ */
+static int Bench_caseRun(const char *stage_name, bench_stage_e stage, const char *size_name, size_t entry_num, int layout,
+                         int alloc_counted)
+{
+    bench_image_t image;
+    bench_result_t result = { 0 };
+    struct rusage usage;
+    int is_64bit = layout >= 2;
+    int big_endian = layout & 1;
+
+    if (Bench_imageBuild(&image, entry_num, is_64bit, big_endian) != 0)
+    {
+        fprintf(stderr, "%s/%s: out of memory\n", stage_name, size_name);
+        return 1;
+    }
+    int ret = Bench_stageRun(&image, stage, &result);
+    size_t image_size = image.size;
+    Bench_imageFree(&image);
+    if (ret != ELFPARSER_SUCCESS)
+    {
+        fprintf(stderr, "%s/%s: stage failed with %d\n", stage_name, size_name, ret);
+        return 1;
+    }
+    getrusage(RUSAGE_SELF, &usage);
+
+    double entries = (double)(result.entries ? result.entries : 1);
+    printf("    {\"stage\": \"%s\", \"size\": \"%s\", \"class\": %d, \"endian\": \"%s\", \"table_entries\": %zu, "
+           "\"image_bytes\": %zu, \"ops\": %" PRIu64 ", \"entries\": %" PRIu64 ", \"best_ns\": %" PRIu64 ", "
+           "\"ns_per_op\": %.3f, \"ns_per_entry\": %.3f, ",
+           stage_name, size_name, is_64bit ? 64 : 32, big_endian ? "big" : "little", entry_num, image_size, result.ops,
+           result.entries, result.best_ns, (double)result.best_ns / (double)(result.ops ? result.ops : 1),
+           (double)result.best_ns / entries);
+    if (alloc_counted)
+    {
+        printf("\"allocs_per_entry\": %.4f, ", (double)result.allocs / entries);
+    }
+    else
+    {
+        printf("\"allocs_per_entry\": null, ");
+    }
+    printf("\"peak_rss_kib\": %ld}", usage.ru_maxrss);
+    fflush(stdout);
+    return 0;
+}
+
+int main(void)
+{
+    static const char *const stage_name[BENCH_STAGE_NUM] = { "header_parse", "secthead_parse_resolve", "symtable_parse_resolve",
+                                                             "secthead_by_name_find", "symtable_by_name_find" };
+    static const char *const size_name[] = { "small", "medium", "huge" };
+    const size_t sizes[] = { 16u, 4096u, 1u << 20 };
+    int alloc_counted = Bench_allocCounted();
+    int printed = 0;
+    int ret = 0;
+
+    printf("{\n  \"bench\": \"stages\",\n  \"alloc_counted\": %s,\n  \"results\": [\n", alloc_counted ? "true" : "false");
+    for (int stage = 0; stage < BENCH_STAGE_NUM; stage++)
+    {
+        for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+        {
+            for (int layout = 0; layout < 4; layout++)
+            {
+                if (printed)
+                {
+                    printf(",\n");
+                }
+                fflush(stdout);
+                pid_t pid = fork();
+                if (pid == 0)
+                {
+                    _exit(Bench_caseRun(stage_name[stage], (bench_stage_e)stage, size_name[s], sizes[s], layout, alloc_counted));
+                }
+                int status = 0;
+                if (pid < 0 || waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+                {
+                    fprintf(stderr, "%s/%s/layout %d: case failed\n", stage_name[stage], size_name[s], layout);
+                    printf("    null");  // Keeps the array well-formed and the case positions stable
+                    ret = 1;
+                }
+                printed = 1;
+            }
+        }
+    }
+    printf("\n  ]\n}\n");
+    return ret;
+}
@@ -0,0 +1,144 @@
+/**
+ * @file elfparser_bench_symcache.c
+ * @brief Benchmark of cold parses against warm symbol cache loads
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * For each file given on the command line (this executable by default), times
+ * ElfParser_SymCache_load() without a cache directory (a plain parse), the
+ * first load into a fresh temporary cache directory (parse plus index write)
+ * and repeated warm loads that are served from the index, and prints the
+ * best and median time of each. Files without a GNU build-id are never
+ * cached and show the same time in every column.
+ *
+ * Build and run from the repository root:
+ *   cc -O2 -pthread -Iinc_pub bench/elfparser_bench_symcache.c src/elfparser_*.c -o bench_symcache && ./bench_symcache [elf files...]
+ */
+
+#include "elfparser_bench_common.h"
+#include "../inc_pub/elfparser_symcache.h"
+#include <dirent.h>
+#include <unistd.h>
+
+#define BENCH_RUN_NUM 31 /**< Timed loads per configuration */
+
+/**
+ * @brief Compares two timings for qsort()
+ * @param[in] lhs First timing
+ * @param[in] rhs Second timing
+ * @return int Negative, zero or positive as lhs is less, equal or greater
+ */
+static int Bench_nsCmp(const void *lhs, const void *rhs)
+{
+    uint64_t a = *(const uint64_t *)lhs;
+    uint64_t b = *(const uint64_t *)rhs;
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief Times repeated loads of one file
+ * @param[in] path Path of the file
+ * @param[in] cache_dir Cache directory, NULL for plain parses
+ * @param[out] best Set to the fastest load in microseconds
+ * @param[out] median Set to the median load in microseconds
+ * @param[out] source Set to the source reported by the last load
+ * @param[out] sym_num Set to the number of symbols loaded
+ * @return int 0 on success, 1 if the file cannot be loaded
+ */
+static int Bench_loadTime(const char *path, const char *cache_dir, double *best, double *median,
+                          elfparser_symcache_source_e *source, uint64_t *sym_num)
+{
+    uint64_t ns[BENCH_RUN_NUM];
+
+    for (int run = 0; run < BENCH_RUN_NUM; run++)
+    {
+        elfparser_symcache_t cache;
+        uint64_t t0 = Bench_nowNs();
+        if (ElfParser_SymCache_load(&cache, cache_dir, path, ELFPARSER_FILE_FLAG_NONE) != ELFPARSER_SUCCESS)
+        {
+            return 1;
+        }
+        ns[run] = Bench_nowNs() - t0;
+        *source = cache.source;
+        *sym_num = 0;
+        for (uint32_t t = 0; t < cache.sym_table_num; t++)
+        {
+            *sym_num += cache.sym_tables[t].table_len;
+        }
+        ElfParser_SymCache_free(&cache);
+    }
+    qsort(ns, BENCH_RUN_NUM, sizeof(ns[0]), Bench_nsCmp);
+    *best = (double)ns[0] / 1e3;
+    *median = (double)ns[BENCH_RUN_NUM / 2] / 1e3;
+    return 0;
+}
+
+/**
+ * @brief Removes the index files of a cache directory and the directory itself
+ * @param[in] dir_path Cache directory
+ */
+static void Bench_dirRemove(const char *dir_path)
+{
+    DIR *dir = opendir(dir_path);
+    if (dir)
+    {
+        struct dirent *ent;
+        while ((ent = readdir(dir)) != NULL)
+        {
+            char path[4096];
+            snprintf(path, sizeof(path), "%s/%s", dir_path, ent->d_name);
+            if (ent->d_name[0] != '.' || (ent->d_name[1] != '\0' && strcmp(ent->d_name, "..") != 0))
+            {
+                unlink(path);
+            }
+        }
+        closedir(dir);
+    }
+    rmdir(dir_path);
+}
+
+int main(int argc, char **argv)
+{
+    const char *self[] = { "/proc/self/exe" };
+    const char **paths = (argc > 1) ? (const char **)&argv[1] : self;
+    int path_num = (argc > 1) ? argc - 1 : 1;
+    int ret = 0;
+
+    printf("%-8s %10s %10s %10s %10s %10s  %s\n", "source", "symbols", "parse_us", "first_us", "warm_us", "warm_med",
+           "file");
+    for (int i = 0; i < path_num; i++)
+    {
+        char dir[] = "/tmp/elfparser_symcache_XXXXXX";
+        if (!mkdtemp(dir))
+        {
+            fprintf(stderr, "cannot create a temporary cache directory\n");
+            return 1;
+        }
+        double parse_best, parse_med, first_us, warm_best, warm_med;
+        elfparser_symcache_source_e source;
+        uint64_t sym_num;
+        elfparser_symcache_t cache;
+
+        int failed = Bench_loadTime(paths[i], NULL, &parse_best, &parse_med, &source, &sym_num);
+        uint64_t t0 = Bench_nowNs();
+        failed |= (ElfParser_SymCache_load(&cache, dir, paths[i], ELFPARSER_FILE_FLAG_NONE) != ELFPARSER_SUCCESS);
+        first_us = (double)(Bench_nowNs() - t0) / 1e3;
+        if (!failed)
+        {
+            ElfParser_SymCache_free(&cache);
+            failed = Bench_loadTime(paths[i], dir, &warm_best, &warm_med, &source, &sym_num);
+        }
+        Bench_dirRemove(dir);
+        if (failed)
+        {
+            fprintf(stderr, "%s: cannot load\n", paths[i]);
+            ret = 1;
+            continue;
+        }
+        printf("%-8s %10" PRIu64 " %10.1f %10.1f %10.1f %10.1f  %s\n",
+               (source == ELFPARSER_SYMCACHE_SOURCE_HIT) ? "hit" : "uncached", sym_num, parse_best, first_us,
+               warm_best, warm_med, paths[i]);
+    }
+    return ret;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file elfparser_alloc_priv.h
+ * @brief Private header for allocator constants and helpers in libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header defines the block sizes of the bump arena and the size classes
+ * of the pool, and the inline helpers the table modules allocate and free
+ * through, which map a NULL allocator to malloc and free. These are used by
+ * the library sources and are not part of the public API.
+ */
+
+#ifndef _IG_ELFPARSER_ALLOC_PRIV_H_
+#define _IG_ELFPARSER_ALLOC_PRIV_H_
+
+#include <stdlib.h>
+#include "../inc_pub/elfparser_alloc.h"
+#include "../inc_priv/elfparser_stats_priv.h"
+
+/* Arena */
+#define ALLOC_ALIGN                 16u         /**< Alignment of every block handed out (alignof(max_align_t) on common ABIs) */
+#define ALLOC_ARENA_BLOCK_DEFAULT   (1u << 20)  /**< Default size of an arena block */
+#define ALLOC_ARENA_BLOCKS_INITIAL  8u          /**< Initial capacity of the block array */
+
+/* Pool */
+#define ALLOC_POOL_HEADER_SIZE      ALLOC_ALIGN /**< Bytes before each pool block holding its size class */
+#define ALLOC_POOL_CLASS_MIN_SHIFT  4u          /**< Smallest size class is 16 bytes */
+#define ALLOC_POOL_CLASS_NUM        13u         /**< Size classes from 16 bytes to 64 KiB */
+#define ALLOC_POOL_CLASS_LARGE      0xffu       /**< Class of blocks above the largest class, passed to malloc directly */
+#define ALLOC_POOL_CACHE_MAX        (4u << 20)  /**< Bytes a thread keeps per size class before freeing to the system */
+
+/**
+ * @brief Allocates a block through an allocator
+ * @param[in] alloc Allocator, NULL for malloc
+ * @param[in] size Size in bytes
+ * @return void* Block, or NULL on failure
+ */
+static inline void *ElfParser_allocMalloc(const elfparser_alloc_t *alloc, size_t size)
+{
+    ElfParser_statsAlloc(size);  // Charged to the open span, if any
+    return alloc ? alloc->alloc_fn(alloc->ctx, size) : malloc(size);
+}
+
+/**
+ * @brief Releases a block through an allocator
+ * @param[in] alloc Allocator, NULL for free
+ * @param[in] ptr Block to release (may be NULL)
+ */
+static inline void ElfParser_allocFree(const elfparser_alloc_t *alloc, void *ptr)
+{
+    if (!alloc)
+    {
+        free(ptr);
+    }
+    else if (alloc->free_fn && ptr)
+    {
+        alloc->free_fn(alloc->ctx, ptr);
+    }
+}
+
+/**
+ * @brief Tells whether blocks of an allocator are released one by one
+ * @param[in] alloc Allocator, NULL for malloc
+ * @return int 1 if per-block frees have an effect, 0 if memory is only released in bulk
+ */
+static inline int ElfParser_allocFreesBlocks(const elfparser_alloc_t *alloc)
+{
+    return !alloc || alloc->free_fn;
+}
+
+/**
+ * @brief Tells whether an allocator may be used by several threads at once
+ * @param[in] alloc Allocator, NULL for malloc
+ * @return int 1 if thread-safe, 0 otherwise
+ */
+static inline int ElfParser_allocThreadSafe(const elfparser_alloc_t *alloc)
+{
+    return !alloc || (alloc->flags & ELFPARSER_ALLOC_FLAG_THREAD_SAFE);
+}
+
+#endif /* _IG_ELFPARSER_ALLOC_PRIV_H_ */
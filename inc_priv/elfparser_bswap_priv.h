@@ -0,0 +1,56 @@
+/**
+ * @file elfparser_bswap_priv.h
+ * @brief Private header for bulk byte-swapping of ELF tables in libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header declares the bulk byte-swap routine used by the big-endian
+ * symbol table and section header decoders. It converts whole arrays of
+ * canonically sized raw entries from big-endian to host order with SIMD byte
+ * shuffles (SSSE3 or AVX2 on x86, selected at run time), so the little-endian
+ * decoders can then read them with plain loads. It is not part of the public API.
+ */
+
+#ifndef _IG_ELFPARSER_BSWAP_PRIV_H_
+#define _IG_ELFPARSER_BSWAP_PRIV_H_
+
+#include <inttypes.h>
+#include <stdlib.h>
+
+#define ELFPARSER_BSWAP_CHUNK_SIZE  1024u /**< Stack buffer size the decoders swap into, in bytes */
+#define ELFPARSER_BSWAP_PERIOD_MAX  4u    /**< Entry count every swap period divides */
+
+#define ELFPARSER_BSWAP_SYM_SIZE_32BIT  16u /**< Canonical symbol table entry size (32-bit) */
+#define ELFPARSER_BSWAP_SYM_SIZE_64BIT  24u /**< Canonical symbol table entry size (64-bit) */
+#define ELFPARSER_BSWAP_SECT_SIZE_32BIT 40u /**< Canonical section header entry size (32-bit) */
+#define ELFPARSER_BSWAP_SECT_SIZE_64BIT 64u /**< Canonical section header entry size (64-bit) */
+
+/**
+ * @brief Raw entry layouts the bulk byte-swap understands
+ */
+typedef enum elfparser_bswap_layout_e
+{
+    ELFPARSER_BSWAP_LAYOUT_SYM_32BIT = 0,   /**< Elf32_Sym */
+    ELFPARSER_BSWAP_LAYOUT_SYM_64BIT = 1,   /**< Elf64_Sym */
+    ELFPARSER_BSWAP_LAYOUT_SECT_32BIT = 2,  /**< Elf32_Shdr */
+    ELFPARSER_BSWAP_LAYOUT_SECT_64BIT = 3,  /**< Elf64_Shdr */
+} elfparser_bswap_layout_e;
+
+/**
+ * @brief Byte-swaps every field of consecutive big-endian entries into host order
+ *
+ * Only whole swap periods are converted (1 to 4 entries depending on layout
+ * and instruction set), so fewer than count entries may be written; the
+ * caller decodes the remainder with its scalar big-endian decoder. Returns 0
+ * when no SIMD implementation is available or the host is big-endian.
+ *
+ * @param[out] dst Destination buffer, may not overlap src
+ * @param[in] src Pointer to the first raw entry, packed at the canonical entry size
+ * @param[in] count Number of entries available at src
+ * @param[in] layout Layout of the raw entries
+ * @return size_t Number of entries written to dst
+ */
+size_t ElfParser_bswapEntries(void *dst, const void *src, size_t count, elfparser_bswap_layout_e layout);
+
+#endif /* _IG_ELFPARSER_BSWAP_PRIV_H_ */
@@ -0,0 +1,46 @@
+/**
+ * @file elfparser_demangle_priv.h
+ * @brief Private header for Itanium C++ demangler constants in libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header defines the limits that keep hostile manglings from exhausting
+ * the stack or the heap, the flag bits stored in parse tree nodes and the
+ * sizes of the work buffers, memo and arena. These are used by
+ * elfparser_demangle.c and are not part of the public API.
+ */
+
+#ifndef _IG_ELFPARSER_DEMANGLE_PRIV_H_
+#define _IG_ELFPARSER_DEMANGLE_PRIV_H_
+
+/* Limits */
+#define DEMANGLE_DEPTH_MAX          256u        /**< Nesting of parse and print recursion before a name is rejected */
+#define DEMANGLE_PRINT_STEPS_MAX    (1u << 22)  /**< Nodes visited while printing one name (substitutions can repeat subtrees) */
+#define DEMANGLE_OUT_MAX            (1u << 20)  /**< Longest demangled name, longer ones are rejected */
+#define DEMANGLE_PACK_NONE          UINT32_MAX  /**< Pack index and size outside any pack expansion */
+
+/* Work Buffers, Memo and Arena */
+#define DEMANGLE_ARRAY_INITIAL      64u         /**< Initial capacity of each work array */
+#define DEMANGLE_OUT_INITIAL        256u        /**< Initial capacity of the output buffer */
+#define DEMANGLE_SLOT_INITIAL       1024u       /**< Initial number of memo slots (power of two) */
+#define DEMANGLE_BLOCK_SIZE         (64u << 10) /**< Minimum size of an arena block */
+#define DEMANGLE_CHUNK_SIZE         512u        /**< New names demangled per work chunk */
+
+/* Qualifier Flags (node flags of qualified types, functions and encodings) */
+#define DEMANGLE_CV_CONST           0x01u /**< const */
+#define DEMANGLE_CV_VOLATILE        0x02u /**< volatile */
+#define DEMANGLE_CV_RESTRICT        0x04u /**< restrict */
+#define DEMANGLE_CV_MASK            0x07u /**< All cv qualifiers */
+#define DEMANGLE_REF_SHIFT          3u    /**< Position of the ref qualifier (1 for &, 2 for &&) */
+
+/* Other Node Flags */
+#define DEMANGLE_TPARAM_FORWARD     0x01u /**< Template parameter used before its arguments (conversion operators) */
+#define DEMANGLE_TPARAM_LAMBDA      0x02u /**< Template parameter of a generic lambda, printed as auto:N in its signature */
+#define DEMANGLE_LITERAL_NEG        0x01u /**< Negative literal */
+#define DEMANGLE_CAST_LIST          0x01u /**< Cast of a parenthesized expression list */
+#define DEMANGLE_PARM_THIS          0x01u /**< The this parameter */
+#define DEMANGLE_OPERATOR_VENDOR    0x01u /**< Vendor extended operator, always printed after a space */
+#define DEMANGLE_PREFIX_GLOBAL      0x01u /**< Global scope prefix, operand printed without parentheses */
+
+#endif /* _IG_ELFPARSER_DEMANGLE_PRIV_H_ */
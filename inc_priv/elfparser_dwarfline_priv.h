@@ -0,0 +1,117 @@
+/**
+ * @file elfparser_dwarfline_priv.h
+ * @brief Private header for DWARF line table decoding constants in libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header defines the DWARF 2 to 5 encodings the line table module needs:
+ * the standard and extended line program opcodes, the attribute forms it
+ * reads or skips in unit headers and compile unit entries, the line table
+ * content types of DWARF 5 and the section names it looks up. These are used
+ * by elfparser_dwarfline.c and are not part of the public API.
+ */
+
+#ifndef _IG_ELFPARSER_DWARFLINE_PRIV_H_
+#define _IG_ELFPARSER_DWARFLINE_PRIV_H_
+
+/* Section Names */
+#define DWARFLINE_SECT_LINE         ".debug_line"     /**< Line number programs */
+#define DWARFLINE_SECT_LINE_STR     ".debug_line_str" /**< Strings of DWARF 5 line table headers */
+#define DWARFLINE_SECT_STR          ".debug_str"      /**< Strings of debugging entries */
+#define DWARFLINE_SECT_ARANGES      ".debug_aranges"  /**< Address ranges of compile units */
+#define DWARFLINE_SECT_INFO         ".debug_info"     /**< Debugging entries */
+#define DWARFLINE_SECT_ABBREV       ".debug_abbrev"   /**< Abbreviation tables of the entries */
+
+/* Auxiliary Section Slots (elfparser_dwarfline_t.aux_*) */
+#define DWARFLINE_AUX_LINE_STR      0u /**< .debug_line_str */
+#define DWARFLINE_AUX_STR           1u /**< .debug_str */
+#define DWARFLINE_AUX_INFO          2u /**< .debug_info */
+#define DWARFLINE_AUX_ABBREV        3u /**< .debug_abbrev */
+
+/* Unit Header */
+#define DWARFLINE_LENGTH_64BIT      0xFFFFFFFFu /**< unit_length escape announcing the 64-bit DWARF format */
+#define DWARFLINE_LENGTH_RESERVED   0xFFFFFFF0u /**< Lowest reserved unit_length value */
+#define DWARFLINE_VERSION_MIN       2u          /**< Oldest supported version */
+#define DWARFLINE_VERSION_MAX       5u          /**< Newest supported version */
+
+/* Standard Opcodes (DW_LNS_*) */
+#define DWARFLINE_LNS_COPY              0x01u /**< Append a row */
+#define DWARFLINE_LNS_ADVANCE_PC        0x02u /**< Advance the address by an unsigned operand */
+#define DWARFLINE_LNS_ADVANCE_LINE      0x03u /**< Advance the line by a signed operand */
+#define DWARFLINE_LNS_SET_FILE          0x04u /**< Set the file index */
+#define DWARFLINE_LNS_SET_COLUMN        0x05u /**< Set the column */
+#define DWARFLINE_LNS_NEGATE_STMT       0x06u /**< Toggle is_stmt */
+#define DWARFLINE_LNS_SET_BASIC_BLOCK   0x07u /**< Mark a basic block start */
+#define DWARFLINE_LNS_CONST_ADD_PC      0x08u /**< Advance the address as special opcode 255 would */
+#define DWARFLINE_LNS_FIXED_ADVANCE_PC  0x09u /**< Advance the address by an unscaled 2-byte operand */
+
+/* Extended Opcodes (DW_LNE_*) */
+#define DWARFLINE_LNE_END_SEQUENCE      0x01u /**< Append the end row and reset the state */
+#define DWARFLINE_LNE_SET_ADDRESS       0x02u /**< Set the address to a target address operand */
+#define DWARFLINE_LNE_DEFINE_FILE       0x03u /**< Add a file entry (DWARF 2 to 4) */
+
+/* Line Table Content Types (DW_LNCT_*) */
+#define DWARFLINE_LNCT_PATH             0x01u /**< Path name */
+#define DWARFLINE_LNCT_DIRECTORY_INDEX  0x02u /**< Index into the directory table */
+
+/* Attributes (DW_AT_*) */
+#define DWARFLINE_AT_STMT_LIST          0x10u /**< Offset of the unit's line program */
+
+/* Unit Types (DW_UT_*) */
+#define DWARFLINE_UT_TYPE               0x02u /**< Type unit */
+#define DWARFLINE_UT_SKELETON           0x04u /**< Skeleton unit */
+#define DWARFLINE_UT_SPLIT_COMPILE      0x05u /**< Split compile unit */
+#define DWARFLINE_UT_SPLIT_TYPE         0x06u /**< Split type unit */
+
+/* Attribute Forms (DW_FORM_*) */
+#define DWARFLINE_FORM_ADDR                 0x01u /**< DW_FORM_addr */
+#define DWARFLINE_FORM_BLOCK2               0x03u /**< DW_FORM_block2 */
+#define DWARFLINE_FORM_BLOCK4               0x04u /**< DW_FORM_block4 */
+#define DWARFLINE_FORM_DATA2                0x05u /**< DW_FORM_data2 */
+#define DWARFLINE_FORM_DATA4                0x06u /**< DW_FORM_data4 */
+#define DWARFLINE_FORM_DATA8                0x07u /**< DW_FORM_data8 */
+#define DWARFLINE_FORM_STRING               0x08u /**< DW_FORM_string */
+#define DWARFLINE_FORM_BLOCK                0x09u /**< DW_FORM_block */
+#define DWARFLINE_FORM_BLOCK1               0x0Au /**< DW_FORM_block1 */
+#define DWARFLINE_FORM_DATA1                0x0Bu /**< DW_FORM_data1 */
+#define DWARFLINE_FORM_FLAG                 0x0Cu /**< DW_FORM_flag */
+#define DWARFLINE_FORM_SDATA                0x0Du /**< DW_FORM_sdata */
+#define DWARFLINE_FORM_STRP                 0x0Eu /**< DW_FORM_strp */
+#define DWARFLINE_FORM_UDATA                0x0Fu /**< DW_FORM_udata */
+#define DWARFLINE_FORM_REF_ADDR             0x10u /**< DW_FORM_ref_addr */
+#define DWARFLINE_FORM_REF1                 0x11u /**< DW_FORM_ref1 */
+#define DWARFLINE_FORM_REF2                 0x12u /**< DW_FORM_ref2 */
+#define DWARFLINE_FORM_REF4                 0x13u /**< DW_FORM_ref4 */
+#define DWARFLINE_FORM_REF8                 0x14u /**< DW_FORM_ref8 */
+#define DWARFLINE_FORM_REF_UDATA            0x15u /**< DW_FORM_ref_udata */
+#define DWARFLINE_FORM_INDIRECT             0x16u /**< DW_FORM_indirect */
+#define DWARFLINE_FORM_SEC_OFFSET           0x17u /**< DW_FORM_sec_offset */
+#define DWARFLINE_FORM_EXPRLOC              0x18u /**< DW_FORM_exprloc */
+#define DWARFLINE_FORM_FLAG_PRESENT         0x19u /**< DW_FORM_flag_present */
+#define DWARFLINE_FORM_STRX                 0x1Au /**< DW_FORM_strx */
+#define DWARFLINE_FORM_ADDRX                0x1Bu /**< DW_FORM_addrx */
+#define DWARFLINE_FORM_REF_SUP4             0x1Cu /**< DW_FORM_ref_sup4 */
+#define DWARFLINE_FORM_STRP_SUP             0x1Du /**< DW_FORM_strp_sup */
+#define DWARFLINE_FORM_DATA16               0x1Eu /**< DW_FORM_data16 */
+#define DWARFLINE_FORM_LINE_STRP            0x1Fu /**< DW_FORM_line_strp */
+#define DWARFLINE_FORM_REF_SIG8             0x20u /**< DW_FORM_ref_sig8 */
+#define DWARFLINE_FORM_IMPLICIT_CONST       0x21u /**< DW_FORM_implicit_const */
+#define DWARFLINE_FORM_LOCLISTX             0x22u /**< DW_FORM_loclistx */
+#define DWARFLINE_FORM_RNGLISTX             0x23u /**< DW_FORM_rnglistx */
+#define DWARFLINE_FORM_REF_SUP8             0x24u /**< DW_FORM_ref_sup8 */
+#define DWARFLINE_FORM_STRX1                0x25u /**< DW_FORM_strx1 */
+#define DWARFLINE_FORM_STRX2                0x26u /**< DW_FORM_strx2 */
+#define DWARFLINE_FORM_STRX3                0x27u /**< DW_FORM_strx3 */
+#define DWARFLINE_FORM_STRX4                0x28u /**< DW_FORM_strx4 */
+#define DWARFLINE_FORM_ADDRX1               0x29u /**< DW_FORM_addrx1 */
+#define DWARFLINE_FORM_ADDRX2               0x2Au /**< DW_FORM_addrx2 */
+#define DWARFLINE_FORM_ADDRX3               0x2Bu /**< DW_FORM_addrx3 */
+#define DWARFLINE_FORM_ADDRX4               0x2Cu /**< DW_FORM_addrx4 */
+#define DWARFLINE_FORM_GNU_REF_ALT          0x1F20u /**< DW_FORM_GNU_ref_alt */
+#define DWARFLINE_FORM_GNU_STRP_ALT         0x1F21u /**< DW_FORM_GNU_strp_alt */
+
+#define DWARFLINE_INDIRECT_DEPTH_MAX    4u  /**< Nested DW_FORM_indirect levels followed before giving up */
+#define DWARFLINE_RANGE_INITIAL         64u /**< Initial capacity of the range table */
+
+#endif /* _IG_ELFPARSER_DWARFLINE_PRIV_H_ */
@@ -0,0 +1,43 @@
+/**
+ * @file elfparser_dynhash_priv.h
+ * @brief Private header for ELF symbol hash table constants in libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header defines internal constants for reading the on-disk symbol hash
+ * tables (.gnu.hash and SHT_HASH) within the standalone libelfparser library.
+ * These constants are used by elfparser_dynhash.c and are not part of the
+ * public API.
+ */
+
+#ifndef _IG_ELFPARSER_DYNHASH_PRIV_H_
+#define _IG_ELFPARSER_DYNHASH_PRIV_H_
+
+/* GNU Hash Table Header Offsets (.gnu.hash) */
+#define DYNHASH_GNU_BUCKETNUM_OFF       0x00u /**< Offset of bucket count (nbuckets) */
+#define DYNHASH_GNU_SYMOFF_OFF          0x04u /**< Offset of first hashed symbol index (symoffset) */
+#define DYNHASH_GNU_BLOOMSIZE_OFF       0x08u /**< Offset of bloom filter word count (bloom_size) */
+#define DYNHASH_GNU_BLOOMSHIFT_OFF      0x0Cu /**< Offset of second bloom hash shift (bloom_shift) */
+#define DYNHASH_GNU_BLOOM_OFF           0x10u /**< Offset of the bloom filter words */
+
+/* GNU Hash Table Sizes */
+#define DYNHASH_GNU_WORD_SIZE           4u    /**< Size of header, bucket and chain words */
+#define DYNHASH_GNU_BLOOMWORD_SIZE_32BIT 4u   /**< Size of a bloom filter word (32-bit) */
+#define DYNHASH_GNU_BLOOMWORD_SIZE_64BIT 8u   /**< Size of a bloom filter word (64-bit) */
+
+/* System V Hash Table Header Word Indices (SHT_HASH) */
+#define DYNHASH_SYSV_BUCKETNUM_WORD     0u    /**< Word index of bucket count (nbucket) */
+#define DYNHASH_SYSV_CHAINNUM_WORD      1u    /**< Word index of chain count (nchain) */
+#define DYNHASH_SYSV_HEADER_WORDS       2u    /**< Number of header words before the buckets */
+
+/* System V Hash Table Sizes */
+#define DYNHASH_SYSV_WORD_SIZE          4u    /**< Default size of a hash word */
+#define DYNHASH_SYSV_WORD_SIZE_WIDE     8u    /**< Hash word size used by a few 64-bit ABIs (sh_entsize 8) */
+
+/* Linked Symbol Table */
+#define DYNHASH_SYM_SIZE_32BIT          16u   /**< Required sh_entsize of the symbol table (Elf32_Sym) */
+#define DYNHASH_SYM_SIZE_64BIT          24u   /**< Required sh_entsize of the symbol table (Elf64_Sym) */
+#define DYNHASH_SYM_UNDEF               0u    /**< Section index of undefined symbols (SHN_UNDEF) */
+
+#endif /* _IG_ELFPARSER_DYNHASH_PRIV_H_ */
@@ -0,0 +1,27 @@
+/**
+ * @file elfparser_file_priv.h
+ * @brief Private header for ELF file handle constants in libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header defines internal constants of the file handle, namely the bits
+ * recording which tables have been parsed and the sizes of the fixed reads
+ * it makes. They are used by elfparser_file.c and are not part of the public
+ * API.
+ */
+
+#ifndef _IG_ELFPARSER_FILE_PRIV_H_
+#define _IG_ELFPARSER_FILE_PRIV_H_
+
+/* Parsed Table Bits (elfparser_file_t.ready) */
+#define FILE_READY_HEADER       0x01u /**< header is parsed */
+#define FILE_READY_SECTHEAD     0x02u /**< sect_head is parsed and its names are resolved */
+#define FILE_READY_PROGHEAD     0x04u /**< prog_head is parsed */
+#define FILE_SETUP_SECTHEAD     0x10u /**< sect_head owns a table that close must free */
+#define FILE_SETUP_PROGHEAD     0x20u /**< prog_head owns a table that close must free */
+
+#define FILE_HEADER_READ_SIZE   64u   /**< Bytes read for the ELF header (size of the 64-bit header) */
+#define FILE_SYMTABLE_RANGE_NUM 3u    /**< Ranges prefetched for a symbol table: entries, names, extended indices */
+
+#endif /* _IG_ELFPARSER_FILE_PRIV_H_ */
@@ -0,0 +1,23 @@
+/**
+ * @file elfparser_fingerprint_priv.h
+ * @brief Private header for file fingerprint constants in libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header defines internal constants of the fingerprint functions: the
+ * seed and chunking of the content hash, whose values are part of the
+ * definition of content_hash and must not change without invalidating every
+ * stored fingerprint, and the work split of the multi-file variant. They are
+ * used by elfparser_fingerprint.c and are not part of the public API.
+ */
+
+#ifndef _IG_ELFPARSER_FINGERPRINT_PRIV_H_
+#define _IG_ELFPARSER_FINGERPRINT_PRIV_H_
+
+#define FINGERPRINT_HASH_SEED       0x454C4650u  /**< Initial content hash state ("ELFP") */
+#define FINGERPRINT_HASH_CHUNK      (1u << 20)   /**< Bytes hashed per reader request; each chunk hash seeds the next */
+#define FINGERPRINT_SEGMENT_RECORD  32u          /**< Bytes of segment geometry hashed before its contents */
+#define FINGERPRINT_FILES_PER_CHUNK 8u           /**< Files claimed at a time by ElfParser_Fingerprint_many() */
+
+#endif /* _IG_ELFPARSER_FINGERPRINT_PRIV_H_ */
@@ -0,0 +1,50 @@
+/**
+ * @file elfparser_hash_priv.h
+ * @brief Private header for the 64-bit block hash in libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header declares the non-cryptographic 64-bit hash used to checksum
+ * on-disk indices and to fingerprint file contents. Its layout follows XXH3:
+ * four 64-bit accumulator lanes take 32-byte stripes, each multiplying the
+ * low and high halves of the keyed input and adding the raw input to the
+ * neighbouring lane, and are scrambled every 16 stripes before a final
+ * multiply-fold merge. The AVX2 and scalar implementations, selected at run
+ * time, return identical values on every host. It is not part of the public API.
+ */
+
+#ifndef _IG_ELFPARSER_HASH_PRIV_H_
+#define _IG_ELFPARSER_HASH_PRIV_H_
+
+#include <inttypes.h>
+#include <stdlib.h>
+
+#define HASH_LANE_NUM           4u    /**< 64-bit accumulator lanes */
+#define HASH_STRIPE_SIZE        32u   /**< Bytes consumed per stripe, 8 per lane */
+#define HASH_BLOCK_STRIPES      16u   /**< Stripes between two scrambles */
+#define HASH_BLOCK_SIZE         (HASH_STRIPE_SIZE * HASH_BLOCK_STRIPES) /**< Bytes between two scrambles */
+
+#define HASH_SECRET_NUM         24u   /**< 64-bit words of key material */
+#define HASH_SECRET_SCRAMBLE    20u   /**< First key word of the scramble step */
+#define HASH_SECRET_TAIL        17u   /**< First key word of the zero-padded last stripe */
+#define HASH_SECRET_MERGE       11u   /**< First key word of the final merge */
+
+#define HASH_PRIME32_1          0x9E3779B1u            /**< Scramble multiplier */
+#define HASH_PRIME64_1          0x9E3779B185EBCA87ull  /**< Length multiplier of the merge */
+#define HASH_PRIME64_2          0xC2B2AE3D27D4EB4Full  /**< Initial value of lane 1 */
+#define HASH_PRIME64_3          0x165667B19E3779F9ull  /**< Initial value of lane 2 */
+#define HASH_PRIME64_4          0x85EBCA77C2B2AE63ull  /**< Initial value of lane 3 */
+#define HASH_PRIME64_5          0x27D4EB2F165667C5ull  /**< Initial value of lane 0 */
+#define HASH_AVALANCHE_MUL      0x165667919E3779F9ull  /**< Multiplier of the final avalanche */
+
+/**
+ * @brief Hashes a block of memory to 64 bits
+ * @param[in] data Pointer to the bytes to hash, may be NULL if size is 0
+ * @param[in] size Number of bytes
+ * @param[in] seed Seed mixed into the initial state
+ * @return uint64_t Hash value
+ */
+uint64_t ElfParser_hash64(const void *data, size_t size, uint64_t seed);
+
+#endif /* _IG_ELFPARSER_HASH_PRIV_H_ */
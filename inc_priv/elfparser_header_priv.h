@@ -16,6 +16,7 @@
 #define _IG_ELFPARSER_HEADER_PRIV_H_
 
 #define IDENT_ENTRY_NUM         6   /**< Number of fields in the ELF identification block */
+#define IDENT_SIZE              16u /**< Size of the ELF identification block (EI_NIDENT) */
 #define HEADER_ENTRY_NUM        13  /**< Number of fields in the ELF header (excluding ident) */
 
 /* ELF Identification Block Offsets (EI_* fields per ELF specification) */
@@ -80,4 +81,9 @@
 #define HEADER_SECTTENTNUM_SIZE             2u   /**< Size of section header entry count (e_shnum) */
 #define HEADER_SECTTENTNAMEIDX_SIZE         2u   /**< Size of section name string table index (e_shstrndx) */
 
+/* Extended Numbering Escapes */
+#define HEADER_SECTNUM_EXTENDED     0x0000u /**< e_shnum value deferring the count to sh_size of section 0 */
+#define HEADER_SHN_XINDEX           0xFFFFu /**< e_shstrndx value deferring the index to sh_link of section 0 (SHN_XINDEX) */
+#define HEADER_PN_XNUM              0xFFFFu /**< e_phnum value deferring the count to sh_info of section 0 (PN_XNUM) */
+
 #endif /* _IG_ELFPARSER_HEADER_PRIV_H_ */
\ No newline at end of file
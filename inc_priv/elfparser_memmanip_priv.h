@@ -8,8 +8,9 @@
  * This header declares private memory manipulation functions for the standalone
  * libelfparser library. These utilities provide low-level operations for copying,
  * comparing, and duplicating memory and strings, intended for internal use by
- * other library components (e.g., elfparser_secthead.c, elfparser_symtable.c).
- * They are not part of the public API.
+ * other library components (e.g., elfparser_secthead.c, elfparser_symtable.c),
+ * plus inline fixed-width loads used by the per-layout decoders and matching
+ * stores used by the on-disk index writer. They are not part of the public API.
  */
 
 #ifndef _IG_ELFPARSER_MEMMANIP_PRIV_H_
@@ -17,6 +18,91 @@
 
 #include <inttypes.h>
 #include <stdlib.h>
+#include "../inc_pub/elfparser_alloc.h"
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define ELFPARSER_HOST_BIG_ENDIAN 1 /**< Host stores multi-byte values big-endian */
+#else
+#define ELFPARSER_HOST_BIG_ENDIAN 0 /**< Host stores multi-byte values little-endian */
+#endif
+
+/**
+ * @brief Loads an unaligned 16-bit value of the given file endianness
+ * @param[in] src Pointer to the value
+ * @param[in] big_endian Non-zero if the value is stored big-endian
+ * @return uint16_t Value in host order
+ */
+static inline uint16_t ElfParser_load16(const uint8_t *src, int big_endian)
+{
+    uint16_t value;
+
+    __builtin_memcpy(&value, src, sizeof(value));  // Single unaligned load
+    return (big_endian != ELFPARSER_HOST_BIG_ENDIAN) ? __builtin_bswap16(value) : value;
+}
+
+/**
+ * @brief Loads an unaligned 32-bit value of the given file endianness
+ * @param[in] src Pointer to the value
+ * @param[in] big_endian Non-zero if the value is stored big-endian
+ * @return uint32_t Value in host order
+ */
+static inline uint32_t ElfParser_load32(const uint8_t *src, int big_endian)
+{
+    uint32_t value;
+
+    __builtin_memcpy(&value, src, sizeof(value));  // Single unaligned load
+    return (big_endian != ELFPARSER_HOST_BIG_ENDIAN) ? __builtin_bswap32(value) : value;
+}
+
+/**
+ * @brief Loads an unaligned 64-bit value of the given file endianness
+ * @param[in] src Pointer to the value
+ * @param[in] big_endian Non-zero if the value is stored big-endian
+ * @return uint64_t Value in host order
+ */
+static inline uint64_t ElfParser_load64(const uint8_t *src, int big_endian)
+{
+    uint64_t value;
+
+    __builtin_memcpy(&value, src, sizeof(value));  // Single unaligned load
+    return (big_endian != ELFPARSER_HOST_BIG_ENDIAN) ? __builtin_bswap64(value) : value;
+}
+
+/**
+ * @brief Stores a 16-bit value unaligned in the given endianness
+ * @param[out] dst Pointer to the destination
+ * @param[in] value Value in host order
+ * @param[in] big_endian Non-zero to store big-endian
+ */
+static inline void ElfParser_store16(uint8_t *dst, uint16_t value, int big_endian)
+{
+    value = (big_endian != ELFPARSER_HOST_BIG_ENDIAN) ? __builtin_bswap16(value) : value;
+    __builtin_memcpy(dst, &value, sizeof(value));  // Single unaligned store
+}
+
+/**
+ * @brief Stores a 32-bit value unaligned in the given endianness
+ * @param[out] dst Pointer to the destination
+ * @param[in] value Value in host order
+ * @param[in] big_endian Non-zero to store big-endian
+ */
+static inline void ElfParser_store32(uint8_t *dst, uint32_t value, int big_endian)
+{
+    value = (big_endian != ELFPARSER_HOST_BIG_ENDIAN) ? __builtin_bswap32(value) : value;
+    __builtin_memcpy(dst, &value, sizeof(value));  // Single unaligned store
+}
+
+/**
+ * @brief Stores a 64-bit value unaligned in the given endianness
+ * @param[out] dst Pointer to the destination
+ * @param[in] value Value in host order
+ * @param[in] big_endian Non-zero to store big-endian
+ */
+static inline void ElfParser_store64(uint8_t *dst, uint64_t value, int big_endian)
+{
+    value = (big_endian != ELFPARSER_HOST_BIG_ENDIAN) ? __builtin_bswap64(value) : value;
+    __builtin_memcpy(dst, &value, sizeof(value));  // Single unaligned store
+}
 
 /**
  * @brief Copies a block of memory from source to destination
@@ -74,4 +160,37 @@ int64_t ElfParser_strExtract(const void *map, char **dup, size_t start, size_t l
  */
 int64_t ElfParser_strDup(const char *str, char **dup);
 
+/**
+ * @brief Duplicates a null-terminated string into memory from an allocator
+ * @param[in] str Source string to duplicate
+ * @param[out] dup Pointer to store the duplicated string
+ * @param[in] alloc Allocator of the copy, NULL for malloc
+ * @return int64_t Length of duplicated string on success, ELFPARSER_ERR_NULL if str is NULL,
+ *                 ELFPARSER_ERR_MALLOC if allocation fails, ELFPARSER_ERR_MEMCPY if copy fails
+ */
+int64_t ElfParser_strDupAlloc(const char *str, char **dup, const elfparser_alloc_t *alloc);
+
+/**
+ * @brief Measures a null-terminated string that must end inside a bounded region
+ * @param[in] str Start of the string
+ * @param[in] max_len Number of bytes available from str onwards
+ * @return int64_t Length of the string without terminator on success, ELFPARSER_ERR_NULL if str is NULL,
+ *                 ELFPARSER_ERR_RANGE if no terminator is found within max_len bytes
+ */
+int64_t ElfParser_strLenBounded(const char *str, size_t max_len);
+
+/**
+ * @brief Computes the GNU (DJB2-style) hash of a null-terminated string
+ * @param[in] str String to hash
+ * @return uint32_t Hash value (h = h * 33 + c, seeded with 5381), 0 if str is NULL
+ */
+uint32_t ElfParser_gnuHash(const char *str);
+
+/**
+ * @brief Computes the System V ELF hash of a null-terminated string
+ * @param[in] str String to hash
+ * @return uint32_t Hash value as used by SHT_HASH sections, 0 if str is NULL
+ */
+uint32_t ElfParser_sysvHash(const char *str);
+
 #endif /* _IG_ELFPARSER_MEMMANIP_PRIV_H_ */
\ No newline at end of file
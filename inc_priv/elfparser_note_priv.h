@@ -0,0 +1,27 @@
+/**
+ * @file elfparser_note_priv.h
+ * @brief Private header for ELF note parsing constants in libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header defines internal constants for decoding ELF notes within the
+ * standalone libelfparser library: the offsets of the fixed note header
+ * fields, which are the same for 32-bit and 64-bit files, and the padding
+ * rules. These constants are used by elfparser_note.c and are not part of
+ * the public API.
+ */
+
+#ifndef _IG_ELFPARSER_NOTE_PRIV_H_
+#define _IG_ELFPARSER_NOTE_PRIV_H_
+
+/* ELF Note Header Field Offsets (Elf32_Nhdr and Elf64_Nhdr share the layout) */
+#define NOTE_NAMESZ_OFF     0x00u /**< Offset of name size including terminator (n_namesz) */
+#define NOTE_DESCSZ_OFF     0x04u /**< Offset of descriptor size (n_descsz) */
+#define NOTE_TYPE_OFF       0x08u /**< Offset of note type (n_type) */
+#define NOTE_HEADER_SIZE    0x0Cu /**< Size of the note header; the name follows it */
+
+#define NOTE_ALIGN_DEFAULT  4u    /**< Padding of name and descriptor unless the container is 8-aligned */
+#define NOTE_ALIGN_WIDE     8u    /**< Padding used by 8-aligned note sections and segments */
+
+#endif /* _IG_ELFPARSER_NOTE_PRIV_H_ */
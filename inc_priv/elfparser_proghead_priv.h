@@ -0,0 +1,46 @@
+/**
+ * @file elfparser_proghead_priv.h
+ * @brief Private header for ELF program header parsing constants in libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header defines internal constants for parsing ELF program headers within
+ * the standalone libelfparser library. It includes offsets and sizes for program
+ * header fields, supporting both 32-bit and 64-bit formats. These constants are
+ * used by elfparser_proghead.c and are not part of the public API.
+ */
+
+#ifndef _IG_ELFPARSER_PROGHEAD_PRIV_H_
+#define _IG_ELFPARSER_PROGHEAD_PRIV_H_
+
+#define PROGHEADER_ENTRY_LEN 8 /**< Number of fields in an ELF program header entry */
+
+/* ELF Program Header Field Offsets (common to 32-bit and 64-bit where not specified) */
+#define PROGHEADER_ENTRY_TYPE_OFF           0x00u /**< Offset of segment type (p_type) */
+
+/* 32-bit ELF Program Header Field Offsets */
+#define PROGHEADER_ENTRY_OFFSET_OFF_32BIT   0x04u /**< Offset of file offset (p_offset, 32-bit) */
+#define PROGHEADER_ENTRY_VADDR_OFF_32BIT    0x08u /**< Offset of virtual address (p_vaddr, 32-bit) */
+#define PROGHEADER_ENTRY_PADDR_OFF_32BIT    0x0Cu /**< Offset of physical address (p_paddr, 32-bit) */
+#define PROGHEADER_ENTRY_FILESZ_OFF_32BIT   0x10u /**< Offset of file size (p_filesz, 32-bit) */
+#define PROGHEADER_ENTRY_MEMSZ_OFF_32BIT    0x14u /**< Offset of memory size (p_memsz, 32-bit) */
+#define PROGHEADER_ENTRY_FLAGS_OFF_32BIT    0x18u /**< Offset of segment flags (p_flags, 32-bit) */
+#define PROGHEADER_ENTRY_ALIGN_OFF_32BIT    0x1Cu /**< Offset of alignment (p_align, 32-bit) */
+
+/* 64-bit ELF Program Header Field Offsets */
+#define PROGHEADER_ENTRY_FLAGS_OFF_64BIT    0x04u /**< Offset of segment flags (p_flags, 64-bit) */
+#define PROGHEADER_ENTRY_OFFSET_OFF_64BIT   0x08u /**< Offset of file offset (p_offset, 64-bit) */
+#define PROGHEADER_ENTRY_VADDR_OFF_64BIT    0x10u /**< Offset of virtual address (p_vaddr, 64-bit) */
+#define PROGHEADER_ENTRY_PADDR_OFF_64BIT    0x18u /**< Offset of physical address (p_paddr, 64-bit) */
+#define PROGHEADER_ENTRY_FILESZ_OFF_64BIT   0x20u /**< Offset of file size (p_filesz, 64-bit) */
+#define PROGHEADER_ENTRY_MEMSZ_OFF_64BIT    0x28u /**< Offset of memory size (p_memsz, 64-bit) */
+#define PROGHEADER_ENTRY_ALIGN_OFF_64BIT    0x30u /**< Offset of alignment (p_align, 64-bit) */
+
+/* ELF Program Header Field Sizes */
+#define PROGHEADER_ENTRY_TYPE_SIZE          4u /**< Size of segment type (p_type) */
+#define PROGHEADER_ENTRY_FLAGS_SIZE         4u /**< Size of segment flags (p_flags) */
+#define PROGHEADER_ENTRY_WORD_SIZE_32BIT    4u /**< Size of offset, address, size and alignment fields (32-bit) */
+#define PROGHEADER_ENTRY_WORD_SIZE_64BIT    8u /**< Size of offset, address, size and alignment fields (64-bit) */
+
+#endif /* _IG_ELFPARSER_PROGHEAD_PRIV_H_ */
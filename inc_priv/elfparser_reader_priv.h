@@ -0,0 +1,24 @@
+/**
+ * @file elfparser_reader_priv.h
+ * @brief Private header for byte-range reader constants in libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header defines internal tuning constants of the reader: how large the
+ * block cache of the pread backend may grow before unpinned blocks are
+ * evicted, how far apart prefetched ranges may be and still be merged into
+ * one read, and the page size assumed for hints when the system does not
+ * report one. They are used by elfparser_reader.c and are not part of the
+ * public API.
+ */
+
+#ifndef _IG_ELFPARSER_READER_PRIV_H_
+#define _IG_ELFPARSER_READER_PRIV_H_
+
+#define READER_CACHE_LIMIT      (8u << 20) /**< Bytes of unpinned blocks kept before LRU eviction starts */
+#define READER_COALESCE_GAP     4096u      /**< Largest gap between prefetched ranges that is read rather than skipped */
+#define READER_BLOCK_CAP_INIT   16u        /**< Initial capacity of the block array */
+#define READER_PAGE_SIZE_DEFAULT 4096u     /**< Page size used if sysconf() cannot report it */
+
+#endif /* _IG_ELFPARSER_READER_PRIV_H_ */
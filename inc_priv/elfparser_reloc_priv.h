@@ -0,0 +1,39 @@
+/**
+ * @file elfparser_reloc_priv.h
+ * @brief Private header for ELF relocation table parsing constants in libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header defines internal constants for decoding ELF relocation entries
+ * within the standalone libelfparser library: field offsets and sizes of the
+ * 32-bit and 64-bit Elf_Rel and Elf_Rela layouts and the r_info packing of
+ * both classes. They are used by elfparser_reloc.c and are not part of the
+ * public API.
+ */
+
+#ifndef _IG_ELFPARSER_RELOC_PRIV_H_
+#define _IG_ELFPARSER_RELOC_PRIV_H_
+
+/* ELF Relocation Entry Field Offsets */
+#define RELOC_ENTRY_OFFSET_OFF          0x00u /**< Offset of r_offset */
+#define RELOC_ENTRY_INFO_OFF_32BIT      0x04u /**< Offset of r_info (32-bit) */
+#define RELOC_ENTRY_ADDEND_OFF_32BIT    0x08u /**< Offset of r_addend (32-bit) */
+#define RELOC_ENTRY_INFO_OFF_64BIT      0x08u /**< Offset of r_info (64-bit) */
+#define RELOC_ENTRY_ADDEND_OFF_64BIT    0x10u /**< Offset of r_addend (64-bit) */
+
+/* ELF Relocation Entry Sizes */
+#define RELOC_REL_SIZE_32BIT            8u  /**< Size of Elf32_Rel */
+#define RELOC_RELA_SIZE_32BIT           12u /**< Size of Elf32_Rela */
+#define RELOC_REL_SIZE_64BIT            16u /**< Size of Elf64_Rel */
+#define RELOC_RELA_SIZE_64BIT           24u /**< Size of Elf64_Rela */
+#define RELOC_RELR_SIZE_32BIT           4u  /**< Size of Elf32_Relr */
+#define RELOC_RELR_SIZE_64BIT           8u  /**< Size of Elf64_Relr */
+
+/* r_info Packing */
+#define RELOC_INFO_SYM_SHIFT_32BIT      8u     /**< ELF32_R_SYM(i) is i >> 8 */
+#define RELOC_INFO_TYPE_MASK_32BIT      0xFFu  /**< ELF32_R_TYPE(i) is i & 0xff */
+#define RELOC_INFO_SYM_SHIFT_64BIT      32u    /**< ELF64_R_SYM(i) is i >> 32 */
+#define RELOC_INFO_TYPE_MASK_64BIT      0xFFFFFFFFu /**< ELF64_R_TYPE(i) is i & 0xffffffff */
+
+#endif /* _IG_ELFPARSER_RELOC_PRIV_H_ */
@@ -0,0 +1,31 @@
+/**
+ * @file elfparser_sectcache_priv.h
+ * @brief Private header for compressed section constants in libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header defines the layout of the ELF compression header (Elf32_Chdr
+ * and Elf64_Chdr) that starts an SHF_COMPRESSED section, and the limits the
+ * cache applies before trusting the decompressed size it announces. These
+ * are used by elfparser_sectcache.c and are not part of the public API.
+ */
+
+#ifndef _IG_ELFPARSER_SECTCACHE_PRIV_H_
+#define _IG_ELFPARSER_SECTCACHE_PRIV_H_
+
+/* Compression Header Layout */
+#define SECTCACHE_CHDR32_SIZE           12u /**< Size of Elf32_Chdr */
+#define SECTCACHE_CHDR32_SIZE_OFF       4u  /**< Offset of ch_size in Elf32_Chdr */
+#define SECTCACHE_CHDR64_SIZE           24u /**< Size of Elf64_Chdr */
+#define SECTCACHE_CHDR64_SIZE_OFF       8u  /**< Offset of ch_size in Elf64_Chdr (after ch_type and ch_reserved) */
+#define SECTCACHE_CHDR_TYPE_OFF         0u  /**< Offset of ch_type in both layouts */
+
+/* Limits */
+#define SECTCACHE_ZLIB_RATIO_MAX        1032u       /**< Largest expansion deflate can produce per input byte */
+#define SECTCACHE_ZSTD_RATIO_MAX        32768u      /**< Largest expansion zstd can produce per input byte (4-byte RLE block of 128 KiB) */
+#define SECTCACHE_RAW_SIZE_MAX          (UINT64_C(1) << 32) /**< Largest decompressed section accepted, whatever the ratio */
+#define SECTCACHE_ZLIB_CHUNK_MAX        0x40000000u /**< Bytes handed to inflate() per call (avail_in and avail_out are 32-bit) */
+#define SECTCACHE_ENTRY_INITIAL         16u         /**< Initial capacity of the entry table */
+
+#endif /* _IG_ELFPARSER_SECTCACHE_PRIV_H_ */
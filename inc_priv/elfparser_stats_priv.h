@@ -0,0 +1,95 @@
+/**
+ * @file elfparser_stats_priv.h
+ * @brief Private header for span bookkeeping of the parse functions in libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header declares what the instrumented parse functions use to open and
+ * close spans. A public parse function checks ElfParser_statsActive() and, if
+ * nothing is registered, runs its body directly; otherwise it brackets the
+ * body with ElfParser_statsBegin() and ElfParser_statsEnd(). Allocation and
+ * error sites inside the body report to the innermost open span of the
+ * thread, which ElfParser_parallelFor() hands on to its workers. These are
+ * not part of the public API.
+ */
+
+#ifndef _IG_ELFPARSER_STATS_PRIV_H_
+#define _IG_ELFPARSER_STATS_PRIV_H_
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include "../inc_pub/elfparser_stats.h"
+
+extern _Thread_local int elfparser_stats_on;                /**< Non-zero while the thread has a registration */
+extern _Thread_local elfparser_span_t *elfparser_stats_span; /**< Innermost open span of the thread, NULL if none */
+
+/**
+ * @brief Tells whether spans are collected on the calling thread
+ * @return int Non-zero if a registration exists
+ */
+static inline int ElfParser_statsActive(void)
+{
+    return __builtin_expect(elfparser_stats_on, 0);
+}
+
+/**
+ * @brief Opens a span and runs the begin callback
+ * @param[out] span Span to open, must stay valid until ElfParser_statsEnd()
+ * @param[in] phase Phase of the call
+ */
+void ElfParser_statsBegin(elfparser_span_t *span, elfparser_phase_e phase);
+
+/**
+ * @brief Closes a span, adds it to the registered totals and runs the end callback
+ * @param[in,out] span Span opened by ElfParser_statsBegin() on the same thread
+ * @param[in] ret Return value of the call
+ * @param[in] bytes Bytes of the input read, ignored if ret is an error
+ * @param[in] entries Entries decoded or resolved, ignored if ret is an error
+ */
+void ElfParser_statsEnd(elfparser_span_t *span, int ret, uint64_t bytes, uint64_t entries);
+
+/**
+ * @brief Returns how many bytes of a string table the names of a table reach into
+ * @param[in] map Pointer to the string table
+ * @param[in] map_size Size of the string table in bytes
+ * @param[in] max_idx Largest name offset of the table
+ * @return uint64_t End of the name at max_idx including its terminator, capped at map_size
+ */
+uint64_t ElfParser_statsNameExtent(const void *map, size_t map_size, uint32_t max_idx);
+
+/**
+ * @brief Charges an allocation to the open span of the thread, if any
+ * @param[in] size Requested size in bytes
+ */
+static inline void ElfParser_statsAlloc(size_t size)
+{
+    elfparser_span_t *span = elfparser_stats_span;
+    if (__builtin_expect(span != NULL, 0))
+    {
+        __atomic_fetch_add(&span->allocs, 1, __ATOMIC_RELAXED);  // Workers of a parallel call share the span
+        __atomic_fetch_add(&span->alloc_bytes, (uint64_t)size, __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * @brief Records where in its input the current call failed, keeping the lowest offset
+ *
+ * Only called on error paths.
+ *
+ * @param[in] offset Offset of the first byte that could not be read or was invalid
+ */
+static inline void ElfParser_statsErrorAt(uint64_t offset)
+{
+    elfparser_span_t *span = elfparser_stats_span;
+    if (span)
+    {
+        uint64_t cur = __atomic_load_n(&span->error_offset, __ATOMIC_RELAXED);
+        while (offset < cur && !__atomic_compare_exchange_n(&span->error_offset, &cur, offset, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        {
+            // cur reloaded by the failed exchange
+        }
+    }
+}
+
+#endif /* _IG_ELFPARSER_STATS_PRIV_H_ */
@@ -0,0 +1,82 @@
+/**
+ * @file elfparser_symcache_priv.h
+ * @brief Private header for the on-disk symbol index layout in libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header defines the layout of the index files written by the symbol
+ * cache. An index is a fixed header followed by the section records, the
+ * section name block and, for every symbol table, a table record, the symbol
+ * records and the table's name block. All integers are little-endian, every
+ * block starts 8-byte aligned, and the checksum covers everything after the
+ * checksum field. These constants are used by elfparser_symcache.c and are
+ * not part of the public API.
+ */
+
+#ifndef _IG_ELFPARSER_SYMCACHE_PRIV_H_
+#define _IG_ELFPARSER_SYMCACHE_PRIV_H_
+
+#define SYMCACHE_MAGIC              0x43535045u /**< "EPSC" read as a little-endian word */
+#define SYMCACHE_VERSION            2u          /**< Bumped on every layout change; also the checksum seed */
+#define SYMCACHE_FILE_SUFFIX        ".symcache" /**< Appended to the hex build-id to name an index */
+#define SYMCACHE_PATH_MAX           4096u       /**< Longest index path built */
+#define SYMCACHE_FILE_MAX           (1ull << 31) /**< Larger files are not read as indices */
+#define SYMCACHE_ALIGN              8u          /**< Alignment of every block */
+
+/* Index Header Field Offsets */
+#define SYMCACHE_HDR_MAGIC_OFF          0x00u /**< Magic number (u32) */
+#define SYMCACHE_HDR_VERSION_OFF        0x04u /**< Layout version (u32) */
+#define SYMCACHE_HDR_CHECKSUM_OFF       0x08u /**< Hash of all bytes from SYMCACHE_HDR_CHECKED_OFF on (u64) */
+#define SYMCACHE_HDR_CHECKED_OFF        0x10u /**< First byte covered by the checksum */
+#define SYMCACHE_HDR_PAYLOAD_SIZE_OFF   0x10u /**< Bytes following the header (u64) */
+#define SYMCACHE_HDR_FILE_SIZE_OFF      0x18u /**< Size of the indexed ELF file (u64) */
+#define SYMCACHE_HDR_SECT_OFF_OFF       0x20u /**< e_shoff of the indexed file (u64) */
+#define SYMCACHE_HDR_SECT_BLOB_OFF      0x28u /**< Size of the section name block (u64) */
+#define SYMCACHE_HDR_SECT_NUM_OFF       0x30u /**< Number of section records (u32) */
+#define SYMCACHE_HDR_SECT_STRTAB_OFF    0x34u /**< Index of the section name string table (u32) */
+#define SYMCACHE_HDR_TABLE_NUM_OFF      0x38u /**< Number of symbol tables (u32) */
+#define SYMCACHE_HDR_BUILD_ID_LEN_OFF   0x3Cu /**< Length of the build-id (u32) */
+#define SYMCACHE_HDR_CLASS_OFF          0x40u /**< ELF class (u8) */
+#define SYMCACHE_HDR_DATA_OFF           0x41u /**< ELF data encoding (u8) */
+#define SYMCACHE_HDR_MACHINE_OFF        0x42u /**< e_machine (u16) */
+#define SYMCACHE_HDR_SECT_ENTSIZE_OFF   0x44u /**< e_shentsize (u16) */
+#define SYMCACHE_HDR_BUILD_ID_OFF       0x48u /**< Build-id bytes, ELFPARSER_NOTE_BUILD_ID_MAX reserved */
+#define SYMCACHE_HDR_FILE_INO_OFF       0x88u /**< Inode of the indexed file (u64) */
+#define SYMCACHE_HDR_FILE_MTIME_OFF     0x90u /**< Modification time of the indexed file in nanoseconds (u64) */
+#define SYMCACHE_HDR_SIZE               0x98u /**< Size of the index header */
+
+/* Section Record Field Offsets */
+#define SYMCACHE_SECT_NAME_IDX_OFF      0x00u /**< sh_name (u32) */
+#define SYMCACHE_SECT_NAME_LEN_OFF      0x04u /**< Length of the name (u32) */
+#define SYMCACHE_SECT_TYPE_OFF          0x08u /**< sh_type (u32) */
+#define SYMCACHE_SECT_LINK_OFF          0x0Cu /**< sh_link (u32) */
+#define SYMCACHE_SECT_INFO_OFF          0x10u /**< sh_info (u32) */
+#define SYMCACHE_SECT_FLAGS_OFF         0x18u /**< sh_flags (u64) */
+#define SYMCACHE_SECT_ADDR_OFF          0x20u /**< sh_addr (u64) */
+#define SYMCACHE_SECT_OFFSET_OFF        0x28u /**< sh_offset (u64) */
+#define SYMCACHE_SECT_SIZE_OFF          0x30u /**< sh_size (u64) */
+#define SYMCACHE_SECT_ADDRALIGN_OFF     0x38u /**< sh_addralign (u64) */
+#define SYMCACHE_SECT_ENTSIZE_OFF       0x40u /**< sh_entsize (u64) */
+#define SYMCACHE_SECT_RECORD_SIZE       0x48u /**< Size of a section record */
+
+/* Symbol Table Record Field Offsets */
+#define SYMCACHE_TABLE_SECT_IDX_OFF     0x00u /**< Index of the symbol table section (u32) */
+#define SYMCACHE_TABLE_SYM_NUM_OFF      0x04u /**< Number of symbol records (u32) */
+#define SYMCACHE_TABLE_STRTAB_OFF       0x08u /**< Index of the linked string table (u32) */
+#define SYMCACHE_TABLE_ENTSIZE_OFF      0x0Cu /**< sh_entsize of the table (u32) */
+#define SYMCACHE_TABLE_BLOB_OFF         0x10u /**< Size of the table's name block (u64) */
+#define SYMCACHE_TABLE_RECORD_SIZE      0x18u /**< Size of a symbol table record */
+
+/* Symbol Record Field Offsets */
+#define SYMCACHE_SYM_VALUE_OFF          0x00u /**< st_value (u64) */
+#define SYMCACHE_SYM_SIZE_OFF           0x08u /**< st_size (u64) */
+#define SYMCACHE_SYM_NAME_IDX_OFF       0x10u /**< st_name (u32) */
+#define SYMCACHE_SYM_NAME_LEN_OFF       0x14u /**< Length of the name (u32) */
+#define SYMCACHE_SYM_SECT_IDX_OFF       0x18u /**< Resolved section index (u32) */
+#define SYMCACHE_SYM_BIND_OFF           0x1Cu /**< Binding (u8) */
+#define SYMCACHE_SYM_TYPE_OFF           0x1Du /**< Type (u8) */
+#define SYMCACHE_SYM_VISIBILITY_OFF     0x1Eu /**< Visibility (u8) */
+#define SYMCACHE_SYM_RECORD_SIZE        0x20u /**< Size of a symbol record */
+
+#endif /* _IG_ELFPARSER_SYMCACHE_PRIV_H_ */
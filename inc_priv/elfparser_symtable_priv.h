@@ -7,14 +7,18 @@
  *
  * This header defines internal constants for parsing ELF symbol tables within
  * the standalone libelfparser library. It includes offsets and sizes for symbol
- * table fields, supporting both 32-bit and 64-bit formats, as well as the name
- * of the string table section. These constants are used by elfparser_symtable.c
- * and are not part of the public API.
+ * table fields, supporting both 32-bit and 64-bit formats, as well as the
+ * shared entry decoder. These are used by elfparser_symtable.c and its
+ * sibling modules and are not part of the public API.
  */
 
 #ifndef _IG_ELFPARSER_SYMTABLE_PRIV_H_
 #define _IG_ELFPARSER_SYMTABLE_PRIV_H_
 
+#include <inttypes.h>
+#include <stdlib.h>
+#include "../inc_pub/elfparser_symtable.h"
+
 #define SYMTABLE_ENTRY_LEN 6 /**< Number of fields in an ELF symbol table entry */
 
 /* ELF Symbol Table Field Offsets */
@@ -44,7 +48,26 @@
 #define SYMTABLE_ENTRY_SIZE_SIZE_32BIT  4u /**< Size of symbol size (st_size, 32-bit) */
 #define SYMTABLE_ENTRY_SIZE_SIZE_64BIT  8u /**< Size of symbol size (st_size, 64-bit) */
 
-/* String Table Section Name */
-#define SYMTABLE_STRING_SECT_NAME ".strtab" /**< Name of the string table section containing symbol names */
+/* Extended Section Index Table (SHT_SYMTAB_SHNDX) */
+#define SYMTABLE_SHNDX_WORD_SIZE        4u /**< Size of one extended section index word */
+
+/* Parallel Parsing */
+#define SYMTABLE_PARALLEL_CHUNK_SIZE    16384u /**< Entries decoded or resolved per work chunk */
+
+/**
+ * @brief Decodes consecutive raw symbol table entries
+ * @param[out] entries Destination array of at least count entries
+ * @param[in] src Pointer to the first raw entry
+ * @param[in] src_size Number of bytes available at src
+ * @param[in] count Number of entries to decode
+ * @param[in] entry_size Distance between raw entries in bytes
+ * @param[in] elf_class ELF class of the raw entries
+ * @param[in] elf_data Data encoding of the raw entries
+ * @param[in,out] max_idx Raised to the largest st_name encountered
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_SymTable_entriesDecode(elfparser_symtable_entry_t *entries, const void *src, size_t src_size, size_t count,
+                                     size_t entry_size, elfparser_header_class_e elf_class,
+                                     elfparser_header_data_e elf_data, uint32_t *max_idx);
 
 #endif /* _IG_ELFPARSER_SYMTABLE_PRIV_H_ */
\ No newline at end of file
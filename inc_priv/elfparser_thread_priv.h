@@ -0,0 +1,69 @@
+/**
+ * @file elfparser_thread_priv.h
+ * @brief Private header for the chunked parallel loop in libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header declares the minimal threading helper used by the parallel
+ * parse and resolve functions. A range of items is cut into fixed-size chunks
+ * that a short-lived group of POSIX threads claims from a shared counter. The
+ * result is deterministic: the error reported is the one of the lowest failing
+ * chunk, whatever the scheduling. It is not part of the public API.
+ */
+
+#ifndef _IG_ELFPARSER_THREAD_PRIV_H_
+#define _IG_ELFPARSER_THREAD_PRIV_H_
+
+#include <inttypes.h>
+#include <stdlib.h>
+
+#define ELFPARSER_THREAD_NUM_MAX 256u /**< Upper bound on worker threads per call */
+
+/**
+ * @brief Work function run for one chunk of the range
+ * @param[in,out] ctx Caller context shared by all chunks
+ * @param[in] chunk_idx Index of the chunk
+ * @param[in] begin First item of the chunk
+ * @param[in] end One past the last item of the chunk
+ * @return int ELFPARSER_SUCCESS, or an ElfParser_Error code for the first failing item of the chunk
+ */
+typedef int (*elfparser_chunk_fn_t)(void *ctx, size_t chunk_idx, size_t begin, size_t end);
+
+/**
+ * @brief Turns a requested thread count into the number of threads to run
+ * @param[in] thread_num Requested number of threads, 0 for one per online CPU
+ * @param[in] work_num Number of independent work items (chunks, files) available
+ * @return uint32_t Thread count between 1 and ELFPARSER_THREAD_NUM_MAX, never above work_num unless work_num is 0
+ */
+uint32_t ElfParser_threadNumResolve(uint32_t thread_num, size_t work_num);
+
+/**
+ * @brief Runs a function over all chunks of an item range on a group of threads
+ *
+ * The calling thread takes part in the work, so thread_num - 1 threads are
+ * started; if starting one fails the remaining ones (or the caller alone)
+ * finish the range. Chunks after an already failed one are skipped.
+ *
+ * @param[in] item_num Number of items in the range
+ * @param[in] chunk_size Items per chunk (the last chunk may be shorter)
+ * @param[in] thread_num Number of threads, 0 for one per online CPU
+ * @param[in] fn Work function
+ * @param[in,out] ctx Context passed to fn
+ * @return int ELFPARSER_SUCCESS if every chunk succeeded, the error of the lowest failing chunk,
+ *             or ELFPARSER_ERR_NULL / ELFPARSER_ERR_MALLOC
+ */
+int ElfParser_parallelFor(size_t item_num, size_t chunk_size, uint32_t thread_num, elfparser_chunk_fn_t fn, void *ctx);
+
+/**
+ * @brief Returns the number of chunks ElfParser_parallelFor() cuts a range into
+ * @param[in] item_num Number of items in the range
+ * @param[in] chunk_size Items per chunk
+ * @return size_t Number of chunks
+ */
+static inline size_t ElfParser_chunkNum(size_t item_num, size_t chunk_size)
+{
+    return chunk_size ? (item_num + chunk_size - 1) / chunk_size : 0;
+}
+
+#endif /* _IG_ELFPARSER_THREAD_PRIV_H_ */
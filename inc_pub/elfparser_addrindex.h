@@ -0,0 +1,83 @@
+/**
+ * @file elfparser_addrindex.h
+ * @brief Public header for the address-to-symbol index in libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header provides the public interface for mapping addresses to the
+ * function or object symbol that covers them. The index flattens the
+ * (possibly overlapping) symbol ranges of a parsed symbol table into sorted,
+ * disjoint segments and keeps their start addresses in an Eytzinger (BFS)
+ * layout, so a single lookup is a branch-free, cache-friendly O(log n) search
+ * and a batch of ascending addresses is answered in one linear merge.
+ *
+ * Resolution rules, applied deterministically:
+ * - only defined STT_FUNC and STT_OBJECT symbols are indexed;
+ * - a zero-size symbol covers exactly its own address;
+ * - where ranges overlap, the symbol with the highest start address wins
+ *   (the innermost one for nested ranges), then the shorter one, then the
+ *   one with the lower symbol table index.
+ */
+
+#ifndef _IG_ELFPARSER_ADDRINDEX_H_
+#define _IG_ELFPARSER_ADDRINDEX_H_
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include "../inc_pub/elfparser_common.h"
+#include "../inc_pub/elfparser_symtable.h"
+
+/**
+ * @brief Structure representing the address-to-symbol index
+ */
+typedef struct elfparser_addrindex_s
+{
+    uint64_t*   seg_start;  /**< Start address of each segment, ascending */
+    uint64_t*   seg_end;    /**< Exclusive end address of each segment */
+    uint32_t*   seg_sym;    /**< Symbol table index owning each segment */
+    uint64_t*   eyt_start;  /**< Segment starts in Eytzinger order, 1-based */
+    uint32_t*   eyt_seg;    /**< Segment index of each Eytzinger slot, 1-based */
+    uint32_t    seg_num;    /**< Number of segments */
+} elfparser_addrindex_t;
+
+/**
+ * @brief Builds an address index from the FUNC and OBJECT symbols of a parsed symbol table
+ * @param[out] addr_index Pointer to the index structure to populate
+ * @param[in] symbol_table Pointer to a parsed symbol table (names need not be resolved)
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_AddrIndex_build(elfparser_addrindex_t *addr_index, const elfparser_symtable_t *symbol_table);
+
+/**
+ * @brief Finds the symbol covering an address
+ * @param[in] addr_index Pointer to the index structure
+ * @param[in] addr Address to resolve
+ * @return int64_t Symbol table index, ELFPARSER_ERR_NOT_FOUND if no symbol covers addr,
+ *                 or an ElfParser_Error code on failure
+ */
+int64_t ElfParser_AddrIndex_lookup(const elfparser_addrindex_t *addr_index, uint64_t addr);
+
+/**
+ * @brief Resolves a batch of addresses, in amortized linear time when they are sorted ascending
+ *
+ * Sorted input is answered with a single merge walk over the segments; an
+ * address that is lower than its predecessor falls back to a logarithmic
+ * search, so unsorted input is still answered correctly.
+ *
+ * @param[in] addr_index Pointer to the index structure
+ * @param[in] addrs Addresses to resolve
+ * @param[in] addr_num Number of addresses
+ * @param[out] sym_idx Per address: symbol table index, or ELFPARSER_ERR_NOT_FOUND
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_AddrIndex_batchLookup(const elfparser_addrindex_t *addr_index, const uint64_t *addrs, size_t addr_num, int64_t *sym_idx);
+
+/**
+ * @brief Frees the resources held by an address index
+ * @param[in,out] addr_index Pointer to the index structure to free
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_AddrIndex_free(elfparser_addrindex_t *addr_index);
+
+#endif /* _IG_ELFPARSER_ADDRINDEX_H_ */
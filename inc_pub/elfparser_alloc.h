@@ -0,0 +1,124 @@
+/**
+ * @file elfparser_alloc.h
+ * @brief Public header for pluggable allocators in libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header provides the allocator interface the section header and symbol
+ * table modules allocate their tables and names through, plus two
+ * implementations of it. A NULL allocator everywhere means malloc and free.
+ * The other modules (file reader, program headers, relocations, symbol index
+ * and symbol cache) take no allocator and use malloc and free directly.
+ *
+ * The bump arena hands out memory from large blocks and frees nothing on its
+ * own: everything parsed through it is released at once by
+ * ElfParser_Alloc_arenaReset(), which keeps the blocks for the next round, so
+ * request-scoped parsing stops fragmenting the heap. The pool keeps freed
+ * blocks in per-thread, per-size-class lists, so repeated parse and free
+ * cycles recycle memory without touching malloc or taking a lock.
+ */
+
+#ifndef _IG_ELFPARSER_ALLOC_H_
+#define _IG_ELFPARSER_ALLOC_H_
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include "../inc_pub/elfparser_common.h"
+
+/* Allocator Flags */
+#define ELFPARSER_ALLOC_FLAG_THREAD_SAFE 0x00000001u /**< alloc_fn and free_fn may be called from several threads at once */
+
+/**
+ * @brief Allocator interface
+ *
+ * alloc_fn returns size bytes aligned for any type, or NULL on failure.
+ * free_fn releases a block returned by alloc_fn of the same allocator; it
+ * may be NULL for allocators that only release memory in bulk, in which case
+ * the library skips per-name frees entirely.
+ */
+typedef struct elfparser_alloc_s
+{
+    void*       (*alloc_fn)(void *ctx, size_t size);    /**< Allocates a block */
+    void        (*free_fn)(void *ctx, void *ptr);       /**< Releases a block, NULL if blocks are only released in bulk */
+    void*       ctx;                                    /**< Passed to both functions */
+    uint32_t    flags;                                  /**< ELFPARSER_ALLOC_FLAG_* values */
+} elfparser_alloc_t;
+
+/**
+ * @brief Structure representing one block of a bump arena
+ */
+typedef struct elfparser_arena_block_s
+{
+    char*   data;   /**< Block memory */
+    size_t  size;   /**< Size of the block in bytes */
+} elfparser_arena_block_t;
+
+/**
+ * @brief Structure representing a bump arena, not thread-safe
+ */
+typedef struct elfparser_arena_s
+{
+    elfparser_alloc_t           alloc;      /**< Allocator handing out arena memory, pass &arena->alloc */
+    elfparser_arena_block_t*    blocks;     /**< Blocks, kept across resets */
+    uint32_t                    block_num;  /**< Number of blocks */
+    uint32_t                    block_cap;  /**< Capacity of blocks */
+    uint32_t                    block_idx;  /**< Block currently allocated from */
+    char*                       cur;        /**< Free space in the current block */
+    size_t                      cur_left;   /**< Bytes left at cur */
+    size_t                      block_size; /**< Size of new blocks (larger requests get a block of their own size) */
+    size_t                      used;       /**< Bytes handed out since the last reset */
+    size_t                      reserved;   /**< Bytes held in blocks */
+} elfparser_arena_t;
+
+/**
+ * @brief Initializes an empty bump arena
+ *
+ * The arena must stay at the same address while its allocator is in use,
+ * since arena->alloc points back to it.
+ *
+ * @param[out] arena Pointer to the arena to initialize, released with ElfParser_Alloc_arenaFree()
+ * @param[in] block_size Size of each block in bytes, 0 for the default
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_Alloc_arenaInit(elfparser_arena_t *arena, size_t block_size);
+
+/**
+ * @brief Releases everything allocated from the arena at once, keeping its blocks for reuse
+ *
+ * Tables and names allocated from the arena become invalid; their _free
+ * functions must not be called afterwards.
+ *
+ * @param[in,out] arena Pointer to an initialized arena
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_Alloc_arenaReset(elfparser_arena_t *arena);
+
+/**
+ * @brief Returns the blocks of the arena to the system
+ * @param[in,out] arena Pointer to the arena to free
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_Alloc_arenaFree(elfparser_arena_t *arena);
+
+/**
+ * @brief Returns the process-wide pool allocator with per-thread caches
+ *
+ * Small blocks are rounded up to a power-of-two size class; a freed block
+ * goes to the free list of its class in the freeing thread and is handed out
+ * again by that thread, so no lock is taken. Large blocks go straight to
+ * malloc. A thread's cached blocks are returned to the system when it exits
+ * or calls ElfParser_Alloc_poolTrim(); blocks freed by other thread exit
+ * destructors after that go straight back to the system.
+ *
+ * @return const elfparser_alloc_t* Pointer to the pool allocator, thread-safe
+ */
+const elfparser_alloc_t *ElfParser_Alloc_pool(void);
+
+/**
+ * @brief Returns the blocks cached by the calling thread's pool to the system
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_Alloc_poolTrim(void);
+
+#endif /* _IG_ELFPARSER_ALLOC_H_ */
@@ -0,0 +1,105 @@
+/**
+ * @file elfparser_batch.h
+ * @brief Public header for parsing many ELF files in parallel in libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header provides the batch engine. Given a list of paths, it opens each
+ * file, parses its header and section header table and loads every symbol
+ * table, on a pool of threads that steal work from each other so that all
+ * cores stay busy even when a few files are orders of magnitude larger than
+ * the rest. Each file is handed to a callback as soon as it is done, with its
+ * own error code, and the run ends with throughput statistics.
+ */
+
+#ifndef _IG_ELFPARSER_BATCH_H_
+#define _IG_ELFPARSER_BATCH_H_
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include "../inc_pub/elfparser_common.h"
+#include "../inc_pub/elfparser_file.h"
+#include "../inc_pub/elfparser_symtable.h"
+
+/**
+ * @brief Enumeration of the per-file stages, used to tell where a file failed
+ */
+typedef enum
+{
+    ELFPARSER_BATCH_STAGE_OPEN     = 0, /**< Opening the file */
+    ELFPARSER_BATCH_STAGE_HEADER   = 1, /**< Parsing the ELF header */
+    ELFPARSER_BATCH_STAGE_SECTHEAD = 2, /**< Parsing the section header table */
+    ELFPARSER_BATCH_STAGE_SYMTABLE = 3, /**< Loading the symbol tables */
+    ELFPARSER_BATCH_STAGE_DONE     = 4  /**< Every stage succeeded */
+} elfparser_batch_stage_e;
+
+/**
+ * @brief Outcome of one file, passed to the callback
+ *
+ * file and sym_tables are owned by the engine and released when the callback
+ * returns; copy out whatever has to outlive it.
+ */
+typedef struct elfparser_batch_result_s
+{
+    const char*                 path;          /**< Path as given in the list */
+    size_t                      path_idx;      /**< Index of path in the list */
+    int                         status;        /**< ELFPARSER_SUCCESS, or the first error encountered */
+    elfparser_batch_stage_e     stage;         /**< Stage that failed, ELFPARSER_BATCH_STAGE_DONE on success */
+    uint64_t                    file_size;     /**< Size of the file in bytes (0 if it could not be opened) */
+    elfparser_file_t*           file;          /**< Open file with header and section headers parsed as far as stage got, NULL if not opened */
+    elfparser_symtable_t*       sym_tables;    /**< Symbol tables loaded before any failure */
+    uint32_t                    sym_table_num; /**< Number of entries in sym_tables */
+    uint64_t                    sym_num;       /**< Total number of symbols in sym_tables */
+    uint32_t                    thread_idx;    /**< Worker that processed the file, 0 being the calling thread */
+} elfparser_batch_result_t;
+
+/**
+ * @brief Callback receiving each file as it completes
+ *
+ * Called concurrently from all workers; it must be thread-safe.
+ *
+ * @param[in,out] ctx Caller context given to ElfParser_Batch_run()
+ * @param[in] result Outcome of the file
+ */
+typedef void (*elfparser_batch_fn_t)(void *ctx, const elfparser_batch_result_t *result);
+
+/**
+ * @brief Totals of one ElfParser_Batch_run() call
+ */
+typedef struct elfparser_batch_stats_s
+{
+    uint64_t  file_num;       /**< Files processed */
+    uint64_t  file_failed;    /**< Files whose status is an error */
+    uint64_t  byte_num;       /**< Sum of the sizes of all opened files */
+    uint64_t  sym_num;        /**< Symbols loaded over all files */
+    uint64_t  steal_num;      /**< Times a worker took files from another worker's queue */
+    uint32_t  thread_num;     /**< Workers used, including the calling thread */
+    uint64_t  wall_ns;        /**< Elapsed time of the run in nanoseconds */
+    double    files_per_sec;  /**< file_num per second of wall time */
+    double    mb_per_sec;     /**< byte_num in MB (10^6 bytes) per second of wall time */
+} elfparser_batch_stats_t;
+
+/**
+ * @brief Parses a list of ELF files on a work-stealing thread pool
+ *
+ * Every worker starts with an equal contiguous share of the list and takes
+ * files from its front; a worker that runs dry steals the back half of the
+ * fullest remaining share. The calling thread is one of the workers. A
+ * failing file does not stop the run; its error is reported through the
+ * callback and counted in stats.
+ *
+ * @param[in] paths Paths of the files
+ * @param[in] path_num Number of paths
+ * @param[in] thread_num Number of workers, 0 for one per online CPU
+ * @param[in] file_flags ELFPARSER_FILE_FLAG_* values every file is opened with
+ * @param[in] fn Callback receiving each file, may be NULL if only stats are wanted
+ * @param[in,out] ctx Caller context passed to fn
+ * @param[out] stats Optional destination of the run totals
+ * @return int ELFPARSER_SUCCESS if the run completed (individual files may have failed),
+ *             or an ElfParser_Error code if it could not be carried out
+ */
+int ElfParser_Batch_run(const char *const *paths, size_t path_num, uint32_t thread_num, uint32_t file_flags,
+                        elfparser_batch_fn_t fn, void *ctx, elfparser_batch_stats_t *stats);
+
+#endif /* _IG_ELFPARSER_BATCH_H_ */
@@ -27,7 +27,18 @@ enum ElfParser_Error {
     ELFPARSER_ERR_MALLOC    = -5,   /**< Memory allocation failed */
     ELFPARSER_ERR_RANGE     = -6,   /**< Range or bounds error (e.g., invalid index or overflow) */
     ELFPARSER_ERR_NOT_FOUND = -7,   /**< Requested item (e.g., section, symbol) not found */
-    ELFPARSER_ERR_MEMCPY    = -8    /**< Memory copy operation failed */
+    ELFPARSER_ERR_MEMCPY    = -8,   /**< Memory copy operation failed */
+    ELFPARSER_ERR_IO        = -9    /**< File could not be opened, inspected or mapped (see errno) */
 };
 
+/**
+ * @brief Enumeration of ownership modes for resolved section and symbol names
+ */
+typedef enum
+{
+    ELFPARSER_NAME_MODE_OWNED = 0, /**< Each name is a separately allocated copy (default) */
+    ELFPARSER_NAME_MODE_VIEW  = 1, /**< Names point into the caller's map, nothing is allocated */
+    ELFPARSER_NAME_MODE_ARENA = 2  /**< Names point into one block owned by the table (name_arena) */
+} elfparser_name_mode_e;
+
 #endif /* _IG_ELFPARSER_COMMON_H_ */
@@ -0,0 +1,132 @@
+/**
+ * @file elfparser_demangle.h
+ * @brief Public header for the Itanium C++ demangler of libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header provides demangling of Itanium C++ ABI symbol names (those
+ * starting with _Z) in-process, producing the same text as GNU c++filt. A
+ * single name can be demangled into a caller buffer; whole symbol tables go
+ * through a demangler that memoizes every mangled name it has seen, so the
+ * many repeats of template-heavy code are demangled once, and stores the
+ * results in an arena of large blocks instead of one allocation per name.
+ * Bulk demangling of a table can be spread over several threads.
+ *
+ * Names outside the supported grammar (new-expressions, noexcept
+ * expressions, C++20 requires clauses and template parameter declarations)
+ * are reported as not demangleable, so callers keep the mangled name just as
+ * c++filt does.
+ */
+
+#ifndef _IG_ELFPARSER_DEMANGLE_H_
+#define _IG_ELFPARSER_DEMANGLE_H_
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include "../inc_pub/elfparser_common.h"
+#include "../inc_pub/elfparser_symtable.h"
+
+/**
+ * @brief Structure representing one slot of the memo hash table
+ */
+typedef struct elfparser_demangle_slot_s
+{
+    uint32_t hash;      /**< Precomputed hash of the mangled name stored in this slot */
+    uint32_t entry_idx; /**< Index of the entry, plus one (0 marks an empty slot) */
+} elfparser_demangle_slot_t;
+
+/**
+ * @brief Structure representing one memoized name
+ */
+typedef struct elfparser_demangle_entry_s
+{
+    const char* mangled;    /**< Mangled name, copied into the arena */
+    const char* demangled;  /**< Demangled name in the arena, NULL if the name cannot be demangled */
+} elfparser_demangle_entry_t;
+
+/**
+ * @brief Counters of a demangler
+ */
+typedef struct elfparser_demangle_stats_s
+{
+    uint64_t  lookups;    /**< Mangled names asked for */
+    uint64_t  memo_hits;  /**< Lookups answered by an earlier result */
+    uint64_t  demangled;  /**< Distinct names demangled successfully */
+    uint64_t  failed;     /**< Distinct names that could not be demangled */
+} elfparser_demangle_stats_t;
+
+/**
+ * @brief Structure representing a memoizing demangler
+ */
+typedef struct elfparser_demangle_s
+{
+    elfparser_demangle_slot_t*  slots;      /**< Open-addressing memo slots */
+    uint32_t                    slot_mask;  /**< Number of slots minus one (slot count is a power of two) */
+    elfparser_demangle_entry_t* entries;    /**< Memoized names in insertion order */
+    uint32_t                    entry_num;  /**< Number of entries */
+    uint32_t                    entry_cap;  /**< Capacity of entries */
+    char**                      blocks;     /**< Arena blocks holding mangled copies and results */
+    uint32_t                    block_num;  /**< Number of arena blocks */
+    uint32_t                    block_cap;  /**< Capacity of blocks */
+    char*                       cur;        /**< Free space in the last block used by ElfParser_Demangle_get() */
+    size_t                      cur_left;   /**< Bytes left at cur */
+    size_t                      arena_size; /**< Bytes held by the arena */
+    void*                       scratch;    /**< Work buffers of ElfParser_Demangle_get(), NULL until first used */
+    elfparser_demangle_stats_t  stats;      /**< Counters */
+} elfparser_demangle_t;
+
+/**
+ * @brief Demangles one name into a caller buffer
+ * @param[in] mangled Mangled name, starting with _Z
+ * @param[out] out Buffer receiving the null-terminated demangled name
+ * @param[in] out_size Size of out in bytes
+ * @param[out] out_len Set to the length of the demangled name without terminator, also when out is too small (may be NULL)
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_FORMAT if the name is not a supported mangled name,
+ *             ELFPARSER_ERR_SIZE if out is too small, or an ElfParser_Error code on failure
+ */
+int ElfParser_Demangle_name(const char *mangled, char *out, size_t out_size, size_t *out_len);
+
+/**
+ * @brief Initializes an empty demangler
+ * @param[out] demangle Pointer to the demangler to initialize, released with ElfParser_Demangle_free()
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_Demangle_init(elfparser_demangle_t *demangle);
+
+/**
+ * @brief Demangles one name through the memo
+ * @param[in,out] demangle Pointer to an initialized demangler
+ * @param[in] mangled Mangled name, starting with _Z
+ * @param[out] demangled Set to the demangled name, valid until the demangler is freed; NULL if it cannot be demangled
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_FORMAT if the name is not a supported mangled name,
+ *             or an ElfParser_Error code on failure
+ */
+int ElfParser_Demangle_get(elfparser_demangle_t *demangle, const char *mangled, const char **demangled);
+
+/**
+ * @brief Demangles every name of a symbol table through the memo
+ *
+ * Names already in the memo are answered from it; the distinct new ones are
+ * demangled on up to thread_num threads and added to it. names[i] is the
+ * demangled name of symbol i, or its sym_name itself when that is not a
+ * mangled C++ name or cannot be demangled. Demangled names stay valid until
+ * the demangler is freed.
+ *
+ * @param[in,out] demangle Pointer to an initialized demangler, used by this thread only
+ * @param[in] symbol_table Pointer to the symbol table; names must already be resolved
+ * @param[in] thread_num Number of threads to use, 0 for one per online CPU
+ * @param[out] names Array of table_len names to fill
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_Demangle_symTable(elfparser_demangle_t *demangle, const elfparser_symtable_t *symbol_table, uint32_t thread_num,
+                                const char **names);
+
+/**
+ * @brief Frees the memo, the arena and the demangler itself
+ * @param[in,out] demangle Pointer to the demangler to free
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_Demangle_free(elfparser_demangle_t *demangle);
+
+#endif /* _IG_ELFPARSER_DEMANGLE_H_ */
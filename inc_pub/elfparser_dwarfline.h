@@ -0,0 +1,183 @@
+/**
+ * @file elfparser_dwarfline.h
+ * @brief Public header for DWARF line table lookups in libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header provides address to source file and line resolution from the
+ * .debug_line section of an ELF file, DWARF versions 2 to 5 in either format
+ * and data encoding. Decoding is lazy and per compile unit: opening reads the
+ * address ranges of every unit from .debug_aranges, and a line program is only
+ * decoded, into a compact table of rows sorted by address, the first time a
+ * lookup lands in one of its ranges. Addresses that no range covers (files
+ * without .debug_aranges, or units it omits) trigger one sweep that decodes
+ * every unit not yet reachable through a range and indexes its sequences.
+ * Batched lookups keep the range and row of the previous hit, so runs of
+ * nearby addresses skip the range search and ascending runs search rows from
+ * the previous hit onwards.
+ *
+ * A line table object lazily mutates itself and is not thread-safe; use one
+ * per thread or serialize access. Compressed debug sections (SHF_COMPRESSED)
+ * are decompressed through a section cache when the table is opened with
+ * ElfParser_DwarfLine_openCached(), and rejected otherwise. Split DWARF units
+ * (.dwo) are not followed.
+ */
+
+#ifndef _IG_ELFPARSER_DWARFLINE_H_
+#define _IG_ELFPARSER_DWARFLINE_H_
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include "../inc_pub/elfparser_common.h"
+#include "../inc_pub/elfparser_file.h"
+#include "../inc_pub/elfparser_sectcache.h"
+
+#define ELFPARSER_DWARFLINE_FILE_END    UINT32_MAX /**< row_file of the row ending a sequence */
+#define ELFPARSER_DWARFLINE_OFFSET_NONE UINT64_MAX /**< Unknown section offset of a unit */
+#define ELFPARSER_DWARFLINE_AUX_NUM     4u         /**< Auxiliary sections fetched on demand */
+
+/**
+ * @brief Enumeration of the decoding state of a unit
+ */
+typedef enum
+{
+    ELFPARSER_DWARFLINE_UNIT_PENDING = 0,  /**< Not decoded yet */
+    ELFPARSER_DWARFLINE_UNIT_DECODED = 1,  /**< rows and file names are valid */
+    ELFPARSER_DWARFLINE_UNIT_INVALID = 2   /**< Malformed; treated as having no rows */
+} elfparser_dwarfline_unit_state_e;
+
+/**
+ * @brief Structure representing one row of a decoded line table
+ */
+typedef struct elfparser_dwarfline_row_s
+{
+    uint64_t row_addr;  /**< First address of the row */
+    uint32_t row_file;  /**< File index into the unit's file names, ELFPARSER_DWARFLINE_FILE_END ends a sequence */
+    uint32_t row_line;  /**< Source line, 0 if the instructions have no line */
+} elfparser_dwarfline_row_t;
+
+/**
+ * @brief Structure representing one compile unit and its line program
+ */
+typedef struct elfparser_dwarfline_unit_s
+{
+    uint64_t                        info_offset;   /**< Offset of the unit in .debug_info, ELFPARSER_DWARFLINE_OFFSET_NONE if found through .debug_line */
+    uint64_t                        line_offset;   /**< Offset of the line program in .debug_line, ELFPARSER_DWARFLINE_OFFSET_NONE until resolved */
+    elfparser_dwarfline_row_t*      rows;          /**< Rows sorted by address, sequences one after another */
+    uint32_t                        row_num;       /**< Number of rows */
+    uint32_t                        file_num;      /**< Number of file names */
+    uint32_t*                       file_name_off; /**< Offset of each file name in name_arena */
+    char*                           name_arena;    /**< Joined directory and file names, NUL-separated */
+    elfparser_dwarfline_unit_state_e state;        /**< Decoding state */
+} elfparser_dwarfline_unit_t;
+
+/**
+ * @brief Structure representing an address range covered by one unit
+ */
+typedef struct elfparser_dwarfline_range_s
+{
+    uint64_t range_start;  /**< First address */
+    uint64_t range_end;    /**< One past the last address */
+    uint32_t unit_idx;     /**< Index of the unit in units */
+} elfparser_dwarfline_range_t;
+
+/**
+ * @brief Structure representing the lazily decoded line tables of one file
+ */
+typedef struct elfparser_dwarfline_s
+{
+    elfparser_file_t*               file;          /**< File the sections are read from, must outlive the structure */
+    elfparser_sectcache_t*          cache;         /**< Cache sections are fetched through, NULL to read them from the file only */
+    const uint8_t*                  line_data;     /**< Contents of .debug_line */
+    size_t                          line_size;     /**< Size of .debug_line in bytes */
+    int                             big_endian;    /**< Non-zero for big-endian data */
+    uint8_t                         addr_size;     /**< Size of a target address in bytes */
+    uint8_t                         swept;         /**< Every unit has been decoded or ranged */
+    uint8_t                         aux_ready[ELFPARSER_DWARFLINE_AUX_NUM]; /**< Auxiliary section fetched or known absent */
+    const uint8_t*                  aux_data[ELFPARSER_DWARFLINE_AUX_NUM];  /**< .debug_line_str, .debug_str, .debug_info, .debug_abbrev */
+    size_t                          aux_size[ELFPARSER_DWARFLINE_AUX_NUM];  /**< Sizes of aux_data, 0 if absent */
+    elfparser_dwarfline_unit_t*     units;         /**< Known units */
+    uint32_t                        unit_num;      /**< Number of entries in units */
+    uint32_t                        unit_cap;      /**< Capacity of units */
+    uint32_t                        decoded_num;   /**< Number of units decoded so far */
+    elfparser_dwarfline_range_t*    ranges;        /**< Address ranges, sorted by range_start */
+    uint64_t*                       range_max_end; /**< Largest range_end among ranges[0..i] */
+    uint32_t                        range_num;     /**< Number of entries in ranges */
+    uint32_t                        range_cap;     /**< Capacity of ranges */
+} elfparser_dwarfline_t;
+
+/**
+ * @brief Structure representing the source location of an address
+ */
+typedef struct elfparser_dwarfline_loc_s
+{
+    const char* file_name;  /**< Source file path, valid until the structure is closed */
+    uint32_t    line;       /**< Source line, 0 if the instructions have no line */
+    uint64_t    row_addr;   /**< First address of the matching row */
+} elfparser_dwarfline_loc_t;
+
+/**
+ * @brief Opens the line tables of a file and indexes the unit address ranges
+ *
+ * No line program is decoded here; only .debug_aranges and the unit headers
+ * it refers to are read.
+ *
+ * @param[out] dwarf_line Pointer to the structure to initialize, released with ElfParser_DwarfLine_close()
+ * @param[in,out] file Pointer to an open file structure
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NOT_FOUND if the file has no .debug_line,
+ *             or an ElfParser_Error code on failure
+ */
+int ElfParser_DwarfLine_open(elfparser_dwarfline_t *dwarf_line, elfparser_file_t *file);
+
+/**
+ * @brief Opens the line tables of a file, decompressing compressed debug sections through a cache
+ *
+ * Same as ElfParser_DwarfLine_open(), except that every section is fetched
+ * through the cache, whose views are released by ElfParser_DwarfLine_close().
+ * The cache must outlive the structure.
+ *
+ * @param[out] dwarf_line Pointer to the structure to initialize, released with ElfParser_DwarfLine_close()
+ * @param[in,out] file Pointer to an open file structure
+ * @param[in,out] cache Pointer to an initialized section cache, NULL to behave like ElfParser_DwarfLine_open()
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NOT_FOUND if the file has no .debug_line,
+ *             or an ElfParser_Error code on failure
+ */
+int ElfParser_DwarfLine_openCached(elfparser_dwarfline_t *dwarf_line, elfparser_file_t *file, elfparser_sectcache_t *cache);
+
+/**
+ * @brief Resolves an address to its source file and line
+ * @param[in,out] dwarf_line Pointer to an open line table structure
+ * @param[in] addr Address to resolve
+ * @param[out] loc Pointer to the location to fill
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NOT_FOUND if no row covers addr,
+ *             or an ElfParser_Error code on failure
+ */
+int ElfParser_DwarfLine_lookup(elfparser_dwarfline_t *dwarf_line, uint64_t addr, elfparser_dwarfline_loc_t *loc);
+
+/**
+ * @brief Resolves a batch of addresses to source files and lines
+ *
+ * Addresses are resolved in the given order. An address inside the range of
+ * the previous hit skips the range search, and one at or above the previous
+ * row searches rows from there, so sorted or clustered input (such as
+ * profiler samples) is cheapest. Each unit is decoded at most once.
+ *
+ * @param[in,out] dwarf_line Pointer to an open line table structure
+ * @param[in] addrs Addresses to resolve
+ * @param[in] addr_num Number of addresses
+ * @param[out] locs Array of addr_num locations to fill
+ * @param[out] status Per address: ELFPARSER_SUCCESS or ELFPARSER_ERR_NOT_FOUND
+ * @return int ELFPARSER_SUCCESS if the batch was carried out, or an ElfParser_Error code on failure
+ */
+int ElfParser_DwarfLine_batchLookup(elfparser_dwarfline_t *dwarf_line, const uint64_t *addrs, size_t addr_num,
+                                    elfparser_dwarfline_loc_t *locs, int *status);
+
+/**
+ * @brief Frees the resources held by a line table structure
+ * @param[in,out] dwarf_line Pointer to the structure to close
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_DwarfLine_close(elfparser_dwarfline_t *dwarf_line);
+
+#endif /* _IG_ELFPARSER_DWARFLINE_H_ */
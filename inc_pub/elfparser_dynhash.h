@@ -0,0 +1,85 @@
+/**
+ * @file elfparser_dynhash.h
+ * @brief Public header for symbol lookups through the on-disk hash tables in libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header provides the public interface for looking up dynamic symbols
+ * through the hash tables shared objects already carry for the dynamic linker:
+ * .gnu.hash (bloom filter plus buckets) and, as a fallback, the System V
+ * SHT_HASH table. Lookups work directly against the mapped file, so only the
+ * handful of .dynsym entries a query touches are ever decoded.
+ */
+
+#ifndef _IG_ELFPARSER_DYNHASH_H_
+#define _IG_ELFPARSER_DYNHASH_H_
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include "../inc_pub/elfparser_common.h"
+#include "../inc_pub/elfparser_secthead.h"
+#include "../inc_pub/elfparser_symtable.h"
+
+/**
+ * @brief Enumeration of supported on-disk hash table flavours
+ */
+typedef enum
+{
+    ELFPARSER_DYNHASH_TYPE_GNU  = 1, /**< .gnu.hash (SHT_GNU_HASH) */
+    ELFPARSER_DYNHASH_TYPE_SYSV = 2  /**< System V hash (SHT_HASH) */
+} elfparser_dynhash_type_e;
+
+/**
+ * @brief Structure describing a hash table and the symbol and string tables it indexes
+ */
+typedef struct elfparser_dynhash_s
+{
+    const uint8_t*              hash_map;      /**< Start of the hash section inside the file map */
+    size_t                      hash_size;     /**< Size of the hash section in bytes */
+    const uint8_t*              sym_map;       /**< Start of the linked symbol table (.dynsym) */
+    size_t                      sym_size;      /**< Size of the symbol table in bytes */
+    const char*                 str_map;       /**< Start of the linked string table (.dynstr) */
+    size_t                      str_size;      /**< Size of the string table in bytes */
+    elfparser_header_class_e    elf_class;     /**< ELF class (32-bit or 64-bit) */
+    elfparser_header_data_e     elf_data;      /**< Data encoding (endianness) */
+    elfparser_dynhash_type_e    hash_type;     /**< Flavour of the hash table in use */
+    uint16_t                    sym_entry_size; /**< Size of each symbol table entry in bytes */
+    uint8_t                     word_size;     /**< Size of bucket and chain words in bytes */
+    uint32_t                    bucket_num;    /**< Number of hash buckets */
+    uint32_t                    chain_num;     /**< Number of chain words (System V only) */
+    uint32_t                    sym_off;       /**< First symbol index covered by the chains (GNU only) */
+    uint32_t                    bloom_size;    /**< Number of bloom filter words (GNU only) */
+    uint32_t                    bloom_shift;   /**< Shift of the second bloom hash (GNU only) */
+    size_t                      bucket_off;    /**< Offset of the buckets inside hash_map */
+    size_t                      chain_off;     /**< Offset of the chains inside hash_map */
+} elfparser_dynhash_t;
+
+/**
+ * @brief Locates the hash, dynamic symbol and dynamic string tables of a file
+ *
+ * .gnu.hash is preferred over SHT_HASH when both are present. The tables are
+ * found by section type and sh_link, so section names need not be resolved.
+ * The hash section must link to an SHT_DYNSYM or SHT_SYMTAB section whose
+ * sh_entsize is the Elf32_Sym or Elf64_Sym size of the file's class.
+ *
+ * @param[out] dyn_hash Pointer to the hash table structure to populate
+ * @param[in] sect_head Pointer to a parsed section header table of the file
+ * @param[in] map Pointer to the memory-mapped ELF file
+ * @param[in] map_size Size of the memory map in bytes
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NOT_FOUND if the file has no hash table,
+ *             or an ElfParser_Error code on failure
+ */
+int ElfParser_DynHash_setup(elfparser_dynhash_t *dyn_hash, const elfparser_secthead_t *sect_head, const void *map, size_t map_size);
+
+/**
+ * @brief Looks up a defined dynamic symbol by name through the hash table
+ * @param[in] dyn_hash Pointer to the hash table structure
+ * @param[in] name Name of the symbol to find
+ * @param[out] entry Optional destination for the decoded symbol; its sym_name is a view into the map
+ * @return int64_t Index of the symbol in .dynsym, ELFPARSER_ERR_NOT_FOUND if no defined symbol matches,
+ *                 or an ElfParser_Error code on failure
+ */
+int64_t ElfParser_DynHash_lookup(const elfparser_dynhash_t *dyn_hash, const char *name, elfparser_symtable_entry_t *entry);
+
+#endif /* _IG_ELFPARSER_DYNHASH_H_ */
@@ -0,0 +1,199 @@
+/**
+ * @file elfparser_file.h
+ * @brief Public header for the ELF file handle of libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header provides a file handle that owns a reader on an ELF file and
+ * parses its header, section header table and program header table lazily,
+ * on first use. Every phase tells the reader what it is about to read
+ * (read-ahead for the header tables and string tables, sequential access for
+ * symbol table scans, release once decoded), so cold-cache opens of large
+ * binaries fault in or read only what is needed, and I/O behaviour can be
+ * tuned in one place instead of in every caller. The reader is mmap-based by
+ * default; ELFPARSER_FILE_FLAG_PREAD switches to positional reads of just the
+ * needed ranges, and ElfParser_Reader_statsGet() on the reader member reports
+ * how many bytes that took.
+ */
+
+#ifndef _IG_ELFPARSER_FILE_H_
+#define _IG_ELFPARSER_FILE_H_
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include "../inc_pub/elfparser_common.h"
+#include "../inc_pub/elfparser_header.h"
+#include "../inc_pub/elfparser_secthead.h"
+#include "../inc_pub/elfparser_proghead.h"
+#include "../inc_pub/elfparser_symtable.h"
+#include "../inc_pub/elfparser_reader.h"
+#include "../inc_pub/elfparser_note.h"
+#include "../inc_pub/elfparser_reloc.h"
+
+/* Open Flag Constants */
+#define ELFPARSER_FILE_FLAG_NONE      0x00000000u /**< Map the file and issue access-pattern hints */
+#define ELFPARSER_FILE_FLAG_POPULATE  ELFPARSER_READER_FLAG_POPULATE  /**< Prefault the whole file at open (MAP_POPULATE), never release pages */
+#define ELFPARSER_FILE_FLAG_NO_ADVISE ELFPARSER_READER_FLAG_NO_ADVISE /**< Issue no madvise/posix_fadvise hints at all */
+#define ELFPARSER_FILE_FLAG_PREAD     0x00000004u /**< Read only the needed ranges with pread() instead of mapping the file */
+
+/**
+ * @brief Structure representing an open ELF file and the tables parsed from it so far
+ */
+typedef struct elfparser_file_s
+{
+    elfparser_reader_t      reader;     /**< Reader all tables are fetched through */
+    uint32_t                flags;      /**< ELFPARSER_FILE_FLAG_* given to open */
+    const elfparser_alloc_t* alloc;     /**< Allocator of the tables parsed from now on, NULL for malloc */
+    uint32_t                ready;      /**< Tables parsed so far (private bit set) */
+    elfparser_header_t      header;     /**< ELF header, valid once ElfParser_File_headerGet() succeeded */
+    elfparser_secthead_t    sect_head;  /**< Section headers, valid once ElfParser_File_sectHeadGet() succeeded */
+    elfparser_proghead_t    prog_head;  /**< Program headers, valid once ElfParser_File_progHeadGet() succeeded */
+} elfparser_file_t;
+
+/**
+ * @brief Opens an ELF file
+ *
+ * Only the reader is set up; nothing is read or parsed until a getter asks
+ * for it.
+ *
+ * @param[out] file Pointer to the file structure to initialize
+ * @param[in] path Path of the file
+ * @param[in] flags Bitwise OR of ELFPARSER_FILE_FLAG_* values
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_File_open(elfparser_file_t *file, const char *path, uint32_t flags);
+
+/**
+ * @brief Gives an access-pattern hint for a byte range of the file
+ *
+ * Forwarded to ElfParser_Reader_advise(), see there.
+ *
+ * @param[in] file Pointer to an open file structure
+ * @param[in] offset Start of the range in the file
+ * @param[in] size Length of the range in bytes
+ * @param[in] advice Access pattern to announce
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_File_advise(const elfparser_file_t *file, uint64_t offset, uint64_t size, elfparser_reader_advice_e advice);
+
+/**
+ * @brief Sets the allocator of the section header and symbol tables parsed through the file
+ *
+ * Applies to tables set up after the call; a table keeps the allocator it was
+ * set up with and releases through it. The allocator must outlive every such
+ * table. An arena allocator makes symbol name resolution single-threaded.
+ *
+ * @param[in,out] file Pointer to an open file structure
+ * @param[in] alloc Allocator to use, NULL for malloc
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_File_allocSet(elfparser_file_t *file, const elfparser_alloc_t *alloc);
+
+/**
+ * @brief Returns the ELF header, parsing it on first use
+ * @param[in,out] file Pointer to an open file structure
+ * @param[out] header Set to the parsed header, owned by file
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_File_headerGet(elfparser_file_t *file, const elfparser_header_t **header);
+
+/**
+ * @brief Returns the section header table, parsing it and resolving its names on first use
+ *
+ * Section names are copied into one block owned by the table and stay valid
+ * until the file is closed; the string table they came from is not kept.
+ *
+ * @param[in,out] file Pointer to an open file structure
+ * @param[out] sect_head Set to the parsed table, owned by file
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NOT_FOUND if the file has no section headers,
+ *             or an ElfParser_Error code on failure
+ */
+int ElfParser_File_sectHeadGet(elfparser_file_t *file, const elfparser_secthead_t **sect_head);
+
+/**
+ * @brief Returns the program header table, parsing it on first use
+ * @param[in,out] file Pointer to an open file structure
+ * @param[out] prog_head Set to the parsed table, owned by file
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NOT_FOUND if the file has no program headers,
+ *             or an ElfParser_Error code on failure
+ */
+int ElfParser_File_progHeadGet(elfparser_file_t *file, const elfparser_proghead_t **prog_head);
+
+/**
+ * @brief Returns the contents of a section
+ *
+ * The contents stay valid until the file is closed.
+ *
+ * @param[in,out] file Pointer to an open file structure
+ * @param[in] sect_idx Index of the section
+ * @param[out] data Set to the first byte of the section, NULL for SHT_NOBITS
+ * @param[out] size Set to the size of the section in bytes (0 for SHT_NOBITS)
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_File_sectionGet(elfparser_file_t *file, uint32_t sect_idx, const void **data, size_t *size);
+
+/**
+ * @brief Sets up, parses and name-resolves a symbol table section in one sequential pass
+ *
+ * The symbol entries are read with sequential read-ahead and released after
+ * decoding; the symbol, string and extended index sections are fetched
+ * together, so the pread backend reads adjacent ones in one go. Escaped
+ * section indices are resolved from a linked SHT_SYMTAB_SHNDX section if
+ * there is one. Names are views into the file contents, so symbol_table must
+ * be freed with ElfParser_SymTable_free() before the file is closed.
+ *
+ * @param[in,out] file Pointer to an open file structure
+ * @param[out] symbol_table Pointer to the symbol table structure to populate
+ * @param[in] sym_sect_idx Index of the SHT_SYMTAB or SHT_DYNSYM section
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_File_symTableLoad(elfparser_file_t *file, elfparser_symtable_t *symbol_table, uint32_t sym_sect_idx);
+
+/**
+ * @brief Loads the most complete symbol table of the file
+ *
+ * That is the static table (SHT_SYMTAB) when there is one, and otherwise the
+ * dynamic table (SHT_DYNSYM), which is all stripped executables and shared
+ * libraries keep. Same contract as ElfParser_File_symTableLoad().
+ *
+ * @param[in,out] file Pointer to an open file structure
+ * @param[out] symbol_table Pointer to the symbol table structure to populate
+ * @param[out] sym_sect_idx Optional destination of the index of the loaded section
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NOT_FOUND if the file has no symbol table,
+ *             or an ElfParser_Error code on failure
+ */
+int ElfParser_File_symTableDefaultLoad(elfparser_file_t *file, elfparser_symtable_t *symbol_table, uint32_t *sym_sect_idx);
+
+/**
+ * @brief Sets up and decodes a relocation section in one sequential pass
+ * @param[in,out] file Pointer to an open file structure
+ * @param[out] reloc Pointer to the relocation structure to populate, released with ElfParser_Reloc_free()
+ * @param[in] reloc_sect_idx Index of the SHT_REL, SHT_RELA or SHT_RELR section
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_File_relocLoad(elfparser_file_t *file, elfparser_reloc_t *reloc, uint32_t reloc_sect_idx);
+
+/**
+ * @brief Copies out the GNU build-id of the file
+ *
+ * PT_NOTE segments are searched first, since the program header table is
+ * small and sits at the front of the file; SHT_NOTE sections are searched
+ * only if no segment carries the note, which covers relocatable objects.
+ *
+ * @param[in,out] file Pointer to an open file structure
+ * @param[out] build_id Destination of at least ELFPARSER_NOTE_BUILD_ID_MAX bytes
+ * @param[out] build_id_len Set to the length of the build-id in bytes
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NOT_FOUND if the file has no build-id,
+ *             or an ElfParser_Error code on failure
+ */
+int ElfParser_File_buildIdGet(elfparser_file_t *file, uint8_t *build_id, uint32_t *build_id_len);
+
+/**
+ * @brief Frees every table parsed from the file and closes its reader
+ * @param[in,out] file Pointer to the file structure to close
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_File_close(elfparser_file_t *file);
+
+#endif /* _IG_ELFPARSER_FILE_H_ */
@@ -0,0 +1,101 @@
+/**
+ * @file elfparser_fingerprint.h
+ * @brief Public header for identity fingerprints of ELF files in libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header provides a cheap identity for deduplicating ELF artifacts: the
+ * class, data encoding, type and machine from the ELF header plus either the
+ * GNU build-id or, for files built without one, a hash of their contents.
+ * The build-id is taken from the PT_NOTE segments, so a typical file costs
+ * the first page or two and neither the section header table nor any symbol
+ * is decoded. Only files without a build-id are read in full, and then only
+ * their PT_LOAD ranges, through an AVX2-accelerated hash where available.
+ */
+
+#ifndef _IG_ELFPARSER_FINGERPRINT_H_
+#define _IG_ELFPARSER_FINGERPRINT_H_
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include "../inc_pub/elfparser_common.h"
+#include "../inc_pub/elfparser_header.h"
+#include "../inc_pub/elfparser_note.h"
+#include "../inc_pub/elfparser_file.h"
+
+/**
+ * @brief Enumeration of what identifies the contents of a file
+ */
+typedef enum
+{
+    ELFPARSER_FINGERPRINT_KIND_BUILD_ID  = 0, /**< GNU build-id note */
+    ELFPARSER_FINGERPRINT_KIND_LOAD_HASH = 1, /**< Hash of the file bytes of every PT_LOAD segment */
+    ELFPARSER_FINGERPRINT_KIND_FILE_HASH = 2  /**< Hash of the whole file (no build-id and no segments, e.g. objects) */
+} elfparser_fingerprint_kind_e;
+
+/**
+ * @brief Identity of one ELF file
+ */
+typedef struct elfparser_fingerprint_s
+{
+    elfparser_header_class_e        elf_class;      /**< ELF class (32-bit or 64-bit) */
+    elfparser_header_data_e         elf_data;       /**< Data encoding (endianness) */
+    elfparser_header_type_e         elf_type;       /**< Object file type */
+    uint16_t                        elf_machine;    /**< Target machine architecture */
+    elfparser_fingerprint_kind_e    kind;           /**< Which of build_id or content_hash identifies the contents */
+    uint32_t                        build_id_len;   /**< Length of build_id, 0 unless kind is BUILD_ID */
+    uint8_t                         build_id[ELFPARSER_NOTE_BUILD_ID_MAX]; /**< GNU build-id */
+    uint64_t                        content_hash;   /**< Hash of the contents, 0 if kind is BUILD_ID */
+    uint64_t                        bytes_read;     /**< Bytes the reader delivered to compute the fingerprint */
+} elfparser_fingerprint_t;
+
+/**
+ * @brief Computes the fingerprint of an open file
+ *
+ * Only the ELF header, the program header table and the PT_NOTE segments are
+ * read when the file has a build-id. Files without program headers are
+ * searched for note sections instead.
+ *
+ * @param[out] fingerprint Pointer to the fingerprint to fill
+ * @param[in,out] file Pointer to an open file structure
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_Fingerprint_compute(elfparser_fingerprint_t *fingerprint, elfparser_file_t *file);
+
+/**
+ * @brief Opens a file, computes its fingerprint and closes it again
+ * @param[out] fingerprint Pointer to the fingerprint to fill
+ * @param[in] path Path of the file
+ * @param[in] file_flags ELFPARSER_FILE_FLAG_* values the file is opened with
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_Fingerprint_path(elfparser_fingerprint_t *fingerprint, const char *path, uint32_t file_flags);
+
+/**
+ * @brief Computes the fingerprints of many files on several threads
+ *
+ * A failing file does not stop the others; its error is stored in its
+ * status entry and its fingerprint is left zeroed.
+ *
+ * @param[in] paths Paths of the files
+ * @param[in] path_num Number of paths
+ * @param[in] thread_num Number of threads, 0 for one per online CPU
+ * @param[in] file_flags ELFPARSER_FILE_FLAG_* values every file is opened with
+ * @param[out] fingerprints Array of path_num fingerprints to fill
+ * @param[out] status Array of path_num result codes, may be NULL
+ * @return int ELFPARSER_SUCCESS if the run completed (individual files may have failed),
+ *             or an ElfParser_Error code if it could not be carried out
+ */
+int ElfParser_Fingerprint_many(const char *const *paths, size_t path_num, uint32_t thread_num, uint32_t file_flags,
+                               elfparser_fingerprint_t *fingerprints, int *status);
+
+/**
+ * @brief Tells whether two fingerprints identify the same artifact
+ * @param[in] lhs First fingerprint
+ * @param[in] rhs Second fingerprint
+ * @return int 1 if class, data encoding, type, machine, kind and identity all match, 0 otherwise
+ */
+int ElfParser_Fingerprint_equal(const elfparser_fingerprint_t *lhs, const elfparser_fingerprint_t *rhs);
+
+#endif /* _IG_ELFPARSER_FINGERPRINT_H_ */
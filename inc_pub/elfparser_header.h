@@ -104,10 +104,10 @@ typedef struct elfparser_header_s
     uint32_t                    elf_flags;                      /**< Processor-specific flags */
     uint16_t                    elf_header_size;                /**< Size of this header */
     uint16_t                    elf_program_header_entry_size;  /**< Size of a program header entry */
-    uint16_t                    elf_program_header_entry_num;   /**< Number of program header entries */
+    uint32_t                    elf_program_header_entry_num;   /**< Number of program header entries (extended numbering resolved) */
     uint16_t                    elf_section_header_entry_size;  /**< Size of a section header entry */
-    uint16_t                    elf_section_header_entry_num;   /**< Number of section header entries */
-    uint16_t                    elf_section_header_name_idx;    /**< Index of section name string table */
+    uint32_t                    elf_section_header_entry_num;   /**< Number of section header entries (extended numbering resolved) */
+    uint32_t                    elf_section_header_name_idx;    /**< Index of section name string table (extended numbering resolved) */
 } elfparser_header_t;
 
 /**
@@ -121,6 +121,11 @@ int ElfParser_Header_identParse(elfparser_header_t *elfparser_header, const void
 
 /**
  * @brief Parses the full ELF header from a memory map
+ *
+ * ELF extended numbering is resolved here: if e_shnum is 0, e_shstrndx is
+ * SHN_XINDEX or e_phnum is PN_XNUM, the real values are read from sh_size,
+ * sh_link and sh_info of section header 0, which must then lie inside map.
+ *
  * @param[out] elfparser_header Pointer to the ELF header structure to populate
  * @param[in] map Pointer to the memory-mapped ELF file
  * @param[in] size Size of the memory map in bytes
@@ -128,6 +133,36 @@ int ElfParser_Header_identParse(elfparser_header_t *elfparser_header, const void
  */
 int ElfParser_Header_parse(elfparser_header_t *elfparser_header, const void *map, size_t size);
 
+/**
+ * @brief Decodes the ELF header fields without resolving extended numbering
+ *
+ * Only the header bytes themselves are read, so map may be a buffer holding
+ * just the start of the file. Escape values are left as stored; see
+ * ElfParser_Header_extendedUsed() and ElfParser_Header_extendedResolve().
+ *
+ * @param[out] elfparser_header Pointer to the ELF header structure to populate (ident already parsed)
+ * @param[in] map Pointer to the start of the ELF file
+ * @param[in] size Number of bytes available at map
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_Header_parseRaw(elfparser_header_t *elfparser_header, const void *map, size_t size);
+
+/**
+ * @brief Checks whether a decoded header uses extended numbering escapes
+ * @param[in] elfparser_header Pointer to a header decoded by ElfParser_Header_parseRaw()
+ * @return int 1 if a count or index has to be read from section header 0, 0 otherwise
+ */
+int ElfParser_Header_extendedUsed(const elfparser_header_t *elfparser_header);
+
+/**
+ * @brief Replaces extended-numbering escapes with the values stored in section header 0
+ * @param[in,out] elfparser_header Pointer to a header decoded by ElfParser_Header_parseRaw()
+ * @param[in] sect0 Pointer to the raw section header 0 (may be NULL if no escape is used)
+ * @param[in] sect0_size Number of bytes available at sect0
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_Header_extendedResolve(elfparser_header_t *elfparser_header, const void *sect0, size_t sect0_size);
+
 /**
  * @brief Retrieves the size of the ELF header based on its class
  * @param[in] elfparser_header Pointer to the ELF header structure
@@ -0,0 +1,94 @@
+/**
+ * @file elfparser_note.h
+ * @brief Public header for ELF note parsing in libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header provides the public interface for walking the notes of an
+ * SHT_NOTE section or a PT_NOTE segment within the standalone libelfparser
+ * library. Notes are returned as views into the caller's buffer; the most
+ * common use, finding the GNU build-id that identifies a linked binary, has
+ * its own lookup.
+ */
+
+#ifndef _IG_ELFPARSER_NOTE_H_
+#define _IG_ELFPARSER_NOTE_H_
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include "../inc_pub/elfparser_common.h"
+#include "../inc_pub/elfparser_header.h"
+
+/* Note Owner Names */
+#define ELFPARSER_NOTE_NAME_GNU             "GNU" /**< Owner of the GNU notes */
+
+/* GNU Note Type Constants (n_type, owner "GNU") */
+#define ELFPARSER_NOTE_TYPE_GNU_ABI_TAG     0x01u /**< ABI tag (NT_GNU_ABI_TAG) */
+#define ELFPARSER_NOTE_TYPE_GNU_HWCAP       0x02u /**< Hardware capabilities (NT_GNU_HWCAP) */
+#define ELFPARSER_NOTE_TYPE_GNU_BUILD_ID    0x03u /**< Unique build identifier (NT_GNU_BUILD_ID) */
+#define ELFPARSER_NOTE_TYPE_GNU_GOLD_VERSION 0x04u /**< Gold linker version (NT_GNU_GOLD_VERSION) */
+#define ELFPARSER_NOTE_TYPE_GNU_PROPERTY    0x05u /**< Program properties (NT_GNU_PROPERTY_TYPE_0) */
+
+#define ELFPARSER_NOTE_BUILD_ID_MAX         64u   /**< Longest build-id accepted, in bytes (SHA-1 ids are 20) */
+
+/**
+ * @brief Structure representing a single note, viewing the caller's buffer
+ */
+typedef struct elfparser_note_s
+{
+    const char*     note_name;      /**< Owner name, not necessarily terminated (see note_name_len) */
+    uint32_t        note_name_len;  /**< Length of note_name without the terminator, if any */
+    uint32_t        note_type;      /**< Note type, meaning depends on the owner */
+    const uint8_t*  note_desc;      /**< Descriptor bytes */
+    uint32_t        note_desc_size; /**< Size of the descriptor in bytes */
+} elfparser_note_t;
+
+/**
+ * @brief Decodes the note at an offset and advances the offset to the next note
+ *
+ * Name and descriptor are padded to the note alignment, which is 8 for sections
+ * and segments aligned to 8 (GNU property notes) and 4 otherwise.
+ *
+ * @param[in] map Pointer to the contents of the note section or segment
+ * @param[in] map_size Size of the contents in bytes
+ * @param[in,out] offset Offset of the note to decode, 0 for the first; advanced past it on success
+ * @param[in] elf_data Data encoding of the file
+ * @param[in] align sh_addralign or p_align of the section or segment
+ * @param[out] note Pointer to the note structure to fill
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NOT_FOUND once offset is past the last note,
+ *             ELFPARSER_ERR_NULL if inputs are NULL, ELFPARSER_ERR_SIZE if the note overruns map
+ */
+int ElfParser_Note_next(const void *map, size_t map_size, size_t *offset, elfparser_header_data_e elf_data,
+                        uint64_t align, elfparser_note_t *note);
+
+/**
+ * @brief Finds the first note with a given owner and type
+ * @param[in] map Pointer to the contents of the note section or segment
+ * @param[in] map_size Size of the contents in bytes
+ * @param[in] elf_data Data encoding of the file
+ * @param[in] align sh_addralign or p_align of the section or segment
+ * @param[in] name Owner name to match (e.g., ELFPARSER_NOTE_NAME_GNU)
+ * @param[in] type Note type to match
+ * @param[out] note Pointer to the note structure to fill
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NOT_FOUND if there is no such note,
+ *             or the error of ElfParser_Note_next()
+ */
+int ElfParser_Note_find(const void *map, size_t map_size, elfparser_header_data_e elf_data, uint64_t align,
+                        const char *name, uint32_t type, elfparser_note_t *note);
+
+/**
+ * @brief Finds the GNU build-id note
+ * @param[in] map Pointer to the contents of the note section or segment
+ * @param[in] map_size Size of the contents in bytes
+ * @param[in] elf_data Data encoding of the file
+ * @param[in] align sh_addralign or p_align of the section or segment
+ * @param[out] note Pointer to the note structure to fill, note_desc being the build-id
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NOT_FOUND if there is no build-id,
+ *             ELFPARSER_ERR_FORMAT if it is empty or longer than ELFPARSER_NOTE_BUILD_ID_MAX,
+ *             or the error of ElfParser_Note_next()
+ */
+int ElfParser_Note_buildIdFind(const void *map, size_t map_size, elfparser_header_data_e elf_data, uint64_t align,
+                               elfparser_note_t *note);
+
+#endif /* _IG_ELFPARSER_NOTE_H_ */
@@ -0,0 +1,141 @@
+/**
+ * @file elfparser_proghead.h
+ * @brief Public header for ELF program header (segment) parsing in libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header provides the public interface for parsing ELF program headers
+ * within the standalone libelfparser library. It includes definitions for
+ * segment types and flags, structures for program header data, and functions
+ * to translate between virtual addresses and file offsets through the PT_LOAD
+ * segments, which is all a stripped binary or a core dump reliably carries.
+ */
+
+#ifndef _IG_ELFPARSER_PROGHEAD_H_
+#define _IG_ELFPARSER_PROGHEAD_H_
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include "../inc_pub/elfparser_common.h"
+#include "../inc_pub/elfparser_header.h"
+
+/* Segment Type Constants (p_type) */
+#define ELFPARSER_PROGHEAD_TYPE_NULL         0x00000000u /**< Unused entry */
+#define ELFPARSER_PROGHEAD_TYPE_LOAD         0x00000001u /**< Loadable segment */
+#define ELFPARSER_PROGHEAD_TYPE_DYNAMIC      0x00000002u /**< Dynamic linking information */
+#define ELFPARSER_PROGHEAD_TYPE_INTERP       0x00000003u /**< Program interpreter path */
+#define ELFPARSER_PROGHEAD_TYPE_NOTE         0x00000004u /**< Notes */
+#define ELFPARSER_PROGHEAD_TYPE_SHLIB        0x00000005u /**< Reserved */
+#define ELFPARSER_PROGHEAD_TYPE_PHDR         0x00000006u /**< Program header table itself */
+#define ELFPARSER_PROGHEAD_TYPE_TLS          0x00000007u /**< Thread-local storage template */
+#define ELFPARSER_PROGHEAD_TYPE_GNU_EH_FRAME 0x6474e550u /**< Exception handling frame header */
+#define ELFPARSER_PROGHEAD_TYPE_GNU_STACK    0x6474e551u /**< Stack executability */
+#define ELFPARSER_PROGHEAD_TYPE_GNU_RELRO    0x6474e552u /**< Read-only after relocation */
+#define ELFPARSER_PROGHEAD_TYPE_GNU_PROPERTY 0x6474e553u /**< GNU property notes */
+
+/* Segment Flag Constants (p_flags) */
+#define ELFPARSER_PROGHEAD_FLAG_EXEC        0x1u /**< Executable segment */
+#define ELFPARSER_PROGHEAD_FLAG_WRITE       0x2u /**< Writable segment */
+#define ELFPARSER_PROGHEAD_FLAG_READ        0x4u /**< Readable segment */
+
+/**
+ * @brief Structure representing a single ELF program header entry
+ */
+typedef struct elfparser_proghead_entry_s
+{
+    uint32_t  ph_type;      /**< Segment type (e.g., ELFPARSER_PROGHEAD_TYPE_*) */
+    uint32_t  ph_flags;     /**< Segment flags (e.g., ELFPARSER_PROGHEAD_FLAG_*) */
+    uint64_t  ph_offset;    /**< Offset of segment in file */
+    uint64_t  ph_vaddr;     /**< Virtual address of segment in memory */
+    uint64_t  ph_paddr;     /**< Physical address of segment (where relevant) */
+    uint64_t  ph_filesz;    /**< Size of segment in file */
+    uint64_t  ph_memsz;     /**< Size of segment in memory */
+    uint64_t  ph_align;     /**< Alignment of segment */
+} elfparser_proghead_entry_t;
+
+/**
+ * @brief Start of a PT_LOAD segment in one address space, as kept by the sorted indices
+ */
+typedef struct elfparser_proghead_span_s
+{
+    uint64_t  start;        /**< Start address or file offset */
+    uint64_t  reach;        /**< Last byte covered by this span or any span sorted before it */
+    uint32_t  idx;          /**< Index of the segment in table */
+} elfparser_proghead_span_t;
+
+/**
+ * @brief Structure representing the ELF program header table
+ */
+typedef struct elfparser_proghead_s
+{
+    elfparser_proghead_entry_t* table;      /**< Array of program header entries */
+    elfparser_header_class_e    elf_class;  /**< ELF class (32-bit or 64-bit) */
+    elfparser_header_data_e     elf_data;   /**< Data encoding (endianness) */
+    uint32_t                    table_len;  /**< Number of entries in table */
+    uint16_t                    entry_size; /**< Size of each entry in bytes */
+    elfparser_proghead_span_t*  by_vaddr;   /**< PT_LOAD segments with memory, sorted by ph_vaddr */
+    elfparser_proghead_span_t*  by_offset;  /**< PT_LOAD segments with file data, sorted by ph_offset */
+    uint32_t                    vaddr_num;  /**< Number of entries in by_vaddr */
+    uint32_t                    offset_num; /**< Number of entries in by_offset */
+} elfparser_proghead_t;
+
+/**
+ * @brief Sets up the program header structure using ELF header data
+ * @param[out] prog_head Pointer to the program header structure to initialize
+ * @param[in] header Pointer to the ELF header containing program header metadata
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_ProgHead_structSetup(elfparser_proghead_t *prog_head, const elfparser_header_t *header);
+
+/**
+ * @brief Parses the program header table from a memory map and builds the PT_LOAD indices
+ * @param[out] prog_head Pointer to the program header structure to populate
+ * @param[in] map Pointer to the memory-mapped program header table
+ * @param[in] map_size Size of the memory map in bytes
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_ProgHead_parse(elfparser_proghead_t *prog_head, const void *map, size_t map_size);
+
+/**
+ * @brief Finds the PT_LOAD segment whose memory image covers a virtual address
+ * @param[in] prog_head Pointer to a parsed program header structure
+ * @param[in] vaddr Virtual address to look up
+ * @return int64_t Index of the segment in table, ELFPARSER_ERR_NOT_FOUND if no segment covers vaddr,
+ *                 or an ElfParser_Error code on failure
+ */
+int64_t ElfParser_ProgHead_vaddrFind(const elfparser_proghead_t *prog_head, uint64_t vaddr);
+
+/**
+ * @brief Translates a virtual address to the file offset holding its bytes
+ *
+ * Addresses in the zero-filled tail of a segment (past ph_filesz, e.g. .bss,
+ * or segments a core dump did not save) have no file bytes and are reported
+ * as not found.
+ *
+ * @param[in] prog_head Pointer to a parsed program header structure
+ * @param[in] vaddr Virtual address to translate
+ * @param[out] offset File offset of vaddr
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NOT_FOUND if vaddr has no file bytes,
+ *             or an ElfParser_Error code on failure
+ */
+int ElfParser_ProgHead_vaddrToOffset(const elfparser_proghead_t *prog_head, uint64_t vaddr, uint64_t *offset);
+
+/**
+ * @brief Translates a file offset to the virtual address it is loaded at
+ * @param[in] prog_head Pointer to a parsed program header structure
+ * @param[in] offset File offset to translate
+ * @param[out] vaddr Virtual address of offset
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NOT_FOUND if no PT_LOAD segment maps offset,
+ *             or an ElfParser_Error code on failure
+ */
+int ElfParser_ProgHead_offsetToVaddr(const elfparser_proghead_t *prog_head, uint64_t offset, uint64_t *vaddr);
+
+/**
+ * @brief Frees the program header structure and its allocated resources
+ * @param[in,out] prog_head Pointer to the program header structure to free
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_ProgHead_free(elfparser_proghead_t *prog_head);
+
+#endif /* _IG_ELFPARSER_PROGHEAD_H_ */
@@ -0,0 +1,192 @@
+/**
+ * @file elfparser_reader.h
+ * @brief Public header for the byte-range reader of libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header provides the reader that sits between a file on disk and the
+ * parse functions, which all work on contiguous memory. A reader hands out
+ * byte ranges of the file as pointers. The mmap backend maps the whole file
+ * and returns pointers into the mapping. The pread backend fetches exactly the
+ * requested ranges with positional reads into a small block cache, merging
+ * nearby ranges requested together into one read, so that a parse of a
+ * multi-gigabyte debug binary on a network filesystem reads only its header,
+ * section header table and the few sections it needs. Both backends count
+ * the bytes they deliver.
+ */
+
+#ifndef _IG_ELFPARSER_READER_H_
+#define _IG_ELFPARSER_READER_H_
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include "../inc_pub/elfparser_common.h"
+
+/* Open Flag Constants */
+#define ELFPARSER_READER_FLAG_NONE      0x00000000u /**< Default behaviour */
+#define ELFPARSER_READER_FLAG_POPULATE  0x00000001u /**< mmap: prefault the whole file (MAP_POPULATE) and never release pages */
+#define ELFPARSER_READER_FLAG_NO_ADVISE 0x00000002u /**< Issue no madvise/posix_fadvise hints at all */
+
+/**
+ * @brief Enumeration of reader backends
+ */
+typedef enum
+{
+    ELFPARSER_READER_BACKEND_MMAP  = 0, /**< Map the whole file, ranges are pointers into the mapping */
+    ELFPARSER_READER_BACKEND_PREAD = 1  /**< Read requested ranges with pread() into a block cache */
+} elfparser_reader_backend_e;
+
+/**
+ * @brief Enumeration of access-pattern hints for a byte range of the file
+ */
+typedef enum
+{
+    ELFPARSER_READER_ADVICE_NORMAL     = 0, /**< Default kernel read-ahead */
+    ELFPARSER_READER_ADVICE_RANDOM     = 1, /**< Scattered reads, no read-ahead */
+    ELFPARSER_READER_ADVICE_SEQUENTIAL = 2, /**< One front-to-back scan, aggressive read-ahead */
+    ELFPARSER_READER_ADVICE_WILLNEED   = 3, /**< Start reading the range in now */
+    ELFPARSER_READER_ADVICE_DONTNEED   = 4  /**< Range is done with, its pages may be dropped */
+} elfparser_reader_advice_e;
+
+/**
+ * @brief Byte range of the file
+ */
+typedef struct elfparser_reader_range_s
+{
+    uint64_t  offset;       /**< Start of the range in the file */
+    uint64_t  size;         /**< Length of the range in bytes */
+} elfparser_reader_range_t;
+
+/**
+ * @brief I/O counters of a reader since it was opened
+ */
+typedef struct elfparser_reader_stats_s
+{
+    uint64_t  file_size;    /**< Size of the file in bytes */
+    uint64_t  bytes_read;   /**< Bytes fetched with pread(), or handed out by the mmap backend */
+    uint64_t  read_num;     /**< Number of pread() runs, or of ranges handed out by the mmap backend */
+    uint64_t  cache_hits;   /**< Ranges served from an already cached block (pread backend) */
+    uint64_t  cache_misses; /**< Ranges that needed a read of their own (pread backend) */
+} elfparser_reader_stats_t;
+
+/**
+ * @brief Cached byte range of the pread backend
+ */
+typedef struct elfparser_reader_block_s
+{
+    uint8_t*  data;         /**< Contents of the range */
+    uint64_t  offset;       /**< Start of the range in the file */
+    uint64_t  size;         /**< Length of the range in bytes */
+    uint32_t  ref_num;      /**< Number of outstanding ElfParser_Reader_rangeGet() pins */
+    uint64_t  last_use;     /**< Value of use_clock at the last hit, for LRU eviction */
+    uint32_t  prefetched;   /**< Non-zero until the first hit on a block added by ElfParser_Reader_prefetch(), never evicted meanwhile */
+} elfparser_reader_block_t;
+
+/**
+ * @brief Structure representing an open file and its reader backend
+ */
+typedef struct elfparser_reader_s
+{
+    elfparser_reader_backend_e  backend;     /**< Backend in use */
+    uint32_t                    flags;       /**< ELFPARSER_READER_FLAG_* given to open */
+    int                         fd;          /**< File descriptor (pread backend), -1 otherwise */
+    const uint8_t*              map;         /**< Mapping of the whole file (mmap backend), NULL otherwise */
+    uint64_t                    file_size;   /**< Size of the file in bytes */
+    uint64_t                    file_dev;    /**< Device of the file at open, with file_ino identifies it across handles */
+    uint64_t                    file_ino;    /**< Inode of the file at open */
+    uint64_t                    file_mtime;  /**< Modification time of the file at open, in nanoseconds */
+    elfparser_reader_block_t*   blocks;      /**< Cached blocks (pread backend) */
+    uint32_t                    block_num;   /**< Number of entries in blocks */
+    uint32_t                    block_cap;   /**< Capacity of blocks */
+    uint64_t                    cache_size;  /**< Total bytes held by blocks */
+    uint64_t                    use_clock;   /**< Counter stamped into last_use */
+    elfparser_reader_stats_t    stats;       /**< I/O counters */
+} elfparser_reader_t;
+
+/**
+ * @brief Opens a file with the given backend
+ * @param[out] reader Pointer to the reader structure to initialize
+ * @param[in] path Path of the file
+ * @param[in] backend Backend to read through
+ * @param[in] flags Bitwise OR of ELFPARSER_READER_FLAG_* values
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_Reader_open(elfparser_reader_t *reader, const char *path, elfparser_reader_backend_e backend, uint32_t flags);
+
+/**
+ * @brief Returns a pointer to a byte range of the file and pins it
+ *
+ * With the mmap backend this is a pointer into the mapping. With the pread
+ * backend the range is served from a cached block that contains it, or read
+ * into a new block of exactly its size; the block stays in memory until every
+ * pin on it is dropped with ElfParser_Reader_rangeRelease() and it is then
+ * evicted, or until the reader is closed.
+ *
+ * @param[in,out] reader Pointer to an open reader structure
+ * @param[in] offset Start of the range in the file
+ * @param[in] size Length of the range in bytes
+ * @param[out] data Set to the first byte of the range
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_Reader_rangeGet(elfparser_reader_t *reader, uint64_t offset, uint64_t size, const void **data);
+
+/**
+ * @brief Drops a pin taken by ElfParser_Reader_rangeGet()
+ * @param[in,out] reader Pointer to an open reader structure
+ * @param[in] data Pointer returned by ElfParser_Reader_rangeGet()
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_Reader_rangeRelease(elfparser_reader_t *reader, const void *data);
+
+/**
+ * @brief Announces ranges that are about to be requested
+ *
+ * With the pread backend, ranges not cached yet are sorted and ranges whose
+ * gaps are small are merged, and each merged run is fetched with a single
+ * read into one unpinned block, from which later ElfParser_Reader_rangeGet()
+ * calls are served. Such a block is not evicted before its first request. A
+ * run larger than the cache limit is not fetched; its ranges are read on
+ * request instead, so no byte is read twice. With the mmap backend this is a
+ * read-ahead hint.
+ *
+ * @param[in,out] reader Pointer to an open reader structure
+ * @param[in] ranges Ranges to fetch, in any order
+ * @param[in] range_num Number of ranges
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_Reader_prefetch(elfparser_reader_t *reader, const elfparser_reader_range_t *ranges, size_t range_num);
+
+/**
+ * @brief Gives an access-pattern hint for a byte range of the file
+ *
+ * Issued as madvise() on the mapping or posix_fadvise() on the descriptor.
+ * The range is widened to whole pages, except for DONTNEED which only covers
+ * pages wholly inside it. Hints are advisory: a kernel that rejects one does
+ * not make the call fail, and nothing is done with ELFPARSER_READER_FLAG_NO_ADVISE
+ * (or, for DONTNEED, with ELFPARSER_READER_FLAG_POPULATE).
+ *
+ * @param[in] reader Pointer to an open reader structure
+ * @param[in] offset Start of the range in the file
+ * @param[in] size Length of the range in bytes
+ * @param[in] advice Access pattern to announce
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_Reader_advise(const elfparser_reader_t *reader, uint64_t offset, uint64_t size, elfparser_reader_advice_e advice);
+
+/**
+ * @brief Copies the I/O counters of a reader
+ * @param[in] reader Pointer to an open reader structure
+ * @param[out] stats Destination of the counters
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_Reader_statsGet(const elfparser_reader_t *reader, elfparser_reader_stats_t *stats);
+
+/**
+ * @brief Releases every cached block, unmaps or closes the file
+ * @param[in,out] reader Pointer to the reader structure to close
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_Reader_close(elfparser_reader_t *reader);
+
+#endif /* _IG_ELFPARSER_READER_H_ */
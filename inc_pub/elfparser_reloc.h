@@ -0,0 +1,137 @@
+/**
+ * @file elfparser_reloc.h
+ * @brief Public header for ELF relocation table parsing in libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header provides the public interface for decoding SHT_REL, SHT_RELA
+ * and packed SHT_RELR relocation sections of either class and data encoding
+ * into one compact array, and for grouping the decoded relocations by the
+ * symbol they reference or by the section they patch. Groups are stored in
+ * compressed sparse row form (one offset array plus one index array), so
+ * every symbol's or section's relocations are a contiguous slice and building
+ * either view is a single counting pass over the table.
+ */
+
+#ifndef _IG_ELFPARSER_RELOC_H_
+#define _IG_ELFPARSER_RELOC_H_
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include "../inc_pub/elfparser_common.h"
+#include "../inc_pub/elfparser_secthead.h"
+#include "../inc_pub/elfparser_header.h"
+
+/**
+ * @brief Structure representing a single decoded relocation
+ */
+typedef struct elfparser_reloc_entry_s
+{
+    uint64_t rel_offset;   /**< Location to patch (r_offset): section offset in objects, virtual address otherwise */
+    int64_t  rel_addend;   /**< Explicit addend (r_addend), 0 for SHT_REL and SHT_RELR */
+    uint32_t rel_sym_idx;  /**< Index into the linked symbol table (R_SYM of r_info), 0 for SHT_RELR */
+    uint32_t rel_type;     /**< Machine-specific relocation type (R_TYPE of r_info), 0 for SHT_RELR */
+} elfparser_reloc_entry_t;
+
+/**
+ * @brief Structure representing a decoded relocation section
+ */
+typedef struct elfparser_reloc_s
+{
+    elfparser_reloc_entry_t*    table;           /**< Array of decoded relocations, in section order */
+    elfparser_header_class_e    elf_class;       /**< ELF class (32-bit or 64-bit) */
+    elfparser_header_data_e     elf_data;        /**< Data encoding (endianness) */
+    uint32_t                    table_len;       /**< Number of entries in table */
+    uint32_t                    sect_type;       /**< ELFPARSER_SECTHEAD_TYPE_REL, _RELA or _RELR */
+    uint16_t                    entry_size;      /**< Size of each raw entry (a word for SHT_RELR) in bytes */
+    uint32_t                    sym_table_idx;   /**< Index of the symbol table section (sh_link), 0 for SHT_RELR */
+    uint32_t                    target_sect_idx; /**< Section every entry patches (sh_info), 0 if found by address */
+} elfparser_reloc_t;
+
+/**
+ * @brief Structure representing relocations grouped by a key, in compressed sparse row form
+ *
+ * The relocations of key k are table[entry_idx[i]] for i from group_start[k]
+ * up to group_start[k + 1], in ascending table order.
+ */
+typedef struct elfparser_reloc_group_s
+{
+    uint32_t*   group_start;  /**< First position in entry_idx of each key, key_num + 1 values */
+    uint32_t*   entry_idx;    /**< Indices into the relocation table, grouped by key */
+    uint32_t    key_num;      /**< Number of keys (symbol table entries or sections) */
+} elfparser_reloc_group_t;
+
+/**
+ * @brief Sets up the relocation structure using section and header data
+ *
+ * The entry array of SHT_REL and SHT_RELA sections is allocated here. The
+ * length of a SHT_RELR section depends on its bitmaps, so its array is left
+ * NULL and allocated by ElfParser_Reloc_parse(). target_sect_idx is taken
+ * from sh_info when the section has SHF_INFO_LINK set or the file is a
+ * relocatable object; dynamic relocations are left to be placed by address.
+ *
+ * @param[out] reloc Pointer to the relocation structure to initialize
+ * @param[in] sect_head Pointer to the section header structure
+ * @param[in] reloc_sect_idx Index of the relocation section in sect_head
+ * @param[in] header Pointer to the ELF header containing class, endianness and type
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_Reloc_structSetup(elfparser_reloc_t *reloc, const elfparser_secthead_t *sect_head, uint32_t reloc_sect_idx, const elfparser_header_t *header);
+
+/**
+ * @brief Decodes the relocation section contents
+ * @param[in,out] reloc Pointer to a relocation structure set up by ElfParser_Reloc_structSetup()
+ * @param[in] map Pointer to the contents of the relocation section
+ * @param[in] map_size Size of the section contents in bytes
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_Reloc_parse(elfparser_reloc_t *reloc, const void *map, size_t map_size);
+
+/**
+ * @brief Groups the relocations by the symbol table entry they reference
+ *
+ * key_num is sym_num, the entry count of the symbol table the section
+ * links to (sh_size / sh_entsize of sym_table_idx), so the group table is
+ * sized by the file's symbols and not by indices read from the entries. An
+ * entry whose rel_sym_idx is not below sym_num fails the call with
+ * ELFPARSER_ERR_RANGE. Group 0 collects the relocations without a symbol;
+ * SHT_RELR sections have no linked table and take a sym_num of 1.
+ *
+ * @param[out] group Pointer to the group structure to populate
+ * @param[in] reloc Pointer to a parsed relocation structure
+ * @param[in] sym_num Number of entries in the linked symbol table
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_Reloc_symGroup(elfparser_reloc_group_t *group, const elfparser_reloc_t *reloc, uint32_t sym_num);
+
+/**
+ * @brief Groups the relocations by the section they patch
+ *
+ * key_num is the number of sections. Relocations of a section with a
+ * target_sect_idx all go to that section; otherwise each rel_offset is looked
+ * up among the address ranges of the SHF_ALLOC sections, and offsets outside
+ * all of them go to group 0.
+ *
+ * @param[out] group Pointer to the group structure to populate
+ * @param[in] reloc Pointer to a parsed relocation structure
+ * @param[in] sect_head Pointer to the section header structure of the same file
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_Reloc_sectGroup(elfparser_reloc_group_t *group, const elfparser_reloc_t *reloc, const elfparser_secthead_t *sect_head);
+
+/**
+ * @brief Frees the resources held by a relocation group
+ * @param[in,out] group Pointer to the group structure to free
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_Reloc_groupFree(elfparser_reloc_group_t *group);
+
+/**
+ * @brief Frees the resources held by a relocation structure
+ * @param[in,out] reloc Pointer to the relocation structure to free
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_Reloc_free(elfparser_reloc_t *reloc);
+
+#endif /* _IG_ELFPARSER_RELOC_H_ */
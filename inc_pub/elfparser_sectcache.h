@@ -0,0 +1,149 @@
+/**
+ * @file elfparser_sectcache.h
+ * @brief Public header for the decompressed section cache of libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header provides transparent access to section contents whether or not
+ * they are compressed. Sections flagged SHF_COMPRESSED (typically .debug_*)
+ * start with a compression header and hold zlib or zstd data; the cache
+ * decompresses each one once into memory it owns and hands out a stable view
+ * until the caller releases it. Entries are keyed by the identity of the file
+ * (device, inode and modification time) and the file range of the section,
+ * so separate handles on the same file, in the same or other threads, share
+ * one copy. The total size of unpinned entries is bounded; the least recently
+ * used ones are evicted first. Uncompressed sections are returned straight
+ * from the file handle and cost no cache space.
+ *
+ * The cache is thread-safe; a file handle is not, so each thread passes its
+ * own. When several threads ask for a section that is not cached yet, one
+ * decompresses it and the others wait for the result.
+ *
+ * The codecs are opt-in, so the library builds without third-party headers.
+ * Define ELFPARSER_WITH_ZLIB and link -lz, or ELFPARSER_WITH_ZSTD and link
+ * -lzstd, to decompress sections of that type; sections of a type that is
+ * not built in fail with ELFPARSER_ERR_FORMAT. A section that announces
+ * more than its codec can expand the compressed bytes to, or more than
+ * 4 GiB, fails with ELFPARSER_ERR_RANGE before anything is allocated.
+ */
+
+#ifndef _IG_ELFPARSER_SECTCACHE_H_
+#define _IG_ELFPARSER_SECTCACHE_H_
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "../inc_pub/elfparser_common.h"
+#include "../inc_pub/elfparser_file.h"
+
+/* Compression Type Constants (ch_type) */
+#define ELFPARSER_SECTCACHE_COMPRESS_ZLIB   1u /**< zlib stream (ELFCOMPRESS_ZLIB) */
+#define ELFPARSER_SECTCACHE_COMPRESS_ZSTD   2u /**< Zstandard frames (ELFCOMPRESS_ZSTD) */
+
+/**
+ * @brief Enumeration of the state of a cache entry
+ */
+typedef enum
+{
+    ELFPARSER_SECTCACHE_ENTRY_LOADING = 0, /**< Being decompressed by one thread, others wait */
+    ELFPARSER_SECTCACHE_ENTRY_READY   = 1  /**< data holds the decompressed contents */
+} elfparser_sectcache_entry_state_e;
+
+/**
+ * @brief Decompressed contents of one section
+ */
+typedef struct elfparser_sectcache_entry_s
+{
+    uint64_t                            file_dev;    /**< Device of the file (reader file_dev) */
+    uint64_t                            file_ino;    /**< Inode of the file (reader file_ino) */
+    uint64_t                            file_mtime;  /**< Modification time of the file (reader file_mtime) */
+    uint64_t                            sect_offset; /**< Offset of the compressed section in the file */
+    uint64_t                            sect_size;   /**< Size of the compressed section in bytes */
+    uint8_t*                            data;        /**< Decompressed contents, NULL while loading */
+    size_t                              size;        /**< Size of data in bytes */
+    uint32_t                            ref_num;     /**< Number of outstanding views */
+    uint64_t                            last_use;    /**< Value of use_clock at the last hit, for LRU eviction */
+    elfparser_sectcache_entry_state_e   state;       /**< Loading or ready */
+} elfparser_sectcache_entry_t;
+
+/**
+ * @brief Counters of a cache
+ */
+typedef struct elfparser_sectcache_stats_s
+{
+    uint64_t  hits;         /**< Views served from a ready entry */
+    uint64_t  misses;       /**< Views that had to decompress */
+    uint64_t  waits;        /**< Views that waited for another thread's decompression */
+    uint64_t  evictions;    /**< Entries dropped to stay within the capacity */
+    uint64_t  bytes_out;    /**< Bytes produced by decompression */
+} elfparser_sectcache_stats_t;
+
+/**
+ * @brief Structure representing a decompressed section cache
+ */
+typedef struct elfparser_sectcache_s
+{
+    pthread_mutex_t                 lock;       /**< Guards every other member */
+    pthread_cond_t                  loaded;     /**< Signalled when a loading entry becomes ready or is dropped */
+    elfparser_sectcache_entry_t**   entries;    /**< Entries, individually allocated so waiters keep valid pointers */
+    uint32_t                        entry_num;  /**< Number of entries */
+    uint32_t                        entry_cap;  /**< Capacity of entries */
+    size_t                          capacity;   /**< Bytes of ready entries kept once unpinned */
+    size_t                          used;       /**< Bytes held by ready entries */
+    uint64_t                        use_clock;  /**< Counter stamped into last_use */
+    elfparser_sectcache_stats_t     stats;      /**< Counters */
+} elfparser_sectcache_t;
+
+/**
+ * @brief Initializes an empty cache
+ * @param[out] cache Pointer to the cache to initialize, released with ElfParser_SectCache_free()
+ * @param[in] capacity Bytes of decompressed data kept once no view pins them
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_SectCache_init(elfparser_sectcache_t *cache, size_t capacity);
+
+/**
+ * @brief Returns the contents of a section, decompressing SHF_COMPRESSED ones through the cache
+ *
+ * A compressed section's view stays valid until it is passed to
+ * ElfParser_SectCache_release(), even if the file is closed in between; an
+ * uncompressed section's view is the file's own and stays valid until the
+ * file is closed (releasing it is a harmless no-op). A section larger than
+ * the capacity is still returned and dropped once released.
+ *
+ * @param[in,out] cache Pointer to an initialized cache
+ * @param[in,out] file Pointer to an open file structure, used by this thread only
+ * @param[in] sect_idx Index of the section
+ * @param[out] data Set to the first byte of the contents, NULL for SHT_NOBITS
+ * @param[out] size Set to the size of the contents in bytes
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_FORMAT for a malformed compression header,
+ *             a compression type not built in or corrupt compressed data, ELFPARSER_ERR_RANGE for an
+ *             implausible decompressed size, or an ElfParser_Error code on failure
+ */
+int ElfParser_SectCache_get(elfparser_sectcache_t *cache, elfparser_file_t *file, uint32_t sect_idx, const void **data, size_t *size);
+
+/**
+ * @brief Releases a view returned by ElfParser_SectCache_get()
+ * @param[in,out] cache Pointer to the cache the view came from
+ * @param[in] data First byte of the view
+ * @return int ELFPARSER_SUCCESS on success (also for views of uncompressed sections), or an ElfParser_Error code on failure
+ */
+int ElfParser_SectCache_release(elfparser_sectcache_t *cache, const void *data);
+
+/**
+ * @brief Copies out the counters of a cache
+ * @param[in,out] cache Pointer to an initialized cache
+ * @param[out] stats Pointer to the counters to fill
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_SectCache_statsGet(elfparser_sectcache_t *cache, elfparser_sectcache_stats_t *stats);
+
+/**
+ * @brief Frees every entry and the cache itself; no view may be outstanding
+ * @param[in,out] cache Pointer to the cache to free
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_SectCache_free(elfparser_sectcache_t *cache);
+
+#endif /* _IG_ELFPARSER_SECTCACHE_H_ */
@@ -17,6 +17,7 @@
 #include <stdlib.h>
 #include "../inc_pub/elfparser_common.h"
 #include "../inc_pub/elfparser_header.h"
+#include "../inc_pub/elfparser_alloc.h"
 
 /* Section Type Constants (sh_type) - Corrected from macro list to enum-like defines */
 #define ELFPARSER_SECTHEAD_TYPE_NULL       0x00u  /**< Null section */
@@ -30,6 +31,10 @@
 #define ELFPARSER_SECTHEAD_TYPE_NOBITS     0x08u /**< No bits (uninitialized data) */
 #define ELFPARSER_SECTHEAD_TYPE_REL        0x09u /**< Relocation entries without addends */
 #define ELFPARSER_SECTHEAD_TYPE_SHLIB      0x0Au /**< Reserved for shared libraries */
+#define ELFPARSER_SECTHEAD_TYPE_DYNSYM     0x0Bu /**< Dynamic linker symbol table */
+#define ELFPARSER_SECTHEAD_TYPE_SYMTAB_SHNDX 0x12u /**< Extended section indices of a symbol table */
+#define ELFPARSER_SECTHEAD_TYPE_RELR       0x13u /**< Packed relative relocations */
+#define ELFPARSER_SECTHEAD_TYPE_GNU_HASH   0x6ffffff6u /**< GNU-style symbol hash table */
 
 /* Section Flag Constants (sh_flags) */
 #define ELFPARSER_SECTHEAD_FLAG_WRITE           0x00000001u /**< Writable section */
@@ -42,6 +47,7 @@
 #define ELFPARSER_SECTHEAD_FLAG_OS_NONCONFORM   0x00000100u /**< Non-standard OS-specific handling */
 #define ELFPARSER_SECTHEAD_FLAG_GROUP           0x00000200u /**< Part of a section group */
 #define ELFPARSER_SECTHEAD_FLAG_TLS             0x00000400u /**< Thread-local storage */
+#define ELFPARSER_SECTHEAD_FLAG_COMPRESSED      0x00000800u /**< Contents start with a compression header */
 #define ELFPARSER_SECTHEAD_FLAG_MASK_OS         0x0ff00000u /**< OS-specific flags mask */
 #define ELFPARSER_SECTHEAD_FLAG_MASK_PROC       0xf0000000u /**< Processor-specific flags mask */
 
@@ -50,7 +56,8 @@
  */
 typedef struct elfparser_secthead_entry_s
 {
-    char*     sh_name;       /**< Section name (dynamically allocated string) */
+    const char* sh_name;     /**< Section name (owned copy or view into the map, see name_mode) */
+    uint32_t  sh_name_len;   /**< Length of sh_name without terminator (set by name resolve) */
     uint32_t  sh_name_idx;   /**< Index of name in string table (sh_name) */
     uint32_t  sh_type;       /**< Section type (e.g., ELFPARSER_SECTHEAD_TYPE_*) */
     uint64_t  sh_flags;      /**< Section flags (e.g., ELFPARSER_SECTHEAD_FLAG_*) */
@@ -71,10 +78,13 @@ typedef struct elfparser_secthead_s
     elfparser_secthead_entry_t* table;           /**< Array of section header entries */
     elfparser_header_class_e    elf_class;       /**< ELF class (32-bit or 64-bit) */
     elfparser_header_data_e     elf_data;        /**< Data encoding (endianness) */
-    uint16_t                    table_len;       /**< Number of entries in table */
+    uint32_t                    table_len;       /**< Number of entries in table (at most INT32_MAX) */
     uint16_t                    entry_size;      /**< Size of each entry in bytes */
-    uint16_t                    string_table_idx; /**< Index of string table section */
+    uint32_t                    string_table_idx; /**< Index of string table section */
     uint32_t                    max_idx;         /**< Maximum string table index encountered */
+    elfparser_name_mode_e       name_mode;       /**< Ownership of the resolved sh_name strings */
+    char*                       name_arena;      /**< Single block holding all names in arena mode */
+    const elfparser_alloc_t*    alloc;           /**< Allocator of the table and names, NULL for malloc */
 } elfparser_secthead_t;
 
 /**
@@ -85,6 +95,15 @@ typedef struct elfparser_secthead_s
  */
 int ElfParser_SectHead_structSetup(elfparser_secthead_t *sect_head, const elfparser_header_t *header);
 
+/**
+ * @brief Sets up the section header structure, allocating the table and names through an allocator
+ * @param[out] sect_head Pointer to the section header structure to initialize
+ * @param[in] header Pointer to the ELF header containing section metadata
+ * @param[in] alloc Allocator used until ElfParser_SectHead_free(), NULL for malloc; must outlive the structure
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_SectHead_structSetupAlloc(elfparser_secthead_t *sect_head, const elfparser_header_t *header, const elfparser_alloc_t *alloc);
+
 /**
  * @brief Parses the section header table from a memory map
  * @param[out] sect_head Pointer to the section header structure to populate
@@ -96,12 +115,50 @@ int ElfParser_SectHead_parse(elfparser_secthead_t *sect_head, const void *map, s
 
 /**
  * @brief Resolves section names from the string table
- * @param[in] sect_head Pointer to the section header structure
+ *
+ * Every sh_name becomes a separately allocated copy. Names or the block of an
+ * earlier resolve are released first and the table returns to
+ * ELFPARSER_NAME_MODE_OWNED.
+ *
+ * @param[in,out] sect_head Pointer to the section header structure
  * @param[in] map Pointer to the memory-mapped ELF file
  * @param[in] map_size Size of the memory map in bytes
  * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
  */
-int ElfParser_SectHead_nameResolve(const elfparser_secthead_t *sect_head, const void *map, size_t map_size);
+int ElfParser_SectHead_nameResolve(elfparser_secthead_t *sect_head, const void *map, size_t map_size);
+
+/**
+ * @brief Resolves section names as views into the string table without copying
+ *
+ * Every sh_name is pointed straight into map and sh_name_len is set to the
+ * validated length of the name; the terminator is guaranteed to lie inside map.
+ * No memory is allocated, so map must stay valid for as long as the names are
+ * used. The string table is validated before names of an earlier resolve are
+ * released, so a failed call leaves the table as it was.
+ * ElfParser_SectHead_free() leaves the names untouched in this mode.
+ *
+ * @param[in,out] sect_head Pointer to the section header structure
+ * @param[in] map Pointer to the memory-mapped string table
+ * @param[in] map_size Size of the memory map in bytes
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_SectHead_nameResolveView(elfparser_secthead_t *sect_head, const void *map, size_t map_size);
+
+/**
+ * @brief Resolves section names into a single block owned by the table
+ *
+ * The referenced part of the string table (up to the end of the name at max_idx)
+ * is measured once, copied into one allocation and every sh_name is pointed into
+ * that block, so map may be released afterwards. Names or the block of an earlier
+ * resolve are released once the new block is filled. ElfParser_SectHead_free()
+ * releases all names with a single free().
+ *
+ * @param[in,out] sect_head Pointer to the section header structure
+ * @param[in] map Pointer to the memory-mapped string table
+ * @param[in] map_size Size of the memory map in bytes
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_SectHead_nameResolveArena(elfparser_secthead_t *sect_head, const void *map, size_t map_size);
 
 /**
  * @brief Frees the section header structure and its allocated resources
@@ -120,4 +177,19 @@ int ElfParser_SectHead_free(elfparser_secthead_t *sect_head);
  */
 int32_t ElfParser_SectHead_byNameFind(const elfparser_secthead_t *sect_head, const char *name, size_t start_idx);
 
+/**
+ * @brief Finds a section header by type
+ *
+ * Compares one integer per entry instead of a name, and works when section
+ * names are unresolved. Pass the previous result plus one as start_idx to
+ * visit every section of a type.
+ *
+ * @param[in] sect_head Pointer to the section header structure
+ * @param[in] type Section type to find (e.g., ELFPARSER_SECTHEAD_TYPE_DYNSYM)
+ * @param[in] start_idx Starting index for the search
+ * @return int32_t Index of the found section, ELFPARSER_ERR_NOT_FOUND if no section has the type,
+ *                 or an ElfParser_Error code on failure
+ */
+int32_t ElfParser_SectHead_byTypeFind(const elfparser_secthead_t *sect_head, uint32_t type, size_t start_idx);
+
 #endif /* _IG_ELFPARSER_SECTHEAD_H_ */
\ No newline at end of file
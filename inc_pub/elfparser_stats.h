@@ -0,0 +1,130 @@
+/**
+ * @file elfparser_stats.h
+ * @brief Public header for per-phase parse statistics and tracing hooks in libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header provides an optional view of where a parse spends its time.
+ * Each call of a parse function belongs to one phase (ident, header, section
+ * table, name resolution, symbol table) and is measured as a span: wall time,
+ * bytes of its input touched, entries decoded, allocations made through the
+ * table allocator, and the input offset it failed at. Spans are summed per
+ * phase into a caller-provided elfparser_stats_t and/or handed to begin and
+ * end callbacks, e.g. to forward them to a tracing system.
+ *
+ * Registration is per thread and covers the calls made by that thread,
+ * including the work they hand to helper threads. While nothing is registered
+ * a parse function only tests one thread-local flag before doing its work.
+ */
+
+#ifndef _IG_ELFPARSER_STATS_H_
+#define _IG_ELFPARSER_STATS_H_
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include "../inc_pub/elfparser_common.h"
+
+#define ELFPARSER_STATS_OFFSET_NONE UINT64_MAX  /**< Error offset when there was no error or it has no position */
+
+/**
+ * @brief Parse phases
+ */
+typedef enum elfparser_phase_e
+{
+    ELFPARSER_PHASE_IDENT = 0,  /**< ElfParser_Header_identParse() */
+    ELFPARSER_PHASE_HEADER,     /**< ElfParser_Header_parse(), parseRaw() and extendedResolve() */
+    ELFPARSER_PHASE_SECTHEAD,   /**< Section header table setup and decode */
+    ELFPARSER_PHASE_NAMES,      /**< Section and symbol name resolution, in any name mode */
+    ELFPARSER_PHASE_SYMTABLE,   /**< Symbol table setup, decode and extended section index resolution */
+    ELFPARSER_PHASE_NUM         /**< Number of phases */
+} elfparser_phase_e;
+
+/**
+ * @brief Measurements of one call of a parse function
+ */
+typedef struct elfparser_span_s
+{
+    elfparser_phase_e           phase;          /**< Phase of the call */
+    int                         ret;            /**< Return value of the call, valid in the end callback */
+    uint64_t                    wall_ns;        /**< Wall time of the call in nanoseconds */
+    uint64_t                    bytes;          /**< Bytes of the input read by the call, 0 if it failed */
+    uint64_t                    entries;        /**< Entries decoded or resolved, 0 if it failed */
+    uint64_t                    allocs;         /**< Allocations made through the table allocator */
+    uint64_t                    alloc_bytes;    /**< Bytes requested by those allocations */
+    uint64_t                    error_offset;   /**< Offset in the call's input where it failed, or ELFPARSER_STATS_OFFSET_NONE */
+    uint64_t                    start_ns;       /**< Internal: monotonic start time */
+    struct elfparser_span_s*    parent;         /**< Internal: span the call is nested in */
+} elfparser_span_t;
+
+/**
+ * @brief Totals of one phase
+ */
+typedef struct elfparser_phase_stats_s
+{
+    uint64_t    calls;              /**< Spans recorded */
+    uint64_t    wall_ns;            /**< Summed wall time in nanoseconds */
+    uint64_t    bytes;              /**< Summed bytes of input read */
+    uint64_t    entries;            /**< Summed entries decoded or resolved */
+    uint64_t    allocs;             /**< Summed allocations */
+    uint64_t    alloc_bytes;        /**< Summed bytes allocated */
+    uint64_t    errors;             /**< Spans that failed */
+    int         first_error;        /**< Return value of the first failed span, ELFPARSER_SUCCESS if none */
+    uint64_t    first_error_offset; /**< error_offset of the first failed span */
+} elfparser_phase_stats_t;
+
+/**
+ * @brief Per-phase totals collected on one thread
+ */
+typedef struct elfparser_stats_s
+{
+    elfparser_phase_stats_t phase[ELFPARSER_PHASE_NUM]; /**< Totals indexed by elfparser_phase_e */
+} elfparser_stats_t;
+
+/**
+ * @brief Tracing callbacks
+ *
+ * begin_fn runs before the clock of a span starts and end_fn after it stops,
+ * so the time spent in the callbacks is not charged to the phase. Either may
+ * be NULL.
+ */
+typedef struct elfparser_trace_s
+{
+    void    (*begin_fn)(void *ctx, elfparser_phase_e phase);        /**< Called when a span opens */
+    void    (*end_fn)(void *ctx, const elfparser_span_t *span);     /**< Called when a span closes */
+    void*   ctx;                                                    /**< Passed to both callbacks */
+} elfparser_trace_t;
+
+/**
+ * @brief Starts collecting spans of the calling thread
+ *
+ * Replaces an earlier registration of the thread. stats is not cleared, so
+ * totals accumulate across registrations until ElfParser_Stats_reset().
+ *
+ * @param[in,out] stats Totals to add every span to, NULL for none; must stay valid while registered
+ * @param[in] trace Callbacks to run for every span, NULL for none (copied)
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if both stats and trace are NULL
+ */
+int ElfParser_Stats_register(elfparser_stats_t *stats, const elfparser_trace_t *trace);
+
+/**
+ * @brief Stops collecting spans of the calling thread
+ * @return int ELFPARSER_SUCCESS
+ */
+int ElfParser_Stats_unregister(void);
+
+/**
+ * @brief Clears per-phase totals
+ * @param[out] stats Totals to clear
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if stats is NULL
+ */
+int ElfParser_Stats_reset(elfparser_stats_t *stats);
+
+/**
+ * @brief Returns a printable name of a phase
+ * @param[in] phase Phase
+ * @return const char* Lower-case name, "unknown" if phase is out of range
+ */
+const char *ElfParser_Stats_phaseName(elfparser_phase_e phase);
+
+#endif /* _IG_ELFPARSER_STATS_H_ */
@@ -0,0 +1,84 @@
+/**
+ * @file elfparser_symcache.h
+ * @brief Public header for the persistent symbol cache of libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header provides a symbol cache that stores the decoded section headers
+ * and symbol tables of an ELF file in a cache directory, in one index file
+ * named after the file's GNU build-id. Later loads of the same file read that
+ * index instead of decoding the ELF tables: the file is only opened far
+ * enough to read its header and build-id note. An index is used only if its
+ * checksum verifies and it matches the file's build-id, size, inode,
+ * modification time, section header table offset, class, data encoding and
+ * machine, so a file rewritten in place or replaced under the same name
+ * is parsed again even if its build-id did not change; a
+ * missing, stale or corrupt index is replaced by a fresh parse, so callers
+ * always get the same tables either way.
+ */
+
+#ifndef _IG_ELFPARSER_SYMCACHE_H_
+#define _IG_ELFPARSER_SYMCACHE_H_
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include "../inc_pub/elfparser_common.h"
+#include "../inc_pub/elfparser_secthead.h"
+#include "../inc_pub/elfparser_symtable.h"
+#include "../inc_pub/elfparser_note.h"
+#include "../inc_pub/elfparser_file.h"
+
+/**
+ * @brief Enumeration of where the tables of a load came from
+ */
+typedef enum
+{
+    ELFPARSER_SYMCACHE_SOURCE_HIT      = 0, /**< Read from a valid index */
+    ELFPARSER_SYMCACHE_SOURCE_MISS     = 1, /**< No index yet; parsed and index written */
+    ELFPARSER_SYMCACHE_SOURCE_STALE    = 2, /**< Index stale or corrupt; parsed and index rewritten */
+    ELFPARSER_SYMCACHE_SOURCE_UNCACHED = 3  /**< Parsed; no cache directory, no build-id or the index could not be written */
+} elfparser_symcache_source_e;
+
+/**
+ * @brief Section headers and symbol tables of one file, independent of the file
+ *
+ * All names are in arena mode, so nothing refers to the ELF file once the
+ * load returns.
+ */
+typedef struct elfparser_symcache_s
+{
+    elfparser_secthead_t        sect_head;      /**< Section headers with resolved names */
+    elfparser_symtable_t*       sym_tables;     /**< Every SHT_SYMTAB and SHT_DYNSYM table, in section order */
+    uint32_t*                   sym_sect_idx;   /**< Section index of each entry of sym_tables */
+    uint32_t                    sym_table_num;  /**< Number of entries in sym_tables */
+    uint8_t                     build_id[ELFPARSER_NOTE_BUILD_ID_MAX]; /**< GNU build-id of the file */
+    uint32_t                    build_id_len;   /**< Length of build_id, 0 if the file has none */
+    elfparser_symcache_source_e source;         /**< Where the tables came from */
+} elfparser_symcache_t;
+
+/**
+ * @brief Loads the section headers and symbol tables of a file through the cache
+ *
+ * Files without a build-id, and every file when cache_dir is NULL, are parsed
+ * without touching the cache. The cache directory is created if it does not
+ * exist; index files are replaced atomically, so concurrent loads of the same
+ * file from several processes are safe. Failing to write an index is not an
+ * error; source then reports ELFPARSER_SYMCACHE_SOURCE_UNCACHED.
+ *
+ * @param[out] cache Pointer to the structure to fill, released with ElfParser_SymCache_free()
+ * @param[in] cache_dir Directory holding the index files, NULL to bypass the cache
+ * @param[in] path Path of the ELF file
+ * @param[in] file_flags ELFPARSER_FILE_FLAG_* values the file is opened with
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code if the file cannot be parsed
+ */
+int ElfParser_SymCache_load(elfparser_symcache_t *cache, const char *cache_dir, const char *path, uint32_t file_flags);
+
+/**
+ * @brief Frees the tables of a loaded cache structure
+ * @param[in,out] cache Pointer to the structure filled by ElfParser_SymCache_load()
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_SymCache_free(elfparser_symcache_t *cache);
+
+#endif /* _IG_ELFPARSER_SYMCACHE_H_ */
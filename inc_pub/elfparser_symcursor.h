@@ -0,0 +1,107 @@
+/**
+ * @file elfparser_symcursor.h
+ * @brief Public header for streaming symbol table iteration in libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header provides the public interface for walking a .symtab or .dynsym
+ * section without materializing it. A cursor decodes entries on demand into a
+ * small caller-provided batch buffer, applies optional type, binding and
+ * section filters while decoding, and points sym_name into the mapped string
+ * table, so memory use is constant in the table size and a walk can stop as
+ * soon as the caller has found what it needs.
+ */
+
+#ifndef _IG_ELFPARSER_SYMCURSOR_H_
+#define _IG_ELFPARSER_SYMCURSOR_H_
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include "../inc_pub/elfparser_common.h"
+#include "../inc_pub/elfparser_secthead.h"
+#include "../inc_pub/elfparser_symtable.h"
+
+/* Filter Constants */
+#define ELFPARSER_SYMCURSOR_ANY         0x0000u     /**< Type or binding mask accepting every value */
+#define ELFPARSER_SYMCURSOR_SECT_ANY    0xFFFFFFFFu /**< Section filter accepting every st_shndx */
+#define ELFPARSER_SYMCURSOR_MASK(value) (1u << ((value) & 0x0Fu)) /**< Mask bit of an ELFPARSER_SYMTABLE_TYPE_* or _BIND_* value */
+
+/**
+ * @brief Structure representing a position in a symbol table section plus its filters
+ */
+typedef struct elfparser_symcursor_s
+{
+    const uint8_t*              sym_map;    /**< Start of the symbol table section inside the file map */
+    const char*                 str_map;    /**< Start of the linked string table */
+    size_t                      str_size;   /**< Size of the string table in bytes */
+    elfparser_header_class_e    elf_class;  /**< ELF class (32-bit or 64-bit) */
+    elfparser_header_data_e     elf_data;   /**< Data encoding (endianness) */
+    uint32_t                    table_len;  /**< Number of entries in the section */
+    uint16_t                    entry_size; /**< Size of each entry in bytes */
+    uint32_t                    next_idx;   /**< Index of the next entry to decode */
+    uint16_t                    type_mask;  /**< Accepted types, ELFPARSER_SYMCURSOR_ANY for all */
+    uint16_t                    bind_mask;  /**< Accepted bindings, ELFPARSER_SYMCURSOR_ANY for all */
+    uint32_t                    sect_idx;   /**< Accepted raw st_shndx, ELFPARSER_SYMCURSOR_SECT_ANY for all */
+} elfparser_symcursor_t;
+
+/**
+ * @brief Opens a cursor at the first entry of a symbol table section
+ *
+ * Nothing is allocated; the cursor refers to map, which must stay valid while
+ * the cursor and the names it returns are used. The string table is found
+ * through sh_link.
+ *
+ * @param[out] cursor Pointer to the cursor structure to initialize
+ * @param[in] sect_head Pointer to a parsed section header table of the file
+ * @param[in] sym_sect_idx Index of the SHT_SYMTAB or SHT_DYNSYM section
+ * @param[in] map Pointer to the memory-mapped ELF file
+ * @param[in] map_size Size of the memory map in bytes
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_SymCursor_open(elfparser_symcursor_t *cursor, const elfparser_secthead_t *sect_head, uint32_t sym_sect_idx,
+                             const void *map, size_t map_size);
+
+/**
+ * @brief Sets the filters applied by ElfParser_SymCursor_next()
+ *
+ * Masks are built from ELFPARSER_SYMCURSOR_MASK() of the accepted values.
+ * The section filter compares the raw st_shndx, so escaped indices appear as
+ * ELFPARSER_SYMTABLE_SECT_XINDEX.
+ *
+ * @param[in,out] cursor Pointer to the cursor structure
+ * @param[in] type_mask Accepted symbol types, ELFPARSER_SYMCURSOR_ANY for all
+ * @param[in] bind_mask Accepted symbol bindings, ELFPARSER_SYMCURSOR_ANY for all
+ * @param[in] sect_idx Accepted section index, ELFPARSER_SYMCURSOR_SECT_ANY for all
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_SymCursor_filterSet(elfparser_symcursor_t *cursor, uint16_t type_mask, uint16_t bind_mask, uint32_t sect_idx);
+
+/**
+ * @brief Moves the cursor to an entry index
+ * @param[in,out] cursor Pointer to the cursor structure
+ * @param[in] sym_idx Index of the next entry to decode (table_len ends the walk)
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_SymCursor_seek(elfparser_symcursor_t *cursor, uint32_t sym_idx);
+
+/**
+ * @brief Decodes the next batch of entries that pass the filters
+ *
+ * Entries are decoded batch_len at a time, filtered in place and returned with
+ * sym_name pointing into the string table. The call returns once the batch is
+ * full, the table ends or a passing entry has a name that does not fit the
+ * string table, so the walk is over only once a call returns 0. The entries
+ * before a bad name are returned first; the call after that returns
+ * ELFPARSER_ERR_SIZE for it and moves the cursor past it, so the caller can
+ * skip it and carry on.
+ *
+ * @param[in,out] cursor Pointer to the cursor structure
+ * @param[out] batch Destination array of batch_len entries
+ * @param[out] sym_idx Optional destination array of batch_len table indices of the returned entries
+ * @param[in] batch_len Capacity of batch
+ * @return int64_t Number of entries returned (0 once the table is exhausted), or an ElfParser_Error code on failure
+ */
+int64_t ElfParser_SymCursor_next(elfparser_symcursor_t *cursor, elfparser_symtable_entry_t *batch, uint32_t *sym_idx, size_t batch_len);
+
+#endif /* _IG_ELFPARSER_SYMCURSOR_H_ */
@@ -0,0 +1,70 @@
+/**
+ * @file elfparser_symindex.h
+ * @brief Public header for the symbol name hash index in libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header provides the public interface for an optional name index built
+ * once over a parsed and name-resolved symbol table. The index is an
+ * open-addressing hash table keyed by symbol name with precomputed hashes;
+ * symbols sharing a name are chained in ascending table order, so lookups keep
+ * the start_idx semantics of ElfParser_SymTable_byNameFind() while running in
+ * O(1) expected time.
+ */
+
+#ifndef _IG_ELFPARSER_SYMINDEX_H_
+#define _IG_ELFPARSER_SYMINDEX_H_
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include "../inc_pub/elfparser_common.h"
+#include "../inc_pub/elfparser_symtable.h"
+
+/**
+ * @brief Structure representing one slot of the symbol name hash index
+ */
+typedef struct elfparser_symindex_slot_s
+{
+    uint32_t hash;      /**< Precomputed hash of the name stored in this slot */
+    uint32_t head_idx;  /**< Lowest symbol index with this name, plus one (0 marks an empty slot) */
+} elfparser_symindex_slot_t;
+
+/**
+ * @brief Structure representing the symbol name hash index
+ */
+typedef struct elfparser_symindex_s
+{
+    const elfparser_symtable_t* symbol_table; /**< Indexed symbol table (must outlive the index) */
+    elfparser_symindex_slot_t*  slots;        /**< Open-addressing slot array */
+    uint32_t*                   next_idx;     /**< Next symbol index with the same name, per symbol */
+    uint32_t                    slot_mask;    /**< Number of slots minus one (slot count is a power of two) */
+    uint32_t                    table_len;    /**< Number of indexed symbols */
+} elfparser_symindex_t;
+
+/**
+ * @brief Builds a name hash index over a parsed and name-resolved symbol table
+ * @param[out] symbol_index Pointer to the index structure to populate
+ * @param[in] symbol_table Pointer to the symbol table; names must already be resolved
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_SymIndex_build(elfparser_symindex_t *symbol_index, const elfparser_symtable_t *symbol_table);
+
+/**
+ * @brief Finds a symbol by name through the hash index
+ * @param[in] symbol_index Pointer to the index structure
+ * @param[in] name Name of the symbol to find
+ * @param[in] start_idx Starting index for the search
+ * @return int32_t Lowest index >= start_idx whose name matches, ELFPARSER_ERR_NOT_FOUND if none,
+ *                 or an ElfParser_Error code on failure
+ */
+int32_t ElfParser_SymIndex_byNameFind(const elfparser_symindex_t *symbol_index, const char *name, size_t start_idx);
+
+/**
+ * @brief Frees the resources held by a symbol name hash index
+ * @param[in,out] symbol_index Pointer to the index structure to free
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_SymIndex_free(elfparser_symindex_t *symbol_index);
+
+#endif /* _IG_ELFPARSER_SYMINDEX_H_ */
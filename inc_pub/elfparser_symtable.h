@@ -19,6 +19,7 @@
 #include "../inc_pub/elfparser_common.h"
 #include "../inc_pub/elfparser_secthead.h"
 #include "../inc_pub/elfparser_header.h"
+#include "../inc_pub/elfparser_alloc.h"
 
 /* Symbol Binding Constants (st_info binding portion) */
 #define ELFPARSER_SYMTABLE_BIND_NUM         0x03 /**< Number of standard binding types */
@@ -52,6 +53,12 @@
 #define ELFPARSER_SYMTABLE_VISIBILITY_HIDDEN    0x02 /**< Hidden visibility (STV_HIDDEN) */
 #define ELFPARSER_SYMTABLE_VISIBILITY_PROTECTED 0x03 /**< Protected visibility (STV_PROTECTED) */
 
+/* Special Section Indices (st_shndx) */
+#define ELFPARSER_SYMTABLE_SECT_UNDEF       0x0000u /**< Undefined symbol (SHN_UNDEF) */
+#define ELFPARSER_SYMTABLE_SECT_ABS         0xFFF1u /**< Absolute value (SHN_ABS) */
+#define ELFPARSER_SYMTABLE_SECT_COMMON      0xFFF2u /**< Common block (SHN_COMMON) */
+#define ELFPARSER_SYMTABLE_SECT_XINDEX      0xFFFFu /**< Real index held in SHT_SYMTAB_SHNDX (SHN_XINDEX) */
+
 /* Return Value Constants */
 #define ELFPARSER_SYMTABLE_NOT_FOUND -1 /**< Return value indicating symbol not found in ElfParser_SymTable_byNameFind */
 
@@ -60,12 +67,13 @@
  */
 typedef struct elfparser_symtable_entry_s
 {
-    char*    sym_name;       /**< Symbol name (dynamically allocated string) */
+    const char* sym_name;    /**< Symbol name (owned copy or view into the map, see name_mode) */
+    uint32_t sym_name_len;   /**< Length of sym_name without terminator (set by name resolve) */
     uint32_t sym_name_idx;   /**< Index of name in string table (st_name) */
     uint8_t  sym_bind;       /**< Symbol binding (e.g., ELFPARSER_SYMTABLE_BIND_*) */
     uint8_t  sym_type;       /**< Symbol type (e.g., ELFPARSER_SYMTABLE_TYPE_*) */
     uint8_t  sym_visibility; /**< Symbol visibility (e.g., ELFPARSER_SYMTABLE_VISIBILITY_*) */
-    uint16_t sym_sect_idx;   /**< Index of associated section (st_shndx) */
+    uint32_t sym_sect_idx;   /**< Index of associated section (st_shndx, see ElfParser_SymTable_shndxResolve) */
     uint64_t sym_value;      /**< Symbol value (st_value, address or offset) */
     uint64_t sym_size;       /**< Symbol size in bytes (st_size) */
 } elfparser_symtable_entry_t;
@@ -78,21 +86,41 @@ typedef struct elfparser_symtable_s
     elfparser_symtable_entry_t* table;           /**< Array of symbol table entries */
     elfparser_header_class_e    elf_class;       /**< ELF class (32-bit or 64-bit) */
     elfparser_header_data_e     elf_data;        /**< Data encoding (endianness) */
-    uint16_t                    table_len;       /**< Number of entries in table */
+    uint32_t                    table_len;       /**< Number of entries in table (at most INT32_MAX) */
     uint16_t                    entry_size;      /**< Size of each entry in bytes */
-    uint16_t                    string_table_idx; /**< Index of string table section */
+    uint32_t                    string_table_idx; /**< Index of string table section */
     uint32_t                    max_idx;         /**< Maximum string table index encountered */
+    elfparser_name_mode_e       name_mode;       /**< Ownership of the resolved sym_name strings */
+    char*                       name_arena;      /**< Single block holding all names in arena mode */
+    const elfparser_alloc_t*    alloc;           /**< Allocator of the table and names, NULL for malloc */
 } elfparser_symtable_t;
 
 /**
  * @brief Sets up the symbol table structure using section and header data
+ *
+ * Works for SHT_SYMTAB and SHT_DYNSYM alike: the string table holding the
+ * names is the section named by the symbol table's sh_link (.strtab or
+ * .dynstr), so .dynsym loads from stripped binaries that have no .strtab.
+ *
  * @param[out] symbol_table Pointer to the symbol table structure to initialize
  * @param[in] sect_head Pointer to the section header structure
  * @param[in] symbol_table_sect_idx Index of the symbol table section in sect_head
  * @param[in] header Pointer to the ELF header containing class and endianness
  * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
  */
-int ElfParser_SymTable_structSetup(elfparser_symtable_t *symbol_table, const elfparser_secthead_t *sect_head, uint16_t symbol_table_sect_idx, const elfparser_header_t *header);
+int ElfParser_SymTable_structSetup(elfparser_symtable_t *symbol_table, const elfparser_secthead_t *sect_head, uint32_t symbol_table_sect_idx, const elfparser_header_t *header);
+
+/**
+ * @brief Sets up the symbol table structure, allocating the table and names through an allocator
+ * @param[out] symbol_table Pointer to the symbol table structure to initialize
+ * @param[in] sect_head Pointer to the section header structure
+ * @param[in] symbol_table_sect_idx Index of the symbol table section in sect_head
+ * @param[in] header Pointer to the ELF header containing class and endianness
+ * @param[in] alloc Allocator used until ElfParser_SymTable_free(), NULL for malloc; must outlive the structure
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_SymTable_structSetupAlloc(elfparser_symtable_t *symbol_table, const elfparser_secthead_t *sect_head, uint32_t symbol_table_sect_idx,
+                                        const elfparser_header_t *header, const elfparser_alloc_t *alloc);
 
 /**
  * @brief Parses the symbol table from a memory map
@@ -103,14 +131,98 @@ int ElfParser_SymTable_structSetup(elfparser_symtable_t *symbol_table, const elf
  */
 int ElfParser_SymTable_parse(elfparser_symtable_t *symbol_table, const void *map, size_t map_size);
 
+/**
+ * @brief Replaces SHN_XINDEX section indices with the values of the matching SHT_SYMTAB_SHNDX section
+ *
+ * Files with 0xff00 or more sections store the section index of such symbols
+ * in a parallel array of 32-bit words instead of st_shndx. Every entry whose
+ * sym_sect_idx is ELFPARSER_SYMTABLE_SECT_XINDEX gets the word at its own
+ * index; other entries are left unchanged.
+ *
+ * @param[in,out] symbol_table Pointer to a parsed symbol table structure
+ * @param[in] map Pointer to the contents of the SHT_SYMTAB_SHNDX section linked to this table
+ * @param[in] map_size Size of the section contents in bytes
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_SymTable_shndxResolve(elfparser_symtable_t *symbol_table, const void *map, size_t map_size);
+
 /**
  * @brief Resolves symbol names from the string table
- * @param[in] symbol_table Pointer to the symbol table structure
+ *
+ * Every sym_name becomes a separately allocated copy. Names or the block of an
+ * earlier resolve are released first and the table returns to
+ * ELFPARSER_NAME_MODE_OWNED.
+ *
+ * @param[in,out] symbol_table Pointer to the symbol table structure
  * @param[in] map Pointer to the memory-mapped ELF file
  * @param[in] map_size Size of the memory map in bytes
  * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
  */
-int ElfParser_SymTable_nameResolve(const elfparser_symtable_t *symbol_table, const void *map, size_t map_size);
+int ElfParser_SymTable_nameResolve(elfparser_symtable_t *symbol_table, const void *map, size_t map_size);
+
+/**
+ * @brief Parses the symbol table from a memory map on several threads
+ *
+ * Same contract and results as ElfParser_SymTable_parse(); the entry range is
+ * cut into chunks that are decoded concurrently and the per-chunk max_idx
+ * values are merged at the end. Worth it for tables of many thousands of entries.
+ *
+ * @param[out] symbol_table Pointer to the symbol table structure to populate
+ * @param[in] map Pointer to the memory-mapped ELF file
+ * @param[in] map_size Size of the memory map in bytes
+ * @param[in] thread_num Number of threads to use, 0 for one per online CPU
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_SymTable_parseParallel(elfparser_symtable_t *symbol_table, const void *map, size_t map_size, uint32_t thread_num);
+
+/**
+ * @brief Resolves symbol names from the string table on several threads
+ *
+ * Same contract as ElfParser_SymTable_nameResolve(). On failure the error of
+ * the lowest failing entry is returned, independent of thread scheduling;
+ * names already duplicated are released by ElfParser_SymTable_free(). Runs on
+ * the calling thread alone if the table's allocator is not thread-safe.
+ *
+ * @param[in,out] symbol_table Pointer to the symbol table structure
+ * @param[in] map Pointer to the memory-mapped ELF file
+ * @param[in] map_size Size of the memory map in bytes
+ * @param[in] thread_num Number of threads to use, 0 for one per online CPU
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_SymTable_nameResolveParallel(elfparser_symtable_t *symbol_table, const void *map, size_t map_size, uint32_t thread_num);
+
+/**
+ * @brief Resolves symbol names as views into the string table without copying
+ *
+ * Every sym_name is pointed straight into map and sym_name_len is set to the
+ * validated length of the name; the terminator is guaranteed to lie inside map.
+ * No memory is allocated, so map must stay valid for as long as the names are
+ * used. The string table is validated before names of an earlier resolve are
+ * released, so a failed call leaves the table as it was.
+ * ElfParser_SymTable_free() leaves the names untouched in this mode.
+ *
+ * @param[in,out] symbol_table Pointer to the symbol table structure
+ * @param[in] map Pointer to the memory-mapped string table
+ * @param[in] map_size Size of the memory map in bytes
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_SymTable_nameResolveView(elfparser_symtable_t *symbol_table, const void *map, size_t map_size);
+
+/**
+ * @brief Resolves symbol names into a single block owned by the table
+ *
+ * The referenced part of the string table (up to the end of the name at max_idx)
+ * is measured once, copied into one allocation and every sym_name is pointed into
+ * that block, so map may be released afterwards. Names or the block of an earlier
+ * resolve are released once the new block is filled. ElfParser_SymTable_free()
+ * releases all names with a single free().
+ *
+ * @param[in,out] symbol_table Pointer to the symbol table structure
+ * @param[in] map Pointer to the memory-mapped string table
+ * @param[in] map_size Size of the memory map in bytes
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+int ElfParser_SymTable_nameResolveArena(elfparser_symtable_t *symbol_table, const void *map, size_t map_size);
 
 /**
  * @brief Frees the symbol table structure and its allocated resources
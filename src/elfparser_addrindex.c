@@ -0,0 +1,349 @@
+/**
+ * @file elfparser_addrindex.c
+ * @brief Address-to-symbol index functions for libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This file implements the address index declared in elfparser_addrindex.h.
+ * Building sorts the candidate symbols by start address and sweeps them with a
+ * priority heap to produce disjoint segments, each owned by the symbol that
+ * wins under the documented overlap rules. Lookups search an Eytzinger copy
+ * of the segment starts; batched lookups merge against the sorted array.
+ */
+
+#include "../inc_pub/elfparser_addrindex.h"
+#include <stdlib.h>
+
+/**
+ * @brief Structure describing one indexed symbol range during the build
+ */
+typedef struct addrindex_cand_s
+{
+    uint64_t start;    /**< First covered address */
+    uint64_t end;      /**< Exclusive end address */
+    uint32_t sym_idx;  /**< Symbol table index */
+} addrindex_cand_t;
+
+/**
+ * @brief Orders candidates by start address, then by priority
+ * @param[in] a First candidate
+ * @param[in] b Second candidate
+ * @return int qsort-style comparison result
+ */
+static int AddrIndex_candCmp(const void *a, const void *b)
+{
+    const addrindex_cand_t *ca = a;
+    const addrindex_cand_t *cb = b;
+
+    if (ca->start != cb->start)
+    {
+        return (ca->start < cb->start) ? -1 : 1;
+    }
+    if (ca->end != cb->end)
+    {
+        return (ca->end < cb->end) ? -1 : 1;
+    }
+    return (ca->sym_idx < cb->sym_idx) ? -1 : (ca->sym_idx > cb->sym_idx);
+}
+
+/**
+ * @brief Tells whether candidate a takes precedence over candidate b where both cover an address
+ * @param[in] a First candidate
+ * @param[in] b Second candidate
+ * @return int Non-zero if a wins
+ */
+static int AddrIndex_candWins(const addrindex_cand_t *a, const addrindex_cand_t *b)
+{
+    if (a->start != b->start)
+    {
+        return a->start > b->start;  // Innermost (latest starting) range wins
+    }
+    if (a->end != b->end)
+    {
+        return a->end < b->end;      // Then the shorter range
+    }
+    return a->sym_idx < b->sym_idx;  // Then the lower symbol index
+}
+
+/**
+ * @brief Pushes a candidate onto the max-heap of active ranges
+ * @param[in,out] heap Heap array of candidate positions
+ * @param[in,out] heap_len Number of elements in the heap
+ * @param[in] cand Candidate array
+ * @param[in] pos Position of the candidate to push
+ */
+static void AddrIndex_heapPush(uint32_t *heap, size_t *heap_len, const addrindex_cand_t *cand, uint32_t pos)
+{
+    size_t i = (*heap_len)++;
+
+    while (i > 0)  // Sift up
+    {
+        size_t parent = (i - 1) / 2;
+        if (!AddrIndex_candWins(&cand[pos], &cand[heap[parent]]))
+        {
+            break;
+        }
+        heap[i] = heap[parent];
+        i = parent;
+    }
+    heap[i] = pos;
+}
+
+/**
+ * @brief Removes the top element of the max-heap of active ranges
+ * @param[in,out] heap Heap array of candidate positions
+ * @param[in,out] heap_len Number of elements in the heap
+ * @param[in] cand Candidate array
+ */
+static void AddrIndex_heapPop(uint32_t *heap, size_t *heap_len, const addrindex_cand_t *cand)
+{
+    uint32_t last = heap[--(*heap_len)];
+    size_t i = 0;
+
+    while (2 * i + 1 < *heap_len)  // Sift down
+    {
+        size_t child = 2 * i + 1;
+        if (child + 1 < *heap_len && AddrIndex_candWins(&cand[heap[child + 1]], &cand[heap[child]]))
+        {
+            child++;
+        }
+        if (!AddrIndex_candWins(&cand[heap[child]], &cand[last]))
+        {
+            break;
+        }
+        heap[i] = heap[child];
+        i = child;
+    }
+    heap[i] = last;
+}
+
+/**
+ * @brief Fills the Eytzinger arrays by an in-order walk of the implicit tree
+ * @param[in,out] addr_index Pointer to the index structure
+ * @param[in] seg Next sorted segment to place
+ * @param[in] k Current 1-based tree node
+ * @return uint32_t Next sorted segment after this subtree
+ */
+static uint32_t AddrIndex_eytFill(elfparser_addrindex_t *addr_index, uint32_t seg, size_t k)
+{
+    if (k <= addr_index->seg_num)
+    {
+        seg = AddrIndex_eytFill(addr_index, seg, 2 * k);
+        addr_index->eyt_start[k] = addr_index->seg_start[seg];
+        addr_index->eyt_seg[k] = seg;
+        seg = AddrIndex_eytFill(addr_index, seg + 1, 2 * k + 1);
+    }
+    return seg;
+}
+
+/**
+ * @brief Builds an address index from the FUNC and OBJECT symbols of a parsed symbol table
+ * @param[out] addr_index Pointer to the index structure to populate
+ * @param[in] symbol_table Pointer to a parsed symbol table (names need not be resolved)
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_MALLOC if memory allocation fails
+ */
+int ElfParser_AddrIndex_build(elfparser_addrindex_t *addr_index, const elfparser_symtable_t *symbol_table)
+{
+    if (!addr_index || !symbol_table || !symbol_table->table)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+
+    size_t cap = (size_t)symbol_table->table_len * 2 + 1;  // Each symbol adds at most two segments
+    addrindex_cand_t *cand = malloc(((size_t)symbol_table->table_len + 1) * sizeof(addrindex_cand_t));
+    uint32_t *heap = malloc(((size_t)symbol_table->table_len + 1) * sizeof(uint32_t));
+    addr_index->seg_start = malloc(cap * sizeof(uint64_t));
+    addr_index->seg_end = malloc(cap * sizeof(uint64_t));
+    addr_index->seg_sym = malloc(cap * sizeof(uint32_t));
+    addr_index->eyt_start = NULL;
+    addr_index->eyt_seg = NULL;
+    addr_index->seg_num = 0;
+    if (!cand || !heap || !addr_index->seg_start || !addr_index->seg_end || !addr_index->seg_sym)
+    {
+        free(cand);
+        free(heap);
+        ElfParser_AddrIndex_free(addr_index);
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+
+    size_t cand_num = 0;
+    for (uint32_t i = 0; i < symbol_table->table_len; i++)  // Collect defined FUNC/OBJECT ranges
+    {
+        const elfparser_symtable_entry_t *entry = &symbol_table->table[i];
+        if ((entry->sym_type != ELFPARSER_SYMTABLE_TYPE_FUNC && entry->sym_type != ELFPARSER_SYMTABLE_TYPE_OBJECT) ||
+            entry->sym_sect_idx == 0)
+        {
+            continue;
+        }
+        uint64_t size = entry->sym_size ? entry->sym_size : 1;  // Zero-size symbols cover their own address
+        cand[cand_num].start = entry->sym_value;
+        cand[cand_num].end = (entry->sym_value + size < entry->sym_value) ? UINT64_MAX : entry->sym_value + size;
+        cand[cand_num].sym_idx = i;
+        cand_num++;
+    }
+    qsort(cand, cand_num, sizeof(addrindex_cand_t), AddrIndex_candCmp);
+
+    size_t next = 0;      // Next candidate not yet pushed
+    size_t heap_len = 0;
+    uint64_t pos = 0;     // Current sweep position
+    while (next < cand_num || heap_len > 0)  // Sweep: the winner only changes at a start or at the winner's end
+    {
+        if (heap_len == 0)
+        {
+            pos = cand[next].start;  // Jump over a gap
+        }
+        while (next < cand_num && cand[next].start == pos)
+        {
+            AddrIndex_heapPush(heap, &heap_len, cand, (uint32_t)next++);
+        }
+        while (heap_len > 0 && cand[heap[0]].end <= pos)
+        {
+            AddrIndex_heapPop(heap, &heap_len, cand);  // Drop expired ranges lazily
+        }
+        if (heap_len == 0)
+        {
+            continue;
+        }
+        const addrindex_cand_t *top = &cand[heap[0]];
+        uint64_t seg_end = top->end;
+        if (next < cand_num && cand[next].start < seg_end)
+        {
+            seg_end = cand[next].start;  // A later start may take over
+        }
+        uint32_t seg = addr_index->seg_num;
+        if (seg > 0 && addr_index->seg_sym[seg - 1] == top->sym_idx && addr_index->seg_end[seg - 1] == pos)
+        {
+            addr_index->seg_end[seg - 1] = seg_end;  // Extend the previous segment of the same symbol
+        }
+        else
+        {
+            addr_index->seg_start[seg] = pos;
+            addr_index->seg_end[seg] = seg_end;
+            addr_index->seg_sym[seg] = top->sym_idx;
+            addr_index->seg_num++;
+        }
+        if (seg_end == UINT64_MAX)
+        {
+            break;  // Range reaches the top of the address space
+        }
+        pos = seg_end;
+    }
+    free(cand);
+    free(heap);
+
+    addr_index->eyt_start = malloc(((size_t)addr_index->seg_num + 1) * sizeof(uint64_t));
+    addr_index->eyt_seg = malloc(((size_t)addr_index->seg_num + 1) * sizeof(uint32_t));
+    if (!addr_index->eyt_start || !addr_index->eyt_seg)
+    {
+        ElfParser_AddrIndex_free(addr_index);
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+    AddrIndex_eytFill(addr_index, 0, 1);
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Finds the last segment starting at or below an address
+ * @param[in] addr_index Pointer to the index structure
+ * @param[in] addr Address to resolve
+ * @return int64_t Segment index, or -1 if every segment starts above addr
+ */
+static int64_t AddrIndex_segFind(const elfparser_addrindex_t *addr_index, uint64_t addr)
+{
+    size_t k = 1;
+
+    while (k <= addr_index->seg_num)  // Branch-free descent to the first start above addr
+    {
+        if (k * 8 <= addr_index->seg_num)
+        {
+            __builtin_prefetch(&addr_index->eyt_start[k * 8]);  // Three levels ahead, one cache line
+        }
+        k = 2 * k + (addr_index->eyt_start[k] <= addr);
+    }
+    k >>= __builtin_ffsll((long long)~k);  // Undo the trailing right turns
+    uint32_t upper = (k == 0) ? addr_index->seg_num : addr_index->eyt_seg[k];
+    return (int64_t)upper - 1;
+}
+
+/**
+ * @brief Finds the symbol covering an address
+ * @param[in] addr_index Pointer to the index structure
+ * @param[in] addr Address to resolve
+ * @return int64_t Symbol table index, ELFPARSER_ERR_NOT_FOUND if no symbol covers addr,
+ *                 ELFPARSER_ERR_NULL if addr_index is NULL or not built
+ */
+int64_t ElfParser_AddrIndex_lookup(const elfparser_addrindex_t *addr_index, uint64_t addr)
+{
+    if (!addr_index || !addr_index->eyt_start)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    int64_t seg = AddrIndex_segFind(addr_index, addr);
+    if (seg < 0 || addr >= addr_index->seg_end[seg])
+    {
+        return ELFPARSER_ERR_NOT_FOUND;  // Below every symbol or inside a gap
+    }
+    return addr_index->seg_sym[seg];
+}
+
+/**
+ * @brief Resolves a batch of addresses, in amortized linear time when they are sorted ascending
+ * @param[in] addr_index Pointer to the index structure
+ * @param[in] addrs Addresses to resolve
+ * @param[in] addr_num Number of addresses
+ * @param[out] sym_idx Per address: symbol table index, or ELFPARSER_ERR_NOT_FOUND
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL or the index is not built
+ */
+int ElfParser_AddrIndex_batchLookup(const elfparser_addrindex_t *addr_index, const uint64_t *addrs, size_t addr_num, int64_t *sym_idx)
+{
+    if (!addr_index || !addr_index->eyt_start || (addr_num && (!addrs || !sym_idx)))
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+
+    int64_t seg = -1;  // Last segment starting at or below the previous address
+    for (size_t i = 0; i < addr_num; i++)
+    {
+        uint64_t addr = addrs[i];
+        if (i > 0 && addr < addrs[i - 1])
+        {
+            seg = AddrIndex_segFind(addr_index, addr);  // Out of order, search again
+        }
+        else
+        {
+            while ((uint64_t)(seg + 1) < addr_index->seg_num && addr_index->seg_start[seg + 1] <= addr)
+            {
+                seg++;  // Merge walk
+            }
+        }
+        sym_idx[i] = (seg < 0 || addr >= addr_index->seg_end[seg]) ? ELFPARSER_ERR_NOT_FOUND : (int64_t)addr_index->seg_sym[seg];
+    }
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Frees the resources held by an address index
+ * @param[in,out] addr_index Pointer to the index structure to free
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if addr_index is NULL
+ */
+int ElfParser_AddrIndex_free(elfparser_addrindex_t *addr_index)
+{
+    if (!addr_index)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    free(addr_index->seg_start);  // Safe to free NULL
+    free(addr_index->seg_end);
+    free(addr_index->seg_sym);
+    free(addr_index->eyt_start);
+    free(addr_index->eyt_seg);
+    addr_index->seg_start = NULL;
+    addr_index->seg_end = NULL;
+    addr_index->seg_sym = NULL;
+    addr_index->eyt_start = NULL;
+    addr_index->eyt_seg = NULL;
+    addr_index->seg_num = 0;
+    return ELFPARSER_SUCCESS;  // Success
+}
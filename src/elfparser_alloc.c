@@ -0,0 +1,306 @@
+/**
+ * @file elfparser_alloc.c
+ * @brief Bump arena and thread-caching pool allocators for libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This file implements the two allocators of elfparser_alloc.h. The arena
+ * bumps a pointer through large blocks and only rewinds on reset, reusing
+ * the blocks it already holds before asking malloc for more. The pool keeps
+ * a free list per power-of-two size class in thread-local storage; a header
+ * in front of every block records its class, so a block can be freed by any
+ * thread, and a pthread key destructor hands a thread's cached blocks back
+ * to the system when it exits.
+ */
+
+#include "../inc_pub/elfparser_alloc.h"
+#include "../inc_priv/elfparser_alloc_priv.h"
+#include <pthread.h>
+#include <string.h>
+
+/**
+ * @brief Free lists of one thread
+ */
+typedef struct alloc_pool_cache_s
+{
+    void*   lists[ALLOC_POOL_CLASS_NUM];    /**< Free blocks of each class, linked through their first word */
+    size_t  cached[ALLOC_POOL_CLASS_NUM];   /**< Bytes held in each list */
+    int     registered;                     /**< Non-zero once the exit destructor knows this cache */
+    int     exiting;                        /**< Non-zero once the exit destructor has run, nothing is cached after */
+} alloc_pool_cache_t;
+
+static _Thread_local alloc_pool_cache_t alloc_pool_cache;   /**< Cache of the calling thread */
+static pthread_key_t alloc_pool_key;                        /**< Runs Alloc_poolExit() on thread exit */
+static pthread_once_t alloc_pool_once = PTHREAD_ONCE_INIT;  /**< Creates alloc_pool_key once */
+static int alloc_pool_key_valid;                            /**< Non-zero if alloc_pool_key was created */
+
+/**
+ * @brief Allocates from the current block of the arena, moving to the next block or a new one when it is full
+ * @param[in,out] ctx Pointer to the elfparser_arena_t
+ * @param[in] size Size in bytes
+ * @return void* Block aligned to ALLOC_ALIGN, or NULL on failure
+ */
+static void *Alloc_arenaAlloc(void *ctx, size_t size)
+{
+    elfparser_arena_t *arena = ctx;
+    size_t need = (size + ALLOC_ALIGN - 1u) & ~(size_t)(ALLOC_ALIGN - 1u);
+
+    if (need < size)
+    {
+        return NULL;  // Size overflows when rounded
+    }
+    need = need ? need : ALLOC_ALIGN;
+    while (need > arena->cur_left && arena->block_idx + 1u < arena->block_num)  // Blocks kept from before a reset
+    {
+        elfparser_arena_block_t *block = &arena->blocks[++arena->block_idx];
+        arena->cur = block->data;
+        arena->cur_left = block->size;
+    }
+    if (need > arena->cur_left)
+    {
+        if (arena->block_num == arena->block_cap)
+        {
+            uint32_t cap = arena->block_cap ? arena->block_cap * 2u : ALLOC_ARENA_BLOCKS_INITIAL;
+            elfparser_arena_block_t *blocks = realloc(arena->blocks, (size_t)cap * sizeof(elfparser_arena_block_t));
+            if (!blocks)
+            {
+                return NULL;  // Allocation failure
+            }
+            arena->blocks = blocks;
+            arena->block_cap = cap;
+        }
+        size_t block_size = (need > arena->block_size) ? need : arena->block_size;
+        char *data = malloc(block_size);
+        if (!data)
+        {
+            return NULL;  // Allocation failure
+        }
+        arena->blocks[arena->block_num] = (elfparser_arena_block_t){ data, block_size };
+        arena->block_idx = arena->block_num++;
+        arena->cur = data;
+        arena->cur_left = block_size;
+        arena->reserved += block_size;
+    }
+
+    void *ptr = arena->cur;
+    arena->cur += need;
+    arena->cur_left -= need;
+    arena->used += need;
+    return ptr;
+}
+
+/**
+ * @brief Initializes an empty bump arena
+ * @param[out] arena Pointer to the arena to initialize, released with ElfParser_Alloc_arenaFree()
+ * @param[in] block_size Size of each block in bytes, 0 for the default
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if arena is NULL
+ */
+int ElfParser_Alloc_arenaInit(elfparser_arena_t *arena, size_t block_size)
+{
+    if (!arena)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    memset(arena, 0, sizeof(*arena));
+    arena->alloc.alloc_fn = Alloc_arenaAlloc;
+    arena->alloc.free_fn = NULL;  // Memory is only released by reset
+    arena->alloc.ctx = arena;
+    arena->alloc.flags = 0;       // Not thread-safe
+    arena->block_size = block_size ? block_size : ALLOC_ARENA_BLOCK_DEFAULT;
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Releases everything allocated from the arena at once, keeping its blocks for reuse
+ * @param[in,out] arena Pointer to an initialized arena
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if arena is NULL
+ */
+int ElfParser_Alloc_arenaReset(elfparser_arena_t *arena)
+{
+    if (!arena)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    arena->block_idx = 0;
+    arena->cur = arena->block_num ? arena->blocks[0].data : NULL;
+    arena->cur_left = arena->block_num ? arena->blocks[0].size : 0;
+    arena->used = 0;
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Returns the blocks of the arena to the system
+ * @param[in,out] arena Pointer to the arena to free
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if arena is NULL
+ */
+int ElfParser_Alloc_arenaFree(elfparser_arena_t *arena)
+{
+    if (!arena)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    for (uint32_t i = 0; i < arena->block_num; i++)
+    {
+        free(arena->blocks[i].data);
+    }
+    free(arena->blocks);
+    arena->blocks = NULL;
+    arena->block_num = 0;
+    arena->block_cap = 0;
+    arena->block_idx = 0;
+    arena->cur = NULL;
+    arena->cur_left = 0;
+    arena->used = 0;
+    arena->reserved = 0;
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Frees every block cached in a thread's free lists
+ * @param[in,out] cache Pointer to the cache to drain
+ */
+static void Alloc_poolDrain(alloc_pool_cache_t *cache)
+{
+    for (uint32_t c = 0; c < ALLOC_POOL_CLASS_NUM; c++)
+    {
+        void *block = cache->lists[c];
+        while (block)
+        {
+            void *next = *(void **)block;
+            free((char *)block - ALLOC_POOL_HEADER_SIZE);
+            block = next;
+        }
+        cache->lists[c] = NULL;
+        cache->cached[c] = 0;
+    }
+}
+
+/**
+ * @brief Thread exit destructor, returns the exiting thread's cached blocks
+ *
+ * Destructors of other keys may still free pool blocks on this thread after
+ * this one has run; the exiting flag sends those straight back to the system.
+ *
+ * @param[in,out] arg Pointer to the exiting thread's cache
+ */
+static void Alloc_poolExit(void *arg)
+{
+    alloc_pool_cache_t *cache = arg;
+
+    Alloc_poolDrain(cache);
+    cache->registered = 0;
+    cache->exiting = 1;
+}
+
+/**
+ * @brief Creates the thread exit key, run once
+ */
+static void Alloc_poolKeyCreate(void)
+{
+    alloc_pool_key_valid = (pthread_key_create(&alloc_pool_key, Alloc_poolExit) == 0);
+}
+
+/**
+ * @brief Returns the size class of a request
+ * @param[in] size Size in bytes
+ * @return uint32_t Class index, ALLOC_POOL_CLASS_LARGE if above the largest class
+ */
+static inline uint32_t Alloc_poolClass(size_t size)
+{
+    if (size <= (1u << ALLOC_POOL_CLASS_MIN_SHIFT))
+    {
+        return 0;  // Smallest class
+    }
+    uint32_t shift = 64u - (uint32_t)__builtin_clzll((unsigned long long)(size - 1u));  // Rounded up to a power of two
+    return (shift - ALLOC_POOL_CLASS_MIN_SHIFT < ALLOC_POOL_CLASS_NUM) ? shift - ALLOC_POOL_CLASS_MIN_SHIFT : ALLOC_POOL_CLASS_LARGE;
+}
+
+/**
+ * @brief Allocates from the calling thread's free list of the size class, or from malloc
+ * @param[in] ctx Unused
+ * @param[in] size Size in bytes
+ * @return void* Block aligned to ALLOC_ALIGN, or NULL on failure
+ */
+static void *Alloc_poolAlloc(void *ctx, size_t size)
+{
+    (void)ctx;
+    uint32_t cls = Alloc_poolClass(size);
+    size_t block_size = (cls == ALLOC_POOL_CLASS_LARGE) ? size : (size_t)1u << (cls + ALLOC_POOL_CLASS_MIN_SHIFT);
+
+    if (cls != ALLOC_POOL_CLASS_LARGE && alloc_pool_cache.lists[cls])
+    {
+        void *block = alloc_pool_cache.lists[cls];
+        alloc_pool_cache.lists[cls] = *(void **)block;
+        alloc_pool_cache.cached[cls] -= block_size;
+        return block;  // Recycled
+    }
+    if (block_size > SIZE_MAX - ALLOC_POOL_HEADER_SIZE)
+    {
+        return NULL;  // Size overflows with the header
+    }
+    uint8_t *header = malloc(ALLOC_POOL_HEADER_SIZE + block_size);
+    if (!header)
+    {
+        return NULL;  // Allocation failure
+    }
+    header[0] = (uint8_t)cls;
+    return header + ALLOC_POOL_HEADER_SIZE;
+}
+
+/**
+ * @brief Puts a block on the calling thread's free list of its class, or frees it if that list is full, it is large or the thread is exiting
+ * @param[in] ctx Unused
+ * @param[in] ptr Block returned by Alloc_poolAlloc() on any thread
+ */
+static void Alloc_poolFree(void *ctx, void *ptr)
+{
+    (void)ctx;
+    uint8_t *header = (uint8_t *)ptr - ALLOC_POOL_HEADER_SIZE;
+    uint32_t cls = header[0];
+
+    if (cls == ALLOC_POOL_CLASS_LARGE)
+    {
+        free(header);
+        return;  // Not cached
+    }
+    size_t block_size = (size_t)1u << (cls + ALLOC_POOL_CLASS_MIN_SHIFT);
+    if (alloc_pool_cache.exiting || alloc_pool_cache.cached[cls] + block_size > ALLOC_POOL_CACHE_MAX)
+    {
+        free(header);
+        return;  // Thread is exiting, or enough of this class cached already
+    }
+    if (!alloc_pool_cache.registered)
+    {
+        pthread_once(&alloc_pool_once, Alloc_poolKeyCreate);
+        if (!alloc_pool_key_valid || pthread_setspecific(alloc_pool_key, &alloc_pool_cache) != 0)
+        {
+            free(header);
+            return;  // Cached blocks could not be released at exit, so cache nothing
+        }
+        alloc_pool_cache.registered = 1;
+    }
+    *(void **)ptr = alloc_pool_cache.lists[cls];
+    alloc_pool_cache.lists[cls] = ptr;
+    alloc_pool_cache.cached[cls] += block_size;
+}
+
+/**
+ * @brief Returns the process-wide pool allocator with per-thread caches
+ * @return const elfparser_alloc_t* Pointer to the pool allocator
+ */
+const elfparser_alloc_t *ElfParser_Alloc_pool(void)
+{
+    static const elfparser_alloc_t pool = { Alloc_poolAlloc, Alloc_poolFree, NULL, ELFPARSER_ALLOC_FLAG_THREAD_SAFE };
+    return &pool;
+}
+
+/**
+ * @brief Returns the blocks cached by the calling thread's pool to the system
+ * @return int ELFPARSER_SUCCESS
+ */
+int ElfParser_Alloc_poolTrim(void)
+{
+    Alloc_poolDrain(&alloc_pool_cache);
+    return ELFPARSER_SUCCESS;  // Success
+}
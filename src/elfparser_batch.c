@@ -0,0 +1,347 @@
+/**
+ * @file elfparser_batch.c
+ * @brief Work-stealing batch parsing of many ELF files for libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This file implements ElfParser_Batch_run(). The path list is split into one
+ * contiguous index range per worker. A worker pops indices from the front of
+ * its own range; once it is empty, the worker locks the other ranges, picks
+ * the one with the most files left and moves the back half of it into its
+ * own range. A stolen half is in neither range between leaving the victim
+ * and reaching the thief, so a worker that finds every range empty only quits
+ * if no steal was in flight before or started during its scan; otherwise it
+ * scans again. Each range has its own lock, so workers only contend when
+ * stealing, which happens rarely compared to the cost of parsing a file.
+ */
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L  // clock_gettime
+#endif
+
+#include "../inc_pub/elfparser_batch.h"
+#include "../inc_priv/elfparser_thread_priv.h"
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief Remaining share of the path list owned by one worker
+ */
+typedef struct batch_queue_s
+{
+    pthread_mutex_t lock;   /**< Guards begin and end */
+    size_t          begin;  /**< Next index the owner pops */
+    size_t          end;    /**< One past the last index, thieves take from here */
+} __attribute__((aligned(64))) batch_queue_t;
+
+/**
+ * @brief State shared by all workers of one ElfParser_Batch_run() call
+ */
+typedef struct batch_job_s
+{
+    const char *const*      paths;       /**< Path list */
+    uint32_t                file_flags;  /**< Flags every file is opened with */
+    elfparser_batch_fn_t    fn;          /**< Per-file callback, may be NULL */
+    void*                   ctx;         /**< Caller context of fn */
+    batch_queue_t*          queues;      /**< One queue per worker */
+    uint32_t                queue_num;   /**< Number of workers */
+    uint64_t                file_num;    /**< Files processed (atomic) */
+    uint64_t                file_failed; /**< Files with an error status (atomic) */
+    uint64_t                byte_num;    /**< Bytes of all opened files (atomic) */
+    uint64_t                sym_num;     /**< Symbols loaded (atomic) */
+    uint64_t                steal_num;   /**< Successful steals (atomic) */
+    uint64_t                steal_begun; /**< Shares taken from a victim (atomic) */
+    uint64_t                steal_done;  /**< Shares handed to their thief (atomic) */
+} batch_job_t;
+
+/**
+ * @brief Start argument of a worker thread
+ */
+typedef struct batch_worker_s
+{
+    batch_job_t*    job;        /**< Shared state */
+    uint32_t        idx;        /**< Index of the worker and of its queue */
+} batch_worker_t;
+
+/**
+ * @brief Returns the monotonic time in nanoseconds
+ * @return uint64_t Current time
+ */
+static uint64_t Batch_nowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Takes the next index from the front of a queue
+ * @param[in,out] queue Queue of the calling worker
+ * @param[out] path_idx Set to the index taken
+ * @return int 1 if an index was taken, 0 if the queue is empty
+ */
+static int Batch_queuePop(batch_queue_t *queue, size_t *path_idx)
+{
+    int taken = 0;
+    pthread_mutex_lock(&queue->lock);
+    if (queue->begin < queue->end)
+    {
+        *path_idx = queue->begin++;
+        taken = 1;
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return taken;
+}
+
+/**
+ * @brief Moves the back half of the fullest other queue into the thief's queue
+ * @param[in,out] job Shared state
+ * @param[in] thief_idx Index of the stealing worker, whose queue is empty
+ * @return int 1 if work was stolen, 0 if every queue is empty
+ */
+static int Batch_steal(batch_job_t *job, uint32_t thief_idx)
+{
+    for (;;)
+    {
+        uint64_t done = __atomic_load_n(&job->steal_done, __ATOMIC_SEQ_CST);
+        uint64_t begun = __atomic_load_n(&job->steal_begun, __ATOMIC_SEQ_CST);
+        uint32_t victim_idx = thief_idx;
+        size_t victim_left = 0;
+        for (uint32_t i = 0; i < job->queue_num; i++)  // Fullest queue right now
+        {
+            if (i == thief_idx)
+            {
+                continue;
+            }
+            pthread_mutex_lock(&job->queues[i].lock);
+            size_t left = job->queues[i].end - job->queues[i].begin;
+            pthread_mutex_unlock(&job->queues[i].lock);
+            if (left > victim_left)
+            {
+                victim_idx = i;
+                victim_left = left;
+            }
+        }
+        if (victim_left == 0)
+        {
+            if (begun == done && __atomic_load_n(&job->steal_begun, __ATOMIC_SEQ_CST) == begun)
+            {
+                return 0;  // No share was in flight, so the scan saw every file left
+            }
+            continue;  // A share may have reached a range already scanned, look again
+        }
+
+        batch_queue_t *victim = &job->queues[victim_idx];
+        pthread_mutex_lock(&victim->lock);
+        size_t left = victim->end - victim->begin;  // May have shrunk since the scan
+        size_t take = (left + 1) / 2;
+        size_t take_end = victim->end;
+        victim->end -= take;
+        if (take != 0)
+        {
+            __atomic_fetch_add(&job->steal_begun, 1, __ATOMIC_SEQ_CST);  // Before anyone sees the shrink
+        }
+        pthread_mutex_unlock(&victim->lock);
+        if (take == 0)
+        {
+            continue;  // Drained meanwhile, look again
+        }
+
+        batch_queue_t *own = &job->queues[thief_idx];
+        pthread_mutex_lock(&own->lock);
+        own->begin = take_end - take;
+        own->end = take_end;
+        pthread_mutex_unlock(&own->lock);
+        __atomic_fetch_add(&job->steal_done, 1, __ATOMIC_SEQ_CST);
+        __atomic_fetch_add(&job->steal_num, 1, __ATOMIC_RELAXED);
+        return 1;  // Stolen
+    }
+}
+
+/**
+ * @brief Opens and parses one file, hands it to the callback and releases it
+ * @param[in,out] job Shared state
+ * @param[in] path_idx Index of the file in the path list
+ * @param[in] thread_idx Index of the calling worker
+ */
+static void Batch_fileProcess(batch_job_t *job, size_t path_idx, uint32_t thread_idx)
+{
+    elfparser_file_t file;
+    elfparser_batch_result_t result;
+    memset(&result, 0, sizeof(result));
+    result.path = job->paths[path_idx];
+    result.path_idx = path_idx;
+    result.thread_idx = thread_idx;
+    result.stage = ELFPARSER_BATCH_STAGE_OPEN;
+
+    result.status = result.path ? ElfParser_File_open(&file, result.path, job->file_flags) : ELFPARSER_ERR_NULL;
+    if (result.status == ELFPARSER_SUCCESS)
+    {
+        result.file = &file;
+        result.file_size = file.reader.file_size;
+        const elfparser_header_t *header;
+        const elfparser_secthead_t *sect_head;
+        result.stage = ELFPARSER_BATCH_STAGE_HEADER;
+        result.status = ElfParser_File_headerGet(&file, &header);
+        if (result.status == ELFPARSER_SUCCESS)
+        {
+            result.stage = ELFPARSER_BATCH_STAGE_SECTHEAD;
+            result.status = ElfParser_File_sectHeadGet(&file, &sect_head);
+        }
+        if (result.status == ELFPARSER_SUCCESS)
+        {
+            result.stage = ELFPARSER_BATCH_STAGE_SYMTABLE;
+            uint32_t table_num = 0;
+            for (uint32_t i = 0; i < sect_head->table_len; i++)  // Count symbol tables
+            {
+                uint32_t type = sect_head->table[i].sh_type;
+                table_num += (type == ELFPARSER_SECTHEAD_TYPE_SYMTAB || type == ELFPARSER_SECTHEAD_TYPE_DYNSYM);
+            }
+            result.sym_tables = malloc((table_num ? table_num : 1) * sizeof(elfparser_symtable_t));
+            result.status = result.sym_tables ? ELFPARSER_SUCCESS : ELFPARSER_ERR_MALLOC;
+            for (uint32_t i = 0; i < sect_head->table_len && result.status == ELFPARSER_SUCCESS; i++)
+            {
+                uint32_t type = sect_head->table[i].sh_type;
+                if (type != ELFPARSER_SECTHEAD_TYPE_SYMTAB && type != ELFPARSER_SECTHEAD_TYPE_DYNSYM)
+                {
+                    continue;
+                }
+                result.status = ElfParser_File_symTableLoad(&file, &result.sym_tables[result.sym_table_num], i);
+                if (result.status == ELFPARSER_SUCCESS)
+                {
+                    result.sym_num += result.sym_tables[result.sym_table_num].table_len;
+                    result.sym_table_num++;
+                }
+            }
+        }
+    }
+    if (result.status == ELFPARSER_SUCCESS)
+    {
+        result.stage = ELFPARSER_BATCH_STAGE_DONE;
+    }
+
+    if (job->fn)
+    {
+        job->fn(job->ctx, &result);
+    }
+    for (uint32_t i = 0; i < result.sym_table_num; i++)
+    {
+        ElfParser_SymTable_free(&result.sym_tables[i]);
+    }
+    free(result.sym_tables);
+    if (result.file)
+    {
+        ElfParser_File_close(&file);
+    }
+
+    __atomic_fetch_add(&job->file_num, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&job->file_failed, (result.status != ELFPARSER_SUCCESS), __ATOMIC_RELAXED);
+    __atomic_fetch_add(&job->byte_num, result.file_size, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&job->sym_num, result.sym_num, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Processes files from the own queue, then from stolen shares, until none are left
+ * @param[in,out] arg Pointer to the batch_worker_t of this worker
+ * @return void* Always NULL
+ */
+static void* Batch_worker(void *arg)
+{
+    batch_worker_t *worker = arg;
+    batch_job_t *job = worker->job;
+    size_t path_idx;
+
+    for (;;)
+    {
+        if (Batch_queuePop(&job->queues[worker->idx], &path_idx))
+        {
+            Batch_fileProcess(job, path_idx, worker->idx);
+        }
+        else if (!Batch_steal(job, worker->idx))
+        {
+            break;  // All work handed out
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Parses a list of ELF files on a work-stealing thread pool
+ * @param[in] paths Paths of the files
+ * @param[in] path_num Number of paths
+ * @param[in] thread_num Number of workers, 0 for one per online CPU
+ * @param[in] file_flags ELFPARSER_FILE_FLAG_* values every file is opened with
+ * @param[in] fn Callback receiving each file, may be NULL if only stats are wanted
+ * @param[in,out] ctx Caller context passed to fn
+ * @param[out] stats Optional destination of the run totals
+ * @return int ELFPARSER_SUCCESS if the run completed, ELFPARSER_ERR_NULL if paths is NULL,
+ *             ELFPARSER_ERR_MALLOC if the queues cannot be allocated
+ */
+int ElfParser_Batch_run(const char *const *paths, size_t path_num, uint32_t thread_num, uint32_t file_flags,
+                        elfparser_batch_fn_t fn, void *ctx, elfparser_batch_stats_t *stats)
+{
+    if (!paths && path_num)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+
+    uint64_t t0 = Batch_nowNs();
+    batch_job_t job = { 0 };
+    job.paths = paths;
+    job.file_flags = file_flags;
+    job.fn = fn;
+    job.ctx = ctx;
+    job.queue_num = ElfParser_threadNumResolve(thread_num, path_num);
+    job.queues = aligned_alloc(sizeof(batch_queue_t), job.queue_num * sizeof(batch_queue_t));
+    batch_worker_t *workers = malloc(job.queue_num * sizeof(batch_worker_t));
+    if (!job.queues || !workers)
+    {
+        free(job.queues);
+        free(workers);
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+    for (uint32_t i = 0; i < job.queue_num; i++)  // Equal contiguous shares
+    {
+        pthread_mutex_init(&job.queues[i].lock, NULL);
+        job.queues[i].begin = path_num * i / job.queue_num;
+        job.queues[i].end = path_num * (i + 1) / job.queue_num;
+        workers[i].job = &job;
+        workers[i].idx = i;
+    }
+
+    pthread_t threads[ELFPARSER_THREAD_NUM_MAX];
+    uint32_t started = 0;
+    while (started + 1u < job.queue_num && pthread_create(&threads[started], NULL, Batch_worker, &workers[started + 1u]) == 0)
+    {
+        started++;  // Caller is worker 0; shares of threads that failed to start get stolen
+    }
+    Batch_worker(&workers[0]);
+    for (uint32_t i = 0; i < started; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+    for (uint32_t i = 0; i < job.queue_num; i++)
+    {
+        pthread_mutex_destroy(&job.queues[i].lock);
+    }
+
+    if (stats)
+    {
+        uint64_t wall_ns = Batch_nowNs() - t0;
+        double wall_s = (wall_ns ? (double)wall_ns : 1.0) / 1e9;
+        stats->file_num = job.file_num;
+        stats->file_failed = job.file_failed;
+        stats->byte_num = job.byte_num;
+        stats->sym_num = job.sym_num;
+        stats->steal_num = job.steal_num;
+        stats->thread_num = started + 1u;
+        stats->wall_ns = wall_ns;
+        stats->files_per_sec = (double)job.file_num / wall_s;
+        stats->mb_per_sec = (double)job.byte_num / 1e6 / wall_s;
+    }
+    free(job.queues);
+    free(workers);
+    return ELFPARSER_SUCCESS;  // Success
+}
@@ -0,0 +1,3915 @@
+/**
+ * @file elfparser_demangle.c
+ * @brief Itanium C++ demangler functions for libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This file implements a recursive descent parser for the Itanium C++ ABI
+ * mangling grammar and a printer that renders the parse tree the way GNU
+ * c++filt does (postfix cv qualifiers, "> >", {lambda(int)#1}, [clone .cold]).
+ * Nodes, node lists, substitutions and template arguments live in growable
+ * arrays of a scratch structure and refer to each other by index, so one
+ * scratch is reused for every name a thread demangles and a name costs no
+ * allocation once the arrays have grown. Template parameters are bound to
+ * their arguments while parsing; the few that are used before their
+ * arguments appear (conversion operators, generic lambdas) are recorded and
+ * bound at the end of their encoding.
+ *
+ * The memoizing demangler keeps an open-addressing table of every mangled
+ * name seen and stores copies and results in arena blocks. Bulk demangling
+ * of a symbol table looks every name up first, then demangles the distinct
+ * new ones in chunks on several threads, each chunk writing into a block of
+ * its own that joins the arena afterwards.
+ */
+
+#include "../inc_pub/elfparser_demangle.h"
+#include "../inc_priv/elfparser_demangle_priv.h"
+#include "../inc_priv/elfparser_memmanip_priv.h"
+#include "../inc_priv/elfparser_thread_priv.h"
+#include <string.h>
+
+/**
+ * @brief Enumeration of parse tree node kinds
+ */
+typedef enum
+{
+    DEMANGLE_NODE_NONE = 0,     /**< Placeholder of node index 0, which means no node */
+    DEMANGLE_NODE_NAME,         /**< Text str */
+    DEMANGLE_NODE_BUILTIN,      /**< Builtin type str, mangling letter in flags */
+    DEMANGLE_NODE_SPECIAL_SUB,  /**< Standard substitution str, class name at c characters into it */
+    DEMANGLE_NODE_NESTED,       /**< a::b */
+    DEMANGLE_NODE_TEMPLATE,     /**< a<list b> */
+    DEMANGLE_NODE_LIST,         /**< b nodes starting at lists[a] */
+    DEMANGLE_NODE_QUAL,         /**< a followed by the cv qualifiers in flags */
+    DEMANGLE_NODE_SUFFIX,       /**< a followed by str (_Complex, _Imaginary, vendor qualifiers) */
+    DEMANGLE_NODE_POINTER,      /**< a* */
+    DEMANGLE_NODE_LREF,         /**< a& */
+    DEMANGLE_NODE_RREF,         /**< a&& */
+    DEMANGLE_NODE_PTRMEM,       /**< Member b of class a */
+    DEMANGLE_NODE_ARRAY,        /**< a [b] */
+    DEMANGLE_NODE_VECTOR,       /**< a __vector(b) */
+    DEMANGLE_NODE_FUNC_TYPE,    /**< Returning a, parameters list b, exception spec c, cv and ref in flags */
+    DEMANGLE_NODE_ENCODING,     /**< Function a, parameters list b, return type c, cv and ref in flags */
+    DEMANGLE_NODE_SPECIAL,      /**< str followed by a (vtable for, thunks, guard variables) */
+    DEMANGLE_NODE_CTOR_VTABLE,  /**< construction vtable for a-in-b */
+    DEMANGLE_NODE_REFTEMP,      /**< reference temporary #str for a */
+    DEMANGLE_NODE_CTOR,         /**< Constructor of the class named by a */
+    DEMANGLE_NODE_DTOR,         /**< Destructor of the class named by a */
+    DEMANGLE_NODE_ABI_TAG,      /**< a[abi:str] */
+    DEMANGLE_NODE_LOCAL,        /**< Entity b local to encoding a */
+    DEMANGLE_NODE_LAMBDA,       /**< {lambda(list a)#b} */
+    DEMANGLE_NODE_UNNAMED,      /**< {unnamed type#b} */
+    DEMANGLE_NODE_DEFAULT_ARG,  /**< {default arg#b}::a */
+    DEMANGLE_NODE_ARG_PACK,     /**< Template argument pack, list a printed in full */
+    DEMANGLE_NODE_PARAM_PACK,   /**< The same pack seen through a parameter, one element per expansion step */
+    DEMANGLE_NODE_EXPANSION,    /**< Pack expansion, a printed once per element */
+    DEMANGLE_NODE_TPARAM,       /**< Template parameter b bound to argument a, of the encoding whose arguments start at c */
+    DEMANGLE_NODE_FLOATN,       /**< _Float<b>, x suffix in flags */
+    DEMANGLE_NODE_OPERATOR,     /**< operator str */
+    DEMANGLE_NODE_CONV,         /**< Conversion operator to type a */
+    DEMANGLE_NODE_LITERAL_OP,   /**< operator"" a */
+    DEMANGLE_NODE_BINDING,      /**< Structured binding [list a] */
+    DEMANGLE_NODE_CLONE,        /**< a [clone str] */
+    DEMANGLE_NODE_LITERAL,      /**< Literal str of type a */
+    DEMANGLE_NODE_PARM,         /**< Function parameter b, counted from 1 */
+    DEMANGLE_NODE_PREFIX,       /**< Prefix operator str applied to a */
+    DEMANGLE_NODE_POSTFIX,      /**< Postfix operator str applied to a */
+    DEMANGLE_NODE_BINARY,       /**< a str b */
+    DEMANGLE_NODE_TERNARY,      /**< a ? b : c */
+    DEMANGLE_NODE_INDEX,        /**< a[b] */
+    DEMANGLE_NODE_CALL,         /**< a(list b) */
+    DEMANGLE_NODE_CAST,         /**< (a)b */
+    DEMANGLE_NODE_NAMED_CAST,   /**< str<a>(b) */
+    DEMANGLE_NODE_ENCLOSE,      /**< str(a) (decltype, sizeof, alignof, typeid, exception specs) */
+    DEMANGLE_NODE_INIT_LIST,    /**< a{list b} */
+    DEMANGLE_NODE_FOLD,         /**< Fold of a and b over operator str, fold kind letter in flags */
+    DEMANGLE_NODE_SIZEOF_PACK   /**< sizeof...(a), printed as the size of the pack */
+} demangle_node_kind_e;
+
+/**
+ * @brief Enumeration of how an operator code is parsed inside expressions
+ */
+typedef enum
+{
+    DEMANGLE_OP_PREFIX = 0,     /**< One operand */
+    DEMANGLE_OP_INCDEC,         /**< One operand, prefix when followed by _ */
+    DEMANGLE_OP_BINARY,         /**< Two operands */
+    DEMANGLE_OP_MEMBER,         /**< Object and member name */
+    DEMANGLE_OP_INDEX,          /**< Array and index */
+    DEMANGLE_OP_TERNARY,        /**< Three operands */
+    DEMANGLE_OP_NAMED_CAST,     /**< Type and operand */
+    DEMANGLE_OP_OF_TYPE,        /**< One type operand */
+    DEMANGLE_OP_DELETE,         /**< Operand of delete */
+    DEMANGLE_OP_NAME_ONLY       /**< Valid only as a function name (new, call) */
+} demangle_op_kind_e;
+
+/**
+ * @brief Structure representing one operator code
+ */
+typedef struct demangle_op_s
+{
+    char                code[2];  /**< Two-letter mangling */
+    demangle_op_kind_e  kind;     /**< Parsing inside expressions */
+    const char*         name;     /**< Printed text */
+} demangle_op_t;
+
+/**
+ * @brief Structure representing one parse tree node
+ */
+typedef struct demangle_node_s
+{
+    uint8_t     kind;   /**< demangle_node_kind_e */
+    uint8_t     flags;  /**< Kind-specific flags */
+    uint32_t    a;      /**< First child node or list */
+    uint32_t    b;      /**< Second child node, list or number */
+    uint32_t    c;      /**< Third child node or number */
+    uint32_t    len;    /**< Length of str */
+    const char* str;    /**< Text, in the mangled name or a literal */
+} demangle_node_t;
+
+/**
+ * @brief Structure representing the reusable work buffers of one thread
+ */
+typedef struct demangle_scratch_s
+{
+    demangle_node_t*    nodes;      /**< Nodes, index 0 unused */
+    uint32_t            node_num;   /**< Number of nodes */
+    uint32_t            node_cap;   /**< Capacity of nodes */
+    uint32_t*           lists;      /**< Children of list nodes */
+    uint32_t            list_num;   /**< Number of list items */
+    uint32_t            list_cap;   /**< Capacity of lists */
+    uint32_t*           stack;      /**< Children of lists being parsed */
+    uint32_t            stack_num;  /**< Number of stacked children */
+    uint32_t            stack_cap;  /**< Capacity of stack */
+    uint32_t*           subs;       /**< Substitution candidates */
+    uint32_t            sub_num;    /**< Number of candidates */
+    uint32_t            sub_cap;    /**< Capacity of subs */
+    uint32_t*           tparams;    /**< Template arguments of the enclosing encodings */
+    uint32_t            tparam_num; /**< Number of arguments */
+    uint32_t            tparam_cap; /**< Capacity of tparams */
+    uint32_t*           refs;       /**< Template parameters bound at the end of their encoding */
+    uint32_t            ref_num;    /**< Number of references */
+    uint32_t            ref_cap;    /**< Capacity of refs */
+    char*               out;        /**< Printed name */
+    size_t              out_len;    /**< Length of out */
+    size_t              out_cap;    /**< Capacity of out */
+} demangle_scratch_t;
+
+/**
+ * @brief Structure representing the state of one demangling
+ */
+typedef struct demangle_state_s
+{
+    demangle_scratch_t* s;              /**< Work buffers */
+    const char*         pos;            /**< Next character of the mangled name */
+    const char*         end;            /**< End of the mangled name */
+    int                 err;            /**< First error, ELFPARSER_SUCCESS while none */
+    uint32_t            depth;          /**< Current recursion depth */
+    uint32_t            steps;          /**< Nodes visited by the printer */
+    uint32_t            tparam_base;    /**< First template argument of the current encoding */
+    uint32_t            ref_base;       /**< First late-bound reference of the current encoding */
+    uint8_t             permit_fwd;     /**< Template parameters may precede their arguments */
+    uint8_t             try_targs;      /**< Template arguments after a template parameter belong to it */
+    uint32_t            lambda_depth;   /**< Lambda signatures being parsed */
+    uint32_t            lambda_print;   /**< Lambda signatures being printed */
+    uint32_t            pack_idx;       /**< Element of the pack being expanded */
+    uint32_t            pack_max;       /**< Size of the pack being expanded */
+    size_t              blank_at;       /**< Output length after dropping an empty list element, whose separator counts as last character */
+    uint8_t             pending_cv;     /**< Qualifiers of enclosing qualified types still to be printed */
+} demangle_state_t;
+
+/**
+ * @brief Structure representing what a name tells about its encoding
+ */
+typedef struct demangle_name_info_s
+{
+    uint8_t cv;         /**< cv qualifiers of a member function */
+    uint8_t ref;        /**< Ref qualifier of a member function */
+    uint8_t ends_targs; /**< Ends with template arguments, so a function carries its return type */
+    uint8_t ctor_conv;  /**< Constructor, destructor or conversion operator, which never carry one */
+} demangle_name_info_t;
+
+/**
+ * @brief Structure representing the bulk demangling of one symbol table
+ */
+typedef struct demangle_job_s
+{
+    const elfparser_demangle_entry_t*   entries;    /**< Memo entries, mangled pointing at the symbol names */
+    const uint32_t*                     pending;    /**< Entry index of every new name */
+    size_t*                             offsets;    /**< Offset of the mangled copy in its chunk block, per new name */
+    size_t*                             results;    /**< Offset of the demangled name, SIZE_MAX on failure, per new name */
+    char**                              blocks;     /**< Block of every chunk */
+    size_t*                             sizes;      /**< Bytes used in the block of every chunk */
+} demangle_job_t;
+
+/* Builtin types by mangling letter, NULL where the letter is something else */
+static const char *const Demangle_builtins[26] =
+{
+    "signed char", "bool", "char", "double", "long double", "float", "__float128", "unsigned char", "int",
+    "unsigned int", NULL, "long", "unsigned long", "__int128", "unsigned __int128", NULL, NULL, NULL, "short",
+    "unsigned short", NULL, "void", "wchar_t", "long long", "unsigned long long", "..."
+};
+
+/* Operator codes */
+static const demangle_op_t Demangle_ops[] =
+{
+    { {'a','N'}, DEMANGLE_OP_BINARY,     "&=" },
+    { {'a','S'}, DEMANGLE_OP_BINARY,     "=" },
+    { {'a','a'}, DEMANGLE_OP_BINARY,     "&&" },
+    { {'a','d'}, DEMANGLE_OP_PREFIX,     "&" },
+    { {'a','n'}, DEMANGLE_OP_BINARY,     "&" },
+    { {'a','t'}, DEMANGLE_OP_OF_TYPE,    "alignof " },
+    { {'a','w'}, DEMANGLE_OP_PREFIX,     "co_await " },
+    { {'a','z'}, DEMANGLE_OP_PREFIX,     "alignof " },
+    { {'c','c'}, DEMANGLE_OP_NAMED_CAST, "const_cast" },
+    { {'c','l'}, DEMANGLE_OP_NAME_ONLY,  "()" },
+    { {'c','m'}, DEMANGLE_OP_BINARY,     "," },
+    { {'c','o'}, DEMANGLE_OP_PREFIX,     "~" },
+    { {'d','V'}, DEMANGLE_OP_BINARY,     "/=" },
+    { {'d','a'}, DEMANGLE_OP_DELETE,     "delete[] " },
+    { {'d','c'}, DEMANGLE_OP_NAMED_CAST, "dynamic_cast" },
+    { {'d','e'}, DEMANGLE_OP_PREFIX,     "*" },
+    { {'d','l'}, DEMANGLE_OP_DELETE,     "delete " },
+    { {'d','s'}, DEMANGLE_OP_BINARY,     ".*" },
+    { {'d','t'}, DEMANGLE_OP_MEMBER,     "." },
+    { {'d','v'}, DEMANGLE_OP_BINARY,     "/" },
+    { {'e','O'}, DEMANGLE_OP_BINARY,     "^=" },
+    { {'e','o'}, DEMANGLE_OP_BINARY,     "^" },
+    { {'e','q'}, DEMANGLE_OP_BINARY,     "==" },
+    { {'g','e'}, DEMANGLE_OP_BINARY,     ">=" },
+    { {'g','t'}, DEMANGLE_OP_BINARY,     ">" },
+    { {'i','x'}, DEMANGLE_OP_INDEX,      "[]" },
+    { {'l','S'}, DEMANGLE_OP_BINARY,     "<<=" },
+    { {'l','e'}, DEMANGLE_OP_BINARY,     "<=" },
+    { {'l','s'}, DEMANGLE_OP_BINARY,     "<<" },
+    { {'l','t'}, DEMANGLE_OP_BINARY,     "<" },
+    { {'m','I'}, DEMANGLE_OP_BINARY,     "-=" },
+    { {'m','L'}, DEMANGLE_OP_BINARY,     "*=" },
+    { {'m','i'}, DEMANGLE_OP_BINARY,     "-" },
+    { {'m','l'}, DEMANGLE_OP_BINARY,     "*" },
+    { {'m','m'}, DEMANGLE_OP_INCDEC,     "--" },
+    { {'n','a'}, DEMANGLE_OP_NAME_ONLY,  "new[]" },
+    { {'n','e'}, DEMANGLE_OP_BINARY,     "!=" },
+    { {'n','g'}, DEMANGLE_OP_PREFIX,     "-" },
+    { {'n','t'}, DEMANGLE_OP_PREFIX,     "!" },
+    { {'n','w'}, DEMANGLE_OP_NAME_ONLY,  "new" },
+    { {'o','R'}, DEMANGLE_OP_BINARY,     "|=" },
+    { {'o','o'}, DEMANGLE_OP_BINARY,     "||" },
+    { {'o','r'}, DEMANGLE_OP_BINARY,     "|" },
+    { {'p','L'}, DEMANGLE_OP_BINARY,     "+=" },
+    { {'p','l'}, DEMANGLE_OP_BINARY,     "+" },
+    { {'p','m'}, DEMANGLE_OP_BINARY,     "->*" },
+    { {'p','p'}, DEMANGLE_OP_INCDEC,     "++" },
+    { {'p','s'}, DEMANGLE_OP_PREFIX,     "+" },
+    { {'p','t'}, DEMANGLE_OP_MEMBER,     "->" },
+    { {'q','u'}, DEMANGLE_OP_TERNARY,    "?" },
+    { {'r','M'}, DEMANGLE_OP_BINARY,     "%=" },
+    { {'r','S'}, DEMANGLE_OP_BINARY,     ">>=" },
+    { {'r','c'}, DEMANGLE_OP_NAMED_CAST, "reinterpret_cast" },
+    { {'r','m'}, DEMANGLE_OP_BINARY,     "%" },
+    { {'r','s'}, DEMANGLE_OP_BINARY,     ">>" },
+    { {'s','c'}, DEMANGLE_OP_NAMED_CAST, "static_cast" },
+    { {'s','s'}, DEMANGLE_OP_BINARY,     "<=>" },
+    { {'s','t'}, DEMANGLE_OP_OF_TYPE,    "sizeof " },
+    { {'s','z'}, DEMANGLE_OP_PREFIX,     "sizeof " },
+    { {'t','e'}, DEMANGLE_OP_PREFIX,     "typeid " },
+    { {'t','i'}, DEMANGLE_OP_OF_TYPE,    "typeid " },
+    { {'t','w'}, DEMANGLE_OP_PREFIX,     "throw " }
+};
+
+/* Standard substitutions, printed in full as c++filt does */
+static const struct
+{
+    char        code;       /* Letter after S */
+    uint8_t     base_len;   /* Length of the class name after "std::" */
+    const char* text;       /* Expansion */
+} Demangle_stdSubs[] =
+{
+    { 'a', 9,  "std::allocator" },
+    { 'b', 12, "std::basic_string" },
+    { 's', 12, "std::basic_string<char, std::char_traits<char>, std::allocator<char> >" },
+    { 'i', 13, "std::basic_istream<char, std::char_traits<char> >" },
+    { 'o', 13, "std::basic_ostream<char, std::char_traits<char> >" },
+    { 'd', 14, "std::basic_iostream<char, std::char_traits<char> >" }
+};
+
+static uint32_t Demangle_type(demangle_state_t *st);
+static uint32_t Demangle_expr(demangle_state_t *st);
+static uint32_t Demangle_encoding(demangle_state_t *st);
+static uint32_t Demangle_name(demangle_state_t *st, demangle_name_info_t *info);
+static uint32_t Demangle_templateArgs(demangle_state_t *st, int tag);
+static uint32_t Demangle_templateArg(demangle_state_t *st);
+static void Demangle_print(demangle_state_t *st, uint32_t id);
+static void Demangle_printLeft(demangle_state_t *st, uint32_t id);
+static void Demangle_printRight(demangle_state_t *st, uint32_t id);
+
+/**
+ * @brief Records the first error of a demangling
+ * @param[in,out] st Demangling state
+ * @param[in] err ElfParser_Error code
+ * @return uint32_t 0, the null node, for use in return statements
+ */
+static uint32_t Demangle_fail(demangle_state_t *st, int err)
+{
+    if (st->err == ELFPARSER_SUCCESS)
+    {
+        st->err = err;
+    }
+    return 0;  // No node
+}
+
+/**
+ * @brief Appends a value to a growable index array
+ * @param[in,out] st Demangling state
+ * @param[in,out] arr Pointer to the array
+ * @param[in,out] num Pointer to the number of values
+ * @param[in,out] cap Pointer to the capacity
+ * @param[in] value Value to append
+ * @return int 0 on success, -1 on allocation failure (recorded in st)
+ */
+static int Demangle_push(demangle_state_t *st, uint32_t **arr, uint32_t *num, uint32_t *cap, uint32_t value)
+{
+    if (*num == *cap)
+    {
+        uint32_t new_cap = *cap ? *cap * 2 : DEMANGLE_ARRAY_INITIAL;
+        uint32_t *grown = realloc(*arr, (size_t)new_cap * sizeof(uint32_t));
+        if (!grown || new_cap < *cap)
+        {
+            Demangle_fail(st, ELFPARSER_ERR_MALLOC);
+            return -1;  // Allocation failure
+        }
+        *arr = grown;
+        *cap = new_cap;
+    }
+    (*arr)[(*num)++] = value;
+    return 0;  // Success
+}
+
+/**
+ * @brief Creates a node
+ * @param[in,out] st Demangling state
+ * @param[in] kind demangle_node_kind_e of the node
+ * @param[in] a First child
+ * @param[in] b Second child
+ * @param[in] c Third child
+ * @return uint32_t Index of the node, 0 after an error
+ */
+static uint32_t Demangle_node(demangle_state_t *st, uint8_t kind, uint32_t a, uint32_t b, uint32_t c)
+{
+    demangle_scratch_t *s = st->s;
+    if (st->err != ELFPARSER_SUCCESS)
+    {
+        return 0;  // Earlier error
+    }
+    if (s->node_num >= s->node_cap)
+    {
+        uint32_t new_cap = s->node_cap ? s->node_cap * 2 : DEMANGLE_ARRAY_INITIAL;
+        demangle_node_t *grown = realloc(s->nodes, (size_t)new_cap * sizeof(demangle_node_t));
+        if (!grown || new_cap < s->node_cap)
+        {
+            return Demangle_fail(st, ELFPARSER_ERR_MALLOC);  // Allocation failure
+        }
+        s->nodes = grown;
+        s->node_cap = new_cap;
+    }
+    demangle_node_t *node = &s->nodes[s->node_num];
+    node->kind = kind;
+    node->flags = 0;
+    node->a = a;
+    node->b = b;
+    node->c = c;
+    node->len = 0;
+    node->str = NULL;
+    return s->node_num++;
+}
+
+/**
+ * @brief Creates a node carrying text
+ * @param[in,out] st Demangling state
+ * @param[in] kind demangle_node_kind_e of the node
+ * @param[in] str Text, in the mangled name or a literal
+ * @param[in] len Length of str
+ * @param[in] a First child
+ * @return uint32_t Index of the node, 0 after an error
+ */
+static uint32_t Demangle_textNode(demangle_state_t *st, uint8_t kind, const char *str, size_t len, uint32_t a)
+{
+    uint32_t id = Demangle_node(st, kind, a, 0, 0);
+    if (id)
+    {
+        st->s->nodes[id].str = str;
+        st->s->nodes[id].len = (uint32_t)len;
+    }
+    return id;
+}
+
+/**
+ * @brief Turns the children stacked since a mark into a list node
+ * @param[in,out] st Demangling state
+ * @param[in] mark Stack size before the first child
+ * @return uint32_t Index of the list node, 0 after an error
+ */
+static uint32_t Demangle_listMake(demangle_state_t *st, uint32_t mark)
+{
+    demangle_scratch_t *s = st->s;
+    if (st->err != ELFPARSER_SUCCESS)
+    {
+        return 0;  // Earlier error
+    }
+    uint32_t start = s->list_num;
+    for (uint32_t i = mark; i < s->stack_num; i++)
+    {
+        if (Demangle_push(st, &s->lists, &s->list_num, &s->list_cap, s->stack[i]))
+        {
+            return 0;  // Allocation failure
+        }
+    }
+    uint32_t count = s->stack_num - mark;
+    s->stack_num = mark;
+    return Demangle_node(st, DEMANGLE_NODE_LIST, start, count, 0);
+}
+
+/**
+ * @brief Returns a character ahead of the current position
+ * @param[in] st Demangling state
+ * @param[in] k Distance from the current position
+ * @return char The character, '\0' past the end
+ */
+static inline char Demangle_look(const demangle_state_t *st, size_t k)
+{
+    return ((size_t)(st->end - st->pos) > k) ? st->pos[k] : '\0';
+}
+
+/**
+ * @brief Consumes one expected character
+ * @param[in,out] st Demangling state
+ * @param[in] c Expected character
+ * @return int 1 if it was there and consumed, 0 otherwise
+ */
+static inline int Demangle_consume(demangle_state_t *st, char c)
+{
+    if (st->pos < st->end && *st->pos == c)
+    {
+        st->pos++;
+        return 1;  // Consumed
+    }
+    return 0;  // Not there
+}
+
+/**
+ * @brief Consumes two expected characters
+ * @param[in,out] st Demangling state
+ * @param[in] c0 First expected character
+ * @param[in] c1 Second expected character
+ * @return int 1 if both were there and consumed, 0 otherwise
+ */
+static inline int Demangle_consume2(demangle_state_t *st, char c0, char c1)
+{
+    if (Demangle_look(st, 0) == c0 && Demangle_look(st, 1) == c1)
+    {
+        st->pos += 2;
+        return 1;  // Consumed
+    }
+    return 0;  // Not there
+}
+
+/**
+ * @brief Tells whether a character is a decimal digit
+ * @param[in] c Character
+ * @return int Non-zero for '0' to '9'
+ */
+static inline int Demangle_isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+/**
+ * @brief Tells whether a character is a lowercase letter
+ * @param[in] c Character
+ * @return int Non-zero for 'a' to 'z'
+ */
+static inline int Demangle_isLower(char c)
+{
+    return c >= 'a' && c <= 'z';
+}
+
+/**
+ * @brief Reads a non-negative decimal number
+ * @param[in,out] st Demangling state
+ * @param[out] value Set to the number
+ * @return int 0 on success, -1 if no digits follow or the number overflows (recorded in st)
+ */
+static int Demangle_numberRead(demangle_state_t *st, uint64_t *value)
+{
+    const char *start = st->pos;
+    uint64_t v = 0;
+    while (st->pos < st->end && Demangle_isDigit(*st->pos))
+    {
+        if (v > (UINT32_MAX - 9u) / 10u)
+        {
+            Demangle_fail(st, ELFPARSER_ERR_FORMAT);
+            return -1;  // Larger than any name or index can be
+        }
+        v = v * 10u + (uint64_t)(*st->pos++ - '0');
+    }
+    if (st->pos == start)
+    {
+        Demangle_fail(st, ELFPARSER_ERR_FORMAT);
+        return -1;  // No digits
+    }
+    *value = v;
+    return 0;  // Success
+}
+
+/**
+ * @brief Reads a number that may be negative (n prefix) and discards it
+ * @param[in,out] st Demangling state
+ * @return int 0 on success, -1 on error (recorded in st)
+ */
+static int Demangle_numberSkip(demangle_state_t *st)
+{
+    uint64_t value;
+    Demangle_consume(st, 'n');
+    return Demangle_numberRead(st, &value);
+}
+
+/**
+ * @brief Reads an optional number ended by an underscore (<number> _ or just _)
+ * @param[in,out] st Demangling state
+ * @param[out] value Set to the number plus one, 0 when it was omitted
+ * @return int 0 on success, -1 on error (recorded in st)
+ */
+static int Demangle_indexRead(demangle_state_t *st, uint64_t *value)
+{
+    *value = 0;
+    if (Demangle_consume(st, '_'))
+    {
+        return 0;  // Omitted
+    }
+    if (Demangle_numberRead(st, value) || !Demangle_consume(st, '_'))
+    {
+        return (int)Demangle_fail(st, ELFPARSER_ERR_FORMAT) - 1;  // Malformed
+    }
+    (*value)++;
+    return 0;  // Success
+}
+
+/**
+ * @brief Skips an optional discriminator of a local entity (_ <digit> or __ <number> _)
+ * @param[in,out] st Demangling state
+ */
+static void Demangle_discriminatorSkip(demangle_state_t *st)
+{
+    uint64_t value;
+    if (!Demangle_consume(st, '_'))
+    {
+        return;
+    }
+    int wide = Demangle_consume(st, '_');
+    if (Demangle_numberRead(st, &value) == 0 && wide)
+    {
+        Demangle_consume(st, '_');
+    }
+}
+
+/**
+ * @brief Parses a <source-name>
+ * @param[in,out] st Demangling state
+ * @return uint32_t Name node, 0 on error
+ */
+static uint32_t Demangle_sourceName(demangle_state_t *st)
+{
+    uint64_t len;
+    if (Demangle_numberRead(st, &len))
+    {
+        return 0;  // Malformed length
+    }
+    if (len == 0 || len > (uint64_t)(st->end - st->pos))
+    {
+        return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Name past the end
+    }
+    const char *str = st->pos;
+    st->pos += len;
+    if (len >= 10 && memcmp(str, "_GLOBAL__N", 10) == 0)
+    {
+        static const char anon[] = "(anonymous namespace)";
+        return Demangle_textNode(st, DEMANGLE_NODE_NAME, anon, sizeof(anon) - 1, 0);
+    }
+    return Demangle_textNode(st, DEMANGLE_NODE_NAME, str, len, 0);
+}
+
+/**
+ * @brief Parses optional cv qualifiers (r V K)
+ * @param[in,out] st Demangling state
+ * @return uint8_t DEMANGLE_CV_* flags
+ */
+static uint8_t Demangle_cvRead(demangle_state_t *st)
+{
+    uint8_t cv = 0;
+    cv |= Demangle_consume(st, 'r') ? DEMANGLE_CV_RESTRICT : 0;
+    cv |= Demangle_consume(st, 'V') ? DEMANGLE_CV_VOLATILE : 0;
+    cv |= Demangle_consume(st, 'K') ? DEMANGLE_CV_CONST : 0;
+    return cv;
+}
+
+/**
+ * @brief Looks up an operator code
+ * @param[in] c0 First letter
+ * @param[in] c1 Second letter
+ * @return const demangle_op_t* The operator, NULL if the code is unknown
+ */
+static const demangle_op_t *Demangle_opFind(char c0, char c1)
+{
+    for (size_t i = 0; i < sizeof(Demangle_ops) / sizeof(Demangle_ops[0]); i++)
+    {
+        if (Demangle_ops[i].code[0] == c0 && Demangle_ops[i].code[1] == c1)
+        {
+            return &Demangle_ops[i];
+        }
+    }
+    return NULL;  // Unknown
+}
+
+/**
+ * @brief Adds a substitution candidate
+ * @param[in,out] st Demangling state
+ * @param[in] id Node that later S_ references may name
+ */
+static void Demangle_subAdd(demangle_state_t *st, uint32_t id)
+{
+    if (id)
+    {
+        Demangle_push(st, &st->s->subs, &st->s->sub_num, &st->s->sub_cap, id);
+    }
+}
+
+/**
+ * @brief Parses a <substitution> (S_, S <seq-id> _ or a standard abbreviation)
+ * @param[in,out] st Demangling state
+ * @return uint32_t The substituted node, 0 on error
+ */
+static uint32_t Demangle_substitution(demangle_state_t *st)
+{
+    if (!Demangle_consume(st, 'S'))
+    {
+        return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Not a substitution
+    }
+    char c = Demangle_look(st, 0);
+    if (Demangle_isLower(c))
+    {
+        for (size_t i = 0; i < sizeof(Demangle_stdSubs) / sizeof(Demangle_stdSubs[0]); i++)
+        {
+            if (Demangle_stdSubs[i].code == c)
+            {
+                st->pos++;
+                uint32_t id = Demangle_textNode(st, DEMANGLE_NODE_SPECIAL_SUB, Demangle_stdSubs[i].text,
+                                                strlen(Demangle_stdSubs[i].text), 0);
+                if (id)
+                {
+                    st->s->nodes[id].c = Demangle_stdSubs[i].base_len;
+                }
+                return id;
+            }
+        }
+        return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Unknown abbreviation
+    }
+    uint64_t idx = 0;
+    if (!Demangle_consume(st, '_'))
+    {
+        while (st->pos < st->end && *st->pos != '_')  // Base 36 sequence id
+        {
+            char d = *st->pos++;
+            uint64_t digit = Demangle_isDigit(d) ? (uint64_t)(d - '0') : (d >= 'A' && d <= 'Z') ? (uint64_t)(d - 'A' + 10) : 36;
+            if (digit == 36 || idx > UINT32_MAX / 36u)
+            {
+                return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Malformed sequence id
+            }
+            idx = idx * 36u + digit;
+        }
+        if (!Demangle_consume(st, '_'))
+        {
+            return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Unterminated
+        }
+        idx++;
+    }
+    if (idx >= st->s->sub_num)
+    {
+        return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Reference past the candidates
+    }
+    uint32_t id = st->s->subs[idx];
+    const demangle_node_t *node = &st->s->nodes[id];
+    if (node->kind == DEMANGLE_NODE_TPARAM && !node->flags && node->c != st->tparam_base &&
+        node->b < st->s->tparam_num - st->tparam_base)
+    {
+        id = Demangle_node(st, DEMANGLE_NODE_TPARAM, st->s->tparams[st->tparam_base + node->b], node->b, st->tparam_base);
+    }
+    return id;  // c++filt reads a template parameter reused outside its encoding in the current one
+}
+
+/**
+ * @brief Parses a <template-param> and binds it to its argument
+ * @param[in,out] st Demangling state
+ * @return uint32_t Template parameter node, 0 on error
+ */
+static uint32_t Demangle_templateParam(demangle_state_t *st)
+{
+    demangle_scratch_t *s = st->s;
+    uint64_t idx;
+    if (!Demangle_consume(st, 'T') || Demangle_indexRead(st, &idx))
+    {
+        return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Malformed (levels and declarations are not supported)
+    }
+    uint32_t id = Demangle_node(st, DEMANGLE_NODE_TPARAM, 0, (uint32_t)idx, st->tparam_base);
+    if (!id)
+    {
+        return 0;  // Allocation failure
+    }
+    if (st->lambda_depth)
+    {
+        s->nodes[id].flags = DEMANGLE_TPARAM_LAMBDA;  // auto:N in the signature, bound later if the encoding allows
+    }
+    else if (idx < (uint64_t)(s->tparam_num - st->tparam_base))
+    {
+        s->nodes[id].a = s->tparams[st->tparam_base + idx];
+        return id;
+    }
+    else if (st->permit_fwd)
+    {
+        s->nodes[id].flags = DEMANGLE_TPARAM_FORWARD;
+    }
+    else
+    {
+        return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // No such argument
+    }
+    return Demangle_push(st, &s->refs, &s->ref_num, &s->ref_cap, id) ? 0 : id;
+}
+
+/**
+ * @brief Binds the late template parameters of the current encoding
+ * @param[in,out] st Demangling state
+ */
+static void Demangle_refsBind(demangle_state_t *st)
+{
+    demangle_scratch_t *s = st->s;
+    uint32_t visible = s->tparam_num - st->tparam_base;
+    for (uint32_t i = st->ref_base; i < s->ref_num && st->err == ELFPARSER_SUCCESS; i++)
+    {
+        demangle_node_t *node = &s->nodes[s->refs[i]];
+        if (node->b < visible)
+        {
+            node->a = s->tparams[st->tparam_base + node->b];
+        }
+        else if (node->flags & DEMANGLE_TPARAM_FORWARD)
+        {
+            Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Never got its argument
+        }
+    }
+}
+
+/**
+ * @brief Parses an <expr-primary> (L ... E)
+ * @param[in,out] st Demangling state
+ * @return uint32_t Literal or encoding node, 0 on error
+ */
+static uint32_t Demangle_exprPrimary(demangle_state_t *st)
+{
+    if (!Demangle_consume(st, 'L'))
+    {
+        return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Not a literal
+    }
+    if ((Demangle_look(st, 0) == '_' && Demangle_look(st, 1) == 'Z') || Demangle_look(st, 0) == 'Z')
+    {
+        Demangle_consume(st, '_');
+        st->pos++;
+        uint32_t enc = Demangle_encoding(st);
+        return (enc && Demangle_consume(st, 'E')) ? enc : Demangle_fail(st, ELFPARSER_ERR_FORMAT);
+    }
+    uint32_t type = Demangle_type(st);
+    if (!type)
+    {
+        return 0;  // Malformed type
+    }
+    int neg = Demangle_consume(st, 'n');
+    const char *value = st->pos;
+    while (st->pos < st->end && *st->pos != 'E')
+    {
+        st->pos++;
+    }
+    size_t len = (size_t)(st->pos - value);
+    if (!Demangle_consume(st, 'E'))
+    {
+        return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Unterminated
+    }
+    uint32_t id = Demangle_textNode(st, DEMANGLE_NODE_LITERAL, value, len, type);
+    if (id)
+    {
+        st->s->nodes[id].flags = neg ? DEMANGLE_LITERAL_NEG : 0;
+    }
+    return id;
+}
+
+/**
+ * @brief Parses a <template-arg>
+ * @param[in,out] st Demangling state
+ * @return uint32_t Argument node, 0 on error
+ */
+static uint32_t Demangle_templateArg(demangle_state_t *st)
+{
+    switch (Demangle_look(st, 0))
+    {
+        case 'X':
+        {
+            st->pos++;
+            uint32_t expr = Demangle_expr(st);
+            return (expr && Demangle_consume(st, 'E')) ? expr : Demangle_fail(st, ELFPARSER_ERR_FORMAT);
+        }
+        case 'J':
+        {
+            uint32_t mark = st->s->stack_num;
+            st->pos++;
+            while (!Demangle_consume(st, 'E'))
+            {
+                uint32_t arg = Demangle_templateArg(st);
+                if (!arg || Demangle_push(st, &st->s->stack, &st->s->stack_num, &st->s->stack_cap, arg))
+                {
+                    return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Malformed pack
+                }
+            }
+            uint32_t list = Demangle_listMake(st, mark);
+            return Demangle_node(st, DEMANGLE_NODE_ARG_PACK, list, 0, 0);
+        }
+        case 'L':
+            return Demangle_exprPrimary(st);
+        default:
+            return Demangle_type(st);
+    }
+}
+
+/**
+ * @brief Parses <template-args> (I ... E)
+ * @param[in,out] st Demangling state
+ * @param[in] tag Non-zero if these are the arguments template parameters of the encoding refer to
+ * @return uint32_t List node, 0 on error
+ */
+static uint32_t Demangle_templateArgs(demangle_state_t *st, int tag)
+{
+    demangle_scratch_t *s = st->s;
+    if (!Demangle_consume(st, 'I'))
+    {
+        return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Not template arguments
+    }
+    if (tag)
+    {
+        s->tparam_num = st->tparam_base;
+    }
+    uint8_t save_targs = st->try_targs;
+    uint32_t mark = s->stack_num;
+    st->try_targs = 1;  // Even inside the type of a conversion operator
+    while (!Demangle_consume(st, 'E'))
+    {
+        uint32_t arg = Demangle_templateArg(st);
+        if (!arg || Demangle_push(st, &s->stack, &s->stack_num, &s->stack_cap, arg))
+        {
+            st->try_targs = save_targs;
+            return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Malformed argument
+        }
+        if (tag)
+        {
+            uint32_t entry = arg;
+            if (s->nodes[arg].kind == DEMANGLE_NODE_ARG_PACK)  // Parameters expand the pack one element at a time
+            {
+                entry = Demangle_node(st, DEMANGLE_NODE_PARAM_PACK, s->nodes[arg].a, 0, 0);
+            }
+            if (!entry || Demangle_push(st, &s->tparams, &s->tparam_num, &s->tparam_cap, entry))
+            {
+                st->try_targs = save_targs;
+                return 0;  // Allocation failure
+            }
+        }
+    }
+    st->try_targs = save_targs;
+    return Demangle_listMake(st, mark);
+}
+
+/**
+ * @brief Parses a bare function type (F [Y] <type>+ [<ref-qualifier>] E), with an optional exception spec before it
+ * @param[in,out] st Demangling state
+ * @return uint32_t Function type node, 0 on error
+ */
+static uint32_t Demangle_funcType(demangle_state_t *st)
+{
+    demangle_scratch_t *s = st->s;
+    uint32_t exc = 0;
+    if (Demangle_consume2(st, 'D', 'o'))
+    {
+        static const char noexcept_text[] = " noexcept";
+        exc = Demangle_textNode(st, DEMANGLE_NODE_NAME, noexcept_text, sizeof(noexcept_text) - 1, 0);
+    }
+    else if (Demangle_consume2(st, 'D', 'O'))
+    {
+        static const char noexcept_text[] = " noexcept";
+        uint32_t expr = Demangle_expr(st);
+        if (!expr || !Demangle_consume(st, 'E'))
+        {
+            return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Malformed noexcept
+        }
+        exc = Demangle_textNode(st, DEMANGLE_NODE_ENCLOSE, noexcept_text, sizeof(noexcept_text) - 1, expr);
+    }
+    else if (Demangle_consume2(st, 'D', 'w'))
+    {
+        static const char throw_text[] = " throw";
+        uint32_t mark = s->stack_num;
+        while (!Demangle_consume(st, 'E'))
+        {
+            uint32_t type = Demangle_type(st);
+            if (!type || Demangle_push(st, &s->stack, &s->stack_num, &s->stack_cap, type))
+            {
+                return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Malformed throw spec
+            }
+        }
+        exc = Demangle_textNode(st, DEMANGLE_NODE_ENCLOSE, throw_text, sizeof(throw_text) - 1, Demangle_listMake(st, mark));
+    }
+    else if (Demangle_consume2(st, 'D', 'x'))
+    {
+        static const char safe_text[] = " transaction_safe";
+        exc = Demangle_textNode(st, DEMANGLE_NODE_NAME, safe_text, sizeof(safe_text) - 1, 0);
+    }
+    if (!Demangle_consume(st, 'F'))
+    {
+        return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Not a function type
+    }
+    Demangle_consume(st, 'Y');
+    uint32_t ret = Demangle_type(st);
+    if (!ret)
+    {
+        return 0;  // Malformed return type
+    }
+    uint32_t mark = s->stack_num;
+    uint8_t ref = 0;
+    int typed = 0;
+    for (;;)
+    {
+        if (Demangle_consume(st, 'E'))
+        {
+            break;
+        }
+        char next = Demangle_look(st, 1);
+        if (!typed && Demangle_look(st, 0) == 'v' && (next == 'E' || ((next == 'R' || next == 'O') && Demangle_look(st, 2) == 'E')))
+        {
+            st->pos++;  // No parameters
+            typed = 1;
+            continue;
+        }
+        if (Demangle_consume2(st, 'R', 'E'))
+        {
+            ref = 1;
+            break;
+        }
+        if (Demangle_consume2(st, 'O', 'E'))
+        {
+            ref = 2;
+            break;
+        }
+        uint32_t param = Demangle_type(st);
+        if (!param || Demangle_push(st, &s->stack, &s->stack_num, &s->stack_cap, param))
+        {
+            return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Malformed parameter
+        }
+        typed = 1;
+    }
+    if (!typed)
+    {
+        return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Return type without parameter types
+    }
+    uint32_t id = Demangle_node(st, DEMANGLE_NODE_FUNC_TYPE, ret, Demangle_listMake(st, mark), exc);
+    if (id)
+    {
+        s->nodes[id].flags = (uint8_t)(ref << DEMANGLE_REF_SHIFT);
+    }
+    return id;
+}
+
+/**
+ * @brief Parses an array type (A [<number> | <expression>] _ <type>)
+ * @param[in,out] st Demangling state
+ * @return uint32_t Array node, 0 on error
+ */
+static uint32_t Demangle_arrayType(demangle_state_t *st)
+{
+    uint32_t dim = 0;
+    st->pos++;
+    if (Demangle_isDigit(Demangle_look(st, 0)))
+    {
+        const char *start = st->pos;
+        uint64_t value;
+        Demangle_numberRead(st, &value);
+        dim = Demangle_textNode(st, DEMANGLE_NODE_NAME, start, (size_t)(st->pos - start), 0);
+    }
+    else if (Demangle_look(st, 0) != '_')
+    {
+        dim = Demangle_expr(st);
+    }
+    if (st->err != ELFPARSER_SUCCESS || !Demangle_consume(st, '_'))
+    {
+        return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Malformed dimension
+    }
+    uint32_t elem = Demangle_type(st);
+    return elem ? Demangle_node(st, DEMANGLE_NODE_ARRAY, elem, dim, 0) : 0;
+}
+
+/**
+ * @brief Parses a builtin type introduced by D, or a type-like D construct
+ * @param[in,out] st Demangling state
+ * @param[out] builtin Set to non-zero for builtin types, which are no substitution candidates
+ * @return uint32_t Type node, 0 on error
+ */
+static uint32_t Demangle_dType(demangle_state_t *st, int *builtin)
+{
+    static const struct
+    {
+        char        code;
+        const char* name;
+    } names[] =
+    {
+        { 'd', "decimal64" }, { 'e', "decimal128" }, { 'f', "decimal32" }, { 'h', "half" }, { 'i', "char32_t" },
+        { 's', "char16_t" }, { 'u', "char8_t" }, { 'a', "auto" }, { 'c', "decltype(auto)" }, { 'n', "decltype(nullptr)" }
+    };
+    char c = Demangle_look(st, 1);
+    *builtin = 0;
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++)
+    {
+        if (names[i].code == c)
+        {
+            st->pos += 2;
+            *builtin = 1;
+            return Demangle_textNode(st, DEMANGLE_NODE_BUILTIN, names[i].name, strlen(names[i].name), 0);
+        }
+    }
+    switch (c)
+    {
+        case 'F':
+        {
+            uint64_t bits;
+            st->pos += 2;
+            if (Demangle_numberRead(st, &bits))
+            {
+                return 0;  // Malformed width
+            }
+            uint8_t ext = (uint8_t)Demangle_consume(st, 'x');
+            if (!ext && !Demangle_consume(st, '_'))
+            {
+                return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Unterminated
+            }
+            uint32_t id = Demangle_node(st, DEMANGLE_NODE_FLOATN, 0, (uint32_t)bits, 0);
+            if (id)
+            {
+                st->s->nodes[id].flags = ext;
+            }
+            *builtin = 1;
+            return id;
+        }
+        case 't':
+        case 'T':
+        {
+            static const char decltype_text[] = "decltype ";
+            st->pos += 2;
+            uint32_t expr = Demangle_expr(st);
+            if (!expr || !Demangle_consume(st, 'E'))
+            {
+                return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Malformed decltype
+            }
+            return Demangle_textNode(st, DEMANGLE_NODE_ENCLOSE, decltype_text, sizeof(decltype_text) - 1, expr);
+        }
+        case 'p':
+        {
+            st->pos += 2;
+            uint32_t pattern = Demangle_type(st);
+            return pattern ? Demangle_node(st, DEMANGLE_NODE_EXPANSION, pattern, 0, 0) : 0;
+        }
+        case 'v':
+        {
+            uint32_t dim;
+            st->pos += 2;
+            if (Demangle_isDigit(Demangle_look(st, 0)))
+            {
+                const char *start = st->pos;
+                uint64_t value;
+                Demangle_numberRead(st, &value);
+                dim = Demangle_textNode(st, DEMANGLE_NODE_NAME, start, (size_t)(st->pos - start), 0);
+            }
+            else
+            {
+                dim = Demangle_consume(st, '_') ? Demangle_expr(st) : Demangle_fail(st, ELFPARSER_ERR_FORMAT);
+            }
+            if (!dim || !Demangle_consume(st, '_'))
+            {
+                return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Malformed vector size
+            }
+            uint32_t elem = Demangle_type(st);
+            return elem ? Demangle_node(st, DEMANGLE_NODE_VECTOR, elem, dim, 0) : 0;
+        }
+        case 'o':
+        case 'O':
+        case 'w':
+        case 'x':
+            return Demangle_funcType(st);
+        default:
+            return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Unsupported D construct
+    }
+}
+
+/**
+ * @brief Parses a <type> and records it as a substitution candidate
+ * @param[in,out] st Demangling state
+ * @return uint32_t Type node, 0 on error
+ */
+static uint32_t Demangle_typeParse(demangle_state_t *st)
+{
+    demangle_scratch_t *s = st->s;
+    char c = Demangle_look(st, 0);
+    uint32_t id;
+
+    if (Demangle_isLower(c) && Demangle_builtins[c - 'a'])
+    {
+        st->pos++;
+        id = Demangle_textNode(st, DEMANGLE_NODE_BUILTIN, Demangle_builtins[c - 'a'], strlen(Demangle_builtins[c - 'a']), 0);
+        if (id)
+        {
+            s->nodes[id].flags = (uint8_t)c;
+        }
+        return id;  // Builtins are no candidates
+    }
+    switch (c)
+    {
+        case 'r':
+        case 'V':
+        case 'K':
+        {
+            uint8_t cv = Demangle_cvRead(st);
+            uint32_t inner = Demangle_type(st);
+            if (!inner)
+            {
+                return 0;  // Malformed type
+            }
+            if (s->nodes[inner].kind == DEMANGLE_NODE_FUNC_TYPE)  // Qualified function type, as in member function pointers
+            {
+                if (s->sub_num && s->subs[s->sub_num - 1] == inner)
+                {
+                    s->sub_num--;  // The qualifiers belong to the function type, one candidate in all
+                }
+                id = Demangle_node(st, DEMANGLE_NODE_FUNC_TYPE, 0, 0, 0);
+                if (id)
+                {
+                    s->nodes[id] = s->nodes[inner];
+                    s->nodes[id].flags |= cv;
+                }
+            }
+            else
+            {
+                id = Demangle_node(st, DEMANGLE_NODE_QUAL, inner, 0, 0);
+                if (id)
+                {
+                    s->nodes[id].flags = cv;
+                }
+            }
+            break;
+        }
+        case 'U':
+        {
+            st->pos++;
+            uint32_t qual = Demangle_sourceName(st);
+            if (qual && Demangle_look(st, 0) == 'I')
+            {
+                Demangle_templateArgs(st, 0);  // Arguments of the qualifier are not printed
+            }
+            uint32_t inner = qual ? Demangle_type(st) : 0;
+            if (!inner)
+            {
+                return 0;  // Malformed qualifier or type
+            }
+            id = Demangle_node(st, DEMANGLE_NODE_SUFFIX, inner, qual, 0);
+            break;
+        }
+        case 'u':
+            st->pos++;
+            id = Demangle_sourceName(st);
+            break;
+        case 'D':
+        {
+            int builtin;
+            id = Demangle_dType(st, &builtin);
+            if (builtin)
+            {
+                return id;  // Builtins are no candidates
+            }
+            break;
+        }
+        case 'F':
+            id = Demangle_funcType(st);
+            break;
+        case 'A':
+            id = Demangle_arrayType(st);
+            break;
+        case 'M':
+        {
+            st->pos++;
+            uint32_t cls = Demangle_type(st);
+            uint32_t member = cls ? Demangle_type(st) : 0;
+            id = member ? Demangle_node(st, DEMANGLE_NODE_PTRMEM, cls, member, 0) : 0;
+            break;
+        }
+        case 'T':
+            if (Demangle_look(st, 1) == 's' || Demangle_look(st, 1) == 'u' || Demangle_look(st, 1) == 'e')
+            {
+                st->pos += 2;
+                id = Demangle_name(st, NULL);  // Elaborated struct, union or enum
+                break;
+            }
+            id = Demangle_templateParam(st);
+            if (id && st->try_targs && Demangle_look(st, 0) == 'I')  // Template template parameter with arguments
+            {
+                Demangle_subAdd(st, id);
+                uint32_t args = Demangle_templateArgs(st, 0);
+                id = args ? Demangle_node(st, DEMANGLE_NODE_TEMPLATE, id, args, 0) : 0;
+            }
+            break;
+        case 'P':
+        case 'R':
+        case 'O':
+        {
+            static const uint8_t kinds[3] = { DEMANGLE_NODE_POINTER, DEMANGLE_NODE_LREF, DEMANGLE_NODE_RREF };
+            uint8_t kind = kinds[(c == 'P') ? 0 : (c == 'R') ? 1 : 2];
+            st->pos++;
+            uint32_t inner = Demangle_type(st);
+            id = inner ? Demangle_node(st, kind, inner, 0, 0) : 0;
+            break;
+        }
+        case 'C':
+        case 'G':
+        {
+            static const char complex_text[] = " _Complex";
+            static const char imaginary_text[] = " _Imaginary";
+            st->pos++;
+            uint32_t inner = Demangle_type(st);
+            id = inner ? Demangle_textNode(st, DEMANGLE_NODE_SUFFIX, (c == 'C') ? complex_text : imaginary_text,
+                                           (c == 'C') ? sizeof(complex_text) - 1 : sizeof(imaginary_text) - 1, inner) : 0;
+            break;
+        }
+        case 'S':
+            if (Demangle_look(st, 1) == 't')
+            {
+                id = Demangle_name(st, NULL);
+                break;
+            }
+            id = Demangle_substitution(st);
+            if (!id || !st->try_targs || Demangle_look(st, 0) != 'I')
+            {
+                return id;  // A substitution is no new candidate
+            }
+            {
+                uint32_t args = Demangle_templateArgs(st, 0);
+                id = args ? Demangle_node(st, DEMANGLE_NODE_TEMPLATE, id, args, 0) : 0;
+            }
+            break;
+        default:
+            id = Demangle_name(st, NULL);  // Class or enum name
+            break;
+    }
+    if (!id)
+    {
+        return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Malformed type
+    }
+    Demangle_subAdd(st, id);
+    return id;
+}
+
+/**
+ * @brief Parses a <type>, bounding the recursion depth
+ * @param[in,out] st Demangling state
+ * @return uint32_t Type node, 0 on error
+ */
+static uint32_t Demangle_type(demangle_state_t *st)
+{
+    if (st->err != ELFPARSER_SUCCESS || ++st->depth > DEMANGLE_DEPTH_MAX)
+    {
+        st->depth -= (st->err == ELFPARSER_SUCCESS);
+        return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Too deep
+    }
+    uint32_t id = Demangle_typeParse(st);
+    st->depth--;
+    return id;
+}
+
+/**
+ * @brief Parses an <operator-name>
+ * @param[in,out] st Demangling state
+ * @param[in,out] info Facts about the enclosing encoding name, NULL outside one
+ * @return uint32_t Operator node, 0 on error
+ */
+static uint32_t Demangle_operatorName(demangle_state_t *st, demangle_name_info_t *info)
+{
+    char c0 = Demangle_look(st, 0);
+    char c1 = Demangle_look(st, 1);
+    if (c0 == 'c' && c1 == 'v')
+    {
+        uint8_t save_targs = st->try_targs;
+        uint8_t save_fwd = st->permit_fwd;
+        st->pos += 2;
+        st->try_targs = 0;  // Arguments after the type belong to the operator
+        st->permit_fwd = save_fwd || info;
+        uint32_t type = Demangle_type(st);
+        st->try_targs = save_targs;
+        st->permit_fwd = save_fwd;
+        if (info)
+        {
+            info->ctor_conv = 1;
+        }
+        return type ? Demangle_node(st, DEMANGLE_NODE_CONV, type, 0, 0) : 0;
+    }
+    if (c0 == 'l' && c1 == 'i')
+    {
+        st->pos += 2;
+        uint32_t suffix = Demangle_sourceName(st);
+        return suffix ? Demangle_node(st, DEMANGLE_NODE_LITERAL_OP, suffix, 0, 0) : 0;
+    }
+    if (c0 == 'v' && Demangle_isDigit(c1))
+    {
+        st->pos += 2;
+        uint32_t name = Demangle_sourceName(st);
+        if (!name)
+        {
+            return 0;  // Malformed vendor operator
+        }
+        uint32_t id = Demangle_textNode(st, DEMANGLE_NODE_OPERATOR, st->s->nodes[name].str, st->s->nodes[name].len, 0);
+        if (id)
+        {
+            st->s->nodes[id].flags = DEMANGLE_OPERATOR_VENDOR;
+        }
+        return id;
+    }
+    const demangle_op_t *op = Demangle_opFind(c0, c1);
+    if (!op)
+    {
+        return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Unknown operator
+    }
+    st->pos += 2;
+    return Demangle_textNode(st, DEMANGLE_NODE_OPERATOR, op->name, strlen(op->name), 0);
+}
+
+/**
+ * @brief Parses an <unnamed-type-name> (Ut ... _ or a lambda closure Ul ... E ... _)
+ * @param[in,out] st Demangling state
+ * @return uint32_t Unnamed type or lambda node, 0 on error
+ */
+static uint32_t Demangle_unnamedTypeName(demangle_state_t *st)
+{
+    demangle_scratch_t *s = st->s;
+    uint64_t num;
+    if (Demangle_consume2(st, 'U', 't'))
+    {
+        if (Demangle_indexRead(st, &num))
+        {
+            return 0;  // Malformed number
+        }
+        return Demangle_node(st, DEMANGLE_NODE_UNNAMED, 0, (uint32_t)num + 1, 0);
+    }
+    if (!Demangle_consume2(st, 'U', 'l'))
+    {
+        return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Unsupported unnamed type
+    }
+    uint32_t mark = s->stack_num;
+    st->lambda_depth++;
+    while (!Demangle_consume(st, 'E'))
+    {
+        if (Demangle_consume(st, 'v'))
+        {
+            continue;  // No parameters
+        }
+        uint32_t param = Demangle_type(st);
+        if (!param || Demangle_push(st, &s->stack, &s->stack_num, &s->stack_cap, param))
+        {
+            st->lambda_depth--;
+            return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Malformed parameter
+        }
+    }
+    st->lambda_depth--;
+    uint32_t params = Demangle_listMake(st, mark);
+    if (Demangle_indexRead(st, &num))
+    {
+        return 0;  // Malformed number
+    }
+    return Demangle_node(st, DEMANGLE_NODE_LAMBDA, params, (uint32_t)num + 1, 0);
+}
+
+/**
+ * @brief Parses an <unqualified-name> and its ABI tags
+ * @param[in,out] st Demangling state
+ * @param[in,out] info Facts about the enclosing encoding name, NULL outside one
+ * @return uint32_t Name node, 0 on error
+ */
+static uint32_t Demangle_unqualifiedName(demangle_state_t *st, demangle_name_info_t *info)
+{
+    demangle_scratch_t *s = st->s;
+    char c = Demangle_look(st, 0);
+    uint32_t id;
+    if (c == 'U')
+    {
+        id = Demangle_unnamedTypeName(st);
+    }
+    else if (c == 'D' && Demangle_look(st, 1) == 'C')
+    {
+        uint32_t mark = s->stack_num;
+        st->pos += 2;
+        while (!Demangle_consume(st, 'E'))
+        {
+            uint32_t name = Demangle_sourceName(st);
+            if (!name || Demangle_push(st, &s->stack, &s->stack_num, &s->stack_cap, name))
+            {
+                return 0;  // Malformed binding
+            }
+        }
+        id = Demangle_node(st, DEMANGLE_NODE_BINDING, Demangle_listMake(st, mark), 0, 0);
+    }
+    else if (Demangle_isDigit(c))
+    {
+        id = Demangle_sourceName(st);
+    }
+    else if (Demangle_isLower(c))
+    {
+        id = Demangle_operatorName(st, info);
+    }
+    else
+    {
+        return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Not a name
+    }
+    while (id && Demangle_consume(st, 'B'))
+    {
+        uint32_t tag = Demangle_sourceName(st);
+        id = tag ? Demangle_textNode(st, DEMANGLE_NODE_ABI_TAG, s->nodes[tag].str, s->nodes[tag].len, id) : 0;
+    }
+    return id;
+}
+
+/**
+ * @brief Parses a constructor or destructor name
+ * @param[in,out] st Demangling state
+ * @param[in] so_far Class the name belongs to
+ * @param[in,out] info Facts about the enclosing encoding name, NULL outside one
+ * @return uint32_t Constructor or destructor node, 0 on error
+ */
+static uint32_t Demangle_ctorDtorName(demangle_state_t *st, uint32_t so_far, demangle_name_info_t *info)
+{
+    if (info)
+    {
+        info->ctor_conv = 1;
+    }
+    if (Demangle_consume(st, 'C'))
+    {
+        int inheriting = Demangle_consume(st, 'I');
+        char c = Demangle_look(st, 0);
+        if (c < '1' || c > '5')
+        {
+            return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Unknown constructor kind
+        }
+        st->pos++;
+        if (inheriting && !Demangle_name(st, NULL))
+        {
+            return 0;  // Malformed base class
+        }
+        return Demangle_node(st, DEMANGLE_NODE_CTOR, so_far, 0, 0);
+    }
+    char c = Demangle_look(st, 1);
+    if (!Demangle_consume(st, 'D') || (c != '0' && c != '1' && c != '2' && c != '4' && c != '5'))
+    {
+        return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Unknown destructor kind
+    }
+    st->pos++;
+    return Demangle_node(st, DEMANGLE_NODE_DTOR, so_far, 0, 0);
+}
+
+/**
+ * @brief Parses a <nested-name> (N ... E)
+ * @param[in,out] st Demangling state
+ * @param[in,out] info Facts about the enclosing encoding name, NULL outside one
+ * @return uint32_t Name node, 0 on error
+ */
+static uint32_t Demangle_nestedName(demangle_state_t *st, demangle_name_info_t *info)
+{
+    demangle_scratch_t *s = st->s;
+    uint32_t so_far = 0;
+    st->pos++;
+    uint8_t cv = Demangle_cvRead(st);
+    uint8_t ref = Demangle_consume(st, 'R') ? 1 : Demangle_consume(st, 'O') ? 2 : 0;
+    if (info)
+    {
+        info->cv = cv;
+        info->ref = ref;
+    }
+    while (!Demangle_consume(st, 'E'))
+    {
+        if (st->err != ELFPARSER_SUCCESS || st->pos >= st->end)
+        {
+            return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Unterminated
+        }
+        Demangle_consume(st, 'L');
+        if (Demangle_consume(st, 'M'))
+        {
+            if (!so_far)
+            {
+                return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Data member prefix without a class
+            }
+            continue;
+        }
+        char c0 = Demangle_look(st, 0);
+        char c1 = Demangle_look(st, 1);
+        uint32_t comp;
+        if (info)
+        {
+            info->ends_targs = 0;
+        }
+        if (c0 == 'I')
+        {
+            if (!so_far)
+            {
+                return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Arguments without a template
+            }
+            uint32_t args = Demangle_templateArgs(st, info != NULL);
+            so_far = args ? Demangle_node(st, DEMANGLE_NODE_TEMPLATE, so_far, args, 0) : 0;
+            if (info)
+            {
+                info->ends_targs = 1;
+            }
+            Demangle_subAdd(st, so_far);
+            continue;
+        }
+        if (c0 == 'S' && c1 == 't')
+        {
+            static const char std_text[] = "std";
+            if (so_far)
+            {
+                return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // std inside a scope
+            }
+            st->pos += 2;
+            so_far = Demangle_textNode(st, DEMANGLE_NODE_NAME, std_text, sizeof(std_text) - 1, 0);
+            continue;  // Not a candidate
+        }
+        if (c0 == 'S')
+        {
+            if (so_far)
+            {
+                return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Substitution inside a scope
+            }
+            so_far = Demangle_substitution(st);
+            if (!so_far)
+            {
+                return 0;  // Malformed substitution
+            }
+            continue;  // Already a candidate
+        }
+        if (c0 == 'T')
+        {
+            comp = Demangle_templateParam(st);
+        }
+        else if (c0 == 'D' && (c1 == 't' || c1 == 'T'))
+        {
+            int builtin;
+            comp = Demangle_dType(st, &builtin);
+        }
+        else if (c0 == 'C' || (c0 == 'D' && c1 != 'C'))
+        {
+            if (!so_far)
+            {
+                return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Constructor without a class
+            }
+            comp = Demangle_ctorDtorName(st, so_far, info);
+        }
+        else
+        {
+            comp = Demangle_unqualifiedName(st, info);
+        }
+        if (!comp)
+        {
+            return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Malformed component
+        }
+        so_far = so_far ? Demangle_node(st, DEMANGLE_NODE_NESTED, so_far, comp, 0) : comp;
+        Demangle_subAdd(st, so_far);
+    }
+    if (!so_far || s->sub_num == 0)
+    {
+        return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Empty name
+    }
+    s->sub_num--;  // The whole name is no candidate, only its prefixes
+    return so_far;
+}
+
+/**
+ * @brief Parses a <local-name> (Z <encoding> E <entity> [<discriminator>])
+ * @param[in,out] st Demangling state
+ * @param[in,out] info Facts about the enclosing encoding name, NULL outside one
+ * @return uint32_t Local name node, 0 on error
+ */
+static uint32_t Demangle_localName(demangle_state_t *st, demangle_name_info_t *info)
+{
+    st->pos++;
+    uint32_t enc = Demangle_encoding(st);
+    if (!enc || !Demangle_consume(st, 'E'))
+    {
+        return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Malformed encoding
+    }
+    if (Demangle_consume(st, 's'))
+    {
+        static const char literal_text[] = "string literal";
+        Demangle_discriminatorSkip(st);
+        uint32_t entity = Demangle_textNode(st, DEMANGLE_NODE_NAME, literal_text, sizeof(literal_text) - 1, 0);
+        return Demangle_node(st, DEMANGLE_NODE_LOCAL, enc, entity, 0);
+    }
+    if (Demangle_consume(st, 'd'))
+    {
+        uint64_t num = 0;
+        if (Demangle_look(st, 0) != '_' && Demangle_numberRead(st, &num))
+        {
+            return 0;  // Malformed parameter number
+        }
+        if (!Demangle_consume(st, '_'))
+        {
+            return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Unterminated
+        }
+        uint32_t entity = Demangle_name(st, info);
+        uint32_t arg = entity ? Demangle_node(st, DEMANGLE_NODE_DEFAULT_ARG, entity, (uint32_t)num + 1, 0) : 0;
+        return arg ? Demangle_node(st, DEMANGLE_NODE_LOCAL, enc, arg, 0) : 0;
+    }
+    uint32_t entity = Demangle_name(st, info);
+    if (!entity)
+    {
+        return 0;  // Malformed entity
+    }
+    Demangle_discriminatorSkip(st);
+    return Demangle_node(st, DEMANGLE_NODE_LOCAL, enc, entity, 0);
+}
+
+/**
+ * @brief Parses a <name>
+ * @param[in,out] st Demangling state
+ * @param[in,out] info Facts about the enclosing encoding name, NULL outside one
+ * @return uint32_t Name node, 0 on error
+ */
+static uint32_t Demangle_name(demangle_state_t *st, demangle_name_info_t *info)
+{
+    char c = Demangle_look(st, 0);
+    uint32_t id;
+    if (c == 'N')
+    {
+        return Demangle_nestedName(st, info);
+    }
+    if (c == 'Z')
+    {
+        return Demangle_localName(st, info);
+    }
+    if (c == 'S' && Demangle_look(st, 1) != 't')
+    {
+        id = Demangle_substitution(st);
+        if (!id || Demangle_look(st, 0) != 'I')
+        {
+            return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // A bare substitution is no name
+        }
+    }
+    else
+    {
+        int is_std = Demangle_consume2(st, 'S', 't');
+        Demangle_consume(st, 'L');
+        id = Demangle_unqualifiedName(st, info);
+        if (id && is_std)
+        {
+            static const char std_text[] = "std";
+            uint32_t std_id = Demangle_textNode(st, DEMANGLE_NODE_NAME, std_text, sizeof(std_text) - 1, 0);
+            id = Demangle_node(st, DEMANGLE_NODE_NESTED, std_id, id, 0);
+        }
+        if (!id || Demangle_look(st, 0) != 'I')
+        {
+            return id;
+        }
+        Demangle_subAdd(st, id);  // Unscoped template name
+    }
+    uint32_t args = Demangle_templateArgs(st, info != NULL);
+    if (info)
+    {
+        info->ends_targs = 1;
+    }
+    return args ? Demangle_node(st, DEMANGLE_NODE_TEMPLATE, id, args, 0) : 0;
+}
+
+/**
+ * @brief Parses a <call-offset> of a thunk (h <number> _ or v <number> _ <number> _)
+ * @param[in,out] st Demangling state
+ * @return int 0 on success, -1 on error (recorded in st)
+ */
+static int Demangle_callOffsetSkip(demangle_state_t *st)
+{
+    if (Demangle_consume(st, 'h'))
+    {
+        return (Demangle_numberSkip(st) || !Demangle_consume(st, '_')) ? (int)Demangle_fail(st, ELFPARSER_ERR_FORMAT) - 1 : 0;
+    }
+    if (Demangle_consume(st, 'v'))
+    {
+        if (Demangle_numberSkip(st) || !Demangle_consume(st, '_') || Demangle_numberSkip(st) || !Demangle_consume(st, '_'))
+        {
+            return (int)Demangle_fail(st, ELFPARSER_ERR_FORMAT) - 1;  // Malformed virtual offset
+        }
+        return 0;
+    }
+    return (int)Demangle_fail(st, ELFPARSER_ERR_FORMAT) - 1;  // Unknown offset kind
+}
+
+/**
+ * @brief Parses a <special-name> (virtual tables, type info, thunks, guard variables)
+ * @param[in,out] st Demangling state
+ * @return uint32_t Special name node, 0 on error
+ */
+static uint32_t Demangle_specialName(demangle_state_t *st)
+{
+    static const struct
+    {
+        char        prefix;     /* T or G */
+        char        code;       /* Letter after the prefix */
+        char        operand;    /* t type, n name, e encoding, a template argument */
+        const char* text;       /* Printed before the operand */
+    } specials[] =
+    {
+        { 'T', 'V', 't', "vtable for " }, { 'T', 'T', 't', "VTT for " }, { 'T', 'I', 't', "typeinfo for " },
+        { 'T', 'S', 't', "typeinfo name for " }, { 'T', 'h', 'e', "non-virtual thunk to " },
+        { 'T', 'v', 'e', "virtual thunk to " }, { 'T', 'c', 'e', "covariant return thunk to " },
+        { 'T', 'H', 'n', "TLS init function for " }, { 'T', 'W', 'n', "TLS wrapper function for " },
+        { 'T', 'A', 'a', "template parameter object for " }, { 'G', 'V', 'n', "guard variable for " },
+        { 'G', 'A', 'e', "hidden alias for " }
+    };
+    char prefix = Demangle_look(st, 0);
+    char code = Demangle_look(st, 1);
+
+    if (prefix == 'T' && code == 'C')
+    {
+        static const char text[] = "construction vtable for ";
+        st->pos += 2;
+        uint32_t derived = Demangle_type(st);
+        if (!derived || Demangle_numberSkip(st) || !Demangle_consume(st, '_'))
+        {
+            return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Malformed construction vtable
+        }
+        uint32_t base = Demangle_type(st);
+        uint32_t id = base ? Demangle_node(st, DEMANGLE_NODE_CTOR_VTABLE, base, derived, 0) : 0;
+        if (id)
+        {
+            st->s->nodes[id].str = text;
+            st->s->nodes[id].len = sizeof(text) - 1;
+        }
+        return id;
+    }
+    if (prefix == 'G' && code == 'R')
+    {
+        st->pos += 2;
+        uint32_t name = Demangle_name(st, NULL);
+        const char *num = st->pos;
+        uint64_t value;
+        if (!name || Demangle_numberRead(st, &value))
+        {
+            return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Malformed reference temporary
+        }
+        return Demangle_textNode(st, DEMANGLE_NODE_REFTEMP, num, (size_t)(st->pos - num), name);
+    }
+    if (prefix == 'G' && code == 'T')
+    {
+        static const char clone_text[] = "transaction clone for ";
+        static const char non_clone_text[] = "non-transaction clone for ";
+        char kind = Demangle_look(st, 2);
+        if (kind != 't' && kind != 'n')
+        {
+            return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Unknown clone kind
+        }
+        st->pos += 3;
+        uint32_t enc = Demangle_encoding(st);
+        return enc ? Demangle_textNode(st, DEMANGLE_NODE_SPECIAL, (kind == 't') ? clone_text : non_clone_text,
+                                       (kind == 't') ? sizeof(clone_text) - 1 : sizeof(non_clone_text) - 1, enc) : 0;
+    }
+    for (size_t i = 0; i < sizeof(specials) / sizeof(specials[0]); i++)
+    {
+        if (specials[i].prefix != prefix || specials[i].code != code)
+        {
+            continue;
+        }
+        uint32_t operand;
+        st->pos += 2;
+        if (code == 'h' || code == 'v')
+        {
+            st->pos--;  // The letter starts the call offset
+            if (Demangle_callOffsetSkip(st))
+            {
+                return 0;  // Malformed offset
+            }
+        }
+        else if (code == 'c' && (Demangle_callOffsetSkip(st) || Demangle_callOffsetSkip(st)))
+        {
+            return 0;  // Malformed offsets
+        }
+        switch (specials[i].operand)
+        {
+            case 't':
+                operand = Demangle_type(st);
+                break;
+            case 'n':
+                operand = Demangle_name(st, NULL);
+                break;
+            case 'a':
+                operand = Demangle_templateArg(st);
+                break;
+            default:
+                operand = Demangle_encoding(st);
+                break;
+        }
+        return operand ? Demangle_textNode(st, DEMANGLE_NODE_SPECIAL, specials[i].text, strlen(specials[i].text), operand) : 0;
+    }
+    return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Unknown special name
+}
+
+/**
+ * @brief Parses an <encoding> with its own template argument scope
+ * @param[in,out] st Demangling state
+ * @return uint32_t Encoding, name or special name node, 0 on error
+ */
+static uint32_t Demangle_encodingParse(demangle_state_t *st)
+{
+    demangle_scratch_t *s = st->s;
+    char c = Demangle_look(st, 0);
+    if (c == 'T' || c == 'G')
+    {
+        return Demangle_specialName(st);
+    }
+
+    uint32_t save_base = st->tparam_base;
+    uint32_t save_num = s->tparam_num;
+    uint32_t save_refs = st->ref_base;
+    st->tparam_base = s->tparam_num;
+    st->ref_base = s->ref_num;
+    demangle_name_info_t info = { 0, 0, 0, 0 };
+    uint32_t id = Demangle_name(st, &info);
+    c = Demangle_look(st, 0);
+    if (id && c != '\0' && c != 'E' && c != '.')  // A function, data names end here
+    {
+        uint32_t ret = 0;
+        if (info.ends_targs && !info.ctor_conv)
+        {
+            ret = Demangle_type(st);
+        }
+        uint32_t mark = s->stack_num;
+        c = Demangle_look(st, 1);
+        if (Demangle_look(st, 0) == 'v' && (c == '\0' || c == 'E' || c == '.'))
+        {
+            st->pos++;  // No parameters
+        }
+        else
+        {
+            while (st->err == ELFPARSER_SUCCESS && (c = Demangle_look(st, 0)) != '\0' && c != 'E' && c != '.')
+            {
+                uint32_t param = Demangle_type(st);
+                if (param)
+                {
+                    Demangle_push(st, &s->stack, &s->stack_num, &s->stack_cap, param);
+                }
+            }
+            if (s->stack_num == mark)
+            {
+                Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Return type without parameter types
+            }
+        }
+        uint32_t params = Demangle_listMake(st, mark);
+        uint32_t name = id;
+        id = Demangle_node(st, DEMANGLE_NODE_ENCODING, name, params, ret);
+        if (id)
+        {
+            s->nodes[id].flags = (uint8_t)(info.cv | (info.ref << DEMANGLE_REF_SHIFT));
+        }
+    }
+    else if (id && (info.cv || info.ref))  // Qualified member name without a type, kept as c++filt prints it
+    {
+        static const char lref_text[] = " &";
+        static const char rref_text[] = " &&";
+        if (info.cv)
+        {
+            id = Demangle_node(st, DEMANGLE_NODE_QUAL, id, 0, 0);
+            if (id)
+            {
+                s->nodes[id].flags = (uint8_t)info.cv;
+            }
+        }
+        if (id && info.ref)
+        {
+            id = Demangle_textNode(st, DEMANGLE_NODE_SUFFIX, (info.ref == 1) ? lref_text : rref_text,
+                                   (info.ref == 1) ? sizeof(lref_text) - 1 : sizeof(rref_text) - 1, id);
+        }
+    }
+    Demangle_refsBind(st);
+    s->tparam_num = save_num;
+    st->tparam_base = save_base;
+    s->ref_num = st->ref_base;
+    st->ref_base = save_refs;
+    return (st->err == ELFPARSER_SUCCESS) ? id : 0;
+}
+
+/**
+ * @brief Parses an <encoding>, bounding the recursion depth
+ * @param[in,out] st Demangling state
+ * @return uint32_t Encoding, name or special name node, 0 on error
+ */
+static uint32_t Demangle_encoding(demangle_state_t *st)
+{
+    if (st->err != ELFPARSER_SUCCESS || ++st->depth > DEMANGLE_DEPTH_MAX)
+    {
+        st->depth -= (st->err == ELFPARSER_SUCCESS);
+        return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Too deep
+    }
+    uint32_t id = Demangle_encodingParse(st);
+    st->depth--;
+    return id;
+}
+
+/**
+ * @brief Parses a <simple-id> (<source-name> [<template-args>])
+ * @param[in,out] st Demangling state
+ * @return uint32_t Name node, 0 on error
+ */
+static uint32_t Demangle_simpleId(demangle_state_t *st)
+{
+    uint32_t id = Demangle_sourceName(st);
+    if (id && Demangle_look(st, 0) == 'I')
+    {
+        uint32_t args = Demangle_templateArgs(st, 0);
+        id = args ? Demangle_node(st, DEMANGLE_NODE_TEMPLATE, id, args, 0) : 0;
+    }
+    return id;
+}
+
+/**
+ * @brief Parses an <unresolved-type> (template parameter, decltype or substitution)
+ * @param[in,out] st Demangling state
+ * @return uint32_t Type node, 0 on error
+ */
+static uint32_t Demangle_unresolvedType(demangle_state_t *st)
+{
+    char c = Demangle_look(st, 0);
+    if (c == 'T')
+    {
+        uint32_t id = Demangle_templateParam(st);
+        Demangle_subAdd(st, id);
+        return id;
+    }
+    if (c == 'D')
+    {
+        return Demangle_type(st);
+    }
+    return Demangle_substitution(st);
+}
+
+/**
+ * @brief Parses a <base-unresolved-name>
+ * @param[in,out] st Demangling state
+ * @return uint32_t Name node, 0 on error
+ */
+static uint32_t Demangle_baseUnresolvedName(demangle_state_t *st)
+{
+    if (Demangle_isDigit(Demangle_look(st, 0)))
+    {
+        return Demangle_simpleId(st);
+    }
+    if (Demangle_consume2(st, 'd', 'n'))
+    {
+        static const char tilde[] = "~";
+        uint32_t type = Demangle_isDigit(Demangle_look(st, 0)) ? Demangle_simpleId(st) : Demangle_unresolvedType(st);
+        uint32_t id = type ? Demangle_textNode(st, DEMANGLE_NODE_PREFIX, tilde, sizeof(tilde) - 1, type) : 0;
+        if (id)
+        {
+            st->s->nodes[id].flags = DEMANGLE_PREFIX_GLOBAL;
+        }
+        return id;
+    }
+    Demangle_consume2(st, 'o', 'n');
+    uint32_t id = Demangle_operatorName(st, NULL);
+    if (id && Demangle_look(st, 0) == 'I')
+    {
+        uint32_t args = Demangle_templateArgs(st, 0);
+        id = args ? Demangle_node(st, DEMANGLE_NODE_TEMPLATE, id, args, 0) : 0;
+    }
+    return id;
+}
+
+/**
+ * @brief Parses an <unresolved-qualifier-level> and adds it to the names it qualifies
+ *
+ * Like the levels of a nested name, the name up to each level is a substitution
+ * candidate, and so is a level's name before its template arguments.
+ *
+ * @param[in,out] st Demangling state
+ * @param[in] so_far Qualifying name, 0 for the first level
+ * @return uint32_t Qualified name node, 0 on error
+ */
+static uint32_t Demangle_qualifierLevel(demangle_state_t *st, uint32_t so_far)
+{
+    uint32_t id = Demangle_sourceName(st);
+    if (id && so_far)
+    {
+        id = Demangle_node(st, DEMANGLE_NODE_NESTED, so_far, id, 0);
+    }
+    if (id && Demangle_look(st, 0) == 'I')
+    {
+        Demangle_subAdd(st, id);  // <template-prefix>
+        uint32_t args = Demangle_templateArgs(st, 0);
+        id = args ? Demangle_node(st, DEMANGLE_NODE_TEMPLATE, id, args, 0) : 0;
+    }
+    Demangle_subAdd(st, id);
+    return id;
+}
+
+/**
+ * @brief Parses an <unresolved-name> (names in expressions of dependent types)
+ * @param[in,out] st Demangling state
+ * @return uint32_t Name node, 0 on error
+ */
+static uint32_t Demangle_unresolvedName(demangle_state_t *st)
+{
+    int global = Demangle_consume2(st, 'g', 's');
+    uint32_t id;
+    if (!Demangle_consume2(st, 's', 'r'))
+    {
+        id = Demangle_baseUnresolvedName(st);
+    }
+    else
+    {
+        uint32_t so_far = 0;
+        if (Demangle_consume(st, 'N'))
+        {
+            if (Demangle_isDigit(Demangle_look(st, 0)))
+            {
+                so_far = Demangle_qualifierLevel(st, 0);  // Plain nested name, as older GCC emits and c++filt accepts
+            }
+            else
+            {
+                so_far = Demangle_unresolvedType(st);
+                if (so_far && Demangle_look(st, 0) == 'I')
+                {
+                    uint32_t args = Demangle_templateArgs(st, 0);
+                    so_far = args ? Demangle_node(st, DEMANGLE_NODE_TEMPLATE, so_far, args, 0) : 0;
+                }
+            }
+            while (so_far && !Demangle_consume(st, 'E'))
+            {
+                so_far = Demangle_qualifierLevel(st, so_far);
+            }
+        }
+        else if (Demangle_isDigit(Demangle_look(st, 0)))
+        {
+            do
+            {
+                uint32_t level = Demangle_simpleId(st);
+                so_far = !level ? 0 : so_far ? Demangle_node(st, DEMANGLE_NODE_NESTED, so_far, level, 0) : level;
+            }
+            while (so_far && !Demangle_consume(st, 'E'));
+        }
+        else
+        {
+            so_far = Demangle_unresolvedType(st);
+            if (so_far && Demangle_look(st, 0) == 'I')
+            {
+                uint32_t args = Demangle_templateArgs(st, 0);
+                so_far = args ? Demangle_node(st, DEMANGLE_NODE_TEMPLATE, so_far, args, 0) : 0;
+            }
+        }
+        uint32_t base = so_far ? Demangle_baseUnresolvedName(st) : 0;
+        if (base && st->s->nodes[base].kind == DEMANGLE_NODE_TEMPLATE)  // Arguments apply to the qualified name
+        {
+            uint32_t qual = Demangle_node(st, DEMANGLE_NODE_NESTED, so_far, st->s->nodes[base].a, 0);
+            id = qual ? Demangle_node(st, DEMANGLE_NODE_TEMPLATE, qual, st->s->nodes[base].b, 0) : 0;
+        }
+        else
+        {
+            id = base ? Demangle_node(st, DEMANGLE_NODE_NESTED, so_far, base, 0) : 0;
+        }
+    }
+    if (id && global)
+    {
+        static const char scope[] = "::";
+        id = Demangle_textNode(st, DEMANGLE_NODE_PREFIX, scope, sizeof(scope) - 1, id);
+        if (id)
+        {
+            st->s->nodes[id].flags = DEMANGLE_PREFIX_GLOBAL;
+        }
+    }
+    return id ? id : Demangle_fail(st, ELFPARSER_ERR_FORMAT);
+}
+
+/**
+ * @brief Parses expressions up to a terminator into a list
+ * @param[in,out] st Demangling state
+ * @param[in] terminator Character ending the list
+ * @return uint32_t List node, 0 on error
+ */
+static uint32_t Demangle_exprList(demangle_state_t *st, char terminator)
+{
+    demangle_scratch_t *s = st->s;
+    uint32_t mark = s->stack_num;
+    while (!Demangle_consume(st, terminator))
+    {
+        uint32_t expr = Demangle_expr(st);
+        if (!expr || Demangle_push(st, &s->stack, &s->stack_num, &s->stack_cap, expr))
+        {
+            return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Malformed expression
+        }
+    }
+    return Demangle_listMake(st, mark);
+}
+
+/**
+ * @brief Parses a function parameter reference (fp ...)
+ * @param[in,out] st Demangling state
+ * @return uint32_t Parameter node, 0 on error
+ */
+static uint32_t Demangle_functionParam(demangle_state_t *st)
+{
+    uint64_t idx;
+    if (!Demangle_consume2(st, 'f', 'p'))  // Parameters of enclosing lambdas (fL) are rejected, as by c++filt
+    {
+        return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Not a parameter
+    }
+    Demangle_cvRead(st);
+    if (Demangle_consume(st, 'T'))
+    {
+        uint32_t id = Demangle_node(st, DEMANGLE_NODE_PARM, 0, 0, 0);
+        if (id)
+        {
+            st->s->nodes[id].flags = DEMANGLE_PARM_THIS;
+        }
+        return id;
+    }
+    if (Demangle_indexRead(st, &idx))
+    {
+        return 0;  // Malformed index
+    }
+    return Demangle_node(st, DEMANGLE_NODE_PARM, 0, (uint32_t)idx + 1, 0);
+}
+
+/**
+ * @brief Parses an <expression>
+ * @param[in,out] st Demangling state
+ * @return uint32_t Expression node, 0 on error
+ */
+static uint32_t Demangle_exprParse(demangle_state_t *st)
+{
+    demangle_scratch_t *s = st->s;
+    char c0 = Demangle_look(st, 0);
+    char c1 = Demangle_look(st, 1);
+    uint32_t a = 0;  // Node 0 is no node
+    uint32_t b = 0;
+
+    switch (c0)
+    {
+        case 'L':
+            return Demangle_exprPrimary(st);
+        case 'T':
+            return Demangle_templateParam(st);
+        case 'f':
+            if (c1 == 'p')
+            {
+                return Demangle_functionParam(st);
+            }
+            if (c1 == 'l' || c1 == 'r' || c1 == 'L' || c1 == 'R')
+            {
+                st->pos += 2;
+                const demangle_op_t *op = Demangle_opFind(Demangle_look(st, 0), Demangle_look(st, 1));
+                if (!op)
+                {
+                    return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Unknown fold operator
+                }
+                st->pos += 2;
+                a = Demangle_expr(st);
+                b = (a && (c1 == 'L' || c1 == 'R')) ? Demangle_expr(st) : 0;
+                uint32_t id = a ? Demangle_textNode(st, DEMANGLE_NODE_FOLD, op->name, strlen(op->name), a) : 0;
+                if (id)
+                {
+                    s->nodes[id].b = b;
+                    s->nodes[id].flags = (uint8_t)c1;
+                }
+                return (st->err == ELFPARSER_SUCCESS) ? id : 0;
+            }
+            break;
+        case 's':
+            if (c1 == 'r')
+            {
+                return Demangle_unresolvedName(st);
+            }
+            if (c1 == 'p')
+            {
+                st->pos += 2;
+                a = Demangle_expr(st);
+                return a ? Demangle_node(st, DEMANGLE_NODE_EXPANSION, a, 0, 0) : 0;
+            }
+            if (c1 == 'Z')
+            {
+                st->pos += 2;
+                a = (Demangle_look(st, 0) == 'T') ? Demangle_templateParam(st) : Demangle_functionParam(st);
+                return a ? Demangle_node(st, DEMANGLE_NODE_SIZEOF_PACK, a, 0, 0) : 0;
+            }
+            if (c1 == 'P')
+            {
+                uint32_t mark = s->stack_num;
+                st->pos += 2;
+                while (!Demangle_consume(st, 'E'))
+                {
+                    a = Demangle_templateArg(st);
+                    if (!a || Demangle_push(st, &s->stack, &s->stack_num, &s->stack_cap, a))
+                    {
+                        return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Malformed pack
+                    }
+                }
+                a = Demangle_node(st, DEMANGLE_NODE_ARG_PACK, Demangle_listMake(st, mark), 0, 0);
+                return a ? Demangle_node(st, DEMANGLE_NODE_SIZEOF_PACK, a, 0, 0) : 0;
+            }
+            break;
+        case 'c':
+            if (c1 == 'l')
+            {
+                st->pos += 2;
+                a = Demangle_expr(st);
+                b = a ? Demangle_exprList(st, 'E') : 0;
+                return b ? Demangle_node(st, DEMANGLE_NODE_CALL, a, b, 0) : 0;
+            }
+            if (c1 == 'v')
+            {
+                st->pos += 2;
+                a = Demangle_type(st);
+                if (!a)
+                {
+                    return 0;  // Malformed type
+                }
+                if (Demangle_consume(st, '_'))
+                {
+                    b = Demangle_exprList(st, 'E');
+                    uint32_t id = b ? Demangle_node(st, DEMANGLE_NODE_CAST, a, b, 0) : 0;
+                    if (id)
+                    {
+                        s->nodes[id].flags = DEMANGLE_CAST_LIST;
+                    }
+                    return id;
+                }
+                b = Demangle_expr(st);
+                return b ? Demangle_node(st, DEMANGLE_NODE_CAST, a, b, 0) : 0;
+            }
+            break;
+        case 'd':
+            if (c1 == 'n')
+            {
+                return Demangle_unresolvedName(st);
+            }
+            break;
+        case 'g':
+            if (c1 == 's')
+            {
+                char c2 = Demangle_look(st, 2);
+                char c3 = Demangle_look(st, 3);
+                if (c2 == 'd' && (c3 == 'l' || c3 == 'a'))
+                {
+                    static const char delete_text[] = "::delete ";
+                    static const char delete_array_text[] = "::delete[] ";
+                    st->pos += 4;
+                    a = Demangle_expr(st);
+                    return a ? Demangle_textNode(st, DEMANGLE_NODE_PREFIX, (c3 == 'l') ? delete_text : delete_array_text,
+                                                 (c3 == 'l') ? sizeof(delete_text) - 1 : sizeof(delete_array_text) - 1, a) : 0;
+                }
+                return Demangle_unresolvedName(st);
+            }
+            break;
+        case 'i':
+            if (c1 == 'l')
+            {
+                st->pos += 2;
+                b = Demangle_exprList(st, 'E');
+                return b ? Demangle_node(st, DEMANGLE_NODE_INIT_LIST, 0, b, 0) : 0;
+            }
+            break;
+        case 't':
+            if (c1 == 'l')
+            {
+                st->pos += 2;
+                a = Demangle_type(st);
+                b = a ? Demangle_exprList(st, 'E') : 0;
+                return b ? Demangle_node(st, DEMANGLE_NODE_INIT_LIST, a, b, 0) : 0;
+            }
+            if (c1 == 'r')
+            {
+                static const char throw_text[] = "throw";
+                st->pos += 2;
+                return Demangle_textNode(st, DEMANGLE_NODE_NAME, throw_text, sizeof(throw_text) - 1, 0);
+            }
+            break;
+        case 'D':
+            if (c1 == 't' || c1 == 'T')
+            {
+                return Demangle_type(st);
+            }
+            break;
+        case 'o':
+            if (c1 == 'n')
+            {
+                return Demangle_unresolvedName(st);
+            }
+            break;
+        default:
+            if (Demangle_isDigit(c0))
+            {
+                return Demangle_unresolvedName(st);
+            }
+            break;
+    }
+
+    const demangle_op_t *op = Demangle_opFind(c0, c1);
+    if (!op)
+    {
+        return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Unknown or unsupported expression
+    }
+    st->pos += 2;
+    uint32_t id = 0;
+    switch (op->kind)
+    {
+        case DEMANGLE_OP_PREFIX:
+        case DEMANGLE_OP_DELETE:
+            a = Demangle_expr(st);
+            id = a ? Demangle_textNode(st, DEMANGLE_NODE_PREFIX, op->name, strlen(op->name), a) : 0;
+            break;
+        case DEMANGLE_OP_INCDEC:
+        {
+            int prefix = Demangle_consume(st, '_');
+            a = Demangle_expr(st);
+            id = a ? Demangle_textNode(st, prefix ? DEMANGLE_NODE_PREFIX : DEMANGLE_NODE_POSTFIX, op->name, strlen(op->name), a) : 0;
+            break;
+        }
+        case DEMANGLE_OP_BINARY:
+        case DEMANGLE_OP_MEMBER:
+            a = Demangle_expr(st);
+            b = a ? Demangle_expr(st) : 0;
+            id = b ? Demangle_textNode(st, DEMANGLE_NODE_BINARY, op->name, strlen(op->name), a) : 0;
+            break;
+        case DEMANGLE_OP_INDEX:
+            a = Demangle_expr(st);
+            b = a ? Demangle_expr(st) : 0;
+            id = b ? Demangle_node(st, DEMANGLE_NODE_INDEX, a, b, 0) : 0;
+            break;
+        case DEMANGLE_OP_TERNARY:
+        {
+            a = Demangle_expr(st);
+            b = a ? Demangle_expr(st) : 0;
+            uint32_t c = b ? Demangle_expr(st) : 0;
+            id = c ? Demangle_node(st, DEMANGLE_NODE_TERNARY, a, b, c) : 0;
+            break;
+        }
+        case DEMANGLE_OP_NAMED_CAST:
+            a = Demangle_type(st);
+            b = a ? Demangle_expr(st) : 0;
+            id = b ? Demangle_textNode(st, DEMANGLE_NODE_NAMED_CAST, op->name, strlen(op->name), a) : 0;
+            break;
+        case DEMANGLE_OP_OF_TYPE:
+            a = Demangle_type(st);
+            id = a ? Demangle_textNode(st, DEMANGLE_NODE_ENCLOSE, op->name, strlen(op->name), a) : 0;
+            break;
+        default:
+            return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // new and friends are not supported
+    }
+    if (id && (op->kind == DEMANGLE_OP_BINARY || op->kind == DEMANGLE_OP_MEMBER || op->kind == DEMANGLE_OP_NAMED_CAST))
+    {
+        s->nodes[id].b = b;
+    }
+    return id ? id : Demangle_fail(st, ELFPARSER_ERR_FORMAT);
+}
+
+/**
+ * @brief Parses an <expression>, bounding the recursion depth
+ * @param[in,out] st Demangling state
+ * @return uint32_t Expression node, 0 on error
+ */
+static uint32_t Demangle_expr(demangle_state_t *st)
+{
+    if (st->err != ELFPARSER_SUCCESS || ++st->depth > DEMANGLE_DEPTH_MAX)
+    {
+        st->depth -= (st->err == ELFPARSER_SUCCESS);
+        return Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Too deep
+    }
+    uint32_t id = Demangle_exprParse(st);
+    st->depth--;
+    return id;
+}
+
+/**
+ * @brief Appends text to the output
+ * @param[in,out] st Demangling state
+ * @param[in] str Text
+ * @param[in] len Length of str
+ */
+static void Demangle_out(demangle_state_t *st, const char *str, size_t len)
+{
+    demangle_scratch_t *s = st->s;
+    if (st->err != ELFPARSER_SUCCESS)
+    {
+        return;
+    }
+    if (s->out_len + len + 1 > s->out_cap)
+    {
+        if (s->out_len + len + 1 > DEMANGLE_OUT_MAX)
+        {
+            Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Absurdly long result
+            return;
+        }
+        size_t new_cap = s->out_cap ? s->out_cap * 2 : DEMANGLE_OUT_INITIAL;
+        new_cap = (new_cap < s->out_len + len + 1) ? s->out_len + len + 1 : new_cap;
+        char *grown = realloc(s->out, new_cap);
+        if (!grown)
+        {
+            Demangle_fail(st, ELFPARSER_ERR_MALLOC);
+            return;
+        }
+        s->out = grown;
+        s->out_cap = new_cap;
+    }
+    memcpy(s->out + s->out_len, str, len);
+    s->out_len += len;
+}
+
+/**
+ * @brief Appends a null-terminated string to the output
+ * @param[in,out] st Demangling state
+ * @param[in] str Text
+ */
+static void Demangle_outStr(demangle_state_t *st, const char *str)
+{
+    Demangle_out(st, str, strlen(str));
+}
+
+/**
+ * @brief Appends a decimal number to the output
+ * @param[in,out] st Demangling state
+ * @param[in] value Number
+ */
+static void Demangle_outNum(demangle_state_t *st, uint32_t value)
+{
+    char digits[10];
+    size_t pos = sizeof(digits);
+    do
+    {
+        digits[--pos] = (char)('0' + value % 10u);
+        value /= 10u;
+    }
+    while (value);
+    Demangle_out(st, &digits[pos], sizeof(digits) - pos);
+}
+
+/**
+ * @brief Returns the last character written
+ * @param[in] st Demangling state
+ * @return char The character, '\0' if nothing was written
+ */
+static inline char Demangle_last(const demangle_state_t *st)
+{
+    if (st->s->out_len == st->blank_at)
+    {
+        return ' ';  // As c++filt, which keeps the separator as last character
+    }
+    return st->s->out_len ? st->s->out[st->s->out_len - 1] : '\0';
+}
+
+/**
+ * @brief Appends cv qualifiers to the output (" const volatile restrict" order)
+ * @param[in,out] st Demangling state
+ * @param[in] cv DEMANGLE_CV_* flags
+ */
+static void Demangle_cvPrint(demangle_state_t *st, uint8_t cv)
+{
+    if (cv & DEMANGLE_CV_CONST)
+    {
+        Demangle_outStr(st, " const");
+    }
+    if (cv & DEMANGLE_CV_VOLATILE)
+    {
+        Demangle_outStr(st, " volatile");
+    }
+    if (cv & DEMANGLE_CV_RESTRICT)
+    {
+        Demangle_outStr(st, " restrict");
+    }
+}
+
+/**
+ * @brief Returns the element of a parameter pack for the current expansion step
+ *
+ * The first pack met while printing the pattern of an expansion decides how
+ * many times the pattern is printed.
+ *
+ * @param[in,out] st Demangling state
+ * @param[in] node Parameter pack node
+ * @return uint32_t The element, 0 outside an expansion or past the end of the pack
+ */
+static uint32_t Demangle_packElem(demangle_state_t *st, const demangle_node_t *node)
+{
+    const demangle_node_t *list = &st->s->nodes[node->a];
+    if (st->pack_idx == DEMANGLE_PACK_NONE)
+    {
+        return 0;  // Not expanding, the pack is printed whole
+    }
+    if (st->pack_max == DEMANGLE_PACK_NONE)
+    {
+        st->pack_max = list->b;
+    }
+    return (st->pack_idx < list->b) ? st->s->lists[list->a + st->pack_idx] : 0;
+}
+
+/**
+ * @brief Looks through template parameters and packs to the node they stand for
+ * @param[in,out] st Demangling state
+ * @param[in] id Node
+ * @return uint32_t The node printed in place of id, 0 if there is none
+ */
+static uint32_t Demangle_resolve(demangle_state_t *st, uint32_t id)
+{
+    for (uint32_t step = 0; id && step < DEMANGLE_DEPTH_MAX; step++)
+    {
+        const demangle_node_t *node = &st->s->nodes[id];
+        if (node->kind == DEMANGLE_NODE_TPARAM)
+        {
+            if ((node->flags & DEMANGLE_TPARAM_LAMBDA) && (st->lambda_print || !node->a))
+            {
+                return id;  // Printed as auto:N
+            }
+            id = node->a;
+        }
+        else if (node->kind == DEMANGLE_NODE_PARAM_PACK)
+        {
+            uint32_t elem = Demangle_packElem(st, node);
+            if (!elem)
+            {
+                return id;  // Whole or empty pack
+            }
+            id = elem;
+        }
+        else
+        {
+            return id;
+        }
+    }
+    return id;
+}
+
+/**
+ * @brief Tells whether a type is printed with a part after the declarator (arrays and functions)
+ * @param[in] st Demangling state
+ * @param[in] id Type node
+ * @param[in] through_pointers Non-zero to look through pointers and references as well
+ * @return int 1 for an array, 2 for a function, 0 otherwise
+ */
+static int Demangle_rhsKind(demangle_state_t *st, uint32_t id, int through_pointers)
+{
+    for (uint32_t step = 0; step < DEMANGLE_DEPTH_MAX; step++)
+    {
+        id = Demangle_resolve(st, id);
+        if (!id)
+        {
+            return 0;
+        }
+        const demangle_node_t *node = &st->s->nodes[id];
+        switch (node->kind)
+        {
+            case DEMANGLE_NODE_ARRAY:
+                return 1;
+            case DEMANGLE_NODE_FUNC_TYPE:
+                return 2;
+            case DEMANGLE_NODE_QUAL:
+            case DEMANGLE_NODE_SUFFIX:
+                id = node->a;
+                break;
+            case DEMANGLE_NODE_POINTER:
+            case DEMANGLE_NODE_LREF:
+            case DEMANGLE_NODE_RREF:
+                if (!through_pointers)
+                {
+                    return 0;
+                }
+                id = node->a;
+                break;
+            case DEMANGLE_NODE_PTRMEM:
+                if (!through_pointers)
+                {
+                    return 0;
+                }
+                id = node->b;
+                break;
+            default:
+                return 0;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Prints the elements of a list separated by commas, dropping the separator of empty ones
+ * @param[in,out] st Demangling state
+ * @param[in] list List node
+ */
+static void Demangle_printList(demangle_state_t *st, uint32_t list)
+{
+    const demangle_node_t *node = &st->s->nodes[list];
+    int first = 1;
+    for (uint32_t i = 0; i < node->b && st->err == ELFPARSER_SUCCESS; i++)
+    {
+        size_t before = st->s->out_len;
+        if (!first)
+        {
+            Demangle_outStr(st, ", ");
+        }
+        size_t mark = st->s->out_len;
+        Demangle_print(st, st->s->lists[node->a + i]);
+        if (st->s->out_len == mark)
+        {
+            st->s->out_len = before;  // Empty pack expansion
+            st->blank_at = first ? SIZE_MAX : before;
+        }
+        else
+        {
+            first = 0;
+        }
+    }
+}
+
+/**
+ * @brief Prints the class name a constructor or destructor is named after
+ * @param[in,out] st Demangling state
+ * @param[in] id Class node
+ */
+static void Demangle_printBaseName(demangle_state_t *st, uint32_t id)
+{
+    for (uint32_t step = 0; id && step < DEMANGLE_DEPTH_MAX; step++)
+    {
+        const demangle_node_t *node = &st->s->nodes[Demangle_resolve(st, id)];
+        switch (node->kind)
+        {
+            case DEMANGLE_NODE_NESTED:
+                id = node->b;
+                break;
+            case DEMANGLE_NODE_TEMPLATE:
+            case DEMANGLE_NODE_ABI_TAG:
+                id = node->a;
+                break;
+            case DEMANGLE_NODE_SPECIAL_SUB:
+                Demangle_out(st, node->str + 5, node->c);  // Past "std::"
+                return;
+            default:
+                Demangle_print(st, Demangle_resolve(st, id));
+                return;
+        }
+    }
+}
+
+/**
+ * @brief Prints an operand of an expression, in parentheses unless it is a plain name
+ * @param[in,out] st Demangling state
+ * @param[in] id Expression node
+ */
+static void Demangle_printSubexpr(demangle_state_t *st, uint32_t id)
+{
+    uint8_t kind = st->s->nodes[id].kind;
+    int simple = (kind == DEMANGLE_NODE_NAME || kind == DEMANGLE_NODE_NESTED || kind == DEMANGLE_NODE_INIT_LIST ||
+                  kind == DEMANGLE_NODE_PARM);
+    if (!simple)
+    {
+        Demangle_outStr(st, "(");
+    }
+    Demangle_print(st, id);
+    if (!simple)
+    {
+        Demangle_outStr(st, ")");
+    }
+}
+
+/**
+ * @brief Prints a literal the way c++filt does (5u, true, (char)97)
+ * @param[in,out] st Demangling state
+ * @param[in] node Literal node
+ */
+static void Demangle_printLiteral(demangle_state_t *st, const demangle_node_t *node)
+{
+    const demangle_node_t *type = &st->s->nodes[node->a];
+    int neg = (node->flags & DEMANGLE_LITERAL_NEG) != 0;
+    char code = (type->kind == DEMANGLE_NODE_BUILTIN) ? (char)type->flags : '\0';
+    const char *suffix = NULL;
+    switch (code)
+    {
+        case 'i': suffix = "";    break;
+        case 'j': suffix = "u";   break;
+        case 'l': suffix = "l";   break;
+        case 'm': suffix = "ul";  break;
+        case 'x': suffix = "ll";  break;
+        case 'y': suffix = "ull"; break;
+        case 'b':
+            if (node->len == 1 && !neg && (node->str[0] == '0' || node->str[0] == '1'))
+            {
+                Demangle_outStr(st, (node->str[0] == '1') ? "true" : "false");
+                return;
+            }
+            break;
+        default:
+            break;
+    }
+    if (suffix && node->len)
+    {
+        Demangle_outStr(st, neg ? "-" : "");
+        Demangle_out(st, node->str, node->len);
+        Demangle_outStr(st, suffix);
+        return;
+    }
+    int is_float = (code == 'f' || code == 'd' || code == 'e' || code == 'g');
+    Demangle_outStr(st, "(");
+    Demangle_print(st, node->a);
+    Demangle_outStr(st, ")");
+    Demangle_outStr(st, neg ? "-" : "");
+    Demangle_outStr(st, is_float ? "[" : "");
+    Demangle_out(st, node->str, node->len);
+    Demangle_outStr(st, is_float ? "]" : "");
+}
+
+/**
+ * @brief Prints a pack expansion once per element of the pack it refers to
+ * @param[in,out] st Demangling state
+ * @param[in] pattern Expanded node
+ */
+static void Demangle_printExpansion(demangle_state_t *st, uint32_t pattern)
+{
+    uint32_t save_idx = st->pack_idx;
+    uint32_t save_max = st->pack_max;
+    size_t start = st->s->out_len;
+    st->pack_idx = 0;
+    st->pack_max = DEMANGLE_PACK_NONE;
+    Demangle_print(st, pattern);  // The first pack met sets pack_max and prints its first element
+    if (st->pack_max == DEMANGLE_PACK_NONE)
+    {
+        st->s->out_len = start;  // No pack, a function parameter pack
+        Demangle_printSubexpr(st, pattern);
+        Demangle_outStr(st, "...");
+    }
+    else if (st->pack_max == 0)
+    {
+        st->s->out_len = start;  // Empty pack
+    }
+    else
+    {
+        for (uint32_t i = 1; i < st->pack_max && st->err == ELFPARSER_SUCCESS; i++)
+        {
+            Demangle_outStr(st, ", ");
+            st->pack_idx = i;
+            Demangle_print(st, pattern);
+        }
+    }
+    st->pack_idx = save_idx;
+    st->pack_max = save_max;
+}
+
+/**
+ * @brief Prints an encoding, optionally without its return type (local names)
+ * @param[in,out] st Demangling state
+ * @param[in] id Encoding node
+ * @param[in] with_ret Non-zero to print the return type
+ */
+static void Demangle_printEncoding(demangle_state_t *st, uint32_t id, int with_ret)
+{
+    const demangle_node_t *node = &st->s->nodes[id];
+    uint32_t ret = with_ret ? node->c : 0;
+    if (ret)
+    {
+        Demangle_printLeft(st, ret);
+        if (!Demangle_rhsKind(st, ret, 1))
+        {
+            Demangle_outStr(st, " ");
+        }
+    }
+    Demangle_print(st, node->a);
+    Demangle_outStr(st, "(");
+    Demangle_printList(st, node->b);
+    Demangle_outStr(st, ")");
+    if (ret)
+    {
+        Demangle_printRight(st, ret);
+    }
+    Demangle_cvPrint(st, node->flags & DEMANGLE_CV_MASK);
+    uint8_t ref = (uint8_t)(node->flags >> DEMANGLE_REF_SHIFT);
+    Demangle_outStr(st, (ref == 1) ? " &" : (ref == 2) ? " &&" : "");
+}
+
+/**
+ * @brief Prints the part of a pointer, reference or pointer to member before the declarator
+ * @param[in,out] st Demangling state
+ * @param[in] node Pointer-like node
+ */
+static void Demangle_printPointerLeft(demangle_state_t *st, const demangle_node_t *node)
+{
+    uint8_t kind = node->kind;
+    uint32_t inner = node->a;
+    if (kind == DEMANGLE_NODE_PTRMEM)
+    {
+        inner = node->b;
+    }
+    else if (kind != DEMANGLE_NODE_POINTER)
+    {
+        for (uint32_t step = 0; step < DEMANGLE_DEPTH_MAX; step++)  // Reference collapsing: & wins over &&
+        {
+            const demangle_node_t *target = &st->s->nodes[Demangle_resolve(st, inner)];
+            if (target->kind != DEMANGLE_NODE_LREF && target->kind != DEMANGLE_NODE_RREF)
+            {
+                break;
+            }
+            kind = (target->kind == DEMANGLE_NODE_LREF) ? DEMANGLE_NODE_LREF : kind;
+            inner = target->a;
+        }
+    }
+    Demangle_printLeft(st, inner);
+    int rhs = Demangle_rhsKind(st, inner, 0);
+    if (kind == DEMANGLE_NODE_PTRMEM)
+    {
+        Demangle_outStr(st, rhs ? "(" : " ");
+        Demangle_print(st, node->a);
+        Demangle_outStr(st, "::*");
+        return;
+    }
+    Demangle_outStr(st, (rhs == 1) ? " (" : (rhs == 2) ? "(" : "");
+    Demangle_outStr(st, (kind == DEMANGLE_NODE_POINTER) ? "*" : (kind == DEMANGLE_NODE_LREF) ? "&" : "&&");
+}
+
+/**
+ * @brief Prints the part of a pointer, reference or pointer to member after the declarator
+ * @param[in,out] st Demangling state
+ * @param[in] node Pointer-like node
+ */
+static void Demangle_printPointerRight(demangle_state_t *st, const demangle_node_t *node)
+{
+    uint32_t inner = (node->kind == DEMANGLE_NODE_PTRMEM) ? node->b : node->a;
+    if (node->kind == DEMANGLE_NODE_LREF || node->kind == DEMANGLE_NODE_RREF)
+    {
+        for (uint32_t step = 0; step < DEMANGLE_DEPTH_MAX; step++)
+        {
+            const demangle_node_t *target = &st->s->nodes[Demangle_resolve(st, inner)];
+            if (target->kind != DEMANGLE_NODE_LREF && target->kind != DEMANGLE_NODE_RREF)
+            {
+                break;
+            }
+            inner = target->a;
+        }
+    }
+    if (Demangle_rhsKind(st, inner, 0))
+    {
+        Demangle_outStr(st, ")");
+    }
+    Demangle_printRight(st, inner);
+}
+
+/**
+ * @brief Prints the part of an expression node (expressions have no right part)
+ * @param[in,out] st Demangling state
+ * @param[in] node Expression node
+ */
+static void Demangle_printExpr(demangle_state_t *st, const demangle_node_t *node)
+{
+    switch (node->kind)
+    {
+        case DEMANGLE_NODE_LITERAL:
+            Demangle_printLiteral(st, node);
+            break;
+        case DEMANGLE_NODE_PARM:
+            if (node->flags & DEMANGLE_PARM_THIS)
+            {
+                Demangle_outStr(st, "this");
+                break;
+            }
+            Demangle_outStr(st, "{parm#");
+            Demangle_outNum(st, node->b);
+            Demangle_outStr(st, "}");
+            break;
+        case DEMANGLE_NODE_PREFIX:
+        {
+            Demangle_out(st, node->str, node->len);
+            if (node->flags & DEMANGLE_PREFIX_GLOBAL)
+            {
+                Demangle_print(st, node->a);
+            }
+            else
+            {
+                Demangle_printSubexpr(st, node->a);
+            }
+            break;
+        }
+        case DEMANGLE_NODE_POSTFIX:
+            Demangle_printSubexpr(st, node->a);
+            Demangle_out(st, node->str, node->len);
+            break;
+        case DEMANGLE_NODE_BINARY:
+        {
+            int paren = (node->len == 1 && node->str[0] == '>');  // Keeps > from closing a template argument list
+            Demangle_outStr(st, paren ? "(" : "");
+            Demangle_printSubexpr(st, node->a);
+            Demangle_out(st, node->str, node->len);
+            Demangle_printSubexpr(st, node->b);
+            Demangle_outStr(st, paren ? ")" : "");
+            break;
+        }
+        case DEMANGLE_NODE_TERNARY:
+            Demangle_printSubexpr(st, node->a);
+            Demangle_outStr(st, "?");
+            Demangle_printSubexpr(st, node->b);
+            Demangle_outStr(st, " : ");
+            Demangle_printSubexpr(st, node->c);
+            break;
+        case DEMANGLE_NODE_INDEX:
+            Demangle_printSubexpr(st, node->a);
+            Demangle_outStr(st, "[");
+            Demangle_print(st, node->b);
+            Demangle_outStr(st, "]");
+            break;
+        case DEMANGLE_NODE_CALL:
+            if (st->s->nodes[node->a].kind == DEMANGLE_NODE_ENCODING)
+            {
+                Demangle_print(st, st->s->nodes[node->a].a);  // The callee by name only
+            }
+            else
+            {
+                Demangle_printSubexpr(st, node->a);
+            }
+            Demangle_outStr(st, "(");
+            Demangle_printList(st, node->b);
+            Demangle_outStr(st, ")");
+            break;
+        case DEMANGLE_NODE_CAST:
+            Demangle_outStr(st, "(");
+            Demangle_print(st, node->a);
+            Demangle_outStr(st, ")");
+            if (node->flags & DEMANGLE_CAST_LIST)
+            {
+                Demangle_outStr(st, "(");
+                Demangle_printList(st, node->b);
+                Demangle_outStr(st, ")");
+            }
+            else
+            {
+                Demangle_printSubexpr(st, node->b);
+            }
+            break;
+        case DEMANGLE_NODE_NAMED_CAST:
+            Demangle_out(st, node->str, node->len);
+            Demangle_outStr(st, "<");
+            Demangle_print(st, node->a);
+            Demangle_outStr(st, ">(");
+            Demangle_print(st, node->b);
+            Demangle_outStr(st, ")");
+            break;
+        case DEMANGLE_NODE_ENCLOSE:
+            Demangle_out(st, node->str, node->len);
+            Demangle_outStr(st, "(");
+            if (st->s->nodes[node->a].kind == DEMANGLE_NODE_LIST)
+            {
+                Demangle_printList(st, node->a);
+            }
+            else
+            {
+                Demangle_print(st, node->a);
+            }
+            Demangle_outStr(st, ")");
+            break;
+        case DEMANGLE_NODE_INIT_LIST:
+            Demangle_print(st, node->a);
+            Demangle_outStr(st, "{");
+            Demangle_printList(st, node->b);
+            Demangle_outStr(st, "}");
+            break;
+        case DEMANGLE_NODE_FOLD:
+            Demangle_outStr(st, "(");
+            if (node->flags == 'l')
+            {
+                Demangle_outStr(st, "...");
+                Demangle_out(st, node->str, node->len);
+                Demangle_printSubexpr(st, node->a);
+            }
+            else
+            {
+                Demangle_printSubexpr(st, node->a);
+                Demangle_out(st, node->str, node->len);
+                Demangle_outStr(st, "...");
+                if (node->b)
+                {
+                    Demangle_out(st, node->str, node->len);
+                    Demangle_printSubexpr(st, node->b);
+                }
+            }
+            Demangle_outStr(st, ")");
+            break;
+        case DEMANGLE_NODE_SIZEOF_PACK:
+        {
+            const demangle_node_t *pack = &st->s->nodes[node->a];  // c++filt prints the size, 0 for anything but a pack
+            if (pack->kind == DEMANGLE_NODE_TPARAM)
+            {
+                pack = &st->s->nodes[pack->a];
+            }
+            int is_pack = (pack->kind == DEMANGLE_NODE_PARAM_PACK || pack->kind == DEMANGLE_NODE_ARG_PACK);
+            Demangle_outNum(st, is_pack ? st->s->nodes[pack->a].b : 0);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Prints the part of a node up to and including its declarator
+ * @param[in,out] st Demangling state
+ * @param[in] node Node
+ */
+static void Demangle_printLeftNode(demangle_state_t *st, const demangle_node_t *node)
+{
+    switch (node->kind)
+    {
+        case DEMANGLE_NODE_NAME:
+        case DEMANGLE_NODE_BUILTIN:
+        case DEMANGLE_NODE_SPECIAL_SUB:
+            Demangle_out(st, node->str, node->len);
+            break;
+        case DEMANGLE_NODE_NESTED:
+            Demangle_print(st, node->a);
+            Demangle_outStr(st, "::");
+            Demangle_print(st, node->b);
+            break;
+        case DEMANGLE_NODE_TEMPLATE:
+            Demangle_print(st, node->a);
+            Demangle_outStr(st, (Demangle_last(st) == '<') ? " <" : "<");
+            Demangle_printList(st, node->b);
+            Demangle_outStr(st, (Demangle_last(st) == '>') ? " >" : ">");
+            break;
+        case DEMANGLE_NODE_LIST:
+            Demangle_printList(st, st->s->nodes[node->a].kind ? (uint32_t)(node - st->s->nodes) : 0);
+            break;
+        case DEMANGLE_NODE_QUAL:
+        {
+            uint8_t cv = node->flags & (uint8_t)~st->pending_cv;  // As c++filt, a qualifier applied twice is printed once
+            st->pending_cv |= node->flags;
+            Demangle_printLeft(st, node->a);
+            Demangle_cvPrint(st, cv);
+            break;
+        }
+        case DEMANGLE_NODE_SUFFIX:
+            Demangle_printLeft(st, node->a);
+            if (node->str)
+            {
+                Demangle_out(st, node->str, node->len);
+            }
+            else
+            {
+                Demangle_outStr(st, " ");
+                Demangle_print(st, node->b);
+            }
+            break;
+        case DEMANGLE_NODE_POINTER:
+        case DEMANGLE_NODE_LREF:
+        case DEMANGLE_NODE_RREF:
+        case DEMANGLE_NODE_PTRMEM:
+            Demangle_printPointerLeft(st, node);
+            break;
+        case DEMANGLE_NODE_ARRAY:
+            Demangle_printLeft(st, node->a);
+            break;
+        case DEMANGLE_NODE_VECTOR:
+            Demangle_print(st, node->a);
+            Demangle_outStr(st, " __vector(");
+            Demangle_print(st, node->b);
+            Demangle_outStr(st, ")");
+            break;
+        case DEMANGLE_NODE_FUNC_TYPE:
+            Demangle_printLeft(st, node->a);
+            if (!Demangle_rhsKind(st, node->a, 1))
+            {
+                Demangle_outStr(st, " ");
+            }
+            break;
+        case DEMANGLE_NODE_ENCODING:
+            Demangle_printEncoding(st, (uint32_t)(node - st->s->nodes), 1);
+            break;
+        case DEMANGLE_NODE_SPECIAL:
+            Demangle_out(st, node->str, node->len);
+            Demangle_print(st, node->a);
+            break;
+        case DEMANGLE_NODE_CTOR_VTABLE:
+            Demangle_out(st, node->str, node->len);
+            Demangle_print(st, node->a);
+            Demangle_outStr(st, "-in-");
+            Demangle_print(st, node->b);
+            break;
+        case DEMANGLE_NODE_REFTEMP:
+            Demangle_outStr(st, "reference temporary #");
+            Demangle_out(st, node->str, node->len);
+            Demangle_outStr(st, " for ");
+            Demangle_print(st, node->a);
+            break;
+        case DEMANGLE_NODE_CTOR:
+        case DEMANGLE_NODE_DTOR:
+            Demangle_outStr(st, (node->kind == DEMANGLE_NODE_DTOR) ? "~" : "");
+            Demangle_printBaseName(st, node->a);
+            break;
+        case DEMANGLE_NODE_ABI_TAG:
+            Demangle_print(st, node->a);
+            Demangle_outStr(st, "[abi:");
+            Demangle_out(st, node->str, node->len);
+            Demangle_outStr(st, "]");
+            break;
+        case DEMANGLE_NODE_LOCAL:
+            if (st->s->nodes[node->a].kind == DEMANGLE_NODE_ENCODING)
+            {
+                Demangle_printEncoding(st, node->a, 0);
+            }
+            else
+            {
+                Demangle_print(st, node->a);
+            }
+            Demangle_outStr(st, "::");
+            Demangle_print(st, node->b);
+            break;
+        case DEMANGLE_NODE_LAMBDA:
+            Demangle_outStr(st, "{lambda(");
+            st->lambda_print++;
+            Demangle_printList(st, node->a);
+            st->lambda_print--;
+            Demangle_outStr(st, ")#");
+            Demangle_outNum(st, node->b);
+            Demangle_outStr(st, "}");
+            break;
+        case DEMANGLE_NODE_UNNAMED:
+            Demangle_outStr(st, "{unnamed type#");
+            Demangle_outNum(st, node->b);
+            Demangle_outStr(st, "}");
+            break;
+        case DEMANGLE_NODE_DEFAULT_ARG:
+            Demangle_outStr(st, "{default arg#");
+            Demangle_outNum(st, node->b);
+            Demangle_outStr(st, "}::");
+            Demangle_print(st, node->a);
+            break;
+        case DEMANGLE_NODE_ARG_PACK:
+            Demangle_printList(st, node->a);
+            break;
+        case DEMANGLE_NODE_PARAM_PACK:
+            if (st->pack_idx == DEMANGLE_PACK_NONE)
+            {
+                Demangle_printList(st, node->a);
+            }
+            else
+            {
+                Demangle_printLeft(st, Demangle_packElem(st, node));
+            }
+            break;
+        case DEMANGLE_NODE_EXPANSION:
+            Demangle_printExpansion(st, node->a);
+            break;
+        case DEMANGLE_NODE_TPARAM:
+            if ((node->flags & DEMANGLE_TPARAM_LAMBDA) && (st->lambda_print || !node->a))
+            {
+                Demangle_outStr(st, "auto:");
+                Demangle_outNum(st, node->b + 1);
+            }
+            else
+            {
+                Demangle_printLeft(st, node->a);
+            }
+            break;
+        case DEMANGLE_NODE_FLOATN:
+            Demangle_outStr(st, "_Float");
+            Demangle_outNum(st, node->b);
+            Demangle_outStr(st, node->flags ? "x" : "");
+            break;
+        case DEMANGLE_NODE_OPERATOR:
+        {
+            size_t len = node->len;
+            Demangle_outStr(st, "operator");
+            if ((node->flags & DEMANGLE_OPERATOR_VENDOR) || Demangle_isLower(node->str[0]))
+            {
+                Demangle_outStr(st, " ");
+            }
+            len -= (len && node->str[len - 1] == ' ');
+            Demangle_out(st, node->str, len);
+            break;
+        }
+        case DEMANGLE_NODE_CONV:
+            Demangle_outStr(st, "operator ");
+            Demangle_print(st, node->a);
+            break;
+        case DEMANGLE_NODE_LITERAL_OP:
+            Demangle_outStr(st, "operator\"\" ");
+            Demangle_print(st, node->a);
+            break;
+        case DEMANGLE_NODE_BINDING:
+            Demangle_outStr(st, "[");
+            Demangle_printList(st, node->a);
+            Demangle_outStr(st, "]");
+            break;
+        case DEMANGLE_NODE_CLONE:
+            Demangle_print(st, node->a);
+            Demangle_outStr(st, " [clone ");
+            Demangle_out(st, node->str, node->len);
+            Demangle_outStr(st, "]");
+            break;
+        default:
+            Demangle_printExpr(st, node);
+            break;
+    }
+}
+
+/**
+ * @brief Prints the part of a node after its declarator (array bounds, function parameters)
+ * @param[in,out] st Demangling state
+ * @param[in] node Node
+ */
+static void Demangle_printRightNode(demangle_state_t *st, const demangle_node_t *node)
+{
+    switch (node->kind)
+    {
+        case DEMANGLE_NODE_QUAL:
+        case DEMANGLE_NODE_SUFFIX:
+            Demangle_printRight(st, node->a);
+            break;
+        case DEMANGLE_NODE_POINTER:
+        case DEMANGLE_NODE_LREF:
+        case DEMANGLE_NODE_RREF:
+        case DEMANGLE_NODE_PTRMEM:
+            Demangle_printPointerRight(st, node);
+            break;
+        case DEMANGLE_NODE_ARRAY:
+            Demangle_outStr(st, (Demangle_last(st) == ']') ? "[" : " [");
+            Demangle_print(st, node->b);
+            Demangle_outStr(st, "]");
+            Demangle_printRight(st, node->a);
+            break;
+        case DEMANGLE_NODE_FUNC_TYPE:
+        {
+            uint8_t ref = (uint8_t)(node->flags >> DEMANGLE_REF_SHIFT);
+            Demangle_outStr(st, "(");
+            Demangle_printList(st, node->b);
+            Demangle_outStr(st, ")");
+            Demangle_cvPrint(st, node->flags & DEMANGLE_CV_MASK);
+            Demangle_outStr(st, (ref == 1) ? " &" : (ref == 2) ? " &&" : "");
+            Demangle_print(st, node->c);
+            Demangle_printRight(st, node->a);
+            break;
+        }
+        case DEMANGLE_NODE_PARAM_PACK:
+            Demangle_printRight(st, Demangle_packElem(st, node));
+            break;
+        case DEMANGLE_NODE_TPARAM:
+            if (!((node->flags & DEMANGLE_TPARAM_LAMBDA) && (st->lambda_print || !node->a)))
+            {
+                Demangle_printRight(st, node->a);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Prints the left part of a node, bounding recursion and work
+ * @param[in,out] st Demangling state
+ * @param[in] id Node, 0 prints nothing
+ */
+static void Demangle_printLeft(demangle_state_t *st, uint32_t id)
+{
+    if (!id || st->err != ELFPARSER_SUCCESS)
+    {
+        return;
+    }
+    if (++st->depth > DEMANGLE_DEPTH_MAX || ++st->steps > DEMANGLE_PRINT_STEPS_MAX)
+    {
+        st->depth--;
+        Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Too deep or too much repetition
+        return;
+    }
+    uint8_t kind = st->s->nodes[id].kind;
+    uint8_t save_cv = st->pending_cv;
+    if (kind != DEMANGLE_NODE_QUAL && kind != DEMANGLE_NODE_TPARAM && kind != DEMANGLE_NODE_PARAM_PACK)
+    {
+        st->pending_cv = 0;  // Only directly nested qualifiers merge
+    }
+    Demangle_printLeftNode(st, &st->s->nodes[id]);
+    st->pending_cv = save_cv;
+    st->depth--;
+}
+
+/**
+ * @brief Prints the right part of a node, bounding recursion and work
+ * @param[in,out] st Demangling state
+ * @param[in] id Node, 0 prints nothing
+ */
+static void Demangle_printRight(demangle_state_t *st, uint32_t id)
+{
+    if (!id || st->err != ELFPARSER_SUCCESS)
+    {
+        return;
+    }
+    if (++st->depth > DEMANGLE_DEPTH_MAX || ++st->steps > DEMANGLE_PRINT_STEPS_MAX)
+    {
+        st->depth--;
+        Demangle_fail(st, ELFPARSER_ERR_FORMAT);  // Too deep or too much repetition
+        return;
+    }
+    Demangle_printRightNode(st, &st->s->nodes[id]);
+    st->depth--;
+}
+
+/**
+ * @brief Prints a node completely
+ * @param[in,out] st Demangling state
+ * @param[in] id Node, 0 prints nothing
+ */
+static void Demangle_print(demangle_state_t *st, uint32_t id)
+{
+    Demangle_printLeft(st, id);
+    Demangle_printRight(st, id);
+}
+
+/**
+ * @brief Demangles one name into the output buffer of a scratch
+ * @param[in,out] s Work buffers, reused across calls
+ * @param[in] mangled Mangled name
+ * @param[in] len Length of mangled
+ * @return int ELFPARSER_SUCCESS with the null-terminated result in s->out and its length in s->out_len,
+ *             ELFPARSER_ERR_FORMAT if the name is not supported, ELFPARSER_ERR_MALLOC on allocation failure
+ */
+static int Demangle_run(demangle_scratch_t *s, const char *mangled, size_t len)
+{
+    if (len < 3 || mangled[0] != '_' || mangled[1] != 'Z')
+    {
+        return ELFPARSER_ERR_FORMAT;  // Not a mangled name
+    }
+    demangle_state_t st;
+    memset(&st, 0, sizeof(st));
+    st.s = s;
+    st.pos = mangled + 2;
+    st.end = mangled + len;
+    st.try_targs = 1;
+    st.pack_idx = DEMANGLE_PACK_NONE;
+    st.pack_max = DEMANGLE_PACK_NONE;
+    st.blank_at = SIZE_MAX;
+    s->node_num = 1;  // Index 0 is the null node
+    s->list_num = 0;
+    s->stack_num = 0;
+    s->sub_num = 0;
+    s->tparam_num = 0;
+    s->ref_num = 0;
+    s->out_len = 0;
+
+    uint32_t root = Demangle_encoding(&st);
+    while (root && Demangle_look(&st, 0) == '.')  // Clone suffixes: .<lowercase or _ word> followed by .<digits> groups
+    {
+        char c = Demangle_look(&st, 1);
+        if (!Demangle_isLower(c) && !Demangle_isDigit(c) && c != '_')
+        {
+            break;
+        }
+        const char *suffix = st.pos;
+        st.pos += 2;
+        while (st.pos < st.end && (Demangle_isLower(*st.pos) || Demangle_isDigit(*st.pos) || *st.pos == '_'))
+        {
+            st.pos++;
+        }
+        while (Demangle_look(&st, 0) == '.' && Demangle_isDigit(Demangle_look(&st, 1)))
+        {
+            st.pos += 2;
+            while (st.pos < st.end && Demangle_isDigit(*st.pos))
+            {
+                st.pos++;
+            }
+        }
+        root = Demangle_textNode(&st, DEMANGLE_NODE_CLONE, suffix, (size_t)(st.pos - suffix), root);
+    }
+    if (root && st.pos != st.end)
+    {
+        Demangle_fail(&st, ELFPARSER_ERR_FORMAT);  // Trailing characters
+    }
+    if (st.err == ELFPARSER_SUCCESS)
+    {
+        Demangle_print(&st, root);
+        Demangle_out(&st, "", 0);  // Makes room for the terminator even for empty output
+    }
+    if (st.err != ELFPARSER_SUCCESS)
+    {
+        return st.err;
+    }
+    s->out[s->out_len] = '\0';
+    return ELFPARSER_SUCCESS;
+}
+
+/**
+ * @brief Frees the work buffers of a scratch
+ * @param[in,out] s Work buffers
+ */
+static void Demangle_scratchFree(demangle_scratch_t *s)
+{
+    free(s->nodes);
+    free(s->lists);
+    free(s->stack);
+    free(s->subs);
+    free(s->tparams);
+    free(s->refs);
+    free(s->out);
+    memset(s, 0, sizeof(*s));
+}
+
+/**
+ * @brief Demangles one name into a caller buffer
+ * @param[in] mangled Mangled name, starting with _Z
+ * @param[out] out Buffer receiving the null-terminated demangled name
+ * @param[in] out_size Size of out in bytes
+ * @param[out] out_len Set to the length of the demangled name without terminator (may be NULL)
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if mangled or out is NULL,
+ *             ELFPARSER_ERR_FORMAT if the name is not a supported mangled name, ELFPARSER_ERR_SIZE if out is too small,
+ *             ELFPARSER_ERR_MALLOC if the work buffers cannot be allocated
+ */
+int ElfParser_Demangle_name(const char *mangled, char *out, size_t out_size, size_t *out_len)
+{
+    if (!mangled || !out)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    demangle_scratch_t scratch;
+    memset(&scratch, 0, sizeof(scratch));
+    int ret = Demangle_run(&scratch, mangled, strlen(mangled));
+    if (ret == ELFPARSER_SUCCESS)
+    {
+        if (out_len)
+        {
+            *out_len = scratch.out_len;
+        }
+        if (scratch.out_len >= out_size)
+        {
+            ret = ELFPARSER_ERR_SIZE;  // Caller buffer too small
+        }
+        else
+        {
+            memcpy(out, scratch.out, scratch.out_len + 1);
+        }
+    }
+    Demangle_scratchFree(&scratch);
+    return ret;
+}
+
+/**
+ * @brief Initializes an empty demangler
+ * @param[out] demangle Pointer to the demangler to initialize
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if demangle is NULL,
+ *             ELFPARSER_ERR_MALLOC if the memo cannot be allocated
+ */
+int ElfParser_Demangle_init(elfparser_demangle_t *demangle)
+{
+    if (!demangle)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    memset(demangle, 0, sizeof(*demangle));
+    demangle->slots = calloc(DEMANGLE_SLOT_INITIAL, sizeof(elfparser_demangle_slot_t));
+    if (!demangle->slots)
+    {
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+    demangle->slot_mask = DEMANGLE_SLOT_INITIAL - 1;
+    return ELFPARSER_SUCCESS;
+}
+
+/**
+ * @brief Finds the memo slot of a name, or the empty slot it would go to
+ * @param[in] demangle Pointer to the demangler
+ * @param[in] mangled Mangled name
+ * @param[in] hash Hash of mangled
+ * @return elfparser_demangle_slot_t* The slot
+ */
+static elfparser_demangle_slot_t *Demangle_slotFind(const elfparser_demangle_t *demangle, const char *mangled, uint32_t hash)
+{
+    for (uint32_t i = hash & demangle->slot_mask;; i = (i + 1) & demangle->slot_mask)  // Load stays below one half
+    {
+        elfparser_demangle_slot_t *slot = &demangle->slots[i];
+        if (!slot->entry_idx ||
+            (slot->hash == hash && ElfParser_strCmp(demangle->entries[slot->entry_idx - 1].mangled, mangled) == 0))
+        {
+            return slot;
+        }
+    }
+}
+
+/**
+ * @brief Rebuilds the memo slots for the current entries
+ * @param[in,out] demangle Pointer to the demangler
+ * @param[in] slot_num Number of slots (power of two, more than twice the entries), the current number to rebuild in place
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_MALLOC on allocation failure
+ */
+static int Demangle_slotsRebuild(elfparser_demangle_t *demangle, uint32_t slot_num)
+{
+    if (slot_num == demangle->slot_mask + 1)
+    {
+        memset(demangle->slots, 0, (size_t)slot_num * sizeof(elfparser_demangle_slot_t));  // In place, cannot fail
+    }
+    else
+    {
+        elfparser_demangle_slot_t *slots = calloc(slot_num, sizeof(elfparser_demangle_slot_t));
+        if (!slots)
+        {
+            return ELFPARSER_ERR_MALLOC;  // Allocation failure
+        }
+        free(demangle->slots);
+        demangle->slots = slots;
+        demangle->slot_mask = slot_num - 1;
+    }
+    for (uint32_t e = 0; e < demangle->entry_num; e++)
+    {
+        const char *mangled = demangle->entries[e].mangled;
+        uint32_t hash = ElfParser_gnuHash(mangled);
+        elfparser_demangle_slot_t *slot = Demangle_slotFind(demangle, mangled, hash);
+        slot->hash = hash;
+        slot->entry_idx = e + 1;
+    }
+    return ELFPARSER_SUCCESS;
+}
+
+/**
+ * @brief Makes room for more memo entries
+ * @param[in,out] demangle Pointer to the demangler
+ * @param[in] extra Number of entries about to be added
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_RANGE if the memo would exceed 2^30 entries,
+ *             ELFPARSER_ERR_MALLOC on allocation failure
+ */
+static int Demangle_reserve(elfparser_demangle_t *demangle, size_t extra)
+{
+    size_t need = (size_t)demangle->entry_num + extra;
+    if (need > (1u << 30))
+    {
+        return ELFPARSER_ERR_RANGE;  // Memo too large
+    }
+    if (need > demangle->entry_cap)
+    {
+        size_t new_cap = demangle->entry_cap ? (size_t)demangle->entry_cap * 2 : DEMANGLE_SLOT_INITIAL / 2;
+        new_cap = (new_cap < need) ? need : new_cap;
+        elfparser_demangle_entry_t *grown = realloc(demangle->entries, new_cap * sizeof(elfparser_demangle_entry_t));
+        if (!grown)
+        {
+            return ELFPARSER_ERR_MALLOC;  // Allocation failure
+        }
+        demangle->entries = grown;
+        demangle->entry_cap = (uint32_t)new_cap;
+    }
+    uint32_t slot_num = demangle->slot_mask + 1;
+    if (need * 2 < slot_num)
+    {
+        return ELFPARSER_SUCCESS;  // Enough slots
+    }
+    while (need * 2 >= slot_num)
+    {
+        slot_num *= 2;
+    }
+    return Demangle_slotsRebuild(demangle, slot_num);
+}
+
+/**
+ * @brief Adds a block to the arena
+ * @param[in,out] demangle Pointer to the demangler
+ * @param[in] block Block, owned by the arena on success
+ * @param[in] size Size of block in bytes
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_MALLOC on allocation failure
+ */
+static int Demangle_blockAdd(elfparser_demangle_t *demangle, char *block, size_t size)
+{
+    if (demangle->block_num == demangle->block_cap)
+    {
+        uint32_t new_cap = demangle->block_cap ? demangle->block_cap * 2 : 16u;
+        char **grown = realloc(demangle->blocks, (size_t)new_cap * sizeof(char *));
+        if (!grown)
+        {
+            return ELFPARSER_ERR_MALLOC;  // Allocation failure
+        }
+        demangle->blocks = grown;
+        demangle->block_cap = new_cap;
+    }
+    demangle->blocks[demangle->block_num++] = block;
+    demangle->arena_size += size;
+    return ELFPARSER_SUCCESS;
+}
+
+/**
+ * @brief Copies bytes into the arena
+ * @param[in,out] demangle Pointer to the demangler
+ * @param[in] data Bytes to copy
+ * @param[in] size Number of bytes
+ * @return char* The copy, NULL on allocation failure
+ */
+static char *Demangle_arenaCopy(elfparser_demangle_t *demangle, const char *data, size_t size)
+{
+    if (size > demangle->cur_left)
+    {
+        size_t block_size = (size > DEMANGLE_BLOCK_SIZE) ? size : DEMANGLE_BLOCK_SIZE;
+        char *block = malloc(block_size);
+        if (!block || Demangle_blockAdd(demangle, block, block_size) != ELFPARSER_SUCCESS)
+        {
+            free(block);
+            return NULL;  // Allocation failure
+        }
+        demangle->cur = block;
+        demangle->cur_left = block_size;
+    }
+    char *copy = demangle->cur;
+    memcpy(copy, data, size);
+    demangle->cur += size;
+    demangle->cur_left -= size;
+    return copy;
+}
+
+/**
+ * @brief Demangles one name through the memo
+ * @param[in,out] demangle Pointer to an initialized demangler
+ * @param[in] mangled Mangled name, starting with _Z
+ * @param[out] demangled Set to the demangled name, NULL if it cannot be demangled
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_FORMAT if the name is not a supported mangled name, ELFPARSER_ERR_MALLOC on allocation failure
+ */
+int ElfParser_Demangle_get(elfparser_demangle_t *demangle, const char *mangled, const char **demangled)
+{
+    if (!demangle || !mangled || !demangled || !demangle->slots)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    *demangled = NULL;
+    demangle->stats.lookups++;
+    int ret = Demangle_reserve(demangle, 1);
+    if (ret != ELFPARSER_SUCCESS)
+    {
+        return ret;  // Memo cannot grow
+    }
+    uint32_t hash = ElfParser_gnuHash(mangled);
+    elfparser_demangle_slot_t *slot = Demangle_slotFind(demangle, mangled, hash);
+    if (slot->entry_idx)
+    {
+        demangle->stats.memo_hits++;
+        *demangled = demangle->entries[slot->entry_idx - 1].demangled;
+        return *demangled ? ELFPARSER_SUCCESS : ELFPARSER_ERR_FORMAT;
+    }
+
+    if (!demangle->scratch)
+    {
+        demangle->scratch = calloc(1, sizeof(demangle_scratch_t));
+        if (!demangle->scratch)
+        {
+            return ELFPARSER_ERR_MALLOC;  // Allocation failure
+        }
+    }
+    demangle_scratch_t *s = demangle->scratch;
+    size_t len = strlen(mangled);
+    ret = Demangle_run(s, mangled, len);
+    if (ret == ELFPARSER_ERR_MALLOC)
+    {
+        return ret;  // Not memoized, a later call may succeed
+    }
+    elfparser_demangle_entry_t entry = { Demangle_arenaCopy(demangle, mangled, len + 1), NULL };
+    if (entry.mangled && ret == ELFPARSER_SUCCESS)
+    {
+        entry.demangled = Demangle_arenaCopy(demangle, s->out, s->out_len + 1);
+    }
+    if (!entry.mangled || (ret == ELFPARSER_SUCCESS && !entry.demangled))
+    {
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+    demangle->entries[demangle->entry_num] = entry;
+    slot->hash = hash;
+    slot->entry_idx = ++demangle->entry_num;
+    demangle->stats.demangled += (ret == ELFPARSER_SUCCESS);
+    demangle->stats.failed += (ret != ELFPARSER_SUCCESS);
+    *demangled = entry.demangled;
+    return ret;
+}
+
+/**
+ * @brief Demangles one chunk of the new names of a symbol table into a block of its own
+ * @param[in,out] ctx Pointer to the demangle_job_t
+ * @param[in] chunk_idx Index of the chunk
+ * @param[in] begin First new name of the chunk
+ * @param[in] end One past the last new name of the chunk
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_MALLOC on allocation failure
+ */
+static int Demangle_chunk(void *ctx, size_t chunk_idx, size_t begin, size_t end)
+{
+    demangle_job_t *job = ctx;
+    demangle_scratch_t scratch;
+    char *block = NULL;
+    size_t used = 0;
+    size_t cap = 0;
+    int ret = ELFPARSER_SUCCESS;
+
+    memset(&scratch, 0, sizeof(scratch));
+    for (size_t k = begin; k < end; k++)
+    {
+        const char *mangled = job->entries[job->pending[k]].mangled;
+        size_t len = strlen(mangled);
+        int status = Demangle_run(&scratch, mangled, len);
+        if (status == ELFPARSER_ERR_MALLOC)
+        {
+            ret = status;
+            break;
+        }
+        size_t need = len + 1 + ((status == ELFPARSER_SUCCESS) ? scratch.out_len + 1 : 0);
+        if (used + need > cap)
+        {
+            size_t new_cap = cap ? cap * 2 : DEMANGLE_BLOCK_SIZE;
+            new_cap = (new_cap < used + need) ? used + need : new_cap;
+            char *grown = realloc(block, new_cap);
+            if (!grown)
+            {
+                ret = ELFPARSER_ERR_MALLOC;
+                break;
+            }
+            block = grown;
+            cap = new_cap;
+        }
+        memcpy(block + used, mangled, len + 1);
+        job->offsets[k] = used;
+        used += len + 1;
+        job->results[k] = SIZE_MAX;
+        if (status == ELFPARSER_SUCCESS)
+        {
+            memcpy(block + used, scratch.out, scratch.out_len + 1);
+            job->results[k] = used;
+            used += scratch.out_len + 1;
+        }
+    }
+    Demangle_scratchFree(&scratch);
+    if (block && used < cap)
+    {
+        char *shrunk = realloc(block, used);  // Offsets stay valid, only the tail goes
+        block = shrunk ? shrunk : block;
+    }
+    job->blocks[chunk_idx] = block;
+    job->sizes[chunk_idx] = used;
+    return ret;
+}
+
+/**
+ * @brief Demangles every name of a symbol table through the memo
+ * @param[in,out] demangle Pointer to an initialized demangler
+ * @param[in] symbol_table Pointer to the symbol table; names must already be resolved
+ * @param[in] thread_num Number of threads to use, 0 for one per online CPU
+ * @param[out] names Array of table_len names to fill
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_RANGE if the memo would grow too large, ELFPARSER_ERR_MALLOC on allocation failure
+ */
+int ElfParser_Demangle_symTable(elfparser_demangle_t *demangle, const elfparser_symtable_t *symbol_table, uint32_t thread_num,
+                                const char **names)
+{
+    if (!demangle || !symbol_table || !names || !demangle->slots)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    if (symbol_table->table_len && !symbol_table->table)
+    {
+        return ELFPARSER_ERR_NULL;  // Unparsed table
+    }
+    size_t table_len = symbol_table->table_len;
+    int ret = Demangle_reserve(demangle, table_len);
+    if (ret != ELFPARSER_SUCCESS)
+    {
+        return ret;  // Memo cannot grow
+    }
+    uint32_t *sym_entry = malloc((table_len ? table_len : 1) * sizeof(uint32_t));
+    uint32_t *pending = malloc((table_len ? table_len : 1) * sizeof(uint32_t));
+    if (!sym_entry || !pending)
+    {
+        free(sym_entry);
+        free(pending);
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+
+    /* Answer repeats from the memo; new names get an entry pointing at the symbol name for now */
+    uint32_t old_num = demangle->entry_num;
+    size_t pending_num = 0;
+    for (size_t i = 0; i < table_len; i++)
+    {
+        const char *name = symbol_table->table[i].sym_name;
+        names[i] = name;
+        sym_entry[i] = UINT32_MAX;
+        if (!name || name[0] != '_' || name[1] != 'Z')
+        {
+            continue;  // Not a mangled C++ name
+        }
+        demangle->stats.lookups++;
+        uint32_t hash = ElfParser_gnuHash(name);
+        elfparser_demangle_slot_t *slot = Demangle_slotFind(demangle, name, hash);
+        if (slot->entry_idx)
+        {
+            demangle->stats.memo_hits++;
+        }
+        else
+        {
+            demangle->entries[demangle->entry_num].mangled = name;
+            demangle->entries[demangle->entry_num].demangled = NULL;
+            slot->hash = hash;
+            slot->entry_idx = ++demangle->entry_num;
+            pending[pending_num++] = slot->entry_idx - 1;
+        }
+        sym_entry[i] = slot->entry_idx - 1;
+    }
+
+    /* Demangle the new names in chunks, each into a block of its own */
+    size_t chunk_num = ElfParser_chunkNum(pending_num, DEMANGLE_CHUNK_SIZE);
+    demangle_job_t job = { demangle->entries, pending, malloc((pending_num ? pending_num : 1) * sizeof(size_t)),
+                           malloc((pending_num ? pending_num : 1) * sizeof(size_t)), calloc(chunk_num ? chunk_num : 1, sizeof(char *)),
+                           calloc(chunk_num ? chunk_num : 1, sizeof(size_t)) };
+    ret = (job.offsets && job.results && job.blocks && job.sizes) ? ELFPARSER_SUCCESS : ELFPARSER_ERR_MALLOC;
+    if (ret == ELFPARSER_SUCCESS && pending_num)
+    {
+        ret = ElfParser_parallelFor(pending_num, DEMANGLE_CHUNK_SIZE, thread_num, Demangle_chunk, &job);
+    }
+    if (ret == ELFPARSER_SUCCESS && demangle->block_cap - demangle->block_num < chunk_num)
+    {
+        uint32_t new_cap = demangle->block_cap ? demangle->block_cap : 16u;
+        while (new_cap - demangle->block_num < chunk_num)
+        {
+            new_cap *= 2;
+        }
+        char **grown = realloc(demangle->blocks, (size_t)new_cap * sizeof(char *));
+        ret = grown ? ELFPARSER_SUCCESS : ELFPARSER_ERR_MALLOC;
+        demangle->blocks = grown ? grown : demangle->blocks;
+        demangle->block_cap = grown ? new_cap : demangle->block_cap;
+    }
+
+    /* Hand the blocks to the arena and point the new entries into them, or forget the new entries */
+    for (size_t c = 0; c < chunk_num && job.blocks; c++)
+    {
+        if (ret != ELFPARSER_SUCCESS)
+        {
+            free(job.blocks[c]);
+            continue;
+        }
+        Demangle_blockAdd(demangle, job.blocks[c], job.sizes[c]);  // Cannot fail, room was made above
+        size_t end = (c + 1) * DEMANGLE_CHUNK_SIZE;
+        for (size_t k = c * DEMANGLE_CHUNK_SIZE; k < end && k < pending_num; k++)
+        {
+            elfparser_demangle_entry_t *entry = &demangle->entries[pending[k]];
+            entry->mangled = job.blocks[c] + job.offsets[k];
+            entry->demangled = (job.results[k] == SIZE_MAX) ? NULL : job.blocks[c] + job.results[k];
+            demangle->stats.demangled += (entry->demangled != NULL);
+            demangle->stats.failed += (entry->demangled == NULL);
+        }
+    }
+    if (ret != ELFPARSER_SUCCESS)
+    {
+        demangle->entry_num = old_num;
+        Demangle_slotsRebuild(demangle, demangle->slot_mask + 1);  // In place, drops the slots of the forgotten entries
+    }
+    else
+    {
+        for (size_t i = 0; i < table_len; i++)
+        {
+            if (sym_entry[i] != UINT32_MAX && demangle->entries[sym_entry[i]].demangled)
+            {
+                names[i] = demangle->entries[sym_entry[i]].demangled;
+            }
+        }
+    }
+    free(job.offsets);
+    free(job.results);
+    free(job.blocks);
+    free(job.sizes);
+    free(sym_entry);
+    free(pending);
+    return ret;
+}
+
+/**
+ * @brief Frees the memo, the arena and the demangler itself
+ * @param[in,out] demangle Pointer to the demangler to free
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if demangle is NULL
+ */
+int ElfParser_Demangle_free(elfparser_demangle_t *demangle)
+{
+    if (!demangle)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    for (uint32_t b = 0; b < demangle->block_num; b++)
+    {
+        free(demangle->blocks[b]);
+    }
+    if (demangle->scratch)
+    {
+        Demangle_scratchFree(demangle->scratch);
+        free(demangle->scratch);
+    }
+    free(demangle->blocks);
+    free(demangle->entries);
+    free(demangle->slots);
+    memset(demangle, 0, sizeof(*demangle));
+    return ELFPARSER_SUCCESS;
+}
@@ -0,0 +1,1607 @@
+/**
+ * @file elfparser_dwarfline.c
+ * @brief DWARF line table lookup functions for libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This file implements lazy address to file and line resolution from
+ * .debug_line. Opening indexes the ranges of .debug_aranges; a unit's line
+ * offset is found from its compile unit entry in .debug_info (the first
+ * entry's DW_AT_stmt_list) and its line program is decoded on the first
+ * lookup that lands in one of its ranges. Decoding runs the line number state
+ * machine once, keeping one row per distinct address and sequence end, and
+ * sorts whole sequences by start address, so a unit's rows answer lookups by
+ * binary search. A miss sweeps the units .debug_aranges does not cover and
+ * indexes their sequences as ranges. Every read goes through a bounds-checked
+ * cursor, so a malformed unit is marked invalid instead of failing lookups.
+ */
+
+#include "../inc_priv/elfparser_dwarfline_priv.h"
+#include "../inc_pub/elfparser_dwarfline.h"
+#include "../inc_priv/elfparser_memmanip_priv.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Bounds-checked reader over a DWARF section; failures are sticky
+ */
+typedef struct dwarfline_cursor_s
+{
+    const uint8_t*  pos;        /**< Next byte to read */
+    const uint8_t*  end;        /**< One past the last readable byte */
+    int             big_endian; /**< Non-zero for big-endian data */
+    int             fail;       /**< Set once a read ran past end or met an unknown encoding */
+} dwarfline_cursor_t;
+
+/**
+ * @brief A decoded sequence within the rows of a unit being built
+ */
+typedef struct dwarfline_seq_s
+{
+    uint64_t    start_addr; /**< Address of the first row */
+    uint32_t    begin;      /**< First row */
+    uint32_t    end;        /**< One past the end-of-sequence row */
+} dwarfline_seq_t;
+
+/**
+ * @brief Growing state of a unit being decoded
+ */
+typedef struct dwarfline_build_s
+{
+    const char**                dirs;       /**< Include directories, index 0 being the compilation directory */
+    uint32_t                    dir_num;    /**< Number of entries in dirs */
+    uint32_t                    dir_cap;    /**< Capacity of dirs */
+    char*                       arena;      /**< Joined file names */
+    size_t                      arena_len;  /**< Bytes used in arena */
+    size_t                      arena_cap;  /**< Capacity of arena */
+    uint32_t*                   file_off;   /**< Offset of each file name in arena */
+    uint32_t                    file_num;   /**< Number of entries in file_off */
+    uint32_t                    file_cap;   /**< Capacity of file_off */
+    elfparser_dwarfline_row_t*  rows;       /**< Rows in program order */
+    uint32_t                    row_num;    /**< Number of entries in rows */
+    uint32_t                    row_cap;    /**< Capacity of rows */
+    dwarfline_seq_t*            seqs;       /**< Completed sequences */
+    uint32_t                    seq_num;    /**< Number of entries in seqs */
+    uint32_t                    seq_cap;    /**< Capacity of seqs */
+} dwarfline_build_t;
+
+/**
+ * @brief Grows an array so it holds at least need elements
+ * @param[in,out] array Pointer to the array pointer
+ * @param[in,out] cap Pointer to the capacity in elements
+ * @param[in] need Number of elements required
+ * @param[in] elem_size Size of one element in bytes
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_MALLOC if memory allocation fails
+ */
+static int DwarfLine_grow(void **array, uint32_t *cap, uint64_t need, size_t elem_size)
+{
+    if (need <= *cap)
+    {
+        return ELFPARSER_SUCCESS;  // Fits
+    }
+    if (need > UINT32_MAX)
+    {
+        return ELFPARSER_ERR_MALLOC;  // Beyond what the counters hold
+    }
+    uint64_t new_cap = *cap ? (uint64_t)*cap * 2u : 16u;
+    new_cap = (new_cap < need) ? need : (new_cap > UINT32_MAX) ? UINT32_MAX : new_cap;
+    void *grown = realloc(*array, (size_t)new_cap * elem_size);
+    if (!grown)
+    {
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+    *array = grown;
+    *cap = (uint32_t)new_cap;
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Reads a fixed-size unsigned value
+ * @param[in,out] cur Pointer to the cursor
+ * @param[in] size Size of the value in bytes, 1 to 8
+ * @return uint64_t The value, 0 on failure
+ */
+static uint64_t DwarfLine_fixedRead(dwarfline_cursor_t *cur, size_t size)
+{
+    if (cur->fail || size == 0 || size > 8u || (size_t)(cur->end - cur->pos) < size)
+    {
+        cur->fail = 1;
+        cur->pos = cur->end;
+        return 0;  // Out of bounds
+    }
+    const uint8_t *src = cur->pos;
+    uint64_t value = 0;
+    cur->pos += size;
+    switch (size)
+    {
+        case 1u: return src[0];
+        case 2u: return ElfParser_load16(src, cur->big_endian);
+        case 4u: return ElfParser_load32(src, cur->big_endian);
+        case 8u: return ElfParser_load64(src, cur->big_endian);
+        default: break;
+    }
+    for (size_t i = 0; i < size; i++)  // Odd sizes (3, 5 to 7 bytes)
+    {
+        value |= (uint64_t)src[i] << (8u * (cur->big_endian ? size - 1u - i : i));
+    }
+    return value;
+}
+
+/**
+ * @brief Reads an unsigned LEB128 value
+ * @param[in,out] cur Pointer to the cursor
+ * @return uint64_t The value (bits beyond 64 are dropped), 0 on failure
+ */
+static uint64_t DwarfLine_ulebRead(dwarfline_cursor_t *cur)
+{
+    uint64_t value = 0;
+    unsigned shift = 0;
+
+    while (cur->pos < cur->end)
+    {
+        uint8_t byte = *cur->pos++;
+        if (shift < 64u)
+        {
+            value |= (uint64_t)(byte & 0x7Fu) << shift;
+        }
+        shift += 7u;
+        if (!(byte & 0x80u))
+        {
+            return value;
+        }
+    }
+    cur->fail = 1;
+    return 0;  // Unterminated
+}
+
+/**
+ * @brief Reads a signed LEB128 value
+ * @param[in,out] cur Pointer to the cursor
+ * @return int64_t The value, 0 on failure
+ */
+static int64_t DwarfLine_slebRead(dwarfline_cursor_t *cur)
+{
+    uint64_t value = 0;
+    unsigned shift = 0;
+
+    while (cur->pos < cur->end)
+    {
+        uint8_t byte = *cur->pos++;
+        if (shift < 64u)
+        {
+            value |= (uint64_t)(byte & 0x7Fu) << shift;
+        }
+        shift += 7u;
+        if (!(byte & 0x80u))
+        {
+            if (shift < 64u && (byte & 0x40u))
+            {
+                value |= ~(uint64_t)0 << shift;  // Sign-extend
+            }
+            return (int64_t)value;
+        }
+    }
+    cur->fail = 1;
+    return 0;  // Unterminated
+}
+
+/**
+ * @brief Skips bytes
+ * @param[in,out] cur Pointer to the cursor
+ * @param[in] size Number of bytes to skip
+ */
+static void DwarfLine_skip(dwarfline_cursor_t *cur, uint64_t size)
+{
+    if (cur->fail || (uint64_t)(cur->end - cur->pos) < size)
+    {
+        cur->fail = 1;
+        cur->pos = cur->end;
+        return;  // Out of bounds
+    }
+    cur->pos += size;
+}
+
+/**
+ * @brief Reads an inline NUL-terminated string
+ * @param[in,out] cur Pointer to the cursor
+ * @return const char* The string, "" on failure
+ */
+static const char *DwarfLine_cstrRead(dwarfline_cursor_t *cur)
+{
+    const uint8_t *nul = cur->fail ? NULL : memchr(cur->pos, 0, (size_t)(cur->end - cur->pos));
+    if (!nul)
+    {
+        cur->fail = 1;
+        cur->pos = cur->end;
+        return "";  // Unterminated
+    }
+    const char *str = (const char *)cur->pos;
+    cur->pos = nul + 1;
+    return str;
+}
+
+/**
+ * @brief Reads an initial length field and narrows the cursor to the unit it announces
+ * @param[in,out] cur Pointer to the cursor, positioned at the unit start
+ * @param[out] offset_size Set to 4 or 8 for the 32-bit or 64-bit DWARF format
+ * @return const uint8_t* One past the last byte of the unit, NULL if the length is invalid
+ */
+static const uint8_t *DwarfLine_unitLengthRead(dwarfline_cursor_t *cur, size_t *offset_size)
+{
+    uint64_t length = DwarfLine_fixedRead(cur, 4u);
+    *offset_size = 4u;
+    if (length == DWARFLINE_LENGTH_64BIT)
+    {
+        length = DwarfLine_fixedRead(cur, 8u);
+        *offset_size = 8u;
+    }
+    else if (length >= DWARFLINE_LENGTH_RESERVED)
+    {
+        cur->fail = 1;  // Reserved escape
+    }
+    if (cur->fail || length > (uint64_t)(cur->end - cur->pos))
+    {
+        cur->fail = 1;
+        return NULL;  // Unit overruns the section
+    }
+    return cur->pos + length;
+}
+
+/**
+ * @brief Returns the contents of a debug section, decompressed through the cache if there is one
+ * @param[in,out] dwarf_line Pointer to the line table structure, file and cache set
+ * @param[in] sect_head Pointer to the section headers of the file
+ * @param[in] sect_idx Index of the section
+ * @param[out] data Set to the contents, NULL for SHT_NOBITS
+ * @param[out] size Set to the size of the contents in bytes
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_FORMAT if the section is compressed and there is no cache,
+ *             or the error of the file or cache functions
+ */
+static int DwarfLine_sectionGet(elfparser_dwarfline_t *dwarf_line, const elfparser_secthead_t *sect_head, uint32_t sect_idx,
+                                const void **data, size_t *size)
+{
+    if (dwarf_line->cache)
+    {
+        return ElfParser_SectCache_get(dwarf_line->cache, dwarf_line->file, sect_idx, data, size);  // Released at close
+    }
+    if (sect_head->table[sect_idx].sh_flags & ELFPARSER_SECTHEAD_FLAG_COMPRESSED)
+    {
+        return ELFPARSER_ERR_FORMAT;  // Compressed contents and nothing to decompress them with
+    }
+    return ElfParser_File_sectionGet(dwarf_line->file, sect_idx, data, size);  // Pinned until the file is closed
+}
+
+/**
+ * @brief Fetches an auxiliary debug section on first use
+ * @param[in,out] dwarf_line Pointer to the line table structure
+ * @param[in] slot DWARFLINE_AUX_* slot of the section
+ * @param[out] cur Cursor set to cover the whole section
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NOT_FOUND if the section is absent or unusable,
+ *             or the error of the reader
+ */
+static int DwarfLine_auxGet(elfparser_dwarfline_t *dwarf_line, uint32_t slot, dwarfline_cursor_t *cur)
+{
+    static const char *const names[ELFPARSER_DWARFLINE_AUX_NUM] = {
+        DWARFLINE_SECT_LINE_STR, DWARFLINE_SECT_STR, DWARFLINE_SECT_INFO, DWARFLINE_SECT_ABBREV
+    };
+
+    if (!dwarf_line->aux_ready[slot])
+    {
+        const elfparser_secthead_t *sect_head;
+        int ret = ElfParser_File_sectHeadGet(dwarf_line->file, &sect_head);
+        int32_t idx = (ret < 0) ? ret : ElfParser_SectHead_byNameFind(sect_head, names[slot], 0);
+        if (idx >= 0)
+        {
+            const void *data;
+            size_t size;
+            ret = DwarfLine_sectionGet(dwarf_line, sect_head, (uint32_t)idx, &data, &size);
+            if (ret == ELFPARSER_ERR_MALLOC || ret == ELFPARSER_ERR_IO)
+            {
+                return ret;  // Resource failure, try again next time
+            }
+            if (ret == ELFPARSER_SUCCESS)
+            {
+                dwarf_line->aux_data[slot] = data;
+                dwarf_line->aux_size[slot] = data ? size : 0;
+            }
+        }
+        dwarf_line->aux_ready[slot] = 1;  // Present or not, decided once
+    }
+    cur->pos = dwarf_line->aux_data[slot];
+    cur->end = cur->pos + dwarf_line->aux_size[slot];
+    cur->big_endian = dwarf_line->big_endian;
+    cur->fail = 0;
+    return dwarf_line->aux_data[slot] ? ELFPARSER_SUCCESS : ELFPARSER_ERR_NOT_FOUND;
+}
+
+/**
+ * @brief Skips one attribute value
+ * @param[in,out] cur Pointer to the cursor
+ * @param[in] form DW_FORM_* of the value
+ * @param[in] offset_size 4 or 8 for the DWARF format of the unit
+ * @param[in] addr_size Size of a target address in bytes
+ * @param[in] version DWARF version of the unit
+ * @param[in] depth Number of DW_FORM_indirect levels followed so far
+ */
+static void DwarfLine_formSkip(dwarfline_cursor_t *cur, uint64_t form, size_t offset_size, size_t addr_size,
+                               uint32_t version, uint32_t depth)
+{
+    switch (form)
+    {
+        case DWARFLINE_FORM_FLAG_PRESENT:
+        case DWARFLINE_FORM_IMPLICIT_CONST:
+            break;  // No data in the entry
+        case DWARFLINE_FORM_DATA1: case DWARFLINE_FORM_REF1: case DWARFLINE_FORM_FLAG:
+        case DWARFLINE_FORM_STRX1: case DWARFLINE_FORM_ADDRX1:
+            DwarfLine_skip(cur, 1u);
+            break;
+        case DWARFLINE_FORM_DATA2: case DWARFLINE_FORM_REF2: case DWARFLINE_FORM_STRX2: case DWARFLINE_FORM_ADDRX2:
+            DwarfLine_skip(cur, 2u);
+            break;
+        case DWARFLINE_FORM_STRX3: case DWARFLINE_FORM_ADDRX3:
+            DwarfLine_skip(cur, 3u);
+            break;
+        case DWARFLINE_FORM_DATA4: case DWARFLINE_FORM_REF4: case DWARFLINE_FORM_REF_SUP4:
+        case DWARFLINE_FORM_STRX4: case DWARFLINE_FORM_ADDRX4:
+            DwarfLine_skip(cur, 4u);
+            break;
+        case DWARFLINE_FORM_DATA8: case DWARFLINE_FORM_REF8: case DWARFLINE_FORM_REF_SIG8: case DWARFLINE_FORM_REF_SUP8:
+            DwarfLine_skip(cur, 8u);
+            break;
+        case DWARFLINE_FORM_DATA16:
+            DwarfLine_skip(cur, 16u);
+            break;
+        case DWARFLINE_FORM_ADDR:
+            DwarfLine_skip(cur, addr_size);
+            break;
+        case DWARFLINE_FORM_REF_ADDR:
+            DwarfLine_skip(cur, (version <= 2u) ? addr_size : offset_size);  // Address-sized in DWARF 2
+            break;
+        case DWARFLINE_FORM_STRP: case DWARFLINE_FORM_LINE_STRP: case DWARFLINE_FORM_SEC_OFFSET:
+        case DWARFLINE_FORM_STRP_SUP: case DWARFLINE_FORM_GNU_REF_ALT: case DWARFLINE_FORM_GNU_STRP_ALT:
+            DwarfLine_skip(cur, offset_size);
+            break;
+        case DWARFLINE_FORM_SDATA:
+            (void)DwarfLine_slebRead(cur);
+            break;
+        case DWARFLINE_FORM_UDATA: case DWARFLINE_FORM_REF_UDATA: case DWARFLINE_FORM_STRX: case DWARFLINE_FORM_ADDRX:
+        case DWARFLINE_FORM_LOCLISTX: case DWARFLINE_FORM_RNGLISTX:
+            (void)DwarfLine_ulebRead(cur);
+            break;
+        case DWARFLINE_FORM_STRING:
+            (void)DwarfLine_cstrRead(cur);
+            break;
+        case DWARFLINE_FORM_BLOCK1:
+            DwarfLine_skip(cur, DwarfLine_fixedRead(cur, 1u));
+            break;
+        case DWARFLINE_FORM_BLOCK2:
+            DwarfLine_skip(cur, DwarfLine_fixedRead(cur, 2u));
+            break;
+        case DWARFLINE_FORM_BLOCK4:
+            DwarfLine_skip(cur, DwarfLine_fixedRead(cur, 4u));
+            break;
+        case DWARFLINE_FORM_BLOCK: case DWARFLINE_FORM_EXPRLOC:
+            DwarfLine_skip(cur, DwarfLine_ulebRead(cur));
+            break;
+        case DWARFLINE_FORM_INDIRECT:
+            if (depth >= DWARFLINE_INDIRECT_DEPTH_MAX)
+            {
+                cur->fail = 1;  // Pathological chain
+                break;
+            }
+            DwarfLine_formSkip(cur, DwarfLine_ulebRead(cur), offset_size, addr_size, version, depth + 1u);
+            break;
+        default:
+            cur->fail = 1;  // Unknown size, nothing after it can be read
+            break;
+    }
+}
+
+/**
+ * @brief Reads a string attribute value of a line table header
+ * @param[in,out] dwarf_line Pointer to the line table structure
+ * @param[in,out] cur Pointer to the cursor
+ * @param[in] form DW_FORM_* of the value
+ * @param[in] offset_size 4 or 8 for the DWARF format of the unit
+ * @param[out] str Set to the string; "" for forms that need unit context (DW_FORM_strx*)
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_FORMAT if the string cannot be located,
+ *             or the error of the reader
+ */
+static int DwarfLine_formStrRead(elfparser_dwarfline_t *dwarf_line, dwarfline_cursor_t *cur, uint64_t form,
+                                 size_t offset_size, const char **str)
+{
+    dwarfline_cursor_t strs;
+    uint32_t slot;
+
+    *str = "";
+    if (form == DWARFLINE_FORM_STRING)
+    {
+        *str = DwarfLine_cstrRead(cur);
+        return cur->fail ? ELFPARSER_ERR_FORMAT : ELFPARSER_SUCCESS;
+    }
+    if (form == DWARFLINE_FORM_LINE_STRP || form == DWARFLINE_FORM_STRP)
+    {
+        slot = (form == DWARFLINE_FORM_LINE_STRP) ? DWARFLINE_AUX_LINE_STR : DWARFLINE_AUX_STR;
+        uint64_t offset = DwarfLine_fixedRead(cur, offset_size);
+        int ret = DwarfLine_auxGet(dwarf_line, slot, &strs);
+        if (ret == ELFPARSER_ERR_NOT_FOUND)
+        {
+            return ELFPARSER_ERR_FORMAT;  // Reference into a missing section
+        }
+        if (ret < 0)
+        {
+            return ret;  // Resource failure
+        }
+        if (cur->fail || offset >= (uint64_t)(strs.end - strs.pos))
+        {
+            return ELFPARSER_ERR_FORMAT;  // Offset outside the string section
+        }
+        DwarfLine_skip(&strs, offset);
+        *str = DwarfLine_cstrRead(&strs);
+        return strs.fail ? ELFPARSER_ERR_FORMAT : ELFPARSER_SUCCESS;
+    }
+    DwarfLine_formSkip(cur, form, offset_size, dwarf_line->addr_size, DWARFLINE_VERSION_MAX, 0);  // Indexed strings: no unit context here
+    return cur->fail ? ELFPARSER_ERR_FORMAT : ELFPARSER_SUCCESS;
+}
+
+/**
+ * @brief Reads an unsigned constant attribute value of a line table header
+ * @param[in,out] cur Pointer to the cursor
+ * @param[in] form DW_FORM_* of the value
+ * @param[in] offset_size 4 or 8 for the DWARF format of the unit
+ * @param[in] addr_size Size of a target address in bytes
+ * @return uint64_t The value, 0 for non-constant forms
+ */
+static uint64_t DwarfLine_formUnsignedRead(dwarfline_cursor_t *cur, uint64_t form, size_t offset_size, size_t addr_size)
+{
+    switch (form)
+    {
+        case DWARFLINE_FORM_DATA1: return DwarfLine_fixedRead(cur, 1u);
+        case DWARFLINE_FORM_DATA2: return DwarfLine_fixedRead(cur, 2u);
+        case DWARFLINE_FORM_DATA4: return DwarfLine_fixedRead(cur, 4u);
+        case DWARFLINE_FORM_DATA8: return DwarfLine_fixedRead(cur, 8u);
+        case DWARFLINE_FORM_UDATA: return DwarfLine_ulebRead(cur);
+        default:
+            DwarfLine_formSkip(cur, form, offset_size, addr_size, DWARFLINE_VERSION_MAX, 0);
+            return 0;
+    }
+}
+
+/**
+ * @brief Finds the line program offset of a compile unit from its first entry's DW_AT_stmt_list
+ * @param[in,out] dwarf_line Pointer to the line table structure
+ * @param[in] info_offset Offset of the unit in .debug_info
+ * @param[out] line_offset Set to the offset of the line program in .debug_line
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_FORMAT if the unit or its attribute is malformed,
+ *             ELFPARSER_ERR_NOT_FOUND if the entry has no DW_AT_stmt_list or a section is missing,
+ *             or the error of the reader
+ */
+static int DwarfLine_stmtListFind(elfparser_dwarfline_t *dwarf_line, uint64_t info_offset, uint64_t *line_offset)
+{
+    dwarfline_cursor_t info;
+    dwarfline_cursor_t abbrev;
+    int ret = DwarfLine_auxGet(dwarf_line, DWARFLINE_AUX_INFO, &info);
+    if (ret == ELFPARSER_SUCCESS)
+    {
+        ret = DwarfLine_auxGet(dwarf_line, DWARFLINE_AUX_ABBREV, &abbrev);
+    }
+    if (ret < 0)
+    {
+        return ret;  // Missing section or resource failure
+    }
+    if (info_offset >= (uint64_t)(info.end - info.pos))
+    {
+        return ELFPARSER_ERR_FORMAT;  // Offset outside .debug_info
+    }
+
+    size_t offset_size;
+    DwarfLine_skip(&info, info_offset);
+    const uint8_t *unit_end = DwarfLine_unitLengthRead(&info, &offset_size);
+    if (!unit_end)
+    {
+        return ELFPARSER_ERR_FORMAT;  // Bad unit length
+    }
+    info.end = unit_end;
+    uint32_t version = (uint32_t)DwarfLine_fixedRead(&info, 2u);
+    uint64_t abbrev_offset;
+    size_t addr_size;
+    if (version >= 5u)
+    {
+        uint32_t unit_type = (uint32_t)DwarfLine_fixedRead(&info, 1u);
+        addr_size = (size_t)DwarfLine_fixedRead(&info, 1u);
+        abbrev_offset = DwarfLine_fixedRead(&info, offset_size);
+        if (unit_type == DWARFLINE_UT_SKELETON || unit_type == DWARFLINE_UT_SPLIT_COMPILE)
+        {
+            DwarfLine_skip(&info, 8u);  // dwo_id
+        }
+        else if (unit_type == DWARFLINE_UT_TYPE || unit_type == DWARFLINE_UT_SPLIT_TYPE)
+        {
+            DwarfLine_skip(&info, 8u + offset_size);  // type_signature, type_offset
+        }
+    }
+    else
+    {
+        abbrev_offset = DwarfLine_fixedRead(&info, offset_size);
+        addr_size = (size_t)DwarfLine_fixedRead(&info, 1u);
+    }
+    uint64_t code = DwarfLine_ulebRead(&info);
+    if (info.fail || version < DWARFLINE_VERSION_MIN || version > DWARFLINE_VERSION_MAX || code == 0 ||
+        abbrev_offset >= (uint64_t)(abbrev.end - abbrev.pos))
+    {
+        return ELFPARSER_ERR_FORMAT;  // Malformed unit header
+    }
+
+    DwarfLine_skip(&abbrev, abbrev_offset);
+    for (;;)  // Declarations until the one of the first entry
+    {
+        uint64_t decl_code = DwarfLine_ulebRead(&abbrev);
+        if (abbrev.fail || decl_code == 0)
+        {
+            return ELFPARSER_ERR_FORMAT;  // Code not declared
+        }
+        (void)DwarfLine_ulebRead(&abbrev);           // Tag
+        DwarfLine_skip(&abbrev, 1u);                 // Children flag
+        for (;;)  // Attribute specifications
+        {
+            uint64_t name = DwarfLine_ulebRead(&abbrev);
+            uint64_t form = DwarfLine_ulebRead(&abbrev);
+            if (form == DWARFLINE_FORM_IMPLICIT_CONST)
+            {
+                (void)DwarfLine_slebRead(&abbrev);
+            }
+            if (abbrev.fail)
+            {
+                return ELFPARSER_ERR_FORMAT;  // Truncated declaration
+            }
+            if (name == 0 && form == 0)
+            {
+                break;  // End of this declaration
+            }
+            if (decl_code != code)
+            {
+                continue;  // Other declaration, specifications only
+            }
+            if (name == DWARFLINE_AT_STMT_LIST)
+            {
+                if (form == DWARFLINE_FORM_SEC_OFFSET)
+                {
+                    *line_offset = DwarfLine_fixedRead(&info, offset_size);
+                }
+                else if (form == DWARFLINE_FORM_DATA4 || form == DWARFLINE_FORM_DATA8)
+                {
+                    *line_offset = DwarfLine_fixedRead(&info, (form == DWARFLINE_FORM_DATA4) ? 4u : 8u);  // DWARF 2 and 3
+                }
+                else
+                {
+                    return ELFPARSER_ERR_FORMAT;  // Not an offset
+                }
+                return info.fail ? ELFPARSER_ERR_FORMAT : ELFPARSER_SUCCESS;
+            }
+            DwarfLine_formSkip(&info, form, offset_size, addr_size, version, 0);
+            if (info.fail)
+            {
+                return ELFPARSER_ERR_FORMAT;  // Entry overruns the unit
+            }
+        }
+        if (decl_code == code)
+        {
+            return ELFPARSER_ERR_NOT_FOUND;  // Unit without a line program
+        }
+    }
+}
+
+/**
+ * @brief Appends a joined directory and file name to the unit being built
+ * @param[in,out] build Pointer to the build state
+ * @param[in] name File name
+ * @param[in] dir_idx Directory index of the file
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_MALLOC if memory allocation fails
+ */
+static int DwarfLine_fileAdd(dwarfline_build_t *build, const char *name, uint64_t dir_idx)
+{
+    const char *parts[3] = { "", "", name };  // Compilation directory, include directory, file name
+    if (name[0] != '/' && dir_idx < build->dir_num)
+    {
+        parts[1] = build->dirs[dir_idx];
+        if (dir_idx != 0 && parts[1][0] != '/' && build->dir_num > 0)
+        {
+            parts[0] = build->dirs[0];  // Relative include directories hang off the compilation directory
+        }
+    }
+
+    size_t len[3];
+    size_t total = 1;  // Terminator
+    for (int i = 0; i < 3; i++)
+    {
+        len[i] = strlen(parts[i]);
+        total += len[i] + 1u;  // Room for a separator
+    }
+    if (DwarfLine_grow((void **)&build->file_off, &build->file_cap, (uint64_t)build->file_num + 1u, sizeof(uint32_t)) < 0 ||
+        build->arena_len + total > UINT32_MAX)
+    {
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure or arena beyond 32-bit offsets
+    }
+    if (build->arena_len + total > build->arena_cap)
+    {
+        size_t cap = build->arena_cap ? build->arena_cap * 2u : 256u;
+        cap = (cap < build->arena_len + total) ? build->arena_len + total : cap;
+        char *grown = realloc(build->arena, cap);
+        if (!grown)
+        {
+            return ELFPARSER_ERR_MALLOC;  // Allocation failure
+        }
+        build->arena = grown;
+        build->arena_cap = cap;
+    }
+
+    char *dst = build->arena + build->arena_len;
+    build->file_off[build->file_num++] = (uint32_t)build->arena_len;
+    for (int i = 0; i < 3; i++)
+    {
+        if (len[i] == 0)
+        {
+            continue;
+        }
+        if (dst != build->arena + build->arena_len && dst[-1] != '/')
+        {
+            *dst++ = '/';  // Separator between non-empty parts
+        }
+        memcpy(dst, parts[i], len[i]);
+        dst += len[i];
+    }
+    *dst++ = '\0';
+    build->arena_len = (size_t)(dst - build->arena);
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Reads the DWARF 5 directory or file name table of a line table header
+ * @param[in,out] dwarf_line Pointer to the line table structure
+ * @param[in,out] cur Pointer to the cursor, positioned at the entry format count
+ * @param[in,out] build Pointer to the build state receiving directories or files
+ * @param[in] offset_size 4 or 8 for the DWARF format of the unit
+ * @param[in] is_file Non-zero for the file name table
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_FORMAT if the table is malformed,
+ *             or the error of the reader or allocator
+ */
+static int DwarfLine_entryTableRead(elfparser_dwarfline_t *dwarf_line, dwarfline_cursor_t *cur, dwarfline_build_t *build,
+                                    size_t offset_size, int is_file)
+{
+    uint64_t fmt_type[UINT8_MAX];
+    uint64_t fmt_form[UINT8_MAX];
+    uint32_t fmt_num = (uint32_t)DwarfLine_fixedRead(cur, 1u);
+    for (uint32_t f = 0; f < fmt_num; f++)
+    {
+        fmt_type[f] = DwarfLine_ulebRead(cur);
+        fmt_form[f] = DwarfLine_ulebRead(cur);
+    }
+    uint64_t entry_num = DwarfLine_ulebRead(cur);
+    if (cur->fail || entry_num > (uint64_t)(cur->end - cur->pos))
+    {
+        return ELFPARSER_ERR_FORMAT;  // Every entry takes at least one byte
+    }
+
+    for (uint64_t e = 0; e < entry_num; e++)
+    {
+        const char *path = "";
+        uint64_t dir_idx = 0;
+        for (uint32_t f = 0; f < fmt_num; f++)
+        {
+            if (fmt_type[f] == DWARFLINE_LNCT_PATH)
+            {
+                int ret = DwarfLine_formStrRead(dwarf_line, cur, fmt_form[f], offset_size, &path);
+                if (ret < 0)
+                {
+                    return ret;  // Unreadable path
+                }
+            }
+            else if (fmt_type[f] == DWARFLINE_LNCT_DIRECTORY_INDEX)
+            {
+                dir_idx = DwarfLine_formUnsignedRead(cur, fmt_form[f], offset_size, dwarf_line->addr_size);
+            }
+            else
+            {
+                DwarfLine_formSkip(cur, fmt_form[f], offset_size, dwarf_line->addr_size, DWARFLINE_VERSION_MAX, 0);  // Timestamp, size, MD5, vendor
+            }
+        }
+        if (cur->fail)
+        {
+            return ELFPARSER_ERR_FORMAT;  // Truncated entry
+        }
+        if (is_file)
+        {
+            int ret = DwarfLine_fileAdd(build, path, dir_idx);
+            if (ret < 0)
+            {
+                return ret;  // Allocation failure
+            }
+        }
+        else
+        {
+            if (DwarfLine_grow((void **)&build->dirs, &build->dir_cap, (uint64_t)build->dir_num + 1u, sizeof(const char *)) < 0)
+            {
+                return ELFPARSER_ERR_MALLOC;  // Allocation failure
+            }
+            build->dirs[build->dir_num++] = path;
+        }
+    }
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Appends a row to the unit being built, merging rows that cover no address
+ * @param[in,out] build Pointer to the build state
+ * @param[in] seq_begin First row of the current sequence
+ * @param[in] addr Address of the row
+ * @param[in] file File index, ELFPARSER_DWARFLINE_FILE_END for the end of a sequence
+ * @param[in] line Source line
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_MALLOC if memory allocation fails
+ */
+static int DwarfLine_rowAdd(dwarfline_build_t *build, uint32_t seq_begin, uint64_t addr, uint32_t file, uint32_t line)
+{
+    if (build->row_num > seq_begin && build->rows[build->row_num - 1u].row_addr == addr)
+    {
+        build->row_num--;  // The previous row covers no address, the later one wins
+    }
+    if (DwarfLine_grow((void **)&build->rows, &build->row_cap, (uint64_t)build->row_num + 1u, sizeof(elfparser_dwarfline_row_t)) < 0)
+    {
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+    elfparser_dwarfline_row_t *row = &build->rows[build->row_num++];
+    row->row_addr = addr;
+    row->row_file = file;
+    row->row_line = line;
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Orders sequences by start address for qsort()
+ * @param[in] lhs First sequence
+ * @param[in] rhs Second sequence
+ * @return int Negative, zero or positive as for qsort()
+ */
+static int DwarfLine_seqCompare(const void *lhs, const void *rhs)
+{
+    const dwarfline_seq_t *a = lhs;
+    const dwarfline_seq_t *b = rhs;
+    if (a->start_addr != b->start_addr)
+    {
+        return (a->start_addr > b->start_addr) - (a->start_addr < b->start_addr);
+    }
+    return (a->begin > b->begin) - (a->begin < b->begin);  // Program order for equal starts
+}
+
+/**
+ * @brief Runs a line number program
+ * @param[in,out] cur Pointer to the cursor covering the program
+ * @param[in,out] build Pointer to the build state receiving rows and sequences
+ * @param[in] header Header fields: min_inst, line_base, line_range, opcode_base, version
+ * @param[in] std_lens Operand counts of the standard opcodes
+ * @param[in] addr_mask Mask of a target address
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_FORMAT if the program is malformed,
+ *             ELFPARSER_ERR_MALLOC if memory allocation fails
+ */
+static int DwarfLine_programRun(dwarfline_cursor_t *cur, dwarfline_build_t *build, const int32_t header[5],
+                                const uint8_t *std_lens, uint64_t addr_mask)
+{
+    const uint64_t min_inst = (uint64_t)header[0];
+    const int32_t line_base = header[1];
+    const uint32_t line_range = (uint32_t)header[2];
+    const uint32_t opcode_base = (uint32_t)header[3];
+    const uint32_t version = (uint32_t)header[4];
+    const uint64_t const_add = ((255u - opcode_base) / line_range) * min_inst;
+    uint64_t addr = 0;
+    uint32_t file = 1;
+    uint32_t line = 1;
+    uint32_t seq_begin = build->row_num;
+    int ret = ELFPARSER_SUCCESS;
+
+    while (cur->pos < cur->end && ret == ELFPARSER_SUCCESS)
+    {
+        uint32_t op = *cur->pos++;
+        if (op >= opcode_base)  // Special opcode: advance address and line, append a row
+        {
+            uint32_t adj = op - opcode_base;
+            addr += (adj / line_range) * min_inst;
+            line += (uint32_t)(line_base + (int32_t)(adj % line_range));
+            ret = DwarfLine_rowAdd(build, seq_begin, addr & addr_mask, file, line);
+            continue;
+        }
+        switch (op)
+        {
+            case 0:  // Extended opcode
+            {
+                uint64_t len = DwarfLine_ulebRead(cur);
+                if (cur->fail || len == 0 || len > (uint64_t)(cur->end - cur->pos))
+                {
+                    return ELFPARSER_ERR_FORMAT;  // Operand overruns the program
+                }
+                const uint8_t *next = cur->pos + len;
+                uint32_t sub = *cur->pos++;
+                if (sub == DWARFLINE_LNE_END_SEQUENCE)
+                {
+                    if (build->row_num > seq_begin)  // Empty sequences are dropped
+                    {
+                        ret = DwarfLine_rowAdd(build, seq_begin, addr & addr_mask, ELFPARSER_DWARFLINE_FILE_END, 0);
+                        if (ret == ELFPARSER_SUCCESS && build->row_num - seq_begin < 2u)
+                        {
+                            build->row_num = seq_begin;  // Only the end row is left
+                        }
+                        else if (ret == ELFPARSER_SUCCESS)
+                        {
+                            ret = DwarfLine_grow((void **)&build->seqs, &build->seq_cap, (uint64_t)build->seq_num + 1u, sizeof(dwarfline_seq_t));
+                            if (ret == ELFPARSER_SUCCESS)
+                            {
+                                dwarfline_seq_t *seq = &build->seqs[build->seq_num++];
+                                seq->start_addr = build->rows[seq_begin].row_addr;
+                                seq->begin = seq_begin;
+                                seq->end = build->row_num;
+                            }
+                        }
+                    }
+                    seq_begin = build->row_num;
+                    addr = 0;
+                    file = 1;
+                    line = 1;
+                }
+                else if (sub == DWARFLINE_LNE_SET_ADDRESS && len - 1u >= 1u && len - 1u <= 8u)
+                {
+                    addr = DwarfLine_fixedRead(cur, (size_t)(len - 1u));
+                }
+                else if (sub == DWARFLINE_LNE_DEFINE_FILE && version < 5u)
+                {
+                    const char *name = DwarfLine_cstrRead(cur);
+                    uint64_t dir_idx = DwarfLine_ulebRead(cur);
+                    if (!cur->fail)
+                    {
+                        ret = DwarfLine_fileAdd(build, name, dir_idx);
+                    }
+                }
+                cur->pos = next;  // Unknown or fully read, continue after the operands
+                cur->fail = 0;
+                break;
+            }
+            case DWARFLINE_LNS_COPY:
+                ret = DwarfLine_rowAdd(build, seq_begin, addr & addr_mask, file, line);
+                break;
+            case DWARFLINE_LNS_ADVANCE_PC:
+                addr += DwarfLine_ulebRead(cur) * min_inst;
+                break;
+            case DWARFLINE_LNS_ADVANCE_LINE:
+                line += (uint32_t)DwarfLine_slebRead(cur);
+                break;
+            case DWARFLINE_LNS_SET_FILE:
+                file = (uint32_t)DwarfLine_ulebRead(cur);
+                file = (file == ELFPARSER_DWARFLINE_FILE_END) ? file - 1u : file;  // Keep the end marker unambiguous
+                break;
+            case DWARFLINE_LNS_CONST_ADD_PC:
+                addr += const_add;
+                break;
+            case DWARFLINE_LNS_FIXED_ADVANCE_PC:
+                addr += DwarfLine_fixedRead(cur, 2u);
+                break;
+            default:  // Column, statement and block flags, and opcodes this reader does not need
+                for (uint32_t n = 0; n < std_lens[op - 1u]; n++)
+                {
+                    (void)DwarfLine_ulebRead(cur);
+                }
+                break;
+        }
+        if (cur->fail)
+        {
+            return ELFPARSER_ERR_FORMAT;  // Operand overruns the program
+        }
+    }
+    build->row_num = (ret == ELFPARSER_SUCCESS) ? seq_begin : build->row_num;  // Drop an unterminated sequence
+    return ret;
+}
+
+/**
+ * @brief Decodes the line program of a unit into its sorted rows and file names
+ * @param[in,out] dwarf_line Pointer to the line table structure
+ * @param[in,out] unit Pointer to the unit, line_offset resolved
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_FORMAT if the program is malformed,
+ *             or the error of the reader or allocator
+ */
+static int DwarfLine_unitDecode(elfparser_dwarfline_t *dwarf_line, elfparser_dwarfline_unit_t *unit)
+{
+    dwarfline_build_t build;
+    dwarfline_cursor_t cur = { dwarf_line->line_data, dwarf_line->line_data + dwarf_line->line_size, dwarf_line->big_endian, 0 };
+    size_t offset_size;
+    int ret = ELFPARSER_ERR_FORMAT;
+
+    memset(&build, 0, sizeof(build));
+    if (unit->line_offset >= dwarf_line->line_size)
+    {
+        return ELFPARSER_ERR_FORMAT;  // Offset outside .debug_line
+    }
+    DwarfLine_skip(&cur, unit->line_offset);
+    const uint8_t *unit_end = DwarfLine_unitLengthRead(&cur, &offset_size);
+    if (!unit_end)
+    {
+        return ELFPARSER_ERR_FORMAT;  // Bad unit length
+    }
+    cur.end = unit_end;
+
+    uint32_t version = (uint32_t)DwarfLine_fixedRead(&cur, 2u);
+    size_t addr_size = dwarf_line->addr_size;
+    if (version >= 5u)
+    {
+        addr_size = (size_t)DwarfLine_fixedRead(&cur, 1u);
+        DwarfLine_skip(&cur, 1u);  // segment_selector_size
+    }
+    uint64_t header_length = DwarfLine_fixedRead(&cur, offset_size);
+    if (cur.fail || header_length > (uint64_t)(cur.end - cur.pos))
+    {
+        return ELFPARSER_ERR_FORMAT;  // Header overruns the unit
+    }
+    const uint8_t *program = cur.pos + header_length;
+    int32_t header[5];
+    header[0] = (int32_t)DwarfLine_fixedRead(&cur, 1u);             // minimum_instruction_length
+    if (version >= 4u)
+    {
+        DwarfLine_skip(&cur, 1u);                                   // maximum_operations_per_instruction (VLIW only)
+    }
+    DwarfLine_skip(&cur, 1u);                                       // default_is_stmt
+    header[1] = (int8_t)DwarfLine_fixedRead(&cur, 1u);              // line_base
+    header[2] = (int32_t)DwarfLine_fixedRead(&cur, 1u);             // line_range
+    header[3] = (int32_t)DwarfLine_fixedRead(&cur, 1u);             // opcode_base
+    header[4] = (int32_t)version;
+    const uint8_t *std_lens = cur.pos;
+    DwarfLine_skip(&cur, header[3] ? (uint64_t)header[3] - 1u : 0);
+    if (cur.fail || version < DWARFLINE_VERSION_MIN || version > DWARFLINE_VERSION_MAX || header[2] == 0 || header[3] == 0 ||
+        addr_size == 0 || addr_size > 8u)
+    {
+        return ELFPARSER_ERR_FORMAT;  // Unsupported version or malformed header
+    }
+
+    if (version >= 5u)  // Typed directory and file tables
+    {
+        ret = DwarfLine_entryTableRead(dwarf_line, &cur, &build, offset_size, 0);
+        if (ret == ELFPARSER_SUCCESS)
+        {
+            ret = DwarfLine_entryTableRead(dwarf_line, &cur, &build, offset_size, 1);
+        }
+    }
+    else  // String lists; directory 0 and file 0 are implicit
+    {
+        ret = DwarfLine_grow((void **)&build.dirs, &build.dir_cap, 1u, sizeof(const char *));
+        if (ret == ELFPARSER_SUCCESS)
+        {
+            build.dirs[build.dir_num++] = "";  // Compilation directory is not in the line table header
+            ret = DwarfLine_fileAdd(&build, "", 0);
+        }
+        for (const char *dir = DwarfLine_cstrRead(&cur); ret == ELFPARSER_SUCCESS && !cur.fail && dir[0]; dir = DwarfLine_cstrRead(&cur))
+        {
+            ret = DwarfLine_grow((void **)&build.dirs, &build.dir_cap, (uint64_t)build.dir_num + 1u, sizeof(const char *));
+            if (ret == ELFPARSER_SUCCESS)
+            {
+                build.dirs[build.dir_num++] = dir;
+            }
+        }
+        for (const char *name = DwarfLine_cstrRead(&cur); ret == ELFPARSER_SUCCESS && !cur.fail && name[0]; name = DwarfLine_cstrRead(&cur))
+        {
+            uint64_t dir_idx = DwarfLine_ulebRead(&cur);
+            (void)DwarfLine_ulebRead(&cur);  // Modification time
+            (void)DwarfLine_ulebRead(&cur);  // File size
+            ret = DwarfLine_fileAdd(&build, name, dir_idx);
+        }
+        ret = (ret == ELFPARSER_SUCCESS && cur.fail) ? ELFPARSER_ERR_FORMAT : ret;
+    }
+
+    if (ret == ELFPARSER_SUCCESS)
+    {
+        cur.pos = program;
+        cur.fail = 0;
+        ret = DwarfLine_programRun(&cur, &build, header, std_lens, (addr_size == 8u) ? UINT64_MAX : ((uint64_t)1 << (addr_size * 8u)) - 1u);
+    }
+    if (ret == ELFPARSER_SUCCESS)
+    {
+        int sorted = 1;
+        for (uint32_t s = 1; s < build.seq_num && sorted; s++)
+        {
+            sorted = (build.seqs[s - 1u].start_addr <= build.seqs[s].start_addr);
+        }
+        if (!sorted)  // Sequences out of address order: move whole sequences
+        {
+            elfparser_dwarfline_row_t *rows = malloc(((size_t)build.row_num ? build.row_num : 1) * sizeof(elfparser_dwarfline_row_t));
+            if (!rows)
+            {
+                ret = ELFPARSER_ERR_MALLOC;  // Allocation failure
+            }
+            else
+            {
+                qsort(build.seqs, build.seq_num, sizeof(dwarfline_seq_t), DwarfLine_seqCompare);
+                uint32_t pos = 0;
+                for (uint32_t s = 0; s < build.seq_num; s++)
+                {
+                    memcpy(&rows[pos], &build.rows[build.seqs[s].begin], (size_t)(build.seqs[s].end - build.seqs[s].begin) * sizeof(elfparser_dwarfline_row_t));
+                    pos += build.seqs[s].end - build.seqs[s].begin;
+                }
+                free(build.rows);
+                build.rows = rows;
+            }
+        }
+    }
+
+    free(build.dirs);
+    free(build.seqs);
+    if (ret < 0)
+    {
+        free(build.rows);
+        free(build.arena);
+        free(build.file_off);
+        return ret;  // Malformed unit or resource failure
+    }
+    unit->rows = build.rows;
+    unit->row_num = build.row_num;
+    unit->name_arena = build.arena;
+    unit->file_name_off = build.file_off;
+    unit->file_num = build.file_num;
+    unit->state = ELFPARSER_DWARFLINE_UNIT_DECODED;
+    dwarf_line->decoded_num++;
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Makes sure a unit is decoded, marking it invalid if it cannot be
+ * @param[in,out] dwarf_line Pointer to the line table structure
+ * @param[in] unit_idx Index of the unit
+ * @return int ELFPARSER_SUCCESS once the unit is decoded or invalid, or a resource error of the reader or allocator
+ */
+static int DwarfLine_unitEnsure(elfparser_dwarfline_t *dwarf_line, uint32_t unit_idx)
+{
+    elfparser_dwarfline_unit_t *unit = &dwarf_line->units[unit_idx];
+    int ret = ELFPARSER_SUCCESS;
+
+    if (unit->state != ELFPARSER_DWARFLINE_UNIT_PENDING)
+    {
+        return ELFPARSER_SUCCESS;  // Already decided
+    }
+    if (unit->line_offset == ELFPARSER_DWARFLINE_OFFSET_NONE)
+    {
+        ret = DwarfLine_stmtListFind(dwarf_line, unit->info_offset, &unit->line_offset);
+    }
+    if (ret == ELFPARSER_SUCCESS)
+    {
+        ret = DwarfLine_unitDecode(dwarf_line, unit);
+    }
+    if (ret == ELFPARSER_ERR_MALLOC || ret == ELFPARSER_ERR_IO)
+    {
+        return ret;  // Resource failure, the unit stays pending
+    }
+    if (ret < 0)
+    {
+        unit->state = ELFPARSER_DWARFLINE_UNIT_INVALID;  // Malformed, never retried
+    }
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Appends a unit
+ * @param[in,out] dwarf_line Pointer to the line table structure
+ * @param[in] info_offset Offset of the unit in .debug_info, or ELFPARSER_DWARFLINE_OFFSET_NONE
+ * @param[in] line_offset Offset of the line program, or ELFPARSER_DWARFLINE_OFFSET_NONE
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_MALLOC if memory allocation fails
+ */
+static int DwarfLine_unitAdd(elfparser_dwarfline_t *dwarf_line, uint64_t info_offset, uint64_t line_offset)
+{
+    if (DwarfLine_grow((void **)&dwarf_line->units, &dwarf_line->unit_cap, (uint64_t)dwarf_line->unit_num + 1u, sizeof(elfparser_dwarfline_unit_t)) < 0)
+    {
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+    elfparser_dwarfline_unit_t *unit = &dwarf_line->units[dwarf_line->unit_num++];
+    memset(unit, 0, sizeof(*unit));
+    unit->info_offset = info_offset;
+    unit->line_offset = line_offset;
+    unit->state = ELFPARSER_DWARFLINE_UNIT_PENDING;
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Appends an address range
+ * @param[in,out] dwarf_line Pointer to the line table structure
+ * @param[in] start First address
+ * @param[in] end One past the last address
+ * @param[in] unit_idx Index of the unit covering the range
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_MALLOC if memory allocation fails
+ */
+static int DwarfLine_rangeAdd(elfparser_dwarfline_t *dwarf_line, uint64_t start, uint64_t end, uint32_t unit_idx)
+{
+    if (DwarfLine_grow((void **)&dwarf_line->ranges, &dwarf_line->range_cap, (uint64_t)dwarf_line->range_num + 1u, sizeof(elfparser_dwarfline_range_t)) < 0)
+    {
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+    elfparser_dwarfline_range_t *range = &dwarf_line->ranges[dwarf_line->range_num++];
+    range->range_start = start;
+    range->range_end = end;
+    range->unit_idx = unit_idx;
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Orders ranges by start address for qsort()
+ * @param[in] lhs First range
+ * @param[in] rhs Second range
+ * @return int Negative, zero or positive as for qsort()
+ */
+static int DwarfLine_rangeCompare(const void *lhs, const void *rhs)
+{
+    const elfparser_dwarfline_range_t *a = lhs;
+    const elfparser_dwarfline_range_t *b = rhs;
+    if (a->range_start != b->range_start)
+    {
+        return (a->range_start > b->range_start) - (a->range_start < b->range_start);
+    }
+    return (a->unit_idx > b->unit_idx) - (a->unit_idx < b->unit_idx);  // Deterministic order for equal starts
+}
+
+/**
+ * @brief Sorts the ranges and rebuilds the running maximum of their ends
+ * @param[in,out] dwarf_line Pointer to the line table structure
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_MALLOC if memory allocation fails
+ */
+static int DwarfLine_rangesSort(elfparser_dwarfline_t *dwarf_line)
+{
+    qsort(dwarf_line->ranges, dwarf_line->range_num, sizeof(elfparser_dwarfline_range_t), DwarfLine_rangeCompare);
+    uint64_t *max_end = realloc(dwarf_line->range_max_end, ((size_t)dwarf_line->range_num ? dwarf_line->range_num : 1) * sizeof(uint64_t));
+    if (!max_end)
+    {
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+    dwarf_line->range_max_end = max_end;
+    uint64_t running = 0;
+    for (uint32_t i = 0; i < dwarf_line->range_num; i++)
+    {
+        running = (dwarf_line->ranges[i].range_end > running) ? dwarf_line->ranges[i].range_end : running;
+        max_end[i] = running;
+    }
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Reads .debug_aranges into units and ranges
+ * @param[in,out] dwarf_line Pointer to the line table structure
+ * @param[in] data Contents of .debug_aranges
+ * @param[in] size Size of the contents in bytes
+ * @return int ELFPARSER_SUCCESS on success (malformed sets are skipped), ELFPARSER_ERR_MALLOC if memory allocation fails
+ */
+static int DwarfLine_arangesRead(elfparser_dwarfline_t *dwarf_line, const uint8_t *data, size_t size)
+{
+    dwarfline_cursor_t cur = { data, data + size, dwarf_line->big_endian, 0 };
+
+    while (cur.pos < cur.end)
+    {
+        const uint8_t *set_start = cur.pos;
+        size_t offset_size;
+        const uint8_t *set_end = DwarfLine_unitLengthRead(&cur, &offset_size);
+        if (!set_end)
+        {
+            break;  // Nothing after a bad length can be located
+        }
+        cur.end = set_end;
+        uint32_t version = (uint32_t)DwarfLine_fixedRead(&cur, 2u);
+        uint64_t info_offset = DwarfLine_fixedRead(&cur, offset_size);
+        size_t addr_size = (size_t)DwarfLine_fixedRead(&cur, 1u);
+        size_t seg_size = (size_t)DwarfLine_fixedRead(&cur, 1u);
+        if (!cur.fail && version == 2u && addr_size >= 1u && addr_size <= 8u && seg_size <= 8u)
+        {
+            size_t tuple_align = 2u * addr_size;
+            size_t header_len = (size_t)(cur.pos - set_start);
+            DwarfLine_skip(&cur, (tuple_align - header_len % tuple_align) % tuple_align);  // Tuples are aligned to their size
+            uint32_t unit_idx = dwarf_line->unit_num;
+            if (unit_idx > 0 && dwarf_line->units[unit_idx - 1u].info_offset == info_offset)
+            {
+                unit_idx--;  // Continuation of the previous unit's set
+            }
+            else if (DwarfLine_unitAdd(dwarf_line, info_offset, ELFPARSER_DWARFLINE_OFFSET_NONE) < 0)
+            {
+                return ELFPARSER_ERR_MALLOC;  // Allocation failure
+            }
+            while (!cur.fail && (size_t)(cur.end - cur.pos) >= seg_size + tuple_align)
+            {
+                DwarfLine_skip(&cur, seg_size);
+                uint64_t start = DwarfLine_fixedRead(&cur, addr_size);
+                uint64_t length = DwarfLine_fixedRead(&cur, addr_size);
+                if (start == 0 && length == 0)
+                {
+                    break;  // Terminator
+                }
+                if (length && DwarfLine_rangeAdd(dwarf_line, start, (start + length < start) ? UINT64_MAX : start + length, unit_idx) < 0)
+                {
+                    return ELFPARSER_ERR_MALLOC;  // Allocation failure
+                }
+            }
+        }
+        cur.pos = set_end;
+        cur.end = data + size;
+        cur.fail = 0;
+    }
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Orders line offsets for qsort() and bsearch()
+ * @param[in] lhs First offset
+ * @param[in] rhs Second offset
+ * @return int Negative, zero or positive as for qsort()
+ */
+static int DwarfLine_offsetCompare(const void *lhs, const void *rhs)
+{
+    uint64_t a = *(const uint64_t *)lhs;
+    uint64_t b = *(const uint64_t *)rhs;
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief Decodes every line program no range leads to and indexes its sequences
+ *
+ * Resolves the line offset of every unit known from .debug_aranges, then
+ * walks the unit headers of .debug_line and decodes the programs none of
+ * them claims.
+ *
+ * @param[in,out] dwarf_line Pointer to the line table structure
+ * @return int ELFPARSER_SUCCESS on success, or a resource error of the reader or allocator
+ */
+static int DwarfLine_sweep(elfparser_dwarfline_t *dwarf_line)
+{
+    uint32_t claimed_num = dwarf_line->unit_num;
+    uint64_t *claimed = malloc(((size_t)claimed_num ? claimed_num : 1) * sizeof(uint64_t));
+    if (!claimed)
+    {
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+    for (uint32_t u = 0; u < claimed_num; u++)
+    {
+        elfparser_dwarfline_unit_t *unit = &dwarf_line->units[u];
+        if (unit->line_offset == ELFPARSER_DWARFLINE_OFFSET_NONE && unit->state == ELFPARSER_DWARFLINE_UNIT_PENDING)
+        {
+            int ret = DwarfLine_stmtListFind(dwarf_line, unit->info_offset, &unit->line_offset);
+            if (ret == ELFPARSER_ERR_MALLOC || ret == ELFPARSER_ERR_IO)
+            {
+                free(claimed);
+                return ret;  // Resource failure
+            }
+            if (ret < 0)
+            {
+                unit->state = ELFPARSER_DWARFLINE_UNIT_INVALID;  // No usable line program
+            }
+        }
+        claimed[u] = unit->line_offset;
+    }
+    qsort(claimed, claimed_num, sizeof(uint64_t), DwarfLine_offsetCompare);
+
+    dwarfline_cursor_t cur = { dwarf_line->line_data, dwarf_line->line_data + dwarf_line->line_size, dwarf_line->big_endian, 0 };
+    int ret = ELFPARSER_SUCCESS;
+    while (cur.pos < cur.end && ret == ELFPARSER_SUCCESS)
+    {
+        uint64_t offset = (uint64_t)(cur.pos - dwarf_line->line_data);
+        size_t offset_size;
+        const uint8_t *unit_end = DwarfLine_unitLengthRead(&cur, &offset_size);
+        if (!unit_end)
+        {
+            break;  // Nothing after a bad length can be located
+        }
+        cur.pos = unit_end;
+        if (bsearch(&offset, claimed, claimed_num, sizeof(uint64_t), DwarfLine_offsetCompare))
+        {
+            continue;  // Reached through .debug_aranges
+        }
+        ret = DwarfLine_unitAdd(dwarf_line, ELFPARSER_DWARFLINE_OFFSET_NONE, offset);
+        uint32_t unit_idx = dwarf_line->unit_num - 1u;
+        if (ret == ELFPARSER_SUCCESS)
+        {
+            ret = DwarfLine_unitEnsure(dwarf_line, unit_idx);
+        }
+        const elfparser_dwarfline_unit_t *unit = &dwarf_line->units[unit_idx];
+        for (uint32_t r = 0, seq_begin = 0; ret == ELFPARSER_SUCCESS && r < unit->row_num; r++)  // One range per sequence
+        {
+            if (unit->rows[r].row_file == ELFPARSER_DWARFLINE_FILE_END)
+            {
+                if (unit->rows[r].row_addr > unit->rows[seq_begin].row_addr)
+                {
+                    ret = DwarfLine_rangeAdd(dwarf_line, unit->rows[seq_begin].row_addr, unit->rows[r].row_addr, unit_idx);
+                }
+                seq_begin = r + 1u;
+            }
+        }
+    }
+    free(claimed);
+    if (ret == ELFPARSER_SUCCESS)
+    {
+        ret = DwarfLine_rangesSort(dwarf_line);
+    }
+    dwarf_line->swept = (ret == ELFPARSER_SUCCESS);
+    return ret;
+}
+
+/**
+ * @brief Finds the row covering an address within a decoded unit
+ * @param[in] unit Pointer to a decoded unit
+ * @param[in] addr Address to resolve
+ * @param[in] from First row that may cover addr
+ * @param[out] loc Pointer to the location to fill
+ * @return int64_t Index of the row, or -1 if no row covers addr
+ */
+static int64_t DwarfLine_rowFind(const elfparser_dwarfline_unit_t *unit, uint64_t addr, uint32_t from, elfparser_dwarfline_loc_t *loc)
+{
+    uint32_t lo = from;
+    uint32_t hi = unit->row_num;
+
+    while (lo < hi)  // First row starting above addr
+    {
+        uint32_t mid = lo + (hi - lo) / 2u;
+        if (unit->rows[mid].row_addr <= addr)
+        {
+            lo = mid + 1u;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    if (lo == 0 || unit->rows[lo - 1u].row_file == ELFPARSER_DWARFLINE_FILE_END)
+    {
+        return -1;  // Before the first row or in a gap between sequences
+    }
+    const elfparser_dwarfline_row_t *row = &unit->rows[lo - 1u];
+    loc->file_name = (row->row_file < unit->file_num) ? unit->name_arena + unit->file_name_off[row->row_file] : "";
+    loc->line = row->row_line;
+    loc->row_addr = row->row_addr;
+    return (int64_t)(lo - 1u);
+}
+
+/**
+ * @brief Resolves an address through the range index, sweeping once on a miss
+ * @param[in,out] dwarf_line Pointer to the line table structure
+ * @param[in] addr Address to resolve
+ * @param[out] loc Pointer to the location to fill
+ * @param[out] range_hint Set to the index of the range that resolved addr
+ * @param[out] row_hint Set to the index of the row that resolved addr
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NOT_FOUND if no row covers addr,
+ *             or a resource error of the reader or allocator
+ */
+static int DwarfLine_find(elfparser_dwarfline_t *dwarf_line, uint64_t addr, elfparser_dwarfline_loc_t *loc,
+                          uint32_t *range_hint, uint32_t *row_hint)
+{
+    for (;;)
+    {
+        uint32_t lo = 0;
+        uint32_t hi = dwarf_line->range_num;
+        while (lo < hi)  // First range starting above addr
+        {
+            uint32_t mid = lo + (hi - lo) / 2u;
+            if (dwarf_line->ranges[mid].range_start <= addr)
+            {
+                lo = mid + 1u;
+            }
+            else
+            {
+                hi = mid;
+            }
+        }
+        for (uint32_t i = lo; i-- > 0 && dwarf_line->range_max_end[i] > addr;)  // Every range that may still cover addr
+        {
+            if (dwarf_line->ranges[i].range_end <= addr)
+            {
+                continue;
+            }
+            uint32_t unit_idx = dwarf_line->ranges[i].unit_idx;
+            int ret = DwarfLine_unitEnsure(dwarf_line, unit_idx);
+            if (ret < 0)
+            {
+                return ret;  // Resource failure
+            }
+            int64_t row = DwarfLine_rowFind(&dwarf_line->units[unit_idx], addr, 0, loc);
+            if (row >= 0)
+            {
+                *range_hint = i;
+                *row_hint = (uint32_t)row;
+                return ELFPARSER_SUCCESS;  // Found
+            }
+        }
+        if (dwarf_line->swept)
+        {
+            return ELFPARSER_ERR_NOT_FOUND;  // Every unit is reachable, nothing covers addr
+        }
+        int ret = DwarfLine_sweep(dwarf_line);
+        if (ret < 0)
+        {
+            return ret;  // Resource failure
+        }
+    }
+}
+
+/**
+ * @brief Opens the line tables of a file and indexes the unit address ranges
+ * @param[out] dwarf_line Pointer to the structure to initialize
+ * @param[in,out] file Pointer to an open file structure
+ * @return int ELFPARSER_SUCCESS on success, or the error of ElfParser_DwarfLine_openCached()
+ */
+int ElfParser_DwarfLine_open(elfparser_dwarfline_t *dwarf_line, elfparser_file_t *file)
+{
+    return ElfParser_DwarfLine_openCached(dwarf_line, file, NULL);
+}
+
+/**
+ * @brief Opens the line tables of a file, decompressing compressed debug sections through a cache
+ * @param[out] dwarf_line Pointer to the structure to initialize
+ * @param[in,out] file Pointer to an open file structure
+ * @param[in,out] cache Pointer to an initialized section cache, NULL to reject compressed sections
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_NOT_FOUND if the file has no .debug_line, ELFPARSER_ERR_FORMAT if it is compressed
+ *             and there is no cache or it cannot be decompressed,
+ *             or the error of the header, section header, reader, cache or allocator functions
+ */
+int ElfParser_DwarfLine_openCached(elfparser_dwarfline_t *dwarf_line, elfparser_file_t *file, elfparser_sectcache_t *cache)
+{
+    if (!dwarf_line || !file)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    memset(dwarf_line, 0, sizeof(*dwarf_line));
+
+    const elfparser_header_t *header;
+    const elfparser_secthead_t *sect_head;
+    int ret = ElfParser_File_headerGet(file, &header);
+    if (ret == ELFPARSER_SUCCESS)
+    {
+        ret = ElfParser_File_sectHeadGet(file, &sect_head);
+    }
+    if (ret < 0)
+    {
+        return ret;  // Not an ELF file or no section headers
+    }
+    int32_t line_idx = ElfParser_SectHead_byNameFind(sect_head, DWARFLINE_SECT_LINE, 0);
+    if (line_idx < 0)
+    {
+        return line_idx;  // No line tables
+    }
+    dwarf_line->file = file;
+    dwarf_line->cache = cache;
+    const void *data;
+    size_t size;
+    ret = DwarfLine_sectionGet(dwarf_line, sect_head, (uint32_t)line_idx, &data, &size);
+    if (ret < 0)
+    {
+        memset(dwarf_line, 0, sizeof(*dwarf_line));
+        return ret;  // Unreadable or compressed
+    }
+    if (!data)
+    {
+        memset(dwarf_line, 0, sizeof(*dwarf_line));
+        return ELFPARSER_ERR_NOT_FOUND;  // SHT_NOBITS placeholder (separate debug file)
+    }
+    dwarf_line->line_data = data;
+    dwarf_line->line_size = size;
+    dwarf_line->big_endian = (header->elf_ident.elf_data == ELFPARSER_HEADER_DATA_BIG_ENDIANNESS);
+    dwarf_line->addr_size = (header->elf_ident.elf_class == ELFPARSER_HEADER_CLASS_64_BIT) ? 8u : 4u;
+    ret = DwarfLine_grow((void **)&dwarf_line->ranges, &dwarf_line->range_cap, DWARFLINE_RANGE_INITIAL, sizeof(elfparser_dwarfline_range_t));
+
+    int32_t aranges_idx = ElfParser_SectHead_byNameFind(sect_head, DWARFLINE_SECT_ARANGES, 0);
+    if (ret == ELFPARSER_SUCCESS && aranges_idx >= 0 &&
+        DwarfLine_sectionGet(dwarf_line, sect_head, (uint32_t)aranges_idx, &data, &size) == ELFPARSER_SUCCESS && data)
+    {
+        ret = DwarfLine_arangesRead(dwarf_line, data, size);  // Without it, the first miss sweeps everything
+        if (cache)
+        {
+            ElfParser_SectCache_release(cache, data);  // Only needed while indexing
+        }
+    }
+    if (ret == ELFPARSER_SUCCESS)
+    {
+        ret = DwarfLine_rangesSort(dwarf_line);
+    }
+    if (ret < 0)
+    {
+        ElfParser_DwarfLine_close(dwarf_line);
+        return ret;  // Allocation failure
+    }
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Resolves an address to its source file and line
+ * @param[in,out] dwarf_line Pointer to an open line table structure
+ * @param[in] addr Address to resolve
+ * @param[out] loc Pointer to the location to fill
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_NOT_FOUND if no row covers addr, or a resource error of the reader or allocator
+ */
+int ElfParser_DwarfLine_lookup(elfparser_dwarfline_t *dwarf_line, uint64_t addr, elfparser_dwarfline_loc_t *loc)
+{
+    if (!dwarf_line || !loc || !dwarf_line->line_data)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    uint32_t range_hint;
+    uint32_t row_hint;
+    return DwarfLine_find(dwarf_line, addr, loc, &range_hint, &row_hint);
+}
+
+/**
+ * @brief Resolves a batch of addresses to source files and lines
+ * @param[in,out] dwarf_line Pointer to an open line table structure
+ * @param[in] addrs Addresses to resolve
+ * @param[in] addr_num Number of addresses
+ * @param[out] locs Array of addr_num locations to fill
+ * @param[out] status Per address: ELFPARSER_SUCCESS or ELFPARSER_ERR_NOT_FOUND
+ * @return int ELFPARSER_SUCCESS if the batch was carried out, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             or a resource error of the reader or allocator
+ */
+int ElfParser_DwarfLine_batchLookup(elfparser_dwarfline_t *dwarf_line, const uint64_t *addrs, size_t addr_num,
+                                    elfparser_dwarfline_loc_t *locs, int *status)
+{
+    if (!dwarf_line || !dwarf_line->line_data || ((!addrs || !locs || !status) && addr_num))
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+
+    uint32_t range_hint = UINT32_MAX;  // Range and row of the previous hit
+    uint32_t row_hint = 0;
+    for (size_t i = 0; i < addr_num; i++)
+    {
+        uint64_t addr = addrs[i];
+        if (range_hint != UINT32_MAX && dwarf_line->ranges[range_hint].range_start <= addr &&
+            addr < dwarf_line->ranges[range_hint].range_end)
+        {
+            const elfparser_dwarfline_unit_t *unit = &dwarf_line->units[dwarf_line->ranges[range_hint].unit_idx];
+            uint32_t from = (unit->rows[row_hint].row_addr <= addr) ? row_hint : 0;  // Ascending runs search from the last hit
+            int64_t row = DwarfLine_rowFind(unit, addr, from, &locs[i]);
+            if (row >= 0)
+            {
+                row_hint = (uint32_t)row;
+                status[i] = ELFPARSER_SUCCESS;
+                continue;
+            }
+        }
+        int ret = DwarfLine_find(dwarf_line, addr, &locs[i], &range_hint, &row_hint);
+        if (ret == ELFPARSER_ERR_NOT_FOUND)
+        {
+            memset(&locs[i], 0, sizeof(locs[i]));
+            range_hint = UINT32_MAX;
+        }
+        else if (ret < 0)
+        {
+            return ret;  // Resource failure
+        }
+        status[i] = ret;
+    }
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Frees the resources held by a line table structure
+ * @param[in,out] dwarf_line Pointer to the structure to close
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if dwarf_line is NULL
+ */
+int ElfParser_DwarfLine_close(elfparser_dwarfline_t *dwarf_line)
+{
+    if (!dwarf_line)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    for (uint32_t u = 0; u < dwarf_line->unit_num; u++)
+    {
+        free(dwarf_line->units[u].rows);  // Safe to free NULL
+        free(dwarf_line->units[u].name_arena);
+        free(dwarf_line->units[u].file_name_off);
+    }
+    free(dwarf_line->units);
+    free(dwarf_line->ranges);
+    free(dwarf_line->range_max_end);
+    if (dwarf_line->cache && dwarf_line->line_data)
+    {
+        ElfParser_SectCache_release(dwarf_line->cache, dwarf_line->line_data);
+        for (uint32_t slot = 0; slot < ELFPARSER_DWARFLINE_AUX_NUM; slot++)
+        {
+            if (dwarf_line->aux_data[slot])
+            {
+                ElfParser_SectCache_release(dwarf_line->cache, dwarf_line->aux_data[slot]);
+            }
+        }
+    }
+    memset(dwarf_line, 0, sizeof(*dwarf_line));  // Uncompressed sections stay pinned by the file
+    return ELFPARSER_SUCCESS;  // Success
+}
@@ -0,0 +1,379 @@
+/**
+ * @file elfparser_dynhash.c
+ * @brief Symbol lookups through the on-disk ELF hash tables for libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This file implements name lookups against .gnu.hash and SHT_HASH sections
+ * exactly as the dynamic linker performs them: the GNU bloom filter rejects most
+ * absent names without touching the buckets, and only the .dynsym entries on
+ * the selected chain are decoded. Nothing is allocated and no symbol table is
+ * materialized.
+ */
+
+#include "../inc_pub/elfparser_dynhash.h"
+#include "../inc_priv/elfparser_dynhash_priv.h"
+#include "../inc_priv/elfparser_symtable_priv.h"
+#include "../inc_priv/elfparser_memmanip_priv.h"
+
+/**
+ * @brief Reads an unsigned word of the file's endianness
+ * @param[in] dyn_hash Pointer to the hash table structure (provides endianness)
+ * @param[in] src Pointer to the word
+ * @param[in] size Size of the word in bytes (4 or 8)
+ * @return uint64_t Decoded value
+ */
+static inline uint64_t DynHash_wordRead(const elfparser_dynhash_t *dyn_hash, const uint8_t *src, size_t size)
+{
+    int big_endian = (dyn_hash->elf_data == ELFPARSER_HEADER_DATA_BIG_ENDIANNESS);
+
+    return (size == 8u) ? ElfParser_load64(src, big_endian) : ElfParser_load32(src, big_endian);
+}
+
+/**
+ * @brief Validates a section's file range and returns a pointer to it
+ * @param[in] entry Section header entry
+ * @param[in] map Pointer to the memory-mapped ELF file
+ * @param[in] map_size Size of the memory map in bytes
+ * @return const uint8_t* Start of the section data, NULL if it lies outside the map
+ */
+static const uint8_t *DynHash_sectionMap(const elfparser_secthead_entry_t *entry, const void *map, size_t map_size)
+{
+    if (entry->sh_offset > map_size || entry->sh_size > map_size - entry->sh_offset)
+    {
+        return NULL;  // Section extends past the map
+    }
+    return (const uint8_t *)map + entry->sh_offset;
+}
+
+/**
+ * @brief Compares a name against a string table entry without leaving the table
+ * @param[in] dyn_hash Pointer to the hash table structure
+ * @param[in] name_idx Offset of the candidate name in the string table
+ * @param[in] name Name being looked up
+ * @return int 1 if the names are equal, 0 otherwise
+ */
+static int DynHash_nameMatch(const elfparser_dynhash_t *dyn_hash, uint32_t name_idx, const char *name)
+{
+    size_t cnt = name_idx;
+
+    while (cnt < dyn_hash->str_size)
+    {
+        if (dyn_hash->str_map[cnt] != *name)
+        {
+            return 0;
+        }
+        if (*name == '\0')
+        {
+            return 1;  // Both strings ended together
+        }
+        cnt++;
+        name++;
+    }
+    return 0;  // Unterminated candidate
+}
+
+/**
+ * @brief Checks whether a symbol matches and decodes it on success
+ * @param[in] dyn_hash Pointer to the hash table structure
+ * @param[in] sym_idx Index of the candidate symbol in .dynsym
+ * @param[in] name Name being looked up
+ * @param[out] entry Optional destination for the decoded symbol
+ * @return int 1 on match, 0 if the symbol does not match, or an ElfParser_Error code on failure
+ */
+static int DynHash_symbolCheck(const elfparser_dynhash_t *dyn_hash, uint32_t sym_idx, const char *name,
+                               elfparser_symtable_entry_t *entry)
+{
+    elfparser_symtable_entry_t decoded;
+    uint32_t max_idx = 0;
+    size_t offset = (size_t)sym_idx * dyn_hash->sym_entry_size;
+
+    if (offset >= dyn_hash->sym_size)
+    {
+        return ELFPARSER_ERR_RANGE;  // Chain points past .dynsym
+    }
+    uint32_t name_idx = (uint32_t)DynHash_wordRead(dyn_hash, dyn_hash->sym_map + offset, SYMTABLE_ENTRY_NAMEIDX_SIZE);
+    if (!DynHash_nameMatch(dyn_hash, name_idx, name))
+    {
+        return 0;  // Cheap reject on st_name alone
+    }
+    int ret = ElfParser_SymTable_entriesDecode(&decoded, dyn_hash->sym_map + offset, dyn_hash->sym_size - offset, 1,
+                                               dyn_hash->sym_entry_size, dyn_hash->elf_class, dyn_hash->elf_data, &max_idx);
+    if (ret != ELFPARSER_SUCCESS)
+    {
+        return ret;
+    }
+    if (decoded.sym_sect_idx == DYNHASH_SYM_UNDEF)
+    {
+        return 0;  // Imported, not exported
+    }
+    if (entry)
+    {
+        decoded.sym_name = &dyn_hash->str_map[name_idx];  // View into .dynstr
+        decoded.sym_name_len = (uint32_t)ElfParser_strLenBounded(decoded.sym_name, dyn_hash->str_size - name_idx);
+        *entry = decoded;
+    }
+    return 1;
+}
+
+/**
+ * @brief Reads the GNU hash header and validates the table layout
+ * @param[in,out] dyn_hash Pointer to the hash table structure
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_SIZE if the section is truncated,
+ *             ELFPARSER_ERR_FORMAT if the header is inconsistent
+ */
+static int DynHash_gnuSetup(elfparser_dynhash_t *dyn_hash)
+{
+    size_t bloom_word = (dyn_hash->elf_class == ELFPARSER_HEADER_CLASS_64_BIT) ? DYNHASH_GNU_BLOOMWORD_SIZE_64BIT
+                                                                               : DYNHASH_GNU_BLOOMWORD_SIZE_32BIT;
+
+    if (dyn_hash->hash_size < DYNHASH_GNU_BLOOM_OFF)
+    {
+        return ELFPARSER_ERR_SIZE;  // Header truncated
+    }
+    dyn_hash->word_size = DYNHASH_GNU_WORD_SIZE;
+    dyn_hash->bucket_num = (uint32_t)DynHash_wordRead(dyn_hash, dyn_hash->hash_map + DYNHASH_GNU_BUCKETNUM_OFF, DYNHASH_GNU_WORD_SIZE);
+    dyn_hash->sym_off = (uint32_t)DynHash_wordRead(dyn_hash, dyn_hash->hash_map + DYNHASH_GNU_SYMOFF_OFF, DYNHASH_GNU_WORD_SIZE);
+    dyn_hash->bloom_size = (uint32_t)DynHash_wordRead(dyn_hash, dyn_hash->hash_map + DYNHASH_GNU_BLOOMSIZE_OFF, DYNHASH_GNU_WORD_SIZE);
+    dyn_hash->bloom_shift = (uint32_t)DynHash_wordRead(dyn_hash, dyn_hash->hash_map + DYNHASH_GNU_BLOOMSHIFT_OFF, DYNHASH_GNU_WORD_SIZE);
+    if (dyn_hash->bucket_num == 0 || dyn_hash->bloom_size == 0 ||
+        (dyn_hash->bloom_size & (dyn_hash->bloom_size - 1)) != 0)  // The linker relies on a power-of-two bloom size
+    {
+        return ELFPARSER_ERR_FORMAT;
+    }
+    dyn_hash->bucket_off = DYNHASH_GNU_BLOOM_OFF + (size_t)dyn_hash->bloom_size * bloom_word;
+    dyn_hash->chain_off = dyn_hash->bucket_off + (size_t)dyn_hash->bucket_num * DYNHASH_GNU_WORD_SIZE;
+    if (dyn_hash->chain_off > dyn_hash->hash_size)
+    {
+        return ELFPARSER_ERR_SIZE;  // Buckets truncated
+    }
+    dyn_hash->chain_num = (uint32_t)((dyn_hash->hash_size - dyn_hash->chain_off) / DYNHASH_GNU_WORD_SIZE);
+    return ELFPARSER_SUCCESS;
+}
+
+/**
+ * @brief Reads the System V hash header and validates the table layout
+ * @param[in,out] dyn_hash Pointer to the hash table structure
+ * @param[in] entry_size sh_entsize of the hash section
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_SIZE if the section is truncated,
+ *             ELFPARSER_ERR_FORMAT if the header is inconsistent
+ */
+static int DynHash_sysvSetup(elfparser_dynhash_t *dyn_hash, uint64_t entry_size)
+{
+    dyn_hash->word_size = (entry_size == DYNHASH_SYSV_WORD_SIZE_WIDE) ? DYNHASH_SYSV_WORD_SIZE_WIDE : DYNHASH_SYSV_WORD_SIZE;
+    if (dyn_hash->hash_size < DYNHASH_SYSV_HEADER_WORDS * (size_t)dyn_hash->word_size)
+    {
+        return ELFPARSER_ERR_SIZE;  // Header truncated
+    }
+    dyn_hash->bucket_num = (uint32_t)DynHash_wordRead(dyn_hash, dyn_hash->hash_map + DYNHASH_SYSV_BUCKETNUM_WORD * dyn_hash->word_size,
+                                                      dyn_hash->word_size);
+    dyn_hash->chain_num = (uint32_t)DynHash_wordRead(dyn_hash, dyn_hash->hash_map + DYNHASH_SYSV_CHAINNUM_WORD * dyn_hash->word_size,
+                                                     dyn_hash->word_size);
+    dyn_hash->sym_off = 0;
+    dyn_hash->bloom_size = 0;
+    dyn_hash->bloom_shift = 0;
+    if (dyn_hash->bucket_num == 0)
+    {
+        return ELFPARSER_ERR_FORMAT;
+    }
+    dyn_hash->bucket_off = DYNHASH_SYSV_HEADER_WORDS * (size_t)dyn_hash->word_size;
+    dyn_hash->chain_off = dyn_hash->bucket_off + (size_t)dyn_hash->bucket_num * dyn_hash->word_size;
+    if (dyn_hash->chain_off + (size_t)dyn_hash->chain_num * dyn_hash->word_size > dyn_hash->hash_size)
+    {
+        return ELFPARSER_ERR_SIZE;  // Buckets or chains truncated
+    }
+    return ELFPARSER_SUCCESS;
+}
+
+/**
+ * @brief Locates the hash, dynamic symbol and dynamic string tables of a file
+ * @param[out] dyn_hash Pointer to the hash table structure to populate
+ * @param[in] sect_head Pointer to a parsed section header table of the file
+ * @param[in] map Pointer to the memory-mapped ELF file
+ * @param[in] map_size Size of the memory map in bytes
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_NOT_FOUND if the file has no hash table, ELFPARSER_ERR_RANGE if a link is invalid
+ *             or does not name a symbol table, ELFPARSER_ERR_SIZE if a table lies outside the map,
+ *             ELFPARSER_ERR_FORMAT if a table is malformed or its symbol entries do not match the class
+ */
+int ElfParser_DynHash_setup(elfparser_dynhash_t *dyn_hash, const elfparser_secthead_t *sect_head, const void *map, size_t map_size)
+{
+    if (!dyn_hash || !sect_head || !sect_head->table || !map)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+
+    size_t hash_idx = sect_head->table_len;
+    for (size_t cnt = 0; cnt < sect_head->table_len; cnt++)  // Prefer .gnu.hash, remember SHT_HASH as fallback
+    {
+        if (sect_head->table[cnt].sh_type == ELFPARSER_SECTHEAD_TYPE_GNU_HASH)
+        {
+            hash_idx = cnt;
+            break;
+        }
+        if (sect_head->table[cnt].sh_type == ELFPARSER_SECTHEAD_TYPE_HASH && hash_idx == sect_head->table_len)
+        {
+            hash_idx = cnt;
+        }
+    }
+    if (hash_idx == sect_head->table_len)
+    {
+        return ELFPARSER_ERR_NOT_FOUND;  // No hash table in this file
+    }
+
+    const elfparser_secthead_entry_t *hash_sect = &sect_head->table[hash_idx];
+    if (hash_sect->sh_link >= sect_head->table_len)
+    {
+        return ELFPARSER_ERR_RANGE;  // Invalid link to the symbol table
+    }
+    const elfparser_secthead_entry_t *sym_sect = &sect_head->table[hash_sect->sh_link];
+    if (sym_sect->sh_type != ELFPARSER_SECTHEAD_TYPE_DYNSYM && sym_sect->sh_type != ELFPARSER_SECTHEAD_TYPE_SYMTAB)
+    {
+        return ELFPARSER_ERR_RANGE;  // Link does not name a symbol table
+    }
+    if (sym_sect->sh_link >= sect_head->table_len)
+    {
+        return ELFPARSER_ERR_RANGE;  // Invalid link to the string table
+    }
+    uint64_t sym_entry_size = (sect_head->elf_class == ELFPARSER_HEADER_CLASS_64_BIT) ? DYNHASH_SYM_SIZE_64BIT : DYNHASH_SYM_SIZE_32BIT;
+    if (sym_sect->sh_entsize != sym_entry_size)
+    {
+        return ELFPARSER_ERR_FORMAT;  // Entries are not Elf32_Sym or Elf64_Sym of this class
+    }
+    const elfparser_secthead_entry_t *str_sect = &sect_head->table[sym_sect->sh_link];
+
+    dyn_hash->hash_map = DynHash_sectionMap(hash_sect, map, map_size);
+    dyn_hash->sym_map = DynHash_sectionMap(sym_sect, map, map_size);
+    dyn_hash->str_map = (const char *)DynHash_sectionMap(str_sect, map, map_size);
+    if (!dyn_hash->hash_map || !dyn_hash->sym_map || !dyn_hash->str_map)
+    {
+        return ELFPARSER_ERR_SIZE;  // A table lies outside the map
+    }
+    dyn_hash->hash_size = hash_sect->sh_size;
+    dyn_hash->sym_size = sym_sect->sh_size;
+    dyn_hash->str_size = str_sect->sh_size;
+    dyn_hash->elf_class = sect_head->elf_class;
+    dyn_hash->elf_data = sect_head->elf_data;
+    dyn_hash->sym_entry_size = (uint16_t)sym_sect->sh_entsize;
+
+    if (hash_sect->sh_type == ELFPARSER_SECTHEAD_TYPE_GNU_HASH)
+    {
+        dyn_hash->hash_type = ELFPARSER_DYNHASH_TYPE_GNU;
+        return DynHash_gnuSetup(dyn_hash);
+    }
+    dyn_hash->hash_type = ELFPARSER_DYNHASH_TYPE_SYSV;
+    return DynHash_sysvSetup(dyn_hash, hash_sect->sh_entsize);
+}
+
+/**
+ * @brief Looks up a name through a GNU hash table
+ * @param[in] dyn_hash Pointer to the hash table structure
+ * @param[in] name Name of the symbol to find
+ * @param[out] entry Optional destination for the decoded symbol
+ * @return int64_t Index of the symbol, ELFPARSER_ERR_NOT_FOUND if absent, or an ElfParser_Error code on failure
+ */
+static int64_t DynHash_gnuLookup(const elfparser_dynhash_t *dyn_hash, const char *name, elfparser_symtable_entry_t *entry)
+{
+    uint32_t hash = ElfParser_gnuHash(name);
+    size_t bloom_word = (dyn_hash->elf_class == ELFPARSER_HEADER_CLASS_64_BIT) ? DYNHASH_GNU_BLOOMWORD_SIZE_64BIT
+                                                                               : DYNHASH_GNU_BLOOMWORD_SIZE_32BIT;
+    uint32_t bloom_bits = (uint32_t)bloom_word * 8u;
+
+    size_t word_idx = (hash / bloom_bits) & (dyn_hash->bloom_size - 1);
+    uint64_t word = DynHash_wordRead(dyn_hash, dyn_hash->hash_map + DYNHASH_GNU_BLOOM_OFF + word_idx * bloom_word, bloom_word);
+    uint64_t mask = (1ull << (hash % bloom_bits)) | (1ull << ((hash >> dyn_hash->bloom_shift) % bloom_bits));
+    if ((word & mask) != mask)
+    {
+        return ELFPARSER_ERR_NOT_FOUND;  // Bloom filter says definitely absent
+    }
+
+    size_t bucket_pos = dyn_hash->bucket_off + (size_t)(hash % dyn_hash->bucket_num) * DYNHASH_GNU_WORD_SIZE;
+    uint32_t sym_idx = (uint32_t)DynHash_wordRead(dyn_hash, dyn_hash->hash_map + bucket_pos, DYNHASH_GNU_WORD_SIZE);
+    if (sym_idx == 0)
+    {
+        return ELFPARSER_ERR_NOT_FOUND;  // Empty bucket
+    }
+    if (sym_idx < dyn_hash->sym_off)
+    {
+        return ELFPARSER_ERR_RANGE;  // Bucket points below the hashed symbols
+    }
+    while ((size_t)(sym_idx - dyn_hash->sym_off) < dyn_hash->chain_num)  // Walk the chain until its end bit
+    {
+        size_t chain_pos = dyn_hash->chain_off + (size_t)(sym_idx - dyn_hash->sym_off) * DYNHASH_GNU_WORD_SIZE;
+        uint32_t chain_hash = (uint32_t)DynHash_wordRead(dyn_hash, dyn_hash->hash_map + chain_pos, DYNHASH_GNU_WORD_SIZE);
+        if ((chain_hash | 1u) == (hash | 1u))  // Low bit marks the end of the chain
+        {
+            int ret = DynHash_symbolCheck(dyn_hash, sym_idx, name, entry);
+            if (ret < 0)
+            {
+                return ret;
+            }
+            if (ret == 1)
+            {
+                return sym_idx;
+            }
+        }
+        if (chain_hash & 1u)
+        {
+            return ELFPARSER_ERR_NOT_FOUND;  // End of chain
+        }
+        sym_idx++;
+    }
+    return ELFPARSER_ERR_RANGE;  // Chain runs past the section
+}
+
+/**
+ * @brief Looks up a name through a System V hash table
+ * @param[in] dyn_hash Pointer to the hash table structure
+ * @param[in] name Name of the symbol to find
+ * @param[out] entry Optional destination for the decoded symbol
+ * @return int64_t Index of the symbol, ELFPARSER_ERR_NOT_FOUND if absent, or an ElfParser_Error code on failure
+ */
+static int64_t DynHash_sysvLookup(const elfparser_dynhash_t *dyn_hash, const char *name, elfparser_symtable_entry_t *entry)
+{
+    uint32_t hash = ElfParser_sysvHash(name);
+    size_t bucket_pos = dyn_hash->bucket_off + (size_t)(hash % dyn_hash->bucket_num) * dyn_hash->word_size;
+    uint32_t sym_idx = (uint32_t)DynHash_wordRead(dyn_hash, dyn_hash->hash_map + bucket_pos, dyn_hash->word_size);
+
+    for (uint32_t steps = 0; sym_idx != 0; steps++)  // Index 0 (STN_UNDEF) terminates a chain
+    {
+        if (sym_idx >= dyn_hash->chain_num || steps > dyn_hash->chain_num)
+        {
+            return ELFPARSER_ERR_RANGE;  // Out of range or cyclic chain
+        }
+        int ret = DynHash_symbolCheck(dyn_hash, sym_idx, name, entry);
+        if (ret < 0)
+        {
+            return ret;
+        }
+        if (ret == 1)
+        {
+            return sym_idx;
+        }
+        size_t chain_pos = dyn_hash->chain_off + (size_t)sym_idx * dyn_hash->word_size;
+        sym_idx = (uint32_t)DynHash_wordRead(dyn_hash, dyn_hash->hash_map + chain_pos, dyn_hash->word_size);
+    }
+    return ELFPARSER_ERR_NOT_FOUND;  // End of chain
+}
+
+/**
+ * @brief Looks up a defined dynamic symbol by name through the hash table
+ * @param[in] dyn_hash Pointer to the hash table structure
+ * @param[in] name Name of the symbol to find
+ * @param[out] entry Optional destination for the decoded symbol; its sym_name is a view into the map
+ * @return int64_t Index of the symbol in .dynsym, ELFPARSER_ERR_NOT_FOUND if no defined symbol matches,
+ *                 ELFPARSER_ERR_NULL if inputs are NULL, ELFPARSER_ERR_RANGE if a chain is corrupt
+ */
+int64_t ElfParser_DynHash_lookup(const elfparser_dynhash_t *dyn_hash, const char *name, elfparser_symtable_entry_t *entry)
+{
+    if (!dyn_hash || !name || !dyn_hash->hash_map)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    if (dyn_hash->hash_type == ELFPARSER_DYNHASH_TYPE_GNU)
+    {
+        return DynHash_gnuLookup(dyn_hash, name, entry);
+    }
+    return DynHash_sysvLookup(dyn_hash, name, entry);
+}
@@ -0,0 +1,672 @@
+/**
+ * @file elfparser_file.c
+ * @brief ELF file handle functions for libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This file implements the file handle. Opening sets up the reader and does
+ * nothing else; each getter parses its table on first use, announcing the
+ * byte ranges it is about to touch first. Raw table bytes are requested from
+ * the reader only for the duration of a decode and released right after.
+ * Section names are copied into one block, so their string table is released
+ * the same way; symbol string tables stay pinned because symbol names are
+ * views into them. The handle allocates nothing beyond the entry tables, the
+ * section name block and whatever the reader caches.
+ */
+
+#include "../inc_pub/elfparser_file.h"
+#include "../inc_priv/elfparser_file_priv.h"
+#include <string.h>
+
+/**
+ * @brief Opens an ELF file
+ * @param[out] file Pointer to the file structure to initialize
+ * @param[in] path Path of the file
+ * @param[in] flags Bitwise OR of ELFPARSER_FILE_FLAG_* values
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             or the error of ElfParser_Reader_open()
+ */
+int ElfParser_File_open(elfparser_file_t *file, const char *path, uint32_t flags)
+{
+    if (!file || !path)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+
+    memset(file, 0, sizeof(*file));  // No table parsed yet
+    elfparser_reader_backend_e backend = (flags & ELFPARSER_FILE_FLAG_PREAD) ? ELFPARSER_READER_BACKEND_PREAD
+                                                                              : ELFPARSER_READER_BACKEND_MMAP;
+    int ret = ElfParser_Reader_open(&file->reader, path, backend, flags & ~ELFPARSER_FILE_FLAG_PREAD);
+    if (ret < 0)
+    {
+        return ret;  // Cannot open, inspect or map
+    }
+    file->flags = flags;
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Gives an access-pattern hint for a byte range of the file
+ * @param[in] file Pointer to an open file structure
+ * @param[in] offset Start of the range in the file
+ * @param[in] size Length of the range in bytes
+ * @param[in] advice Access pattern to announce
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if the file is NULL,
+ *             or the error of ElfParser_Reader_advise()
+ */
+int ElfParser_File_advise(const elfparser_file_t *file, uint64_t offset, uint64_t size, elfparser_reader_advice_e advice)
+{
+    if (!file)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    return ElfParser_Reader_advise(&file->reader, offset, size, advice);
+}
+
+/**
+ * @brief Sets the allocator of the section header and symbol tables parsed through the file
+ * @param[in,out] file Pointer to an open file structure
+ * @param[in] alloc Allocator to use, NULL for malloc
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if the file is NULL
+ */
+int ElfParser_File_allocSet(elfparser_file_t *file, const elfparser_alloc_t *alloc)
+{
+    if (!file)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    file->alloc = alloc;
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Checks that a byte range lies inside the file
+ * @param[in] file Pointer to an open file structure
+ * @param[in] offset Start of the range
+ * @param[in] size Length of the range in bytes
+ * @return int 1 if the range is inside the file, 0 otherwise
+ */
+static inline int File_rangeValid(const elfparser_file_t *file, uint64_t offset, uint64_t size)
+{
+    return offset <= file->reader.file_size && size <= file->reader.file_size - offset;
+}
+
+/**
+ * @brief Returns the ELF header, parsing it on first use
+ * @param[in,out] file Pointer to an open file structure
+ * @param[out] header Set to the parsed header, owned by file
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_SIZE if section header 0 is needed but lies outside the file,
+ *             or the error of the reader or header functions
+ */
+int ElfParser_File_headerGet(elfparser_file_t *file, const elfparser_header_t **header)
+{
+    if (!file || !header)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    if (file->ready & FILE_READY_HEADER)
+    {
+        *header = &file->header;
+        return ELFPARSER_SUCCESS;  // Already parsed
+    }
+
+    uint64_t head_size = (file->reader.file_size < FILE_HEADER_READ_SIZE) ? file->reader.file_size : FILE_HEADER_READ_SIZE;
+    const void *head;
+    int ret = ElfParser_Reader_rangeGet(&file->reader, 0, head_size, &head);
+    if (ret < 0)
+    {
+        return ret;  // Not open or unreadable
+    }
+    ret = ElfParser_Header_identParse(&file->header, head, (size_t)head_size);
+    if (ret >= 0)
+    {
+        ret = ElfParser_Header_parseRaw(&file->header, head, (size_t)head_size);
+    }
+    ElfParser_Reader_rangeRelease(&file->reader, head);  // Fields are decoded
+    if (ret < 0)
+    {
+        return ret;  // Not an ELF file or malformed header
+    }
+
+    if (ElfParser_Header_extendedUsed(&file->header))  // Counts beyond 16 bits live in section 0
+    {
+        uint64_t sect0_off = file->header.elf_section_header_off;
+        uint64_t sect0_size = file->header.elf_section_header_entry_size;
+        if (!File_rangeValid(file, sect0_off, sect0_size))
+        {
+            return ELFPARSER_ERR_SIZE;  // Section header 0 outside the file
+        }
+        const void *sect0;
+        ret = ElfParser_Reader_rangeGet(&file->reader, sect0_off, sect0_size, &sect0);
+        if (ret < 0)
+        {
+            return ret;  // Unreadable
+        }
+        ret = ElfParser_Header_extendedResolve(&file->header, sect0, (size_t)sect0_size);
+        ElfParser_Reader_rangeRelease(&file->reader, sect0);
+        if (ret < 0)
+        {
+            return ret;  // Truncated section header 0
+        }
+    }
+
+    file->ready |= FILE_READY_HEADER;
+    *header = &file->header;
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Returns the section header table, parsing it and resolving its names on first use
+ * @param[in,out] file Pointer to an open file structure
+ * @param[out] sect_head Set to the parsed table, owned by file
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_NOT_FOUND if the file has no section headers, ELFPARSER_ERR_SIZE if a table lies
+ *             outside the file, ELFPARSER_ERR_RANGE if the name string table index is invalid,
+ *             or the error of the reader, header or section header functions
+ */
+int ElfParser_File_sectHeadGet(elfparser_file_t *file, const elfparser_secthead_t **sect_head)
+{
+    if (!file || !sect_head)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    if (file->ready & FILE_READY_SECTHEAD)
+    {
+        *sect_head = &file->sect_head;
+        return ELFPARSER_SUCCESS;  // Already parsed
+    }
+
+    const elfparser_header_t *header;
+    int ret = ElfParser_File_headerGet(file, &header);
+    if (ret < 0)
+    {
+        return ret;  // No usable header
+    }
+    if (header->elf_section_header_entry_num == 0)
+    {
+        return ELFPARSER_ERR_NOT_FOUND;  // Section headers stripped or never written
+    }
+    uint64_t table_off = header->elf_section_header_off;
+    uint64_t table_size = (uint64_t)header->elf_section_header_entry_size * header->elf_section_header_entry_num;
+    if (!File_rangeValid(file, table_off, table_size))
+    {
+        return ELFPARSER_ERR_SIZE;  // Table outside the file
+    }
+    ElfParser_Reader_advise(&file->reader, table_off, table_size, ELFPARSER_READER_ADVICE_WILLNEED);
+
+    if (file->ready & FILE_SETUP_SECTHEAD)  // Earlier attempt failed halfway
+    {
+        ElfParser_SectHead_free(&file->sect_head);
+        file->ready &= ~FILE_SETUP_SECTHEAD;
+    }
+    ret = ElfParser_SectHead_structSetupAlloc(&file->sect_head, header, file->alloc);
+    if (ret < 0)
+    {
+        return ret;  // Allocation failure
+    }
+    file->ready |= FILE_SETUP_SECTHEAD;
+    const void *raw;
+    ret = ElfParser_Reader_rangeGet(&file->reader, table_off, table_size, &raw);
+    if (ret < 0)
+    {
+        return ret;  // Unreadable
+    }
+    ret = ElfParser_SectHead_parse(&file->sect_head, raw, (size_t)table_size);
+    ElfParser_Reader_rangeRelease(&file->reader, raw);  // Entries are decoded
+    if (ret < 0)
+    {
+        return ret;  // Malformed table
+    }
+
+    if (file->sect_head.string_table_idx >= file->sect_head.table_len)
+    {
+        return ELFPARSER_ERR_RANGE;  // No name string table
+    }
+    const elfparser_secthead_entry_t *str_sect = &file->sect_head.table[file->sect_head.string_table_idx];
+    if (!File_rangeValid(file, str_sect->sh_offset, str_sect->sh_size))
+    {
+        return ELFPARSER_ERR_SIZE;  // Name string table outside the file
+    }
+    ElfParser_Reader_advise(&file->reader, str_sect->sh_offset, str_sect->sh_size, ELFPARSER_READER_ADVICE_WILLNEED);
+    const void *names;
+    ret = ElfParser_Reader_rangeGet(&file->reader, str_sect->sh_offset, str_sect->sh_size, &names);
+    if (ret < 0)
+    {
+        return ret;  // Unreadable
+    }
+    ret = ElfParser_SectHead_nameResolveArena(&file->sect_head, names, (size_t)str_sect->sh_size);
+    ElfParser_Reader_rangeRelease(&file->reader, names);  // Names are copied, a retry pins afresh
+    if (ret < 0)
+    {
+        return ret;  // Name outside the string table
+    }
+
+    file->ready |= FILE_READY_SECTHEAD;
+    *sect_head = &file->sect_head;
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Returns the program header table, parsing it on first use
+ * @param[in,out] file Pointer to an open file structure
+ * @param[out] prog_head Set to the parsed table, owned by file
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_NOT_FOUND if the file has no program headers, ELFPARSER_ERR_SIZE if the table lies
+ *             outside the file, or the error of the reader, header or program header functions
+ */
+int ElfParser_File_progHeadGet(elfparser_file_t *file, const elfparser_proghead_t **prog_head)
+{
+    if (!file || !prog_head)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    if (file->ready & FILE_READY_PROGHEAD)
+    {
+        *prog_head = &file->prog_head;
+        return ELFPARSER_SUCCESS;  // Already parsed
+    }
+
+    const elfparser_header_t *header;
+    int ret = ElfParser_File_headerGet(file, &header);
+    if (ret < 0)
+    {
+        return ret;  // No usable header
+    }
+    if (header->elf_program_header_entry_num == 0)
+    {
+        return ELFPARSER_ERR_NOT_FOUND;  // Relocatable objects have no segments
+    }
+    uint64_t table_off = header->elf_program_header_off;
+    uint64_t table_size = (uint64_t)header->elf_program_header_entry_size * header->elf_program_header_entry_num;
+    if (!File_rangeValid(file, table_off, table_size))
+    {
+        return ELFPARSER_ERR_SIZE;  // Table outside the file
+    }
+    ElfParser_Reader_advise(&file->reader, table_off, table_size, ELFPARSER_READER_ADVICE_WILLNEED);
+
+    if (file->ready & FILE_SETUP_PROGHEAD)  // Earlier attempt failed halfway
+    {
+        ElfParser_ProgHead_free(&file->prog_head);
+        file->ready &= ~FILE_SETUP_PROGHEAD;
+    }
+    ret = ElfParser_ProgHead_structSetup(&file->prog_head, header);
+    if (ret < 0)
+    {
+        return ret;  // Allocation failure
+    }
+    file->ready |= FILE_SETUP_PROGHEAD;
+    const void *raw;
+    ret = ElfParser_Reader_rangeGet(&file->reader, table_off, table_size, &raw);
+    if (ret < 0)
+    {
+        return ret;  // Unreadable
+    }
+    ret = ElfParser_ProgHead_parse(&file->prog_head, raw, (size_t)table_size);
+    ElfParser_Reader_rangeRelease(&file->reader, raw);  // Entries are decoded
+    if (ret < 0)
+    {
+        return ret;  // Malformed table
+    }
+
+    file->ready |= FILE_READY_PROGHEAD;
+    *prog_head = &file->prog_head;
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Returns the contents of a section
+ * @param[in,out] file Pointer to an open file structure
+ * @param[in] sect_idx Index of the section
+ * @param[out] data Set to the first byte of the section, NULL for SHT_NOBITS
+ * @param[out] size Set to the size of the section in bytes (0 for SHT_NOBITS)
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_RANGE if sect_idx is invalid, ELFPARSER_ERR_SIZE if the section lies outside the file,
+ *             or the error of ElfParser_File_sectHeadGet() or the reader
+ */
+int ElfParser_File_sectionGet(elfparser_file_t *file, uint32_t sect_idx, const void **data, size_t *size)
+{
+    if (!data || !size)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    const elfparser_secthead_t *sect_head;
+    int ret = ElfParser_File_sectHeadGet(file, &sect_head);
+    if (ret < 0)
+    {
+        return ret;  // No section headers
+    }
+    if (sect_idx >= sect_head->table_len)
+    {
+        return ELFPARSER_ERR_RANGE;  // Invalid section index
+    }
+
+    const elfparser_secthead_entry_t *sect = &sect_head->table[sect_idx];
+    if (sect->sh_type == ELFPARSER_SECTHEAD_TYPE_NOBITS)
+    {
+        *data = NULL;  // Occupies no file bytes
+        *size = 0;
+        return ELFPARSER_SUCCESS;
+    }
+    if (!File_rangeValid(file, sect->sh_offset, sect->sh_size))
+    {
+        return ELFPARSER_ERR_SIZE;  // Section outside the file
+    }
+    ret = ElfParser_Reader_rangeGet(&file->reader, sect->sh_offset, sect->sh_size, data);  // Pinned until close
+    if (ret < 0)
+    {
+        return ret;  // Unreadable
+    }
+    *size = (size_t)sect->sh_size;
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Sets up, parses and name-resolves a symbol table section in one sequential pass
+ * @param[in,out] file Pointer to an open file structure
+ * @param[out] symbol_table Pointer to the symbol table structure to populate
+ * @param[in] sym_sect_idx Index of the SHT_SYMTAB or SHT_DYNSYM section
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_RANGE if an index or link is invalid, ELFPARSER_ERR_FORMAT if the section is not
+ *             a symbol table, ELFPARSER_ERR_SIZE if a table lies outside the file,
+ *             or the error of the reader, section header or symbol table functions
+ */
+int ElfParser_File_symTableLoad(elfparser_file_t *file, elfparser_symtable_t *symbol_table, uint32_t sym_sect_idx)
+{
+    if (!symbol_table)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    const elfparser_secthead_t *sect_head;
+    int ret = ElfParser_File_sectHeadGet(file, &sect_head);
+    if (ret < 0)
+    {
+        return ret;  // No section headers
+    }
+    if (sym_sect_idx >= sect_head->table_len)
+    {
+        return ELFPARSER_ERR_RANGE;  // Invalid section index
+    }
+
+    const elfparser_secthead_entry_t *sym_sect = &sect_head->table[sym_sect_idx];
+    if (sym_sect->sh_type != ELFPARSER_SECTHEAD_TYPE_SYMTAB && sym_sect->sh_type != ELFPARSER_SECTHEAD_TYPE_DYNSYM)
+    {
+        return ELFPARSER_ERR_FORMAT;  // Not a symbol table
+    }
+    if (sym_sect->sh_link >= sect_head->table_len)
+    {
+        return ELFPARSER_ERR_RANGE;  // Invalid string table link
+    }
+    const elfparser_secthead_entry_t *str_sect = &sect_head->table[sym_sect->sh_link];
+    const elfparser_secthead_entry_t *shndx_sect = NULL;
+    for (uint32_t i = 0; i < sect_head->table_len; i++)  // Escaped section indices, if any
+    {
+        if (sect_head->table[i].sh_type == ELFPARSER_SECTHEAD_TYPE_SYMTAB_SHNDX && sect_head->table[i].sh_link == sym_sect_idx)
+        {
+            shndx_sect = &sect_head->table[i];
+            break;
+        }
+    }
+    if (!File_rangeValid(file, sym_sect->sh_offset, sym_sect->sh_size) ||
+        !File_rangeValid(file, str_sect->sh_offset, str_sect->sh_size) ||
+        (shndx_sect && !File_rangeValid(file, shndx_sect->sh_offset, shndx_sect->sh_size)))
+    {
+        return ELFPARSER_ERR_SIZE;  // A table lies outside the file
+    }
+
+    elfparser_reader_range_t ranges[FILE_SYMTABLE_RANGE_NUM] = {
+        { sym_sect->sh_offset, sym_sect->sh_size },
+        { str_sect->sh_offset, str_sect->sh_size },
+        { shndx_sect ? shndx_sect->sh_offset : 0, shndx_sect ? shndx_sect->sh_size : 0 }
+    };
+    ret = ElfParser_SymTable_structSetupAlloc(symbol_table, sect_head, sym_sect_idx, &file->header, file->alloc);
+    if (ret < 0)
+    {
+        return ret;  // Invalid geometry or allocation failure
+    }
+    symbol_table->name_mode = ELFPARSER_NAME_MODE_VIEW;  // Names are never owned, free must not touch them
+    ElfParser_Reader_advise(&file->reader, sym_sect->sh_offset, sym_sect->sh_size, ELFPARSER_READER_ADVICE_SEQUENTIAL);
+    ret = ElfParser_Reader_prefetch(&file->reader, ranges, FILE_SYMTABLE_RANGE_NUM);  // Adjacent sections in one read
+    const void *raw;
+    if (ret >= 0)
+    {
+        ret = ElfParser_Reader_rangeGet(&file->reader, sym_sect->sh_offset, sym_sect->sh_size, &raw);
+    }
+    if (ret >= 0)
+    {
+        ret = ElfParser_SymTable_parse(symbol_table, raw, (size_t)sym_sect->sh_size);
+        ElfParser_Reader_rangeRelease(&file->reader, raw);  // Entries are decoded
+        ElfParser_Reader_advise(&file->reader, sym_sect->sh_offset, sym_sect->sh_size, ELFPARSER_READER_ADVICE_DONTNEED);
+    }
+    if (ret >= 0 && shndx_sect)
+    {
+        ret = ElfParser_Reader_rangeGet(&file->reader, shndx_sect->sh_offset, shndx_sect->sh_size, &raw);
+        if (ret >= 0)
+        {
+            ret = ElfParser_SymTable_shndxResolve(symbol_table, raw, (size_t)shndx_sect->sh_size);
+            ElfParser_Reader_rangeRelease(&file->reader, raw);
+        }
+    }
+    if (ret >= 0)
+    {
+        ret = ElfParser_Reader_rangeGet(&file->reader, str_sect->sh_offset, str_sect->sh_size, &raw);  // Pinned until close
+    }
+    if (ret >= 0)
+    {
+        ret = ElfParser_SymTable_nameResolveView(symbol_table, raw, (size_t)str_sect->sh_size);
+        if (ret < 0)
+        {
+            ElfParser_Reader_rangeRelease(&file->reader, raw);  // No name points into it
+        }
+    }
+    if (ret < 0)
+    {
+        ElfParser_SymTable_free(symbol_table);
+        return ret;  // Unreadable or malformed table
+    }
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Loads the most complete symbol table of the file
+ * @param[in,out] file Pointer to an open file structure
+ * @param[out] symbol_table Pointer to the symbol table structure to populate
+ * @param[out] sym_sect_idx Optional destination of the index of the loaded section
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_NOT_FOUND if there is neither a SHT_SYMTAB nor a SHT_DYNSYM section,
+ *             or the error of ElfParser_File_sectHeadGet() or ElfParser_File_symTableLoad()
+ */
+int ElfParser_File_symTableDefaultLoad(elfparser_file_t *file, elfparser_symtable_t *symbol_table, uint32_t *sym_sect_idx)
+{
+    if (!symbol_table)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    const elfparser_secthead_t *sect_head;
+    int ret = ElfParser_File_sectHeadGet(file, &sect_head);
+    if (ret < 0)
+    {
+        return ret;  // No section headers
+    }
+    int32_t idx = ElfParser_SectHead_byTypeFind(sect_head, ELFPARSER_SECTHEAD_TYPE_SYMTAB, 0);
+    if (idx == ELFPARSER_ERR_NOT_FOUND)
+    {
+        idx = ElfParser_SectHead_byTypeFind(sect_head, ELFPARSER_SECTHEAD_TYPE_DYNSYM, 0);  // Stripped: exports only
+    }
+    if (idx < 0)
+    {
+        return idx;  // No symbol table at all
+    }
+    if (sym_sect_idx)
+    {
+        *sym_sect_idx = (uint32_t)idx;
+    }
+    return ElfParser_File_symTableLoad(file, symbol_table, (uint32_t)idx);
+}
+
+/**
+ * @brief Sets up and decodes a relocation section in one sequential pass
+ * @param[in,out] file Pointer to an open file structure
+ * @param[out] reloc Pointer to the relocation structure to populate
+ * @param[in] reloc_sect_idx Index of the SHT_REL, SHT_RELA or SHT_RELR section
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_RANGE if reloc_sect_idx is invalid, ELFPARSER_ERR_SIZE if the section lies outside the file,
+ *             or the error of the reader, section header or relocation functions
+ */
+int ElfParser_File_relocLoad(elfparser_file_t *file, elfparser_reloc_t *reloc, uint32_t reloc_sect_idx)
+{
+    if (!reloc)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    const elfparser_secthead_t *sect_head;
+    int ret = ElfParser_File_sectHeadGet(file, &sect_head);
+    if (ret < 0)
+    {
+        return ret;  // No section headers
+    }
+    if (reloc_sect_idx >= sect_head->table_len)
+    {
+        return ELFPARSER_ERR_RANGE;  // Invalid section index
+    }
+    const elfparser_secthead_entry_t *rel_sect = &sect_head->table[reloc_sect_idx];
+    if (!File_rangeValid(file, rel_sect->sh_offset, rel_sect->sh_size))
+    {
+        return ELFPARSER_ERR_SIZE;  // Section outside the file
+    }
+
+    ret = ElfParser_Reloc_structSetup(reloc, sect_head, reloc_sect_idx, &file->header);
+    if (ret < 0)
+    {
+        return ret;  // Not a relocation section or allocation failure
+    }
+    ElfParser_Reader_advise(&file->reader, rel_sect->sh_offset, rel_sect->sh_size, ELFPARSER_READER_ADVICE_SEQUENTIAL);
+    const void *raw;
+    ret = ElfParser_Reader_rangeGet(&file->reader, rel_sect->sh_offset, rel_sect->sh_size, &raw);
+    if (ret >= 0)
+    {
+        ret = ElfParser_Reloc_parse(reloc, raw, (size_t)rel_sect->sh_size);
+        ElfParser_Reader_rangeRelease(&file->reader, raw);  // Entries are decoded
+        ElfParser_Reader_advise(&file->reader, rel_sect->sh_offset, rel_sect->sh_size, ELFPARSER_READER_ADVICE_DONTNEED);
+    }
+    if (ret < 0)
+    {
+        ElfParser_Reloc_free(reloc);
+        return ret;  // Unreadable or malformed section
+    }
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Looks for the build-id note in one note section or segment
+ * @param[in,out] file Pointer to an open file structure with a parsed header
+ * @param[in] offset Start of the notes in the file
+ * @param[in] size Size of the notes in bytes
+ * @param[in] align Alignment of the section or segment
+ * @param[out] build_id Destination of at least ELFPARSER_NOTE_BUILD_ID_MAX bytes
+ * @param[out] build_id_len Set to the length of the build-id in bytes
+ * @return int ELFPARSER_SUCCESS if the build-id was copied, an ElfParser_Error code otherwise
+ */
+static int File_buildIdScan(elfparser_file_t *file, uint64_t offset, uint64_t size, uint64_t align,
+                            uint8_t *build_id, uint32_t *build_id_len)
+{
+    if (!File_rangeValid(file, offset, size))
+    {
+        return ELFPARSER_ERR_SIZE;  // Notes outside the file
+    }
+    const void *raw;
+    int ret = ElfParser_Reader_rangeGet(&file->reader, offset, size, &raw);
+    if (ret < 0)
+    {
+        return ret;  // Unreadable
+    }
+    elfparser_note_t note;
+    ret = ElfParser_Note_buildIdFind(raw, (size_t)size, file->header.elf_ident.elf_data, align, &note);
+    if (ret >= 0)
+    {
+        memcpy(build_id, note.note_desc, note.note_desc_size);  // Copy out before the range is released
+        *build_id_len = note.note_desc_size;
+    }
+    ElfParser_Reader_rangeRelease(&file->reader, raw);
+    return ret;
+}
+
+/**
+ * @brief Copies out the GNU build-id of the file
+ * @param[in,out] file Pointer to an open file structure
+ * @param[out] build_id Destination of at least ELFPARSER_NOTE_BUILD_ID_MAX bytes
+ * @param[out] build_id_len Set to the length of the build-id in bytes
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_NOT_FOUND if no note segment or section holds a build-id,
+ *             or the error of ElfParser_File_headerGet() or ElfParser_File_sectHeadGet()
+ */
+int ElfParser_File_buildIdGet(elfparser_file_t *file, uint8_t *build_id, uint32_t *build_id_len)
+{
+    if (!file || !build_id || !build_id_len)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    const elfparser_header_t *header;
+    int ret = ElfParser_File_headerGet(file, &header);
+    if (ret < 0)
+    {
+        return ret;  // No usable header
+    }
+
+    const elfparser_proghead_t *prog_head;
+    if (ElfParser_File_progHeadGet(file, &prog_head) == ELFPARSER_SUCCESS)  // Linked files: notes are in segments
+    {
+        for (uint32_t i = 0; i < prog_head->table_len; i++)
+        {
+            const elfparser_proghead_entry_t *seg = &prog_head->table[i];
+            if (seg->ph_type == ELFPARSER_PROGHEAD_TYPE_NOTE &&
+                File_buildIdScan(file, seg->ph_offset, seg->ph_filesz, seg->ph_align, build_id, build_id_len) == ELFPARSER_SUCCESS)
+            {
+                return ELFPARSER_SUCCESS;  // Found without touching the section headers
+            }
+        }
+    }
+
+    const elfparser_secthead_t *sect_head;
+    ret = ElfParser_File_sectHeadGet(file, &sect_head);
+    if (ret < 0)
+    {
+        return ret;  // No section headers to fall back on
+    }
+    for (uint32_t i = 0; i < sect_head->table_len; i++)
+    {
+        const elfparser_secthead_entry_t *sect = &sect_head->table[i];
+        if (sect->sh_type == ELFPARSER_SECTHEAD_TYPE_NOTE &&
+            File_buildIdScan(file, sect->sh_offset, sect->sh_size, sect->sh_addralign, build_id, build_id_len) == ELFPARSER_SUCCESS)
+        {
+            return ELFPARSER_SUCCESS;  // Found
+        }
+    }
+    return ELFPARSER_ERR_NOT_FOUND;  // No build-id anywhere
+}
+
+/**
+ * @brief Frees every table parsed from the file and closes its reader
+ * @param[in,out] file Pointer to the file structure to close
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if the file is NULL,
+ *             or the error of ElfParser_Reader_close()
+ */
+int ElfParser_File_close(elfparser_file_t *file)
+{
+    if (!file)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+
+    if (file->ready & FILE_SETUP_SECTHEAD)
+    {
+        ElfParser_SectHead_free(&file->sect_head);
+    }
+    if (file->ready & FILE_SETUP_PROGHEAD)
+    {
+        ElfParser_ProgHead_free(&file->prog_head);
+    }
+    file->ready = 0;
+    return ElfParser_Reader_close(&file->reader);
+}
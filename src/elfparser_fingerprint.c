@@ -0,0 +1,268 @@
+/**
+ * @file elfparser_fingerprint.c
+ * @brief Identity fingerprint functions for libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This file implements file fingerprints. The identity fields come from the
+ * ELF header and the build-id from the file handle's note lookup, which reads
+ * the program header table and the PT_NOTE segments only. Files without a
+ * build-id are hashed: the geometry and file bytes of each PT_LOAD segment,
+ * or the whole file when there are no segments, are fed through
+ * ElfParser_hash64() in fixed-size chunks, each chunk's hash seeding the
+ * next, with sequential read-ahead announced before and the pages released
+ * after. The multi-file variant spreads files over ElfParser_parallelFor().
+ */
+
+#include "../inc_pub/elfparser_fingerprint.h"
+#include "../inc_priv/elfparser_fingerprint_priv.h"
+#include "../inc_priv/elfparser_hash_priv.h"
+#include "../inc_priv/elfparser_memmanip_priv.h"
+#include "../inc_priv/elfparser_thread_priv.h"
+#include <string.h>
+
+/**
+ * @brief Context shared by the chunks of one ElfParser_Fingerprint_many() call
+ */
+typedef struct fingerprint_job_s
+{
+    const char *const*          paths;          /**< Paths of the files */
+    uint32_t                    file_flags;     /**< Flags every file is opened with */
+    elfparser_fingerprint_t*    fingerprints;   /**< Destination fingerprints */
+    int*                        status;         /**< Destination result codes, may be NULL */
+} fingerprint_job_t;
+
+/**
+ * @brief Feeds a byte range of the file into the content hash
+ * @param[in,out] file Pointer to an open file structure
+ * @param[in] offset Start of the range
+ * @param[in] size Length of the range in bytes
+ * @param[in,out] state Running content hash
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_SIZE if the range lies outside the file,
+ *             or the error of the reader
+ */
+static int Fingerprint_rangeHash(elfparser_file_t *file, uint64_t offset, uint64_t size, uint64_t *state)
+{
+    if (offset > file->reader.file_size || size > file->reader.file_size - offset)
+    {
+        return ELFPARSER_ERR_SIZE;  // Range outside the file
+    }
+    ElfParser_Reader_advise(&file->reader, offset, size, ELFPARSER_READER_ADVICE_SEQUENTIAL);
+    for (uint64_t pos = 0; pos < size; pos += FINGERPRINT_HASH_CHUNK)
+    {
+        uint64_t len = (size - pos < FINGERPRINT_HASH_CHUNK) ? size - pos : FINGERPRINT_HASH_CHUNK;
+        const void *data;
+        int ret = ElfParser_Reader_rangeGet(&file->reader, offset + pos, len, &data);
+        if (ret < 0)
+        {
+            return ret;  // Unreadable
+        }
+        *state = ElfParser_hash64(data, (size_t)len, *state);
+        ElfParser_Reader_rangeRelease(&file->reader, data);
+    }
+    ElfParser_Reader_advise(&file->reader, offset, size, ELFPARSER_READER_ADVICE_DONTNEED);  // Read once
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Hashes the contents of a file without a build-id
+ * @param[out] fingerprint Pointer to the fingerprint receiving kind and content_hash
+ * @param[in,out] file Pointer to an open file structure with a parsed header
+ * @return int ELFPARSER_SUCCESS on success, or the error of the program header or range hash functions
+ */
+static int Fingerprint_contentHash(elfparser_fingerprint_t *fingerprint, elfparser_file_t *file)
+{
+    uint64_t state = FINGERPRINT_HASH_SEED;
+    const elfparser_proghead_t *prog_head;
+    int ret = ElfParser_File_progHeadGet(file, &prog_head);
+    if (ret < 0 && ret != ELFPARSER_ERR_NOT_FOUND)
+    {
+        return ret;  // Malformed program header table
+    }
+
+    if (ret == ELFPARSER_SUCCESS && prog_head->offset_num)  // Loadable file bytes, in table order
+    {
+        for (uint32_t i = 0; i < prog_head->table_len; i++)
+        {
+            const elfparser_proghead_entry_t *seg = &prog_head->table[i];
+            if (seg->ph_type != ELFPARSER_PROGHEAD_TYPE_LOAD || seg->ph_filesz == 0)
+            {
+                continue;
+            }
+            uint8_t record[FINGERPRINT_SEGMENT_RECORD];  // Where the bytes go matters as much as the bytes
+            ElfParser_store64(record, seg->ph_offset, 0);
+            ElfParser_store64(record + 8, seg->ph_filesz, 0);
+            ElfParser_store64(record + 16, seg->ph_vaddr, 0);
+            ElfParser_store64(record + 24, ((uint64_t)seg->ph_type << 32) | seg->ph_flags, 0);
+            state = ElfParser_hash64(record, sizeof(record), state);
+            ret = Fingerprint_rangeHash(file, seg->ph_offset, seg->ph_filesz, &state);
+            if (ret < 0)
+            {
+                return ret;  // Segment outside the file or unreadable
+            }
+        }
+        fingerprint->kind = ELFPARSER_FINGERPRINT_KIND_LOAD_HASH;
+    }
+    else  // Relocatable objects: nothing is loadable, the file is the artifact
+    {
+        ret = Fingerprint_rangeHash(file, 0, file->reader.file_size, &state);
+        if (ret < 0)
+        {
+            return ret;  // Unreadable
+        }
+        fingerprint->kind = ELFPARSER_FINGERPRINT_KIND_FILE_HASH;
+    }
+    fingerprint->content_hash = state;
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Computes the fingerprint of an open file
+ * @param[out] fingerprint Pointer to the fingerprint to fill
+ * @param[in,out] file Pointer to an open file structure
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             or the error of the header, reader or program header functions
+ */
+int ElfParser_Fingerprint_compute(elfparser_fingerprint_t *fingerprint, elfparser_file_t *file)
+{
+    if (!fingerprint || !file)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    memset(fingerprint, 0, sizeof(*fingerprint));
+
+    uint64_t bytes_before = file->reader.stats.bytes_read;
+    const elfparser_header_t *header;
+    int ret = ElfParser_File_headerGet(file, &header);
+    if (ret < 0)
+    {
+        return ret;  // Not an ELF file
+    }
+    fingerprint->elf_class = header->elf_ident.elf_class;
+    fingerprint->elf_data = header->elf_ident.elf_data;
+    fingerprint->elf_type = header->elf_type;
+    fingerprint->elf_machine = header->elf_machine;
+
+    ret = ElfParser_File_buildIdGet(file, fingerprint->build_id, &fingerprint->build_id_len);
+    if (ret == ELFPARSER_SUCCESS)
+    {
+        fingerprint->kind = ELFPARSER_FINGERPRINT_KIND_BUILD_ID;
+    }
+    else if (ret == ELFPARSER_ERR_MALLOC || ret == ELFPARSER_ERR_IO)
+    {
+        return ret;  // Resource failure, not a property of the file
+    }
+    else  // No build-id, or notes and section headers unusable
+    {
+        fingerprint->build_id_len = 0;
+        ret = Fingerprint_contentHash(fingerprint, file);
+        if (ret < 0)
+        {
+            return ret;  // Contents unreadable
+        }
+    }
+    fingerprint->bytes_read = file->reader.stats.bytes_read - bytes_before;
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Opens a file, computes its fingerprint and closes it again
+ * @param[out] fingerprint Pointer to the fingerprint to fill
+ * @param[in] path Path of the file
+ * @param[in] file_flags ELFPARSER_FILE_FLAG_* values the file is opened with
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             or the error of ElfParser_File_open() or ElfParser_Fingerprint_compute()
+ */
+int ElfParser_Fingerprint_path(elfparser_fingerprint_t *fingerprint, const char *path, uint32_t file_flags)
+{
+    if (!fingerprint || !path)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    memset(fingerprint, 0, sizeof(*fingerprint));
+
+    elfparser_file_t file;
+    int ret = ElfParser_File_open(&file, path, file_flags);
+    if (ret < 0)
+    {
+        return ret;  // Cannot open
+    }
+    ret = ElfParser_Fingerprint_compute(fingerprint, &file);
+    ElfParser_File_close(&file);
+    if (ret < 0)
+    {
+        memset(fingerprint, 0, sizeof(*fingerprint));  // No half-filled identity
+    }
+    return ret;
+}
+
+/**
+ * @brief Fingerprints one chunk of the path list
+ * @param[in,out] ctx Pointer to the fingerprint_job_t of the call
+ * @param[in] chunk_idx Index of the chunk (unused)
+ * @param[in] begin First path of the chunk
+ * @param[in] end One past the last path of the chunk
+ * @return int Always ELFPARSER_SUCCESS, so one bad file never skips the others
+ */
+static int Fingerprint_chunk(void *ctx, size_t chunk_idx, size_t begin, size_t end)
+{
+    fingerprint_job_t *job = ctx;
+
+    (void)chunk_idx;
+    for (size_t i = begin; i < end; i++)
+    {
+        int ret = ElfParser_Fingerprint_path(&job->fingerprints[i], job->paths[i], job->file_flags);
+        if (job->status)
+        {
+            job->status[i] = ret;
+        }
+    }
+    return ELFPARSER_SUCCESS;
+}
+
+/**
+ * @brief Computes the fingerprints of many files on several threads
+ * @param[in] paths Paths of the files
+ * @param[in] path_num Number of paths
+ * @param[in] thread_num Number of threads, 0 for one per online CPU
+ * @param[in] file_flags ELFPARSER_FILE_FLAG_* values every file is opened with
+ * @param[out] fingerprints Array of path_num fingerprints to fill
+ * @param[out] status Array of path_num result codes, may be NULL
+ * @return int ELFPARSER_SUCCESS if the run completed, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             or the error of ElfParser_parallelFor()
+ */
+int ElfParser_Fingerprint_many(const char *const *paths, size_t path_num, uint32_t thread_num, uint32_t file_flags,
+                               elfparser_fingerprint_t *fingerprints, int *status)
+{
+    if ((!paths || !fingerprints) && path_num)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    fingerprint_job_t job = { paths, file_flags, fingerprints, status };
+    return ElfParser_parallelFor(path_num, FINGERPRINT_FILES_PER_CHUNK, thread_num, Fingerprint_chunk, &job);
+}
+
+/**
+ * @brief Tells whether two fingerprints identify the same artifact
+ * @param[in] lhs First fingerprint
+ * @param[in] rhs Second fingerprint
+ * @return int 1 if class, data encoding, type, machine, kind and identity all match, 0 otherwise
+ */
+int ElfParser_Fingerprint_equal(const elfparser_fingerprint_t *lhs, const elfparser_fingerprint_t *rhs)
+{
+    if (!lhs || !rhs)
+    {
+        return 0;  // Nothing to compare
+    }
+    if (lhs->elf_class != rhs->elf_class || lhs->elf_data != rhs->elf_data || lhs->elf_type != rhs->elf_type ||
+        lhs->elf_machine != rhs->elf_machine || lhs->kind != rhs->kind)
+    {
+        return 0;  // Different targets or different kinds of identity
+    }
+    if (lhs->kind == ELFPARSER_FINGERPRINT_KIND_BUILD_ID)
+    {
+        return lhs->build_id_len == rhs->build_id_len && memcmp(lhs->build_id, rhs->build_id, lhs->build_id_len) == 0;
+    }
+    return lhs->content_hash == rhs->content_hash;
+}
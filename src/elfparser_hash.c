@@ -0,0 +1,218 @@
+/**
+ * @file elfparser_hash.c
+ * @brief 64-bit block hash for libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This file implements ElfParser_hash64(), the checksum of the on-disk
+ * indices and the content hash of file fingerprints. The stripe loop has no
+ * dependency between lanes within a stripe and only 32x32-bit multiplies, so
+ * the four lanes map onto one AVX2 register: on x86 the full 512-byte blocks
+ * go through a vector loop selected at run time, and the scalar loop handles
+ * the rest and every other architecture. Both produce bit-identical results,
+ * input being read as little-endian words so every host agrees. Building with
+ * ELFPARSER_NO_SIMD keeps only the scalar loop.
+ */
+
+#include "../inc_priv/elfparser_hash_priv.h"
+#include "../inc_priv/elfparser_memmanip_priv.h"
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && !defined(ELFPARSER_NO_SIMD)
+#define HASH_X86 1 /**< Build the AVX2 block loop */
+#include <immintrin.h>
+#else
+#define HASH_X86 0
+#endif
+
+/**
+ * @brief Key material consumed by stripes, scrambles and the merge (fixed, not secret)
+ */
+static const uint64_t Hash_secret[HASH_SECRET_NUM] = {
+    0x6e789e6aa1b965f4ull, 0x06c45d188009454full, 0xf88bb8a8724c81ecull, 0x1b39896a51a8749bull,
+    0x53cb9f0c747ea2eaull, 0x2c829abe1f4532e1ull, 0xc584133ac916ab3cull, 0x3ee5789041c98ac3ull,
+    0xf3b8488c368cb0a6ull, 0x657eecdd3cb13d09ull, 0xc2d326e0055bdef6ull, 0x8621a03fe0bbdb7bull,
+    0x8e1f7555983aa92full, 0xb54e0f1600cc4d19ull, 0x84bb3f97971d80abull, 0x7d29825c75521255ull,
+    0xc3cf17102b7f7f86ull, 0x3466e9a083914f64ull, 0xd81a8d2b5a4485acull, 0xdb01602b100b9ed7ull,
+    0xa9038a921825f10dull, 0xedf5f1d90dca2f6aull, 0x54496ad67bd2634cull, 0xdd7c01d4f5407269ull
+};
+
+/**
+ * @brief Adds one 32-byte stripe to the accumulators
+ * @param[in,out] acc Accumulator lanes
+ * @param[in] src Pointer to the stripe
+ * @param[in] key Key words of the stripe, one per lane
+ */
+static inline void Hash_stripeAccumulate(uint64_t *acc, const uint8_t *src, const uint64_t *key)
+{
+    for (uint32_t lane = 0; lane < HASH_LANE_NUM; lane++)
+    {
+        uint64_t data = ElfParser_load64(src + lane * sizeof(uint64_t), 0);  // Little-endian on every host
+        uint64_t keyed = data ^ key[lane];
+        acc[lane ^ 1u] += data;                                   // Raw input to the neighbour keeps it from cancelling out
+        acc[lane] += (keyed & 0xFFFFFFFFu) * (keyed >> 32);       // 32x32->64 multiply of the keyed halves
+    }
+}
+
+/**
+ * @brief Mixes the accumulators at the end of a block
+ * @param[in,out] acc Accumulator lanes
+ * @param[in] key Key words of the scramble, one per lane
+ */
+static inline void Hash_scramble(uint64_t *acc, const uint64_t *key)
+{
+    for (uint32_t lane = 0; lane < HASH_LANE_NUM; lane++)
+    {
+        uint64_t value = acc[lane];
+        value ^= value >> 47;
+        value ^= key[lane];
+        acc[lane] = value * HASH_PRIME32_1;
+    }
+}
+
+#if HASH_X86
+
+/**
+ * @brief Runs full blocks through the accumulators four lanes at a time
+ *
+ * Lane for lane the same arithmetic as Hash_stripeAccumulate() and
+ * Hash_scramble(): the neighbour's input is brought in with a 64-bit swap
+ * inside each 128-bit half, and the 64x32-bit scramble multiply is put
+ * together from two 32x32-bit products.
+ *
+ * @param[in,out] acc Accumulator lanes
+ * @param[in] src Pointer to the first block
+ * @param[in] block_num Number of HASH_BLOCK_SIZE blocks
+ */
+__attribute__((target("avx2"))) static void Hash_blocksAvx2(uint64_t *acc, const uint8_t *src, size_t block_num)
+{
+    __m256i lanes = _mm256_loadu_si256((const __m256i *)acc);
+    const __m256i scramble_key = _mm256_loadu_si256((const __m256i *)&Hash_secret[HASH_SECRET_SCRAMBLE]);
+    const __m256i prime = _mm256_set1_epi64x(HASH_PRIME32_1);
+
+    for (size_t block = 0; block < block_num; block++, src += HASH_BLOCK_SIZE)
+    {
+        for (uint32_t stripe = 0; stripe < HASH_BLOCK_STRIPES; stripe++)
+        {
+            __m256i data = _mm256_loadu_si256((const __m256i *)(src + stripe * HASH_STRIPE_SIZE));
+            __m256i keyed = _mm256_xor_si256(data, _mm256_loadu_si256((const __m256i *)&Hash_secret[stripe]));
+            __m256i product = _mm256_mul_epu32(keyed, _mm256_srli_epi64(keyed, 32));  // Low half times high half
+            __m256i swapped = _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));   // Lane i gets input of lane i ^ 1
+            lanes = _mm256_add_epi64(lanes, _mm256_add_epi64(product, swapped));
+        }
+        lanes = _mm256_xor_si256(lanes, _mm256_srli_epi64(lanes, 47));
+        lanes = _mm256_xor_si256(lanes, scramble_key);
+        __m256i low = _mm256_mul_epu32(lanes, prime);
+        __m256i high = _mm256_mul_epu32(_mm256_srli_epi64(lanes, 32), prime);
+        lanes = _mm256_add_epi64(low, _mm256_slli_epi64(high, 32));
+    }
+    _mm256_storeu_si256((__m256i *)acc, lanes);
+}
+
+/**
+ * @brief Tells whether the AVX2 block loop can run, detecting it on first use
+ * @return int Non-zero if AVX2 is available
+ */
+static int Hash_avx2Available(void)
+{
+    static int level = -1;  // Detected once; racing first calls store the same value
+    int cur = __atomic_load_n(&level, __ATOMIC_RELAXED);
+
+    if (cur < 0)
+    {
+        __builtin_cpu_init();
+        cur = __builtin_cpu_supports("avx2") ? 1 : 0;
+        __atomic_store_n(&level, cur, __ATOMIC_RELAXED);
+    }
+    return cur;
+}
+
+#endif /* HASH_X86 */
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef unsigned __int128 hash_u128_t; /**< 128-bit product, marked as an extension for -Wpedantic */
+#endif
+
+/**
+ * @brief Multiplies two words to 128 bits and folds the halves together
+ *
+ * Uses the compiler's 128-bit integer where the target has one; 32-bit
+ * targets build the product from four 32x32-bit partial products instead.
+ *
+ * @param[in] lhs First factor
+ * @param[in] rhs Second factor
+ * @return uint64_t Low half XOR high half of the product
+ */
+static inline uint64_t Hash_mulFold(uint64_t lhs, uint64_t rhs)
+{
+#ifdef __SIZEOF_INT128__
+    hash_u128_t product = (hash_u128_t)lhs * rhs;
+    return (uint64_t)product ^ (uint64_t)(product >> 64);
+#else
+    uint64_t lo_lo = (lhs & 0xFFFFFFFFull) * (rhs & 0xFFFFFFFFull);
+    uint64_t hi_lo = (lhs >> 32) * (rhs & 0xFFFFFFFFull);
+    uint64_t lo_hi = (lhs & 0xFFFFFFFFull) * (rhs >> 32);
+    uint64_t hi_hi = (lhs >> 32) * (rhs >> 32);
+    uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFull) + lo_hi;  // Cannot overflow: each term is below 2^64 - 2^33
+    uint64_t low = (cross << 32) | (lo_lo & 0xFFFFFFFFull);
+    uint64_t high = hi_hi + (hi_lo >> 32) + (cross >> 32);
+    return low ^ high;
+#endif
+}
+
+/**
+ * @brief Hashes a block of memory to 64 bits
+ * @param[in] data Pointer to the bytes to hash, may be NULL if size is 0
+ * @param[in] size Number of bytes
+ * @param[in] seed Seed mixed into the initial state
+ * @return uint64_t Hash value
+ */
+uint64_t ElfParser_hash64(const void *data, size_t size, uint64_t seed)
+{
+    const uint8_t *src = data;
+    uint64_t acc[HASH_LANE_NUM] = {
+        HASH_PRIME64_5 ^ seed, HASH_PRIME64_2 + seed, HASH_PRIME64_3 ^ seed, HASH_PRIME64_4 - seed
+    };
+
+    size_t block_num = size / HASH_BLOCK_SIZE;
+    size_t block = 0;
+#if HASH_X86
+    if (block_num && Hash_avx2Available())
+    {
+        Hash_blocksAvx2(acc, src, block_num);
+        src += block_num * HASH_BLOCK_SIZE;
+        block = block_num;
+    }
+#endif
+    for (; block < block_num; block++, src += HASH_BLOCK_SIZE)  // Full blocks, scrambled after each
+    {
+        for (uint32_t stripe = 0; stripe < HASH_BLOCK_STRIPES; stripe++)
+        {
+            Hash_stripeAccumulate(acc, src + stripe * HASH_STRIPE_SIZE, &Hash_secret[stripe]);
+        }
+        Hash_scramble(acc, &Hash_secret[HASH_SECRET_SCRAMBLE]);
+    }
+
+    size_t rest = size - block_num * HASH_BLOCK_SIZE;
+    uint32_t stripe_num = (uint32_t)(rest / HASH_STRIPE_SIZE);
+    for (uint32_t stripe = 0; stripe < stripe_num; stripe++, src += HASH_STRIPE_SIZE)  // Whole stripes of the last block
+    {
+        Hash_stripeAccumulate(acc, src, &Hash_secret[stripe]);
+    }
+    rest -= (size_t)stripe_num * HASH_STRIPE_SIZE;
+    if (rest)  // Zero-padded final stripe; the length in the merge tells paddings apart
+    {
+        uint8_t last[HASH_STRIPE_SIZE] = { 0 };
+        memcpy(last, src, rest);
+        Hash_stripeAccumulate(acc, last, &Hash_secret[HASH_SECRET_TAIL]);
+    }
+
+    uint64_t hash = (uint64_t)size * HASH_PRIME64_1 ^ seed;
+    hash += Hash_mulFold(acc[0] ^ Hash_secret[HASH_SECRET_MERGE], acc[1] ^ Hash_secret[HASH_SECRET_MERGE + 1]);
+    hash += Hash_mulFold(acc[2] ^ Hash_secret[HASH_SECRET_MERGE + 2], acc[3] ^ Hash_secret[HASH_SECRET_MERGE + 3]);
+    hash ^= hash >> 37;  // Avalanche
+    hash *= HASH_AVALANCHE_MUL;
+    hash ^= hash >> 32;
+    return hash;
+}
@@ -14,18 +14,16 @@
 #include "../inc_pub/elfparser_header.h"
 #include "../inc_priv/elfparser_header_priv.h"
 #include "../inc_priv/elfparser_memmanip_priv.h"
+#include "../inc_priv/elfparser_secthead_priv.h"
+#include "../inc_priv/elfparser_stats_priv.h"
 
 #define ELFPARSER_MAGIC_WORD "\177ELF" /**< ELF magic number (0x7F followed by "ELF") */
 
 /**
- * @brief Parses the ELF identification block from a memory map
- * @param[out] elf_header Pointer to the ELF header structure to populate
- * @param[in] map Pointer to the memory-mapped ELF file
- * @param[in] size Size of the memory map in bytes
- * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_SIZE if size is too small,
- *             ELFPARSER_ERR_NULL if inputs are NULL, ELFPARSER_ERR_FORMAT if magic number is invalid
+ * @brief Body of ElfParser_Header_identParse(), run with or without an open span
+ * @return int See ElfParser_Header_identParse()
  */
-int ElfParser_Header_identParse(elfparser_header_t *elf_header, const void *map, size_t size)
+static int Header_identParseRun(elfparser_header_t *elf_header, const void *map, size_t size)
 {
     const char expected_magic_word[] = ELFPARSER_MAGIC_WORD;  // Expected ELF magic number
     const uint32_t mem_off[] = { IDENT_MAGIC_OFF,             // Offsets for ident fields
@@ -47,8 +45,9 @@ int ElfParser_Header_identParse(elfparser_header_t *elf_header, const void *map,
                                &(elf_header->elf_ident.elf_osabi),
                                &(elf_header->elf_ident.elf_abi_version) };
 
-    if (size < 16)  // Minimum size for ELF ident (EI_NIDENT is 16 bytes)
+    if (size < IDENT_SIZE)  // Minimum size for ELF ident (EI_NIDENT is 16 bytes)
     {
+        ElfParser_statsErrorAt(size);
         return ELFPARSER_ERR_SIZE;  // Insufficient size
     }
     if (!elf_header || !map)
@@ -57,6 +56,7 @@ int ElfParser_Header_identParse(elfparser_header_t *elf_header, const void *map,
     }
     if (ElfParser_memCmp(map, expected_magic_word, 4) != 0)  // Validate magic number
     {
+        ElfParser_statsErrorAt(IDENT_MAGIC_OFF);
         return ELFPARSER_ERR_FORMAT;  // Invalid ELF file
     }
 
@@ -71,6 +71,27 @@ int ElfParser_Header_identParse(elfparser_header_t *elf_header, const void *map,
     return ELFPARSER_SUCCESS;  // Success
 }
 
+/**
+ * @brief Parses the ELF identification block from a memory map
+ * @param[out] elf_header Pointer to the ELF header structure to populate
+ * @param[in] map Pointer to the memory-mapped ELF file
+ * @param[in] size Size of the memory map in bytes
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_SIZE if size is too small,
+ *             ELFPARSER_ERR_NULL if inputs are NULL, ELFPARSER_ERR_FORMAT if magic number is invalid
+ */
+int ElfParser_Header_identParse(elfparser_header_t *elf_header, const void *map, size_t size)
+{
+    if (!ElfParser_statsActive())
+    {
+        return Header_identParseRun(elf_header, map, size);  // Nothing registered
+    }
+    elfparser_span_t span;
+    ElfParser_statsBegin(&span, ELFPARSER_PHASE_IDENT);
+    int ret = Header_identParseRun(elf_header, map, size);
+    ElfParser_statsEnd(&span, ret, IDENT_SIZE, 1);
+    return ret;
+}
+
 /**
  * @brief Retrieves the size of the ELF header based on its class
  * @param[in] elf_header Pointer to the ELF header structure
@@ -87,77 +108,162 @@ size_t ElfParser_Header_sizeGet(const elfparser_header_t *elf_header)
 }                                                                                                                   // else invalid 
 
 /**
- * @brief Parses the full ELF header from a memory map
+ * @brief Decodes the ELF header fields for one class and endianness
+ *
+ * Always inlined into the four layout-specific decoders below, so the field
+ * offsets, widths and byte order are compile-time constants in each of them.
+ *
  * @param[out] elf_header Pointer to the ELF header structure to populate
- * @param[in] map Pointer to the memory-mapped ELF file
- * @param[in] size Size of the memory map in bytes
- * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_SIZE if size is insufficient,
- *             ELFPARSER_ERR_NULL if inputs are NULL, ELFPARSER_ERR_CLASS if class or endianness is invalid
+ * @param[in] src Pointer to the start of the ELF file
+ * @param[in] is_64bit Non-zero for the 64-bit layout
+ * @param[in] big_endian Non-zero for big-endian data
  */
-int ElfParser_Header_parse(elfparser_header_t *elf_header, const void *map, size_t size)
+static inline __attribute__((always_inline)) void Header_fieldsDecode(elfparser_header_t *elf_header, const uint8_t *src,
+                                                                      const int is_64bit, const int big_endian)
+{
+    elf_header->elf_type = (elfparser_header_type_e)ElfParser_load16(src + HEADER_TYPE_OFF, big_endian);
+    elf_header->elf_machine = ElfParser_load16(src + HEADER_MACHINE_OFF, big_endian);
+    elf_header->elf_version = ElfParser_load32(src + HEADER_VERSION_OFF, big_endian);
+    if (is_64bit)
+    {
+        elf_header->elf_entry = ElfParser_load64(src + HEADER_ENTRY_OFF, big_endian);
+        elf_header->elf_program_header_off = ElfParser_load64(src + HEADER_PROGTABLEOFF_OFF_64BIT, big_endian);
+        elf_header->elf_section_header_off = ElfParser_load64(src + HEADER_SECTTABLEOFF_OFF_64BIT, big_endian);
+    }
+    else
+    {
+        elf_header->elf_entry = ElfParser_load32(src + HEADER_ENTRY_OFF, big_endian);
+        elf_header->elf_program_header_off = ElfParser_load32(src + HEADER_PROGTABLEOFF_OFF_32BIT, big_endian);
+        elf_header->elf_section_header_off = ElfParser_load32(src + HEADER_SECTTABLEOFF_OFF_32BIT, big_endian);
+    }
+    elf_header->elf_flags = ElfParser_load32(src + (is_64bit ? HEADER_FLAGS_OFF_64BIT : HEADER_FLAGS_OFF_32BIT), big_endian);
+    elf_header->elf_header_size = ElfParser_load16(src + (is_64bit ? HEADER_HEADERSIZE_OFF_64BIT : HEADER_HEADERSIZE_OFF_32BIT), big_endian);
+    elf_header->elf_program_header_entry_size = ElfParser_load16(src + (is_64bit ? HEADER_PROGTENTSIZE_OFF_64BIT : HEADER_PROGTENTSIZE_OFF_32BIT), big_endian);
+    elf_header->elf_program_header_entry_num = ElfParser_load16(src + (is_64bit ? HEADER_PROGTENTNUM_OFF_64BIT : HEADER_PROGTENTNUM_OFF_32BIT), big_endian);
+    elf_header->elf_section_header_entry_size = ElfParser_load16(src + (is_64bit ? HEADER_SECTTENTSIZE_OFF_64BIT : HEADER_SECTTENTSIZE_OFF_32BIT), big_endian);
+    elf_header->elf_section_header_entry_num = ElfParser_load16(src + (is_64bit ? HEADER_SECTTENTNUM_OFF_64BIT : HEADER_SECTTENTNUM_OFF_32BIT), big_endian);
+    elf_header->elf_section_header_name_idx = ElfParser_load16(src + (is_64bit ? HEADER_SECTTENTNAMEIDX_OFF_64BIT : HEADER_SECTTENTNAMEIDX_OFF_32BIT), big_endian);
+}
+
+/* Layout-specific header decoders (32/64-bit x little/big-endian) */
+static void Header_decode32Le(elfparser_header_t *elf_header, const uint8_t *src) { Header_fieldsDecode(elf_header, src, 0, 0); }
+static void Header_decode32Be(elfparser_header_t *elf_header, const uint8_t *src) { Header_fieldsDecode(elf_header, src, 0, 1); }
+static void Header_decode64Le(elfparser_header_t *elf_header, const uint8_t *src) { Header_fieldsDecode(elf_header, src, 1, 0); }
+static void Header_decode64Be(elfparser_header_t *elf_header, const uint8_t *src) { Header_fieldsDecode(elf_header, src, 1, 1); }
+
+/**
+ * @brief Checks whether a decoded header uses extended numbering escapes
+ * @param[in] elf_header Pointer to a header decoded by ElfParser_Header_parseRaw()
+ * @return int 1 if a count or index has to be read from section header 0, 0 otherwise (also for NULL)
+ */
+int ElfParser_Header_extendedUsed(const elfparser_header_t *elf_header)
+{
+    if (!elf_header)
+    {
+        return 0;  // Nothing to resolve
+    }
+    return (elf_header->elf_section_header_entry_num == HEADER_SECTNUM_EXTENDED && elf_header->elf_section_header_off != 0) ||
+           elf_header->elf_section_header_name_idx == HEADER_SHN_XINDEX ||
+           elf_header->elf_program_header_entry_num == HEADER_PN_XNUM;
+}
+
+/**
+ * @brief Returns how many bytes of section header 0 ElfParser_Header_extendedResolve() reads
+ * @param[in] elf_header Pointer to a header decoded by ElfParser_Header_parseRaw()
+ * @param[in] sect0 Pointer to the raw section header 0
+ * @param[in] sect0_size Number of bytes available at sect0
+ * @return uint64_t One section header entry capped at sect0_size, 0 if no escape is used
+ */
+static uint64_t Header_sect0ReadSize(const elfparser_header_t *elf_header, const void *sect0, size_t sect0_size)
 {
-    const uint32_t mem_off_32bit[] = {  HEADER_TYPE_OFF,
-                                        HEADER_MACHINE_OFF,
-                                        HEADER_VERSION_OFF,
-                                        HEADER_ENTRY_OFF,
-                                        HEADER_PROGTABLEOFF_OFF_32BIT,
-                                        HEADER_SECTTABLEOFF_OFF_32BIT,
-                                        HEADER_FLAGS_OFF_32BIT,
-                                        HEADER_HEADERSIZE_OFF_32BIT,
-                                        HEADER_PROGTENTSIZE_OFF_32BIT,
-                                        HEADER_PROGTENTNUM_OFF_32BIT,
-                                        HEADER_SECTTENTSIZE_OFF_32BIT,
-                                        HEADER_SECTTENTNUM_OFF_32BIT,
-                                        HEADER_SECTTENTNAMEIDX_OFF_32BIT };
-
-    const uint32_t mem_off_64bit[] = {  HEADER_TYPE_OFF,
-                                        HEADER_MACHINE_OFF,
-                                        HEADER_VERSION_OFF,
-                                        HEADER_ENTRY_OFF,
-                                        HEADER_PROGTABLEOFF_OFF_64BIT,
-                                        HEADER_SECTTABLEOFF_OFF_64BIT,
-                                        HEADER_FLAGS_OFF_64BIT,
-                                        HEADER_HEADERSIZE_OFF_64BIT,
-                                        HEADER_PROGTENTSIZE_OFF_64BIT,
-                                        HEADER_PROGTENTNUM_OFF_64BIT,
-                                        HEADER_SECTTENTSIZE_OFF_64BIT,
-                                        HEADER_SECTTENTNUM_OFF_64BIT,
-                                        HEADER_SECTTENTNAMEIDX_OFF_64BIT };
-
-    const uint32_t mem_size_32bit[] = { HEADER_TYPE_SIZE,
-                                        HEADER_MACHINE_SIZE,
-                                        HEADER_VERSION_SIZE,
-                                        HEADER_ENTRY_SIZE_32BIT,
-                                        HEADER_PROGTABLEOFF_SIZE_32BIT,
-                                        HEADER_SECTTABLEOFF_SIZE_32BIT,
-                                        HEADER_FLAGS_SIZE,
-                                        HEADER_HEADERSIZE_SIZE,
-                                        HEADER_PROGTENTSIZE_SIZE,
-                                        HEADER_PROGTENTNUM_SIZE,
-                                        HEADER_SECTTENTSIZE_SIZE,
-                                        HEADER_SECTTENTNUM_SIZE,
-                                        HEADER_SECTTENTNAMEIDX_SIZE };
-
-    const uint32_t mem_size_64bit[] = { HEADER_TYPE_SIZE,
-                                        HEADER_MACHINE_SIZE,
-                                        HEADER_VERSION_SIZE,
-                                        HEADER_ENTRY_SIZE_64BIT,
-                                        HEADER_PROGTABLEOFF_SIZE_64BIT,
-                                        HEADER_SECTTABLEOFF_SIZE_64BIT,
-                                        HEADER_FLAGS_SIZE,
-                                        HEADER_HEADERSIZE_SIZE,
-                                        HEADER_PROGTENTSIZE_SIZE,
-                                        HEADER_PROGTENTNUM_SIZE,
-                                        HEADER_SECTTENTSIZE_SIZE,
-                                        HEADER_SECTTENTNUM_SIZE,
-                                        HEADER_SECTTENTNAMEIDX_SIZE };
-
-    void *const ret_dest[] = { &(elf_header->elf_type), &(elf_header->elf_machine), &(elf_header->elf_version),
-                               &(elf_header->elf_entry), &(elf_header->elf_program_header_off), &(elf_header->elf_section_header_off),
-                               &(elf_header->elf_flags), &(elf_header->elf_header_size), &(elf_header->elf_program_header_entry_size),
-                               &(elf_header->elf_program_header_entry_num), &(elf_header->elf_section_header_entry_size),
-                               &(elf_header->elf_section_header_entry_num), &(elf_header->elf_section_header_name_idx) };
+    if (!sect0 || !ElfParser_Header_extendedUsed(elf_header))
+    {
+        return 0;  // Section header 0 not consulted
+    }
+    return (elf_header->elf_section_header_entry_size < sect0_size) ? elf_header->elf_section_header_entry_size : sect0_size;
+}
+
+/**
+ * @brief Body of ElfParser_Header_extendedResolve(), run with or without an open span
+ * @return int See ElfParser_Header_extendedResolve()
+ */
+static int Header_extendedResolveRun(elfparser_header_t *elf_header, const void *sect0, size_t sect0_size)
+{
+    if (!elf_header)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    int sect_num_ext = (elf_header->elf_section_header_entry_num == HEADER_SECTNUM_EXTENDED && elf_header->elf_section_header_off != 0);
+    int name_idx_ext = (elf_header->elf_section_header_name_idx == HEADER_SHN_XINDEX);
+    int prog_num_ext = (elf_header->elf_program_header_entry_num == HEADER_PN_XNUM);
+    if (!sect_num_ext && !name_idx_ext && !prog_num_ext)
+    {
+        return ELFPARSER_SUCCESS;  // Plain numbering
+    }
+    if (!sect0)
+    {
+        return ELFPARSER_ERR_NULL;  // Section header 0 needed but not given
+    }
 
+    int is_64bit = (elf_header->elf_ident.elf_class == ELFPARSER_HEADER_CLASS_64_BIT);
+    int big_endian = (elf_header->elf_ident.elf_data == ELFPARSER_HEADER_DATA_BIG_ENDIANNESS);
+    size_t info_end = is_64bit ? SECTHEADER_ENTRY_INFO_OFF_64BIT + SECTHEADER_ENTRY_INFO_SIZE
+                               : SECTHEADER_ENTRY_INFO_OFF_32BIT + SECTHEADER_ENTRY_INFO_SIZE;  // Furthest field needed
+    if (sect0_size < info_end)
+    {
+        return ELFPARSER_ERR_SIZE;  // Section header 0 truncated
+    }
+
+    const uint8_t *raw = sect0;
+    if (sect_num_ext)
+    {
+        uint64_t sect_num = is_64bit ? ElfParser_load64(raw + SECTHEADER_ENTRY_SECTSIZE_OFF_64BIT, big_endian)
+                                     : ElfParser_load32(raw + SECTHEADER_ENTRY_SECTSIZE_OFF_32BIT, big_endian);
+        if (sect_num > UINT32_MAX)
+        {
+            return ELFPARSER_ERR_SIZE;  // Count cannot describe a real table
+        }
+        elf_header->elf_section_header_entry_num = (uint32_t)sect_num;
+    }
+    if (name_idx_ext)
+    {
+        elf_header->elf_section_header_name_idx = ElfParser_load32(raw + (is_64bit ? SECTHEADER_ENTRY_LINK_OFF_64BIT : SECTHEADER_ENTRY_LINK_OFF_32BIT), big_endian);
+    }
+    if (prog_num_ext)
+    {
+        elf_header->elf_program_header_entry_num = ElfParser_load32(raw + (is_64bit ? SECTHEADER_ENTRY_INFO_OFF_64BIT : SECTHEADER_ENTRY_INFO_OFF_32BIT), big_endian);
+    }
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Replaces extended-numbering escapes with the values stored in section header 0
+ * @param[in,out] elf_header Pointer to a header decoded by ElfParser_Header_parseRaw()
+ * @param[in] sect0 Pointer to the raw section header 0 (may be NULL if no escape is used)
+ * @param[in] sect0_size Number of bytes available at sect0
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if elf_header is NULL or sect0 is needed but NULL,
+ *             ELFPARSER_ERR_SIZE if section header 0 is truncated or holds an impossible count
+ */
+int ElfParser_Header_extendedResolve(elfparser_header_t *elf_header, const void *sect0, size_t sect0_size)
+{
+    if (!ElfParser_statsActive())
+    {
+        return Header_extendedResolveRun(elf_header, sect0, sect0_size);  // Nothing registered
+    }
+    uint64_t sect0_read = Header_sect0ReadSize(elf_header, sect0, sect0_size);
+    elfparser_span_t span;
+    ElfParser_statsBegin(&span, ELFPARSER_PHASE_HEADER);
+    int ret = Header_extendedResolveRun(elf_header, sect0, sect0_size);
+    ElfParser_statsEnd(&span, ret, sect0_read, 1);
+    return ret;
+}
+
+/**
+ * @brief Body of ElfParser_Header_parseRaw(), run with or without an open span
+ * @return int See ElfParser_Header_parseRaw()
+ */
+static int Header_parseRawRun(elfparser_header_t *elf_header, const void *map, size_t size)
+{
     if (!elf_header || !map)
     {
         return ELFPARSER_ERR_NULL;  // Null pointer input
@@ -165,44 +271,89 @@ int ElfParser_Header_parse(elfparser_header_t *elf_header, const void *map, size
     size_t header_size = ElfParser_Header_sizeGet(elf_header);  // Cache header size
     if (size < header_size || header_size == 0)
     {
+        ElfParser_statsErrorAt(header_size ? size : IDENT_CLASS_OFF);
         return ELFPARSER_ERR_SIZE;  // Insufficient size or invalid class
     }
 
-    const uint32_t *mem_off;    // Selected offset array
-    const uint32_t *mem_size;   // Selected size array
-    if (elf_header->elf_ident.elf_class == ELFPARSER_HEADER_CLASS_32_BIT)
+    int is_64bit = (elf_header->elf_ident.elf_class == ELFPARSER_HEADER_CLASS_64_BIT);  // Class already validated by sizeGet
+    if (elf_header->elf_ident.elf_data == ELFPARSER_HEADER_DATA_LITTLE_ENDIANNESS)
     {
-        mem_off = mem_off_32bit;
-        mem_size = mem_size_32bit;
+        is_64bit ? Header_decode64Le(elf_header, map) : Header_decode32Le(elf_header, map);
     }
-    else if (elf_header->elf_ident.elf_class == ELFPARSER_HEADER_CLASS_64_BIT)
+    else if (elf_header->elf_ident.elf_data == ELFPARSER_HEADER_DATA_BIG_ENDIANNESS)
     {
-        mem_off = mem_off_64bit;
-        mem_size = mem_size_64bit;
+        is_64bit ? Header_decode64Be(elf_header, map) : Header_decode32Be(elf_header, map);
     }
     else
     {
-        return ELFPARSER_ERR_CLASS;  // Invalid class
+        ElfParser_statsErrorAt(IDENT_DATA_OFF);
+        return ELFPARSER_ERR_CLASS;  // Invalid endianness
     }
+    return ELFPARSER_SUCCESS;  // Success
+}
 
-    for (uint8_t i = 0; i < HEADER_ENTRY_NUM; i++)  // Parse header fields
+/**
+ * @brief Decodes the ELF header fields without resolving extended numbering
+ * @param[out] elf_header Pointer to the ELF header structure to populate
+ * @param[in] map Pointer to the start of the ELF file (only the header itself is read)
+ * @param[in] size Size of the memory map in bytes
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_SIZE if size is insufficient,
+ *             ELFPARSER_ERR_NULL if inputs are NULL, ELFPARSER_ERR_CLASS if class or endianness is invalid
+ */
+int ElfParser_Header_parseRaw(elfparser_header_t *elf_header, const void *map, size_t size)
+{
+    if (!ElfParser_statsActive())
     {
-        if (mem_off[i] + mem_size[i] > size)  // Bounds check
-        {
-            return ELFPARSER_ERR_SIZE;
-        }
-        if (elf_header->elf_ident.elf_data == ELFPARSER_HEADER_DATA_BIG_ENDIANNESS)
-        {
-            ElfParser_memRevCpy(ret_dest[i], map + mem_off[i], mem_size[i]);  // Big-endian copy
-        }
-        else if (elf_header->elf_ident.elf_data == ELFPARSER_HEADER_DATA_LITTLE_ENDIANNESS)
-        {
-            ElfParser_memCpy(ret_dest[i], map + mem_off[i], mem_size[i]);  // Little-endian copy
-        }
-        else
-        {
-            return ELFPARSER_ERR_CLASS;  // Invalid endianness
-        }
+        return Header_parseRawRun(elf_header, map, size);  // Nothing registered
     }
-    return ELFPARSER_SUCCESS;  // Success
+    elfparser_span_t span;
+    ElfParser_statsBegin(&span, ELFPARSER_PHASE_HEADER);
+    int ret = Header_parseRawRun(elf_header, map, size);
+    ElfParser_statsEnd(&span, ret, ElfParser_Header_sizeGet(elf_header), 1);
+    return ret;
+}
+
+/**
+ * @brief Body of ElfParser_Header_parse(), run with or without an open span
+ * @return int See ElfParser_Header_parse()
+ */
+static int Header_parseRun(elfparser_header_t *elf_header, const void *map, size_t size, uint64_t *sect0_read)
+{
+    int ret = Header_parseRawRun(elf_header, map, size);  // One span for the whole parse
+    if (ret < 0 || !ElfParser_Header_extendedUsed(elf_header))
+    {
+        return ret;  // Invalid header or plain numbering
+    }
+    if (elf_header->elf_section_header_off > size)
+    {
+        ElfParser_statsErrorAt(size);
+        return ELFPARSER_ERR_SIZE;  // Section header 0 not inside the map
+    }
+    const uint8_t *sect0 = (const uint8_t *)map + elf_header->elf_section_header_off;
+    size_t sect0_size = size - elf_header->elf_section_header_off;
+    *sect0_read = Header_sect0ReadSize(elf_header, sect0, sect0_size);
+    return Header_extendedResolveRun(elf_header, sect0, sect0_size);  // Counts beyond 16 bits live in section 0
+}
+
+/**
+ * @brief Parses the full ELF header from a memory map
+ * @param[out] elf_header Pointer to the ELF header structure to populate
+ * @param[in] map Pointer to the memory-mapped ELF file
+ * @param[in] size Size of the memory map in bytes
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_SIZE if size is insufficient (including
+ *             section header 0 when extended numbering is used), ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_CLASS if class or endianness is invalid
+ */
+int ElfParser_Header_parse(elfparser_header_t *elf_header, const void *map, size_t size)
+{
+    uint64_t sect0_read = 0;
+    if (!ElfParser_statsActive())
+    {
+        return Header_parseRun(elf_header, map, size, &sect0_read);  // Nothing registered
+    }
+    elfparser_span_t span;
+    ElfParser_statsBegin(&span, ELFPARSER_PHASE_HEADER);
+    int ret = Header_parseRun(elf_header, map, size, &sect0_read);
+    ElfParser_statsEnd(&span, ret, ElfParser_Header_sizeGet(elf_header) + sect0_read, 1);
+    return ret;
 }
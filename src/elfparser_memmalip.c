@@ -12,6 +12,7 @@
 
 #include "../inc_priv/elfparser_memmanip_priv.h"
 #include "../inc_pub/elfparser_common.h"
+#include "../inc_priv/elfparser_alloc_priv.h"
 
 /**
  * @brief Copies a block of memory from source to destination
@@ -201,6 +202,19 @@ int64_t ElfParser_strExtract(const void *map, char **dup, size_t start, size_t l
  *                 ELFPARSER_ERR_MALLOC if malloc fails, ELFPARSER_ERR_MEMCPY if copy fails
  */
 int64_t ElfParser_strDup(const char *str, char **dup)
+{
+    return ElfParser_strDupAlloc(str, dup, NULL);  // Plain malloc
+}
+
+/**
+ * @brief Duplicates a null-terminated string into memory from an allocator
+ * @param[in] str Source string to duplicate
+ * @param[out] dup Pointer to store the duplicated string
+ * @param[in] alloc Allocator of the copy, NULL for malloc
+ * @return int64_t Length of duplicated string on success, ELFPARSER_ERR_NULL if str is NULL,
+ *                 ELFPARSER_ERR_MALLOC if allocation fails, ELFPARSER_ERR_MEMCPY if copy fails
+ */
+int64_t ElfParser_strDupAlloc(const char *str, char **dup, const elfparser_alloc_t *alloc)
 {
     size_t cnt = 0;
     int64_t ret_val = 0;
@@ -218,16 +232,93 @@ int64_t ElfParser_strDup(const char *str, char **dup)
         }
     }
     ret_val = cnt + 1;  // Include null terminator
-    *dup = malloc(ret_val);
+    *dup = ElfParser_allocMalloc(alloc, (size_t)ret_val);
     if (!*dup)
     {
         return ELFPARSER_ERR_MALLOC;
     }
     if (!ElfParser_memCpy(*dup, str, ret_val))
     {
-        free(*dup);  // Cleanup on failure
+        ElfParser_allocFree(alloc, *dup);  // Cleanup on failure
         *dup = NULL;
         return ELFPARSER_ERR_MEMCPY;
     }
     return ret_val;
 }
+
+/**
+ * @brief Measures a null-terminated string that must end inside a bounded region
+ * @param[in] str Start of the string
+ * @param[in] max_len Number of bytes available from str onwards
+ * @return int64_t Length of the string without terminator on success, ELFPARSER_ERR_NULL if str is NULL,
+ *                 ELFPARSER_ERR_RANGE if no terminator is found within max_len bytes
+ */
+int64_t ElfParser_strLenBounded(const char *str, size_t max_len)
+{
+    size_t cnt = 0;
+
+    if (!str)
+    {
+        return ELFPARSER_ERR_NULL;
+    }
+    while (cnt < max_len)
+    {
+        if (str[cnt] == '\0')
+        {
+            return (int64_t)cnt;  // Terminator found inside the region
+        }
+        cnt++;
+    }
+    return ELFPARSER_ERR_RANGE;  // Unterminated string
+}
+
+/**
+ * @brief Computes the GNU (DJB2-style) hash of a null-terminated string
+ * @param[in] str String to hash
+ * @return uint32_t Hash value (h = h * 33 + c, seeded with 5381), 0 if str is NULL
+ */
+uint32_t ElfParser_gnuHash(const char *str)
+{
+    const uint8_t *str_p = (const uint8_t *)str;
+    uint32_t hash = 5381u;
+
+    if (!str)
+    {
+        return 0;
+    }
+    while (*str_p != '\0')
+    {
+        hash = (hash << 5) + hash + *str_p;  // hash * 33 + c
+        str_p++;
+    }
+    return hash;
+}
+
+/**
+ * @brief Computes the System V ELF hash of a null-terminated string
+ * @param[in] str String to hash
+ * @return uint32_t Hash value as used by SHT_HASH sections, 0 if str is NULL
+ */
+uint32_t ElfParser_sysvHash(const char *str)
+{
+    const uint8_t *str_p = (const uint8_t *)str;
+    uint32_t hash = 0;
+    uint32_t high = 0;
+
+    if (!str)
+    {
+        return 0;
+    }
+    while (*str_p != '\0')
+    {
+        hash = (hash << 4) + *str_p;
+        high = hash & 0xf0000000u;
+        if (high)
+        {
+            hash ^= high >> 24;
+        }
+        hash &= ~high;
+        str_p++;
+    }
+    return hash;
+}
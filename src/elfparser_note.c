@@ -0,0 +1,136 @@
+/**
+ * @file elfparser_note.c
+ * @brief ELF note parsing functions for libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This file implements functions to walk the notes of an ELF note section or
+ * segment within the standalone libelfparser library. Every note is bounds
+ * checked against the caller's buffer and returned as a view into it, so no
+ * memory is allocated; lookups by owner and type, including the GNU build-id,
+ * are built on the same iterator.
+ */
+
+#include "../inc_priv/elfparser_note_priv.h"
+#include "../inc_pub/elfparser_note.h"
+#include "../inc_priv/elfparser_memmanip_priv.h"
+#include <stdlib.h>
+
+/**
+ * @brief Decodes the note at an offset and advances the offset to the next note
+ * @param[in] map Pointer to the contents of the note section or segment
+ * @param[in] map_size Size of the contents in bytes
+ * @param[in,out] offset Offset of the note to decode, 0 for the first; advanced past it on success
+ * @param[in] elf_data Data encoding of the file
+ * @param[in] align sh_addralign or p_align of the section or segment
+ * @param[out] note Pointer to the note structure to fill
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NOT_FOUND once offset is past the last note,
+ *             ELFPARSER_ERR_NULL if inputs are NULL, ELFPARSER_ERR_SIZE if the note overruns map
+ */
+int ElfParser_Note_next(const void *map, size_t map_size, size_t *offset, elfparser_header_data_e elf_data,
+                        uint64_t align, elfparser_note_t *note)
+{
+    if (!map || !offset || !note)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    if (*offset >= map_size)
+    {
+        return ELFPARSER_ERR_NOT_FOUND;  // No more notes
+    }
+    if (map_size - *offset < NOTE_HEADER_SIZE)
+    {
+        return ELFPARSER_ERR_SIZE;  // Truncated note header
+    }
+
+    const uint8_t *src = (const uint8_t *)map + *offset;
+    const int big_endian = (elf_data == ELFPARSER_HEADER_DATA_BIG_ENDIANNESS);
+    const uint64_t pad = (align == NOTE_ALIGN_WIDE) ? NOTE_ALIGN_WIDE : NOTE_ALIGN_DEFAULT;
+    uint32_t name_size = ElfParser_load32(src + NOTE_NAMESZ_OFF, big_endian);
+    uint32_t desc_size = ElfParser_load32(src + NOTE_DESCSZ_OFF, big_endian);
+    uint64_t name_off = (uint64_t)*offset + NOTE_HEADER_SIZE;
+    uint64_t desc_off = (name_off + name_size + pad - 1) & ~(pad - 1);    // 64-bit sums cannot wrap
+    uint64_t next_off = (desc_off + desc_size + pad - 1) & ~(pad - 1);
+    if (desc_off + desc_size > map_size)
+    {
+        return ELFPARSER_ERR_SIZE;  // Name or descriptor overruns the buffer
+    }
+
+    note->note_name = (const char *)map + name_off;
+    note->note_name_len = name_size;
+    if (name_size && note->note_name[name_size - 1] == '\0')
+    {
+        note->note_name_len = name_size - 1;  // n_namesz counts the terminator
+    }
+    note->note_type = ElfParser_load32(src + NOTE_TYPE_OFF, big_endian);
+    note->note_desc = (const uint8_t *)map + desc_off;
+    note->note_desc_size = desc_size;
+    *offset = (next_off < map_size) ? (size_t)next_off : map_size;  // Trailing padding may be cut off
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Finds the first note with a given owner and type
+ * @param[in] map Pointer to the contents of the note section or segment
+ * @param[in] map_size Size of the contents in bytes
+ * @param[in] elf_data Data encoding of the file
+ * @param[in] align sh_addralign or p_align of the section or segment
+ * @param[in] name Owner name to match (e.g., ELFPARSER_NOTE_NAME_GNU)
+ * @param[in] type Note type to match
+ * @param[out] note Pointer to the note structure to fill
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NOT_FOUND if there is no such note,
+ *             or the error of ElfParser_Note_next()
+ */
+int ElfParser_Note_find(const void *map, size_t map_size, elfparser_header_data_e elf_data, uint64_t align,
+                        const char *name, uint32_t type, elfparser_note_t *note)
+{
+    if (!name)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    size_t name_len = 0;
+    while (name[name_len])
+    {
+        name_len++;
+    }
+
+    size_t offset = 0;
+    int ret;
+    while ((ret = ElfParser_Note_next(map, map_size, &offset, elf_data, align, note)) == ELFPARSER_SUCCESS)
+    {
+        if (note->note_type == type && note->note_name_len == name_len &&
+            ElfParser_memCmp(note->note_name, name, name_len) == 0)
+        {
+            return ELFPARSER_SUCCESS;  // Found
+        }
+    }
+    return ret;  // ELFPARSER_ERR_NOT_FOUND at the end, or a malformed note
+}
+
+/**
+ * @brief Finds the GNU build-id note
+ * @param[in] map Pointer to the contents of the note section or segment
+ * @param[in] map_size Size of the contents in bytes
+ * @param[in] elf_data Data encoding of the file
+ * @param[in] align sh_addralign or p_align of the section or segment
+ * @param[out] note Pointer to the note structure to fill, note_desc being the build-id
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NOT_FOUND if there is no build-id,
+ *             ELFPARSER_ERR_FORMAT if it is empty or longer than ELFPARSER_NOTE_BUILD_ID_MAX,
+ *             or the error of ElfParser_Note_next()
+ */
+int ElfParser_Note_buildIdFind(const void *map, size_t map_size, elfparser_header_data_e elf_data, uint64_t align,
+                               elfparser_note_t *note)
+{
+    int ret = ElfParser_Note_find(map, map_size, elf_data, align, ELFPARSER_NOTE_NAME_GNU,
+                                  ELFPARSER_NOTE_TYPE_GNU_BUILD_ID, note);
+    if (ret < 0)
+    {
+        return ret;  // Absent or malformed
+    }
+    if (note->note_desc_size == 0 || note->note_desc_size > ELFPARSER_NOTE_BUILD_ID_MAX)
+    {
+        return ELFPARSER_ERR_FORMAT;  // Not a usable identifier
+    }
+    return ELFPARSER_SUCCESS;  // Success
+}
@@ -0,0 +1,392 @@
+/**
+ * @file elfparser_proghead.c
+ * @brief ELF program header parsing functions for libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This file implements functions to parse and manage ELF program headers within
+ * the standalone libelfparser library. It supports setting up program header
+ * structures, parsing program header tables with the same per-layout decoders
+ * the section headers use, translating between virtual addresses and file
+ * offsets through binary searches over the sorted PT_LOAD segments, and
+ * freeing allocated resources, for both 32-bit and 64-bit ELF formats.
+ */
+
+#include "../inc_priv/elfparser_proghead_priv.h"
+#include "../inc_pub/elfparser_proghead.h"
+#include "../inc_priv/elfparser_memmanip_priv.h"
+#include "../inc_priv/elfparser_alloc_priv.h"
+#include <stdlib.h>
+
+/**
+ * @brief Sets up the program header structure using ELF header data
+ * @param[out] prog_head Pointer to the program header structure to initialize
+ * @param[in] header Pointer to the ELF header containing program header metadata
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_MALLOC if memory allocation fails
+ */
+int ElfParser_ProgHead_structSetup(elfparser_proghead_t *prog_head, const elfparser_header_t *header)
+{
+    if (!prog_head || !header)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+
+    prog_head->elf_class = header->elf_ident.elf_class;                     // Set ELF class (32/64-bit)
+    prog_head->elf_data = header->elf_ident.elf_data;                       // Set endianness
+    prog_head->entry_size = header->elf_program_header_entry_size;          // Size of each program header entry
+    prog_head->table_len = header->elf_program_header_entry_num;            // Number of program header entries
+    prog_head->by_vaddr = NULL;                                             // Indices are built by parse
+    prog_head->by_offset = NULL;
+    prog_head->vaddr_num = 0;
+    prog_head->offset_num = 0;
+    prog_head->table = ElfParser_allocMalloc(NULL, ((size_t)prog_head->table_len ? prog_head->table_len : 1) * sizeof(elfparser_proghead_entry_t)); // Allocate table
+    if (!prog_head->table)
+    {
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Decodes consecutive program header entries for one class and endianness
+ *
+ * Always inlined into the four layout-specific decoders below, so the field
+ * offsets, widths and byte order are compile-time constants in each of them.
+ *
+ * @param[out] entries Destination array of at least count entries
+ * @param[in] src Pointer to the first raw entry
+ * @param[in] count Number of entries to decode
+ * @param[in] entry_size Distance between raw entries in bytes
+ * @param[in] is_64bit Non-zero for the 64-bit layout
+ * @param[in] big_endian Non-zero for big-endian data
+ */
+static inline __attribute__((always_inline)) void ProgHead_entriesKernel(elfparser_proghead_entry_t *entries, const uint8_t *src,
+                                                                         size_t count, size_t entry_size,
+                                                                         const int is_64bit, const int big_endian)
+{
+    for (size_t i = 0; i < count; i++, src += entry_size)  // One fixed-layout entry per iteration
+    {
+        elfparser_proghead_entry_t *entry = &entries[i];
+        entry->ph_type = ElfParser_load32(src + PROGHEADER_ENTRY_TYPE_OFF, big_endian);
+        if (is_64bit)
+        {
+            entry->ph_flags = ElfParser_load32(src + PROGHEADER_ENTRY_FLAGS_OFF_64BIT, big_endian);
+            entry->ph_offset = ElfParser_load64(src + PROGHEADER_ENTRY_OFFSET_OFF_64BIT, big_endian);
+            entry->ph_vaddr = ElfParser_load64(src + PROGHEADER_ENTRY_VADDR_OFF_64BIT, big_endian);
+            entry->ph_paddr = ElfParser_load64(src + PROGHEADER_ENTRY_PADDR_OFF_64BIT, big_endian);
+            entry->ph_filesz = ElfParser_load64(src + PROGHEADER_ENTRY_FILESZ_OFF_64BIT, big_endian);
+            entry->ph_memsz = ElfParser_load64(src + PROGHEADER_ENTRY_MEMSZ_OFF_64BIT, big_endian);
+            entry->ph_align = ElfParser_load64(src + PROGHEADER_ENTRY_ALIGN_OFF_64BIT, big_endian);
+        }
+        else
+        {
+            entry->ph_flags = ElfParser_load32(src + PROGHEADER_ENTRY_FLAGS_OFF_32BIT, big_endian);
+            entry->ph_offset = ElfParser_load32(src + PROGHEADER_ENTRY_OFFSET_OFF_32BIT, big_endian);
+            entry->ph_vaddr = ElfParser_load32(src + PROGHEADER_ENTRY_VADDR_OFF_32BIT, big_endian);
+            entry->ph_paddr = ElfParser_load32(src + PROGHEADER_ENTRY_PADDR_OFF_32BIT, big_endian);
+            entry->ph_filesz = ElfParser_load32(src + PROGHEADER_ENTRY_FILESZ_OFF_32BIT, big_endian);
+            entry->ph_memsz = ElfParser_load32(src + PROGHEADER_ENTRY_MEMSZ_OFF_32BIT, big_endian);
+            entry->ph_align = ElfParser_load32(src + PROGHEADER_ENTRY_ALIGN_OFF_32BIT, big_endian);
+        }
+    }
+}
+
+/* Layout-specific program header decoders (32/64-bit x little/big-endian) */
+static void ProgHead_decode32Le(elfparser_proghead_entry_t *entries, const uint8_t *src, size_t count, size_t entry_size)
+{
+    ProgHead_entriesKernel(entries, src, count, entry_size, 0, 0);
+}
+static void ProgHead_decode32Be(elfparser_proghead_entry_t *entries, const uint8_t *src, size_t count, size_t entry_size)
+{
+    ProgHead_entriesKernel(entries, src, count, entry_size, 0, 1);
+}
+static void ProgHead_decode64Le(elfparser_proghead_entry_t *entries, const uint8_t *src, size_t count, size_t entry_size)
+{
+    ProgHead_entriesKernel(entries, src, count, entry_size, 1, 0);
+}
+static void ProgHead_decode64Be(elfparser_proghead_entry_t *entries, const uint8_t *src, size_t count, size_t entry_size)
+{
+    ProgHead_entriesKernel(entries, src, count, entry_size, 1, 1);
+}
+
+/**
+ * @brief Orders spans by start, then by segment index
+ * @param[in] a Pointer to the first span
+ * @param[in] b Pointer to the second span
+ * @return int Negative, zero or positive as for qsort()
+ */
+static int ProgHead_spanCompare(const void *a, const void *b)
+{
+    const elfparser_proghead_span_t *span_a = a;
+    const elfparser_proghead_span_t *span_b = b;
+
+    if (span_a->start != span_b->start)
+    {
+        return (span_a->start < span_b->start) ? -1 : 1;
+    }
+    return (span_a->idx > span_b->idx) - (span_a->idx < span_b->idx);
+}
+
+/**
+ * @brief Fills the running maximum of the last byte each sorted span covers
+ * @param[in,out] spans Spans sorted by start
+ * @param[in] span_num Number of spans
+ * @param[in] table Program header entries the spans refer to
+ * @param[in] by_file Nonzero to measure spans by ph_filesz, zero by ph_memsz
+ */
+static void ProgHead_spanReach(elfparser_proghead_span_t *spans, uint32_t span_num, const elfparser_proghead_entry_t *table, int by_file)
+{
+    uint64_t reach = 0;
+
+    for (uint32_t i = 0; i < span_num; i++)
+    {
+        const elfparser_proghead_entry_t *entry = &table[spans[i].idx];
+        uint64_t size = by_file ? entry->ph_filesz : entry->ph_memsz;  // Nonzero, empty spans are not indexed
+        uint64_t last = (size - 1 > UINT64_MAX - spans[i].start) ? UINT64_MAX : spans[i].start + (size - 1);  // Saturated
+        reach = (last > reach) ? last : reach;
+        spans[i].reach = reach;
+    }
+}
+
+/**
+ * @brief Builds the sorted PT_LOAD indices of a decoded table
+ * @param[in,out] prog_head Pointer to the program header structure
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_MALLOC if memory allocation fails
+ */
+static int ProgHead_loadIndexBuild(elfparser_proghead_t *prog_head)
+{
+    size_t cap = prog_head->table_len ? prog_head->table_len : 1;
+
+    ElfParser_allocFree(NULL, prog_head->by_vaddr);  // Parsing again replaces earlier indices
+    ElfParser_allocFree(NULL, prog_head->by_offset);
+    prog_head->vaddr_num = 0;
+    prog_head->offset_num = 0;
+    prog_head->by_vaddr = ElfParser_allocMalloc(NULL, cap * sizeof(elfparser_proghead_span_t));
+    prog_head->by_offset = ElfParser_allocMalloc(NULL, cap * sizeof(elfparser_proghead_span_t));
+    if (!prog_head->by_vaddr || !prog_head->by_offset)
+    {
+        ElfParser_allocFree(NULL, prog_head->by_vaddr);
+        ElfParser_allocFree(NULL, prog_head->by_offset);
+        prog_head->by_vaddr = NULL;
+        prog_head->by_offset = NULL;
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+
+    for (uint32_t i = 0; i < prog_head->table_len; i++)  // Collect loadable segments
+    {
+        const elfparser_proghead_entry_t *entry = &prog_head->table[i];
+        if (entry->ph_type != ELFPARSER_PROGHEAD_TYPE_LOAD)
+        {
+            continue;
+        }
+        if (entry->ph_memsz > 0)
+        {
+            prog_head->by_vaddr[prog_head->vaddr_num++] = (elfparser_proghead_span_t){ entry->ph_vaddr, 0, i };
+        }
+        if (entry->ph_filesz > 0)
+        {
+            prog_head->by_offset[prog_head->offset_num++] = (elfparser_proghead_span_t){ entry->ph_offset, 0, i };
+        }
+    }
+    qsort(prog_head->by_vaddr, prog_head->vaddr_num, sizeof(elfparser_proghead_span_t), ProgHead_spanCompare);
+    qsort(prog_head->by_offset, prog_head->offset_num, sizeof(elfparser_proghead_span_t), ProgHead_spanCompare);
+    ProgHead_spanReach(prog_head->by_vaddr, prog_head->vaddr_num, prog_head->table, 0);
+    ProgHead_spanReach(prog_head->by_offset, prog_head->offset_num, prog_head->table, 1);
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Parses the program header table from a memory map and builds the PT_LOAD indices
+ * @param[out] prog_head Pointer to the program header structure to populate
+ * @param[in] map Pointer to the memory-mapped program header table
+ * @param[in] map_size Size of the memory map in bytes
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_SIZE if size is insufficient, ELFPARSER_ERR_CLASS if class or endianness is invalid,
+ *             ELFPARSER_ERR_MALLOC if the indices cannot be allocated
+ */
+int ElfParser_ProgHead_parse(elfparser_proghead_t *prog_head, const void *map, size_t map_size)
+{
+    if (!prog_head || !map || !prog_head->table)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    size_t required_size = (size_t)prog_head->entry_size * prog_head->table_len;
+    if (map_size < required_size || required_size == 0)
+    {
+        return ELFPARSER_ERR_SIZE;  // Insufficient size or invalid table length
+    }
+
+    size_t layout_size;  // Bytes one entry occupies in this class
+    void (*decode)(elfparser_proghead_entry_t *, const uint8_t *, size_t, size_t);  // Hoisted dispatch
+    int big_endian = (prog_head->elf_data == ELFPARSER_HEADER_DATA_BIG_ENDIANNESS);
+    if (prog_head->elf_data != ELFPARSER_HEADER_DATA_LITTLE_ENDIANNESS && !big_endian)
+    {
+        return ELFPARSER_ERR_CLASS;  // Invalid endianness
+    }
+    if (prog_head->elf_class == ELFPARSER_HEADER_CLASS_32_BIT)
+    {
+        layout_size = PROGHEADER_ENTRY_ALIGN_OFF_32BIT + PROGHEADER_ENTRY_WORD_SIZE_32BIT;
+        decode = big_endian ? ProgHead_decode32Be : ProgHead_decode32Le;
+    }
+    else if (prog_head->elf_class == ELFPARSER_HEADER_CLASS_64_BIT)
+    {
+        layout_size = PROGHEADER_ENTRY_ALIGN_OFF_64BIT + PROGHEADER_ENTRY_WORD_SIZE_64BIT;
+        decode = big_endian ? ProgHead_decode64Be : ProgHead_decode64Le;
+    }
+    else
+    {
+        return ELFPARSER_ERR_CLASS;  // Invalid class
+    }
+    if (required_size - prog_head->entry_size + layout_size > map_size)
+    {
+        return ELFPARSER_ERR_SIZE;  // Last entry runs out of the map
+    }
+
+    decode(prog_head->table, map, prog_head->table_len, prog_head->entry_size);
+    return ProgHead_loadIndexBuild(prog_head);
+}
+
+/**
+ * @brief Returns the last span starting at or below a key that also covers it
+ *
+ * Segments may overlap, so the span starting closest below the key can end
+ * before it while an earlier, longer one still covers it. The search steps
+ * back from the floor only while the running reach says some span at or
+ * before the current one still extends to the key.
+ *
+ * @param[in] spans Spans sorted by start, with reach filled
+ * @param[in] span_num Number of spans
+ * @param[in] table Program header entries the spans refer to
+ * @param[in] by_file Nonzero to measure spans by ph_filesz, zero by ph_memsz
+ * @param[in] key Address or offset to look up
+ * @return const elfparser_proghead_span_t* Covering span, NULL if no span covers key
+ */
+static const elfparser_proghead_span_t *ProgHead_spanFind(const elfparser_proghead_span_t *spans, uint32_t span_num,
+                                                          const elfparser_proghead_entry_t *table, int by_file, uint64_t key)
+{
+    uint32_t lo = 0;
+    uint32_t hi = span_num;
+
+    while (lo < hi)  // Upper bound: first span starting above key
+    {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (spans[mid].start <= key)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    while (lo > 0 && spans[lo - 1].reach >= key)  // Some span up to here still reaches key
+    {
+        const elfparser_proghead_span_t *span = &spans[--lo];
+        uint64_t size = by_file ? table[span->idx].ph_filesz : table[span->idx].ph_memsz;
+        if (key - span->start < size)
+        {
+            return span;  // Latest-starting segment that covers key
+        }
+    }
+    return NULL;  // Below the first segment or in a gap
+}
+
+/**
+ * @brief Finds the PT_LOAD segment whose memory image covers a virtual address
+ * @param[in] prog_head Pointer to a parsed program header structure
+ * @param[in] vaddr Virtual address to look up
+ * @return int64_t Index of the segment in table, ELFPARSER_ERR_NOT_FOUND if no segment covers vaddr,
+ *                 ELFPARSER_ERR_NULL if the structure is not parsed
+ */
+int64_t ElfParser_ProgHead_vaddrFind(const elfparser_proghead_t *prog_head, uint64_t vaddr)
+{
+    if (!prog_head || !prog_head->table || !prog_head->by_vaddr)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input or not parsed
+    }
+
+    const elfparser_proghead_span_t *span = ProgHead_spanFind(prog_head->by_vaddr, prog_head->vaddr_num, prog_head->table, 0, vaddr);
+    if (!span)
+    {
+        return ELFPARSER_ERR_NOT_FOUND;  // Below the first segment or in a gap
+    }
+    return span->idx;
+}
+
+/**
+ * @brief Translates a virtual address to the file offset holding its bytes
+ * @param[in] prog_head Pointer to a parsed program header structure
+ * @param[in] vaddr Virtual address to translate
+ * @param[out] offset File offset of vaddr
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NOT_FOUND if vaddr has no file bytes,
+ *             ELFPARSER_ERR_NULL if inputs are NULL or the structure is not parsed
+ */
+int ElfParser_ProgHead_vaddrToOffset(const elfparser_proghead_t *prog_head, uint64_t vaddr, uint64_t *offset)
+{
+    if (!offset)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    int64_t seg_idx = ElfParser_ProgHead_vaddrFind(prog_head, vaddr);
+    if (seg_idx < 0)
+    {
+        return (int)seg_idx;  // Not mapped or invalid input
+    }
+
+    const elfparser_proghead_entry_t *entry = &prog_head->table[seg_idx];
+    if (vaddr - entry->ph_vaddr >= entry->ph_filesz)
+    {
+        return ELFPARSER_ERR_NOT_FOUND;  // Zero-filled part of the segment
+    }
+    *offset = entry->ph_offset + (vaddr - entry->ph_vaddr);
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Translates a file offset to the virtual address it is loaded at
+ * @param[in] prog_head Pointer to a parsed program header structure
+ * @param[in] offset File offset to translate
+ * @param[out] vaddr Virtual address of offset
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NOT_FOUND if no PT_LOAD segment maps offset,
+ *             ELFPARSER_ERR_NULL if inputs are NULL or the structure is not parsed
+ */
+int ElfParser_ProgHead_offsetToVaddr(const elfparser_proghead_t *prog_head, uint64_t offset, uint64_t *vaddr)
+{
+    if (!prog_head || !prog_head->table || !prog_head->by_offset || !vaddr)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input or not parsed
+    }
+
+    const elfparser_proghead_span_t *span = ProgHead_spanFind(prog_head->by_offset, prog_head->offset_num, prog_head->table, 1, offset);
+    if (!span)
+    {
+        return ELFPARSER_ERR_NOT_FOUND;  // Not part of any loaded segment
+    }
+    *vaddr = prog_head->table[span->idx].ph_vaddr + (offset - span->start);
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Frees the program header structure and its allocated resources
+ * @param[in,out] prog_head Pointer to the program header structure to free
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if the structure is NULL or already freed
+ */
+int ElfParser_ProgHead_free(elfparser_proghead_t *prog_head)
+{
+    if (!prog_head || !prog_head->table)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+
+    ElfParser_allocFree(NULL, prog_head->by_vaddr);
+    ElfParser_allocFree(NULL, prog_head->by_offset);
+    ElfParser_allocFree(NULL, prog_head->table);  // Free the table
+    prog_head->by_vaddr = NULL;
+    prog_head->by_offset = NULL;
+    prog_head->vaddr_num = 0;
+    prog_head->offset_num = 0;
+    prog_head->table = NULL; // Nullify pointer
+    return ELFPARSER_SUCCESS;  // Success
+}
@@ -0,0 +1,523 @@
+/**
+ * @file elfparser_reader.c
+ * @brief Byte-range reader functions for libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This file implements the two reader backends. The mmap backend is a thin
+ * wrapper around one read-only mapping. The pread backend keeps the file
+ * descriptor open and a short array of cached blocks, each an exact file
+ * range; a request is served from any block containing it, otherwise read on
+ * its own. Blocks are pinned while a caller holds a pointer into them, and
+ * unpinned blocks are evicted least recently used first once the cache grows
+ * past READER_CACHE_LIMIT. Requests are expected to number in the tens per
+ * file, so blocks are found by a linear scan.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE  // pread, posix_fadvise, st_mtim and the Linux mmap/madvise extensions
+#endif
+
+#include "../inc_pub/elfparser_reader.h"
+#include "../inc_priv/elfparser_reader_priv.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifndef MAP_POPULATE
+#define MAP_POPULATE 0  // Prefaulting is a Linux extension, plain lazy mapping elsewhere
+#endif
+
+static const uint8_t Reader_emptyRange[1];  // Returned for zero-length ranges, never dereferenced by callers
+
+/**
+ * @brief Opens a file with the given backend
+ * @param[out] reader Pointer to the reader structure to initialize
+ * @param[in] path Path of the file
+ * @param[in] backend Backend to read through
+ * @param[in] flags Bitwise OR of ELFPARSER_READER_FLAG_* values
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_IO if the file cannot be opened, inspected or mapped, ELFPARSER_ERR_SIZE if the file
+ *             is empty, ELFPARSER_ERR_RANGE if the backend is invalid or the file does not fit the address space
+ */
+int ElfParser_Reader_open(elfparser_reader_t *reader, const char *path, elfparser_reader_backend_e backend, uint32_t flags)
+{
+    if (!reader || !path)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    if (backend != ELFPARSER_READER_BACKEND_MMAP && backend != ELFPARSER_READER_BACKEND_PREAD)
+    {
+        return ELFPARSER_ERR_RANGE;  // Unknown backend
+    }
+
+    memset(reader, 0, sizeof(*reader));  // No block cached yet
+    reader->fd = -1;
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return ELFPARSER_ERR_IO;  // Cannot open
+    }
+    struct stat st;
+    if (fstat(fd, &st) < 0)
+    {
+        close(fd);
+        return ELFPARSER_ERR_IO;  // Cannot inspect
+    }
+    if (st.st_size <= 0)
+    {
+        close(fd);
+        return ELFPARSER_ERR_SIZE;  // Nothing to read
+    }
+    if ((uint64_t)st.st_size > SIZE_MAX)
+    {
+        close(fd);
+        return ELFPARSER_ERR_RANGE;  // Larger than the address space
+    }
+
+    if (backend == ELFPARSER_READER_BACKEND_MMAP)
+    {
+        int map_flags = MAP_PRIVATE | ((flags & ELFPARSER_READER_FLAG_POPULATE) ? MAP_POPULATE : 0);
+        void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, map_flags, fd, 0);
+        close(fd);  // The mapping keeps the file referenced
+        if (map == MAP_FAILED)
+        {
+            return ELFPARSER_ERR_IO;  // Cannot map
+        }
+        reader->map = map;
+    }
+    else
+    {
+        reader->fd = fd;  // Kept for the positional reads
+    }
+    reader->backend = backend;
+    reader->flags = flags;
+    reader->file_size = (uint64_t)st.st_size;
+    reader->file_dev = (uint64_t)st.st_dev;
+    reader->file_ino = (uint64_t)st.st_ino;
+    reader->file_mtime = (uint64_t)st.st_mtim.tv_sec * 1000000000ull + (uint64_t)st.st_mtim.tv_nsec;
+    reader->stats.file_size = reader->file_size;
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Reads a byte range of the file completely
+ * @param[in,out] reader Pointer to an open pread reader
+ * @param[out] dst Destination of size bytes
+ * @param[in] offset Start of the range in the file
+ * @param[in] size Length of the range in bytes
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_IO if a read fails,
+ *             ELFPARSER_ERR_SIZE if the file ends early
+ */
+static int Reader_readExact(elfparser_reader_t *reader, uint8_t *dst, uint64_t offset, uint64_t size)
+{
+    uint64_t done = 0;
+    while (done < size)  // pread() may return less than asked for
+    {
+        ssize_t got = pread(reader->fd, dst + done, (size_t)(size - done), (off_t)(offset + done));
+        if (got < 0 && errno == EINTR)
+        {
+            continue;  // Interrupted, retry
+        }
+        if (got < 0)
+        {
+            return ELFPARSER_ERR_IO;  // Read failed
+        }
+        if (got == 0)
+        {
+            return ELFPARSER_ERR_SIZE;  // File shrank since open
+        }
+        done += (uint64_t)got;
+    }
+    reader->stats.bytes_read += size;
+    reader->stats.read_num++;
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Finds a cached block containing a byte range
+ * @param[in] reader Pointer to an open pread reader
+ * @param[in] offset Start of the range in the file
+ * @param[in] size Length of the range in bytes
+ * @return elfparser_reader_block_t* Containing block, NULL if none
+ */
+static elfparser_reader_block_t *Reader_blockFind(const elfparser_reader_t *reader, uint64_t offset, uint64_t size)
+{
+    for (uint32_t i = 0; i < reader->block_num; i++)
+    {
+        elfparser_reader_block_t *block = &reader->blocks[i];
+        if (offset >= block->offset && offset - block->offset <= block->size && size <= block->size - (offset - block->offset))
+        {
+            return block;
+        }
+    }
+    return NULL;  // Not cached
+}
+
+/**
+ * @brief Evicts least recently used unpinned blocks until the cache is within its limit
+ *
+ * Blocks read ahead by ElfParser_Reader_prefetch() are kept until they are
+ * first requested, otherwise a read-ahead could be dropped and read again.
+ *
+ * @param[in,out] reader Pointer to an open pread reader
+ */
+static void Reader_evict(elfparser_reader_t *reader)
+{
+    while (reader->cache_size > READER_CACHE_LIMIT)
+    {
+        elfparser_reader_block_t *victim = NULL;
+        for (uint32_t i = 0; i < reader->block_num; i++)  // Oldest unpinned block
+        {
+            elfparser_reader_block_t *block = &reader->blocks[i];
+            if (block->ref_num == 0 && !block->prefetched && (!victim || block->last_use < victim->last_use))
+            {
+                victim = block;
+            }
+        }
+        if (!victim)
+        {
+            return;  // Everything left is pinned
+        }
+        reader->cache_size -= victim->size;
+        free(victim->data);
+        *victim = reader->blocks[--reader->block_num];  // Order does not matter
+    }
+}
+
+/**
+ * @brief Reads a byte range into a new cached block
+ * @param[in,out] reader Pointer to an open pread reader
+ * @param[in] offset Start of the range in the file
+ * @param[in] size Length of the range in bytes, non-zero
+ * @param[in] ref_num Initial number of pins
+ * @param[out] added Set to the new block, valid until the next call that adds or evicts blocks
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_MALLOC if memory allocation fails,
+ *             or the error of Reader_readExact()
+ */
+static int Reader_blockAdd(elfparser_reader_t *reader, uint64_t offset, uint64_t size, uint32_t ref_num,
+                           elfparser_reader_block_t **added)
+{
+    if (reader->block_num == reader->block_cap)  // Grow the block array
+    {
+        uint32_t cap = reader->block_cap ? reader->block_cap * 2 : READER_BLOCK_CAP_INIT;
+        elfparser_reader_block_t *blocks = realloc(reader->blocks, (size_t)cap * sizeof(elfparser_reader_block_t));
+        if (!blocks)
+        {
+            return ELFPARSER_ERR_MALLOC;  // Allocation failure
+        }
+        reader->blocks = blocks;
+        reader->block_cap = cap;
+    }
+    uint8_t *data = malloc((size_t)size);
+    if (!data)
+    {
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+    int ret = Reader_readExact(reader, data, offset, size);
+    if (ret < 0)
+    {
+        free(data);
+        return ret;  // Read failed
+    }
+
+    elfparser_reader_block_t *block = &reader->blocks[reader->block_num++];
+    block->data = data;
+    block->offset = offset;
+    block->size = size;
+    block->ref_num = ref_num;
+    block->last_use = ++reader->use_clock;
+    block->prefetched = 0;
+    reader->cache_size += size;
+    *added = block;
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Returns a pointer to a byte range of the file and pins it
+ * @param[in,out] reader Pointer to an open reader structure
+ * @param[in] offset Start of the range in the file
+ * @param[in] size Length of the range in bytes
+ * @param[out] data Set to the first byte of the range
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL or the reader is not open,
+ *             ELFPARSER_ERR_RANGE if the range lies outside the file, ELFPARSER_ERR_MALLOC if memory
+ *             allocation fails, ELFPARSER_ERR_IO if a read fails
+ */
+int ElfParser_Reader_rangeGet(elfparser_reader_t *reader, uint64_t offset, uint64_t size, const void **data)
+{
+    if (!reader || !data || (!reader->map && reader->fd < 0))
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input or not open
+    }
+    if (offset > reader->file_size || size > reader->file_size - offset)
+    {
+        return ELFPARSER_ERR_RANGE;  // Outside the file
+    }
+
+    if (reader->backend == ELFPARSER_READER_BACKEND_MMAP)
+    {
+        reader->stats.bytes_read += size;
+        reader->stats.read_num++;
+        *data = reader->map + offset;
+        return ELFPARSER_SUCCESS;  // Zero-copy
+    }
+    if (size == 0)
+    {
+        *data = Reader_emptyRange;
+        return ELFPARSER_SUCCESS;  // Nothing to read or pin
+    }
+
+    elfparser_reader_block_t *block = Reader_blockFind(reader, offset, size);
+    if (block)
+    {
+        reader->stats.cache_hits++;
+        block->ref_num++;
+        block->prefetched = 0;  // Read-ahead consumed, evictable once released
+        block->last_use = ++reader->use_clock;
+    }
+    else
+    {
+        reader->stats.cache_misses++;
+        int ret = Reader_blockAdd(reader, offset, size, 1, &block);
+        if (ret < 0)
+        {
+            return ret;  // Allocation or read failure
+        }
+    }
+    *data = block->data + (offset - block->offset);
+    Reader_evict(reader);  // May move blocks, but never the data of a pinned one
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Drops a pin taken by ElfParser_Reader_rangeGet()
+ * @param[in,out] reader Pointer to an open reader structure
+ * @param[in] data Pointer returned by ElfParser_Reader_rangeGet()
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_NOT_FOUND if data was not handed out by this reader or is not pinned
+ */
+int ElfParser_Reader_rangeRelease(elfparser_reader_t *reader, const void *data)
+{
+    if (!reader || !data)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    if (reader->backend == ELFPARSER_READER_BACKEND_MMAP || data == Reader_emptyRange)
+    {
+        return ELFPARSER_SUCCESS;  // Nothing is pinned
+    }
+
+    const uint8_t *ptr = data;
+    for (uint32_t i = 0; i < reader->block_num; i++)
+    {
+        elfparser_reader_block_t *block = &reader->blocks[i];
+        if (ptr >= block->data && ptr < block->data + block->size && block->ref_num > 0)
+        {
+            block->ref_num--;
+            Reader_evict(reader);
+            return ELFPARSER_SUCCESS;  // Success
+        }
+    }
+    return ELFPARSER_ERR_NOT_FOUND;  // Unknown or unpinned pointer
+}
+
+/**
+ * @brief Orders ranges by offset
+ * @param[in] a Pointer to the first range
+ * @param[in] b Pointer to the second range
+ * @return int Negative, zero or positive as for qsort()
+ */
+static int Reader_rangeCompare(const void *a, const void *b)
+{
+    const elfparser_reader_range_t *range_a = a;
+    const elfparser_reader_range_t *range_b = b;
+    return (range_a->offset > range_b->offset) - (range_a->offset < range_b->offset);
+}
+
+/**
+ * @brief Announces ranges that are about to be requested
+ * @param[in,out] reader Pointer to an open reader structure
+ * @param[in] ranges Ranges to fetch, in any order
+ * @param[in] range_num Number of ranges
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL or the reader is not open,
+ *             ELFPARSER_ERR_RANGE if a range lies outside the file, ELFPARSER_ERR_MALLOC if memory
+ *             allocation fails, ELFPARSER_ERR_IO if a read fails
+ */
+int ElfParser_Reader_prefetch(elfparser_reader_t *reader, const elfparser_reader_range_t *ranges, size_t range_num)
+{
+    if (!reader || (!ranges && range_num) || (!reader->map && reader->fd < 0))
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input or not open
+    }
+    for (size_t i = 0; i < range_num; i++)
+    {
+        if (ranges[i].offset > reader->file_size || ranges[i].size > reader->file_size - ranges[i].offset)
+        {
+            return ELFPARSER_ERR_RANGE;  // Outside the file
+        }
+    }
+    if (reader->backend == ELFPARSER_READER_BACKEND_MMAP)
+    {
+        for (size_t i = 0; i < range_num; i++)
+        {
+            ElfParser_Reader_advise(reader, ranges[i].offset, ranges[i].size, ELFPARSER_READER_ADVICE_WILLNEED);
+        }
+        return ELFPARSER_SUCCESS;  // Read-ahead only
+    }
+
+    elfparser_reader_range_t *todo = malloc((range_num ? range_num : 1) * sizeof(elfparser_reader_range_t));
+    if (!todo)
+    {
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+    size_t todo_num = 0;
+    for (size_t i = 0; i < range_num; i++)  // Only what is neither empty nor cached
+    {
+        if (ranges[i].size && !Reader_blockFind(reader, ranges[i].offset, ranges[i].size))
+        {
+            todo[todo_num++] = ranges[i];
+        }
+    }
+    qsort(todo, todo_num, sizeof(elfparser_reader_range_t), Reader_rangeCompare);
+
+    int ret = ELFPARSER_SUCCESS;
+    size_t i = 0;
+    while (i < todo_num && ret >= 0)  // One read per run of nearby ranges
+    {
+        uint64_t run_start = todo[i].offset;
+        uint64_t run_end = todo[i].offset + todo[i].size;
+        for (i++; i < todo_num && todo[i].offset <= run_end + READER_COALESCE_GAP; i++)
+        {
+            uint64_t end = todo[i].offset + todo[i].size;
+            run_end = (end > run_end) ? end : run_end;
+        }
+        if (run_end - run_start > READER_CACHE_LIMIT)
+        {
+            continue;  // Larger than the cache, each range is read on request instead
+        }
+        elfparser_reader_block_t *block;
+        ret = Reader_blockAdd(reader, run_start, run_end - run_start, 0, &block);
+        if (ret >= 0)
+        {
+            block->prefetched = 1;  // Kept until requested
+        }
+    }
+    free(todo);
+    Reader_evict(reader);  // Only older blocks, the ones just read stay
+    return ret;
+}
+
+/**
+ * @brief Gives an access-pattern hint for a byte range of the file
+ * @param[in] reader Pointer to an open reader structure
+ * @param[in] offset Start of the range in the file
+ * @param[in] size Length of the range in bytes
+ * @param[in] advice Access pattern to announce
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if the reader is NULL or not open,
+ *             ELFPARSER_ERR_RANGE if offset is past the end of the file or advice is invalid
+ */
+int ElfParser_Reader_advise(const elfparser_reader_t *reader, uint64_t offset, uint64_t size, elfparser_reader_advice_e advice)
+{
+    if (!reader || (!reader->map && reader->fd < 0))
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input or not open
+    }
+    if (offset > reader->file_size)
+    {
+        return ELFPARSER_ERR_RANGE;  // Outside the file
+    }
+
+    int madv;
+    int fadv;
+    switch (advice)
+    {
+        case ELFPARSER_READER_ADVICE_NORMAL:     madv = MADV_NORMAL;     fadv = POSIX_FADV_NORMAL;     break;
+        case ELFPARSER_READER_ADVICE_RANDOM:     madv = MADV_RANDOM;     fadv = POSIX_FADV_RANDOM;     break;
+        case ELFPARSER_READER_ADVICE_SEQUENTIAL: madv = MADV_SEQUENTIAL; fadv = POSIX_FADV_SEQUENTIAL; break;
+        case ELFPARSER_READER_ADVICE_WILLNEED:   madv = MADV_WILLNEED;   fadv = POSIX_FADV_WILLNEED;   break;
+        case ELFPARSER_READER_ADVICE_DONTNEED:   madv = MADV_DONTNEED;   fadv = POSIX_FADV_DONTNEED;   break;
+        default:                                 return ELFPARSER_ERR_RANGE;  // Unknown advice
+    }
+    if ((reader->flags & ELFPARSER_READER_FLAG_NO_ADVISE) ||
+        (advice == ELFPARSER_READER_ADVICE_DONTNEED && (reader->flags & ELFPARSER_READER_FLAG_POPULATE)))
+    {
+        return ELFPARSER_SUCCESS;  // Hints disabled, or pages are meant to stay resident
+    }
+
+    uint64_t end = (size > reader->file_size - offset) ? reader->file_size : offset + size;  // Clamp to the file
+    if (reader->backend == ELFPARSER_READER_BACKEND_PREAD)
+    {
+        (void)posix_fadvise(reader->fd, (off_t)offset, (off_t)(end - offset), fadv);  // Advisory only, kernel rounds to pages
+        return ELFPARSER_SUCCESS;  // Success
+    }
+
+    long page_size = sysconf(_SC_PAGESIZE);
+    uint64_t page = (page_size > 0) ? (uint64_t)page_size : READER_PAGE_SIZE_DEFAULT;
+    uint64_t start;
+    if (advice == ELFPARSER_READER_ADVICE_DONTNEED)  // Release only pages wholly inside the range
+    {
+        start = (offset + page - 1) & ~(page - 1);
+        end = (end == reader->file_size) ? ((end + page - 1) & ~(page - 1)) : (end & ~(page - 1));
+    }
+    else  // Cover every page the range touches
+    {
+        start = offset & ~(page - 1);
+        end = (end + page - 1) & ~(page - 1);
+    }
+    if (end > start)
+    {
+        (void)madvise((void *)(reader->map + start), (size_t)(end - start), madv);  // Advisory only
+    }
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Copies the I/O counters of a reader
+ * @param[in] reader Pointer to an open reader structure
+ * @param[out] stats Destination of the counters
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL
+ */
+int ElfParser_Reader_statsGet(const elfparser_reader_t *reader, elfparser_reader_stats_t *stats)
+{
+    if (!reader || !stats)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+
+    *stats = reader->stats;
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Releases every cached block, unmaps or closes the file
+ * @param[in,out] reader Pointer to the reader structure to close
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if the reader is NULL or not open
+ */
+int ElfParser_Reader_close(elfparser_reader_t *reader)
+{
+    if (!reader || (!reader->map && reader->fd < 0))
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input or already closed
+    }
+
+    for (uint32_t i = 0; i < reader->block_num; i++)  // Pinned or not
+    {
+        free(reader->blocks[i].data);
+    }
+    free(reader->blocks);
+    if (reader->map)
+    {
+        munmap((void *)reader->map, (size_t)reader->file_size);
+    }
+    if (reader->fd >= 0)
+    {
+        close(reader->fd);
+    }
+    memset(reader, 0, sizeof(*reader));  // Mark as closed
+    reader->fd = -1;
+    return ELFPARSER_SUCCESS;  // Success
+}
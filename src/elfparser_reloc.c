@@ -0,0 +1,556 @@
+/**
+ * @file elfparser_reloc.c
+ * @brief ELF relocation table parsing functions for libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This file implements functions to decode ELF relocation sections within the
+ * standalone libelfparser library. SHT_REL and SHT_RELA entries go through
+ * one always-inlined kernel specialised per class, data encoding and addend
+ * presence, so each of the eight decoders runs a branch-free loop with
+ * constant field offsets. SHT_RELR sections are expanded in two passes, a
+ * popcount pass sizing the table and a decode pass filling it. Grouping by
+ * symbol or by patched section is a counting sort into compressed sparse rows.
+ */
+
+#include "../inc_priv/elfparser_reloc_priv.h"
+#include "../inc_pub/elfparser_reloc.h"
+#include "../inc_priv/elfparser_memmanip_priv.h"
+#include <stdlib.h>
+
+/**
+ * @brief Address range of one SHF_ALLOC section, for placing dynamic relocations
+ */
+typedef struct reloc_sect_span_s
+{
+    uint64_t    start;      /**< sh_addr */
+    uint64_t    end;        /**< sh_addr + sh_size, saturated */
+    uint32_t    sect_idx;   /**< Index of the section */
+} reloc_sect_span_t;
+
+/**
+ * @brief Sets up the relocation structure using section and header data
+ * @param[out] reloc Pointer to the relocation structure to initialize
+ * @param[in] sect_head Pointer to the section header structure
+ * @param[in] reloc_sect_idx Index of the relocation section in sect_head
+ * @param[in] header Pointer to the ELF header containing class, endianness and type
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_RANGE if reloc_sect_idx is invalid or the entry geometry does not fit,
+ *             ELFPARSER_ERR_FORMAT if the section is not SHT_REL/SHT_RELA/SHT_RELR,
+ *             ELFPARSER_ERR_CLASS if class or endianness is invalid, ELFPARSER_ERR_MALLOC if memory allocation fails
+ */
+int ElfParser_Reloc_structSetup(elfparser_reloc_t *reloc, const elfparser_secthead_t *sect_head, uint32_t reloc_sect_idx, const elfparser_header_t *header)
+{
+    if (!reloc || !sect_head || !header)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    if (reloc_sect_idx >= sect_head->table_len || !sect_head->table)
+    {
+        return ELFPARSER_ERR_RANGE;  // Invalid section index
+    }
+
+    const elfparser_secthead_entry_t *rel_sect = &sect_head->table[reloc_sect_idx];
+    const int is_64bit = (header->elf_ident.elf_class == ELFPARSER_HEADER_CLASS_64_BIT);
+    if (!is_64bit && header->elf_ident.elf_class != ELFPARSER_HEADER_CLASS_32_BIT)
+    {
+        return ELFPARSER_ERR_CLASS;  // Invalid class
+    }
+    if (header->elf_ident.elf_data != ELFPARSER_HEADER_DATA_LITTLE_ENDIANNESS &&
+        header->elf_ident.elf_data != ELFPARSER_HEADER_DATA_BIG_ENDIANNESS)
+    {
+        return ELFPARSER_ERR_CLASS;  // Invalid endianness
+    }
+
+    uint64_t min_size;  // Smallest entry size that holds every field
+    switch (rel_sect->sh_type)
+    {
+        case ELFPARSER_SECTHEAD_TYPE_REL:
+            min_size = is_64bit ? RELOC_REL_SIZE_64BIT : RELOC_REL_SIZE_32BIT;
+            break;
+        case ELFPARSER_SECTHEAD_TYPE_RELA:
+            min_size = is_64bit ? RELOC_RELA_SIZE_64BIT : RELOC_RELA_SIZE_32BIT;
+            break;
+        case ELFPARSER_SECTHEAD_TYPE_RELR:
+            min_size = is_64bit ? RELOC_RELR_SIZE_64BIT : RELOC_RELR_SIZE_32BIT;
+            break;
+        default:
+            return ELFPARSER_ERR_FORMAT;  // Not a relocation section
+    }
+    if (rel_sect->sh_entsize < min_size || rel_sect->sh_entsize > UINT16_MAX ||
+        (rel_sect->sh_type == ELFPARSER_SECTHEAD_TYPE_RELR && rel_sect->sh_entsize != min_size) ||
+        rel_sect->sh_size / rel_sect->sh_entsize > UINT32_MAX)
+    {
+        return ELFPARSER_ERR_RANGE;  // Entry size too small or entry count out of range
+    }
+
+    reloc->elf_class = header->elf_ident.elf_class;  // Set ELF class
+    reloc->elf_data = header->elf_ident.elf_data;    // Set endianness
+    reloc->sect_type = rel_sect->sh_type;            // Decides layout and addend presence
+    reloc->entry_size = (uint16_t)rel_sect->sh_entsize; // Size of each entry
+    reloc->sym_table_idx = (rel_sect->sh_type == ELFPARSER_SECTHEAD_TYPE_RELR) ? 0 : rel_sect->sh_link;
+    reloc->target_sect_idx = 0;                       // Placed by address unless sh_info names the section
+    if (rel_sect->sh_info < sect_head->table_len &&
+        ((rel_sect->sh_flags & ELFPARSER_SECTHEAD_FLAG_INFO_LINK) || header->elf_type == ELFPARSER_HEADER_TYPE_REL))
+    {
+        reloc->target_sect_idx = rel_sect->sh_info;
+    }
+    reloc->table = NULL;
+    reloc->table_len = 0;
+    if (rel_sect->sh_type == ELFPARSER_SECTHEAD_TYPE_RELR)
+    {
+        return ELFPARSER_SUCCESS;  // Length known only after the bitmaps are counted
+    }
+
+    reloc->table_len = (uint32_t)(rel_sect->sh_size / reloc->entry_size); // Number of entries
+    reloc->table = malloc(((size_t)reloc->table_len ? reloc->table_len : 1) * sizeof(elfparser_reloc_entry_t)); // Allocate table
+    if (!reloc->table)
+    {
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Decodes consecutive SHT_REL or SHT_RELA entries for one layout
+ *
+ * Always inlined into the layout-specific decoders below, so the field
+ * offsets, widths, r_info packing and byte order are compile-time constants
+ * in each of them.
+ *
+ * @param[out] entries Destination array of at least count entries
+ * @param[in] src Pointer to the first raw entry
+ * @param[in] count Number of entries to decode
+ * @param[in] entry_size Distance between raw entries in bytes
+ * @param[in] is_64bit Non-zero for the 64-bit layout
+ * @param[in] big_endian Non-zero for big-endian data
+ * @param[in] has_addend Non-zero for Elf_Rela
+ */
+static inline __attribute__((always_inline)) void Reloc_entriesKernel(elfparser_reloc_entry_t *entries, const uint8_t *src, size_t count,
+                                                                      size_t entry_size, const int is_64bit, const int big_endian,
+                                                                      const int has_addend)
+{
+    for (size_t i = 0; i < count; i++, src += entry_size)  // One fixed-layout entry per iteration
+    {
+        elfparser_reloc_entry_t *entry = &entries[i];
+        if (is_64bit)
+        {
+            uint64_t info = ElfParser_load64(src + RELOC_ENTRY_INFO_OFF_64BIT, big_endian);
+            entry->rel_offset = ElfParser_load64(src + RELOC_ENTRY_OFFSET_OFF, big_endian);
+            entry->rel_addend = has_addend ? (int64_t)ElfParser_load64(src + RELOC_ENTRY_ADDEND_OFF_64BIT, big_endian) : 0;
+            entry->rel_sym_idx = (uint32_t)(info >> RELOC_INFO_SYM_SHIFT_64BIT);
+            entry->rel_type = (uint32_t)(info & RELOC_INFO_TYPE_MASK_64BIT);
+        }
+        else
+        {
+            uint32_t info = ElfParser_load32(src + RELOC_ENTRY_INFO_OFF_32BIT, big_endian);
+            entry->rel_offset = ElfParser_load32(src + RELOC_ENTRY_OFFSET_OFF, big_endian);
+            entry->rel_addend = has_addend ? (int32_t)ElfParser_load32(src + RELOC_ENTRY_ADDEND_OFF_32BIT, big_endian) : 0; // Sign-extended
+            entry->rel_sym_idx = info >> RELOC_INFO_SYM_SHIFT_32BIT;
+            entry->rel_type = info & RELOC_INFO_TYPE_MASK_32BIT;
+        }
+    }
+}
+
+/* Layout-specific relocation decoders (32/64-bit x little/big-endian x REL/RELA) */
+static void Reloc_decodeRel32Le(elfparser_reloc_entry_t *entries, const uint8_t *src, size_t count, size_t entry_size)
+{
+    Reloc_entriesKernel(entries, src, count, entry_size, 0, 0, 0);
+}
+static void Reloc_decodeRel32Be(elfparser_reloc_entry_t *entries, const uint8_t *src, size_t count, size_t entry_size)
+{
+    Reloc_entriesKernel(entries, src, count, entry_size, 0, 1, 0);
+}
+static void Reloc_decodeRel64Le(elfparser_reloc_entry_t *entries, const uint8_t *src, size_t count, size_t entry_size)
+{
+    Reloc_entriesKernel(entries, src, count, entry_size, 1, 0, 0);
+}
+static void Reloc_decodeRel64Be(elfparser_reloc_entry_t *entries, const uint8_t *src, size_t count, size_t entry_size)
+{
+    Reloc_entriesKernel(entries, src, count, entry_size, 1, 1, 0);
+}
+static void Reloc_decodeRela32Le(elfparser_reloc_entry_t *entries, const uint8_t *src, size_t count, size_t entry_size)
+{
+    Reloc_entriesKernel(entries, src, count, entry_size, 0, 0, 1);
+}
+static void Reloc_decodeRela32Be(elfparser_reloc_entry_t *entries, const uint8_t *src, size_t count, size_t entry_size)
+{
+    Reloc_entriesKernel(entries, src, count, entry_size, 0, 1, 1);
+}
+static void Reloc_decodeRela64Le(elfparser_reloc_entry_t *entries, const uint8_t *src, size_t count, size_t entry_size)
+{
+    Reloc_entriesKernel(entries, src, count, entry_size, 1, 0, 1);
+}
+static void Reloc_decodeRela64Be(elfparser_reloc_entry_t *entries, const uint8_t *src, size_t count, size_t entry_size)
+{
+    Reloc_entriesKernel(entries, src, count, entry_size, 1, 1, 1);
+}
+
+/**
+ * @brief Counts the relocations a SHT_RELR section expands to
+ * @param[in] src Pointer to the first word
+ * @param[in] word_num Number of words
+ * @param[in] is_64bit Non-zero for 64-bit words
+ * @param[in] big_endian Non-zero for big-endian data
+ * @return uint64_t Number of relocations
+ */
+static uint64_t Reloc_relrCount(const uint8_t *src, size_t word_num, int is_64bit, int big_endian)
+{
+    uint64_t count = 0;
+
+    for (size_t i = 0; i < word_num; i++)
+    {
+        uint64_t word = is_64bit ? ElfParser_load64(src + i * RELOC_RELR_SIZE_64BIT, big_endian)
+                                 : ElfParser_load32(src + i * RELOC_RELR_SIZE_32BIT, big_endian);
+        count += (word & 1u) ? (uint64_t)__builtin_popcountll(word >> 1) : 1u;  // Bitmap or single address
+    }
+    return count;
+}
+
+/**
+ * @brief Expands a SHT_RELR section into relocation entries
+ *
+ * An even word is the address of one relocation and sets the base to the
+ * word after it; an odd word is a bitmap whose bit i (from 1) marks a
+ * relocation at base + (i - 1) words, after which the base advances by one
+ * word per bitmap bit.
+ *
+ * @param[out] entries Destination array, sized by Reloc_relrCount()
+ * @param[in] src Pointer to the first word
+ * @param[in] word_num Number of words
+ * @param[in] is_64bit Non-zero for 64-bit words
+ * @param[in] big_endian Non-zero for big-endian data
+ */
+static void Reloc_relrDecode(elfparser_reloc_entry_t *entries, const uint8_t *src, size_t word_num, int is_64bit, int big_endian)
+{
+    const uint64_t word_size = is_64bit ? RELOC_RELR_SIZE_64BIT : RELOC_RELR_SIZE_32BIT;
+    const uint64_t addr_mask = is_64bit ? UINT64_MAX : UINT32_MAX;
+    uint64_t base = 0;
+
+    for (size_t i = 0; i < word_num; i++)
+    {
+        uint64_t word = is_64bit ? ElfParser_load64(src + i * RELOC_RELR_SIZE_64BIT, big_endian)
+                                 : ElfParser_load32(src + i * RELOC_RELR_SIZE_32BIT, big_endian);
+        if ((word & 1u) == 0)  // Address entry
+        {
+            entries->rel_offset = word;
+            entries->rel_addend = 0;
+            entries->rel_sym_idx = 0;
+            entries->rel_type = 0;
+            entries++;
+            base = (word + word_size) & addr_mask;
+            continue;
+        }
+        for (uint64_t bits = word >> 1; bits; bits &= bits - 1)  // Bitmap entry, set bits only
+        {
+            entries->rel_offset = (base + (uint64_t)__builtin_ctzll(bits) * word_size) & addr_mask;
+            entries->rel_addend = 0;
+            entries->rel_sym_idx = 0;
+            entries->rel_type = 0;
+            entries++;
+        }
+        base = (base + (word_size * 8u - 1u) * word_size) & addr_mask;
+    }
+}
+
+/**
+ * @brief Decodes the relocation section contents
+ * @param[in,out] reloc Pointer to a relocation structure set up by ElfParser_Reloc_structSetup()
+ * @param[in] map Pointer to the contents of the relocation section
+ * @param[in] map_size Size of the section contents in bytes
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_SIZE if map is too small, ELFPARSER_ERR_FORMAT if sect_type is not a relocation type,
+ *             ELFPARSER_ERR_RANGE if a SHT_RELR section expands past UINT32_MAX entries,
+ *             ELFPARSER_ERR_MALLOC if memory allocation fails
+ */
+int ElfParser_Reloc_parse(elfparser_reloc_t *reloc, const void *map, size_t map_size)
+{
+    if (!reloc || !map)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    const int is_64bit = (reloc->elf_class == ELFPARSER_HEADER_CLASS_64_BIT);
+    const int big_endian = (reloc->elf_data == ELFPARSER_HEADER_DATA_BIG_ENDIANNESS);
+
+    if (reloc->sect_type == ELFPARSER_SECTHEAD_TYPE_RELR)
+    {
+        size_t word_num = map_size / (is_64bit ? RELOC_RELR_SIZE_64BIT : RELOC_RELR_SIZE_32BIT);
+        uint64_t count = Reloc_relrCount(map, word_num, is_64bit, big_endian);
+        if (count > UINT32_MAX)
+        {
+            return ELFPARSER_ERR_RANGE;  // Too many relocations for table_len
+        }
+        free(reloc->table);  // Parsed twice, keep the latest
+        reloc->table = malloc(((size_t)count ? (size_t)count : 1) * sizeof(elfparser_reloc_entry_t));
+        if (!reloc->table)
+        {
+            reloc->table_len = 0;
+            return ELFPARSER_ERR_MALLOC;  // Allocation failure
+        }
+        reloc->table_len = (uint32_t)count;
+        Reloc_relrDecode(reloc->table, map, word_num, is_64bit, big_endian);
+        return ELFPARSER_SUCCESS;  // Success
+    }
+
+    if (!reloc->table)
+    {
+        return ELFPARSER_ERR_NULL;  // Not set up
+    }
+    size_t required_size = (size_t)reloc->entry_size * reloc->table_len;
+    if (map_size < required_size)
+    {
+        return ELFPARSER_ERR_SIZE;  // Insufficient size
+    }
+    void (*decode)(elfparser_reloc_entry_t *, const uint8_t *, size_t, size_t);  // Hoisted dispatch
+    if (reloc->sect_type == ELFPARSER_SECTHEAD_TYPE_RELA)
+    {
+        decode = is_64bit ? (big_endian ? Reloc_decodeRela64Be : Reloc_decodeRela64Le)
+                          : (big_endian ? Reloc_decodeRela32Be : Reloc_decodeRela32Le);
+    }
+    else if (reloc->sect_type == ELFPARSER_SECTHEAD_TYPE_REL)
+    {
+        decode = is_64bit ? (big_endian ? Reloc_decodeRel64Be : Reloc_decodeRel64Le)
+                          : (big_endian ? Reloc_decodeRel32Be : Reloc_decodeRel32Le);
+    }
+    else
+    {
+        return ELFPARSER_ERR_FORMAT;  // Not a relocation section
+    }
+
+    decode(reloc->table, map, reloc->table_len, reloc->entry_size);
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Turns per-entry keys into compressed sparse rows with a counting sort
+ * @param[out] group Pointer to the group structure to populate
+ * @param[in] keys Key of each relocation, each below key_num
+ * @param[in] key_num Number of keys
+ * @param[in] entry_num Number of relocations
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_MALLOC if memory allocation fails
+ */
+static int Reloc_groupBuild(elfparser_reloc_group_t *group, const uint32_t *keys, uint32_t key_num, uint32_t entry_num)
+{
+    group->key_num = key_num;
+    group->group_start = calloc((size_t)key_num + 1u, sizeof(uint32_t));
+    group->entry_idx = malloc(((size_t)entry_num ? entry_num : 1) * sizeof(uint32_t));
+    if (!group->group_start || !group->entry_idx)
+    {
+        ElfParser_Reloc_groupFree(group);
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+
+    for (uint32_t i = 0; i < entry_num; i++)  // Histogram, shifted by one
+    {
+        group->group_start[keys[i] + 1u]++;
+    }
+    for (uint32_t k = 0; k < key_num; k++)  // Prefix sum: start of each group
+    {
+        group->group_start[k + 1u] += group->group_start[k];
+    }
+    for (uint32_t i = 0; i < entry_num; i++)  // Stable scatter, group_start[k] advances to the end of group k
+    {
+        group->entry_idx[group->group_start[keys[i]]++] = i;
+    }
+    for (uint32_t k = key_num; k > 0; k--)  // Shift the ends back into starts
+    {
+        group->group_start[k] = group->group_start[k - 1u];
+    }
+    group->group_start[0] = 0;
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Groups the relocations by the symbol table entry they reference
+ * @param[out] group Pointer to the group structure to populate
+ * @param[in] reloc Pointer to a parsed relocation structure
+ * @param[in] sym_num Number of entries in the linked symbol table (1 for SHT_RELR)
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_RANGE if a symbol index is not below sym_num, ELFPARSER_ERR_MALLOC if memory allocation fails
+ */
+int ElfParser_Reloc_symGroup(elfparser_reloc_group_t *group, const elfparser_reloc_t *reloc, uint32_t sym_num)
+{
+    if (!group || !reloc || !reloc->table)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    group->group_start = NULL;
+    group->entry_idx = NULL;
+    group->key_num = 0;
+
+    for (uint32_t i = 0; i < reloc->table_len; i++)  // Size from the symbol table, never from the entries
+    {
+        if (reloc->table[i].rel_sym_idx >= sym_num)
+        {
+            return ELFPARSER_ERR_RANGE;  // Symbol index past the linked table
+        }
+    }
+    uint32_t *keys = malloc(((size_t)reloc->table_len ? reloc->table_len : 1) * sizeof(uint32_t));
+    if (!keys)
+    {
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+    for (uint32_t i = 0; i < reloc->table_len; i++)
+    {
+        keys[i] = reloc->table[i].rel_sym_idx;
+    }
+    int ret = Reloc_groupBuild(group, keys, sym_num, reloc->table_len);
+    free(keys);
+    return ret;
+}
+
+/**
+ * @brief Orders section spans by start address for qsort()
+ * @param[in] lhs First span
+ * @param[in] rhs Second span
+ * @return int Negative, zero or positive as for qsort()
+ */
+static int Reloc_spanCompare(const void *lhs, const void *rhs)
+{
+    const reloc_sect_span_t *a = lhs;
+    const reloc_sect_span_t *b = rhs;
+    if (a->start != b->start)
+    {
+        return (a->start > b->start) - (a->start < b->start);
+    }
+    return (a->sect_idx > b->sect_idx) - (a->sect_idx < b->sect_idx);  // Deterministic order for equal starts
+}
+
+/**
+ * @brief Finds the section span containing an address
+ * @param[in] spans Spans sorted by start address
+ * @param[in] span_num Number of spans
+ * @param[in] addr Address to place
+ * @return size_t Index of the span, or span_num if no span contains addr
+ */
+static size_t Reloc_spanFind(const reloc_sect_span_t *spans, size_t span_num, uint64_t addr)
+{
+    size_t lo = 0;
+    size_t hi = span_num;
+
+    while (lo < hi)  // First span starting above addr
+    {
+        size_t mid = lo + (hi - lo) / 2u;
+        if (spans[mid].start <= addr)
+        {
+            lo = mid + 1u;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return (lo > 0 && addr < spans[lo - 1u].end) ? lo - 1u : span_num;
+}
+
+/**
+ * @brief Groups the relocations by the section they patch
+ * @param[out] group Pointer to the group structure to populate
+ * @param[in] reloc Pointer to a parsed relocation structure
+ * @param[in] sect_head Pointer to the section header structure of the same file
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_RANGE if target_sect_idx is not a section of sect_head,
+ *             ELFPARSER_ERR_MALLOC if memory allocation fails
+ */
+int ElfParser_Reloc_sectGroup(elfparser_reloc_group_t *group, const elfparser_reloc_t *reloc, const elfparser_secthead_t *sect_head)
+{
+    if (!group || !reloc || !reloc->table || !sect_head || !sect_head->table)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    group->group_start = NULL;
+    group->entry_idx = NULL;
+    group->key_num = 0;
+    if (reloc->target_sect_idx >= sect_head->table_len)
+    {
+        return ELFPARSER_ERR_RANGE;  // Section header table of another file
+    }
+
+    uint32_t *keys = malloc(((size_t)reloc->table_len ? reloc->table_len : 1) * sizeof(uint32_t));
+    if (!keys)
+    {
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+    if (reloc->target_sect_idx)  // Every entry patches the same section
+    {
+        for (uint32_t i = 0; i < reloc->table_len; i++)
+        {
+            keys[i] = reloc->target_sect_idx;
+        }
+    }
+    else  // Dynamic relocations: place each address
+    {
+        reloc_sect_span_t *spans = malloc(((size_t)sect_head->table_len ? sect_head->table_len : 1) * sizeof(reloc_sect_span_t));
+        if (!spans)
+        {
+            free(keys);
+            return ELFPARSER_ERR_MALLOC;  // Allocation failure
+        }
+        size_t span_num = 0;
+        for (uint32_t s = 0; s < sect_head->table_len; s++)  // Mapped, non-TLS sections (TLS ones alias other addresses)
+        {
+            const elfparser_secthead_entry_t *sect = &sect_head->table[s];
+            if (!(sect->sh_flags & ELFPARSER_SECTHEAD_FLAG_ALLOC) || (sect->sh_flags & ELFPARSER_SECTHEAD_FLAG_TLS) || sect->sh_size == 0)
+            {
+                continue;
+            }
+            spans[span_num].start = sect->sh_addr;
+            spans[span_num].end = (sect->sh_addr + sect->sh_size < sect->sh_addr) ? UINT64_MAX : sect->sh_addr + sect->sh_size;
+            spans[span_num].sect_idx = s;
+            span_num++;
+        }
+        qsort(spans, span_num, sizeof(reloc_sect_span_t), Reloc_spanCompare);
+
+        size_t last = span_num;  // Relocations come mostly sorted: try the previous section first
+        for (uint32_t i = 0; i < reloc->table_len; i++)
+        {
+            uint64_t addr = reloc->table[i].rel_offset;
+            if (last == span_num || addr < spans[last].start || addr >= spans[last].end)
+            {
+                last = Reloc_spanFind(spans, span_num, addr);
+            }
+            keys[i] = (last == span_num) ? 0 : spans[last].sect_idx;
+        }
+        free(spans);
+    }
+    int ret = Reloc_groupBuild(group, keys, sect_head->table_len, reloc->table_len);
+    free(keys);
+    return ret;
+}
+
+/**
+ * @brief Frees the resources held by a relocation group
+ * @param[in,out] group Pointer to the group structure to free
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if group is NULL
+ */
+int ElfParser_Reloc_groupFree(elfparser_reloc_group_t *group)
+{
+    if (!group)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    free(group->group_start);  // Safe to free NULL
+    free(group->entry_idx);
+    group->group_start = NULL;
+    group->entry_idx = NULL;
+    group->key_num = 0;
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Frees the resources held by a relocation structure
+ * @param[in,out] reloc Pointer to the relocation structure to free
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if reloc is NULL
+ */
+int ElfParser_Reloc_free(elfparser_reloc_t *reloc)
+{
+    if (!reloc)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    free(reloc->table);  // Safe to free NULL
+    reloc->table = NULL; // Nullify pointer
+    reloc->table_len = 0;
+    return ELFPARSER_SUCCESS;  // Success
+}
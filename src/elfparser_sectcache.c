@@ -0,0 +1,464 @@
+/**
+ * @file elfparser_sectcache.c
+ * @brief Decompressed section cache functions for libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This file implements the cache behind transparent access to SHF_COMPRESSED
+ * sections. A lookup that misses inserts a loading entry under the lock and
+ * decompresses outside it, so other sections stay available meanwhile and a
+ * second thread asking for the same section waits on a condition variable
+ * instead of decompressing it again. Compressed bytes are fetched with
+ * sequential read-ahead and released as soon as they are decoded; only the
+ * decompressed copy is kept. Eviction mirrors the reader's block cache: a
+ * linear scan for the least recently used entry that no view pins, repeated
+ * until the ready entries fit the capacity.
+ */
+
+#include "../inc_pub/elfparser_sectcache.h"
+#include "../inc_priv/elfparser_sectcache_priv.h"
+#include "../inc_priv/elfparser_memmanip_priv.h"
+#include <string.h>
+#ifdef ELFPARSER_WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef ELFPARSER_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+/**
+ * @brief Initializes an empty cache
+ * @param[out] cache Pointer to the cache to initialize
+ * @param[in] capacity Bytes of decompressed data kept once no view pins them
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if cache is NULL,
+ *             ELFPARSER_ERR_MALLOC if the lock cannot be created
+ */
+int ElfParser_SectCache_init(elfparser_sectcache_t *cache, size_t capacity)
+{
+    if (!cache)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    memset(cache, 0, sizeof(*cache));
+    if (pthread_mutex_init(&cache->lock, NULL) != 0)
+    {
+        return ELFPARSER_ERR_MALLOC;  // Out of resources
+    }
+    if (pthread_cond_init(&cache->loaded, NULL) != 0)
+    {
+        pthread_mutex_destroy(&cache->lock);
+        return ELFPARSER_ERR_MALLOC;  // Out of resources
+    }
+    cache->capacity = capacity;
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+#ifdef ELFPARSER_WITH_ZLIB
+/**
+ * @brief Inflates a zlib stream into a buffer of exactly the announced size
+ * @param[in] src Compressed stream
+ * @param[in] src_size Size of the stream in bytes
+ * @param[out] dst Destination of dst_size + 1 bytes (the spare byte catches overlong streams)
+ * @param[in] dst_size Announced decompressed size
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_FORMAT if the stream is corrupt or its size differs,
+ *             ELFPARSER_ERR_MALLOC if zlib cannot allocate its state
+ */
+static int SectCache_zlibInflate(const uint8_t *src, size_t src_size, uint8_t *dst, size_t dst_size)
+{
+    z_stream stream;
+    size_t in_left = src_size;
+    size_t out_left = dst_size + 1u;
+    int zret;
+
+    memset(&stream, 0, sizeof(stream));
+    if (inflateInit(&stream) != Z_OK)
+    {
+        return ELFPARSER_ERR_MALLOC;  // No inflate state
+    }
+    stream.next_in = (Bytef *)src;
+    stream.next_out = dst;
+    do  // avail_in and avail_out are 32-bit, feed huge sections in chunks
+    {
+        if (stream.avail_in == 0 && in_left)
+        {
+            stream.avail_in = (uInt)((in_left < SECTCACHE_ZLIB_CHUNK_MAX) ? in_left : SECTCACHE_ZLIB_CHUNK_MAX);
+            in_left -= stream.avail_in;
+        }
+        if (stream.avail_out == 0 && out_left)
+        {
+            stream.avail_out = (uInt)((out_left < SECTCACHE_ZLIB_CHUNK_MAX) ? out_left : SECTCACHE_ZLIB_CHUNK_MAX);
+            out_left -= stream.avail_out;
+        }
+        zret = inflate(&stream, Z_NO_FLUSH);
+    } while (zret == Z_OK);
+    size_t produced = (size_t)(stream.next_out - dst);
+    inflateEnd(&stream);
+    if (zret == Z_MEM_ERROR)
+    {
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure inside zlib
+    }
+    return (zret == Z_STREAM_END && produced == dst_size) ? ELFPARSER_SUCCESS : ELFPARSER_ERR_FORMAT;
+}
+#endif
+
+/**
+ * @brief Returns the largest expansion a built-in codec can produce per compressed byte
+ * @param[in] type Compression type (ch_type)
+ * @return uint64_t Expansion limit, 0 if the type is unknown or not built in
+ */
+static uint64_t SectCache_ratioMax(uint32_t type)
+{
+    switch (type)
+    {
+#ifdef ELFPARSER_WITH_ZLIB
+        case ELFPARSER_SECTCACHE_COMPRESS_ZLIB:
+            return SECTCACHE_ZLIB_RATIO_MAX;
+#endif
+#ifdef ELFPARSER_WITH_ZSTD
+        case ELFPARSER_SECTCACHE_COMPRESS_ZSTD:
+            return SECTCACHE_ZSTD_RATIO_MAX;
+#endif
+        default:
+            return 0;  // Unknown or left out of this build
+    }
+}
+
+/**
+ * @brief Decompresses the contents of an SHF_COMPRESSED section
+ * @param[in] src Section contents, starting with the compression header
+ * @param[in] src_size Size of the contents in bytes
+ * @param[in] header ELF header of the file, for the header layout and byte order
+ * @param[out] out Set to a newly allocated buffer holding the decompressed contents
+ * @param[out] out_size Set to the decompressed size in bytes
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_FORMAT if the header or data is invalid or the type
+ *             is not built in, ELFPARSER_ERR_RANGE if the announced size is larger than the input can expand to
+ *             or than SECTCACHE_RAW_SIZE_MAX, ELFPARSER_ERR_MALLOC if memory allocation fails
+ */
+static int SectCache_decompress(const uint8_t *src, size_t src_size, const elfparser_header_t *header, uint8_t **out, size_t *out_size)
+{
+    int big_endian = (header->elf_ident.elf_data == ELFPARSER_HEADER_DATA_BIG_ENDIANNESS);
+    int is_64 = (header->elf_ident.elf_class == ELFPARSER_HEADER_CLASS_64_BIT);
+    size_t chdr_size = is_64 ? SECTCACHE_CHDR64_SIZE : SECTCACHE_CHDR32_SIZE;
+    if (src_size < chdr_size)
+    {
+        return ELFPARSER_ERR_FORMAT;  // No room for the compression header
+    }
+    uint32_t type = ElfParser_load32(src + SECTCACHE_CHDR_TYPE_OFF, big_endian);
+    uint64_t raw_size = is_64 ? ElfParser_load64(src + SECTCACHE_CHDR64_SIZE_OFF, big_endian)
+                              : ElfParser_load32(src + SECTCACHE_CHDR32_SIZE_OFF, big_endian);
+    uint64_t ratio_max = SectCache_ratioMax(type);
+    if (ratio_max == 0)
+    {
+        return ELFPARSER_ERR_FORMAT;  // Unknown type or codec not built in
+    }
+    src += chdr_size;
+    src_size -= chdr_size;
+    if (raw_size > SECTCACHE_RAW_SIZE_MAX || raw_size >= SIZE_MAX || raw_size / ratio_max > src_size)
+    {
+        return ELFPARSER_ERR_RANGE;  // More than the codec can expand the input to, do not allocate it
+    }
+
+    uint8_t *dst = malloc((size_t)raw_size + 1u);  // Spare byte catches streams longer than announced
+    if (!dst)
+    {
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+    int ret = ELFPARSER_ERR_FORMAT;  // Unsupported compression type
+    switch (type)
+    {
+#ifdef ELFPARSER_WITH_ZLIB
+        case ELFPARSER_SECTCACHE_COMPRESS_ZLIB:
+            ret = SectCache_zlibInflate(src, src_size, dst, (size_t)raw_size);
+            break;
+#endif
+#ifdef ELFPARSER_WITH_ZSTD
+        case ELFPARSER_SECTCACHE_COMPRESS_ZSTD:
+        {
+            size_t zret = ZSTD_decompress(dst, (size_t)raw_size + 1u, src, src_size);
+            ret = (!ZSTD_isError(zret) && zret == raw_size) ? ELFPARSER_SUCCESS : ELFPARSER_ERR_FORMAT;
+            break;
+        }
+#endif
+        default:
+            break;
+    }
+    if (ret < 0)
+    {
+        free(dst);
+        return ret;  // Corrupt data or not built in
+    }
+    *out = dst;
+    *out_size = (size_t)raw_size;
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Finds the entry of a section, with the lock held
+ * @param[in] cache Pointer to the cache
+ * @param[in] reader Reader of the file holding the section
+ * @param[in] sect Section header entry of the section
+ * @return elfparser_sectcache_entry_t* The entry, NULL if the section is not cached or loading
+ */
+static elfparser_sectcache_entry_t *SectCache_find(const elfparser_sectcache_t *cache, const elfparser_reader_t *reader,
+                                                   const elfparser_secthead_entry_t *sect)
+{
+    for (uint32_t i = 0; i < cache->entry_num; i++)
+    {
+        elfparser_sectcache_entry_t *entry = cache->entries[i];
+        if (entry->sect_offset == sect->sh_offset && entry->sect_size == sect->sh_size && entry->file_ino == reader->file_ino &&
+            entry->file_dev == reader->file_dev && entry->file_mtime == reader->file_mtime)
+        {
+            return entry;
+        }
+    }
+    return NULL;  // Not cached
+}
+
+/**
+ * @brief Unlinks and frees an entry, with the lock held
+ * @param[in,out] cache Pointer to the cache
+ * @param[in] entry Entry to remove
+ */
+static void SectCache_remove(elfparser_sectcache_t *cache, elfparser_sectcache_entry_t *entry)
+{
+    for (uint32_t i = 0; i < cache->entry_num; i++)
+    {
+        if (cache->entries[i] == entry)
+        {
+            cache->entries[i] = cache->entries[--cache->entry_num];  // Order is irrelevant
+            break;
+        }
+    }
+    if (entry->state == ELFPARSER_SECTCACHE_ENTRY_READY)
+    {
+        cache->used -= entry->size;
+    }
+    free(entry->data);
+    free(entry);
+}
+
+/**
+ * @brief Evicts least recently used unpinned entries until the ready ones fit the capacity, with the lock held
+ * @param[in,out] cache Pointer to the cache
+ */
+static void SectCache_evict(elfparser_sectcache_t *cache)
+{
+    while (cache->used > cache->capacity)
+    {
+        elfparser_sectcache_entry_t *victim = NULL;
+        for (uint32_t i = 0; i < cache->entry_num; i++)
+        {
+            elfparser_sectcache_entry_t *entry = cache->entries[i];
+            if (entry->state == ELFPARSER_SECTCACHE_ENTRY_READY && entry->ref_num == 0 &&
+                (!victim || entry->last_use < victim->last_use))
+            {
+                victim = entry;
+            }
+        }
+        if (!victim)
+        {
+            return;  // Everything left is pinned
+        }
+        SectCache_remove(cache, victim);
+        cache->stats.evictions++;
+    }
+}
+
+/**
+ * @brief Returns the contents of a section, decompressing SHF_COMPRESSED ones through the cache
+ * @param[in,out] cache Pointer to an initialized cache
+ * @param[in,out] file Pointer to an open file structure, used by this thread only
+ * @param[in] sect_idx Index of the section
+ * @param[out] data Set to the first byte of the contents, NULL for SHT_NOBITS
+ * @param[out] size Set to the size of the contents in bytes
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_RANGE if sect_idx is invalid, ELFPARSER_ERR_SIZE if the section lies outside the file,
+ *             ELFPARSER_ERR_FORMAT if the compressed contents are invalid or their type is not built in,
+ *             ELFPARSER_ERR_MALLOC if memory allocation fails, or the error of the file or reader functions
+ */
+int ElfParser_SectCache_get(elfparser_sectcache_t *cache, elfparser_file_t *file, uint32_t sect_idx, const void **data, size_t *size)
+{
+    if (!cache || !file || !data || !size)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    const elfparser_header_t *header;
+    const elfparser_secthead_t *sect_head;
+    int ret = ElfParser_File_headerGet(file, &header);
+    if (ret == ELFPARSER_SUCCESS)
+    {
+        ret = ElfParser_File_sectHeadGet(file, &sect_head);
+    }
+    if (ret < 0)
+    {
+        return ret;  // No usable header or section headers
+    }
+    if (sect_idx >= sect_head->table_len)
+    {
+        return ELFPARSER_ERR_RANGE;  // Invalid section index
+    }
+    const elfparser_secthead_entry_t *sect = &sect_head->table[sect_idx];
+    if (!(sect->sh_flags & ELFPARSER_SECTHEAD_FLAG_COMPRESSED) || sect->sh_type == ELFPARSER_SECTHEAD_TYPE_NOBITS)
+    {
+        return ElfParser_File_sectionGet(file, sect_idx, data, size);  // Plain contents, pinned by the file
+    }
+    const elfparser_reader_t *reader = &file->reader;
+    if (sect->sh_offset > reader->file_size || sect->sh_size > reader->file_size - sect->sh_offset)
+    {
+        return ELFPARSER_ERR_SIZE;  // Section outside the file
+    }
+
+    pthread_mutex_lock(&cache->lock);
+    elfparser_sectcache_entry_t *entry;
+    int waited = 0;
+    while ((entry = SectCache_find(cache, reader, sect)) && entry->state == ELFPARSER_SECTCACHE_ENTRY_LOADING)
+    {
+        cache->stats.waits += !waited;  // Another thread is decompressing it
+        waited = 1;
+        pthread_cond_wait(&cache->loaded, &cache->lock);
+    }
+    if (entry)
+    {
+        entry->ref_num++;
+        entry->last_use = ++cache->use_clock;
+        cache->stats.hits++;
+        *data = entry->data;
+        *size = entry->size;
+        pthread_mutex_unlock(&cache->lock);
+        return ELFPARSER_SUCCESS;  // Hit
+    }
+
+    if (cache->entry_num == cache->entry_cap)
+    {
+        uint32_t cap = cache->entry_cap ? cache->entry_cap * 2u : SECTCACHE_ENTRY_INITIAL;
+        elfparser_sectcache_entry_t **grown = realloc(cache->entries, (size_t)cap * sizeof(elfparser_sectcache_entry_t *));
+        if (!grown)
+        {
+            pthread_mutex_unlock(&cache->lock);
+            return ELFPARSER_ERR_MALLOC;  // Allocation failure
+        }
+        cache->entries = grown;
+        cache->entry_cap = cap;
+    }
+    entry = calloc(1, sizeof(elfparser_sectcache_entry_t));
+    if (!entry)
+    {
+        pthread_mutex_unlock(&cache->lock);
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+    entry->file_dev = reader->file_dev;
+    entry->file_ino = reader->file_ino;
+    entry->file_mtime = reader->file_mtime;
+    entry->sect_offset = sect->sh_offset;
+    entry->sect_size = sect->sh_size;
+    entry->ref_num = 1;  // The view handed out below
+    entry->state = ELFPARSER_SECTCACHE_ENTRY_LOADING;
+    cache->entries[cache->entry_num++] = entry;
+    cache->stats.misses++;
+    pthread_mutex_unlock(&cache->lock);
+
+    uint8_t *out = NULL;
+    size_t out_size = 0;
+    const void *raw;
+    ElfParser_Reader_advise(reader, sect->sh_offset, sect->sh_size, ELFPARSER_READER_ADVICE_SEQUENTIAL);
+    ret = ElfParser_Reader_rangeGet(&file->reader, sect->sh_offset, sect->sh_size, &raw);
+    if (ret >= 0)
+    {
+        ret = SectCache_decompress(raw, (size_t)sect->sh_size, header, &out, &out_size);
+        ElfParser_Reader_rangeRelease(&file->reader, raw);  // Only the decompressed copy is kept
+        ElfParser_Reader_advise(reader, sect->sh_offset, sect->sh_size, ELFPARSER_READER_ADVICE_DONTNEED);
+    }
+
+    pthread_mutex_lock(&cache->lock);
+    if (ret < 0)
+    {
+        SectCache_remove(cache, entry);  // Waiters retry and report their own error
+    }
+    else
+    {
+        entry->data = out;
+        entry->size = out_size;
+        entry->state = ELFPARSER_SECTCACHE_ENTRY_READY;
+        entry->last_use = ++cache->use_clock;
+        cache->used += out_size;
+        cache->stats.bytes_out += out_size;
+        SectCache_evict(cache);  // Never this one, it is pinned
+        *data = out;
+        *size = out_size;
+    }
+    pthread_cond_broadcast(&cache->loaded);
+    pthread_mutex_unlock(&cache->lock);
+    return (ret < 0) ? ret : ELFPARSER_SUCCESS;
+}
+
+/**
+ * @brief Releases a view returned by ElfParser_SectCache_get()
+ * @param[in,out] cache Pointer to the cache the view came from
+ * @param[in] data First byte of the view
+ * @return int ELFPARSER_SUCCESS on success (also for views of uncompressed sections), ELFPARSER_ERR_NULL if inputs are NULL
+ */
+int ElfParser_SectCache_release(elfparser_sectcache_t *cache, const void *data)
+{
+    if (!cache || !data)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    pthread_mutex_lock(&cache->lock);
+    for (uint32_t i = 0; i < cache->entry_num; i++)
+    {
+        elfparser_sectcache_entry_t *entry = cache->entries[i];
+        if (entry->data == data && entry->ref_num > 0)
+        {
+            entry->ref_num--;
+            SectCache_evict(cache);
+            break;
+        }
+    }
+    pthread_mutex_unlock(&cache->lock);
+    return ELFPARSER_SUCCESS;  // Success, views of plain sections belong to their file
+}
+
+/**
+ * @brief Copies out the counters of a cache
+ * @param[in,out] cache Pointer to an initialized cache
+ * @param[out] stats Pointer to the counters to fill
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL
+ */
+int ElfParser_SectCache_statsGet(elfparser_sectcache_t *cache, elfparser_sectcache_stats_t *stats)
+{
+    if (!cache || !stats)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    pthread_mutex_lock(&cache->lock);
+    *stats = cache->stats;
+    pthread_mutex_unlock(&cache->lock);
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Frees every entry and the cache itself
+ * @param[in,out] cache Pointer to the cache to free
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if cache is NULL
+ */
+int ElfParser_SectCache_free(elfparser_sectcache_t *cache)
+{
+    if (!cache)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    for (uint32_t i = 0; i < cache->entry_num; i++)
+    {
+        free(cache->entries[i]->data);
+        free(cache->entries[i]);
+    }
+    free(cache->entries);
+    cache->entries = NULL;
+    cache->entry_num = 0;
+    cache->entry_cap = 0;
+    cache->used = 0;
+    pthread_cond_destroy(&cache->loaded);
+    pthread_mutex_destroy(&cache->lock);
+    return ELFPARSER_SUCCESS;  // Success
+}
@@ -14,6 +14,9 @@
 #include "../inc_priv/elfparser_secthead_priv.h"
 #include "../inc_pub/elfparser_secthead.h"
 #include "../inc_priv/elfparser_memmanip_priv.h"
+#include "../inc_priv/elfparser_bswap_priv.h"
+#include "../inc_priv/elfparser_alloc_priv.h"
+#include "../inc_priv/elfparser_stats_priv.h"
 #include "../inc_pub/elfparser_header.h"
 #include <stdlib.h>
 
@@ -22,14 +25,28 @@
  * @param[out] sect_head Pointer to the section header structure to initialize
  * @param[in] header Pointer to the ELF header containing section metadata
  * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_FORMAT if the table has more than INT32_MAX entries,
  *             ELFPARSER_ERR_MALLOC if memory allocation fails
  */
 int ElfParser_SectHead_structSetup(elfparser_secthead_t *sect_head, const elfparser_header_t *header)
+{
+    return ElfParser_SectHead_structSetupAlloc(sect_head, header, NULL);  // Plain malloc
+}
+
+/**
+ * @brief Body of ElfParser_SectHead_structSetupAlloc(), run with or without an open span
+ * @return int See ElfParser_SectHead_structSetupAlloc()
+ */
+static int SectHead_structSetupRun(elfparser_secthead_t *sect_head, const elfparser_header_t *header, const elfparser_alloc_t *alloc)
 {
     if (!sect_head || !header)
     {
         return ELFPARSER_ERR_NULL;  // Null pointer input
     }
+    if (header->elf_section_header_entry_num > INT32_MAX)
+    {
+        return ELFPARSER_ERR_FORMAT;  // Indices would collide with the error codes of the find functions
+    }
 
     sect_head->elf_class = header->elf_ident.elf_class;                 // Set ELF class (32/64-bit)
     sect_head->elf_data = header->elf_ident.elf_data;                   // Set endianness
@@ -37,7 +54,10 @@ int ElfParser_SectHead_structSetup(elfparser_secthead_t *sect_head, const elfpar
     sect_head->table_len = header->elf_section_header_entry_num;        // Number of section header entries
     sect_head->string_table_idx = header->elf_section_header_name_idx;  // Index of string table section
     sect_head->max_idx = 0;                                             // Initialize max name index
-    sect_head->table = malloc(sect_head->table_len * sizeof(elfparser_secthead_entry_t)); // Allocate table
+    sect_head->name_mode = ELFPARSER_NAME_MODE_OWNED;                   // Names are copied unless resolved as views
+    sect_head->name_arena = NULL;                                       // No name block yet
+    sect_head->alloc = alloc;                                           // Allocator of the table and names
+    sect_head->table = ElfParser_allocMalloc(alloc, ((size_t)sect_head->table_len ? sect_head->table_len : 1) * sizeof(elfparser_secthead_entry_t)); // Allocate table, one entry for a file without section headers
     if (!sect_head->table)
     {
         return ELFPARSER_ERR_MALLOC;  // Allocation failure
@@ -46,14 +66,142 @@ int ElfParser_SectHead_structSetup(elfparser_secthead_t *sect_head, const elfpar
 }
 
 /**
- * @brief Parses the section header table from a memory map
- * @param[out] sect_head Pointer to the section header structure to populate
- * @param[in] map Pointer to the memory-mapped ELF file
- * @param[in] map_size Size of the memory map in bytes
+ * @brief Sets up the section header structure, allocating the table and names through an allocator
+ * @param[out] sect_head Pointer to the section header structure to initialize
+ * @param[in] header Pointer to the ELF header containing section metadata
+ * @param[in] alloc Allocator used until ElfParser_SectHead_free(), NULL for malloc
  * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
- *             ELFPARSER_ERR_SIZE if size is insufficient, ELFPARSER_ERR_CLASS if class or endianness is invalid
+ *             ELFPARSER_ERR_FORMAT if the table has more than INT32_MAX entries,
+ *             ELFPARSER_ERR_MALLOC if memory allocation fails
  */
-int ElfParser_SectHead_parse(elfparser_secthead_t *sect_head, const void *map, size_t map_size)
+int ElfParser_SectHead_structSetupAlloc(elfparser_secthead_t *sect_head, const elfparser_header_t *header, const elfparser_alloc_t *alloc)
+{
+    if (!ElfParser_statsActive())
+    {
+        return SectHead_structSetupRun(sect_head, header, alloc);  // Nothing registered
+    }
+    elfparser_span_t span;
+    ElfParser_statsBegin(&span, ELFPARSER_PHASE_SECTHEAD);
+    int ret = SectHead_structSetupRun(sect_head, header, alloc);
+    ElfParser_statsEnd(&span, ret, 0, 0);
+    return ret;
+}
+
+/**
+ * @brief Decodes consecutive section header entries for one class and endianness
+ *
+ * Always inlined into the four layout-specific decoders below, so the field
+ * offsets, widths and byte order are compile-time constants in each of them.
+ *
+ * @param[out] entries Destination array of at least count entries
+ * @param[in] src Pointer to the first raw entry
+ * @param[in] count Number of entries to decode
+ * @param[in] entry_size Distance between raw entries in bytes
+ * @param[in,out] max_idx Raised to the largest sh_name encountered
+ * @param[in] is_64bit Non-zero for the 64-bit layout
+ * @param[in] big_endian Non-zero for big-endian data
+ */
+static inline __attribute__((always_inline)) void SectHead_entriesKernel(elfparser_secthead_entry_t *entries, const uint8_t *src,
+                                                                         size_t count, size_t entry_size, uint32_t *max_idx,
+                                                                         const int is_64bit, const int big_endian)
+{
+    uint32_t max = *max_idx;
+
+    for (size_t i = 0; i < count; i++, src += entry_size)  // One fixed-layout entry per iteration
+    {
+        elfparser_secthead_entry_t *entry = &entries[i];
+        entry->sh_name = NULL;  // Initialize name pointer
+        entry->sh_name_len = 0;
+        entry->sh_name_idx = ElfParser_load32(src + SECTHEADER_ENTRY_NAMEIDX_OFF, big_endian);
+        entry->sh_type = ElfParser_load32(src + SECTHEADER_ENTRY_TYPE_OFF, big_endian);
+        if (is_64bit)
+        {
+            entry->sh_flags = ElfParser_load64(src + SECTHEADER_ENTRY_FLAGS_OFF, big_endian);
+            entry->sh_addr = ElfParser_load64(src + SECTHEADER_ENTRY_SECTADDR_OFF_64BIT, big_endian);
+            entry->sh_offset = ElfParser_load64(src + SECTHEADER_ENTRY_SECTOFF_OFF_64BIT, big_endian);
+            entry->sh_size = ElfParser_load64(src + SECTHEADER_ENTRY_SECTSIZE_OFF_64BIT, big_endian);
+            entry->sh_link = ElfParser_load32(src + SECTHEADER_ENTRY_LINK_OFF_64BIT, big_endian);
+            entry->sh_info = ElfParser_load32(src + SECTHEADER_ENTRY_INFO_OFF_64BIT, big_endian);
+            entry->sh_addralign = ElfParser_load64(src + SECTHEADER_ENTRY_ADDRALIGN_OFF_64BIT, big_endian);
+            entry->sh_entsize = ElfParser_load64(src + SECTHEADER_ENTRY_ENTRYSIZE_OFF_64BIT, big_endian);
+        }
+        else
+        {
+            entry->sh_flags = ElfParser_load32(src + SECTHEADER_ENTRY_FLAGS_OFF, big_endian);
+            entry->sh_addr = ElfParser_load32(src + SECTHEADER_ENTRY_SECTADDR_OFF_32BIT, big_endian);
+            entry->sh_offset = ElfParser_load32(src + SECTHEADER_ENTRY_SECTOFF_OFF_32BIT, big_endian);
+            entry->sh_size = ElfParser_load32(src + SECTHEADER_ENTRY_SECTSIZE_OFF_32BIT, big_endian);
+            entry->sh_link = ElfParser_load32(src + SECTHEADER_ENTRY_LINK_OFF_32BIT, big_endian);
+            entry->sh_info = ElfParser_load32(src + SECTHEADER_ENTRY_INFO_OFF_32BIT, big_endian);
+            entry->sh_addralign = ElfParser_load32(src + SECTHEADER_ENTRY_ADDRALIGN_OFF_32BIT, big_endian);
+            entry->sh_entsize = ElfParser_load32(src + SECTHEADER_ENTRY_ENTRYSIZE_OFF_32BIT, big_endian);
+        }
+        max = (entry->sh_name_idx > max) ? entry->sh_name_idx : max;  // Track max name index
+    }
+    *max_idx = max;
+}
+
+/**
+ * @brief Decodes big-endian section header entries through the bulk byte-swap
+ *
+ * Canonically sized entries are swapped into host order one stack-sized chunk
+ * at a time and decoded by the little-endian kernel while the chunk is still
+ * in L1; entries the swap leaves over (a partial period, no SIMD support or a
+ * non-canonical entry_size) go through the scalar big-endian kernel.
+ *
+ * @param[out] entries Destination array of at least count entries
+ * @param[in] src Pointer to the first raw entry
+ * @param[in] count Number of entries to decode
+ * @param[in] entry_size Distance between raw entries in bytes
+ * @param[in,out] max_idx Raised to the largest name index encountered
+ * @param[in] is_64bit Non-zero for the 64-bit layout
+ */
+static inline __attribute__((always_inline)) void SectHead_swappedDecode(elfparser_secthead_entry_t *entries, const uint8_t *src, size_t count,
+                                                                         size_t entry_size, uint32_t *max_idx, const int is_64bit)
+{
+    const size_t canon_size = is_64bit ? ELFPARSER_BSWAP_SECT_SIZE_64BIT : ELFPARSER_BSWAP_SECT_SIZE_32BIT;
+    const size_t chunk_num = (ELFPARSER_BSWAP_CHUNK_SIZE / canon_size) / ELFPARSER_BSWAP_PERIOD_MAX * ELFPARSER_BSWAP_PERIOD_MAX;
+    uint8_t chunk[ELFPARSER_BSWAP_CHUNK_SIZE] __attribute__((aligned(32)));  // Host-order copy of the current chunk
+
+    while (entry_size == canon_size && count > 0)
+    {
+        size_t num = (count < chunk_num) ? count : chunk_num;
+        size_t done = ElfParser_bswapEntries(chunk, src, num, is_64bit ? ELFPARSER_BSWAP_LAYOUT_SECT_64BIT : ELFPARSER_BSWAP_LAYOUT_SECT_32BIT);
+        if (done == 0)
+        {
+            break;  // Left for the scalar kernel
+        }
+        SectHead_entriesKernel(entries, chunk, done, canon_size, max_idx, is_64bit, ELFPARSER_HOST_BIG_ENDIAN);
+        entries += done;
+        src += done * canon_size;
+        count -= done;
+    }
+    SectHead_entriesKernel(entries, src, count, entry_size, max_idx, is_64bit, 1);  // Tail or fallback
+}
+
+/* Layout-specific section header decoders (32/64-bit x little/big-endian) */
+static void SectHead_decode32Le(elfparser_secthead_entry_t *entries, const uint8_t *src, size_t count, size_t entry_size, uint32_t *max_idx)
+{
+    SectHead_entriesKernel(entries, src, count, entry_size, max_idx, 0, 0);
+}
+static void SectHead_decode32Be(elfparser_secthead_entry_t *entries, const uint8_t *src, size_t count, size_t entry_size, uint32_t *max_idx)
+{
+    SectHead_swappedDecode(entries, src, count, entry_size, max_idx, 0);
+}
+static void SectHead_decode64Le(elfparser_secthead_entry_t *entries, const uint8_t *src, size_t count, size_t entry_size, uint32_t *max_idx)
+{
+    SectHead_entriesKernel(entries, src, count, entry_size, max_idx, 1, 0);
+}
+static void SectHead_decode64Be(elfparser_secthead_entry_t *entries, const uint8_t *src, size_t count, size_t entry_size, uint32_t *max_idx)
+{
+    SectHead_swappedDecode(entries, src, count, entry_size, max_idx, 1);
+}
+
+/**
+ * @brief Body of ElfParser_SectHead_parse(), run with or without an open span
+ * @return int See ElfParser_SectHead_parse()
+ */
+static int SectHead_parseRun(elfparser_secthead_t *sect_head, const void *map, size_t map_size)
 {
     if (!sect_head || !map)
     {
@@ -62,90 +210,96 @@ int ElfParser_SectHead_parse(elfparser_secthead_t *sect_head, const void *map, s
     size_t required_size = (size_t)sect_head->entry_size * sect_head->table_len;
     if (map_size < required_size || required_size == 0)
     {
+        ElfParser_statsErrorAt(map_size);
         return ELFPARSER_ERR_SIZE;  // Insufficient size or invalid table length
     }
 
-    const uint64_t mem_off_32bit[] = { SECTHEADER_ENTRY_NAMEIDX_OFF, SECTHEADER_ENTRY_TYPE_OFF, SECTHEADER_ENTRY_FLAGS_OFF, // 32-bit offsets
-                                       SECTHEADER_ENTRY_SECTADDR_OFF_32BIT, SECTHEADER_ENTRY_SECTOFF_OFF_32BIT, SECTHEADER_ENTRY_SECTSIZE_OFF_32BIT,
-                                       SECTHEADER_ENTRY_LINK_OFF_32BIT, SECTHEADER_ENTRY_INFO_OFF_32BIT, SECTHEADER_ENTRY_ADDRALIGN_OFF_32BIT,
-                                       SECTHEADER_ENTRY_ENTRYSIZE_OFF_32BIT };
-    const uint64_t mem_off_64bit[] = { SECTHEADER_ENTRY_NAMEIDX_OFF, SECTHEADER_ENTRY_TYPE_OFF, SECTHEADER_ENTRY_FLAGS_OFF, // 64-bit offsets
-                                       SECTHEADER_ENTRY_SECTADDR_OFF_64BIT, SECTHEADER_ENTRY_SECTOFF_OFF_64BIT, SECTHEADER_ENTRY_SECTSIZE_OFF_64BIT,
-                                       SECTHEADER_ENTRY_LINK_OFF_64BIT, SECTHEADER_ENTRY_INFO_OFF_64BIT, SECTHEADER_ENTRY_ADDRALIGN_OFF_64BIT,
-                                       SECTHEADER_ENTRY_ENTRYSIZE_OFF_64BIT };
-    const uint64_t mem_size_32bit[] = { SECTHEADER_ENTRY_NAMEIDX_SIZE, SECTHEADER_ENTRY_TYPE_SIZE, SECTHEADER_ENTRY_FLAGS_SIZE_32BIT, // 32-bit sizes
-                                        SECTHEADER_ENTRY_SECTADDR_SIZE_32BIT, SECTHEADER_ENTRY_SECTOFF_SIZE_32BIT, SECTHEADER_ENTRY_SECTSIZE_SIZE_32BIT,
-                                        SECTHEADER_ENTRY_LINK_SIZE, SECTHEADER_ENTRY_INFO_SIZE, SECTHEADER_ENTRY_ADDRALIGN_SIZE_32BIT,
-                                        SECTHEADER_ENTRY_ENTRYSIZE_SIZE_32BIT };
-    const uint64_t mem_size_64bit[] = { SECTHEADER_ENTRY_NAMEIDX_SIZE, SECTHEADER_ENTRY_TYPE_SIZE, SECTHEADER_ENTRY_FLAGS_SIZE_64BIT, // 64-bit sizes
-                                        SECTHEADER_ENTRY_SECTADDR_SIZE_64BIT, SECTHEADER_ENTRY_SECTOFF_SIZE_64BIT, SECTHEADER_ENTRY_SECTSIZE_SIZE_64BIT,
-                                        SECTHEADER_ENTRY_LINK_SIZE, SECTHEADER_ENTRY_INFO_SIZE, SECTHEADER_ENTRY_ADDRALIGN_SIZE_64BIT,
-                                        SECTHEADER_ENTRY_ENTRYSIZE_SIZE_64BIT };
-
-    const uint64_t *mem_off, *mem_size;  // Selected offset and size arrays
+    size_t layout_size;  // Bytes one entry occupies in this class
+    void (*decode)(elfparser_secthead_entry_t *, const uint8_t *, size_t, size_t, uint32_t *);  // Hoisted dispatch
+    int big_endian = (sect_head->elf_data == ELFPARSER_HEADER_DATA_BIG_ENDIANNESS);
+    if (sect_head->elf_data != ELFPARSER_HEADER_DATA_LITTLE_ENDIANNESS && !big_endian)
+    {
+        return ELFPARSER_ERR_CLASS;  // Invalid endianness
+    }
     if (sect_head->elf_class == ELFPARSER_HEADER_CLASS_32_BIT)
     {
-        mem_off = mem_off_32bit;
-        mem_size = mem_size_32bit;
+        layout_size = SECTHEADER_ENTRY_ENTRYSIZE_OFF_32BIT + SECTHEADER_ENTRY_ENTRYSIZE_SIZE_32BIT;
+        decode = big_endian ? SectHead_decode32Be : SectHead_decode32Le;
     }
     else if (sect_head->elf_class == ELFPARSER_HEADER_CLASS_64_BIT)
     {
-        mem_off = mem_off_64bit;
-        mem_size = mem_size_64bit;
+        layout_size = SECTHEADER_ENTRY_ENTRYSIZE_OFF_64BIT + SECTHEADER_ENTRY_ENTRYSIZE_SIZE_64BIT;
+        decode = big_endian ? SectHead_decode64Be : SectHead_decode64Le;
     }
     else
     {
         return ELFPARSER_ERR_CLASS;  // Invalid class
     }
+    if (required_size - sect_head->entry_size + layout_size > map_size)
+    {
+        ElfParser_statsErrorAt(map_size);
+        return ELFPARSER_ERR_SIZE;  // Last entry runs out of the map
+    }
 
-    for (uint32_t i = 0; i < sect_head->table_len; i++)  // Parse each section header entry
+    decode(sect_head->table, map, sect_head->table_len, sect_head->entry_size, &(sect_head->max_idx));
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Parses the section header table from a memory map
+ * @param[out] sect_head Pointer to the section header structure to populate
+ * @param[in] map Pointer to the memory-mapped ELF file
+ * @param[in] map_size Size of the memory map in bytes
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_SIZE if size is insufficient, ELFPARSER_ERR_CLASS if class or endianness is invalid
+ */
+int ElfParser_SectHead_parse(elfparser_secthead_t *sect_head, const void *map, size_t map_size)
+{
+    if (!ElfParser_statsActive())
     {
-        void *const ret_dest[SECTHEADER_ENTRY_LEN] = { // Static destination array
-            &(sect_head->table[i].sh_name_idx), &(sect_head->table[i].sh_type), &(sect_head->table[i].sh_flags),
-            &(sect_head->table[i].sh_addr), &(sect_head->table[i].sh_offset), &(sect_head->table[i].sh_size),
-            &(sect_head->table[i].sh_link), &(sect_head->table[i].sh_info), &(sect_head->table[i].sh_addralign),
-            &(sect_head->table[i].sh_entsize)
-        };
-        sect_head->table[i].sh_name = NULL;  // Initialize name pointer only
+        return SectHead_parseRun(sect_head, map, map_size);  // Nothing registered
+    }
+    elfparser_span_t span;
+    ElfParser_statsBegin(&span, ELFPARSER_PHASE_SECTHEAD);
+    int ret = SectHead_parseRun(sect_head, map, map_size);
+    ElfParser_statsEnd(&span, ret, (ret < 0) ? 0 : (uint64_t)sect_head->table_len * sect_head->entry_size,
+                       (ret < 0) ? 0 : sect_head->table_len);
+    return ret;
+}
 
-        size_t base_offset = i * sect_head->entry_size;
-        for (uint8_t j = 0; j < SECTHEADER_ENTRY_LEN; j++)  // Copy fields with bounds check
-        {
-            size_t offset = base_offset + mem_off[j];
-            if (offset + mem_size[j] > map_size)
-            {
-                return ELFPARSER_ERR_SIZE;  // Out of bounds
-            }
-            if (sect_head->elf_data == ELFPARSER_HEADER_DATA_BIG_ENDIANNESS)
-            {
-                ElfParser_memRevCpy(ret_dest[j], map + offset, mem_size[j]);
-            }
-            else if (sect_head->elf_data == ELFPARSER_HEADER_DATA_LITTLE_ENDIANNESS)
-            {
-                ElfParser_memCpy(ret_dest[j], map + offset, mem_size[j]);
-            }
-            else
-            {
-                return ELFPARSER_ERR_CLASS;  // Invalid endianness
-            }
-        }
-        if (sect_head->table[i].sh_name_idx > sect_head->max_idx)
+/**
+ * @brief Releases the names resolved so far in the table's current name mode
+ *
+ * Every name pointer is cleared afterwards, so no entry is left pointing into
+ * a freed block or a caller's map once the mode changes.
+ *
+ * @param[in,out] sect_head Pointer to the section header structure
+ */
+static void SectHead_namesRelease(elfparser_secthead_t *sect_head)
+{
+    const elfparser_alloc_t *alloc = sect_head->alloc;
+    int owned = (sect_head->name_mode == ELFPARSER_NAME_MODE_OWNED && ElfParser_allocFreesBlocks(alloc));  // Each name was duplicated separately
+    for (size_t cnt = 0; cnt < sect_head->table_len; cnt++)  // Drop each name
+    {
+        if (owned)
         {
-            sect_head->max_idx = sect_head->table[i].sh_name_idx;  // Update max name index
+            ElfParser_allocFree(alloc, (void *)sect_head->table[cnt].sh_name);  // Safe to free NULL
         }
+        sect_head->table[cnt].sh_name = NULL;
+        sect_head->table[cnt].sh_name_len = 0;
+    }
+    if (sect_head->name_mode == ELFPARSER_NAME_MODE_ARENA)  // All names share one block
+    {
+        ElfParser_allocFree(alloc, sect_head->name_arena);
+        sect_head->name_arena = NULL;
     }
-    return ELFPARSER_SUCCESS;  // Success
 }
 
 /**
- * @brief Resolves section names from the string table
- * @param[in] sect_head Pointer to the section header structure
- * @param[in] map Pointer to the memory-mapped ELF file
- * @param[in] map_size Size of the memory map in bytes
- * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_SIZE if map is too small,
- *             ELFPARSER_ERR_NULL if inputs are NULL, ELFPARSER_ERR_MALLOC if string duplication fails
+ * @brief Body of ElfParser_SectHead_nameResolve(), run with or without an open span
+ * @return int See ElfParser_SectHead_nameResolve()
  */
-int ElfParser_SectHead_nameResolve(const elfparser_secthead_t *sect_head, const void *map, size_t map_size)
+static int SectHead_nameResolveRun(elfparser_secthead_t *sect_head, const void *map, size_t map_size)
 {
     if (!sect_head || !map)
     {
@@ -153,25 +307,183 @@ int ElfParser_SectHead_nameResolve(const elfparser_secthead_t *sect_head, const
     }
     if (map_size <= sect_head->max_idx)  // Check if map covers max index
     {
+        ElfParser_statsErrorAt(map_size);
         return ELFPARSER_ERR_SIZE;  // Insufficient size
     }
 
     const char *char_map = map;  // Cast map to char pointer
+    SectHead_namesRelease(sect_head);  // Names or block of an earlier resolve
+    sect_head->name_mode = ELFPARSER_NAME_MODE_OWNED;  // Free releases each name from here on
     for (size_t cnt = 0; cnt < sect_head->table_len; cnt++)  // Resolve names
     {
         size_t name_idx = sect_head->table[cnt].sh_name_idx;
         if (name_idx >= map_size)  // Bounds check
         {
+            ElfParser_statsErrorAt(name_idx);
             return ELFPARSER_ERR_SIZE;
         }
-        if (ElfParser_strDup(&char_map[name_idx], &(sect_head->table[cnt].sh_name)) < 0)
+        char *name_dup = NULL;
+        int64_t dup_size = ElfParser_strDupAlloc(&char_map[name_idx], &name_dup, sect_head->alloc);
+        if (dup_size < 0)
         {
             return ELFPARSER_ERR_MALLOC;  // String duplication failed
         }
+        sect_head->table[cnt].sh_name = name_dup;
+        sect_head->table[cnt].sh_name_len = (uint32_t)(dup_size - 1);  // Size includes the terminator
     }
     return ELFPARSER_SUCCESS;  // Success
 }
 
+/**
+ * @brief Resolves section names from the string table
+ * @param[in,out] sect_head Pointer to the section header structure
+ * @param[in] map Pointer to the memory-mapped ELF file
+ * @param[in] map_size Size of the memory map in bytes
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_SIZE if map is too small,
+ *             ELFPARSER_ERR_NULL if inputs are NULL, ELFPARSER_ERR_MALLOC if string duplication fails
+ */
+int ElfParser_SectHead_nameResolve(elfparser_secthead_t *sect_head, const void *map, size_t map_size)
+{
+    if (!ElfParser_statsActive())
+    {
+        return SectHead_nameResolveRun(sect_head, map, map_size);  // Nothing registered
+    }
+    elfparser_span_t span;
+    ElfParser_statsBegin(&span, ELFPARSER_PHASE_NAMES);
+    int ret = SectHead_nameResolveRun(sect_head, map, map_size);
+    ElfParser_statsEnd(&span, ret, (ret < 0) ? 0 : ElfParser_statsNameExtent(map, map_size, sect_head->max_idx),
+                       (ret < 0) ? 0 : sect_head->table_len);
+    return ret;
+}
+
+/**
+ * @brief Body of ElfParser_SectHead_nameResolveView(), run with or without an open span
+ * @return int See ElfParser_SectHead_nameResolveView()
+ */
+static int SectHead_nameResolveViewRun(elfparser_secthead_t *sect_head, const void *map, size_t map_size)
+{
+    if (!sect_head || !map || !sect_head->table)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    if (map_size <= sect_head->max_idx)  // Check if map covers max index
+    {
+        ElfParser_statsErrorAt(map_size);
+        return ELFPARSER_ERR_SIZE;  // Insufficient size
+    }
+
+    const char *char_map = map;  // Cast map to char pointer
+    if (ElfParser_strLenBounded(&char_map[sect_head->max_idx], map_size - sect_head->max_idx) < 0)
+    {
+        ElfParser_statsErrorAt(map_size);
+        return ELFPARSER_ERR_SIZE;  // Highest name not terminated inside the map
+    }
+
+    SectHead_namesRelease(sect_head);  // Names or block of an earlier resolve
+    sect_head->name_mode = ELFPARSER_NAME_MODE_VIEW;  // Free must not touch the names from here on
+    for (size_t cnt = 0; cnt < sect_head->table_len; cnt++)  // Point names into the map
+    {
+        size_t name_idx = sect_head->table[cnt].sh_name_idx;
+        int64_t name_len = ElfParser_strLenBounded(&char_map[name_idx], map_size - name_idx);
+        sect_head->table[cnt].sh_name = &char_map[name_idx];
+        sect_head->table[cnt].sh_name_len = (uint32_t)name_len;  // Always terminated: ends at or before the name at max_idx
+    }
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Resolves section names as views into the string table without copying
+ * @param[in,out] sect_head Pointer to the section header structure
+ * @param[in] map Pointer to the memory-mapped string table
+ * @param[in] map_size Size of the memory map in bytes
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_SIZE if a name index or terminator lies outside the map
+ */
+int ElfParser_SectHead_nameResolveView(elfparser_secthead_t *sect_head, const void *map, size_t map_size)
+{
+    if (!ElfParser_statsActive())
+    {
+        return SectHead_nameResolveViewRun(sect_head, map, map_size);  // Nothing registered
+    }
+    elfparser_span_t span;
+    ElfParser_statsBegin(&span, ELFPARSER_PHASE_NAMES);
+    int ret = SectHead_nameResolveViewRun(sect_head, map, map_size);
+    ElfParser_statsEnd(&span, ret, (ret < 0) ? 0 : ElfParser_statsNameExtent(map, map_size, sect_head->max_idx),
+                       (ret < 0) ? 0 : sect_head->table_len);
+    return ret;
+}
+
+/**
+ * @brief Body of ElfParser_SectHead_nameResolveArena(), run with or without an open span
+ * @return int See ElfParser_SectHead_nameResolveArena()
+ */
+static int SectHead_nameResolveArenaRun(elfparser_secthead_t *sect_head, const void *map, size_t map_size)
+{
+    if (!sect_head || !map || !sect_head->table)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    if (map_size <= sect_head->max_idx)  // Check if map covers max index
+    {
+        ElfParser_statsErrorAt(map_size);
+        return ELFPARSER_ERR_SIZE;  // Insufficient size
+    }
+
+    const char *char_map = map;  // Cast map to char pointer
+    int64_t last_len = ElfParser_strLenBounded(&char_map[sect_head->max_idx], map_size - sect_head->max_idx);
+    if (last_len < 0)
+    {
+        ElfParser_statsErrorAt(map_size);
+        return ELFPARSER_ERR_SIZE;  // Highest name not terminated inside the map
+    }
+    size_t arena_size = (size_t)sect_head->max_idx + (size_t)last_len + 1;  // Every name ends at or before this
+    char *arena = ElfParser_allocMalloc(sect_head->alloc, arena_size);
+    if (!arena)
+    {
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+    if (!ElfParser_memCpy(arena, char_map, arena_size))  // One bulk copy of the referenced strings
+    {
+        ElfParser_allocFree(sect_head->alloc, arena);
+        return ELFPARSER_ERR_MEMCPY;
+    }
+
+    SectHead_namesRelease(sect_head);  // Names or block of an earlier resolve
+    for (size_t cnt = 0; cnt < sect_head->table_len; cnt++)  // Point names into the block
+    {
+        size_t name_idx = sect_head->table[cnt].sh_name_idx;
+        int64_t name_len = ElfParser_strLenBounded(&arena[name_idx], arena_size - name_idx);
+        sect_head->table[cnt].sh_name = &arena[name_idx];
+        sect_head->table[cnt].sh_name_len = (uint32_t)name_len;  // Always terminated: the block ends with a terminator
+    }
+    sect_head->name_arena = arena;
+    sect_head->name_mode = ELFPARSER_NAME_MODE_ARENA;  // Free releases the block in one go
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Resolves section names into a single block owned by the table
+ * @param[in,out] sect_head Pointer to the section header structure
+ * @param[in] map Pointer to the memory-mapped string table
+ * @param[in] map_size Size of the memory map in bytes
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_SIZE if a name lies outside the map, ELFPARSER_ERR_MALLOC if allocation fails,
+ *             ELFPARSER_ERR_MEMCPY if the copy fails
+ */
+int ElfParser_SectHead_nameResolveArena(elfparser_secthead_t *sect_head, const void *map, size_t map_size)
+{
+    if (!ElfParser_statsActive())
+    {
+        return SectHead_nameResolveArenaRun(sect_head, map, map_size);  // Nothing registered
+    }
+    elfparser_span_t span;
+    ElfParser_statsBegin(&span, ELFPARSER_PHASE_NAMES);
+    int ret = SectHead_nameResolveArenaRun(sect_head, map, map_size);
+    ElfParser_statsEnd(&span, ret, (ret < 0) ? 0 : ElfParser_statsNameExtent(map, map_size, sect_head->max_idx),
+                       (ret < 0) ? 0 : sect_head->table_len);
+    return ret;
+}
+
 /**
  * @brief Frees the section header structure and its allocated resources
  * @param[in,out] sect_head Pointer to the section header structure to free
@@ -183,12 +495,8 @@ int ElfParser_SectHead_free(elfparser_secthead_t *sect_head)
     {
         return ELFPARSER_ERR_NULL;  // Null pointer input
     }
-    for (size_t cnt = 0; cnt < sect_head->table_len; cnt++)  // Free each section name
-    {
-        free(sect_head->table[cnt].sh_name);  // Safe to free NULL
-        sect_head->table[cnt].sh_name = NULL; // Optional: ensure NULL after free
-    }
-    free(sect_head->table);  // Free the table
+    SectHead_namesRelease(sect_head);
+    ElfParser_allocFree(sect_head->alloc, sect_head->table);  // Free the table
     sect_head->table = NULL; // Nullify pointer
     return ELFPARSER_SUCCESS;  // Success
 }
@@ -221,3 +529,32 @@ int32_t ElfParser_SectHead_byNameFind(const elfparser_secthead_t *sect_head, con
     }
     return ELFPARSER_ERR_NOT_FOUND;  // Not found
 }
+
+/**
+ * @brief Finds a section header by type
+ * @param[in] sect_head Pointer to the section header structure
+ * @param[in] type Section type to find
+ * @param[in] start_idx Starting index for the search
+ * @return int32_t Index of the found section, ELFPARSER_ERR_NULL if sect_head is NULL,
+ *                 ELFPARSER_ERR_RANGE if table is invalid or start_idx is out of bounds,
+ *                 ELFPARSER_ERR_NOT_FOUND if no section has the type
+ */
+int32_t ElfParser_SectHead_byTypeFind(const elfparser_secthead_t *sect_head, uint32_t type, size_t start_idx)
+{
+    if (!sect_head)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    if (!sect_head->table || sect_head->table_len <= start_idx)
+    {
+        return ELFPARSER_ERR_RANGE;  // Invalid table or start index
+    }
+    for (size_t cnt = start_idx; cnt < sect_head->table_len; cnt++)  // Search for match
+    {
+        if (sect_head->table[cnt].sh_type == type)
+        {
+            return (int32_t)cnt;  // Return index
+        }
+    }
+    return ELFPARSER_ERR_NOT_FOUND;  // Not found
+}
@@ -0,0 +1,194 @@
+/**
+ * @file elfparser_stats.c
+ * @brief Per-phase parse statistics and tracing hooks for libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This file implements the registration of the calling thread's totals and
+ * callbacks and the span bookkeeping behind it. Spans live on the stack of
+ * the instrumented function and are linked to the span they are nested in,
+ * so the innermost one receives allocations and error offsets.
+ */
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L  // clock_gettime
+#endif
+
+#include "../inc_pub/elfparser_stats.h"
+#include "../inc_priv/elfparser_stats_priv.h"
+#include "../inc_priv/elfparser_memmanip_priv.h"
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief Registration of one thread
+ */
+typedef struct stats_reg_s
+{
+    elfparser_stats_t*  stats;  /**< Totals to add spans to, NULL for none */
+    elfparser_trace_t   trace;  /**< Callbacks, zeroed for none */
+} stats_reg_t;
+
+_Thread_local int elfparser_stats_on;                   /**< Non-zero while the thread has a registration */
+_Thread_local elfparser_span_t *elfparser_stats_span;   /**< Innermost open span of the thread, NULL if none */
+static _Thread_local stats_reg_t stats_reg;             /**< Registration of the thread */
+
+static const char *const stats_phase_names[ELFPARSER_PHASE_NUM] = { "ident", "header", "secthead", "names", "symtable" }; /**< Indexed by elfparser_phase_e */
+
+/**
+ * @brief Reads the monotonic clock
+ * @return uint64_t Nanoseconds since an arbitrary start
+ */
+static inline uint64_t Stats_nowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Starts collecting spans of the calling thread
+ * @param[in,out] stats Totals to add every span to, NULL for none
+ * @param[in] trace Callbacks to run for every span, NULL for none (copied)
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if both stats and trace are NULL
+ */
+int ElfParser_Stats_register(elfparser_stats_t *stats, const elfparser_trace_t *trace)
+{
+    if (!stats && !trace)
+    {
+        return ELFPARSER_ERR_NULL;  // Nothing to report to
+    }
+    stats_reg.stats = stats;
+    if (trace)
+    {
+        stats_reg.trace = *trace;
+    }
+    else
+    {
+        memset(&stats_reg.trace, 0, sizeof(stats_reg.trace));
+    }
+    elfparser_stats_on = 1;
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Stops collecting spans of the calling thread
+ * @return int ELFPARSER_SUCCESS
+ */
+int ElfParser_Stats_unregister(void)
+{
+    elfparser_stats_on = 0;
+    memset(&stats_reg, 0, sizeof(stats_reg));
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Clears per-phase totals
+ * @param[out] stats Totals to clear
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if stats is NULL
+ */
+int ElfParser_Stats_reset(elfparser_stats_t *stats)
+{
+    if (!stats)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    memset(stats, 0, sizeof(*stats));
+    for (uint32_t p = 0; p < ELFPARSER_PHASE_NUM; p++)
+    {
+        stats->phase[p].first_error_offset = ELFPARSER_STATS_OFFSET_NONE;
+    }
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Returns a printable name of a phase
+ * @param[in] phase Phase
+ * @return const char* Lower-case name, "unknown" if phase is out of range
+ */
+const char *ElfParser_Stats_phaseName(elfparser_phase_e phase)
+{
+    return ((uint32_t)phase < ELFPARSER_PHASE_NUM) ? stats_phase_names[phase] : "unknown";
+}
+
+/**
+ * @brief Opens a span and runs the begin callback
+ * @param[out] span Span to open, must stay valid until ElfParser_statsEnd()
+ * @param[in] phase Phase of the call
+ */
+void ElfParser_statsBegin(elfparser_span_t *span, elfparser_phase_e phase)
+{
+    memset(span, 0, sizeof(*span));
+    span->phase = phase;
+    span->error_offset = ELFPARSER_STATS_OFFSET_NONE;
+    span->parent = elfparser_stats_span;
+    if (stats_reg.trace.begin_fn)
+    {
+        stats_reg.trace.begin_fn(stats_reg.trace.ctx, phase);
+    }
+    elfparser_stats_span = span;
+    span->start_ns = Stats_nowNs();  // Last, so the callback is not timed
+}
+
+/**
+ * @brief Closes a span, adds it to the registered totals and runs the end callback
+ * @param[in,out] span Span opened by ElfParser_statsBegin() on the same thread
+ * @param[in] ret Return value of the call
+ * @param[in] bytes Bytes of the input read, ignored if ret is an error
+ * @param[in] entries Entries decoded or resolved, ignored if ret is an error
+ */
+void ElfParser_statsEnd(elfparser_span_t *span, int ret, uint64_t bytes, uint64_t entries)
+{
+    span->wall_ns = Stats_nowNs() - span->start_ns;  // First, so the bookkeeping is not timed
+    elfparser_stats_span = span->parent;
+    span->ret = ret;
+    span->bytes = (ret < 0) ? 0 : bytes;
+    span->entries = (ret < 0) ? 0 : entries;
+    if (ret >= 0)
+    {
+        span->error_offset = ELFPARSER_STATS_OFFSET_NONE;  // Offsets noted by a failed attempt that was recovered from
+    }
+
+    elfparser_stats_t *stats = stats_reg.stats;
+    if (stats && (uint32_t)span->phase < ELFPARSER_PHASE_NUM)
+    {
+        elfparser_phase_stats_t *total = &stats->phase[span->phase];
+        total->calls++;
+        total->wall_ns += span->wall_ns;
+        total->bytes += span->bytes;
+        total->entries += span->entries;
+        total->allocs += span->allocs;
+        total->alloc_bytes += span->alloc_bytes;
+        if (ret < 0)
+        {
+            if (total->errors == 0)
+            {
+                total->first_error = ret;
+                total->first_error_offset = span->error_offset;
+            }
+            total->errors++;
+        }
+    }
+    if (stats_reg.trace.end_fn)
+    {
+        stats_reg.trace.end_fn(stats_reg.trace.ctx, span);
+    }
+}
+
+/**
+ * @brief Returns how many bytes of a string table the names of a table reach into
+ * @param[in] map Pointer to the string table
+ * @param[in] map_size Size of the string table in bytes
+ * @param[in] max_idx Largest name offset of the table
+ * @return uint64_t End of the name at max_idx including its terminator, capped at map_size
+ */
+uint64_t ElfParser_statsNameExtent(const void *map, size_t map_size, uint32_t max_idx)
+{
+    if (!map || max_idx >= map_size)
+    {
+        return map_size;  // Whole table or nothing usable
+    }
+    int64_t last_len = ElfParser_strLenBounded((const char *)map + max_idx, map_size - max_idx);
+    return (last_len < 0) ? map_size : (uint64_t)max_idx + (uint64_t)last_len + 1u;
+}
@@ -0,0 +1,725 @@
+/**
+ * @file elfparser_symcache.c
+ * @brief Persistent symbol cache functions for libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This file implements the symbol cache. A load opens the ELF file, reads its
+ * header and build-id and looks for an index named after the build-id. A
+ * valid index is read in one go, its checksum verified and its fixed-size
+ * records expanded into section header and symbol table structures whose
+ * names point into one copied block per table. Otherwise the file is parsed
+ * through the file handle, the result encoded into a fresh index, which is
+ * written to a temporary file and renamed into place, and the structures are
+ * decoded from that same encoding, so both paths produce identical tables.
+ */
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L  // O_CLOEXEC, mkstemp and fchmod
+#endif
+
+#include "../inc_pub/elfparser_symcache.h"
+#include "../inc_priv/elfparser_symcache_priv.h"
+#include "../inc_priv/elfparser_hash_priv.h"
+#include "../inc_priv/elfparser_memmanip_priv.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Properties an index must share with the file to be used for it
+ */
+typedef struct symcache_key_s
+{
+    uint64_t        file_size;      /**< Size of the ELF file */
+    uint64_t        file_ino;       /**< Inode of the ELF file, changes when it is replaced */
+    uint64_t        file_mtime;     /**< Modification time of the ELF file, changes when it is rewritten in place */
+    uint64_t        sect_off;       /**< e_shoff, moves when sections are stripped or added */
+    uint32_t        sect_num;       /**< Number of section headers */
+    uint8_t         elf_class;      /**< ELF class */
+    uint8_t         elf_data;       /**< ELF data encoding */
+    uint16_t        machine;        /**< e_machine */
+    uint32_t        build_id_len;   /**< Length of build_id */
+    const uint8_t*  build_id;       /**< GNU build-id */
+} symcache_key_t;
+
+/**
+ * @brief Rounds a block size up to SYMCACHE_ALIGN
+ * @param[in] size Size in bytes
+ * @return uint64_t Padded size
+ */
+static inline uint64_t SymCache_pad(uint64_t size)
+{
+    return (size + SYMCACHE_ALIGN - 1) & ~(uint64_t)(SYMCACHE_ALIGN - 1);
+}
+
+/**
+ * @brief Builds the path of a cache file from the directory and the build-id
+ * @param[out] out Destination buffer of SYMCACHE_PATH_MAX bytes
+ * @param[in] dir Cache directory
+ * @param[in] key Key holding the build-id
+ * @param[in] prefix Text put before the hex build-id
+ * @param[in] suffix Text put after the hex build-id
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_SIZE if the path does not fit
+ */
+static int SymCache_pathBuild(char *out, const char *dir, const symcache_key_t *key, const char *prefix, const char *suffix)
+{
+    static const char hex[] = "0123456789abcdef";
+    char id[ELFPARSER_NOTE_BUILD_ID_MAX * 2 + 1];
+
+    for (uint32_t i = 0; i < key->build_id_len; i++)
+    {
+        id[2 * i] = hex[key->build_id[i] >> 4];
+        id[2 * i + 1] = hex[key->build_id[i] & 0x0F];
+    }
+    id[2 * key->build_id_len] = '\0';
+    int len = snprintf(out, SYMCACHE_PATH_MAX, "%s/%s%s%s", dir, prefix, id, suffix);
+    if (len < 0 || (size_t)len >= SYMCACHE_PATH_MAX)
+    {
+        return ELFPARSER_ERR_SIZE;  // Path too long
+    }
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Reads a whole index file into a new buffer
+ * @param[in] path Path of the index
+ * @param[out] buf Set to the allocated contents
+ * @param[out] size Set to the size of the contents
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NOT_FOUND if there is no index,
+ *             ELFPARSER_ERR_SIZE if it is implausibly large, ELFPARSER_ERR_MALLOC or ELFPARSER_ERR_IO on failure
+ */
+static int SymCache_fileRead(const char *path, uint8_t **buf, size_t *size)
+{
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return (errno == ENOENT) ? ELFPARSER_ERR_NOT_FOUND : ELFPARSER_ERR_IO;  // Miss or unreadable
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        return ELFPARSER_ERR_IO;  // Cannot inspect
+    }
+    if ((uint64_t)st.st_size > SYMCACHE_FILE_MAX)
+    {
+        close(fd);
+        return ELFPARSER_ERR_SIZE;  // Not one of ours
+    }
+
+    size_t file_size = (size_t)st.st_size;
+    uint8_t *data = malloc(file_size ? file_size : 1);
+    if (!data)
+    {
+        close(fd);
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+    size_t done = 0;
+    while (done < file_size)
+    {
+        ssize_t got = read(fd, data + done, file_size - done);
+        if (got < 0 && errno == EINTR)
+        {
+            continue;  // Interrupted, retry
+        }
+        if (got <= 0)
+        {
+            break;  // Error or truncated underneath us
+        }
+        done += (size_t)got;
+    }
+    close(fd);
+    if (done != file_size)
+    {
+        free(data);
+        return ELFPARSER_ERR_IO;  // Short read
+    }
+    *buf = data;
+    *size = file_size;
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Writes an index to a temporary file and renames it into place
+ * @param[in] dir Cache directory, created if missing
+ * @param[in] key Key holding the build-id that names the index
+ * @param[in] buf Encoded index
+ * @param[in] size Size of the encoded index
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_SIZE if a path is too long, ELFPARSER_ERR_IO on failure
+ */
+static int SymCache_fileWrite(const char *dir, const symcache_key_t *key, const uint8_t *buf, size_t size)
+{
+    char path[SYMCACHE_PATH_MAX];
+    char tmp_path[SYMCACHE_PATH_MAX];
+    if (SymCache_pathBuild(path, dir, key, "", SYMCACHE_FILE_SUFFIX) < 0 ||
+        SymCache_pathBuild(tmp_path, dir, key, ".", ".XXXXXX") < 0)
+    {
+        return ELFPARSER_ERR_SIZE;  // Path too long
+    }
+    if (mkdir(dir, 0755) != 0 && errno != EEXIST)
+    {
+        return ELFPARSER_ERR_IO;  // No directory to write into
+    }
+
+    int fd = mkstemp(tmp_path);  // Unique per writer, so concurrent writers never interleave
+    if (fd < 0)
+    {
+        return ELFPARSER_ERR_IO;  // Directory not writable
+    }
+    size_t done = 0;
+    while (done < size)
+    {
+        ssize_t put = write(fd, buf + done, size - done);
+        if (put < 0 && errno == EINTR)
+        {
+            continue;  // Interrupted, retry
+        }
+        if (put <= 0)
+        {
+            break;  // Disk full or I/O error
+        }
+        done += (size_t)put;
+    }
+    fchmod(fd, 0644);  // mkstemp creates 0600; let other users of a shared cache read it
+    int synced = (done == size) ? fsync(fd) : -1;  // Data on disk before the name, so a crash never leaves an empty index
+    if (close(fd) != 0 || synced != 0 || rename(tmp_path, path) != 0)  // Readers see the old index or the new one
+    {
+        unlink(tmp_path);
+        return ELFPARSER_ERR_IO;
+    }
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Measures the part of the name string table referenced by the section headers
+ * @param[in] sect_head Section headers with view or arena names
+ * @param[out] base Set to the start of the string table
+ * @return uint64_t Bytes from the start of the string table to the end of the furthest name
+ */
+static uint64_t SymCache_sectBlobMeasure(const elfparser_secthead_t *sect_head, const char **base)
+{
+    uint64_t end = 0;
+
+    *base = sect_head->table_len ? sect_head->table[0].sh_name - sect_head->table[0].sh_name_idx : NULL;
+    for (uint32_t i = 0; i < sect_head->table_len; i++)
+    {
+        uint64_t name_end = (uint64_t)sect_head->table[i].sh_name_idx + sect_head->table[i].sh_name_len + 1;
+        end = (name_end > end) ? name_end : end;  // Include the terminator
+    }
+    return end;
+}
+
+/**
+ * @brief Measures the part of the string table referenced by a symbol table
+ * @param[in] symbol_table Symbol table with view or arena names
+ * @param[out] base Set to the start of the string table
+ * @return uint64_t Bytes from the start of the string table to the end of the furthest name
+ */
+static uint64_t SymCache_symBlobMeasure(const elfparser_symtable_t *symbol_table, const char **base)
+{
+    uint64_t end = 0;
+
+    *base = symbol_table->table_len ? symbol_table->table[0].sym_name - symbol_table->table[0].sym_name_idx : NULL;
+    for (uint32_t i = 0; i < symbol_table->table_len; i++)
+    {
+        uint64_t name_end = (uint64_t)symbol_table->table[i].sym_name_idx + symbol_table->table[i].sym_name_len + 1;
+        end = (name_end > end) ? name_end : end;  // Include the terminator
+    }
+    return end;
+}
+
+/**
+ * @brief Encodes section headers and symbol tables into an index
+ *
+ * Names must be views or arenas, i.e. every name lies at its string table
+ * index from the start of its string table.
+ *
+ * @param[in] key Properties of the file
+ * @param[in] sect_head Section headers with resolved names
+ * @param[in] tables Symbol tables with resolved names
+ * @param[in] sect_idx Section index of each table
+ * @param[in] table_num Number of tables
+ * @param[out] buf Set to the allocated index
+ * @param[out] size Set to the size of the index
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_MALLOC if allocation fails
+ */
+static int SymCache_encode(const symcache_key_t *key, const elfparser_secthead_t *sect_head,
+                           const elfparser_symtable_t *tables, const uint32_t *sect_idx, uint32_t table_num,
+                           uint8_t **buf, size_t *size)
+{
+    const elfparser_secthead_entry_t *sects = sect_head->table;
+    const char *sect_base;
+    uint64_t sect_blob = SymCache_sectBlobMeasure(sect_head, &sect_base);
+    uint64_t total = SYMCACHE_HDR_SIZE + (uint64_t)sect_head->table_len * SYMCACHE_SECT_RECORD_SIZE + SymCache_pad(sect_blob);
+    for (uint32_t t = 0; t < table_num; t++)
+    {
+        const char *base;
+        total += SYMCACHE_TABLE_RECORD_SIZE + (uint64_t)tables[t].table_len * SYMCACHE_SYM_RECORD_SIZE + SymCache_pad(SymCache_symBlobMeasure(&tables[t], &base));
+    }
+    if (total > SYMCACHE_FILE_MAX)
+    {
+        return ELFPARSER_ERR_SIZE;  // Would not be read back
+    }
+    uint8_t *out = calloc(1, (size_t)total);  // Zeroed padding keeps the checksum reproducible
+    if (!out)
+    {
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+
+    ElfParser_store32(out + SYMCACHE_HDR_MAGIC_OFF, SYMCACHE_MAGIC, 0);
+    ElfParser_store32(out + SYMCACHE_HDR_VERSION_OFF, SYMCACHE_VERSION, 0);
+    ElfParser_store64(out + SYMCACHE_HDR_PAYLOAD_SIZE_OFF, total - SYMCACHE_HDR_SIZE, 0);
+    ElfParser_store64(out + SYMCACHE_HDR_FILE_SIZE_OFF, key->file_size, 0);
+    ElfParser_store64(out + SYMCACHE_HDR_FILE_INO_OFF, key->file_ino, 0);
+    ElfParser_store64(out + SYMCACHE_HDR_FILE_MTIME_OFF, key->file_mtime, 0);
+    ElfParser_store64(out + SYMCACHE_HDR_SECT_OFF_OFF, key->sect_off, 0);
+    ElfParser_store64(out + SYMCACHE_HDR_SECT_BLOB_OFF, sect_blob, 0);
+    ElfParser_store32(out + SYMCACHE_HDR_SECT_NUM_OFF, sect_head->table_len, 0);
+    ElfParser_store32(out + SYMCACHE_HDR_SECT_STRTAB_OFF, sect_head->string_table_idx, 0);
+    ElfParser_store32(out + SYMCACHE_HDR_TABLE_NUM_OFF, table_num, 0);
+    ElfParser_store32(out + SYMCACHE_HDR_BUILD_ID_LEN_OFF, key->build_id_len, 0);
+    out[SYMCACHE_HDR_CLASS_OFF] = key->elf_class;
+    out[SYMCACHE_HDR_DATA_OFF] = key->elf_data;
+    ElfParser_store16(out + SYMCACHE_HDR_MACHINE_OFF, key->machine, 0);
+    ElfParser_store16(out + SYMCACHE_HDR_SECT_ENTSIZE_OFF, sect_head->entry_size, 0);
+    memcpy(out + SYMCACHE_HDR_BUILD_ID_OFF, key->build_id, key->build_id_len);
+
+    uint8_t *rec = out + SYMCACHE_HDR_SIZE;
+    for (uint32_t i = 0; i < sect_head->table_len; i++, rec += SYMCACHE_SECT_RECORD_SIZE)
+    {
+        ElfParser_store32(rec + SYMCACHE_SECT_NAME_IDX_OFF, sects[i].sh_name_idx, 0);
+        ElfParser_store32(rec + SYMCACHE_SECT_NAME_LEN_OFF, sects[i].sh_name_len, 0);
+        ElfParser_store32(rec + SYMCACHE_SECT_TYPE_OFF, sects[i].sh_type, 0);
+        ElfParser_store32(rec + SYMCACHE_SECT_LINK_OFF, sects[i].sh_link, 0);
+        ElfParser_store32(rec + SYMCACHE_SECT_INFO_OFF, sects[i].sh_info, 0);
+        ElfParser_store64(rec + SYMCACHE_SECT_FLAGS_OFF, sects[i].sh_flags, 0);
+        ElfParser_store64(rec + SYMCACHE_SECT_ADDR_OFF, sects[i].sh_addr, 0);
+        ElfParser_store64(rec + SYMCACHE_SECT_OFFSET_OFF, sects[i].sh_offset, 0);
+        ElfParser_store64(rec + SYMCACHE_SECT_SIZE_OFF, sects[i].sh_size, 0);
+        ElfParser_store64(rec + SYMCACHE_SECT_ADDRALIGN_OFF, sects[i].sh_addralign, 0);
+        ElfParser_store64(rec + SYMCACHE_SECT_ENTSIZE_OFF, sects[i].sh_entsize, 0);
+    }
+    if (sect_blob)
+    {
+        memcpy(rec, sect_base, (size_t)sect_blob);
+    }
+    rec += SymCache_pad(sect_blob);
+
+    for (uint32_t t = 0; t < table_num; t++)
+    {
+        const elfparser_symtable_entry_t *syms = tables[t].table;
+        const char *base;
+        uint64_t blob = SymCache_symBlobMeasure(&tables[t], &base);
+        ElfParser_store32(rec + SYMCACHE_TABLE_SECT_IDX_OFF, sect_idx[t], 0);
+        ElfParser_store32(rec + SYMCACHE_TABLE_SYM_NUM_OFF, tables[t].table_len, 0);
+        ElfParser_store32(rec + SYMCACHE_TABLE_STRTAB_OFF, tables[t].string_table_idx, 0);
+        ElfParser_store32(rec + SYMCACHE_TABLE_ENTSIZE_OFF, tables[t].entry_size, 0);
+        ElfParser_store64(rec + SYMCACHE_TABLE_BLOB_OFF, blob, 0);
+        rec += SYMCACHE_TABLE_RECORD_SIZE;
+        for (uint32_t i = 0; i < tables[t].table_len; i++, rec += SYMCACHE_SYM_RECORD_SIZE)
+        {
+            ElfParser_store64(rec + SYMCACHE_SYM_VALUE_OFF, syms[i].sym_value, 0);
+            ElfParser_store64(rec + SYMCACHE_SYM_SIZE_OFF, syms[i].sym_size, 0);
+            ElfParser_store32(rec + SYMCACHE_SYM_NAME_IDX_OFF, syms[i].sym_name_idx, 0);
+            ElfParser_store32(rec + SYMCACHE_SYM_NAME_LEN_OFF, syms[i].sym_name_len, 0);
+            ElfParser_store32(rec + SYMCACHE_SYM_SECT_IDX_OFF, syms[i].sym_sect_idx, 0);
+            rec[SYMCACHE_SYM_BIND_OFF] = syms[i].sym_bind;
+            rec[SYMCACHE_SYM_TYPE_OFF] = syms[i].sym_type;
+            rec[SYMCACHE_SYM_VISIBILITY_OFF] = syms[i].sym_visibility;
+        }
+        if (blob)
+        {
+            memcpy(rec, base, (size_t)blob);
+        }
+        rec += SymCache_pad(blob);
+    }
+
+    ElfParser_store64(out + SYMCACHE_HDR_CHECKSUM_OFF,
+                      ElfParser_hash64(out + SYMCACHE_HDR_CHECKED_OFF, (size_t)total - SYMCACHE_HDR_CHECKED_OFF, SYMCACHE_VERSION), 0);
+    *buf = out;
+    *size = (size_t)total;
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Copies a name block out of an index
+ * @param[in] src Pointer to the name block in the index
+ * @param[in] blob Size of the name block
+ * @param[out] arena Set to the allocated copy
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_MALLOC if allocation fails
+ */
+static int SymCache_arenaCopy(const uint8_t *src, uint64_t blob, char **arena)
+{
+    *arena = malloc(blob ? (size_t)blob : 1);
+    if (!*arena)
+    {
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+    if (blob)
+    {
+        memcpy(*arena, src, (size_t)blob);
+    }
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Checks that a name lies inside its block and is terminated there
+ * @param[in] arena Name block
+ * @param[in] blob Size of the name block
+ * @param[in] idx Offset of the name
+ * @param[in] len Length of the name
+ * @return int Non-zero if the name is valid
+ */
+static inline int SymCache_nameValid(const char *arena, uint64_t blob, uint32_t idx, uint32_t len)
+{
+    return (uint64_t)idx + len < blob && arena[(uint64_t)idx + len] == '\0';
+}
+
+/**
+ * @brief Decodes an index into a cache structure after validating it against the file
+ * @param[out] cache Pointer to the cache structure to fill; released again on failure
+ * @param[in] buf Index contents
+ * @param[in] size Size of the index
+ * @param[in] key Properties of the file
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_FORMAT if the index is corrupt or stale,
+ *             ELFPARSER_ERR_MALLOC if allocation fails
+ */
+static int SymCache_decode(elfparser_symcache_t *cache, const uint8_t *buf, size_t size, const symcache_key_t *key)
+{
+    if (size < SYMCACHE_HDR_SIZE ||
+        ElfParser_load32(buf + SYMCACHE_HDR_MAGIC_OFF, 0) != SYMCACHE_MAGIC ||
+        ElfParser_load32(buf + SYMCACHE_HDR_VERSION_OFF, 0) != SYMCACHE_VERSION ||
+        ElfParser_load64(buf + SYMCACHE_HDR_PAYLOAD_SIZE_OFF, 0) != size - SYMCACHE_HDR_SIZE)
+    {
+        return ELFPARSER_ERR_FORMAT;  // Not an index of this version, or truncated
+    }
+    if (ElfParser_load64(buf + SYMCACHE_HDR_CHECKSUM_OFF, 0) !=
+        ElfParser_hash64(buf + SYMCACHE_HDR_CHECKED_OFF, size - SYMCACHE_HDR_CHECKED_OFF, SYMCACHE_VERSION))
+    {
+        return ELFPARSER_ERR_FORMAT;  // Corrupt
+    }
+    if (ElfParser_load64(buf + SYMCACHE_HDR_FILE_SIZE_OFF, 0) != key->file_size ||
+        ElfParser_load64(buf + SYMCACHE_HDR_FILE_INO_OFF, 0) != key->file_ino ||
+        ElfParser_load64(buf + SYMCACHE_HDR_FILE_MTIME_OFF, 0) != key->file_mtime ||
+        ElfParser_load64(buf + SYMCACHE_HDR_SECT_OFF_OFF, 0) != key->sect_off ||
+        ElfParser_load32(buf + SYMCACHE_HDR_SECT_NUM_OFF, 0) != key->sect_num ||
+        buf[SYMCACHE_HDR_CLASS_OFF] != key->elf_class || buf[SYMCACHE_HDR_DATA_OFF] != key->elf_data ||
+        ElfParser_load16(buf + SYMCACHE_HDR_MACHINE_OFF, 0) != key->machine ||
+        ElfParser_load32(buf + SYMCACHE_HDR_BUILD_ID_LEN_OFF, 0) != key->build_id_len ||
+        memcmp(buf + SYMCACHE_HDR_BUILD_ID_OFF, key->build_id, key->build_id_len) != 0)
+    {
+        return ELFPARSER_ERR_FORMAT;  // Stale: the file was rebuilt, stripped or replaced
+    }
+
+    uint32_t sect_num = key->sect_num;
+    uint64_t sect_blob = ElfParser_load64(buf + SYMCACHE_HDR_SECT_BLOB_OFF, 0);
+    uint32_t table_num = ElfParser_load32(buf + SYMCACHE_HDR_TABLE_NUM_OFF, 0);
+    const uint8_t *end = buf + size;
+    const uint8_t *rec = buf + SYMCACHE_HDR_SIZE;
+    if ((uint64_t)(end - rec) < (uint64_t)sect_num * SYMCACHE_SECT_RECORD_SIZE + SymCache_pad(sect_blob) ||
+        table_num > sect_num)
+    {
+        return ELFPARSER_ERR_FORMAT;  // Counts do not fit the payload
+    }
+
+    elfparser_secthead_t *sect_head = &cache->sect_head;
+    sect_head->elf_class = (elfparser_header_class_e)key->elf_class;
+    sect_head->elf_data = (elfparser_header_data_e)key->elf_data;
+    sect_head->table_len = sect_num;
+    sect_head->entry_size = ElfParser_load16(buf + SYMCACHE_HDR_SECT_ENTSIZE_OFF, 0);
+    sect_head->string_table_idx = ElfParser_load32(buf + SYMCACHE_HDR_SECT_STRTAB_OFF, 0);
+    sect_head->max_idx = 0;
+    sect_head->name_mode = ELFPARSER_NAME_MODE_ARENA;
+    sect_head->name_arena = NULL;
+    sect_head->alloc = NULL;  // Tables and name blocks below come from malloc
+    sect_head->table = malloc((size_t)(sect_num ? sect_num : 1) * sizeof(elfparser_secthead_entry_t));
+    cache->sym_tables = calloc(table_num ? table_num : 1, sizeof(elfparser_symtable_t));
+    cache->sym_sect_idx = malloc((size_t)(table_num ? table_num : 1) * sizeof(uint32_t));
+    if (!sect_head->table || !cache->sym_tables || !cache->sym_sect_idx ||
+        SymCache_arenaCopy(rec + (uint64_t)sect_num * SYMCACHE_SECT_RECORD_SIZE, sect_blob, &sect_head->name_arena) < 0)
+    {
+        ElfParser_SymCache_free(cache);
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+    for (uint32_t i = 0; i < sect_num; i++, rec += SYMCACHE_SECT_RECORD_SIZE)
+    {
+        elfparser_secthead_entry_t *sect = &sect_head->table[i];
+        sect->sh_name_idx = ElfParser_load32(rec + SYMCACHE_SECT_NAME_IDX_OFF, 0);
+        sect->sh_name_len = ElfParser_load32(rec + SYMCACHE_SECT_NAME_LEN_OFF, 0);
+        sect->sh_type = ElfParser_load32(rec + SYMCACHE_SECT_TYPE_OFF, 0);
+        sect->sh_link = ElfParser_load32(rec + SYMCACHE_SECT_LINK_OFF, 0);
+        sect->sh_info = ElfParser_load32(rec + SYMCACHE_SECT_INFO_OFF, 0);
+        sect->sh_flags = ElfParser_load64(rec + SYMCACHE_SECT_FLAGS_OFF, 0);
+        sect->sh_addr = ElfParser_load64(rec + SYMCACHE_SECT_ADDR_OFF, 0);
+        sect->sh_offset = ElfParser_load64(rec + SYMCACHE_SECT_OFFSET_OFF, 0);
+        sect->sh_size = ElfParser_load64(rec + SYMCACHE_SECT_SIZE_OFF, 0);
+        sect->sh_addralign = ElfParser_load64(rec + SYMCACHE_SECT_ADDRALIGN_OFF, 0);
+        sect->sh_entsize = ElfParser_load64(rec + SYMCACHE_SECT_ENTSIZE_OFF, 0);
+        if (!SymCache_nameValid(sect_head->name_arena, sect_blob, sect->sh_name_idx, sect->sh_name_len))
+        {
+            ElfParser_SymCache_free(cache);
+            return ELFPARSER_ERR_FORMAT;  // Name outside its block
+        }
+        sect->sh_name = sect_head->name_arena + sect->sh_name_idx;
+        if (sect->sh_name_idx > sect_head->max_idx)
+        {
+            sect_head->max_idx = sect->sh_name_idx;
+        }
+    }
+    rec += SymCache_pad(sect_blob);
+
+    for (uint32_t t = 0; t < table_num; t++)
+    {
+        if (end - rec < SYMCACHE_TABLE_RECORD_SIZE)
+        {
+            ElfParser_SymCache_free(cache);
+            return ELFPARSER_ERR_FORMAT;  // Truncated table record
+        }
+        elfparser_symtable_t *table = &cache->sym_tables[t];
+        cache->sym_table_num = t + 1;  // Tables up to this one are released on failure
+        uint32_t sym_num = ElfParser_load32(rec + SYMCACHE_TABLE_SYM_NUM_OFF, 0);
+        uint64_t blob = ElfParser_load64(rec + SYMCACHE_TABLE_BLOB_OFF, 0);
+        cache->sym_sect_idx[t] = ElfParser_load32(rec + SYMCACHE_TABLE_SECT_IDX_OFF, 0);
+        table->elf_class = sect_head->elf_class;
+        table->elf_data = sect_head->elf_data;
+        table->string_table_idx = ElfParser_load32(rec + SYMCACHE_TABLE_STRTAB_OFF, 0);
+        table->entry_size = (uint16_t)ElfParser_load32(rec + SYMCACHE_TABLE_ENTSIZE_OFF, 0);
+        table->max_idx = 0;
+        table->name_mode = ELFPARSER_NAME_MODE_ARENA;
+        table->alloc = NULL;
+        rec += SYMCACHE_TABLE_RECORD_SIZE;
+        if (sym_num > INT32_MAX || (uint64_t)(end - rec) < (uint64_t)sym_num * SYMCACHE_SYM_RECORD_SIZE + SymCache_pad(blob))
+        {
+            ElfParser_SymCache_free(cache);
+            return ELFPARSER_ERR_FORMAT;  // Too many symbols to index or records overrun the payload
+        }
+        table->table = malloc((size_t)(sym_num ? sym_num : 1) * sizeof(elfparser_symtable_entry_t));
+        table->table_len = sym_num;
+        if (!table->table ||
+            SymCache_arenaCopy(rec + (uint64_t)sym_num * SYMCACHE_SYM_RECORD_SIZE, blob, &table->name_arena) < 0)
+        {
+            ElfParser_SymCache_free(cache);
+            return ELFPARSER_ERR_MALLOC;  // Allocation failure
+        }
+        for (uint32_t i = 0; i < sym_num; i++, rec += SYMCACHE_SYM_RECORD_SIZE)
+        {
+            elfparser_symtable_entry_t *sym = &table->table[i];
+            sym->sym_value = ElfParser_load64(rec + SYMCACHE_SYM_VALUE_OFF, 0);
+            sym->sym_size = ElfParser_load64(rec + SYMCACHE_SYM_SIZE_OFF, 0);
+            sym->sym_name_idx = ElfParser_load32(rec + SYMCACHE_SYM_NAME_IDX_OFF, 0);
+            sym->sym_name_len = ElfParser_load32(rec + SYMCACHE_SYM_NAME_LEN_OFF, 0);
+            sym->sym_sect_idx = ElfParser_load32(rec + SYMCACHE_SYM_SECT_IDX_OFF, 0);
+            sym->sym_bind = rec[SYMCACHE_SYM_BIND_OFF];
+            sym->sym_type = rec[SYMCACHE_SYM_TYPE_OFF];
+            sym->sym_visibility = rec[SYMCACHE_SYM_VISIBILITY_OFF];
+            if (!SymCache_nameValid(table->name_arena, blob, sym->sym_name_idx, sym->sym_name_len))
+            {
+                ElfParser_SymCache_free(cache);
+                return ELFPARSER_ERR_FORMAT;  // Name outside its block
+            }
+            sym->sym_name = table->name_arena + sym->sym_name_idx;
+            if (sym->sym_name_idx > table->max_idx)
+            {
+                table->max_idx = sym->sym_name_idx;
+            }
+        }
+        rec += SymCache_pad(blob);
+    }
+    if (rec != end)
+    {
+        ElfParser_SymCache_free(cache);
+        return ELFPARSER_ERR_FORMAT;  // Trailing bytes
+    }
+    cache->sym_table_num = table_num;
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Parses the section headers and all symbol tables of a file and encodes them into an index
+ * @param[in,out] file Pointer to an open file structure
+ * @param[in] key Properties of the file
+ * @param[out] buf Set to the allocated index
+ * @param[out] size Set to the size of the index
+ * @return int ELFPARSER_SUCCESS on success, or the error of the file handle or the encoder
+ */
+static int SymCache_parse(elfparser_file_t *file, const symcache_key_t *key, uint8_t **buf, size_t *size)
+{
+    const elfparser_secthead_t *sect_head;
+    int ret = ElfParser_File_sectHeadGet(file, &sect_head);
+    if (ret < 0)
+    {
+        return ret;  // No section headers
+    }
+
+    uint32_t table_num = 0;
+    for (uint32_t i = 0; i < sect_head->table_len; i++)
+    {
+        uint32_t type = sect_head->table[i].sh_type;
+        table_num += (type == ELFPARSER_SECTHEAD_TYPE_SYMTAB || type == ELFPARSER_SECTHEAD_TYPE_DYNSYM);
+    }
+    elfparser_symtable_t *tables = calloc(table_num ? table_num : 1, sizeof(elfparser_symtable_t));
+    uint32_t *sect_idx = malloc((size_t)(table_num ? table_num : 1) * sizeof(uint32_t));
+    if (!tables || !sect_idx)
+    {
+        free(tables);
+        free(sect_idx);
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+
+    uint32_t loaded = 0;
+    for (uint32_t i = 0; i < sect_head->table_len && ret >= 0; i++)
+    {
+        uint32_t type = sect_head->table[i].sh_type;
+        if (type == ELFPARSER_SECTHEAD_TYPE_SYMTAB || type == ELFPARSER_SECTHEAD_TYPE_DYNSYM)
+        {
+            ret = ElfParser_File_symTableLoad(file, &tables[loaded], i);
+            sect_idx[loaded] = i;
+            loaded += (ret >= 0);
+        }
+    }
+    if (ret >= 0)
+    {
+        ret = SymCache_encode(key, sect_head, tables, sect_idx, table_num, buf, size);
+    }
+    for (uint32_t t = 0; t < loaded; t++)
+    {
+        ElfParser_SymTable_free(&tables[t]);
+    }
+    free(tables);
+    free(sect_idx);
+    return ret;
+}
+
+/**
+ * @brief Loads the section headers and symbol tables of a file through the cache
+ * @param[out] cache Pointer to the structure to fill, released with ElfParser_SymCache_free()
+ * @param[in] cache_dir Directory holding the index files, NULL to bypass the cache
+ * @param[in] path Path of the ELF file
+ * @param[in] file_flags ELFPARSER_FILE_FLAG_* values the file is opened with
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             or the error of the file handle, section header or symbol table functions
+ */
+int ElfParser_SymCache_load(elfparser_symcache_t *cache, const char *cache_dir, const char *path, uint32_t file_flags)
+{
+    if (!cache || !path)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    memset(cache, 0, sizeof(*cache));
+
+    elfparser_file_t file;
+    int ret = ElfParser_File_open(&file, path, file_flags);
+    if (ret < 0)
+    {
+        return ret;  // Cannot open
+    }
+    const elfparser_header_t *header;
+    ret = ElfParser_File_headerGet(&file, &header);
+    if (ret >= 0)
+    {
+        ret = ElfParser_File_buildIdGet(&file, cache->build_id, &cache->build_id_len);
+        if (ret == ELFPARSER_ERR_NOT_FOUND)
+        {
+            cache->build_id_len = 0;  // Parsed, but never cached
+            ret = ELFPARSER_SUCCESS;
+        }
+    }
+    if (ret < 0)
+    {
+        ElfParser_File_close(&file);
+        return ret;  // Not an ELF file
+    }
+
+    symcache_key_t key = {
+        .file_size = file.reader.file_size,
+        .file_ino = file.reader.file_ino,
+        .file_mtime = file.reader.file_mtime,
+        .sect_off = header->elf_section_header_off,
+        .sect_num = header->elf_section_header_entry_num,
+        .elf_class = (uint8_t)header->elf_ident.elf_class,
+        .elf_data = (uint8_t)header->elf_ident.elf_data,
+        .machine = header->elf_machine,
+        .build_id_len = cache->build_id_len,
+        .build_id = cache->build_id
+    };
+    char index_path[SYMCACHE_PATH_MAX];
+    uint8_t *buf = NULL;
+    size_t size = 0;
+    cache->source = ELFPARSER_SYMCACHE_SOURCE_UNCACHED;
+    if (cache_dir && key.build_id_len && SymCache_pathBuild(index_path, cache_dir, &key, "", SYMCACHE_FILE_SUFFIX) >= 0)
+    {
+        cache->source = ELFPARSER_SYMCACHE_SOURCE_MISS;
+        if (SymCache_fileRead(index_path, &buf, &size) >= 0)
+        {
+            ret = SymCache_decode(cache, buf, size, &key);
+            free(buf);
+            buf = NULL;
+            if (ret >= 0)
+            {
+                cache->source = ELFPARSER_SYMCACHE_SOURCE_HIT;
+                ElfParser_File_close(&file);
+                return ELFPARSER_SUCCESS;  // Warm load: no ELF table was decoded
+            }
+            cache->source = ELFPARSER_SYMCACHE_SOURCE_STALE;
+        }
+    }
+
+    ret = SymCache_parse(&file, &key, &buf, &size);
+    ElfParser_File_close(&file);
+    if (ret < 0)
+    {
+        return ret;  // Unparsable file
+    }
+    if (cache->source != ELFPARSER_SYMCACHE_SOURCE_UNCACHED && SymCache_fileWrite(cache_dir, &key, buf, size) < 0)
+    {
+        cache->source = ELFPARSER_SYMCACHE_SOURCE_UNCACHED;  // Read-only or full cache directory
+    }
+    ret = SymCache_decode(cache, buf, size, &key);  // Same tables as a later warm load
+    free(buf);
+    return ret;
+}
+
+/**
+ * @brief Frees the tables of a loaded cache structure
+ * @param[in,out] cache Pointer to the structure filled by ElfParser_SymCache_load()
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if cache is NULL
+ */
+int ElfParser_SymCache_free(elfparser_symcache_t *cache)
+{
+    if (!cache)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    if (cache->sect_head.table)
+    {
+        ElfParser_SectHead_free(&cache->sect_head);
+    }
+    else
+    {
+        free(cache->sect_head.name_arena);
+    }
+    cache->sect_head.name_arena = NULL;
+    for (uint32_t t = 0; t < cache->sym_table_num; t++)  // Names are arenas, freed whatever table_len says
+    {
+        if (cache->sym_tables[t].table)
+        {
+            ElfParser_SymTable_free(&cache->sym_tables[t]);
+        }
+        else
+        {
+            free(cache->sym_tables[t].name_arena);
+            cache->sym_tables[t].name_arena = NULL;
+        }
+    }
+    free(cache->sym_tables);
+    free(cache->sym_sect_idx);
+    cache->sym_tables = NULL;
+    cache->sym_sect_idx = NULL;
+    cache->sym_table_num = 0;
+    return ELFPARSER_SUCCESS;  // Success
+}
@@ -0,0 +1,201 @@
+/**
+ * @file elfparser_symcursor.c
+ * @brief Streaming symbol table iteration for libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This file implements the symbol cursor. Each call to ElfParser_SymCursor_next()
+ * decodes a run of raw entries straight into the caller's batch with the
+ * shared per-layout decoder, then compacts the batch in place while it is
+ * still hot in cache, keeping only entries that pass the filters and giving
+ * them bounded-checked name views. No memory is allocated.
+ */
+
+#include "../inc_pub/elfparser_symcursor.h"
+#include "../inc_priv/elfparser_symtable_priv.h"
+#include "../inc_priv/elfparser_memmanip_priv.h"
+
+/**
+ * @brief Opens a cursor at the first entry of a symbol table section
+ * @param[out] cursor Pointer to the cursor structure to initialize
+ * @param[in] sect_head Pointer to a parsed section header table of the file
+ * @param[in] sym_sect_idx Index of the SHT_SYMTAB or SHT_DYNSYM section
+ * @param[in] map Pointer to the memory-mapped ELF file
+ * @param[in] map_size Size of the memory map in bytes
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_RANGE if an index or link is invalid, ELFPARSER_ERR_FORMAT if the section
+ *             is not a symbol table, ELFPARSER_ERR_SIZE if a table lies outside the map
+ */
+int ElfParser_SymCursor_open(elfparser_symcursor_t *cursor, const elfparser_secthead_t *sect_head, uint32_t sym_sect_idx,
+                             const void *map, size_t map_size)
+{
+    if (!cursor || !sect_head || !sect_head->table || !map)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    if (sym_sect_idx >= sect_head->table_len)
+    {
+        return ELFPARSER_ERR_RANGE;  // Invalid section index
+    }
+
+    const elfparser_secthead_entry_t *sym_sect = &sect_head->table[sym_sect_idx];
+    if (sym_sect->sh_type != ELFPARSER_SECTHEAD_TYPE_SYMTAB && sym_sect->sh_type != ELFPARSER_SECTHEAD_TYPE_DYNSYM)
+    {
+        return ELFPARSER_ERR_FORMAT;  // Not a symbol table
+    }
+    if (sym_sect->sh_link >= sect_head->table_len || sym_sect->sh_entsize == 0 || sym_sect->sh_entsize > UINT16_MAX ||
+        sym_sect->sh_size / sym_sect->sh_entsize > UINT32_MAX)
+    {
+        return ELFPARSER_ERR_RANGE;  // Invalid string table link or entry geometry
+    }
+    const elfparser_secthead_entry_t *str_sect = &sect_head->table[sym_sect->sh_link];
+    if (sym_sect->sh_offset > map_size || sym_sect->sh_size > map_size - sym_sect->sh_offset ||
+        str_sect->sh_offset > map_size || str_sect->sh_size > map_size - str_sect->sh_offset)
+    {
+        return ELFPARSER_ERR_SIZE;  // A table lies outside the map
+    }
+
+    cursor->sym_map = (const uint8_t *)map + sym_sect->sh_offset;
+    cursor->str_map = (const char *)map + str_sect->sh_offset;
+    cursor->str_size = str_sect->sh_size;
+    cursor->elf_class = sect_head->elf_class;
+    cursor->elf_data = sect_head->elf_data;
+    cursor->table_len = (uint32_t)(sym_sect->sh_size / sym_sect->sh_entsize);
+    cursor->entry_size = (uint16_t)sym_sect->sh_entsize;
+    cursor->next_idx = 0;
+    cursor->type_mask = ELFPARSER_SYMCURSOR_ANY;
+    cursor->bind_mask = ELFPARSER_SYMCURSOR_ANY;
+    cursor->sect_idx = ELFPARSER_SYMCURSOR_SECT_ANY;
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Sets the filters applied by ElfParser_SymCursor_next()
+ * @param[in,out] cursor Pointer to the cursor structure
+ * @param[in] type_mask Accepted symbol types, ELFPARSER_SYMCURSOR_ANY for all
+ * @param[in] bind_mask Accepted symbol bindings, ELFPARSER_SYMCURSOR_ANY for all
+ * @param[in] sect_idx Accepted section index, ELFPARSER_SYMCURSOR_SECT_ANY for all
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if cursor is NULL
+ */
+int ElfParser_SymCursor_filterSet(elfparser_symcursor_t *cursor, uint16_t type_mask, uint16_t bind_mask, uint32_t sect_idx)
+{
+    if (!cursor)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+
+    cursor->type_mask = type_mask;
+    cursor->bind_mask = bind_mask;
+    cursor->sect_idx = sect_idx;
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Moves the cursor to an entry index
+ * @param[in,out] cursor Pointer to the cursor structure
+ * @param[in] sym_idx Index of the next entry to decode (table_len ends the walk)
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if cursor is NULL,
+ *             ELFPARSER_ERR_RANGE if sym_idx is past the end of the table
+ */
+int ElfParser_SymCursor_seek(elfparser_symcursor_t *cursor, uint32_t sym_idx)
+{
+    if (!cursor)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    if (sym_idx > cursor->table_len)
+    {
+        return ELFPARSER_ERR_RANGE;  // Past the end
+    }
+
+    cursor->next_idx = sym_idx;
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Checks a decoded entry against the cursor filters
+ * @param[in] cursor Pointer to the cursor structure
+ * @param[in] entry Decoded entry
+ * @return int 1 if the entry passes, 0 otherwise
+ */
+static inline int SymCursor_filterPass(const elfparser_symcursor_t *cursor, const elfparser_symtable_entry_t *entry)
+{
+    return (cursor->type_mask == ELFPARSER_SYMCURSOR_ANY || (cursor->type_mask & ELFPARSER_SYMCURSOR_MASK(entry->sym_type))) &&
+           (cursor->bind_mask == ELFPARSER_SYMCURSOR_ANY || (cursor->bind_mask & ELFPARSER_SYMCURSOR_MASK(entry->sym_bind))) &&
+           (cursor->sect_idx == ELFPARSER_SYMCURSOR_SECT_ANY || cursor->sect_idx == entry->sym_sect_idx);
+}
+
+/**
+ * @brief Decodes the next batch of entries that pass the filters
+ * @param[in,out] cursor Pointer to the cursor structure
+ * @param[out] batch Destination array of batch_len entries
+ * @param[out] sym_idx Optional destination array of batch_len table indices of the returned entries
+ * @param[in] batch_len Capacity of batch
+ * @return int64_t Number of entries returned (0 once the table is exhausted), ELFPARSER_ERR_NULL if inputs are NULL,
+ *                 ELFPARSER_ERR_SIZE if the next passing entry has a name outside the string table (the cursor
+ *                 is left after it), ELFPARSER_ERR_CLASS if class or endianness is invalid
+ */
+int64_t ElfParser_SymCursor_next(elfparser_symcursor_t *cursor, elfparser_symtable_entry_t *batch, uint32_t *sym_idx, size_t batch_len)
+{
+    if (!cursor || !batch || !cursor->sym_map)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+
+    size_t kept = 0;
+    while (kept < batch_len && cursor->next_idx < cursor->table_len)
+    {
+        size_t run = cursor->table_len - cursor->next_idx;
+        run = (run < batch_len - kept) ? run : batch_len - kept;  // Decode only what the batch can hold
+        size_t offset = (size_t)cursor->next_idx * cursor->entry_size;
+        uint32_t unused_max = 0;
+        int ret = ElfParser_SymTable_entriesDecode(&batch[kept], cursor->sym_map + offset,
+                                                   (size_t)cursor->table_len * cursor->entry_size - offset, run,
+                                                   cursor->entry_size, cursor->elf_class, cursor->elf_data, &unused_max);
+        if (ret < 0)
+        {
+            return ret;  // Invalid class or endianness
+        }
+
+        size_t decoded_end = kept + run;
+        uint32_t first_idx = cursor->next_idx;
+        for (size_t i = kept; i < decoded_end; i++)  // Compact passing entries to the front
+        {
+            elfparser_symtable_entry_t *entry = &batch[i];
+            if (!SymCursor_filterPass(cursor, entry))
+            {
+                continue;
+            }
+            int64_t name_len = -1;
+            if (entry->sym_name_idx < cursor->str_size)
+            {
+                name_len = ElfParser_strLenBounded(&cursor->str_map[entry->sym_name_idx], cursor->str_size - entry->sym_name_idx);
+            }
+            if (name_len < 0)  // Name outside the string table or not terminated inside it
+            {
+                uint32_t bad_idx = first_idx + (uint32_t)(i - (decoded_end - run));
+                if (kept)
+                {
+                    cursor->next_idx = bad_idx;  // Return what passed so far; the next call reports this entry
+                    return (int64_t)kept;
+                }
+                cursor->next_idx = bad_idx + 1;  // Step past the bad entry so the walk can go on
+                return ELFPARSER_ERR_SIZE;
+            }
+            entry->sym_name = &cursor->str_map[entry->sym_name_idx];
+            entry->sym_name_len = (uint32_t)name_len;
+            if (sym_idx)
+            {
+                sym_idx[kept] = first_idx + (uint32_t)(i - (decoded_end - run));
+            }
+            if (i != kept)
+            {
+                batch[kept] = *entry;
+            }
+            kept++;
+        }
+        cursor->next_idx += (uint32_t)run;
+    }
+    return (int64_t)kept;
+}
@@ -0,0 +1,148 @@
+/**
+ * @file elfparser_symindex.c
+ * @brief Symbol name hash index functions for libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This file implements an open-addressing hash index over the resolved names of
+ * a symbol table. Each distinct name occupies one slot holding its hash and the
+ * lowest matching symbol index; further symbols with the same name are linked
+ * in ascending order through next_idx, which keeps the start_idx iteration
+ * semantics of ElfParser_SymTable_byNameFind().
+ */
+
+#include "../inc_pub/elfparser_symindex.h"
+#include "../inc_priv/elfparser_memmanip_priv.h"
+#include <stdlib.h>
+
+#define SYMINDEX_IDX_NONE UINT32_MAX /**< Terminator of a same-name chain */
+
+/**
+ * @brief Builds a name hash index over a parsed and name-resolved symbol table
+ * @param[out] symbol_index Pointer to the index structure to populate
+ * @param[in] symbol_table Pointer to the symbol table; names must already be resolved
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs or the table are NULL,
+ *             ELFPARSER_ERR_RANGE if the table is too large to index, ELFPARSER_ERR_MALLOC if allocation fails
+ */
+int ElfParser_SymIndex_build(elfparser_symindex_t *symbol_index, const elfparser_symtable_t *symbol_table)
+{
+    if (!symbol_index || !symbol_table || !symbol_table->table)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    size_t table_len = symbol_table->table_len;
+    if (table_len > (1u << 30))
+    {
+        return ELFPARSER_ERR_RANGE;  // Slot count would pass 2^31 and wrap when doubled
+    }
+
+    uint32_t slot_num = 16;  // Keep the load factor at or below one half
+    while (slot_num < table_len * 2)
+    {
+        slot_num <<= 1;
+    }
+    symbol_index->symbol_table = symbol_table;
+    symbol_index->table_len = (uint32_t)table_len;
+    symbol_index->slot_mask = slot_num - 1;
+    symbol_index->slots = calloc(slot_num, sizeof(elfparser_symindex_slot_t));
+    symbol_index->next_idx = malloc((table_len ? table_len : 1) * sizeof(uint32_t));
+    uint32_t *tail_idx = malloc(slot_num * sizeof(uint32_t));  // Last chained symbol per slot, build only
+    if (!symbol_index->slots || !symbol_index->next_idx || !tail_idx)
+    {
+        free(tail_idx);
+        ElfParser_SymIndex_free(symbol_index);
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+
+    for (uint32_t i = 0; i < table_len; i++)  // Insert symbols in ascending order
+    {
+        const char *name = symbol_table->table[i].sym_name;
+        symbol_index->next_idx[i] = SYMINDEX_IDX_NONE;
+        if (!name)
+        {
+            continue;  // Unresolved names cannot be looked up
+        }
+        uint32_t hash = ElfParser_gnuHash(name);
+        uint32_t slot = hash & symbol_index->slot_mask;
+        while (symbol_index->slots[slot].head_idx != 0)  // Linear probing
+        {
+            elfparser_symindex_slot_t *cur = &symbol_index->slots[slot];
+            if (cur->hash == hash && ElfParser_strCmp(symbol_table->table[cur->head_idx - 1].sym_name, name) == 0)
+            {
+                break;  // Same name already present
+            }
+            slot = (slot + 1) & symbol_index->slot_mask;
+        }
+        if (symbol_index->slots[slot].head_idx == 0)
+        {
+            symbol_index->slots[slot].hash = hash;  // New name, becomes chain head
+            symbol_index->slots[slot].head_idx = i + 1;
+        }
+        else
+        {
+            symbol_index->next_idx[tail_idx[slot]] = i;  // Duplicate name, append to chain
+        }
+        tail_idx[slot] = i;
+    }
+    free(tail_idx);
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Finds a symbol by name through the hash index
+ * @param[in] symbol_index Pointer to the index structure
+ * @param[in] name Name of the symbol to find
+ * @param[in] start_idx Starting index for the search
+ * @return int32_t Lowest index >= start_idx whose name matches, ELFPARSER_ERR_NOT_FOUND if none,
+ *                 ELFPARSER_ERR_NULL if inputs are NULL, ELFPARSER_ERR_RANGE if start_idx is out of bounds
+ */
+int32_t ElfParser_SymIndex_byNameFind(const elfparser_symindex_t *symbol_index, const char *name, size_t start_idx)
+{
+    if (!symbol_index || !name || !symbol_index->slots)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    if (symbol_index->table_len <= start_idx)
+    {
+        return ELFPARSER_ERR_RANGE;  // Invalid start index
+    }
+
+    const elfparser_symtable_entry_t *table = symbol_index->symbol_table->table;
+    uint32_t hash = ElfParser_gnuHash(name);
+    uint32_t slot = hash & symbol_index->slot_mask;
+    while (symbol_index->slots[slot].head_idx != 0)  // Probe until an empty slot
+    {
+        const elfparser_symindex_slot_t *cur = &symbol_index->slots[slot];
+        if (cur->hash == hash && ElfParser_strCmp(table[cur->head_idx - 1].sym_name, name) == 0)
+        {
+            uint32_t idx = cur->head_idx - 1;
+            while (idx != SYMINDEX_IDX_NONE && idx < start_idx)  // Skip matches before start_idx
+            {
+                idx = symbol_index->next_idx[idx];
+            }
+            return (idx == SYMINDEX_IDX_NONE) ? ELFPARSER_ERR_NOT_FOUND : (int32_t)idx;
+        }
+        slot = (slot + 1) & symbol_index->slot_mask;
+    }
+    return ELFPARSER_ERR_NOT_FOUND;  // Not found
+}
+
+/**
+ * @brief Frees the resources held by a symbol name hash index
+ * @param[in,out] symbol_index Pointer to the index structure to free
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if symbol_index is NULL
+ */
+int ElfParser_SymIndex_free(elfparser_symindex_t *symbol_index)
+{
+    if (!symbol_index)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    free(symbol_index->slots);     // Safe to free NULL
+    free(symbol_index->next_idx);
+    symbol_index->slots = NULL;
+    symbol_index->next_idx = NULL;
+    symbol_index->table_len = 0;
+    return ELFPARSER_SUCCESS;  // Success
+}
@@ -14,6 +14,10 @@
 #include "../inc_priv/elfparser_symtable_priv.h"
 #include "../inc_pub/elfparser_secthead.h"
 #include "../inc_priv/elfparser_memmanip_priv.h"
+#include "../inc_priv/elfparser_bswap_priv.h"
+#include "../inc_priv/elfparser_thread_priv.h"
+#include "../inc_priv/elfparser_alloc_priv.h"
+#include "../inc_priv/elfparser_stats_priv.h"
 #include "../inc_pub/elfparser_symtable.h"
 #include <stdlib.h>
 
@@ -24,11 +28,21 @@
  * @param[in] symbol_table_sect_idx Index of the symbol table section in sect_head
  * @param[in] header Pointer to the ELF header containing class and endianness
  * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
- *             ELFPARSER_ERR_RANGE if symbol_table_sect_idx is invalid,
- *             ELFPARSER_ERR_NOT_FOUND if string table not found,
- *             ELFPARSER_ERR_MALLOC if memory allocation fails
+ *             ELFPARSER_ERR_RANGE if symbol_table_sect_idx or sh_link is invalid or the entry geometry does not fit,
+ *             ELFPARSER_ERR_FORMAT if the section is not SHT_SYMTAB/SHT_DYNSYM, its link is not a string table
+ *             or it holds more than INT32_MAX entries, ELFPARSER_ERR_MALLOC if memory allocation fails
  */
-int ElfParser_SymTable_structSetup(elfparser_symtable_t *symbol_table, const elfparser_secthead_t *sect_head, uint16_t symbol_table_sect_idx, const elfparser_header_t *header)
+int ElfParser_SymTable_structSetup(elfparser_symtable_t *symbol_table, const elfparser_secthead_t *sect_head, uint32_t symbol_table_sect_idx, const elfparser_header_t *header)
+{
+    return ElfParser_SymTable_structSetupAlloc(symbol_table, sect_head, symbol_table_sect_idx, header, NULL);  // Plain malloc
+}
+
+/**
+ * @brief Body of ElfParser_SymTable_structSetupAlloc(), run with or without an open span
+ * @return int See ElfParser_SymTable_structSetupAlloc()
+ */
+static int SymTable_structSetupRun(elfparser_symtable_t *symbol_table, const elfparser_secthead_t *sect_head, uint32_t symbol_table_sect_idx,
+                                   const elfparser_header_t *header, const elfparser_alloc_t *alloc)
 {
     if (!symbol_table || !sect_head || !header)
     {
@@ -39,22 +53,38 @@ int ElfParser_SymTable_structSetup(elfparser_symtable_t *symbol_table, const elf
         return ELFPARSER_ERR_RANGE;  // Invalid section index
     }
 
-    symbol_table->elf_class = header->elf_ident.elf_class;  // Set ELF class
-    symbol_table->elf_data = header->elf_ident.elf_data;    // Set endianness
-    symbol_table->entry_size = sect_head->table[symbol_table_sect_idx].sh_entsize; // Size of each entry
-    symbol_table->table_len = sect_head->table[symbol_table_sect_idx].sh_size / symbol_table->entry_size; // Number of entries
-    int32_t temp = ElfParser_SectHead_byNameFind(sect_head, SYMTABLE_STRING_SECT_NAME, 0); // Find string table
-    if (temp == ELFPARSER_ERR_NOT_FOUND)
+    const elfparser_secthead_entry_t *sym_sect = &sect_head->table[symbol_table_sect_idx];
+    if (sym_sect->sh_type != ELFPARSER_SECTHEAD_TYPE_SYMTAB && sym_sect->sh_type != ELFPARSER_SECTHEAD_TYPE_DYNSYM)
     {
-        return ELFPARSER_ERR_NOT_FOUND;  // String table not found
+        return ELFPARSER_ERR_FORMAT;  // Not a symbol table
     }
-    if (temp < 0)  // Other errors from SectHead_byNameFind
+    if (sym_sect->sh_entsize == 0 || sym_sect->sh_entsize > UINT16_MAX)
     {
-        return temp;  // Propagate error
+        return ELFPARSER_ERR_RANGE;  // Entry size missing or out of range
     }
-    symbol_table->string_table_idx = (uint16_t)temp;  // Set string table index
+    if (sym_sect->sh_size / sym_sect->sh_entsize > INT32_MAX)
+    {
+        return ELFPARSER_ERR_FORMAT;  // Indices would collide with the error codes of the find functions
+    }
+    if (sym_sect->sh_link == 0 || sym_sect->sh_link >= sect_head->table_len)
+    {
+        return ELFPARSER_ERR_RANGE;  // Invalid string table link
+    }
+    if (sect_head->table[sym_sect->sh_link].sh_type != ELFPARSER_SECTHEAD_TYPE_STRINGTAB)
+    {
+        return ELFPARSER_ERR_FORMAT;  // Linked section holds no strings
+    }
+
+    symbol_table->elf_class = header->elf_ident.elf_class;  // Set ELF class
+    symbol_table->elf_data = header->elf_ident.elf_data;    // Set endianness
+    symbol_table->entry_size = (uint16_t)sym_sect->sh_entsize; // Size of each entry
+    symbol_table->table_len = (uint32_t)(sym_sect->sh_size / symbol_table->entry_size); // Number of entries
+    symbol_table->string_table_idx = sym_sect->sh_link; // .strtab for .symtab, .dynstr for .dynsym
     symbol_table->max_idx = 0;                        // Initialize max name index
-    symbol_table->table = malloc(symbol_table->table_len * sizeof(elfparser_symtable_entry_t)); // Allocate table
+    symbol_table->name_mode = ELFPARSER_NAME_MODE_OWNED; // Names are copied unless resolved as views
+    symbol_table->name_arena = NULL;                  // No name block yet
+    symbol_table->alloc = alloc;                      // Allocator of the table and names
+    symbol_table->table = ElfParser_allocMalloc(alloc, ((size_t)symbol_table->table_len ? symbol_table->table_len : 1) * sizeof(elfparser_symtable_entry_t)); // Allocate table
     if (!symbol_table->table)
     {
         return ELFPARSER_ERR_MALLOC;  // Allocation failure
@@ -63,14 +93,195 @@ int ElfParser_SymTable_structSetup(elfparser_symtable_t *symbol_table, const elf
 }
 
 /**
- * @brief Parses the symbol table from a memory map
- * @param[out] symbol_table Pointer to the symbol table structure to populate
- * @param[in] map Pointer to the memory-mapped ELF file
- * @param[in] map_size Size of the memory map in bytes
+ * @brief Sets up the symbol table structure, allocating the table and names through an allocator
+ * @param[out] symbol_table Pointer to the symbol table structure to initialize
+ * @param[in] sect_head Pointer to the section header structure
+ * @param[in] symbol_table_sect_idx Index of the symbol table section in sect_head
+ * @param[in] header Pointer to the ELF header containing class and endianness
+ * @param[in] alloc Allocator used until ElfParser_SymTable_free(), NULL for malloc
  * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
- *             ELFPARSER_ERR_SIZE if size is insufficient, ELFPARSER_ERR_CLASS if class or endianness is invalid
+ *             ELFPARSER_ERR_RANGE if symbol_table_sect_idx or sh_link is invalid or the entry geometry does not fit,
+ *             ELFPARSER_ERR_FORMAT if the section is not SHT_SYMTAB/SHT_DYNSYM, its link is not a string table
+ *             or it holds more than INT32_MAX entries, ELFPARSER_ERR_MALLOC if memory allocation fails
  */
-int ElfParser_SymTable_parse(elfparser_symtable_t *symbol_table, const void *map, size_t map_size)
+int ElfParser_SymTable_structSetupAlloc(elfparser_symtable_t *symbol_table, const elfparser_secthead_t *sect_head, uint32_t symbol_table_sect_idx,
+                                        const elfparser_header_t *header, const elfparser_alloc_t *alloc)
+{
+    if (!ElfParser_statsActive())
+    {
+        return SymTable_structSetupRun(symbol_table, sect_head, symbol_table_sect_idx, header, alloc);  // Nothing registered
+    }
+    elfparser_span_t span;
+    ElfParser_statsBegin(&span, ELFPARSER_PHASE_SYMTABLE);
+    int ret = SymTable_structSetupRun(symbol_table, sect_head, symbol_table_sect_idx, header, alloc);
+    ElfParser_statsEnd(&span, ret, 0, 0);
+    return ret;
+}
+
+/**
+ * @brief Decodes consecutive symbol table entries for one class and endianness
+ *
+ * Always inlined into the four layout-specific decoders below, so the field
+ * offsets, widths and byte order are compile-time constants in each of them.
+ *
+ * @param[out] entries Destination array of at least count entries
+ * @param[in] src Pointer to the first raw entry
+ * @param[in] count Number of entries to decode
+ * @param[in] entry_size Distance between raw entries in bytes
+ * @param[in,out] max_idx Raised to the largest st_name encountered
+ * @param[in] is_64bit Non-zero for the 64-bit layout
+ * @param[in] big_endian Non-zero for big-endian data
+ */
+static inline __attribute__((always_inline)) void SymTable_entriesKernel(elfparser_symtable_entry_t *entries, const uint8_t *src,
+                                                                         size_t count, size_t entry_size, uint32_t *max_idx,
+                                                                         const int is_64bit, const int big_endian)
+{
+    uint32_t max = *max_idx;
+
+    for (size_t i = 0; i < count; i++, src += entry_size)  // One fixed-layout entry per iteration
+    {
+        elfparser_symtable_entry_t *entry = &entries[i];
+        uint8_t info = src[is_64bit ? SYMTABLE_ENTRY_INFO_OFF_64BIT : SYMTABLE_ENTRY_INFO_OFF_32BIT];
+        entry->sym_name = NULL;  // Initialize name pointer
+        entry->sym_name_len = 0;
+        entry->sym_name_idx = ElfParser_load32(src + SYMTABLE_ENTRY_NAMEIDX_OFF, big_endian);
+        entry->sym_bind = info >> 4u;   // Binding from the high nibble of st_info
+        entry->sym_type = info & 0x0fu; // Type from the low nibble of st_info
+        entry->sym_visibility = src[is_64bit ? SYMTABLE_ENTRY_OTHER_OFF_64BIT : SYMTABLE_ENTRY_OTHER_OFF_32BIT];
+        entry->sym_sect_idx = ElfParser_load16(src + (is_64bit ? SYMTABLE_ENTRY_SECTIDX_OFF_64BIT : SYMTABLE_ENTRY_SECTIDX_OFF_32BIT), big_endian);
+        if (is_64bit)
+        {
+            entry->sym_value = ElfParser_load64(src + SYMTABLE_ENTRY_VALUE_OFF_64BIT, big_endian);
+            entry->sym_size = ElfParser_load64(src + SYMTABLE_ENTRY_SIZE_OFF_64BIT, big_endian);
+        }
+        else
+        {
+            entry->sym_value = ElfParser_load32(src + SYMTABLE_ENTRY_VALUE_OFF_32BIT, big_endian);
+            entry->sym_size = ElfParser_load32(src + SYMTABLE_ENTRY_SIZE_OFF_32BIT, big_endian);
+        }
+        max = (entry->sym_name_idx > max) ? entry->sym_name_idx : max;  // Track max name index
+    }
+    *max_idx = max;
+}
+
+/**
+ * @brief Decodes big-endian symbol table entries through the bulk byte-swap
+ *
+ * Canonically sized entries are swapped into host order one stack-sized chunk
+ * at a time and decoded by the little-endian kernel while the chunk is still
+ * in L1; entries the swap leaves over (a partial period, no SIMD support or a
+ * non-canonical entry_size) go through the scalar big-endian kernel.
+ *
+ * @param[out] entries Destination array of at least count entries
+ * @param[in] src Pointer to the first raw entry
+ * @param[in] count Number of entries to decode
+ * @param[in] entry_size Distance between raw entries in bytes
+ * @param[in,out] max_idx Raised to the largest name index encountered
+ * @param[in] is_64bit Non-zero for the 64-bit layout
+ */
+static inline __attribute__((always_inline)) void SymTable_swappedDecode(elfparser_symtable_entry_t *entries, const uint8_t *src, size_t count,
+                                                                         size_t entry_size, uint32_t *max_idx, const int is_64bit)
+{
+    const size_t canon_size = is_64bit ? ELFPARSER_BSWAP_SYM_SIZE_64BIT : ELFPARSER_BSWAP_SYM_SIZE_32BIT;
+    const size_t chunk_num = (ELFPARSER_BSWAP_CHUNK_SIZE / canon_size) / ELFPARSER_BSWAP_PERIOD_MAX * ELFPARSER_BSWAP_PERIOD_MAX;
+    uint8_t chunk[ELFPARSER_BSWAP_CHUNK_SIZE] __attribute__((aligned(32)));  // Host-order copy of the current chunk
+
+    while (entry_size == canon_size && count > 0)
+    {
+        size_t num = (count < chunk_num) ? count : chunk_num;
+        size_t done = ElfParser_bswapEntries(chunk, src, num, is_64bit ? ELFPARSER_BSWAP_LAYOUT_SYM_64BIT : ELFPARSER_BSWAP_LAYOUT_SYM_32BIT);
+        if (done == 0)
+        {
+            break;  // Left for the scalar kernel
+        }
+        SymTable_entriesKernel(entries, chunk, done, canon_size, max_idx, is_64bit, ELFPARSER_HOST_BIG_ENDIAN);
+        entries += done;
+        src += done * canon_size;
+        count -= done;
+    }
+    SymTable_entriesKernel(entries, src, count, entry_size, max_idx, is_64bit, 1);  // Tail or fallback
+}
+
+/* Layout-specific symbol decoders (32/64-bit x little/big-endian) */
+static void SymTable_decode32Le(elfparser_symtable_entry_t *entries, const uint8_t *src, size_t count, size_t entry_size, uint32_t *max_idx)
+{
+    SymTable_entriesKernel(entries, src, count, entry_size, max_idx, 0, 0);
+}
+static void SymTable_decode32Be(elfparser_symtable_entry_t *entries, const uint8_t *src, size_t count, size_t entry_size, uint32_t *max_idx)
+{
+    SymTable_swappedDecode(entries, src, count, entry_size, max_idx, 0);
+}
+static void SymTable_decode64Le(elfparser_symtable_entry_t *entries, const uint8_t *src, size_t count, size_t entry_size, uint32_t *max_idx)
+{
+    SymTable_entriesKernel(entries, src, count, entry_size, max_idx, 1, 0);
+}
+static void SymTable_decode64Be(elfparser_symtable_entry_t *entries, const uint8_t *src, size_t count, size_t entry_size, uint32_t *max_idx)
+{
+    SymTable_swappedDecode(entries, src, count, entry_size, max_idx, 1);
+}
+
+/**
+ * @brief Decodes consecutive raw symbol table entries
+ * @param[out] entries Destination array of at least count entries
+ * @param[in] src Pointer to the first raw entry
+ * @param[in] src_size Number of bytes available at src
+ * @param[in] count Number of entries to decode
+ * @param[in] entry_size Distance between raw entries in bytes
+ * @param[in] elf_class ELF class of the raw entries
+ * @param[in] elf_data Data encoding of the raw entries
+ * @param[in,out] max_idx Raised to the largest st_name encountered
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_SIZE if an entry lies outside src, ELFPARSER_ERR_CLASS if class or endianness is invalid
+ */
+int ElfParser_SymTable_entriesDecode(elfparser_symtable_entry_t *entries, const void *src, size_t src_size, size_t count,
+                                     size_t entry_size, elfparser_header_class_e elf_class,
+                                     elfparser_header_data_e elf_data, uint32_t *max_idx)
+{
+    if (!entries || !src || !max_idx)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+
+    size_t layout_size;  // Bytes one entry occupies in this class
+    void (*decode)(elfparser_symtable_entry_t *, const uint8_t *, size_t, size_t, uint32_t *);  // Hoisted dispatch
+    int big_endian = (elf_data == ELFPARSER_HEADER_DATA_BIG_ENDIANNESS);
+    if (elf_data != ELFPARSER_HEADER_DATA_LITTLE_ENDIANNESS && !big_endian)
+    {
+        return ELFPARSER_ERR_CLASS;  // Invalid endianness
+    }
+    if (elf_class == ELFPARSER_HEADER_CLASS_32_BIT)
+    {
+        layout_size = SYMTABLE_ENTRY_SECTIDX_OFF_32BIT + SYMTABLE_ENTRY_SECTIDX_SIZE;
+        decode = big_endian ? SymTable_decode32Be : SymTable_decode32Le;
+    }
+    else if (elf_class == ELFPARSER_HEADER_CLASS_64_BIT)
+    {
+        layout_size = SYMTABLE_ENTRY_SIZE_OFF_64BIT + SYMTABLE_ENTRY_SIZE_SIZE_64BIT;
+        decode = big_endian ? SymTable_decode64Be : SymTable_decode64Le;
+    }
+    else
+    {
+        return ELFPARSER_ERR_CLASS;  // Invalid class
+    }
+    if (count == 0)
+    {
+        return ELFPARSER_SUCCESS;  // Nothing to decode
+    }
+    if (layout_size > src_size || (count - 1) > (src_size - layout_size) / (entry_size ? entry_size : 1))
+    {
+        ElfParser_statsErrorAt(src_size);
+        return ELFPARSER_ERR_SIZE;  // Last entry runs out of the source
+    }
+
+    decode(entries, src, count, entry_size, max_idx);
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Body of ElfParser_SymTable_parse(), run with or without an open span
+ * @return int See ElfParser_SymTable_parse()
+ */
+static int SymTable_parseRun(elfparser_symtable_t *symbol_table, const void *map, size_t map_size)
 {
     if (!symbol_table || !map)
     {
@@ -79,83 +290,302 @@ int ElfParser_SymTable_parse(elfparser_symtable_t *symbol_table, const void *map
     size_t required_size = (size_t)symbol_table->entry_size * symbol_table->table_len;
     if (map_size < required_size || required_size == 0)
     {
+        ElfParser_statsErrorAt(map_size);
         return ELFPARSER_ERR_SIZE;  // Insufficient size or invalid length
     }
 
-    const uint64_t mem_off_32bit[] = { SYMTABLE_ENTRY_NAMEIDX_OFF, SYMTABLE_ENTRY_INFO_OFF_32BIT, SYMTABLE_ENTRY_OTHER_OFF_32BIT, // 32-bit offsets
-                                       SYMTABLE_ENTRY_SECTIDX_OFF_32BIT, SYMTABLE_ENTRY_VALUE_OFF_32BIT, SYMTABLE_ENTRY_SIZE_OFF_32BIT };
-    const uint64_t mem_off_64bit[] = { SYMTABLE_ENTRY_NAMEIDX_OFF, SYMTABLE_ENTRY_INFO_OFF_64BIT, SYMTABLE_ENTRY_OTHER_OFF_64BIT, // 64-bit offsets
-                                       SYMTABLE_ENTRY_SECTIDX_OFF_64BIT, SYMTABLE_ENTRY_VALUE_OFF_64BIT, SYMTABLE_ENTRY_SIZE_OFF_64BIT };
-    const uint64_t mem_size_32bit[] = { SYMTABLE_ENTRY_NAMEIDX_SIZE, SYMTABLE_ENTRY_INFO_SIZE, SYMTABLE_ENTRY_OTHER_SIZE, // 32-bit sizes
-                                        SYMTABLE_ENTRY_SECTIDX_SIZE, SYMTABLE_ENTRY_VALUE_SIZE_32BIT, SYMTABLE_ENTRY_SIZE_SIZE_32BIT };
-    const uint64_t mem_size_64bit[] = { SYMTABLE_ENTRY_NAMEIDX_SIZE, SYMTABLE_ENTRY_INFO_SIZE, SYMTABLE_ENTRY_OTHER_SIZE, // 64-bit sizes
-                                        SYMTABLE_ENTRY_SECTIDX_SIZE, SYMTABLE_ENTRY_VALUE_SIZE_64BIT, SYMTABLE_ENTRY_SIZE_SIZE_64BIT };
+    return ElfParser_SymTable_entriesDecode(symbol_table->table, map, map_size, symbol_table->table_len,
+                                            symbol_table->entry_size, symbol_table->elf_class,
+                                            symbol_table->elf_data, &(symbol_table->max_idx));
+}
 
-    const uint64_t *mem_off, *mem_size;  // Selected offset and size arrays
-    if (symbol_table->elf_class == ELFPARSER_HEADER_CLASS_32_BIT)
+/**
+ * @brief Parses the symbol table from a memory map
+ * @param[out] symbol_table Pointer to the symbol table structure to populate
+ * @param[in] map Pointer to the memory-mapped ELF file
+ * @param[in] map_size Size of the memory map in bytes
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_SIZE if size is insufficient, ELFPARSER_ERR_CLASS if class or endianness is invalid
+ */
+int ElfParser_SymTable_parse(elfparser_symtable_t *symbol_table, const void *map, size_t map_size)
+{
+    if (!ElfParser_statsActive())
     {
-        mem_off = mem_off_32bit;
-        mem_size = mem_size_32bit;
+        return SymTable_parseRun(symbol_table, map, map_size);  // Nothing registered
     }
-    else if (symbol_table->elf_class == ELFPARSER_HEADER_CLASS_64_BIT)
+    elfparser_span_t span;
+    ElfParser_statsBegin(&span, ELFPARSER_PHASE_SYMTABLE);
+    int ret = SymTable_parseRun(symbol_table, map, map_size);
+    ElfParser_statsEnd(&span, ret, (ret < 0) ? 0 : (uint64_t)symbol_table->table_len * symbol_table->entry_size,
+                       (ret < 0) ? 0 : symbol_table->table_len);
+    return ret;
+}
+
+/**
+ * @brief Body of ElfParser_SymTable_shndxResolve(), run with or without an open span
+ * @return int See ElfParser_SymTable_shndxResolve()
+ */
+static int SymTable_shndxResolveRun(elfparser_symtable_t *symbol_table, const void *map, size_t map_size)
+{
+    if (!symbol_table || !map || !symbol_table->table)
     {
-        mem_off = mem_off_64bit;
-        mem_size = mem_size_64bit;
+        return ELFPARSER_ERR_NULL;  // Null pointer input
     }
-    else
+
+    const uint8_t *words = map;
+    size_t word_num = map_size / SYMTABLE_SHNDX_WORD_SIZE;  // One word per symbol
+    int big_endian = (symbol_table->elf_data == ELFPARSER_HEADER_DATA_BIG_ENDIANNESS);
+    for (size_t cnt = 0; cnt < symbol_table->table_len; cnt++)
     {
-        return ELFPARSER_ERR_CLASS;  // Invalid class
+        if (symbol_table->table[cnt].sym_sect_idx != ELFPARSER_SYMTABLE_SECT_XINDEX)
+        {
+            continue;  // Index fits st_shndx
+        }
+        if (cnt >= word_num)
+        {
+            ElfParser_statsErrorAt((uint64_t)cnt * SYMTABLE_SHNDX_WORD_SIZE);
+            return ELFPARSER_ERR_SIZE;  // Section shorter than the symbol table
+        }
+        symbol_table->table[cnt].sym_sect_idx = ElfParser_load32(words + cnt * SYMTABLE_SHNDX_WORD_SIZE, big_endian);
     }
+    return ELFPARSER_SUCCESS;  // Success
+}
 
-    for (uint32_t i = 0; i < symbol_table->table_len; i++)  // Parse each symbol entry
+/**
+ * @brief Replaces SHN_XINDEX section indices with the values of the matching SHT_SYMTAB_SHNDX section
+ * @param[in,out] symbol_table Pointer to a parsed symbol table structure
+ * @param[in] map Pointer to the contents of the SHT_SYMTAB_SHNDX section linked to this table
+ * @param[in] map_size Size of the section contents in bytes
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_SIZE if an escaped entry has no word in map
+ */
+int ElfParser_SymTable_shndxResolve(elfparser_symtable_t *symbol_table, const void *map, size_t map_size)
+{
+    if (!ElfParser_statsActive())
     {
-        void *const ret_dest[SYMTABLE_ENTRY_LEN] = { // Static destination array
-            &(symbol_table->table[i].sym_name_idx), &(symbol_table->table[i].sym_type),
-            &(symbol_table->table[i].sym_visibility), &(symbol_table->table[i].sym_sect_idx),
-            &(symbol_table->table[i].sym_value), &(symbol_table->table[i].sym_size)
-        };
-        symbol_table->table[i].sym_name = NULL;  // Initialize name pointer only
+        return SymTable_shndxResolveRun(symbol_table, map, map_size);  // Nothing registered
+    }
+    elfparser_span_t span;
+    ElfParser_statsBegin(&span, ELFPARSER_PHASE_SYMTABLE);
+    int ret = SymTable_shndxResolveRun(symbol_table, map, map_size);
+    ElfParser_statsEnd(&span, ret, (ret < 0) ? 0 : (uint64_t)map_size,
+                       (ret < 0) ? 0 : symbol_table->table_len);
+    return ret;
+}
 
-        size_t base_offset = i * symbol_table->entry_size;
-        for (uint8_t j = 0; j < SYMTABLE_ENTRY_LEN; j++)  // Copy fields with bounds check
+/**
+ * @brief Duplicates the names of a range of entries from the string table
+ * @param[in] symbol_table Pointer to the symbol table structure
+ * @param[in] map Pointer to the string table
+ * @param[in] map_size Size of the string table in bytes
+ * @param[in] begin First entry to resolve
+ * @param[in] end One past the last entry to resolve
+ * @return int ELFPARSER_SUCCESS on success, or the error of the first failing entry
+ */
+static int SymTable_namesDup(const elfparser_symtable_t *symbol_table, const void *map, size_t map_size, size_t begin, size_t end)
+{
+    const char *char_map = map;  // Cast map to char pointer
+    for (size_t cnt = begin; cnt < end; cnt++)  // Resolve names
+    {
+        size_t name_idx = symbol_table->table[cnt].sym_name_idx;
+        if (name_idx >= map_size)  // Bounds check
         {
-            size_t offset = base_offset + mem_off[j];
-            if (offset + mem_size[j] > map_size)
-            {
-                return ELFPARSER_ERR_SIZE;  // Out of bounds
-            }
-            if (symbol_table->elf_data == ELFPARSER_HEADER_DATA_BIG_ENDIANNESS)
-            {
-                ElfParser_memRevCpy(ret_dest[j], map + offset, mem_size[j]);
-            }
-            else if (symbol_table->elf_data == ELFPARSER_HEADER_DATA_LITTLE_ENDIANNESS)
-            {
-                ElfParser_memCpy(ret_dest[j], map + offset, mem_size[j]);
-            }
-            else
-            {
-                return ELFPARSER_ERR_CLASS;  // Invalid endianness
-            }
+            ElfParser_statsErrorAt(name_idx);
+            return ELFPARSER_ERR_SIZE;
         }
-        if (symbol_table->table[i].sym_name_idx > symbol_table->max_idx)
+        char *name_dup = NULL;
+        int64_t dup_size = ElfParser_strDupAlloc(&char_map[name_idx], &name_dup, symbol_table->alloc);
+        if (dup_size < 0)
         {
-            symbol_table->max_idx = symbol_table->table[i].sym_name_idx;  // Update max name index
+            return ELFPARSER_ERR_MALLOC;  // String duplication failed
         }
-        symbol_table->table[i].sym_bind = symbol_table->table[i].sym_type >> 4u;  // Extract binding from st_info
-        symbol_table->table[i].sym_type &= 0x0f;  // Mask to get type from st_info
+        symbol_table->table[cnt].sym_name = name_dup;
+        symbol_table->table[cnt].sym_name_len = (uint32_t)(dup_size - 1);  // Size includes the terminator
     }
     return ELFPARSER_SUCCESS;  // Success
 }
 
+/**
+ * @brief Releases the names resolved so far in the table's current name mode
+ *
+ * Every name pointer is cleared afterwards, so no entry is left pointing into
+ * a freed block or a caller's map once the mode changes.
+ *
+ * @param[in,out] symbol_table Pointer to the symbol table structure
+ */
+static void SymTable_namesRelease(elfparser_symtable_t *symbol_table)
+{
+    const elfparser_alloc_t *alloc = symbol_table->alloc;
+    int owned = (symbol_table->name_mode == ELFPARSER_NAME_MODE_OWNED && ElfParser_allocFreesBlocks(alloc));  // Each name was duplicated separately
+    for (size_t cnt = 0; cnt < symbol_table->table_len; cnt++)  // Drop each name
+    {
+        if (owned)
+        {
+            ElfParser_allocFree(alloc, (void *)symbol_table->table[cnt].sym_name);  // Safe to free NULL
+        }
+        symbol_table->table[cnt].sym_name = NULL;
+        symbol_table->table[cnt].sym_name_len = 0;
+    }
+    if (symbol_table->name_mode == ELFPARSER_NAME_MODE_ARENA)  // All names share one block
+    {
+        ElfParser_allocFree(alloc, symbol_table->name_arena);
+        symbol_table->name_arena = NULL;
+    }
+}
+
+/**
+ * @brief Body of ElfParser_SymTable_nameResolve(), run with or without an open span
+ * @return int See ElfParser_SymTable_nameResolve()
+ */
+static int SymTable_nameResolveRun(elfparser_symtable_t *symbol_table, const void *map, size_t map_size)
+{
+    if (!symbol_table || !map)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    if (map_size <= symbol_table->max_idx)  // Check if map covers max index
+    {
+        ElfParser_statsErrorAt(map_size);
+        return ELFPARSER_ERR_SIZE;  // Insufficient size
+    }
+
+    SymTable_namesRelease(symbol_table);  // Names or block of an earlier resolve
+    symbol_table->name_mode = ELFPARSER_NAME_MODE_OWNED;  // Free releases each name from here on
+    return SymTable_namesDup(symbol_table, map, map_size, 0, symbol_table->table_len);
+}
+
 /**
  * @brief Resolves symbol names from the string table
- * @param[in] symbol_table Pointer to the symbol table structure
+ * @param[in,out] symbol_table Pointer to the symbol table structure
  * @param[in] map Pointer to the memory-mapped ELF file
  * @param[in] map_size Size of the memory map in bytes
  * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
  *             ELFPARSER_ERR_SIZE if map is too small, ELFPARSER_ERR_MALLOC if string duplication fails
  */
-int ElfParser_SymTable_nameResolve(const elfparser_symtable_t *symbol_table, const void *map, size_t map_size)
+int ElfParser_SymTable_nameResolve(elfparser_symtable_t *symbol_table, const void *map, size_t map_size)
+{
+    if (!ElfParser_statsActive())
+    {
+        return SymTable_nameResolveRun(symbol_table, map, map_size);  // Nothing registered
+    }
+    elfparser_span_t span;
+    ElfParser_statsBegin(&span, ELFPARSER_PHASE_NAMES);
+    int ret = SymTable_nameResolveRun(symbol_table, map, map_size);
+    ElfParser_statsEnd(&span, ret, (ret < 0) ? 0 : ElfParser_statsNameExtent(map, map_size, symbol_table->max_idx),
+                       (ret < 0) ? 0 : symbol_table->table_len);
+    return ret;
+}
+
+/**
+ * @brief Work shared by the chunks of a parallel parse or resolve
+ */
+typedef struct symtable_parallel_s
+{
+    elfparser_symtable_t*   symbol_table;   /**< Table being parsed or resolved */
+    const uint8_t*          map;            /**< Raw entries or string table */
+    size_t                  map_size;       /**< Size of map in bytes */
+    uint32_t*               chunk_max;      /**< Largest st_name of each chunk (parse only) */
+} symtable_parallel_t;
+
+/**
+ * @brief Decodes one chunk of entries for ElfParser_SymTable_parseParallel()
+ * @return int ELFPARSER_SUCCESS on success, or an ElfParser_Error code on failure
+ */
+static int SymTable_parseChunk(void *ctx, size_t chunk_idx, size_t begin, size_t end)
+{
+    symtable_parallel_t *job = ctx;
+    elfparser_symtable_t *symbol_table = job->symbol_table;
+    size_t offset = begin * symbol_table->entry_size;
+
+    job->chunk_max[chunk_idx] = 0;
+    return ElfParser_SymTable_entriesDecode(&symbol_table->table[begin], job->map + offset, job->map_size - offset, end - begin,
+                                            symbol_table->entry_size, symbol_table->elf_class, symbol_table->elf_data,
+                                            &(job->chunk_max[chunk_idx]));
+}
+
+/**
+ * @brief Resolves the names of one chunk of entries for ElfParser_SymTable_nameResolveParallel()
+ * @return int ELFPARSER_SUCCESS on success, or the error of the first failing entry of the chunk
+ */
+static int SymTable_resolveChunk(void *ctx, size_t chunk_idx, size_t begin, size_t end)
+{
+    symtable_parallel_t *job = ctx;
+
+    (void)chunk_idx;
+    return SymTable_namesDup(job->symbol_table, job->map, job->map_size, begin, end);
+}
+
+/**
+ * @brief Body of ElfParser_SymTable_parseParallel(), run with or without an open span
+ * @return int See ElfParser_SymTable_parseParallel()
+ */
+static int SymTable_parseParallelRun(elfparser_symtable_t *symbol_table, const void *map, size_t map_size, uint32_t thread_num)
+{
+    if (!symbol_table || !map)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    size_t required_size = (size_t)symbol_table->entry_size * symbol_table->table_len;
+    if (map_size < required_size || required_size == 0)
+    {
+        ElfParser_statsErrorAt(map_size);
+        return ELFPARSER_ERR_SIZE;  // Insufficient size or invalid length
+    }
+    uint32_t unused_max = 0;
+    int ret = ElfParser_SymTable_entriesDecode(symbol_table->table, map, map_size, 0, symbol_table->entry_size,
+                                               symbol_table->elf_class, symbol_table->elf_data, &unused_max);
+    if (ret < 0)
+    {
+        return ret;  // Invalid class or endianness, reported before any thread starts
+    }
+
+    size_t chunk_num = ElfParser_chunkNum(symbol_table->table_len, SYMTABLE_PARALLEL_CHUNK_SIZE);
+    symtable_parallel_t job = { symbol_table, map, map_size, calloc(chunk_num, sizeof(uint32_t)) };
+    if (!job.chunk_max)
+    {
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+    ret = ElfParser_parallelFor(symbol_table->table_len, SYMTABLE_PARALLEL_CHUNK_SIZE, thread_num, SymTable_parseChunk, &job);
+    if (ret == ELFPARSER_SUCCESS)
+    {
+        for (size_t i = 0; i < chunk_num; i++)  // Merge per-chunk maxima
+        {
+            symbol_table->max_idx = (job.chunk_max[i] > symbol_table->max_idx) ? job.chunk_max[i] : symbol_table->max_idx;
+        }
+    }
+    free(job.chunk_max);
+    return ret;
+}
+
+/**
+ * @brief Parses the symbol table from a memory map on several threads
+ * @param[out] symbol_table Pointer to the symbol table structure to populate
+ * @param[in] map Pointer to the memory-mapped ELF file
+ * @param[in] map_size Size of the memory map in bytes
+ * @param[in] thread_num Number of threads to use, 0 for one per online CPU
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_SIZE if size is insufficient, ELFPARSER_ERR_CLASS if class or endianness is invalid,
+ *             ELFPARSER_ERR_MALLOC if the work state cannot be allocated
+ */
+int ElfParser_SymTable_parseParallel(elfparser_symtable_t *symbol_table, const void *map, size_t map_size, uint32_t thread_num)
+{
+    if (!ElfParser_statsActive())
+    {
+        return SymTable_parseParallelRun(symbol_table, map, map_size, thread_num);  // Nothing registered
+    }
+    elfparser_span_t span;
+    ElfParser_statsBegin(&span, ELFPARSER_PHASE_SYMTABLE);
+    int ret = SymTable_parseParallelRun(symbol_table, map, map_size, thread_num);
+    ElfParser_statsEnd(&span, ret, (ret < 0) ? 0 : (uint64_t)symbol_table->table_len * symbol_table->entry_size,
+                       (ret < 0) ? 0 : symbol_table->table_len);
+    return ret;
+}
+
+/**
+ * @brief Body of ElfParser_SymTable_nameResolveParallel(), run with or without an open span
+ * @return int See ElfParser_SymTable_nameResolveParallel()
+ */
+static int SymTable_nameResolveParallelRun(elfparser_symtable_t *symbol_table, const void *map, size_t map_size, uint32_t thread_num)
 {
     if (!symbol_table || !map)
     {
@@ -163,25 +593,171 @@ int ElfParser_SymTable_nameResolve(const elfparser_symtable_t *symbol_table, con
     }
     if (map_size <= symbol_table->max_idx)  // Check if map covers max index
     {
+        ElfParser_statsErrorAt(map_size);
+        return ELFPARSER_ERR_SIZE;  // Insufficient size
+    }
+
+    if (!ElfParser_allocThreadSafe(symbol_table->alloc))
+    {
+        thread_num = 1;  // Allocator must not be entered from several threads
+    }
+    SymTable_namesRelease(symbol_table);  // Names or block of an earlier resolve
+    symbol_table->name_mode = ELFPARSER_NAME_MODE_OWNED;  // Free releases each name from here on
+    symtable_parallel_t job = { symbol_table, map, map_size, NULL };
+    return ElfParser_parallelFor(symbol_table->table_len, SYMTABLE_PARALLEL_CHUNK_SIZE, thread_num, SymTable_resolveChunk, &job);
+}
+
+/**
+ * @brief Resolves symbol names from the string table on several threads
+ * @param[in,out] symbol_table Pointer to the symbol table structure
+ * @param[in] map Pointer to the memory-mapped ELF file
+ * @param[in] map_size Size of the memory map in bytes
+ * @param[in] thread_num Number of threads to use, 0 for one per online CPU
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_SIZE if map is too small, ELFPARSER_ERR_MALLOC if string duplication fails
+ */
+int ElfParser_SymTable_nameResolveParallel(elfparser_symtable_t *symbol_table, const void *map, size_t map_size, uint32_t thread_num)
+{
+    if (!ElfParser_statsActive())
+    {
+        return SymTable_nameResolveParallelRun(symbol_table, map, map_size, thread_num);  // Nothing registered
+    }
+    elfparser_span_t span;
+    ElfParser_statsBegin(&span, ELFPARSER_PHASE_NAMES);
+    int ret = SymTable_nameResolveParallelRun(symbol_table, map, map_size, thread_num);
+    ElfParser_statsEnd(&span, ret, (ret < 0) ? 0 : ElfParser_statsNameExtent(map, map_size, symbol_table->max_idx),
+                       (ret < 0) ? 0 : symbol_table->table_len);
+    return ret;
+}
+
+/**
+ * @brief Body of ElfParser_SymTable_nameResolveView(), run with or without an open span
+ * @return int See ElfParser_SymTable_nameResolveView()
+ */
+static int SymTable_nameResolveViewRun(elfparser_symtable_t *symbol_table, const void *map, size_t map_size)
+{
+    if (!symbol_table || !map || !symbol_table->table)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    if (map_size <= symbol_table->max_idx)  // Check if map covers max index
+    {
+        ElfParser_statsErrorAt(map_size);
         return ELFPARSER_ERR_SIZE;  // Insufficient size
     }
 
     const char *char_map = map;  // Cast map to char pointer
-    for (size_t cnt = 0; cnt < symbol_table->table_len; cnt++)  // Resolve names
+    if (ElfParser_strLenBounded(&char_map[symbol_table->max_idx], map_size - symbol_table->max_idx) < 0)
+    {
+        ElfParser_statsErrorAt(map_size);
+        return ELFPARSER_ERR_SIZE;  // Highest name not terminated inside the map
+    }
+
+    SymTable_namesRelease(symbol_table);  // Names or block of an earlier resolve
+    symbol_table->name_mode = ELFPARSER_NAME_MODE_VIEW;  // Free must not touch the names from here on
+    for (size_t cnt = 0; cnt < symbol_table->table_len; cnt++)  // Point names into the map
     {
         size_t name_idx = symbol_table->table[cnt].sym_name_idx;
-        if (name_idx >= map_size)  // Bounds check
-        {
-            return ELFPARSER_ERR_SIZE;
-        }
-        if (ElfParser_strDup(&char_map[name_idx], &(symbol_table->table[cnt].sym_name)) < 0)
-        {
-            return ELFPARSER_ERR_MALLOC;  // String duplication failed
-        }
+        int64_t name_len = ElfParser_strLenBounded(&char_map[name_idx], map_size - name_idx);
+        symbol_table->table[cnt].sym_name = &char_map[name_idx];
+        symbol_table->table[cnt].sym_name_len = (uint32_t)name_len;  // Always terminated: ends at or before the name at max_idx
+    }
+    return ELFPARSER_SUCCESS;  // Success
+}
+
+/**
+ * @brief Resolves symbol names as views into the string table without copying
+ * @param[in,out] symbol_table Pointer to the symbol table structure
+ * @param[in] map Pointer to the memory-mapped string table
+ * @param[in] map_size Size of the memory map in bytes
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_SIZE if a name index or terminator lies outside the map
+ */
+int ElfParser_SymTable_nameResolveView(elfparser_symtable_t *symbol_table, const void *map, size_t map_size)
+{
+    if (!ElfParser_statsActive())
+    {
+        return SymTable_nameResolveViewRun(symbol_table, map, map_size);  // Nothing registered
+    }
+    elfparser_span_t span;
+    ElfParser_statsBegin(&span, ELFPARSER_PHASE_NAMES);
+    int ret = SymTable_nameResolveViewRun(symbol_table, map, map_size);
+    ElfParser_statsEnd(&span, ret, (ret < 0) ? 0 : ElfParser_statsNameExtent(map, map_size, symbol_table->max_idx),
+                       (ret < 0) ? 0 : symbol_table->table_len);
+    return ret;
+}
+
+/**
+ * @brief Body of ElfParser_SymTable_nameResolveArena(), run with or without an open span
+ * @return int See ElfParser_SymTable_nameResolveArena()
+ */
+static int SymTable_nameResolveArenaRun(elfparser_symtable_t *symbol_table, const void *map, size_t map_size)
+{
+    if (!symbol_table || !map || !symbol_table->table)
+    {
+        return ELFPARSER_ERR_NULL;  // Null pointer input
+    }
+    if (map_size <= symbol_table->max_idx)  // Check if map covers max index
+    {
+        ElfParser_statsErrorAt(map_size);
+        return ELFPARSER_ERR_SIZE;  // Insufficient size
+    }
+
+    const char *char_map = map;  // Cast map to char pointer
+    int64_t last_len = ElfParser_strLenBounded(&char_map[symbol_table->max_idx], map_size - symbol_table->max_idx);
+    if (last_len < 0)
+    {
+        ElfParser_statsErrorAt(map_size);
+        return ELFPARSER_ERR_SIZE;  // Highest name not terminated inside the map
+    }
+    size_t arena_size = (size_t)symbol_table->max_idx + (size_t)last_len + 1;  // Every name ends at or before this
+    char *arena = ElfParser_allocMalloc(symbol_table->alloc, arena_size);
+    if (!arena)
+    {
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+    if (!ElfParser_memCpy(arena, char_map, arena_size))  // One bulk copy of the referenced strings
+    {
+        ElfParser_allocFree(symbol_table->alloc, arena);
+        return ELFPARSER_ERR_MEMCPY;
+    }
+
+    SymTable_namesRelease(symbol_table);  // Names or block of an earlier resolve
+    for (size_t cnt = 0; cnt < symbol_table->table_len; cnt++)  // Point names into the block
+    {
+        size_t name_idx = symbol_table->table[cnt].sym_name_idx;
+        int64_t name_len = ElfParser_strLenBounded(&arena[name_idx], arena_size - name_idx);
+        symbol_table->table[cnt].sym_name = &arena[name_idx];
+        symbol_table->table[cnt].sym_name_len = (uint32_t)name_len;  // Always terminated: the block ends with a terminator
     }
+    symbol_table->name_arena = arena;
+    symbol_table->name_mode = ELFPARSER_NAME_MODE_ARENA;  // Free releases the block in one go
     return ELFPARSER_SUCCESS;  // Success
 }
 
+/**
+ * @brief Resolves symbol names into a single block owned by the table
+ * @param[in,out] symbol_table Pointer to the symbol table structure
+ * @param[in] map Pointer to the memory-mapped string table
+ * @param[in] map_size Size of the memory map in bytes
+ * @return int ELFPARSER_SUCCESS on success, ELFPARSER_ERR_NULL if inputs are NULL,
+ *             ELFPARSER_ERR_SIZE if a name lies outside the map, ELFPARSER_ERR_MALLOC if allocation fails,
+ *             ELFPARSER_ERR_MEMCPY if the copy fails
+ */
+int ElfParser_SymTable_nameResolveArena(elfparser_symtable_t *symbol_table, const void *map, size_t map_size)
+{
+    if (!ElfParser_statsActive())
+    {
+        return SymTable_nameResolveArenaRun(symbol_table, map, map_size);  // Nothing registered
+    }
+    elfparser_span_t span;
+    ElfParser_statsBegin(&span, ELFPARSER_PHASE_NAMES);
+    int ret = SymTable_nameResolveArenaRun(symbol_table, map, map_size);
+    ElfParser_statsEnd(&span, ret, (ret < 0) ? 0 : ElfParser_statsNameExtent(map, map_size, symbol_table->max_idx),
+                       (ret < 0) ? 0 : symbol_table->table_len);
+    return ret;
+}
+
 /**
  * @brief Frees the symbol table structure and its allocated resources
  * @param[in,out] symbol_table Pointer to the symbol table structure to free
@@ -193,12 +769,8 @@ int ElfParser_SymTable_free(elfparser_symtable_t *symbol_table)
     {
         return ELFPARSER_ERR_NULL;  // Null pointer input
     }
-    for (size_t cnt = 0; cnt < symbol_table->table_len; cnt++)  // Free each symbol name
-    {
-        free(symbol_table->table[cnt].sym_name);  // Safe to free NULL
-        symbol_table->table[cnt].sym_name = NULL; // Ensure NULL after free
-    }
-    free(symbol_table->table);  // Free the table
+    SymTable_namesRelease(symbol_table);
+    ElfParser_allocFree(symbol_table->alloc, symbol_table->table);  // Free the table
     symbol_table->table = NULL; // Nullify pointer
     return ELFPARSER_SUCCESS;   // Success
 }
@@ -0,0 +1,141 @@
+/**
+ * @file elfparser_thread.c
+ * @brief Chunked parallel loop for libelfparser
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This file implements ElfParser_parallelFor(), the helper behind the parallel
+ * parse and resolve functions. Threads claim chunks in ascending order from an
+ * atomic counter and record each chunk's status; the lowest failing chunk is
+ * tracked with an atomic minimum so later chunks can be skipped early and the
+ * reported error does not depend on scheduling.
+ */
+
+#include "../inc_priv/elfparser_thread_priv.h"
+#include "../inc_pub/elfparser_common.h"
+#include "../inc_priv/elfparser_stats_priv.h"
+#include <pthread.h>
+#include <unistd.h>
+
+/**
+ * @brief State shared by all threads of one ElfParser_parallelFor() call
+ */
+typedef struct thread_job_s
+{
+    size_t                  item_num;   /**< Number of items in the range */
+    size_t                  chunk_size; /**< Items per chunk */
+    size_t                  chunk_num;  /**< Number of chunks */
+    elfparser_chunk_fn_t    fn;         /**< Work function */
+    void*                   ctx;        /**< Caller context */
+    size_t                  next_chunk; /**< Next unclaimed chunk (atomic) */
+    size_t                  fail_chunk; /**< Lowest failed chunk so far, chunk_num if none (atomic) */
+    int*                    status;     /**< Result of each chunk */
+    elfparser_span_t*       span;       /**< Open span of the calling thread, NULL if none */
+} thread_job_t;
+
+/**
+ * @brief Claims and runs chunks until the range is exhausted
+ * @param[in,out] arg Pointer to the shared thread_job_t
+ * @return void* Always NULL
+ */
+static void* Thread_worker(void *arg)
+{
+    thread_job_t *job = arg;
+
+    elfparser_stats_span = job->span;  // Allocations and errors count towards the caller's span
+    for (;;)
+    {
+        size_t chunk = __atomic_fetch_add(&job->next_chunk, 1, __ATOMIC_RELAXED);
+        if (chunk >= job->chunk_num || chunk > __atomic_load_n(&job->fail_chunk, __ATOMIC_RELAXED))
+        {
+            break;  // Range done, or every remaining chunk lies past a failure
+        }
+        size_t begin = chunk * job->chunk_size;
+        size_t end = (begin + job->chunk_size < job->item_num) ? begin + job->chunk_size : job->item_num;
+        int ret = job->fn(job->ctx, chunk, begin, end);
+        job->status[chunk] = ret;
+        if (ret < 0)
+        {
+            size_t cur = __atomic_load_n(&job->fail_chunk, __ATOMIC_RELAXED);
+            while (chunk < cur && !__atomic_compare_exchange_n(&job->fail_chunk, &cur, chunk, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                // cur reloaded by the failed exchange
+            }
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Turns a requested thread count into the number of threads to run
+ * @param[in] thread_num Requested number of threads, 0 for one per online CPU
+ * @param[in] work_num Number of independent work items (chunks, files) available
+ * @return uint32_t Thread count between 1 and ELFPARSER_THREAD_NUM_MAX, never above work_num unless work_num is 0
+ */
+uint32_t ElfParser_threadNumResolve(uint32_t thread_num, size_t work_num)
+{
+    if (thread_num == 0)
+    {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        thread_num = (online > 0) ? (uint32_t)online : 1u;  // One thread per CPU
+    }
+    thread_num = (thread_num > ELFPARSER_THREAD_NUM_MAX) ? ELFPARSER_THREAD_NUM_MAX : thread_num;
+    thread_num = (work_num && thread_num > work_num) ? (uint32_t)work_num : thread_num;  // No idle threads
+    return thread_num;
+}
+
+/**
+ * @brief Runs a function over all chunks of an item range on a group of threads
+ * @param[in] item_num Number of items in the range
+ * @param[in] chunk_size Items per chunk (the last chunk may be shorter)
+ * @param[in] thread_num Number of threads, 0 for one per online CPU
+ * @param[in] fn Work function
+ * @param[in,out] ctx Context passed to fn
+ * @return int ELFPARSER_SUCCESS if every chunk succeeded, the error of the lowest failing chunk,
+ *             or ELFPARSER_ERR_NULL / ELFPARSER_ERR_MALLOC
+ */
+int ElfParser_parallelFor(size_t item_num, size_t chunk_size, uint32_t thread_num, elfparser_chunk_fn_t fn, void *ctx)
+{
+    if (!fn || chunk_size == 0)
+    {
+        return ELFPARSER_ERR_NULL;  // Nothing to run
+    }
+    if (item_num == 0)
+    {
+        return ELFPARSER_SUCCESS;  // Empty range
+    }
+
+    thread_job_t job = { 0 };
+    job.item_num = item_num;
+    job.chunk_size = chunk_size;
+    job.chunk_num = ElfParser_chunkNum(item_num, chunk_size);
+    job.fn = fn;
+    job.ctx = ctx;
+    job.next_chunk = 0;
+    job.fail_chunk = job.chunk_num;  // No failure yet
+    job.span = elfparser_stats_span;
+    job.status = calloc(job.chunk_num, sizeof(int));
+    if (!job.status)
+    {
+        return ELFPARSER_ERR_MALLOC;  // Allocation failure
+    }
+
+    thread_num = ElfParser_threadNumResolve(thread_num, job.chunk_num);
+
+    pthread_t threads[ELFPARSER_THREAD_NUM_MAX];
+    uint32_t started = 0;
+    while (started + 1u < thread_num && pthread_create(&threads[started], NULL, Thread_worker, &job) == 0)
+    {
+        started++;  // Caller is the remaining thread
+    }
+    Thread_worker(&job);
+    for (uint32_t i = 0; i < started; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    int ret = (job.fail_chunk < job.chunk_num) ? job.status[job.fail_chunk] : ELFPARSER_SUCCESS;
+    free(job.status);
+    return ret;
+}
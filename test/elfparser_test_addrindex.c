@@ -0,0 +1,237 @@
+/**
+ * @file elfparser_test_addrindex.c
+ * @brief Tests address-to-symbol resolution against the documented overlap rules
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * A hand-written table covers each rule on its own: nested ranges, partial
+ * overlaps, equal starts decided by length and then by symbol index,
+ * zero-size symbols covering exactly their own address inside and outside
+ * other ranges, ignored undefined and untyped symbols and a range running
+ * past the top of the address space. Random tables of every size up to a few
+ * dozen symbols are then checked address by address against a brute-force
+ * scan that applies the same rules, through single lookups and through
+ * batches in ascending and in scrambled order.
+ *
+ * Build and run from the repository root:
+ *   cc -O2 -pthread -Iinc_pub test/elfparser_test_addrindex.c src/elfparser_*.c -o test_addrindex && ./test_addrindex
+ */
+
+#include "elfparser_test_common.h"
+#include "../inc_pub/elfparser_addrindex.h"
+
+#define TEST_RAND_SYM_MAX   48u   /**< Largest random table */
+#define TEST_RAND_ADDR_MAX  320u  /**< Addresses checked per random table */
+#define TEST_RAND_ROUNDS    8u    /**< Random tables per size */
+
+/**
+ * @brief One expected resolution
+ */
+typedef struct test_probe_s
+{
+    uint64_t    addr;     /**< Address to resolve */
+    int64_t     sym_idx;  /**< Expected symbol index or ELFPARSER_ERR_NOT_FOUND */
+} test_probe_t;
+
+static uint64_t test_rand_state = 0x9E3779B97F4A7C15u;  /**< Generator state, fixed for repeatable runs */
+
+/**
+ * @brief Returns the next value of a 64-bit xorshift generator
+ * @return uint64_t Pseudo-random value
+ */
+static uint64_t Test_rand(void)
+{
+    test_rand_state ^= test_rand_state << 13;
+    test_rand_state ^= test_rand_state >> 7;
+    test_rand_state ^= test_rand_state << 17;
+    return test_rand_state;
+}
+
+/**
+ * @brief Fills one symbol entry
+ * @param[out] entry Entry to fill
+ * @param[in] type Symbol type
+ * @param[in] sect_idx st_shndx, 0 for undefined
+ * @param[in] value Start address
+ * @param[in] size Size in bytes
+ */
+static void Test_symSet(elfparser_symtable_entry_t *entry, uint8_t type, uint32_t sect_idx, uint64_t value, uint64_t size)
+{
+    memset(entry, 0, sizeof(*entry));
+    entry->sym_type = type;
+    entry->sym_bind = ELFPARSER_SYMTABLE_BIND_GLOBAL;
+    entry->sym_sect_idx = sect_idx;
+    entry->sym_value = value;
+    entry->sym_size = size;
+}
+
+/**
+ * @brief Resolves an address by scanning every symbol with the documented rules
+ * @param[in] symbol_table Symbol table
+ * @param[in] addr Address to resolve
+ * @return int64_t Winning symbol index, or ELFPARSER_ERR_NOT_FOUND
+ */
+static int64_t Test_refLookup(const elfparser_symtable_t *symbol_table, uint64_t addr)
+{
+    int64_t best = ELFPARSER_ERR_NOT_FOUND;
+    uint64_t best_start = 0;
+    uint64_t best_end = 0;
+
+    for (uint32_t i = 0; i < symbol_table->table_len; i++)
+    {
+        const elfparser_symtable_entry_t *entry = &symbol_table->table[i];
+        if ((entry->sym_type != ELFPARSER_SYMTABLE_TYPE_FUNC && entry->sym_type != ELFPARSER_SYMTABLE_TYPE_OBJECT) ||
+            entry->sym_sect_idx == 0)
+        {
+            continue;  // Not indexed
+        }
+        uint64_t size = entry->sym_size ? entry->sym_size : 1;
+        uint64_t start = entry->sym_value;
+        uint64_t end = (start + size < start) ? UINT64_MAX : start + size;
+        if (addr < start || addr >= end)
+        {
+            continue;  // Does not cover addr
+        }
+        if (best < 0 || start > best_start || (start == best_start && end < best_end))  // Equal ranges: lower index kept
+        {
+            best = i;
+            best_start = start;
+            best_end = end;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Checks the hand-written table, one rule per group of probes
+ */
+static void Test_rules(void)
+{
+    elfparser_symtable_entry_t table[12];
+    elfparser_symtable_t symbol_table;
+    elfparser_addrindex_t addr_index;
+
+    Test_symSet(&table[0], ELFPARSER_SYMTABLE_TYPE_NOTYPE, 0, 0, 0);
+    Test_symSet(&table[1], ELFPARSER_SYMTABLE_TYPE_FUNC, 1, 0x1000, 0x100);   // Outer range
+    Test_symSet(&table[2], ELFPARSER_SYMTABLE_TYPE_FUNC, 1, 0x1040, 0x20);    // Nested inside 1
+    Test_symSet(&table[3], ELFPARSER_SYMTABLE_TYPE_OBJECT, 1, 0x1080, 0);     // Zero size inside 1 and 10
+    Test_symSet(&table[4], ELFPARSER_SYMTABLE_TYPE_FUNC, 1, 0x2000, 0x40);    // Same start as 5 and 6, longer
+    Test_symSet(&table[5], ELFPARSER_SYMTABLE_TYPE_FUNC, 1, 0x2000, 0x10);
+    Test_symSet(&table[6], ELFPARSER_SYMTABLE_TYPE_FUNC, 1, 0x2000, 0x10);    // Same range as 5, higher index
+    Test_symSet(&table[7], ELFPARSER_SYMTABLE_TYPE_FUNC, 0, 0x3000, 0x100);   // Undefined
+    Test_symSet(&table[8], ELFPARSER_SYMTABLE_TYPE_NOTYPE, 1, 0x3000, 0x100); // Not a function or object
+    Test_symSet(&table[9], ELFPARSER_SYMTABLE_TYPE_OBJECT, 2, 0x4000, 0);     // Zero size on its own
+    Test_symSet(&table[10], ELFPARSER_SYMTABLE_TYPE_FUNC, 1, 0x1050, 0x50);   // Overlaps the end of 2
+    Test_symSet(&table[11], ELFPARSER_SYMTABLE_TYPE_FUNC, 1, UINT64_MAX - 0x10, 0x100);  // Runs past the top
+    memset(&symbol_table, 0, sizeof(symbol_table));
+    symbol_table.table = table;
+    symbol_table.table_len = sizeof(table) / sizeof(table[0]);
+
+    static const test_probe_t probe[] = {
+        { 0x0fff, ELFPARSER_ERR_NOT_FOUND }, { 0x1000, 1 }, { 0x103f, 1 },
+        { 0x1040, 2 }, { 0x104f, 2 },                                       // Innermost wins
+        { 0x1050, 10 }, { 0x107f, 10 }, { 0x1080, 3 }, { 0x1081, 10 },      // Later start wins, zero size covers one address
+        { 0x109f, 10 }, { 0x10a0, 1 }, { 0x10ff, 1 }, { 0x1100, ELFPARSER_ERR_NOT_FOUND },
+        { 0x2000, 5 }, { 0x200f, 5 }, { 0x2010, 4 }, { 0x203f, 4 },         // Shorter, then lower index
+        { 0x2040, ELFPARSER_ERR_NOT_FOUND },
+        { 0x3000, ELFPARSER_ERR_NOT_FOUND }, { 0x30ff, ELFPARSER_ERR_NOT_FOUND },
+        { 0x3fff, ELFPARSER_ERR_NOT_FOUND }, { 0x4000, 9 }, { 0x4001, ELFPARSER_ERR_NOT_FOUND },
+        { UINT64_MAX - 0x11, ELFPARSER_ERR_NOT_FOUND }, { UINT64_MAX - 0x10, 11 }, { UINT64_MAX - 1, 11 },
+        { UINT64_MAX, ELFPARSER_ERR_NOT_FOUND },                             // End clamped, exclusive
+    };
+    const size_t probe_num = sizeof(probe) / sizeof(probe[0]);
+    uint64_t addrs[sizeof(probe) / sizeof(probe[0])];
+    int64_t got[sizeof(probe) / sizeof(probe[0])];
+
+    TEST_CHECK(ElfParser_AddrIndex_build(&addr_index, &symbol_table) == ELFPARSER_SUCCESS);
+    for (size_t i = 0; i < probe_num; i++)
+    {
+        int64_t sym_idx = ElfParser_AddrIndex_lookup(&addr_index, probe[i].addr);
+        TEST_CHECK(sym_idx == probe[i].sym_idx);
+        TEST_CHECK(sym_idx == Test_refLookup(&symbol_table, probe[i].addr));
+        addrs[i] = probe[i].addr;
+    }
+    TEST_CHECK(ElfParser_AddrIndex_batchLookup(&addr_index, addrs, probe_num, got) == ELFPARSER_SUCCESS);
+    for (size_t i = 0; i < probe_num; i++)
+    {
+        TEST_CHECK(got[i] == probe[i].sym_idx);
+    }
+    TEST_CHECK(ElfParser_AddrIndex_free(&addr_index) == ELFPARSER_SUCCESS);
+
+    symbol_table.table_len = 1;  // Nothing indexed
+    TEST_CHECK(ElfParser_AddrIndex_build(&addr_index, &symbol_table) == ELFPARSER_SUCCESS);
+    TEST_CHECK(addr_index.seg_num == 0 && ElfParser_AddrIndex_lookup(&addr_index, 0) == ELFPARSER_ERR_NOT_FOUND);
+    TEST_CHECK(ElfParser_AddrIndex_free(&addr_index) == ELFPARSER_SUCCESS);
+    TEST_CHECK(ElfParser_AddrIndex_lookup(&addr_index, 0) == ELFPARSER_ERR_NULL);
+}
+
+/**
+ * @brief Checks random tables of one size against the brute-force scan
+ * @param[in] sym_num Number of symbols
+ */
+static void Test_random(uint32_t sym_num)
+{
+    elfparser_symtable_entry_t table[TEST_RAND_SYM_MAX];
+    elfparser_symtable_t symbol_table;
+    elfparser_addrindex_t addr_index;
+    uint64_t addrs[TEST_RAND_ADDR_MAX];
+    int64_t got[TEST_RAND_ADDR_MAX];
+
+    for (uint32_t i = 0; i < sym_num; i++)
+    {
+        uint64_t r = Test_rand();
+        uint8_t type = (r & 7) == 0 ? ELFPARSER_SYMTABLE_TYPE_NOTYPE : (r & 1) ? ELFPARSER_SYMTABLE_TYPE_FUNC : ELFPARSER_SYMTABLE_TYPE_OBJECT;
+        uint32_t sect_idx = ((r >> 3) & 15) == 0 ? 0 : 1;
+        uint64_t size = ((r >> 7) & 3) == 0 ? 0 : (r >> 9) % 40;  // A quarter zero-size
+        Test_symSet(&table[i], type, sect_idx, (r >> 20) % 280, size);
+    }
+    memset(&symbol_table, 0, sizeof(symbol_table));
+    symbol_table.table = table;
+    symbol_table.table_len = sym_num;
+    int ret = ElfParser_AddrIndex_build(&addr_index, &symbol_table);
+    TEST_CHECK(ret == ELFPARSER_SUCCESS);
+    if (ret != ELFPARSER_SUCCESS)
+    {
+        return;
+    }
+
+    for (uint32_t a = 0; a < TEST_RAND_ADDR_MAX; a++)
+    {
+        int64_t want = Test_refLookup(&symbol_table, a);
+        TEST_CHECK(ElfParser_AddrIndex_lookup(&addr_index, a) == want);
+        addrs[a] = a;
+    }
+    TEST_CHECK(ElfParser_AddrIndex_batchLookup(&addr_index, addrs, TEST_RAND_ADDR_MAX, got) == ELFPARSER_SUCCESS);  // Ascending
+    for (uint32_t a = 0; a < TEST_RAND_ADDR_MAX; a++)
+    {
+        TEST_CHECK(got[a] == Test_refLookup(&symbol_table, a));
+    }
+    for (uint32_t a = 0; a < TEST_RAND_ADDR_MAX; a++)
+    {
+        addrs[a] = Test_rand() % TEST_RAND_ADDR_MAX;
+    }
+    TEST_CHECK(ElfParser_AddrIndex_batchLookup(&addr_index, addrs, TEST_RAND_ADDR_MAX, got) == ELFPARSER_SUCCESS);  // Scrambled
+    for (uint32_t a = 0; a < TEST_RAND_ADDR_MAX; a++)
+    {
+        TEST_CHECK(got[a] == Test_refLookup(&symbol_table, addrs[a]));
+    }
+    for (uint32_t s = 1; s < addr_index.seg_num; s++)  // Segments are sorted and disjoint
+    {
+        TEST_CHECK(addr_index.seg_end[s - 1] <= addr_index.seg_start[s] && addr_index.seg_start[s] < addr_index.seg_end[s]);
+    }
+    ElfParser_AddrIndex_free(&addr_index);
+}
+
+int main(void)
+{
+    Test_rules();
+    for (uint32_t sym_num = 1; sym_num <= TEST_RAND_SYM_MAX; sym_num++)
+    {
+        for (uint32_t round = 0; round < TEST_RAND_ROUNDS; round++)
+        {
+            Test_random(sym_num);
+        }
+    }
+    return Test_report("test_addrindex");
+}
@@ -0,0 +1,337 @@
+/**
+ * @file elfparser_test_common.h
+ * @brief Shared helpers for the libelfparser behavior tests
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * This header provides the small amount of infrastructure shared by the test
+ * programs in test/: a check macro that counts failures, an allocator that
+ * counts live blocks, and a builder for complete ELF images in memory with
+ * any class and endianness. Like the benchmarks, every test is a single
+ * translation unit compiled together with the library sources; it prints a
+ * line per failed check and exits non-zero if any check failed.
+ */
+
+#ifndef _IG_ELFPARSER_TEST_COMMON_H_
+#define _IG_ELFPARSER_TEST_COMMON_H_
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../inc_pub/elfparser_header.h"
+#include "../inc_pub/elfparser_secthead.h"
+#include "../inc_pub/elfparser_alloc.h"
+
+/* Image Builder Flags */
+#define TEST_ELF_FLAG_EXTENDED  0x00000001u /**< Store e_shnum as 0 and e_shstrndx as SHN_XINDEX, real values in section 0 */
+
+#define TEST_SHN_XINDEX         0xFFFFu     /**< e_shstrndx escape (SHN_XINDEX) */
+
+static uint32_t test_check_num = 0;  /**< Checks run so far */
+static uint32_t test_fail_num = 0;   /**< Checks failed so far */
+
+/**
+ * @brief Checks a condition and reports it if it does not hold
+ * @param[in] cond Condition that must be non-zero
+ */
+#define TEST_CHECK(cond) Test_check((cond) ? 1 : 0, #cond, __FILE__, __LINE__)
+
+/**
+ * @brief Records the result of one check
+ * @param[in] ok Non-zero if the check passed
+ * @param[in] expr Source text of the condition
+ * @param[in] file Source file of the check
+ * @param[in] line Source line of the check
+ */
+static inline void Test_check(int ok, const char *expr, const char *file, int line)
+{
+    test_check_num++;
+    if (!ok)
+    {
+        test_fail_num++;
+        fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expr);
+    }
+}
+
+/**
+ * @brief Prints the summary line of a test program
+ * @param[in] name Name of the test program
+ * @return int Exit status, 0 if every check passed
+ */
+static inline int Test_report(const char *name)
+{
+    printf("%s: %" PRIu32 " checks, %" PRIu32 " failed\n", name, test_check_num, test_fail_num);
+    return test_fail_num ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/**
+ * @brief State of the counting allocator
+ */
+typedef struct test_alloc_count_s
+{
+    int64_t live;   /**< Blocks handed out and not yet freed */
+    int64_t total;  /**< Blocks handed out in total */
+} test_alloc_count_t;
+
+/** @brief alloc_fn of the counting allocator */
+static inline void *Test_countAlloc(void *ctx, size_t size)
+{
+    test_alloc_count_t *count = ctx;
+    void *ptr = malloc(size ? size : 1);
+
+    if (ptr)
+    {
+        count->live++;
+        count->total++;
+    }
+    return ptr;
+}
+
+/** @brief free_fn of the counting allocator */
+static inline void Test_countFree(void *ctx, void *ptr)
+{
+    test_alloc_count_t *count = ctx;
+
+    count->live--;
+    free(ptr);
+}
+
+/**
+ * @brief Initializes an allocator that forwards to malloc and counts live blocks
+ * @param[out] alloc Allocator to initialize
+ * @param[out] count Counters the allocator updates, zeroed here
+ */
+static inline void Test_countAllocInit(elfparser_alloc_t *alloc, test_alloc_count_t *count)
+{
+    memset(count, 0, sizeof(*count));
+    alloc->alloc_fn = Test_countAlloc;
+    alloc->free_fn = Test_countFree;
+    alloc->ctx = count;
+    alloc->flags = 0;
+}
+
+/**
+ * @brief Stores an unsigned value with the given width and endianness
+ * @param[out] dst Destination bytes
+ * @param[in] value Value to store
+ * @param[in] size Width in bytes (at most 8)
+ * @param[in] big_endian Non-zero to store big-endian
+ */
+static inline void Test_store(uint8_t *dst, uint64_t value, size_t size, int big_endian)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        dst[big_endian ? size - 1 - i : i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+/**
+ * @brief Returns the raw size of one symbol table entry
+ * @param[in] is_64bit Non-zero for the 64-bit layout
+ * @return size_t Entry size in bytes
+ */
+static inline size_t Test_symEntrySize(int is_64bit)
+{
+    return is_64bit ? 24u : 16u;
+}
+
+/**
+ * @brief Writes one raw symbol table entry
+ * @param[out] dst Destination of Test_symEntrySize(is_64bit) bytes
+ * @param[in] is_64bit Non-zero for the 64-bit layout
+ * @param[in] big_endian Non-zero for big-endian data
+ * @param[in] name_idx st_name
+ * @param[in] info st_info (binding << 4 | type)
+ * @param[in] shndx st_shndx
+ * @param[in] value st_value
+ * @param[in] size st_size
+ */
+static inline void Test_symWrite(uint8_t *dst, int is_64bit, int big_endian, uint32_t name_idx, uint8_t info,
+                                 uint16_t shndx, uint64_t value, uint64_t size)
+{
+    memset(dst, 0, Test_symEntrySize(is_64bit));
+    Test_store(dst, name_idx, 4, big_endian);
+    if (is_64bit)
+    {
+        dst[4] = info;
+        Test_store(dst + 6, shndx, 2, big_endian);
+        Test_store(dst + 8, value, 8, big_endian);
+        Test_store(dst + 16, size, 8, big_endian);
+    }
+    else
+    {
+        Test_store(dst + 4, value, 4, big_endian);
+        Test_store(dst + 8, size, 4, big_endian);
+        dst[12] = info;
+        Test_store(dst + 14, shndx, 2, big_endian);
+    }
+}
+
+/**
+ * @brief Description of one section of a test image
+ */
+typedef struct test_sect_s
+{
+    const char* name;     /**< Section name, NULL for the empty name */
+    uint32_t    type;     /**< sh_type */
+    uint64_t    flags;    /**< sh_flags */
+    uint32_t    link;     /**< sh_link */
+    uint32_t    info;     /**< sh_info */
+    uint64_t    entsize;  /**< sh_entsize */
+    const void* data;     /**< Contents, NULL for none */
+    size_t      size;     /**< Size of the contents in bytes */
+} test_sect_t;
+
+/**
+ * @brief A test image built in memory
+ */
+typedef struct test_elf_s
+{
+    uint8_t*    data;          /**< Image bytes, released with free() */
+    size_t      size;          /**< Size of the image in bytes */
+    uint64_t    sect_head_off; /**< Offset of the section header table */
+    uint32_t    sect_num;      /**< Number of sections including the null section and .shstrtab */
+    uint32_t    shstrtab_idx;  /**< Index of .shstrtab, always the last section */
+} test_elf_t;
+
+/**
+ * @brief Builds an ELF image from a list of sections
+ *
+ * Section 0 is the null section, sects[i] becomes section i + 1 and
+ * .shstrtab is appended as the last section. Contents are placed after the
+ * ELF header, each aligned to 8 bytes, followed by the section header table.
+ *
+ * @param[out] elf Image to build
+ * @param[in] sects Sections to place, in index order from 1
+ * @param[in] sect_num Number of entries in sects
+ * @param[in] is_64bit Non-zero for ELFCLASS64
+ * @param[in] big_endian Non-zero for ELFDATA2MSB
+ * @param[in] flags TEST_ELF_FLAG_* values
+ * @return int 0 on success, -1 if memory allocation fails
+ */
+static inline int Test_elfBuild(test_elf_t *elf, const test_sect_t *sects, uint32_t sect_num, int is_64bit, int big_endian, uint32_t flags)
+{
+    const size_t ehdr_size = is_64bit ? 64u : 52u;
+    const size_t shdr_size = is_64bit ? 64u : 40u;
+    const size_t word = is_64bit ? 8u : 4u;
+    const uint32_t total = sect_num + 2u;  // Null section and .shstrtab
+    static const char shstrtab_name[] = ".shstrtab";
+
+    size_t strtab_size = 1 + sizeof(shstrtab_name);  // Empty name and .shstrtab
+    size_t data_size = 0;
+    for (uint32_t i = 0; i < sect_num; i++)
+    {
+        strtab_size += sects[i].name ? strlen(sects[i].name) + 1 : 0;
+        data_size += (sects[i].size + 7u) & ~(size_t)7u;
+    }
+    size_t strtab_off = ehdr_size + data_size;
+    size_t head_off = (strtab_off + strtab_size + 7u) & ~(size_t)7u;
+
+    memset(elf, 0, sizeof(*elf));
+    elf->size = head_off + (size_t)total * shdr_size;
+    elf->data = calloc(1, elf->size);
+    if (!elf->data)
+    {
+        return -1;
+    }
+    elf->sect_head_off = head_off;
+    elf->sect_num = total;
+    elf->shstrtab_idx = total - 1;
+
+    uint8_t *img = elf->data;
+    memcpy(img, "\x7f" "ELF", 4);
+    img[4] = is_64bit ? 2 : 1;    // EI_CLASS
+    img[5] = big_endian ? 2 : 1;  // EI_DATA
+    img[6] = 1;                   // EI_VERSION
+    Test_store(img + 16, 3, 2, big_endian);  // e_type ET_DYN
+    Test_store(img + 18, 62, 2, big_endian); // e_machine
+    Test_store(img + 20, 1, 4, big_endian);  // e_version
+    size_t shoff_at = is_64bit ? 40u : 32u;      // e_shoff, followed by e_flags and the 16-bit fields
+    size_t flags_at = shoff_at + word;
+    Test_store(img + shoff_at, head_off, word, big_endian);
+    Test_store(img + flags_at + 4, ehdr_size, 2, big_endian);   // e_ehsize
+    Test_store(img + flags_at + 10, shdr_size, 2, big_endian);  // e_shentsize
+    int extended = (flags & TEST_ELF_FLAG_EXTENDED) != 0;
+    Test_store(img + flags_at + 12, extended ? 0 : total, 2, big_endian);                            // e_shnum
+    Test_store(img + flags_at + 14, extended ? TEST_SHN_XINDEX : elf->shstrtab_idx, 2, big_endian);  // e_shstrndx
+
+    char *strtab = (char *)img + strtab_off;
+    size_t str_len = 1;  // Offset 0 is the empty name
+    size_t data_off = ehdr_size;
+    for (uint32_t i = 0; i <= sect_num; i++)
+    {
+        int is_shstrtab = (i == sect_num);
+        const test_sect_t *sect = is_shstrtab ? NULL : &sects[i];
+        const char *name = is_shstrtab ? shstrtab_name : sect->name;
+        uint8_t *shdr = img + head_off + (size_t)(i + 1) * shdr_size;
+        uint64_t offset = is_shstrtab ? strtab_off : data_off;
+        uint64_t size = is_shstrtab ? strtab_size : sect->size;
+
+        if (name)
+        {
+            Test_store(shdr, str_len, 4, big_endian);  // sh_name
+            memcpy(strtab + str_len, name, strlen(name) + 1);
+            str_len += strlen(name) + 1;
+        }
+        if (!is_shstrtab && sect->data)
+        {
+            memcpy(img + data_off, sect->data, sect->size);
+        }
+        if (!is_shstrtab)
+        {
+            data_off += (sect->size + 7u) & ~(size_t)7u;
+        }
+        Test_store(shdr + 4, is_shstrtab ? 3u : sect->type, 4, big_endian);  // sh_type
+        Test_store(shdr + 8, is_shstrtab ? 0u : sect->flags, word, big_endian);
+        Test_store(shdr + 8 + 2 * word, offset, word, big_endian);
+        Test_store(shdr + 8 + 3 * word, size, word, big_endian);
+        Test_store(shdr + 8 + 4 * word, is_shstrtab ? 0u : sect->link, 4, big_endian);
+        Test_store(shdr + 12 + 4 * word, is_shstrtab ? 0u : sect->info, 4, big_endian);
+        Test_store(shdr + 16 + 4 * word, 1u, word, big_endian);  // sh_addralign
+        Test_store(shdr + 16 + 5 * word, is_shstrtab ? 0u : sect->entsize, word, big_endian);
+    }
+    if (extended)  // Real count in sh_size and string table index in sh_link of section 0
+    {
+        uint8_t *shdr0 = img + head_off;
+        Test_store(shdr0 + 8 + 3 * word, total, word, big_endian);
+        Test_store(shdr0 + 8 + 4 * word, elf->shstrtab_idx, 4, big_endian);
+    }
+    return 0;
+}
+
+/**
+ * @brief Parses the header and section header table of a test image and resolves section names
+ * @param[out] header Header to fill
+ * @param[out] sect_head Section header table to set up, released with ElfParser_SectHead_free()
+ * @param[in] elf Image to parse
+ * @param[in] alloc Allocator of the table and names, NULL for malloc
+ * @return int ELFPARSER_SUCCESS on success, or the error of the first failing step
+ */
+static inline int Test_elfOpen(elfparser_header_t *header, elfparser_secthead_t *sect_head, const test_elf_t *elf, const elfparser_alloc_t *alloc)
+{
+    memset(header, 0, sizeof(*header));  // identParse fills only the low byte of the enum fields
+    int ret = ElfParser_Header_identParse(header, elf->data, elf->size);
+    if (ret == ELFPARSER_SUCCESS)
+    {
+        ret = ElfParser_Header_parse(header, elf->data, elf->size);
+    }
+    if (ret == ELFPARSER_SUCCESS)
+    {
+        ret = ElfParser_SectHead_structSetupAlloc(sect_head, header, alloc);
+    }
+    if (ret == ELFPARSER_SUCCESS)
+    {
+        ret = ElfParser_SectHead_parse(sect_head, elf->data + header->elf_section_header_off,
+                                       elf->size - header->elf_section_header_off);
+    }
+    if (ret == ELFPARSER_SUCCESS && sect_head->string_table_idx < sect_head->table_len)
+    {
+        const elfparser_secthead_entry_t *strtab = &sect_head->table[sect_head->string_table_idx];
+        ret = ElfParser_SectHead_nameResolve(sect_head, elf->data + strtab->sh_offset, strtab->sh_size);
+    }
+    return ret;
+}
+
+#endif /* _IG_ELFPARSER_TEST_COMMON_H_ */
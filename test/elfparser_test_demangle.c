@@ -0,0 +1,143 @@
+/**
+ * @file elfparser_test_demangle.c
+ * @brief Tests the Itanium demangler against c++filt reference output
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * Every accepted vector is paired with the text GNU c++filt prints for it,
+ * grouped by the part of the grammar it exercises: substitutions, template
+ * arguments and forwarding references, unresolved names in decltype, lambdas
+ * and function and member pointers. The rejected vectors are names c++filt
+ * leaves mangled: truncated input, references to substitutions or template
+ * parameters that do not exist, and function types without parameters. Each
+ * vector goes through ElfParser_Demangle_name() and through the memo of
+ * ElfParser_Demangle_get() twice, the second time as a memo hit.
+ *
+ * Build and run from the repository root:
+ *   cc -O2 -pthread -Iinc_pub test/elfparser_test_demangle.c src/elfparser_*.c -o test_demangle && ./test_demangle
+ */
+
+#include "elfparser_test_common.h"
+#include "../inc_pub/elfparser_demangle.h"
+
+#define TEST_OUT_MAX 512 /**< Size of the output buffer */
+
+/**
+ * @brief One mangled name and the text c++filt prints for it
+ */
+typedef struct test_vec_s
+{
+    const char* mangled;    /**< Mangled name */
+    const char* demangled;  /**< c++filt output */
+} test_vec_t;
+
+static const test_vec_t test_accept[] = {
+    /* Substitutions: S_ is the first candidate, S0_ the second, St/Sa/Ss the standard ones */
+    { "_ZN1A1fES_",                     "A::f(A)" },
+    { "_Z1fN1A1BES0_",                  "f(A::B, A::B)" },
+    { "_Z1fN1A1BES0_S_",                "f(A::B, A::B, A)" },
+    { "_Z1fPKcS0_",                     "f(char const*, char const*)" },
+    { "_ZN2ns1fERKSs",                  "ns::f(std::basic_string<char, std::char_traits<char>, std::allocator<char> > const&)" },
+    { "_ZNSt6vectorIiSaIiEE9push_backERKi", "std::vector<int, std::allocator<int> >::push_back(int const&)" },
+    { "_ZNKSt3mapIiSsSt4lessIiESaISt4pairIKiSsEEE4findERS3_",
+      "std::map<int, std::basic_string<char, std::char_traits<char>, std::allocator<char> >, std::less<int>, "
+      "std::allocator<std::pair<int const, std::basic_string<char, std::char_traits<char>, std::allocator<char> > > > >"
+      "::find(int const&) const" },
+    /* Template arguments, T_ references and forwarding */
+    { "_Z1fIiEvT_",                     "void f<int>(int)" },
+    { "_Z3maxIiET_S0_S0_",              "int max<int>(int, int)" },
+    { "_Z1fIidEvT0_T_",                 "void f<int, double>(double, int)" },
+    { "_Z1fIiEvOT_",                    "void f<int>(int&&)" },
+    { "_ZSt7forwardIiEOT_RNSt16remove_referenceIS0_E4typeE", "int&& std::forward<int>(std::remove_reference<int>::type&)" },
+    { "_Z1gIJidEEvDpOT_",               "void g<int, double>(int&&, double&&)" },
+    { "_Z1fIJEEvv",                     "void f<>()" },
+    { "_Z1fIiE",                        "f<int>" },
+    /* Unresolved names (sr, srN) */
+    { "_ZN1AIiE1fIdEEvDTsrT_1xE",       "void A<int>::f<double>(decltype (double::x))" },
+    { "_Z1fIiEvDTsrNT_4typeE1xE",       "void f<int>(decltype (int::type::x))" },
+    { "_Z1fIiEvDTsrNS_1AIT_EE1xE",      "void f<int>(decltype (f::A<int>::x))" },
+    { "_Z1fIiEvDTsrN1AIT_E1BE1xE",      "void f<int>(decltype (A<int>::B::x))" },
+    /* Lambdas */
+    { "_ZZ4mainENKUlvE_clEv",           "main::{lambda()#1}::operator()() const" },
+    { "_ZZ4mainENKUliE0_clEi",          "main::{lambda(int)#2}::operator()(int) const" },
+    { "_ZZ4mainENKUlRKiE_clES0_",       "main::{lambda(int const&)#1}::operator()(int const&) const" },
+    { "_ZZ4mainENKUlvE_clE",            "main::{lambda()#1}::operator() const" },
+    /* Function pointers, member pointers and arrays */
+    { "_Z1fPFviE",                      "f(void (*)(int))" },
+    { "_Z1fPFvRKiE",                    "f(void (*)(int const&))" },
+    { "_Z1fPFPFivEiE",                  "f(int (*(*)(int))())" },
+    { "_Z1fPFvvE",                      "f(void (*)())" },
+    { "_Z1fPFvivE",                     "f(void (*)(int, void))" },
+    { "_Z1fM1AFivE",                    "f(int (A::*)())" },
+    { "_Z1fRA10_i",                     "f(int (&) [10])" },
+    /* Qualified member names without a type */
+    { "_ZNK1A1fE",                      "A::f const" },
+    { "_ZNKR1A1fE",                     "A::f const &" },
+};
+
+static const char *const test_reject[] = {
+    "_Z",
+    "_Z1",
+    "_Z3fo",                            // Source name longer than the input
+    "_ZN3foo",                          // Nested name without E
+    "_ZZ4mainE",                        // Local name without entity
+    "_Z1fS_",                           // No substitution candidate yet
+    "_Z1fNS0_1AE",                      // Second candidate does not exist
+    "_Z1fIiEvT0_",                      // Second template parameter does not exist
+    "_Z1fPFv",                          // Function type without E
+    "_Z1fPFvE",                         // Function type without parameter types
+    "_Z1fPFvREE",
+    "_Z1fIiEvDTsrNT_E",                 // srN without a base name
+    "_Z1fSt6vectorIiSaIiE",             // Template arguments without E
+    "_ZNSt6vectorIiSaIiEE9push_backERKi_",  // Trailing garbage
+    "foo",
+};
+
+int main(void)
+{
+    char out[TEST_OUT_MAX];
+    size_t out_len;
+    elfparser_demangle_t demangle;
+    const char *demangled;
+
+    TEST_CHECK(ElfParser_Demangle_init(&demangle) == ELFPARSER_SUCCESS);
+    for (int pass = 0; pass < 2; pass++)  // Second pass answers from the memo
+    {
+        for (size_t i = 0; i < sizeof(test_accept) / sizeof(test_accept[0]); i++)
+        {
+            const test_vec_t *vec = &test_accept[i];
+            out_len = 0;
+            int ret = ElfParser_Demangle_name(vec->mangled, out, sizeof(out), &out_len);
+            TEST_CHECK(ret == ELFPARSER_SUCCESS);
+            if (ret != ELFPARSER_SUCCESS || strcmp(out, vec->demangled) != 0)
+            {
+                fprintf(stderr, "%s: got \"%s\", want \"%s\"\n", vec->mangled, ret == ELFPARSER_SUCCESS ? out : "", vec->demangled);
+                TEST_CHECK(!"matches c++filt");
+            }
+            TEST_CHECK(out_len == strlen(vec->demangled));
+            TEST_CHECK(ElfParser_Demangle_get(&demangle, vec->mangled, &demangled) == ELFPARSER_SUCCESS);
+            TEST_CHECK(demangled && strcmp(demangled, vec->demangled) == 0);
+        }
+        for (size_t i = 0; i < sizeof(test_reject) / sizeof(test_reject[0]); i++)
+        {
+            TEST_CHECK(ElfParser_Demangle_name(test_reject[i], out, sizeof(out), NULL) == ELFPARSER_ERR_FORMAT);
+            TEST_CHECK(ElfParser_Demangle_get(&demangle, test_reject[i], &demangled) == ELFPARSER_ERR_FORMAT);
+            TEST_CHECK(demangled == NULL);
+        }
+    }
+    const uint64_t accept_num = sizeof(test_accept) / sizeof(test_accept[0]);
+    const uint64_t reject_num = sizeof(test_reject) / sizeof(test_reject[0]);
+    TEST_CHECK(demangle.stats.lookups == 2 * (accept_num + reject_num));
+    TEST_CHECK(demangle.stats.memo_hits == accept_num + reject_num);
+    TEST_CHECK(demangle.stats.demangled == accept_num && demangle.stats.failed == reject_num);
+    TEST_CHECK(ElfParser_Demangle_free(&demangle) == ELFPARSER_SUCCESS);
+
+    out_len = 0;  // Too small a buffer still reports the length
+    TEST_CHECK(ElfParser_Demangle_name("_ZN3foo3barEv", out, 10, &out_len) == ELFPARSER_ERR_SIZE);
+    TEST_CHECK(out_len == strlen("foo::bar()"));
+    TEST_CHECK(ElfParser_Demangle_name("_ZN3foo3barEv", out, 11, &out_len) == ELFPARSER_SUCCESS);
+    TEST_CHECK(strcmp(out, "foo::bar()") == 0);
+    TEST_CHECK(ElfParser_Demangle_name(NULL, out, sizeof(out), NULL) == ELFPARSER_ERR_NULL);
+    return Test_report("test_demangle");
+}
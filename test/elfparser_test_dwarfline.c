@@ -0,0 +1,621 @@
+/**
+ * @file elfparser_test_dwarfline.c
+ * @brief Tests line table decoding and address lookups on hand-assembled DWARF 4 and 5 units
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * Each image holds a DWARF 4 unit with string-list directory and file tables
+ * and a DWARF 5 unit whose typed tables take paths from .debug_line_str and
+ * inline strings, directory indices as udata and skip an MD5 per file. The
+ * programs use special opcodes, the DWARF 2 standard opcodes and
+ * DW_LNE_define_file, and the DWARF 4 program ends two sequences, the first
+ * starting above the second. Every address around the rows is resolved singly and in a
+ * batch, in both classes and byte orders and in the 32-bit and 64-bit DWARF
+ * formats. The units are then cut at every length: a cut inside a header or
+ * inside an operand must leave the unit invalid with no rows, a cut between
+ * opcodes may only drop the unterminated sequence, and nothing may resolve
+ * past the cut. Unsupported versions, a zero line_range and a header_length
+ * overrunning the unit are rejected the same way.
+ *
+ * Build and run from the repository root:
+ *   cc -O2 -pthread -Iinc_pub test/elfparser_test_dwarfline.c src/elfparser_*.c -o test_dwarfline && ./test_dwarfline
+ */
+
+#include <unistd.h>
+#include "elfparser_test_common.h"
+#include "../inc_pub/elfparser_dwarfline.h"
+
+#define TEST_BUF_MAX        1024u /**< Largest unit or string section */
+#define TEST_SHT_PROGBITS   1u    /**< sh_type of the debug sections */
+#define TEST_LINE_BASE      (-5)  /**< line_base of every unit */
+#define TEST_LINE_RANGE     14u   /**< line_range of every unit */
+#define TEST_OPCODE_BASE    13u   /**< opcode_base of every unit */
+
+/**
+ * @brief A byte buffer assembled in the target byte order
+ */
+typedef struct test_buf_s
+{
+    uint8_t     data[TEST_BUF_MAX]; /**< Bytes */
+    size_t      len;                /**< Bytes written */
+    int         big_endian;         /**< Byte order of multi-byte values */
+} test_buf_t;
+
+/**
+ * @brief Offsets inside an assembled unit, from the start of the unit
+ */
+typedef struct test_marks_s
+{
+    size_t      program;     /**< First byte of the line program */
+    size_t      seq_end;     /**< One past the first DW_LNE_end_sequence */
+    size_t      operand[2];  /**< Inside an extended and a LEB128 operand */
+} test_marks_t;
+
+/**
+ * @brief One expected lookup result
+ */
+typedef struct test_probe_s
+{
+    uint64_t    addr;       /**< Address to resolve */
+    const char* file_name;  /**< Expected file name, NULL for ELFPARSER_ERR_NOT_FOUND */
+    uint32_t    line;       /**< Expected line */
+    uint64_t    row_addr;   /**< Expected first address of the row */
+} test_probe_t;
+
+static const test_probe_t test_probes[] = {
+    { 0x07ff, NULL, 0, 0 },
+    { 0x0800, "d.c", 1, 0x0800 },                   // DW_LNE_define_file
+    { 0x080f, "d.c", 1, 0x0800 },
+    { 0x0810, NULL, 0, 0 },                         // End of the lower sequence
+    { 0x0fff, NULL, 0, 0 },
+    { 0x1000, "a.c", 3, 0x1000 },                   // Special opcode, no address advance
+    { 0x1003, "a.c", 3, 0x1000 },
+    { 0x1004, "a.c", 4, 0x1004 },                   // Special opcode advancing both
+    { 0x100b, "a.c", 4, 0x1004 },
+    { 0x100c, "inc/b.h", 14, 0x100c },              // set_file, advance_line, advance_pc, copy
+    { 0x101f, "inc/b.h", 14, 0x100c },              // const_add_pc and fixed_advance_pc reach 0x1020
+    { 0x1020, NULL, 0, 0 },
+    { 0x1fff, NULL, 0, 0 },
+    { 0x2000, "/src/m.c", 5, 0x2000 },              // DWARF 5: file 0, directory 0 from .debug_line_str
+    { 0x2005, "/src/m.c", 5, 0x2000 },
+    { 0x2006, "/src/lib/u.h", 3, 0x2006 },          // Relative directory under directory 0
+    { 0x2007, "/src/lib/u.h", 3, 0x2006 },
+    { 0x2008, NULL, 0, 0 },
+    { UINT64_MAX, NULL, 0, 0 },
+};
+
+static const uint8_t test_std_lens[TEST_OPCODE_BASE - 1u] = { 0, 1, 1, 1, 1, 0, 0, 0, 1, 0, 0, 1 };
+
+/**
+ * @brief Appends a fixed-size value
+ * @param[in,out] buf Buffer
+ * @param[in] value Value
+ * @param[in] size Size in bytes
+ */
+static void Test_put(test_buf_t *buf, uint64_t value, size_t size)
+{
+    Test_store(buf->data + buf->len, value, size, buf->big_endian);
+    buf->len += size;
+}
+
+/**
+ * @brief Appends an unsigned LEB128 value
+ * @param[in,out] buf Buffer
+ * @param[in] value Value
+ */
+static void Test_putUleb(test_buf_t *buf, uint64_t value)
+{
+    do
+    {
+        uint8_t byte = value & 0x7fu;
+        value >>= 7;
+        buf->data[buf->len++] = byte | (value ? 0x80u : 0u);
+    } while (value);
+}
+
+/**
+ * @brief Appends a NUL-terminated string
+ * @param[in,out] buf Buffer
+ * @param[in] str String
+ */
+static void Test_putStr(test_buf_t *buf, const char *str)
+{
+    memcpy(buf->data + buf->len, str, strlen(str) + 1);
+    buf->len += strlen(str) + 1;
+}
+
+/**
+ * @brief Appends a DW_LNE_set_address
+ * @param[in,out] buf Buffer
+ * @param[in] addr Address
+ * @param[in] addr_size Size of the address operand
+ */
+static void Test_putSetAddress(test_buf_t *buf, uint64_t addr, size_t addr_size)
+{
+    Test_put(buf, 0, 1);
+    Test_putUleb(buf, 1u + addr_size);
+    Test_put(buf, 0x02, 1);
+    Test_put(buf, addr, addr_size);
+}
+
+/**
+ * @brief Appends the special opcode that advances the address and line
+ * @param[in,out] buf Buffer
+ * @param[in] addr_adv Address advance
+ * @param[in] line_adv Line advance, within line_base and line_base + line_range - 1
+ */
+static void Test_putSpecial(test_buf_t *buf, uint32_t addr_adv, int32_t line_adv)
+{
+    Test_put(buf, TEST_OPCODE_BASE + (uint32_t)(line_adv - TEST_LINE_BASE) + TEST_LINE_RANGE * addr_adv, 1);
+}
+
+/**
+ * @brief Starts a unit: writes its initial length placeholder and version
+ * @param[in,out] buf Buffer
+ * @param[in] offset_size 4 or 8 for the 32-bit or 64-bit DWARF format
+ * @param[in] version Version
+ * @return size_t Offset of the first byte the length covers
+ */
+static size_t Test_unitBegin(test_buf_t *buf, size_t offset_size, uint32_t version)
+{
+    if (offset_size == 8u)
+    {
+        Test_put(buf, 0xffffffffu, 4);
+    }
+    Test_put(buf, 0, offset_size);
+    size_t body = buf->len;
+    Test_put(buf, version, 2);
+    return body;
+}
+
+/**
+ * @brief Writes the header fields from minimum_instruction_length through standard_opcode_lengths
+ * @param[in,out] buf Buffer
+ * @param[in] version Version, 4 and above carry maximum_operations_per_instruction
+ */
+static void Test_putHeaderFields(test_buf_t *buf, uint32_t version)
+{
+    Test_put(buf, 1, 1);  // minimum_instruction_length
+    if (version >= 4u)
+    {
+        Test_put(buf, 1, 1);  // maximum_operations_per_instruction
+    }
+    Test_put(buf, 1, 1);  // default_is_stmt
+    Test_put(buf, (uint8_t)TEST_LINE_BASE, 1);
+    Test_put(buf, TEST_LINE_RANGE, 1);
+    Test_put(buf, TEST_OPCODE_BASE, 1);
+    memcpy(buf->data + buf->len, test_std_lens, sizeof(test_std_lens));
+    buf->len += sizeof(test_std_lens);
+}
+
+/**
+ * @brief Fills the initial length and header_length placeholders of a finished unit
+ * @param[in,out] buf Buffer
+ * @param[in] body Offset returned by Test_unitBegin()
+ * @param[in] header_length_at Offset of header_length
+ * @param[in] program Offset of the first program byte
+ * @param[in] offset_size 4 or 8
+ */
+static void Test_unitEnd(test_buf_t *buf, size_t body, size_t header_length_at, size_t program, size_t offset_size)
+{
+    Test_store(buf->data + body - offset_size, buf->len - body, offset_size, buf->big_endian);
+    Test_store(buf->data + header_length_at, program - header_length_at - offset_size, offset_size, buf->big_endian);
+}
+
+/**
+ * @brief Assembles the DWARF 4 unit
+ * @param[in,out] buf Buffer receiving the unit
+ * @param[in] addr_size Size of a target address
+ * @param[in] offset_size 4 or 8
+ * @param[out] marks Offsets inside the unit
+ */
+static void Test_unitV4(test_buf_t *buf, size_t addr_size, size_t offset_size, test_marks_t *marks)
+{
+    size_t unit = buf->len;
+    size_t body = Test_unitBegin(buf, offset_size, 4);
+    size_t header_length_at = buf->len;
+    Test_put(buf, 0, offset_size);
+    Test_putHeaderFields(buf, 4);
+    Test_putStr(buf, "inc");
+    Test_putStr(buf, "");           // End of include_directories
+    Test_putStr(buf, "a.c");        // File 1
+    Test_putUleb(buf, 0);
+    Test_putUleb(buf, 0);
+    Test_putUleb(buf, 0);
+    Test_putStr(buf, "b.h");        // File 2, under include directory 1
+    Test_putUleb(buf, 1);
+    Test_putUleb(buf, 0x5f0000);    // Multi-byte modification time
+    Test_putUleb(buf, 300);
+    Test_putStr(buf, "");           // End of file_names
+    size_t program = buf->len;
+
+    Test_putSetAddress(buf, 0x1000, addr_size);
+    marks->operand[0] = buf->len - 1u;  // Cut before the last address byte
+    Test_putSpecial(buf, 0, 2);     // 0x1000 line 3
+    Test_putSpecial(buf, 4, 1);     // 0x1004 line 4
+    Test_put(buf, 0x04, 1);         // DW_LNS_set_file 2
+    Test_putUleb(buf, 2);
+    Test_put(buf, 0x03, 1);         // DW_LNS_advance_line +10
+    Test_putUleb(buf, 10);
+    Test_put(buf, 0x05, 1);         // DW_LNS_set_column
+    Test_putUleb(buf, 200);
+    Test_put(buf, 0x06, 1);         // DW_LNS_negate_stmt
+    Test_put(buf, 0x07, 1);         // DW_LNS_set_basic_block
+    Test_put(buf, 0x02, 1);         // DW_LNS_advance_pc 8
+    Test_putUleb(buf, 8);
+    Test_put(buf, 0x01, 1);         // DW_LNS_copy: 0x100c
+    Test_put(buf, 0x08, 1);         // DW_LNS_const_add_pc: +17
+    Test_put(buf, 0x09, 1);         // DW_LNS_fixed_advance_pc 3
+    Test_put(buf, 3, 2);
+    Test_put(buf, 0, 1);            // DW_LNE_end_sequence at 0x1020
+    Test_putUleb(buf, 1);
+    Test_put(buf, 0x01, 1);
+    marks->seq_end = buf->len - unit;
+
+    Test_putSetAddress(buf, 0x0800, addr_size);
+    Test_put(buf, 0, 1);            // DW_LNE_define_file "d.c" as file 3
+    Test_putUleb(buf, 1u + 4u + 3u);
+    Test_put(buf, 0x03, 1);
+    Test_putStr(buf, "d.c");
+    Test_putUleb(buf, 0);
+    Test_putUleb(buf, 0);
+    Test_putUleb(buf, 0);
+    Test_put(buf, 0x04, 1);         // DW_LNS_set_file 3
+    Test_putUleb(buf, 3);
+    Test_put(buf, 0x01, 1);         // DW_LNS_copy: 0x0800 line 1
+    Test_put(buf, 0x02, 1);         // DW_LNS_advance_pc 0x10
+    marks->operand[1] = buf->len;
+    Test_putUleb(buf, 0x10);
+    Test_put(buf, 0, 1);            // DW_LNE_end_sequence at 0x0810
+    Test_putUleb(buf, 1);
+    Test_put(buf, 0x01, 1);
+
+    marks->program = program - unit;
+    marks->operand[0] -= unit;
+    marks->operand[1] -= unit;
+    Test_unitEnd(buf, body, header_length_at, program, offset_size);
+}
+
+/**
+ * @brief Assembles the DWARF 5 unit
+ * @param[in,out] buf Buffer receiving the unit
+ * @param[in,out] line_str Buffer receiving .debug_line_str
+ * @param[in] addr_size Size of a target address
+ * @param[in] offset_size 4 or 8
+ * @param[out] marks Offsets inside the unit
+ */
+static void Test_unitV5(test_buf_t *buf, test_buf_t *line_str, size_t addr_size, size_t offset_size, test_marks_t *marks)
+{
+    static const uint8_t md5[16] = { 0 };
+    size_t unit = buf->len;
+    size_t body = Test_unitBegin(buf, offset_size, 5);
+    Test_put(buf, addr_size, 1);
+    Test_put(buf, 0, 1);            // segment_selector_size
+    size_t header_length_at = buf->len;
+    Test_put(buf, 0, offset_size);
+    Test_putHeaderFields(buf, 5);
+
+    Test_put(buf, 1, 1);            // directory_entry_format: path as line_strp
+    Test_putUleb(buf, 0x01);
+    Test_putUleb(buf, 0x1f);
+    Test_putUleb(buf, 2);
+    Test_put(buf, line_str->len, offset_size);
+    Test_putStr(line_str, "/src");
+    Test_put(buf, line_str->len, offset_size);
+    Test_putStr(line_str, "lib");
+
+    Test_put(buf, 3, 1);            // file_name_entry_format: inline path, udata directory, data16 MD5
+    Test_putUleb(buf, 0x01);
+    Test_putUleb(buf, 0x08);
+    Test_putUleb(buf, 0x02);
+    Test_putUleb(buf, 0x0f);
+    Test_putUleb(buf, 0x05);
+    Test_putUleb(buf, 0x1e);
+    Test_putUleb(buf, 2);
+    Test_putStr(buf, "m.c");
+    Test_putUleb(buf, 0);
+    memcpy(buf->data + buf->len, md5, sizeof(md5));
+    buf->len += sizeof(md5);
+    Test_putStr(buf, "u.h");
+    Test_putUleb(buf, 1);
+    memcpy(buf->data + buf->len, md5, sizeof(md5));
+    buf->len += sizeof(md5);
+    size_t program = buf->len;
+
+    Test_putSetAddress(buf, 0x2000, addr_size);
+    marks->operand[0] = buf->len - 1u;  // Cut before the last address byte
+    Test_put(buf, 0x04, 1);         // DW_LNS_set_file 0
+    Test_putUleb(buf, 0);
+    Test_putSpecial(buf, 0, 4);     // 0x2000 line 5
+    Test_put(buf, 0x04, 1);         // DW_LNS_set_file 1
+    Test_putUleb(buf, 1);
+    Test_putSpecial(buf, 6, -2);    // 0x2006 line 3
+    Test_put(buf, 0x02, 1);         // DW_LNS_advance_pc 2
+    Test_putUleb(buf, 2);
+    marks->operand[1] = buf->len - 1u;
+    Test_put(buf, 0, 1);            // DW_LNE_end_sequence at 0x2008
+    Test_putUleb(buf, 1);
+    Test_put(buf, 0x01, 1);
+    marks->seq_end = buf->len - unit;
+
+    marks->program = program - unit;
+    marks->operand[0] -= unit;
+    marks->operand[1] -= unit;
+    Test_unitEnd(buf, body, header_length_at, program, offset_size);
+}
+
+/**
+ * @brief Writes an image with the given debug sections to a temporary file and opens its line tables
+ * @param[out] file File structure, released with ElfParser_File_close()
+ * @param[out] dwarf_line Line table structure, released with ElfParser_DwarfLine_close()
+ * @param[in] line .debug_line contents
+ * @param[in] line_str .debug_line_str contents, NULL for none
+ * @param[in] is_64bit Nonzero for ELFCLASS64
+ * @param[in] big_endian Nonzero for ELFDATA2MSB
+ * @return int Result of ElfParser_DwarfLine_open(), ELFPARSER_ERR_IO if the image cannot be written
+ */
+static int Test_open(elfparser_file_t *file, elfparser_dwarfline_t *dwarf_line, const test_buf_t *line, const test_buf_t *line_str,
+                     int is_64bit, int big_endian)
+{
+    const test_sect_t sects[] = {
+        { ".debug_line", TEST_SHT_PROGBITS, 0, 0, 0, 0, line->data, line->len },
+        { ".debug_line_str", TEST_SHT_PROGBITS, 0x30, 0, 0, 1, line_str ? line_str->data : NULL, line_str ? line_str->len : 0 },
+    };
+    char path[] = "/tmp/elfparser_test_dwarfline.XXXXXX";
+    test_elf_t elf;
+
+    if (Test_elfBuild(&elf, sects, line_str ? 2u : 1u, is_64bit, big_endian, 0) != 0)
+    {
+        return ELFPARSER_ERR_MALLOC;
+    }
+    int fd = mkstemp(path);
+    int written = (fd >= 0) && write(fd, elf.data, elf.size) == (ssize_t)elf.size;
+    free(elf.data);
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+    int ret = written ? ElfParser_File_open(file, path, ELFPARSER_FILE_FLAG_NONE) : ELFPARSER_ERR_IO;
+    if (fd >= 0)
+    {
+        unlink(path);  // The open file keeps its contents
+    }
+    if (ret != ELFPARSER_SUCCESS)
+    {
+        return ret;
+    }
+    ret = ElfParser_DwarfLine_open(dwarf_line, file);
+    if (ret != ELFPARSER_SUCCESS)
+    {
+        ElfParser_File_close(file);
+    }
+    return ret;
+}
+
+/**
+ * @brief Closes what Test_open() opened
+ * @param[in,out] file File structure
+ * @param[in,out] dwarf_line Line table structure
+ */
+static void Test_close(elfparser_file_t *file, elfparser_dwarfline_t *dwarf_line)
+{
+    TEST_CHECK(ElfParser_DwarfLine_close(dwarf_line) == ELFPARSER_SUCCESS);
+    TEST_CHECK(ElfParser_File_close(file) == ELFPARSER_SUCCESS);
+}
+
+/**
+ * @brief Checks one lookup result against a probe
+ * @param[in] probe Expected result
+ * @param[in] ret Return value of the lookup
+ * @param[in] loc Location filled by the lookup
+ * @return int 1 if it matches
+ */
+static int Test_probeMatch(const test_probe_t *probe, int ret, const elfparser_dwarfline_loc_t *loc)
+{
+    if (!probe->file_name)
+    {
+        return ret == ELFPARSER_ERR_NOT_FOUND;
+    }
+    return ret == ELFPARSER_SUCCESS && strcmp(loc->file_name, probe->file_name) == 0 && loc->line == probe->line &&
+           loc->row_addr == probe->row_addr;
+}
+
+/**
+ * @brief Checks lookups on the image holding both well-formed units
+ * @param[in] is_64bit Nonzero for ELFCLASS64
+ * @param[in] big_endian Nonzero for ELFDATA2MSB
+ * @param[in] offset_size 4 or 8 for the DWARF format of both units
+ */
+static void Test_units(int is_64bit, int big_endian, size_t offset_size)
+{
+    const size_t probe_num = sizeof(test_probes) / sizeof(test_probes[0]);
+    size_t addr_size = is_64bit ? 8u : 4u;
+    test_buf_t line = { .big_endian = big_endian };
+    test_buf_t line_str = { .big_endian = big_endian };
+    test_marks_t marks;
+    elfparser_file_t file;
+    elfparser_dwarfline_t dwarf_line;
+    elfparser_dwarfline_loc_t loc;
+
+    Test_unitV4(&line, addr_size, offset_size, &marks);
+    Test_unitV5(&line, &line_str, addr_size, offset_size, &marks);
+    TEST_CHECK(Test_open(&file, &dwarf_line, &line, &line_str, is_64bit, big_endian) == ELFPARSER_SUCCESS);
+    TEST_CHECK(dwarf_line.unit_num == 0);  // No .debug_aranges: nothing is read until the first miss
+    for (size_t i = 0; i < probe_num; i++)
+    {
+        memset(&loc, 0, sizeof(loc));
+        int ret = ElfParser_DwarfLine_lookup(&dwarf_line, test_probes[i].addr, &loc);
+        TEST_CHECK(Test_probeMatch(&test_probes[i], ret, &loc));
+    }
+    TEST_CHECK(dwarf_line.swept && dwarf_line.unit_num == 2);
+    TEST_CHECK(dwarf_line.units[0].state == ELFPARSER_DWARFLINE_UNIT_DECODED && dwarf_line.units[0].row_num == 6);
+    TEST_CHECK(dwarf_line.units[1].state == ELFPARSER_DWARFLINE_UNIT_DECODED && dwarf_line.units[1].row_num == 3);
+    TEST_CHECK(dwarf_line.units[0].rows[0].row_addr == 0x0800);  // Sequences sorted by address
+    TEST_CHECK(dwarf_line.units[0].rows[1].row_file == ELFPARSER_DWARFLINE_FILE_END);
+
+    uint64_t addrs[sizeof(test_probes) / sizeof(test_probes[0])];
+    elfparser_dwarfline_loc_t locs[sizeof(test_probes) / sizeof(test_probes[0])];
+    int status[sizeof(test_probes) / sizeof(test_probes[0])];
+    for (size_t i = 0; i < probe_num; i++)
+    {
+        addrs[i] = test_probes[probe_num - 1u - i].addr;  // Descending, so no row hint carries over
+    }
+    TEST_CHECK(ElfParser_DwarfLine_batchLookup(&dwarf_line, addrs, probe_num, locs, status) == ELFPARSER_SUCCESS);
+    for (size_t i = 0; i < probe_num; i++)
+    {
+        TEST_CHECK(Test_probeMatch(&test_probes[probe_num - 1u - i], status[i], &locs[i]));
+    }
+    for (size_t i = 0; i < probe_num; i++)
+    {
+        addrs[i] = test_probes[i].addr;
+    }
+    TEST_CHECK(ElfParser_DwarfLine_batchLookup(&dwarf_line, addrs, probe_num, locs, status) == ELFPARSER_SUCCESS);
+    for (size_t i = 0; i < probe_num; i++)
+    {
+        TEST_CHECK(Test_probeMatch(&test_probes[i], status[i], &locs[i]));
+    }
+    TEST_CHECK(ElfParser_DwarfLine_lookup(&dwarf_line, 0x1000, NULL) == ELFPARSER_ERR_NULL);
+    Test_close(&file, &dwarf_line);
+}
+
+/**
+ * @brief Cuts one unit at every length and checks what survives
+ * @param[in] is_64bit Nonzero for ELFCLASS64
+ * @param[in] big_endian Nonzero for ELFDATA2MSB
+ * @param[in] version 4 or 5
+ */
+static void Test_cuts(int is_64bit, int big_endian, uint32_t version)
+{
+    size_t addr_size = is_64bit ? 8u : 4u;
+    test_buf_t whole = { .big_endian = big_endian };
+    test_buf_t line_str = { .big_endian = big_endian };
+    test_marks_t marks;
+    elfparser_dwarfline_loc_t loc;
+    const uint64_t first_addr = (version == 5u) ? 0x2000 : 0x1000;  // First row of the first sequence
+
+    if (version == 5u)
+    {
+        Test_unitV5(&whole, &line_str, addr_size, 4, &marks);
+    }
+    else
+    {
+        Test_unitV4(&whole, addr_size, 4, &marks);
+    }
+    for (size_t cut = 4u + 2u; cut <= whole.len; cut++)  // From just the length and version to the whole unit
+    {
+        test_buf_t line = whole;
+        elfparser_file_t file;
+        elfparser_dwarfline_t dwarf_line;
+
+        line.len = cut;
+        Test_store(line.data, cut - 4u, 4, big_endian);  // The unit ends at the cut
+        if (Test_open(&file, &dwarf_line, &line, &line_str, is_64bit, big_endian) != ELFPARSER_SUCCESS)
+        {
+            TEST_CHECK(!"opens");
+            continue;
+        }
+        int first = ElfParser_DwarfLine_lookup(&dwarf_line, first_addr, &loc);
+        TEST_CHECK(first == ELFPARSER_SUCCESS || first == ELFPARSER_ERR_NOT_FOUND);
+        TEST_CHECK(dwarf_line.unit_num == 1);
+        const elfparser_dwarfline_unit_t *unit = &dwarf_line.units[0];
+        if (cut < marks.program)
+        {
+            TEST_CHECK(unit->state == ELFPARSER_DWARFLINE_UNIT_INVALID);  // Truncated header
+        }
+        if (cut == marks.operand[0] || cut == marks.operand[1])
+        {
+            TEST_CHECK(unit->state == ELFPARSER_DWARFLINE_UNIT_INVALID);  // Truncated operand
+        }
+        if (unit->state == ELFPARSER_DWARFLINE_UNIT_INVALID)
+        {
+            TEST_CHECK(unit->row_num == 0 && !unit->rows);
+            TEST_CHECK(first == ELFPARSER_ERR_NOT_FOUND);
+        }
+        else
+        {
+            TEST_CHECK(unit->state == ELFPARSER_DWARFLINE_UNIT_DECODED);
+            TEST_CHECK((first == ELFPARSER_SUCCESS) == (cut >= marks.seq_end));  // Only whole sequences are kept
+        }
+        if (cut == marks.seq_end)
+        {
+            TEST_CHECK(unit->state == ELFPARSER_DWARFLINE_UNIT_DECODED && first == ELFPARSER_SUCCESS);
+            TEST_CHECK(ElfParser_DwarfLine_lookup(&dwarf_line, 0x0800, &loc) == ELFPARSER_ERR_NOT_FOUND);
+        }
+        Test_close(&file, &dwarf_line);
+    }
+}
+
+/**
+ * @brief Checks that malformed header fields make a unit invalid without affecting the one after it
+ * @param[in] is_64bit Nonzero for ELFCLASS64
+ * @param[in] big_endian Nonzero for ELFDATA2MSB
+ */
+static void Test_badHeaders(int is_64bit, int big_endian)
+{
+    size_t addr_size = is_64bit ? 8u : 4u;
+    elfparser_dwarfline_loc_t loc;
+
+    for (int variant = 0; variant < 5; variant++)
+    {
+        test_buf_t line = { .big_endian = big_endian };
+        test_buf_t line_str = { .big_endian = big_endian };
+        test_marks_t marks;
+        elfparser_file_t file;
+        elfparser_dwarfline_t dwarf_line;
+
+        Test_unitV4(&line, addr_size, 4, &marks);
+        size_t v4_len = line.len;
+        Test_unitV5(&line, &line_str, addr_size, 4, &marks);
+        switch (variant)
+        {
+            case 0: Test_store(line.data + 4, 1, 2, big_endian); break;                  // Version 1
+            case 1: Test_store(line.data + 4, 6, 2, big_endian); break;                  // Version 6
+            case 2: line.data[4 + 2 + 4 + 4] = 0; break;                                 // line_range 0
+            case 3: Test_store(line.data + 6, v4_len, 4, big_endian); break;             // header_length past the unit
+            default: line.data[4 + 2 + 4 + 5] = 0; break;                                // opcode_base 0
+        }
+        if (Test_open(&file, &dwarf_line, &line, &line_str, is_64bit, big_endian) != ELFPARSER_SUCCESS)
+        {
+            TEST_CHECK(!"opens");
+            continue;
+        }
+        TEST_CHECK(ElfParser_DwarfLine_lookup(&dwarf_line, 0x1000, &loc) == ELFPARSER_ERR_NOT_FOUND);
+        TEST_CHECK(dwarf_line.unit_num == 2 && dwarf_line.units[0].state == ELFPARSER_DWARFLINE_UNIT_INVALID);
+        TEST_CHECK(ElfParser_DwarfLine_lookup(&dwarf_line, 0x2006, &loc) == ELFPARSER_SUCCESS &&
+                   strcmp(loc.file_name, "/src/lib/u.h") == 0 && loc.line == 3);
+        Test_close(&file, &dwarf_line);
+    }
+
+    test_buf_t line = { .big_endian = big_endian };  // Initial length past the section: nothing can be located
+    test_marks_t marks;
+    elfparser_file_t file;
+    elfparser_dwarfline_t dwarf_line;
+    Test_unitV4(&line, addr_size, 4, &marks);
+    Test_store(line.data, line.len, 4, big_endian);
+    if (Test_open(&file, &dwarf_line, &line, NULL, is_64bit, big_endian) == ELFPARSER_SUCCESS)
+    {
+        TEST_CHECK(ElfParser_DwarfLine_lookup(&dwarf_line, 0x1000, &loc) == ELFPARSER_ERR_NOT_FOUND);
+        TEST_CHECK(dwarf_line.swept && dwarf_line.unit_num == 0);
+        Test_close(&file, &dwarf_line);
+    }
+    else
+    {
+        TEST_CHECK(!"opens");
+    }
+}
+
+int main(void)
+{
+    for (int layout = 0; layout < 4; layout++)
+    {
+        int is_64bit = layout & 1;
+        int big_endian = layout >> 1;
+        Test_units(is_64bit, big_endian, 4);
+        Test_units(is_64bit, big_endian, 8);
+        Test_cuts(is_64bit, big_endian, 4);
+        Test_cuts(is_64bit, big_endian, 5);
+        Test_badHeaders(is_64bit, big_endian);
+    }
+    return Test_report("test_dwarfline");
+}
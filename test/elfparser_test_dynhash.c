@@ -0,0 +1,253 @@
+/**
+ * @file elfparser_test_dynhash.c
+ * @brief Tests symbol lookups through .gnu.hash and SHT_HASH tables
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * Builds .dynsym, .dynstr and the hash tables the way a linker lays them
+ * out, hashing names with reference implementations kept in this file, and
+ * checks that every defined symbol is found at its index while absent and
+ * undefined names come back as ELFPARSER_ERR_NOT_FOUND. The bloom filter is
+ * kept small so some absent names pass it and are rejected by the chains.
+ *
+ * Build and run from the repository root:
+ *   cc -O2 -pthread -Iinc_pub test/elfparser_test_dynhash.c src/elfparser_*.c -o test_dynhash && ./test_dynhash
+ */
+
+#include "elfparser_test_common.h"
+#include "../inc_pub/elfparser_dynhash.h"
+
+#define TEST_DEF_NUM          8u   /**< Defined symbols */
+#define TEST_DYNSYM_NUM       (TEST_DEF_NUM + 2u)  /**< Null symbol, one undefined symbol and the defined ones */
+#define TEST_GNU_SYM_OFF      2u   /**< First symbol covered by .gnu.hash */
+#define TEST_GNU_BUCKET_NUM   3u   /**< .gnu.hash buckets */
+#define TEST_GNU_BLOOM_SIZE   2u   /**< .gnu.hash bloom words */
+#define TEST_GNU_BLOOM_SHIFT  6u   /**< .gnu.hash second bloom hash shift */
+#define TEST_SYSV_BUCKET_NUM  3u   /**< SHT_HASH buckets */
+
+#define TEST_HASH_GNU         0x1u /**< Image carries .gnu.hash */
+#define TEST_HASH_SYSV        0x2u /**< Image carries SHT_HASH */
+#define TEST_HASH_SYSV_WIDE   0x4u /**< SHT_HASH uses 8-byte words (sh_entsize 8) */
+
+static const char *const test_def_name[TEST_DEF_NUM] = { "malloc", "free", "printf", "ElfParser_init",
+                                                          "memcpy", "strlen", "_start", "environ" };
+static const char test_undef_name[] = "puts";  /**< Imported symbol, present in .dynsym but undefined */
+static const char *const test_miss_name[] = { "", "calloc", "mallo", "malloc_", "FREE", "ElfParser_fini",
+                                              "strnlen", "environment", "_end", "main" };
+
+/**
+ * @brief Reference GNU hash (h = h * 33 + c, seeded with 5381)
+ * @param[in] name Null-terminated name
+ * @return uint32_t Hash value
+ */
+static uint32_t Test_gnuHash(const char *name)
+{
+    uint32_t hash = 5381u;
+    for (const unsigned char *c = (const unsigned char *)name; *c; c++)
+    {
+        hash = hash * 33u + *c;
+    }
+    return hash;
+}
+
+/**
+ * @brief Reference System V ELF hash
+ * @param[in] name Null-terminated name
+ * @return uint32_t Hash value
+ */
+static uint32_t Test_sysvHash(const char *name)
+{
+    uint32_t hash = 0;
+    for (const unsigned char *c = (const unsigned char *)name; *c; c++)
+    {
+        hash = (hash << 4) + *c;
+        uint32_t high = hash & 0xf0000000u;
+        hash ^= high >> 24;
+        hash &= ~high;
+    }
+    return hash;
+}
+
+/**
+ * @brief Builds an image with the requested hash tables and checks hits and misses
+ * @param[in] is_64bit Non-zero for ELFCLASS64
+ * @param[in] big_endian Non-zero for ELFDATA2MSB
+ * @param[in] tables TEST_HASH_* values
+ */
+static void Test_dynHashCheck(int is_64bit, int big_endian, uint32_t tables)
+{
+    const size_t sym_size = Test_symEntrySize(is_64bit);
+    const size_t bloom_word = is_64bit ? 8u : 4u;
+    const size_t sysv_word = (tables & TEST_HASH_SYSV_WIDE) ? 8u : 4u;
+    const char *sym_name[TEST_DYNSYM_NUM] = { "", test_undef_name };
+    uint32_t def_of_sym[TEST_DYNSYM_NUM] = { 0 };  // Index into test_def_name of each defined symbol
+    uint8_t dynsym[TEST_DYNSYM_NUM * 24];
+    char dynstr[256];
+    uint8_t gnu[16 + TEST_GNU_BLOOM_SIZE * 8 + (TEST_GNU_BUCKET_NUM + TEST_DEF_NUM) * 4] = { 0 };
+    uint8_t sysv[(2 + TEST_SYSV_BUCKET_NUM + TEST_DYNSYM_NUM) * 8] = { 0 };
+
+    uint32_t sym_num = TEST_GNU_SYM_OFF;
+    for (uint32_t bucket = 0; bucket < TEST_GNU_BUCKET_NUM; bucket++)  // .gnu.hash needs symbols grouped by bucket
+    {
+        for (uint32_t i = 0; i < TEST_DEF_NUM; i++)
+        {
+            if (Test_gnuHash(test_def_name[i]) % TEST_GNU_BUCKET_NUM == bucket)
+            {
+                def_of_sym[sym_num] = i;
+                sym_name[sym_num++] = test_def_name[i];
+            }
+        }
+    }
+
+    size_t str_len = 1;
+    dynstr[0] = '\0';
+    for (uint32_t i = 0; i < TEST_DYNSYM_NUM; i++)
+    {
+        uint32_t name_idx = 0;
+        if (i > 0)
+        {
+            name_idx = (uint32_t)str_len;
+            memcpy(dynstr + str_len, sym_name[i], strlen(sym_name[i]) + 1);
+            str_len += strlen(sym_name[i]) + 1;
+        }
+        uint16_t shndx = (i < TEST_GNU_SYM_OFF) ? 0 : 1;  // Null and imported symbols are undefined
+        uint64_t value = (i < TEST_GNU_SYM_OFF) ? 0 : 0x1000u + 0x10u * def_of_sym[i];
+        Test_symWrite(dynsym + i * sym_size, is_64bit, big_endian, name_idx, i ? 0x12 : 0, shndx, value, i ? 8 : 0);
+    }
+
+    Test_store(gnu, TEST_GNU_BUCKET_NUM, 4, big_endian);
+    Test_store(gnu + 4, TEST_GNU_SYM_OFF, 4, big_endian);
+    Test_store(gnu + 8, TEST_GNU_BLOOM_SIZE, 4, big_endian);
+    Test_store(gnu + 12, TEST_GNU_BLOOM_SHIFT, 4, big_endian);
+    uint64_t bloom[TEST_GNU_BLOOM_SIZE] = { 0 };
+    uint32_t bucket_head[TEST_GNU_BUCKET_NUM] = { 0 };
+    uint8_t *gnu_bucket = gnu + 16 + TEST_GNU_BLOOM_SIZE * bloom_word;
+    uint8_t *gnu_chain = gnu_bucket + TEST_GNU_BUCKET_NUM * 4;
+    const uint32_t bloom_bits = (uint32_t)bloom_word * 8u;
+    for (uint32_t i = TEST_GNU_SYM_OFF; i < TEST_DYNSYM_NUM; i++)
+    {
+        uint32_t hash = Test_gnuHash(sym_name[i]);
+        uint32_t bucket = hash % TEST_GNU_BUCKET_NUM;
+        int last = (i + 1 == TEST_DYNSYM_NUM) || (Test_gnuHash(sym_name[i + 1]) % TEST_GNU_BUCKET_NUM != bucket);
+        bloom[(hash / bloom_bits) % TEST_GNU_BLOOM_SIZE] |= (UINT64_C(1) << (hash % bloom_bits)) |
+                                                           (UINT64_C(1) << ((hash >> TEST_GNU_BLOOM_SHIFT) % bloom_bits));
+        if (!bucket_head[bucket])
+        {
+            bucket_head[bucket] = i;
+        }
+        Test_store(gnu_chain + (i - TEST_GNU_SYM_OFF) * 4, (hash & ~1u) | (last ? 1u : 0u), 4, big_endian);
+    }
+    for (uint32_t i = 0; i < TEST_GNU_BLOOM_SIZE; i++)
+    {
+        Test_store(gnu + 16 + i * bloom_word, bloom[i], bloom_word, big_endian);
+    }
+    for (uint32_t i = 0; i < TEST_GNU_BUCKET_NUM; i++)
+    {
+        Test_store(gnu_bucket + i * 4, bucket_head[i], 4, big_endian);
+    }
+
+    uint32_t sysv_bucket[TEST_SYSV_BUCKET_NUM] = { 0 };
+    Test_store(sysv, TEST_SYSV_BUCKET_NUM, sysv_word, big_endian);
+    Test_store(sysv + sysv_word, TEST_DYNSYM_NUM, sysv_word, big_endian);
+    uint8_t *sysv_chain = sysv + (2 + TEST_SYSV_BUCKET_NUM) * sysv_word;
+    for (uint32_t i = 1; i < TEST_DYNSYM_NUM; i++)  // Push each symbol on the front of its chain
+    {
+        uint32_t bucket = Test_sysvHash(sym_name[i]) % TEST_SYSV_BUCKET_NUM;
+        Test_store(sysv_chain + i * sysv_word, sysv_bucket[bucket], sysv_word, big_endian);
+        sysv_bucket[bucket] = i;
+    }
+    for (uint32_t i = 0; i < TEST_SYSV_BUCKET_NUM; i++)
+    {
+        Test_store(sysv + (2 + i) * sysv_word, sysv_bucket[i], sysv_word, big_endian);
+    }
+
+    test_sect_t sects[4] = {
+        { ".dynsym", ELFPARSER_SECTHEAD_TYPE_DYNSYM, ELFPARSER_SECTHEAD_FLAG_ALLOC, 2, 1, sym_size, dynsym, TEST_DYNSYM_NUM * sym_size },
+        { ".dynstr", ELFPARSER_SECTHEAD_TYPE_STRINGTAB, ELFPARSER_SECTHEAD_FLAG_ALLOC, 0, 0, 0, dynstr, str_len },
+    };
+    uint32_t sect_num = 2;
+    if (tables & TEST_HASH_SYSV)  // Placed first so the GNU preference does not depend on order
+    {
+        sects[sect_num++] = (test_sect_t){ ".hash", ELFPARSER_SECTHEAD_TYPE_HASH, ELFPARSER_SECTHEAD_FLAG_ALLOC, 1, 0, sysv_word,
+                                           sysv, (2 + TEST_SYSV_BUCKET_NUM + TEST_DYNSYM_NUM) * sysv_word };
+    }
+    if (tables & TEST_HASH_GNU)
+    {
+        sects[sect_num++] = (test_sect_t){ ".gnu.hash", ELFPARSER_SECTHEAD_TYPE_GNU_HASH, ELFPARSER_SECTHEAD_FLAG_ALLOC, 1, 0, 0,
+                                           gnu, 16 + TEST_GNU_BLOOM_SIZE * bloom_word + (TEST_GNU_BUCKET_NUM + TEST_DEF_NUM) * 4 };
+    }
+
+    test_elf_t elf;
+    elfparser_header_t header;
+    elfparser_secthead_t sect_head;
+    elfparser_dynhash_t dyn_hash;
+    if (Test_elfBuild(&elf, sects, sect_num, is_64bit, big_endian, 0) < 0)
+    {
+        TEST_CHECK(!"image built");
+        return;
+    }
+    int ret = Test_elfOpen(&header, &sect_head, &elf, NULL);
+    TEST_CHECK(ret == ELFPARSER_SUCCESS);
+    if (ret == ELFPARSER_SUCCESS)
+    {
+        ret = ElfParser_DynHash_setup(&dyn_hash, &sect_head, elf.data, elf.size);
+    }
+    if (!(tables & (TEST_HASH_GNU | TEST_HASH_SYSV)))
+    {
+        TEST_CHECK(ret == ELFPARSER_ERR_NOT_FOUND);  // No table to set up from
+        ElfParser_SectHead_free(&sect_head);
+        free(elf.data);
+        return;
+    }
+    TEST_CHECK(ret == ELFPARSER_SUCCESS);
+    if (ret != ELFPARSER_SUCCESS)
+    {
+        ElfParser_SectHead_free(&sect_head);
+        free(elf.data);
+        return;
+    }
+    TEST_CHECK(dyn_hash.hash_type == ((tables & TEST_HASH_GNU) ? ELFPARSER_DYNHASH_TYPE_GNU : ELFPARSER_DYNHASH_TYPE_SYSV));
+
+    for (uint32_t i = TEST_GNU_SYM_OFF; i < TEST_DYNSYM_NUM; i++)  // Every defined symbol is found at its index
+    {
+        elfparser_symtable_entry_t entry;
+        TEST_CHECK(ElfParser_DynHash_lookup(&dyn_hash, sym_name[i], &entry) == (int64_t)i);
+        TEST_CHECK(entry.sym_name && strcmp(entry.sym_name, sym_name[i]) == 0 && entry.sym_name_len == strlen(sym_name[i]));
+        TEST_CHECK(entry.sym_value == 0x1000u + 0x10u * def_of_sym[i] && entry.sym_sect_idx == 1);
+        TEST_CHECK(ElfParser_DynHash_lookup(&dyn_hash, sym_name[i], NULL) == (int64_t)i);  // Entry is optional
+    }
+    TEST_CHECK(ElfParser_DynHash_lookup(&dyn_hash, test_undef_name, NULL) == ELFPARSER_ERR_NOT_FOUND);  // Imported only
+    for (size_t i = 0; i < sizeof(test_miss_name) / sizeof(test_miss_name[0]); i++)
+    {
+        TEST_CHECK(ElfParser_DynHash_lookup(&dyn_hash, test_miss_name[i], NULL) == ELFPARSER_ERR_NOT_FOUND);
+    }
+
+    elfparser_secthead_entry_t *dynsym_head = &sect_head.table[1];
+    dynsym_head->sh_entsize = Test_symEntrySize(!is_64bit);  // Entries of the other class
+    TEST_CHECK(ElfParser_DynHash_setup(&dyn_hash, &sect_head, elf.data, elf.size) == ELFPARSER_ERR_FORMAT);
+    dynsym_head->sh_entsize = sym_size + 8;
+    TEST_CHECK(ElfParser_DynHash_setup(&dyn_hash, &sect_head, elf.data, elf.size) == ELFPARSER_ERR_FORMAT);
+    dynsym_head->sh_entsize = sym_size;
+    dynsym_head->sh_type = ELFPARSER_SECTHEAD_TYPE_PROGBITS;  // Link no longer names a symbol table
+    TEST_CHECK(ElfParser_DynHash_setup(&dyn_hash, &sect_head, elf.data, elf.size) == ELFPARSER_ERR_RANGE);
+    dynsym_head->sh_type = ELFPARSER_SECTHEAD_TYPE_SYMTAB;  // A full symbol table is accepted
+    TEST_CHECK(ElfParser_DynHash_setup(&dyn_hash, &sect_head, elf.data, elf.size) == ELFPARSER_SUCCESS);
+    ElfParser_SectHead_free(&sect_head);
+    free(elf.data);
+}
+
+int main(void)
+{
+    static const uint32_t tables[] = { TEST_HASH_GNU, TEST_HASH_SYSV, TEST_HASH_SYSV | TEST_HASH_SYSV_WIDE,
+                                       TEST_HASH_GNU | TEST_HASH_SYSV, 0 };
+
+    for (int layout = 0; layout < 4; layout++)  // 32/64-bit x little/big-endian
+    {
+        for (size_t i = 0; i < sizeof(tables) / sizeof(tables[0]); i++)
+        {
+            Test_dynHashCheck(layout & 1, layout >> 1, tables[i]);
+        }
+    }
+    return Test_report("test_dynhash");
+}
@@ -0,0 +1,196 @@
+/**
+ * @file elfparser_test_extnum.c
+ * @brief Tests extended section numbering: e_shnum 0, SHN_XINDEX and SHT_SYMTAB_SHNDX
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * Builds images whose e_shnum is 0 and e_shstrndx is SHN_XINDEX, with the
+ * real values in section header 0, and checks that the header parse picks
+ * them up. The large image has more sections than st_shndx can name, so a
+ * symbol defined past 0xff00 escapes to SHN_XINDEX and its section index is
+ * read back from the SHT_SYMTAB_SHNDX section. A header with e_shnum 0 and
+ * no section header table sets up an empty table, even through an allocator
+ * that returns NULL for zero-size requests, and parsing it fails cleanly.
+ *
+ * Build and run from the repository root:
+ *   cc -O2 -pthread -Iinc_pub test/elfparser_test_extnum.c src/elfparser_*.c -o test_extnum && ./test_extnum
+ */
+
+#include "elfparser_test_common.h"
+#include "../inc_pub/elfparser_symtable.h"
+
+#define TEST_FILLER_NUM   0xff10u  /**< Empty sections placed before the interesting ones */
+#define TEST_SYM_NUM      4u       /**< Symbols in the large image, including the null symbol */
+#define TEST_SHN_ABS      0xFFF1u  /**< Reserved index that must pass through unchanged */
+
+static const char test_strtab[] = "\0far\0near\0absolute";  /**< .strtab contents */
+
+/** @brief alloc_fn that returns NULL for zero-size requests, as malloc(0) may */
+static void *Test_strictAlloc(void *ctx, size_t size)
+{
+    (void)ctx;
+    return size ? malloc(size) : NULL;
+}
+
+/** @brief free_fn of the strict allocator */
+static void Test_strictFree(void *ctx, void *ptr)
+{
+    (void)ctx;
+    free(ptr);
+}
+
+/**
+ * @brief Checks that a header without section headers sets up an empty table
+ * @param[in] is_64bit Non-zero for ELFCLASS64
+ * @param[in] big_endian Non-zero for ELFDATA2MSB
+ */
+static void Test_noSections(int is_64bit, int big_endian)
+{
+    const elfparser_alloc_t strict = { Test_strictAlloc, Test_strictFree, NULL, 0 };
+    test_elf_t elf;
+    elfparser_header_t header = { 0 };
+    elfparser_secthead_t sect_head;
+
+    TEST_CHECK(Test_elfBuild(&elf, NULL, 0, is_64bit, big_endian, 0) == 0);
+    Test_store(elf.data + (is_64bit ? 40u : 32u), 0, is_64bit ? 8u : 4u, big_endian);  // e_shoff 0
+    Test_store(elf.data + (is_64bit ? 60u : 48u), 0, 2, big_endian);                   // e_shnum 0
+    Test_store(elf.data + (is_64bit ? 62u : 50u), 0, 2, big_endian);                   // e_shstrndx SHN_UNDEF
+    TEST_CHECK(ElfParser_Header_identParse(&header, elf.data, elf.size) == ELFPARSER_SUCCESS);
+    TEST_CHECK(ElfParser_Header_parse(&header, elf.data, elf.size) == ELFPARSER_SUCCESS);
+    TEST_CHECK(header.elf_section_header_entry_num == 0 && ElfParser_Header_extendedUsed(&header) == 0);
+
+    TEST_CHECK(ElfParser_SectHead_structSetupAlloc(&sect_head, &header, &strict) == ELFPARSER_SUCCESS);
+    TEST_CHECK(sect_head.table != NULL && sect_head.table_len == 0);
+    TEST_CHECK(ElfParser_SectHead_parse(&sect_head, elf.data, elf.size) == ELFPARSER_ERR_SIZE);  // Nothing to parse
+    TEST_CHECK(ElfParser_SectHead_free(&sect_head) == ELFPARSER_SUCCESS);
+    free(elf.data);
+}
+
+/**
+ * @brief Checks that a small image with escaped counts parses like a plain one
+ * @param[in] is_64bit Non-zero for ELFCLASS64
+ * @param[in] big_endian Non-zero for ELFDATA2MSB
+ */
+static void Test_smallExtended(int is_64bit, int big_endian)
+{
+    static const uint8_t text[8] = { 0xc3 };
+    const test_sect_t sects[] = {
+        { ".text", ELFPARSER_SECTHEAD_TYPE_PROGBITS, ELFPARSER_SECTHEAD_FLAG_ALLOC | ELFPARSER_SECTHEAD_FLAG_EXECINST, 0, 0, 0, text, sizeof(text) },
+    };
+    test_elf_t elf;
+    elfparser_header_t header = { 0 };
+    elfparser_secthead_t sect_head;
+
+    TEST_CHECK(Test_elfBuild(&elf, sects, 1, is_64bit, big_endian, TEST_ELF_FLAG_EXTENDED) == 0);
+    TEST_CHECK(ElfParser_Header_identParse(&header, elf.data, elf.size) == ELFPARSER_SUCCESS);
+    TEST_CHECK(ElfParser_Header_parseRaw(&header, elf.data, elf.size) == ELFPARSER_SUCCESS);
+    TEST_CHECK(header.elf_section_header_entry_num == 0 && header.elf_section_header_name_idx == TEST_SHN_XINDEX);
+    TEST_CHECK(ElfParser_Header_extendedUsed(&header) == 1);
+
+    const uint8_t *sect0 = elf.data + elf.sect_head_off;
+    TEST_CHECK(ElfParser_Header_extendedResolve(&header, NULL, 0) == ELFPARSER_ERR_NULL);
+    TEST_CHECK(ElfParser_Header_extendedResolve(&header, sect0, is_64bit ? 32u : 24u) == ELFPARSER_ERR_SIZE);  // Stops before sh_link
+    TEST_CHECK(ElfParser_Header_extendedResolve(&header, sect0, elf.size - elf.sect_head_off) == ELFPARSER_SUCCESS);
+    TEST_CHECK(header.elf_section_header_entry_num == elf.sect_num && header.elf_section_header_name_idx == elf.shstrtab_idx);
+
+    TEST_CHECK(Test_elfOpen(&header, &sect_head, &elf, NULL) == ELFPARSER_SUCCESS);  // Parse resolves on its own
+    TEST_CHECK(header.elf_section_header_entry_num == elf.sect_num && header.elf_section_header_name_idx == elf.shstrtab_idx);
+    TEST_CHECK(sect_head.table_len == elf.sect_num && sect_head.string_table_idx == elf.shstrtab_idx);
+    TEST_CHECK(sect_head.table[1].sh_name && strcmp(sect_head.table[1].sh_name, ".text") == 0);
+    TEST_CHECK(sect_head.table[elf.shstrtab_idx].sh_name && strcmp(sect_head.table[elf.shstrtab_idx].sh_name, ".shstrtab") == 0);
+    ElfParser_SectHead_free(&sect_head);
+    free(elf.data);
+}
+
+/**
+ * @brief Checks a symbol defined in a section past 0xff00 through SHT_SYMTAB_SHNDX
+ * @param[in] is_64bit Non-zero for ELFCLASS64
+ * @param[in] big_endian Non-zero for ELFDATA2MSB
+ */
+static void Test_largeShndx(int is_64bit, int big_endian)
+{
+    const uint32_t text_idx = TEST_FILLER_NUM + 1;  // Section 0 comes first
+    const uint32_t symtab_idx = text_idx + 1;
+    const uint32_t strtab_idx = text_idx + 2;
+    static const uint8_t text[8] = { 0xc3 };
+    uint8_t symtab[TEST_SYM_NUM * 24];
+    uint8_t shndx[TEST_SYM_NUM * 4] = { 0 };
+    size_t sym_size = Test_symEntrySize(is_64bit);
+
+    Test_symWrite(symtab, is_64bit, big_endian, 0, 0, 0, 0, 0);
+    Test_symWrite(symtab + sym_size, is_64bit, big_endian, 1, 0x12, TEST_SHN_XINDEX, 0x4000, 8);          // far
+    Test_symWrite(symtab + 2 * sym_size, is_64bit, big_endian, 5, 0x12, 1, 0x1000, 8);                    // near
+    Test_symWrite(symtab + 3 * sym_size, is_64bit, big_endian, 10, 0x10, TEST_SHN_ABS, 0x1234, 0);        // absolute
+    Test_store(shndx + 4, text_idx, 4, big_endian);  // Only the escaped symbol has a non-zero word
+
+    test_sect_t *sects = calloc(TEST_FILLER_NUM + 4, sizeof(*sects));
+    if (!sects)
+    {
+        TEST_CHECK(sects != NULL);
+        return;
+    }
+    for (uint32_t i = 0; i < TEST_FILLER_NUM; i++)
+    {
+        sects[i].type = ELFPARSER_SECTHEAD_TYPE_NOBITS;
+    }
+    sects[TEST_FILLER_NUM] = (test_sect_t){ ".text", ELFPARSER_SECTHEAD_TYPE_PROGBITS, ELFPARSER_SECTHEAD_FLAG_ALLOC, 0, 0, 0, text, sizeof(text) };
+    sects[TEST_FILLER_NUM + 1] = (test_sect_t){ ".symtab", ELFPARSER_SECTHEAD_TYPE_SYMTAB, 0, strtab_idx, 1, sym_size, symtab, TEST_SYM_NUM * sym_size };
+    sects[TEST_FILLER_NUM + 2] = (test_sect_t){ ".strtab", ELFPARSER_SECTHEAD_TYPE_STRINGTAB, 0, 0, 0, 0, test_strtab, sizeof(test_strtab) };
+    sects[TEST_FILLER_NUM + 3] = (test_sect_t){ ".symtab_shndx", ELFPARSER_SECTHEAD_TYPE_SYMTAB_SHNDX, 0, symtab_idx, 0, 4, shndx, sizeof(shndx) };
+
+    test_elf_t elf;
+    elfparser_header_t header;
+    elfparser_secthead_t sect_head;
+    elfparser_symtable_t symbol_table;
+    int built = Test_elfBuild(&elf, sects, TEST_FILLER_NUM + 4, is_64bit, big_endian, TEST_ELF_FLAG_EXTENDED);
+    free(sects);
+    TEST_CHECK(built == 0);
+    if (built < 0)
+    {
+        return;
+    }
+    TEST_CHECK(elf.sect_num > 0xff00u);
+
+    int ret = Test_elfOpen(&header, &sect_head, &elf, NULL);
+    TEST_CHECK(ret == ELFPARSER_SUCCESS);
+    if (ret < 0)
+    {
+        free(elf.data);
+        return;
+    }
+    TEST_CHECK(sect_head.table_len == elf.sect_num && sect_head.string_table_idx == elf.shstrtab_idx);
+    TEST_CHECK(sect_head.table[elf.shstrtab_idx].sh_name && strcmp(sect_head.table[elf.shstrtab_idx].sh_name, ".shstrtab") == 0);
+
+    int32_t shndx_idx = ElfParser_SectHead_byTypeFind(&sect_head, ELFPARSER_SECTHEAD_TYPE_SYMTAB_SHNDX, 0);
+    TEST_CHECK(shndx_idx == (int32_t)(strtab_idx + 1) && sect_head.table[shndx_idx].sh_link == symtab_idx);
+    const elfparser_secthead_entry_t *sym_sect = &sect_head.table[symtab_idx];
+    const elfparser_secthead_entry_t *shndx_sect = &sect_head.table[strtab_idx + 1];
+
+    TEST_CHECK(ElfParser_SymTable_structSetup(&symbol_table, &sect_head, symtab_idx, &header) == ELFPARSER_SUCCESS);
+    TEST_CHECK(ElfParser_SymTable_parse(&symbol_table, elf.data + sym_sect->sh_offset, sym_sect->sh_size) == ELFPARSER_SUCCESS);
+    TEST_CHECK(symbol_table.table[1].sym_sect_idx == ELFPARSER_SYMTABLE_SECT_XINDEX);
+
+    TEST_CHECK(ElfParser_SymTable_shndxResolve(&symbol_table, elf.data + shndx_sect->sh_offset, 4) == ELFPARSER_ERR_SIZE);  // Word of symbol 1 missing
+    TEST_CHECK(ElfParser_SymTable_shndxResolve(&symbol_table, elf.data + shndx_sect->sh_offset, shndx_sect->sh_size) == ELFPARSER_SUCCESS);
+    TEST_CHECK(symbol_table.table[1].sym_sect_idx == text_idx);
+    TEST_CHECK(strcmp(sect_head.table[symbol_table.table[1].sym_sect_idx].sh_name, ".text") == 0);
+    TEST_CHECK(symbol_table.table[2].sym_sect_idx == 1);             // Plain index untouched
+    TEST_CHECK(symbol_table.table[3].sym_sect_idx == TEST_SHN_ABS);  // Reserved index untouched
+    TEST_CHECK(symbol_table.table[0].sym_sect_idx == 0);
+
+    ElfParser_SymTable_free(&symbol_table);
+    ElfParser_SectHead_free(&sect_head);
+    free(elf.data);
+}
+
+int main(void)
+{
+    for (int layout = 0; layout < 4; layout++)  // 32/64-bit x little/big-endian
+    {
+        Test_smallExtended(layout & 1, layout >> 1);
+        Test_largeShndx(layout & 1, layout >> 1);
+        Test_noSections(layout & 1, layout >> 1);
+    }
+    return Test_report("test_extnum");
+}
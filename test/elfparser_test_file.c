@@ -0,0 +1,186 @@
+/**
+ * @file elfparser_test_file.c
+ * @brief Tests which reader ranges the file handle leaves pinned
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * Opens images through the pread backend, whose cached blocks count their
+ * pins, and checks the pin count after each getter. Section names are copied,
+ * so a successful ElfParser_File_sectHeadGet() leaves nothing pinned; a
+ * symbol table load keeps exactly its string table pinned because its names
+ * are views. A section name string table too short for its names, and a
+ * symbol string table cut the same way, must fail without leaving a pin, and
+ * retrying the failed getter must not take another one.
+ *
+ * Build and run from the repository root:
+ *   cc -O2 -pthread -Iinc_pub test/elfparser_test_file.c src/elfparser_*.c -o test_file && ./test_file
+ */
+
+#include <unistd.h>
+#include "elfparser_test_common.h"
+#include "../inc_pub/elfparser_file.h"
+#include "../inc_pub/elfparser_symtable.h"
+
+#define TEST_SYM_NUM        3u /**< Symbols in the test image, including the null symbol */
+#define TEST_SYMTAB_IDX     2u /**< Section index of .symtab */
+#define TEST_STRTAB_IDX     3u /**< Section index of .strtab */
+#define TEST_SHSTRTAB_IDX   4u /**< Section index of .shstrtab */
+
+static const char test_strtab[] = "\0main\0data";  /**< .strtab contents */
+
+/**
+ * @brief Counts the pins held on the cached blocks of a reader
+ * @param[in] file Open file structure
+ * @return uint32_t Sum of ref_num over all blocks
+ */
+static uint32_t Test_pinCount(const elfparser_file_t *file)
+{
+    uint32_t pins = 0;
+
+    for (uint32_t i = 0; i < file->reader.block_num; i++)
+    {
+        pins += file->reader.blocks[i].ref_num;
+    }
+    return pins;
+}
+
+/**
+ * @brief Writes an image to a temporary file and opens it
+ * @param[out] file File structure, released with ElfParser_File_close()
+ * @param[in] elf Image
+ * @param[in] flags ELFPARSER_FILE_FLAG_* values
+ * @return int Result of ElfParser_File_open(), ELFPARSER_ERR_IO if the image cannot be written
+ */
+static int Test_open(elfparser_file_t *file, const test_elf_t *elf, uint32_t flags)
+{
+    char path[] = "/tmp/elfparser_test_file.XXXXXX";
+    int fd = mkstemp(path);
+
+    if (fd < 0)
+    {
+        return ELFPARSER_ERR_IO;
+    }
+    int written = write(fd, elf->data, elf->size) == (ssize_t)elf->size;
+    close(fd);
+    int ret = written ? ElfParser_File_open(file, path, flags) : ELFPARSER_ERR_IO;
+    unlink(path);  // The open file keeps its contents
+    return ret;
+}
+
+/**
+ * @brief Shrinks sh_size of one section of an image
+ * @param[in,out] elf Image
+ * @param[in] sect_idx Section index
+ * @param[in] size New sh_size
+ * @param[in] is_64bit Non-zero for ELFCLASS64
+ * @param[in] big_endian Non-zero for ELFDATA2MSB
+ */
+static void Test_sizeSet(test_elf_t *elf, uint32_t sect_idx, uint64_t size, int is_64bit, int big_endian)
+{
+    size_t word = is_64bit ? 8u : 4u;
+    uint8_t *shdr = elf->data + elf->sect_head_off + (size_t)sect_idx * (is_64bit ? 64u : 40u);
+
+    Test_store(shdr + 8 + 3 * word, size, word, big_endian);
+}
+
+/**
+ * @brief Checks the pins of every getter on a well-formed image
+ * @param[in] elf Image
+ * @param[in] flags ELFPARSER_FILE_FLAG_* values
+ */
+static void Test_wellFormed(const test_elf_t *elf, uint32_t flags)
+{
+    elfparser_file_t file;
+    const elfparser_secthead_t *sect_head;
+    elfparser_symtable_t symbol_table;
+
+    TEST_CHECK(Test_open(&file, elf, flags) == ELFPARSER_SUCCESS);
+    TEST_CHECK(ElfParser_File_sectHeadGet(&file, &sect_head) == ELFPARSER_SUCCESS);
+    TEST_CHECK(Test_pinCount(&file) == 0);  // Names are copied
+    TEST_CHECK(sect_head->name_mode == ELFPARSER_NAME_MODE_ARENA);
+    TEST_CHECK(strcmp(sect_head->table[TEST_SYMTAB_IDX].sh_name, ".symtab") == 0);
+    TEST_CHECK(strcmp(sect_head->table[TEST_SHSTRTAB_IDX].sh_name, ".shstrtab") == 0);
+    TEST_CHECK(ElfParser_File_sectHeadGet(&file, &sect_head) == ELFPARSER_SUCCESS && Test_pinCount(&file) == 0);
+
+    TEST_CHECK(ElfParser_File_symTableLoad(&file, &symbol_table, TEST_SYMTAB_IDX) == ELFPARSER_SUCCESS);
+    TEST_CHECK(Test_pinCount(&file) == ((flags & ELFPARSER_FILE_FLAG_PREAD) ? 1u : 0u));  // Symbol names are views
+    TEST_CHECK(symbol_table.table_len == TEST_SYM_NUM && strcmp(symbol_table.table[2].sym_name, "data") == 0);
+    TEST_CHECK(ElfParser_SymTable_free(&symbol_table) == ELFPARSER_SUCCESS);
+    TEST_CHECK(ElfParser_File_close(&file) == ELFPARSER_SUCCESS);
+}
+
+/**
+ * @brief Checks that getters failing on a cut string table leave no pin behind
+ * @param[in] elf Well-formed image, copied before it is cut
+ * @param[in] is_64bit Non-zero for ELFCLASS64
+ * @param[in] big_endian Non-zero for ELFDATA2MSB
+ */
+static void Test_cutNames(const test_elf_t *elf, int is_64bit, int big_endian)
+{
+    test_elf_t cut = *elf;
+    elfparser_file_t file;
+    const elfparser_secthead_t *sect_head;
+    elfparser_symtable_t symbol_table;
+
+    cut.data = malloc(elf->size);
+    if (!cut.data)
+    {
+        TEST_CHECK(!"out of memory");
+        return;
+    }
+    memcpy(cut.data, elf->data, elf->size);
+    Test_sizeSet(&cut, TEST_SHSTRTAB_IDX, 4, is_64bit, big_endian);  // Inside ".text"
+    TEST_CHECK(Test_open(&file, &cut, ELFPARSER_FILE_FLAG_PREAD) == ELFPARSER_SUCCESS);
+    for (int attempt = 0; attempt < 3; attempt++)
+    {
+        TEST_CHECK(ElfParser_File_sectHeadGet(&file, &sect_head) == ELFPARSER_ERR_SIZE);
+        TEST_CHECK(Test_pinCount(&file) == 0);
+    }
+    TEST_CHECK(ElfParser_File_close(&file) == ELFPARSER_SUCCESS);
+
+    memcpy(cut.data, elf->data, elf->size);
+    Test_sizeSet(&cut, TEST_STRTAB_IDX, 3, is_64bit, big_endian);  // Inside "main"
+    TEST_CHECK(Test_open(&file, &cut, ELFPARSER_FILE_FLAG_PREAD) == ELFPARSER_SUCCESS);
+    for (int attempt = 0; attempt < 3; attempt++)
+    {
+        TEST_CHECK(ElfParser_File_symTableLoad(&file, &symbol_table, TEST_SYMTAB_IDX) == ELFPARSER_ERR_SIZE);
+        TEST_CHECK(Test_pinCount(&file) == 0);
+    }
+    TEST_CHECK(ElfParser_File_close(&file) == ELFPARSER_SUCCESS);
+    free(cut.data);
+}
+
+int main(void)
+{
+    static const uint8_t text[16] = { 0xc3 };
+    static const uint32_t name_idx[TEST_SYM_NUM] = { 0, 1, 6 };
+
+    for (int layout = 0; layout < 4; layout++)  // 32/64-bit x little/big-endian
+    {
+        int is_64bit = layout & 1;
+        int big_endian = layout >> 1;
+        uint8_t symtab[TEST_SYM_NUM * 24];
+        size_t sym_size = Test_symEntrySize(is_64bit);
+        for (uint32_t i = 0; i < TEST_SYM_NUM; i++)
+        {
+            Test_symWrite(symtab + i * sym_size, is_64bit, big_endian, name_idx[i], i ? 0x12 : 0, i ? 1 : 0, 0x1000 + i * 16, 16);
+        }
+        const test_sect_t sects[] = {
+            { ".text", ELFPARSER_SECTHEAD_TYPE_PROGBITS, ELFPARSER_SECTHEAD_FLAG_ALLOC | ELFPARSER_SECTHEAD_FLAG_EXECINST, 0, 0, 0, text, sizeof(text) },
+            { ".symtab", ELFPARSER_SECTHEAD_TYPE_SYMTAB, 0, TEST_STRTAB_IDX, 1, sym_size, symtab, TEST_SYM_NUM * sym_size },
+            { ".strtab", ELFPARSER_SECTHEAD_TYPE_STRINGTAB, 0, 0, 0, 0, test_strtab, sizeof(test_strtab) },
+        };
+        test_elf_t elf;
+        if (Test_elfBuild(&elf, sects, sizeof(sects) / sizeof(sects[0]), is_64bit, big_endian, 0) < 0)
+        {
+            fprintf(stderr, "out of memory\n");
+            return EXIT_FAILURE;
+        }
+        Test_wellFormed(&elf, ELFPARSER_FILE_FLAG_PREAD);
+        Test_wellFormed(&elf, ELFPARSER_FILE_FLAG_NONE);
+        Test_cutNames(&elf, is_64bit, big_endian);
+        free(elf.data);
+    }
+    return Test_report("test_file");
+}
@@ -0,0 +1,202 @@
+/**
+ * @file elfparser_test_namemode.c
+ * @brief Tests switching section and symbol names between owned, view and arena modes
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * Resolves the names of one table in every order of the three modes and
+ * checks after each step that the names are right, name_mode matches the
+ * last resolve and a counting allocator holds exactly the blocks that mode
+ * owns: the table plus one block per name when owned, the table plus one
+ * block in arena mode, the table alone for views. A view resolve that fails
+ * validation must leave the previous names in place.
+ *
+ * Build and run from the repository root:
+ *   cc -O2 -pthread -Iinc_pub test/elfparser_test_namemode.c src/elfparser_*.c -o test_namemode && ./test_namemode
+ */
+
+#include "elfparser_test_common.h"
+#include "../inc_pub/elfparser_symtable.h"
+
+#define TEST_SYM_NUM 4 /**< Symbols in the test image, including the null symbol */
+
+static const char test_strtab[] = "\0main\0helper_function\0data";                /**< .strtab contents */
+static const uint32_t test_sym_name_idx[TEST_SYM_NUM] = { 0, 1, 6, 22 };          /**< st_name of each symbol */
+static const char *const test_sym_name[TEST_SYM_NUM] = { "", "main", "helper_function", "data" };
+
+/**
+ * @brief Checks every section name against the names the image was built with
+ * @param[in] sect_head Section header table with resolved names
+ */
+static void Test_sectNamesCheck(const elfparser_secthead_t *sect_head)
+{
+    static const char *const names[] = { "", ".text", ".symtab", ".strtab", ".shstrtab" };
+
+    TEST_CHECK(sect_head->table_len == sizeof(names) / sizeof(names[0]));
+    for (uint32_t i = 0; i < sect_head->table_len && i < sizeof(names) / sizeof(names[0]); i++)
+    {
+        TEST_CHECK(sect_head->table[i].sh_name && strcmp(sect_head->table[i].sh_name, names[i]) == 0);
+        TEST_CHECK(sect_head->table[i].sh_name_len == strlen(names[i]));
+    }
+}
+
+/**
+ * @brief Checks every symbol name against the names the image was built with
+ * @param[in] symbol_table Symbol table with resolved names
+ */
+static void Test_symNamesCheck(const elfparser_symtable_t *symbol_table)
+{
+    TEST_CHECK(symbol_table->table_len == TEST_SYM_NUM);
+    for (uint32_t i = 0; i < symbol_table->table_len && i < TEST_SYM_NUM; i++)
+    {
+        TEST_CHECK(symbol_table->table[i].sym_name && strcmp(symbol_table->table[i].sym_name, test_sym_name[i]) == 0);
+        TEST_CHECK(symbol_table->table[i].sym_name_len == strlen(test_sym_name[i]));
+    }
+}
+
+/**
+ * @brief Walks the section header names through every mode transition
+ * @param[in] elf Test image
+ */
+static void Test_sectModes(const test_elf_t *elf)
+{
+    elfparser_alloc_t alloc;
+    test_alloc_count_t count;
+    elfparser_header_t header;
+    elfparser_secthead_t sect_head;
+
+    Test_countAllocInit(&alloc, &count);
+    TEST_CHECK(Test_elfOpen(&header, &sect_head, elf, &alloc) == ELFPARSER_SUCCESS);
+    const int64_t owned_live = 1 + (int64_t)sect_head.table_len;  // Table and one copy per name
+    const elfparser_secthead_entry_t *strtab = &sect_head.table[sect_head.string_table_idx];
+    const char *str_map = (const char *)elf->data + strtab->sh_offset;
+    const size_t str_size = strtab->sh_size;
+
+    TEST_CHECK(sect_head.name_mode == ELFPARSER_NAME_MODE_OWNED && count.live == owned_live);
+    Test_sectNamesCheck(&sect_head);
+
+    TEST_CHECK(ElfParser_SectHead_nameResolveView(&sect_head, str_map, str_size) == ELFPARSER_SUCCESS);  // Owned to view
+    TEST_CHECK(sect_head.name_mode == ELFPARSER_NAME_MODE_VIEW && count.live == 1);
+    TEST_CHECK(sect_head.table[1].sh_name == str_map + sect_head.table[1].sh_name_idx);
+    Test_sectNamesCheck(&sect_head);
+
+    TEST_CHECK(ElfParser_SectHead_nameResolve(&sect_head, str_map, str_size) == ELFPARSER_SUCCESS);  // View to owned
+    TEST_CHECK(sect_head.name_mode == ELFPARSER_NAME_MODE_OWNED && count.live == owned_live);
+    Test_sectNamesCheck(&sect_head);
+
+    TEST_CHECK(ElfParser_SectHead_nameResolveArena(&sect_head, str_map, str_size) == ELFPARSER_SUCCESS);  // Owned to arena
+    TEST_CHECK(sect_head.name_mode == ELFPARSER_NAME_MODE_ARENA && count.live == 2);
+    Test_sectNamesCheck(&sect_head);
+
+    TEST_CHECK(ElfParser_SectHead_nameResolveView(&sect_head, str_map, str_size) == ELFPARSER_SUCCESS);  // Arena to view
+    TEST_CHECK(sect_head.name_mode == ELFPARSER_NAME_MODE_VIEW && count.live == 1 && !sect_head.name_arena);
+
+    TEST_CHECK(ElfParser_SectHead_nameResolveArena(&sect_head, str_map, str_size) == ELFPARSER_SUCCESS);  // View to arena
+    TEST_CHECK(sect_head.name_mode == ELFPARSER_NAME_MODE_ARENA && count.live == 2);
+
+    TEST_CHECK(ElfParser_SectHead_nameResolve(&sect_head, str_map, str_size) == ELFPARSER_SUCCESS);  // Arena to owned
+    TEST_CHECK(sect_head.name_mode == ELFPARSER_NAME_MODE_OWNED && count.live == owned_live && !sect_head.name_arena);
+    Test_sectNamesCheck(&sect_head);
+
+    TEST_CHECK(ElfParser_SectHead_nameResolveView(&sect_head, str_map, strtab->sh_size - 1) == ELFPARSER_ERR_SIZE);  // Last name cut off
+    TEST_CHECK(sect_head.name_mode == ELFPARSER_NAME_MODE_OWNED && count.live == owned_live);
+    Test_sectNamesCheck(&sect_head);
+
+    TEST_CHECK(ElfParser_SectHead_free(&sect_head) == ELFPARSER_SUCCESS);
+    TEST_CHECK(count.live == 0);
+}
+
+/**
+ * @brief Walks the symbol names through every mode transition, including the parallel resolve
+ * @param[in] elf Test image
+ */
+static void Test_symModes(const test_elf_t *elf)
+{
+    elfparser_alloc_t alloc;
+    test_alloc_count_t count;
+    elfparser_header_t header;
+    elfparser_secthead_t sect_head;
+    elfparser_symtable_t symbol_table;
+
+    TEST_CHECK(Test_elfOpen(&header, &sect_head, elf, NULL) == ELFPARSER_SUCCESS);
+    int32_t sym_idx = ElfParser_SectHead_byTypeFind(&sect_head, ELFPARSER_SECTHEAD_TYPE_SYMTAB, 0);
+    TEST_CHECK(sym_idx > 0);
+    if (sym_idx <= 0)
+    {
+        ElfParser_SectHead_free(&sect_head);
+        return;
+    }
+    Test_countAllocInit(&alloc, &count);
+    const elfparser_secthead_entry_t *sym_sect = &sect_head.table[sym_idx];
+    TEST_CHECK(ElfParser_SymTable_structSetupAlloc(&symbol_table, &sect_head, (uint32_t)sym_idx, &header, &alloc) == ELFPARSER_SUCCESS);
+    TEST_CHECK(ElfParser_SymTable_parse(&symbol_table, elf->data + sym_sect->sh_offset, sym_sect->sh_size) == ELFPARSER_SUCCESS);
+    const elfparser_secthead_entry_t *strtab = &sect_head.table[symbol_table.string_table_idx];
+    const char *str_map = (const char *)elf->data + strtab->sh_offset;
+    const size_t str_size = strtab->sh_size;
+    const int64_t owned_live = 1 + TEST_SYM_NUM;  // Table and one copy per name
+
+    TEST_CHECK(ElfParser_SymTable_nameResolveArena(&symbol_table, str_map, str_size) == ELFPARSER_SUCCESS);
+    TEST_CHECK(symbol_table.name_mode == ELFPARSER_NAME_MODE_ARENA && count.live == 2);
+    Test_symNamesCheck(&symbol_table);
+
+    TEST_CHECK(ElfParser_SymTable_nameResolveParallel(&symbol_table, str_map, str_size, 2) == ELFPARSER_SUCCESS);  // Arena to owned
+    TEST_CHECK(symbol_table.name_mode == ELFPARSER_NAME_MODE_OWNED && count.live == owned_live && !symbol_table.name_arena);
+    Test_symNamesCheck(&symbol_table);
+
+    TEST_CHECK(ElfParser_SymTable_nameResolveView(&symbol_table, str_map, str_size) == ELFPARSER_SUCCESS);  // Owned to view
+    TEST_CHECK(symbol_table.name_mode == ELFPARSER_NAME_MODE_VIEW && count.live == 1);
+    Test_symNamesCheck(&symbol_table);
+
+    TEST_CHECK(ElfParser_SymTable_nameResolve(&symbol_table, str_map, str_size) == ELFPARSER_SUCCESS);  // View to owned
+    TEST_CHECK(symbol_table.name_mode == ELFPARSER_NAME_MODE_OWNED && count.live == owned_live);
+    Test_symNamesCheck(&symbol_table);
+
+    TEST_CHECK(ElfParser_SymTable_nameResolve(&symbol_table, str_map, str_size) == ELFPARSER_SUCCESS);  // Owned again
+    TEST_CHECK(count.live == owned_live);
+
+    TEST_CHECK(ElfParser_SymTable_nameResolveView(&symbol_table, str_map, str_size) == ELFPARSER_SUCCESS);
+    TEST_CHECK(ElfParser_SymTable_nameResolveParallel(&symbol_table, str_map, str_size, 2) == ELFPARSER_SUCCESS);  // View to owned
+    TEST_CHECK(symbol_table.name_mode == ELFPARSER_NAME_MODE_OWNED && count.live == owned_live);
+    Test_symNamesCheck(&symbol_table);
+
+    TEST_CHECK(ElfParser_SymTable_nameResolveView(&symbol_table, str_map, str_size - 1) == ELFPARSER_ERR_SIZE);  // Last name cut off
+    TEST_CHECK(symbol_table.name_mode == ELFPARSER_NAME_MODE_OWNED && count.live == owned_live);
+    Test_symNamesCheck(&symbol_table);
+
+    TEST_CHECK(ElfParser_SymTable_free(&symbol_table) == ELFPARSER_SUCCESS);
+    TEST_CHECK(count.live == 0);
+    ElfParser_SectHead_free(&sect_head);
+}
+
+int main(void)
+{
+    static const uint8_t text[16] = { 0xc3 };
+
+    for (int layout = 0; layout < 4; layout++)  // 32/64-bit x little/big-endian
+    {
+        int is_64bit = layout & 1;
+        int big_endian = layout >> 1;
+        uint8_t symtab[TEST_SYM_NUM * 24];
+        size_t sym_size = Test_symEntrySize(is_64bit);
+        for (uint32_t i = 0; i < TEST_SYM_NUM; i++)
+        {
+            Test_symWrite(symtab + i * sym_size, is_64bit, big_endian, test_sym_name_idx[i], i ? 0x12 : 0, i ? 1 : 0, 0x1000 + i * 16, 16);
+        }
+        const test_sect_t sects[] = {
+            { ".text", ELFPARSER_SECTHEAD_TYPE_PROGBITS, ELFPARSER_SECTHEAD_FLAG_ALLOC | ELFPARSER_SECTHEAD_FLAG_EXECINST, 0, 0, 0, text, sizeof(text) },
+            { ".symtab", ELFPARSER_SECTHEAD_TYPE_SYMTAB, 0, 3, 1, sym_size, symtab, TEST_SYM_NUM * sym_size },
+            { ".strtab", ELFPARSER_SECTHEAD_TYPE_STRINGTAB, 0, 0, 0, 0, test_strtab, sizeof(test_strtab) },
+        };
+        test_elf_t elf;
+        if (Test_elfBuild(&elf, sects, sizeof(sects) / sizeof(sects[0]), is_64bit, big_endian, 0) < 0)
+        {
+            fprintf(stderr, "out of memory\n");
+            return EXIT_FAILURE;
+        }
+        Test_sectModes(&elf);
+        Test_symModes(&elf);
+        free(elf.data);
+    }
+    return Test_report("test_namemode");
+}
@@ -0,0 +1,226 @@
+/**
+ * @file elfparser_test_proghead.c
+ * @brief Tests program header parsing and address translation through PT_LOAD segments
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * A hand-written table covers a short segment nested in a longer one, so an
+ * address past the short one must still resolve to the longer segment that
+ * starts before it, a zero-filled segment tail with no file bytes, ignored
+ * non-PT_LOAD entries and a segment ending at the top of the address
+ * space. Random tables of every size up to a few dozen segments are then
+ * checked key by key against a brute-force scan, in both classes and byte
+ * orders: the covering segment that starts last wins, equal starts going to
+ * the higher table index.
+ *
+ * Build and run from the repository root:
+ *   cc -O2 -pthread -Iinc_pub test/elfparser_test_proghead.c src/elfparser_*.c -o test_proghead && ./test_proghead
+ */
+
+#include "elfparser_test_common.h"
+#include "../inc_pub/elfparser_proghead.h"
+
+#define TEST_PHDR_SIZE_32BIT    32u   /**< Size of a 32-bit program header entry */
+#define TEST_PHDR_SIZE_64BIT    56u   /**< Size of a 64-bit program header entry */
+#define TEST_PHDR_MAX           40u   /**< Largest table */
+#define TEST_RAND_KEY_MAX       0x400u /**< Random segments and keys stay below this */
+#define TEST_RAND_ROUNDS        6u    /**< Random tables per size and layout */
+
+/**
+ * @brief One program header entry to encode
+ */
+typedef struct test_phdr_s
+{
+    uint32_t    type;     /**< p_type */
+    uint64_t    offset;   /**< p_offset */
+    uint64_t    vaddr;    /**< p_vaddr */
+    uint64_t    filesz;   /**< p_filesz */
+    uint64_t    memsz;    /**< p_memsz */
+} test_phdr_t;
+
+static uint64_t test_rand_state = 0x2545F4914F6CDD1Du;  /**< Generator state, fixed for repeatable runs */
+
+/**
+ * @brief Returns the next value of a 64-bit xorshift generator
+ * @return uint64_t Pseudo-random value
+ */
+static uint64_t Test_rand(void)
+{
+    test_rand_state ^= test_rand_state << 13;
+    test_rand_state ^= test_rand_state >> 7;
+    test_rand_state ^= test_rand_state << 17;
+    return test_rand_state;
+}
+
+/**
+ * @brief Encodes a program header table and parses it
+ * @param[out] prog_head Program header structure to fill, released with ElfParser_ProgHead_free()
+ * @param[in] phdrs Entries to encode
+ * @param[in] phdr_num Number of entries, at most TEST_PHDR_MAX
+ * @param[in] is_64bit Nonzero for ELFCLASS64
+ * @param[in] big_endian Nonzero for ELFDATA2MSB
+ * @return int Result of ElfParser_ProgHead_parse()
+ */
+static int Test_phdrParse(elfparser_proghead_t *prog_head, const test_phdr_t *phdrs, uint32_t phdr_num, int is_64bit, int big_endian)
+{
+    uint8_t map[TEST_PHDR_MAX * TEST_PHDR_SIZE_64BIT];
+    size_t entry_size = is_64bit ? TEST_PHDR_SIZE_64BIT : TEST_PHDR_SIZE_32BIT;
+    size_t word = is_64bit ? 8u : 4u;
+    elfparser_header_t header;
+
+    memset(map, 0, sizeof(map));
+    for (uint32_t i = 0; i < phdr_num; i++)
+    {
+        uint8_t *dst = map + i * entry_size;
+        const test_phdr_t *phdr = &phdrs[i];
+        Test_store(dst, phdr->type, 4, big_endian);
+        Test_store(dst + (is_64bit ? 0x08u : 0x04u), phdr->offset, word, big_endian);
+        Test_store(dst + (is_64bit ? 0x10u : 0x08u), phdr->vaddr, word, big_endian);
+        Test_store(dst + (is_64bit ? 0x18u : 0x0Cu), phdr->vaddr, word, big_endian);  // p_paddr
+        Test_store(dst + (is_64bit ? 0x20u : 0x10u), phdr->filesz, word, big_endian);
+        Test_store(dst + (is_64bit ? 0x28u : 0x14u), phdr->memsz, word, big_endian);
+    }
+
+    memset(&header, 0, sizeof(header));
+    header.elf_ident.elf_class = is_64bit ? ELFPARSER_HEADER_CLASS_64_BIT : ELFPARSER_HEADER_CLASS_32_BIT;
+    header.elf_ident.elf_data = big_endian ? ELFPARSER_HEADER_DATA_BIG_ENDIANNESS : ELFPARSER_HEADER_DATA_LITTLE_ENDIANNESS;
+    header.elf_program_header_entry_size = (uint16_t)entry_size;
+    header.elf_program_header_entry_num = phdr_num;
+    if (ElfParser_ProgHead_structSetup(prog_head, &header) != ELFPARSER_SUCCESS)
+    {
+        return ELFPARSER_ERR_MALLOC;
+    }
+    return ElfParser_ProgHead_parse(prog_head, map, phdr_num * entry_size);
+}
+
+/**
+ * @brief Finds the covering PT_LOAD segment by scanning every entry
+ * @param[in] phdrs Entries
+ * @param[in] phdr_num Number of entries
+ * @param[in] key Address or offset to look up
+ * @param[in] by_file Nonzero to look up a file offset, zero a virtual address
+ * @return int64_t Covering segment starting last, the higher index on equal starts, or ELFPARSER_ERR_NOT_FOUND
+ */
+static int64_t Test_refFind(const test_phdr_t *phdrs, uint32_t phdr_num, uint64_t key, int by_file)
+{
+    int64_t best = ELFPARSER_ERR_NOT_FOUND;
+
+    for (uint32_t i = 0; i < phdr_num; i++)
+    {
+        uint64_t start = by_file ? phdrs[i].offset : phdrs[i].vaddr;
+        uint64_t size = by_file ? phdrs[i].filesz : phdrs[i].memsz;
+        if (phdrs[i].type != ELFPARSER_PROGHEAD_TYPE_LOAD || key < start || key - start >= size)
+        {
+            continue;
+        }
+        if (best < 0 || start >= (by_file ? phdrs[best].offset : phdrs[best].vaddr))
+        {
+            best = i;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Checks the hand-written table in one class and byte order
+ * @param[in] is_64bit Nonzero for ELFCLASS64
+ * @param[in] big_endian Nonzero for ELFDATA2MSB
+ */
+static void Test_rules(int is_64bit, int big_endian)
+{
+    const uint64_t top = is_64bit ? UINT64_C(0xFFFFFFFFFFFFF000) : UINT64_C(0xFFFFF000);
+    const test_phdr_t phdrs[] = {
+        { ELFPARSER_PROGHEAD_TYPE_LOAD, 0x0000, 0x1000, 0x3000, 0x3000 },  // Long segment
+        { ELFPARSER_PROGHEAD_TYPE_LOAD, 0x0800, 0x1800, 0x0100, 0x0100 },  // Short one nested in it
+        { ELFPARSER_PROGHEAD_TYPE_NOTE, 0x5000, 0x5000, 0x1000, 0x1000 },  // Not loaded
+        { ELFPARSER_PROGHEAD_TYPE_LOAD, 0x5000, 0x6000, 0x1000, 0x2000 },  // Zero-filled tail
+        { ELFPARSER_PROGHEAD_TYPE_LOAD, 0x7000, top,    0x1000, 0x1000 },  // Last page of the address space
+    };
+    elfparser_proghead_t prog_head;
+    uint64_t out = 0;
+
+    TEST_CHECK(Test_phdrParse(&prog_head, phdrs, 5, is_64bit, big_endian) == ELFPARSER_SUCCESS);
+    TEST_CHECK(prog_head.vaddr_num == 4 && prog_head.offset_num == 4);
+
+    TEST_CHECK(ElfParser_ProgHead_vaddrFind(&prog_head, 0x0fff) == ELFPARSER_ERR_NOT_FOUND);
+    TEST_CHECK(ElfParser_ProgHead_vaddrFind(&prog_head, 0x1000) == 0);
+    TEST_CHECK(ElfParser_ProgHead_vaddrFind(&prog_head, 0x1850) == 1);
+    TEST_CHECK(ElfParser_ProgHead_vaddrFind(&prog_head, 0x1900) == 0);  // Past the short segment, inside the long one
+    TEST_CHECK(ElfParser_ProgHead_vaddrFind(&prog_head, 0x3fff) == 0);
+    TEST_CHECK(ElfParser_ProgHead_vaddrFind(&prog_head, 0x4000) == ELFPARSER_ERR_NOT_FOUND);
+    TEST_CHECK(ElfParser_ProgHead_vaddrFind(&prog_head, 0x5800) == ELFPARSER_ERR_NOT_FOUND);  // Only the PT_NOTE
+    TEST_CHECK(ElfParser_ProgHead_vaddrFind(&prog_head, 0x7fff) == 3);
+    TEST_CHECK(ElfParser_ProgHead_vaddrFind(&prog_head, 0x8000) == ELFPARSER_ERR_NOT_FOUND);
+    TEST_CHECK(ElfParser_ProgHead_vaddrFind(&prog_head, top + 0xfff) == 4);
+
+    TEST_CHECK(ElfParser_ProgHead_vaddrToOffset(&prog_head, 0x1900, &out) == ELFPARSER_SUCCESS && out == 0x0900);
+    TEST_CHECK(ElfParser_ProgHead_vaddrToOffset(&prog_head, 0x1850, &out) == ELFPARSER_SUCCESS && out == 0x0850);
+    TEST_CHECK(ElfParser_ProgHead_vaddrToOffset(&prog_head, 0x6800, &out) == ELFPARSER_SUCCESS && out == 0x5800);
+    TEST_CHECK(ElfParser_ProgHead_vaddrToOffset(&prog_head, 0x7800, &out) == ELFPARSER_ERR_NOT_FOUND);  // Zero-filled
+    TEST_CHECK(ElfParser_ProgHead_vaddrToOffset(&prog_head, top + 0x10, &out) == ELFPARSER_SUCCESS && out == 0x7010);
+
+    TEST_CHECK(ElfParser_ProgHead_offsetToVaddr(&prog_head, 0x0850, &out) == ELFPARSER_SUCCESS && out == 0x1850);
+    TEST_CHECK(ElfParser_ProgHead_offsetToVaddr(&prog_head, 0x0900, &out) == ELFPARSER_SUCCESS && out == 0x1900);
+    TEST_CHECK(ElfParser_ProgHead_offsetToVaddr(&prog_head, 0x2fff, &out) == ELFPARSER_SUCCESS && out == 0x3fff);
+    TEST_CHECK(ElfParser_ProgHead_offsetToVaddr(&prog_head, 0x3000, &out) == ELFPARSER_ERR_NOT_FOUND);
+    TEST_CHECK(ElfParser_ProgHead_offsetToVaddr(&prog_head, 0x5fff, &out) == ELFPARSER_SUCCESS && out == 0x6fff);
+    TEST_CHECK(ElfParser_ProgHead_offsetToVaddr(&prog_head, 0x7fff, &out) == ELFPARSER_SUCCESS && out == top + 0xfff);
+    TEST_CHECK(ElfParser_ProgHead_offsetToVaddr(&prog_head, 0x8000, &out) == ELFPARSER_ERR_NOT_FOUND);
+
+    TEST_CHECK(ElfParser_ProgHead_vaddrToOffset(&prog_head, 0x1000, NULL) == ELFPARSER_ERR_NULL);
+    TEST_CHECK(ElfParser_ProgHead_free(&prog_head) == ELFPARSER_SUCCESS);
+    TEST_CHECK(ElfParser_ProgHead_vaddrFind(&prog_head, 0x1000) == ELFPARSER_ERR_NULL);
+}
+
+/**
+ * @brief Checks random tables of one size against the brute-force scan
+ * @param[in] phdr_num Number of entries
+ * @param[in] is_64bit Nonzero for ELFCLASS64
+ * @param[in] big_endian Nonzero for ELFDATA2MSB
+ */
+static void Test_random(uint32_t phdr_num, int is_64bit, int big_endian)
+{
+    test_phdr_t phdrs[TEST_PHDR_MAX];
+    elfparser_proghead_t prog_head;
+
+    for (uint32_t i = 0; i < phdr_num; i++)
+    {
+        uint64_t r = Test_rand();
+        phdrs[i].type = (r % 8 == 0) ? 1u + (uint32_t)(r >> 3) % 6 : ELFPARSER_PROGHEAD_TYPE_LOAD;  // Mostly PT_LOAD
+        phdrs[i].vaddr = (r >> 8) % TEST_RAND_KEY_MAX;
+        phdrs[i].offset = (r >> 20) % TEST_RAND_KEY_MAX;
+        phdrs[i].memsz = ((r >> 32) & 1) ? (r >> 33) % 0x200 : (r >> 33) % 0x20;  // Long and short segments
+        phdrs[i].filesz = ((r >> 48) & 3) ? phdrs[i].memsz : phdrs[i].memsz / 2;
+    }
+    TEST_CHECK(Test_phdrParse(&prog_head, phdrs, phdr_num, is_64bit, big_endian) == ELFPARSER_SUCCESS);
+    for (uint64_t key = 0; key < TEST_RAND_KEY_MAX + 0x200; key++)
+    {
+        int64_t want = Test_refFind(phdrs, phdr_num, key, 0);
+        uint64_t out = 0;
+        TEST_CHECK(ElfParser_ProgHead_vaddrFind(&prog_head, key) == want);
+
+        want = Test_refFind(phdrs, phdr_num, key, 1);
+        int ret = ElfParser_ProgHead_offsetToVaddr(&prog_head, key, &out);
+        TEST_CHECK(want < 0 ? ret == ELFPARSER_ERR_NOT_FOUND : (ret == ELFPARSER_SUCCESS && out == phdrs[want].vaddr + (key - phdrs[want].offset)));
+    }
+    ElfParser_ProgHead_free(&prog_head);
+}
+
+int main(void)
+{
+    for (int layout = 0; layout < 4; layout++)
+    {
+        int is_64bit = layout & 1;
+        int big_endian = layout >> 1;
+        Test_rules(is_64bit, big_endian);
+        for (uint32_t phdr_num = 1; phdr_num <= TEST_PHDR_MAX; phdr_num++)
+        {
+            for (uint32_t round = 0; round < TEST_RAND_ROUNDS; round++)
+            {
+                Test_random(phdr_num, is_64bit, big_endian);
+            }
+        }
+    }
+    return Test_report("test_proghead");
+}
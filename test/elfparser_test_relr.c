@@ -0,0 +1,143 @@
+/**
+ * @file elfparser_test_relr.c
+ * @brief Tests SHT_RELR decoding against hand-expanded address and bitmap words
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * Each vector is a packed RELR section and the offsets it has to expand to.
+ * An even word is an address relocated on its own; an odd word is a bitmap
+ * whose bit i marks the word i - 1 places after the last relocated one, and
+ * each bitmap moves the base on by one word per bit it can hold.
+ *
+ * Build and run from the repository root:
+ *   cc -O2 -pthread -Iinc_pub test/elfparser_test_relr.c src/elfparser_*.c -o test_relr && ./test_relr
+ */
+
+#include "elfparser_test_common.h"
+#include "../inc_pub/elfparser_reloc.h"
+
+#define TEST_RELR_WORD_MAX   4u   /**< Most words in one vector */
+#define TEST_RELR_OFFSET_MAX 80u  /**< Most offsets one vector expands to */
+
+/**
+ * @brief One packed RELR section and its expansion
+ */
+typedef struct test_relr_s
+{
+    uint32_t    word_num;                          /**< Words in the section */
+    uint64_t    word[TEST_RELR_WORD_MAX];          /**< Section words, stored in the class word size */
+    uint32_t    offset_num;                        /**< Relocations the words expand to */
+    uint64_t    offset[TEST_RELR_OFFSET_MAX];      /**< Expected rel_offset values in order */
+} test_relr_t;
+
+/**
+ * @brief Decodes one vector and compares every entry with the expected expansion
+ * @param[in] vec Vector to check
+ * @param[in] is_64bit Non-zero for ELFCLASS64 (word size 8)
+ * @param[in] big_endian Non-zero for ELFDATA2MSB
+ */
+static void Test_relrCheck(const test_relr_t *vec, int is_64bit, int big_endian)
+{
+    const size_t word_size = is_64bit ? 8u : 4u;
+    uint8_t words[TEST_RELR_WORD_MAX * 8];
+    for (uint32_t i = 0; i < vec->word_num; i++)
+    {
+        Test_store(words + i * word_size, vec->word[i], word_size, big_endian);
+    }
+    const test_sect_t sects[] = {
+        { ".relr.dyn", ELFPARSER_SECTHEAD_TYPE_RELR, ELFPARSER_SECTHEAD_FLAG_ALLOC, 0, 0, word_size, words, vec->word_num * word_size },
+        { ".relr.bad", ELFPARSER_SECTHEAD_TYPE_RELR, ELFPARSER_SECTHEAD_FLAG_ALLOC, 0, 0, word_size * 2, words, vec->word_num * word_size },
+    };
+    test_elf_t elf;
+    elfparser_header_t header;
+    elfparser_secthead_t sect_head;
+    elfparser_reloc_t reloc;
+
+    if (Test_elfBuild(&elf, sects, sizeof(sects) / sizeof(sects[0]), is_64bit, big_endian, 0) < 0)
+    {
+        TEST_CHECK(!"image built");
+        return;
+    }
+    int ret = Test_elfOpen(&header, &sect_head, &elf, NULL);
+    TEST_CHECK(ret == ELFPARSER_SUCCESS);
+    if (ret < 0)
+    {
+        free(elf.data);
+        return;
+    }
+    TEST_CHECK(ElfParser_Reloc_structSetup(&reloc, &sect_head, 2, &header) < 0);  // Entry size is not one word
+
+    const elfparser_secthead_entry_t *relr = &sect_head.table[1];
+    TEST_CHECK(ElfParser_Reloc_structSetup(&reloc, &sect_head, 1, &header) == ELFPARSER_SUCCESS);
+    TEST_CHECK(reloc.table == NULL && reloc.sect_type == ELFPARSER_SECTHEAD_TYPE_RELR);
+    TEST_CHECK(ElfParser_Reloc_parse(&reloc, elf.data + relr->sh_offset, relr->sh_size) == ELFPARSER_SUCCESS);
+    TEST_CHECK(reloc.table_len == vec->offset_num);
+    for (uint32_t i = 0; i < reloc.table_len && i < vec->offset_num; i++)
+    {
+        TEST_CHECK(reloc.table[i].rel_offset == vec->offset[i]);
+        TEST_CHECK(reloc.table[i].rel_addend == 0 && reloc.table[i].rel_sym_idx == 0 && reloc.table[i].rel_type == 0);
+    }
+
+    elfparser_reloc_group_t group;
+    TEST_CHECK(ElfParser_Reloc_symGroup(&group, &reloc, 1) == ELFPARSER_SUCCESS);  // No symbols: one group holds all
+    TEST_CHECK(group.key_num == 1 && group.group_start[0] == 0 && group.group_start[1] == reloc.table_len);
+    ElfParser_Reloc_groupFree(&group);
+    if (reloc.table_len)
+    {
+        reloc.table[reloc.table_len - 1].rel_sym_idx = 0xFFFFFFFEu;  // Corrupt index is rejected, not used as a size
+        TEST_CHECK(ElfParser_Reloc_symGroup(&group, &reloc, 1) == ELFPARSER_ERR_RANGE);
+        TEST_CHECK(ElfParser_Reloc_symGroup(&group, &reloc, 0) == ELFPARSER_ERR_RANGE);
+    }
+    ElfParser_Reloc_free(&reloc);
+    ElfParser_SectHead_free(&sect_head);
+    free(elf.data);
+}
+
+int main(void)
+{
+    static const test_relr_t vec64[] = {
+        {   // Address, bitmap with bits 1 and 3, bitmap with only its top bit, address
+            4, { 0x10000u, 0xBu, (UINT64_C(1) << 63) | 1u, 0x20000u },
+            5, { 0x10000u, 0x10008u, 0x10018u, 0x103F0u, 0x20000u }
+        },
+        {   // Empty section
+            0, { 0 }, 0, { 0 }
+        },
+    };
+    static const test_relr_t vec32[] = {
+        {   // Address, bitmap with bits 1 and 2, bitmap with only its top bit
+            3, { 0x1000u, 0x7u, (UINT64_C(1) << 31) | 1u },
+            4, { 0x1000u, 0x1004u, 0x1008u, 0x10F8u }
+        },
+        {   // Bitmap straight after an address with no bit set moves the base only
+            3, { 0x2000u, 0x1u, 0x3u },
+            2, { 0x2000u, 0x2080u }
+        },
+    };
+    test_relr_t run64 = { 3, { 0x3000u, UINT64_MAX, 0x3u }, 65, { 0 } };  // Every bit set: 65 consecutive words
+    test_relr_t run32 = { 3, { 0x3000u, UINT32_MAX, 0x3u }, 33, { 0 } };
+    for (uint32_t i = 0; i < run64.offset_num; i++)
+    {
+        run64.offset[i] = 0x3000u + i * 8u;
+    }
+    for (uint32_t i = 0; i < run32.offset_num; i++)
+    {
+        run32.offset[i] = 0x3000u + i * 4u;
+    }
+
+    for (int big_endian = 0; big_endian < 2; big_endian++)
+    {
+        for (size_t i = 0; i < sizeof(vec64) / sizeof(vec64[0]); i++)
+        {
+            Test_relrCheck(&vec64[i], 1, big_endian);
+        }
+        for (size_t i = 0; i < sizeof(vec32) / sizeof(vec32[0]); i++)
+        {
+            Test_relrCheck(&vec32[i], 0, big_endian);
+        }
+        Test_relrCheck(&run64, 1, big_endian);
+        Test_relrCheck(&run32, 0, big_endian);
+    }
+    return Test_report("test_relr");
+}
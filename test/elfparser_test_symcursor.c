@@ -0,0 +1,231 @@
+/**
+ * @file elfparser_test_symcursor.c
+ * @brief Tests symbol cursor filters, batch boundaries and bad names
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * Walks a small symbol table with every batch size from one entry to more
+ * than the whole table and several type, binding and section filters, and
+ * checks that the walk yields exactly the passing entries, in table order,
+ * with the right names and indices. A second image gives two passing entries
+ * names outside the string table: each must come back as one
+ * ELFPARSER_ERR_SIZE after the entries before it, with the walk carrying on
+ * behind it, whatever the batch size.
+ *
+ * Build and run from the repository root:
+ *   cc -O2 -pthread -Iinc_pub test/elfparser_test_symcursor.c src/elfparser_*.c -o test_symcursor && ./test_symcursor
+ */
+
+#include "elfparser_test_common.h"
+#include "../inc_pub/elfparser_symcursor.h"
+
+#define TEST_SYM_NUM        8   /**< Symbols in the test image, including the null symbol */
+#define TEST_EVENT_MAX      32  /**< Most events one walk may produce */
+#define TEST_EVENT_ERR      -1  /**< Event recorded for an ELFPARSER_ERR_SIZE return */
+#define TEST_BAD_NAME_IDX   0x1000u /**< st_name past the end of the string table */
+
+/**
+ * @brief One symbol of the test image
+ */
+typedef struct test_sym_s
+{
+    uint32_t    name_idx;  /**< st_name */
+    const char* name;      /**< Name at name_idx */
+    uint8_t     type;      /**< Symbol type */
+    uint8_t     bind;      /**< Symbol binding */
+    uint16_t    shndx;     /**< st_shndx */
+} test_sym_t;
+
+/**
+ * @brief One filter setting of the cursor
+ */
+typedef struct test_filter_s
+{
+    uint16_t    type_mask;  /**< Accepted types */
+    uint16_t    bind_mask;  /**< Accepted bindings */
+    uint32_t    sect_idx;   /**< Accepted st_shndx */
+} test_filter_t;
+
+static const char test_strtab[] = "\0alpha\0beta\0gamma\0delta\0eps\0zeta\0eta";  /**< .strtab contents */
+static const test_sym_t test_sym[TEST_SYM_NUM] = {
+    {  0, "",      ELFPARSER_SYMTABLE_TYPE_NOTYPE, ELFPARSER_SYMTABLE_BIND_LOCAL,  0 },
+    {  1, "alpha", ELFPARSER_SYMTABLE_TYPE_FUNC,   ELFPARSER_SYMTABLE_BIND_GLOBAL, 1 },
+    {  7, "beta",  ELFPARSER_SYMTABLE_TYPE_OBJECT, ELFPARSER_SYMTABLE_BIND_LOCAL,  1 },
+    { 12, "gamma", ELFPARSER_SYMTABLE_TYPE_FUNC,   ELFPARSER_SYMTABLE_BIND_WEAK,   2 },
+    { 18, "delta", ELFPARSER_SYMTABLE_TYPE_FUNC,   ELFPARSER_SYMTABLE_BIND_GLOBAL, 1 },
+    { 24, "eps",   ELFPARSER_SYMTABLE_TYPE_OBJECT, ELFPARSER_SYMTABLE_BIND_GLOBAL, 2 },
+    { 28, "zeta",  ELFPARSER_SYMTABLE_TYPE_FUNC,   ELFPARSER_SYMTABLE_BIND_LOCAL,  1 },
+    { 33, "eta",   ELFPARSER_SYMTABLE_TYPE_NOTYPE, ELFPARSER_SYMTABLE_BIND_GLOBAL, 0 },
+};
+static const test_filter_t test_filter[] = {
+    { ELFPARSER_SYMCURSOR_ANY, ELFPARSER_SYMCURSOR_ANY, ELFPARSER_SYMCURSOR_SECT_ANY },
+    { ELFPARSER_SYMCURSOR_MASK(ELFPARSER_SYMTABLE_TYPE_FUNC), ELFPARSER_SYMCURSOR_ANY, ELFPARSER_SYMCURSOR_SECT_ANY },
+    { ELFPARSER_SYMCURSOR_ANY, ELFPARSER_SYMCURSOR_MASK(ELFPARSER_SYMTABLE_BIND_GLOBAL) | ELFPARSER_SYMCURSOR_MASK(ELFPARSER_SYMTABLE_BIND_WEAK),
+      ELFPARSER_SYMCURSOR_SECT_ANY },
+    { ELFPARSER_SYMCURSOR_MASK(ELFPARSER_SYMTABLE_TYPE_FUNC) | ELFPARSER_SYMCURSOR_MASK(ELFPARSER_SYMTABLE_TYPE_OBJECT),
+      ELFPARSER_SYMCURSOR_MASK(ELFPARSER_SYMTABLE_BIND_GLOBAL), 1 },
+    { ELFPARSER_SYMCURSOR_ANY, ELFPARSER_SYMCURSOR_ANY, 2 },
+    { ELFPARSER_SYMCURSOR_MASK(ELFPARSER_SYMTABLE_TYPE_OBJECT), ELFPARSER_SYMCURSOR_ANY, ELFPARSER_SYMCURSOR_SECT_ANY },
+    { ELFPARSER_SYMCURSOR_MASK(ELFPARSER_SYMTABLE_TYPE_TLS), ELFPARSER_SYMCURSOR_ANY, ELFPARSER_SYMCURSOR_SECT_ANY },
+};
+
+/**
+ * @brief Checks a symbol against a filter the way the cursor should
+ * @param[in] filter Filter setting
+ * @param[in] sym Symbol to check
+ * @return int 1 if the symbol passes, 0 otherwise
+ */
+static int Test_filterPass(const test_filter_t *filter, const test_sym_t *sym)
+{
+    return (filter->type_mask == ELFPARSER_SYMCURSOR_ANY || (filter->type_mask & ELFPARSER_SYMCURSOR_MASK(sym->type))) &&
+           (filter->bind_mask == ELFPARSER_SYMCURSOR_ANY || (filter->bind_mask & ELFPARSER_SYMCURSOR_MASK(sym->bind))) &&
+           (filter->sect_idx == ELFPARSER_SYMCURSOR_SECT_ANY || filter->sect_idx == sym->shndx);
+}
+
+/**
+ * @brief Walks a cursor to the end and records every returned index and error in order
+ * @param[in,out] cursor Open cursor with its filters set
+ * @param[in] batch_len Batch size of each call
+ * @param[in] bad Non-zero for the symbols whose names lie outside the string table
+ * @param[out] event Returned symbol indices, TEST_EVENT_ERR for each error
+ * @return uint32_t Number of events recorded
+ */
+static uint32_t Test_walk(elfparser_symcursor_t *cursor, size_t batch_len, const int *bad, int32_t *event)
+{
+    elfparser_symtable_entry_t batch[TEST_SYM_NUM + 2];
+    uint32_t sym_idx[TEST_SYM_NUM + 2];
+    uint32_t event_num = 0;
+
+    for (uint32_t call = 0; call < TEST_EVENT_MAX && event_num < TEST_EVENT_MAX; call++)
+    {
+        int64_t ret = ElfParser_SymCursor_next(cursor, batch, sym_idx, batch_len);
+        if (ret < 0)
+        {
+            TEST_CHECK(ret == ELFPARSER_ERR_SIZE);
+            event[event_num++] = TEST_EVENT_ERR;
+            continue;
+        }
+        if (ret == 0)
+        {
+            return event_num;
+        }
+        TEST_CHECK((size_t)ret <= batch_len);
+        for (int64_t k = 0; k < ret && event_num < TEST_EVENT_MAX; k++)
+        {
+            uint32_t idx = sym_idx[k];
+            TEST_CHECK(idx < TEST_SYM_NUM && !bad[idx]);
+            if (idx < TEST_SYM_NUM)
+            {
+                TEST_CHECK(batch[k].sym_name && strcmp(batch[k].sym_name, test_sym[idx].name) == 0);
+                TEST_CHECK(batch[k].sym_name_len == strlen(test_sym[idx].name));
+                TEST_CHECK(batch[k].sym_type == test_sym[idx].type && batch[k].sym_bind == test_sym[idx].bind);
+                TEST_CHECK(batch[k].sym_sect_idx == test_sym[idx].shndx);
+            }
+            event[event_num++] = (int32_t)idx;
+        }
+    }
+    TEST_CHECK(!"walk ended");
+    return event_num;
+}
+
+/**
+ * @brief Walks one image with every filter and batch size and compares the events with the expected ones
+ * @param[in] is_64bit Non-zero for ELFCLASS64
+ * @param[in] big_endian Non-zero for ELFDATA2MSB
+ * @param[in] bad Non-zero for the symbols given a name outside the string table
+ */
+static void Test_cursorCheck(int is_64bit, int big_endian, const int *bad)
+{
+    uint8_t symtab[TEST_SYM_NUM * 24];
+    size_t sym_size = Test_symEntrySize(is_64bit);
+    for (uint32_t i = 0; i < TEST_SYM_NUM; i++)
+    {
+        uint8_t info = (uint8_t)((test_sym[i].bind << 4) | test_sym[i].type);
+        uint32_t name_idx = bad[i] ? TEST_BAD_NAME_IDX : test_sym[i].name_idx;
+        Test_symWrite(symtab + i * sym_size, is_64bit, big_endian, name_idx, info, test_sym[i].shndx, 0x1000 + i * 16, 16);
+    }
+    const test_sect_t sects[] = {
+        { ".symtab", ELFPARSER_SECTHEAD_TYPE_SYMTAB, 0, 2, 1, sym_size, symtab, TEST_SYM_NUM * sym_size },
+        { ".strtab", ELFPARSER_SECTHEAD_TYPE_STRINGTAB, 0, 0, 0, 0, test_strtab, sizeof(test_strtab) },
+    };
+    test_elf_t elf;
+    elfparser_header_t header;
+    elfparser_secthead_t sect_head;
+    elfparser_symcursor_t cursor;
+
+    if (Test_elfBuild(&elf, sects, sizeof(sects) / sizeof(sects[0]), is_64bit, big_endian, 0) < 0)
+    {
+        TEST_CHECK(!"image built");
+        return;
+    }
+    int ret = Test_elfOpen(&header, &sect_head, &elf, NULL);
+    TEST_CHECK(ret == ELFPARSER_SUCCESS);
+    if (ret < 0)
+    {
+        free(elf.data);
+        return;
+    }
+    TEST_CHECK(ElfParser_SymCursor_open(&cursor, &sect_head, 2, elf.data, elf.size) == ELFPARSER_ERR_FORMAT);  // .strtab
+    TEST_CHECK(ElfParser_SymCursor_open(&cursor, &sect_head, sect_head.table_len, elf.data, elf.size) == ELFPARSER_ERR_RANGE);
+    TEST_CHECK(ElfParser_SymCursor_open(&cursor, &sect_head, 1, elf.data, elf.size / 2) == ELFPARSER_ERR_SIZE);
+
+    for (size_t f = 0; f < sizeof(test_filter) / sizeof(test_filter[0]); f++)
+    {
+        int32_t expect[TEST_EVENT_MAX];
+        uint32_t expect_num = 0;
+        for (uint32_t i = 0; i < TEST_SYM_NUM; i++)
+        {
+            if (Test_filterPass(&test_filter[f], &test_sym[i]))
+            {
+                expect[expect_num++] = bad[i] ? TEST_EVENT_ERR : (int32_t)i;
+            }
+        }
+        for (size_t batch_len = 1; batch_len <= TEST_SYM_NUM + 2; batch_len++)
+        {
+            int32_t event[TEST_EVENT_MAX];
+            TEST_CHECK(ElfParser_SymCursor_open(&cursor, &sect_head, 1, elf.data, elf.size) == ELFPARSER_SUCCESS);
+            TEST_CHECK(ElfParser_SymCursor_filterSet(&cursor, test_filter[f].type_mask, test_filter[f].bind_mask,
+                                                     test_filter[f].sect_idx) == ELFPARSER_SUCCESS);
+            uint32_t event_num = Test_walk(&cursor, batch_len, bad, event);
+            TEST_CHECK(event_num == expect_num && memcmp(event, expect, expect_num * sizeof(expect[0])) == 0);
+            TEST_CHECK(cursor.next_idx == TEST_SYM_NUM);
+            TEST_CHECK(ElfParser_SymCursor_next(&cursor, NULL, NULL, batch_len) == ELFPARSER_ERR_NULL);
+        }
+    }
+
+    elfparser_symtable_entry_t batch[TEST_SYM_NUM];
+    TEST_CHECK(ElfParser_SymCursor_open(&cursor, &sect_head, 1, elf.data, elf.size) == ELFPARSER_SUCCESS);
+    TEST_CHECK(ElfParser_SymCursor_seek(&cursor, TEST_SYM_NUM + 1) == ELFPARSER_ERR_RANGE);
+    TEST_CHECK(ElfParser_SymCursor_seek(&cursor, TEST_SYM_NUM - 2) == ELFPARSER_SUCCESS);
+    int last_bad = bad[TEST_SYM_NUM - 1];
+    TEST_CHECK(ElfParser_SymCursor_next(&cursor, batch, NULL, TEST_SYM_NUM) == (last_bad ? 1 : 2));  // Without index output
+    TEST_CHECK(strcmp(batch[0].sym_name, "zeta") == 0 && (last_bad || strcmp(batch[1].sym_name, "eta") == 0));
+    if (last_bad)
+    {
+        TEST_CHECK(ElfParser_SymCursor_next(&cursor, batch, NULL, TEST_SYM_NUM) == ELFPARSER_ERR_SIZE);
+        TEST_CHECK(ElfParser_SymCursor_seek(&cursor, TEST_SYM_NUM - 1) == ELFPARSER_SUCCESS);  // Seeking back reports it again
+        TEST_CHECK(ElfParser_SymCursor_next(&cursor, batch, NULL, TEST_SYM_NUM) == ELFPARSER_ERR_SIZE);
+    }
+    TEST_CHECK(ElfParser_SymCursor_next(&cursor, batch, NULL, TEST_SYM_NUM) == 0);
+    TEST_CHECK(ElfParser_SymCursor_seek(&cursor, TEST_SYM_NUM) == ELFPARSER_SUCCESS);
+    TEST_CHECK(ElfParser_SymCursor_next(&cursor, batch, NULL, TEST_SYM_NUM) == 0);
+
+    ElfParser_SectHead_free(&sect_head);
+    free(elf.data);
+}
+
+int main(void)
+{
+    static const int good[TEST_SYM_NUM] = { 0 };
+    static const int bad[TEST_SYM_NUM] = { 0, 0, 0, 1, 0, 0, 0, 1 };  // A weak function and the last symbol
+
+    for (int layout = 0; layout < 4; layout++)  // 32/64-bit x little/big-endian
+    {
+        int is_64bit = layout & 1;
+        int big_endian = layout >> 1;
+        Test_cursorCheck(is_64bit, big_endian, good);
+        Test_cursorCheck(is_64bit, big_endian, bad);
+    }
+    return Test_report("test_symcursor");
+}
@@ -0,0 +1,134 @@
+/**
+ * @file elfparser_test_symlink.c
+ * @brief Tests section lookups by type and symbol string tables found through sh_link
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * The image carries .symtab and .dynsym, each linked to its own string table
+ * with different names at the same offsets, so a table that picked the wrong
+ * string table would resolve the wrong names. ElfParser_SectHead_byTypeFind()
+ * is checked for hits, for walking every section of one type and for
+ * ELFPARSER_ERR_NOT_FOUND when no section has the type.
+ *
+ * Build and run from the repository root:
+ *   cc -O2 -pthread -Iinc_pub test/elfparser_test_symlink.c src/elfparser_*.c -o test_symlink && ./test_symlink
+ */
+
+#include "elfparser_test_common.h"
+#include "../inc_pub/elfparser_symtable.h"
+
+#define TEST_SYM_NUM 3u  /**< Symbols in each table, including the null symbol */
+
+static const char test_strtab[] = "\0local_a\0local_b";    /**< .strtab contents */
+static const char test_dynstr[] = "\0dyn_aaa\0dyn_bbb";    /**< .dynstr contents, names at the same offsets */
+
+/**
+ * @brief Sets up, parses and resolves one symbol table and checks its names
+ * @param[in] elf Test image
+ * @param[in] header Parsed header of the image
+ * @param[in] sect_head Parsed section header table of the image
+ * @param[in] sym_idx Index of the SHT_SYMTAB or SHT_DYNSYM section
+ * @param[in] str_idx Index of the string table the section links to
+ * @param[in] name1 Expected name of symbol 1
+ * @param[in] name2 Expected name of symbol 2
+ */
+static void Test_symLinkCheck(const test_elf_t *elf, const elfparser_header_t *header, const elfparser_secthead_t *sect_head,
+                              uint32_t sym_idx, uint32_t str_idx, const char *name1, const char *name2)
+{
+    elfparser_symtable_t symbol_table;
+    const elfparser_secthead_entry_t *sym_sect = &sect_head->table[sym_idx];
+
+    TEST_CHECK(ElfParser_SymTable_structSetup(&symbol_table, sect_head, sym_idx, header) == ELFPARSER_SUCCESS);
+    TEST_CHECK(symbol_table.string_table_idx == str_idx);
+    TEST_CHECK(ElfParser_SymTable_parse(&symbol_table, elf->data + sym_sect->sh_offset, sym_sect->sh_size) == ELFPARSER_SUCCESS);
+    const elfparser_secthead_entry_t *str_sect = &sect_head->table[symbol_table.string_table_idx];
+    TEST_CHECK(ElfParser_SymTable_nameResolve(&symbol_table, elf->data + str_sect->sh_offset, str_sect->sh_size) == ELFPARSER_SUCCESS);
+    TEST_CHECK(symbol_table.table_len == TEST_SYM_NUM);
+    TEST_CHECK(strcmp(symbol_table.table[1].sym_name, name1) == 0 && strcmp(symbol_table.table[2].sym_name, name2) == 0);
+    TEST_CHECK(ElfParser_SymTable_byNameFind(&symbol_table, name2, 0) == 2);
+    TEST_CHECK(ElfParser_SymTable_byNameFind(&symbol_table, name2, 3) < 0);  // Start past the end
+    ElfParser_SymTable_free(&symbol_table);
+}
+
+/**
+ * @brief Runs every check on one class and data encoding
+ * @param[in] is_64bit Non-zero for ELFCLASS64
+ * @param[in] big_endian Non-zero for ELFDATA2MSB
+ */
+static void Test_layoutCheck(int is_64bit, int big_endian)
+{
+    static const uint8_t text[16] = { 0xc3 };
+    const size_t sym_size = Test_symEntrySize(is_64bit);
+    uint8_t symtab[TEST_SYM_NUM * 24];
+    Test_symWrite(symtab, is_64bit, big_endian, 0, 0, 0, 0, 0);
+    Test_symWrite(symtab + sym_size, is_64bit, big_endian, 1, 0x12, 1, 0x1000, 8);
+    Test_symWrite(symtab + 2 * sym_size, is_64bit, big_endian, 9, 0x12, 1, 0x1010, 8);
+
+    const test_sect_t sects[] = {
+        { ".text", ELFPARSER_SECTHEAD_TYPE_PROGBITS, ELFPARSER_SECTHEAD_FLAG_ALLOC | ELFPARSER_SECTHEAD_FLAG_EXECINST, 0, 0, 0, text, sizeof(text) },
+        { ".dynstr", ELFPARSER_SECTHEAD_TYPE_STRINGTAB, ELFPARSER_SECTHEAD_FLAG_ALLOC, 0, 0, 0, test_dynstr, sizeof(test_dynstr) },
+        { ".dynsym", ELFPARSER_SECTHEAD_TYPE_DYNSYM, ELFPARSER_SECTHEAD_FLAG_ALLOC, 2, 1, sym_size, symtab, TEST_SYM_NUM * sym_size },
+        { ".symtab", ELFPARSER_SECTHEAD_TYPE_SYMTAB, 0, 5, 1, sym_size, symtab, TEST_SYM_NUM * sym_size },
+        { ".strtab", ELFPARSER_SECTHEAD_TYPE_STRINGTAB, 0, 0, 0, 0, test_strtab, sizeof(test_strtab) },
+        { ".bad_link", ELFPARSER_SECTHEAD_TYPE_SYMTAB, 0, 1, 1, sym_size, symtab, TEST_SYM_NUM * sym_size },  // Links to .text
+    };
+    test_elf_t elf;
+    elfparser_header_t header;
+    elfparser_secthead_t sect_head;
+    elfparser_symtable_t symbol_table;
+
+    if (Test_elfBuild(&elf, sects, sizeof(sects) / sizeof(sects[0]), is_64bit, big_endian, 0) < 0)
+    {
+        TEST_CHECK(!"image built");
+        return;
+    }
+    int ret = Test_elfOpen(&header, &sect_head, &elf, NULL);
+    TEST_CHECK(ret == ELFPARSER_SUCCESS);
+    if (ret < 0)
+    {
+        free(elf.data);
+        return;
+    }
+
+    TEST_CHECK(ElfParser_SectHead_byTypeFind(&sect_head, ELFPARSER_SECTHEAD_TYPE_DYNSYM, 0) == 3);
+    TEST_CHECK(ElfParser_SectHead_byTypeFind(&sect_head, ELFPARSER_SECTHEAD_TYPE_SYMTAB, 0) == 4);
+    TEST_CHECK(ElfParser_SectHead_byTypeFind(&sect_head, ELFPARSER_SECTHEAD_TYPE_SYMTAB, 4) == 4);  // Start is inclusive
+    TEST_CHECK(ElfParser_SectHead_byTypeFind(&sect_head, ELFPARSER_SECTHEAD_TYPE_SYMTAB, 5) == 6);
+    TEST_CHECK(ElfParser_SectHead_byTypeFind(&sect_head, ELFPARSER_SECTHEAD_TYPE_SYMTAB, 7) == ELFPARSER_ERR_NOT_FOUND);
+    TEST_CHECK(ElfParser_SectHead_byTypeFind(&sect_head, ELFPARSER_SECTHEAD_TYPE_NULL, 0) == 0);
+
+    uint32_t strtab_num = 0;  // .dynstr, .strtab and .shstrtab
+    int32_t idx = ElfParser_SectHead_byTypeFind(&sect_head, ELFPARSER_SECTHEAD_TYPE_STRINGTAB, 0);
+    while (idx >= 0)
+    {
+        TEST_CHECK(sect_head.table[idx].sh_type == ELFPARSER_SECTHEAD_TYPE_STRINGTAB);
+        strtab_num++;
+        idx = ElfParser_SectHead_byTypeFind(&sect_head, ELFPARSER_SECTHEAD_TYPE_STRINGTAB, (size_t)idx + 1);
+    }
+    TEST_CHECK(strtab_num == 3);
+    TEST_CHECK(idx == ELFPARSER_ERR_RANGE);  // .shstrtab is the last section, so the walk steps past the end
+
+    TEST_CHECK(ElfParser_SectHead_byTypeFind(&sect_head, ELFPARSER_SECTHEAD_TYPE_RELA, 0) == ELFPARSER_ERR_NOT_FOUND);  // Misses
+    TEST_CHECK(ElfParser_SectHead_byTypeFind(&sect_head, ELFPARSER_SECTHEAD_TYPE_GNU_HASH, 0) == ELFPARSER_ERR_NOT_FOUND);
+    TEST_CHECK(ElfParser_SectHead_byTypeFind(&sect_head, ELFPARSER_SECTHEAD_TYPE_DYNSYM, 4) == ELFPARSER_ERR_NOT_FOUND);
+    TEST_CHECK(ElfParser_SectHead_byTypeFind(&sect_head, ELFPARSER_SECTHEAD_TYPE_DYNSYM, sect_head.table_len) == ELFPARSER_ERR_RANGE);
+    TEST_CHECK(ElfParser_SectHead_byTypeFind(NULL, ELFPARSER_SECTHEAD_TYPE_DYNSYM, 0) == ELFPARSER_ERR_NULL);
+
+    Test_symLinkCheck(&elf, &header, &sect_head, 3, 2, "dyn_aaa", "dyn_bbb");   // .dynsym through .dynstr
+    Test_symLinkCheck(&elf, &header, &sect_head, 4, 5, "local_a", "local_b");   // .symtab through .strtab
+    TEST_CHECK(ElfParser_SymTable_structSetup(&symbol_table, &sect_head, 6, &header) == ELFPARSER_ERR_FORMAT);  // Link is not SHT_STRTAB
+    TEST_CHECK(ElfParser_SymTable_structSetup(&symbol_table, &sect_head, 2, &header) == ELFPARSER_ERR_FORMAT);  // Not a symbol table
+
+    ElfParser_SectHead_free(&sect_head);
+    free(elf.data);
+}
+
+int main(void)
+{
+    for (int layout = 0; layout < 4; layout++)  // 32/64-bit x little/big-endian
+    {
+        Test_layoutCheck(layout & 1, layout >> 1);
+    }
+    return Test_report("test_symlink");
+}
@@ -0,0 +1,754 @@
+/**
+ * @file elfparser_elfgen.c
+ * @brief Generator of synthetic ELF files for scaling and stress tests
+ * @author Domen Banfi
+ * @date 2025-03-16
+ * @version 1.0
+ *
+ * Writes a valid relocatable ELF file of any class and endianness with a
+ * chosen number of sections and symbols, so the parser can be run on inputs
+ * that are hard to find in the wild: tens of millions of symbols, more than
+ * 0xff00 sections (extended numbering and a .symtab_shndx section), big-endian
+ * 32-bit files, or string tables whose names share a long common prefix.
+ * Symbol name lengths follow a uniform or log-uniform distribution and a
+ * chosen fraction of symbols reuse the name of an earlier one. The same seed
+ * always produces the same file.
+ *
+ * The file is produced front to back in large sequential writes: .strtab,
+ * .symtab, .symtab_shndx, .shstrtab and the section header table are streamed
+ * through one buffer and only the ELF header is written last, in place. Only
+ * the st_name offsets (4 bytes per symbol) are kept in memory.
+ *
+ * Build and run from the repository root:
+ *   cc -O2 -Iinc_pub tools/elfparser_elfgen.c -o elfgen && ./elfgen -c 32 -e big -s 100000 -n 10000000 out.elf
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "../inc_pub/elfparser_header.h"
+#include "../inc_pub/elfparser_secthead.h"
+#include "../inc_pub/elfparser_symtable.h"
+
+#define GEN_BUF_SIZE        (8u << 20)  /**< Size of the write buffer, every write but the last two is this large */
+#define GEN_SECT_RESERVED   0xff00u     /**< SHN_LORESERVE: section counts and indices from here on need escapes */
+#define GEN_NAME_MAX        4096u       /**< Longest symbol name accepted */
+#define GEN_SECT_NAME_MAX   32u         /**< Room for one section name */
+#define GEN_LOCAL_SHARE     8u          /**< One symbol in this many is local */
+#define GEN_ADDR_BASE       0x400000u   /**< Address of the first filler section and symbol */
+
+/* Section indices of the fixed sections */
+#define GEN_IDX_SYMTAB      1u  /**< .symtab */
+#define GEN_IDX_STRTAB      2u  /**< .strtab */
+#define GEN_IDX_SHSTRTAB    3u  /**< .shstrtab */
+#define GEN_IDX_SHNDX       4u  /**< .symtab_shndx, present only with extended numbering */
+
+/**
+ * @brief Distribution of symbol name lengths
+ */
+typedef enum gen_dist_e
+{
+    GEN_DIST_UNIFORM = 0,   /**< Every length in [min, max] equally likely */
+    GEN_DIST_LOG            /**< Every power-of-two band in [min, max] equally likely, many short and few long names */
+} gen_dist_e;
+
+/**
+ * @brief Options of one generated file
+ */
+typedef struct gen_config_s
+{
+    int         is_64bit;   /**< Non-zero for ELFCLASS64 */
+    int         big_endian; /**< Non-zero for ELFDATA2MSB */
+    uint32_t    sect_num;   /**< Total number of sections, including the null section */
+    uint64_t    sym_num;    /**< Total number of symbols, including the null symbol */
+    uint32_t    name_min;   /**< Shortest symbol name */
+    uint32_t    name_max;   /**< Longest symbol name (names may grow past it to stay unique) */
+    gen_dist_e  name_dist;  /**< Distribution of name lengths */
+    double      dup_ratio;  /**< Fraction of symbols reusing an earlier symbol's name */
+    uint32_t    prefix_len; /**< Length of a prefix shared by all names (pathological for comparisons) */
+    uint64_t    seed;       /**< Generator seed */
+    const char* path;       /**< Output file */
+} gen_config_t;
+
+/**
+ * @brief Buffered sequential writer
+ */
+typedef struct gen_writer_s
+{
+    int         fd;     /**< Output file descriptor */
+    uint8_t*    buf;    /**< Write buffer of GEN_BUF_SIZE bytes */
+    size_t      used;   /**< Bytes pending in buf */
+    uint64_t    off;    /**< File offset of the next byte */
+    int         err;    /**< errno of the first failed write, 0 if none */
+} gen_writer_t;
+
+/**
+ * @brief Layout of the generated file
+ */
+typedef struct gen_layout_s
+{
+    size_t      word;           /**< Size of an address-sized field */
+    size_t      header_size;    /**< ELF header size */
+    size_t      sym_entry;      /**< Symbol table entry size */
+    size_t      sect_entry;     /**< Section header entry size */
+    int         extended;       /**< Non-zero if the section count needs extended numbering */
+    uint32_t    fixed_num;      /**< Number of fixed sections, including the null section */
+    uint32_t    local_num;      /**< Number of local symbols, including the null symbol */
+    uint64_t    strtab_off;     /**< .strtab offset */
+    uint64_t    strtab_size;    /**< .strtab size */
+    uint64_t    symtab_off;     /**< .symtab offset */
+    uint64_t    shndx_off;      /**< .symtab_shndx offset */
+    uint64_t    shstrtab_off;   /**< .shstrtab offset */
+    uint64_t    shstrtab_size;  /**< .shstrtab size */
+    uint64_t    shdr_off;       /**< Section header table offset */
+} gen_layout_t;
+
+/**
+ * @brief Advances a xorshift64 generator and returns the next value
+ * @param[in,out] state Generator state, must be non-zero
+ * @return uint64_t Next pseudo random value
+ */
+static inline uint64_t Gen_rand(uint64_t *state)
+{
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+/**
+ * @brief Mixes a counter into a well-spread value, for per-symbol fields that are regenerated later
+ * @param[in] x Value to mix
+ * @return uint64_t Mixed value (splitmix64 finalizer)
+ */
+static inline uint64_t Gen_mix(uint64_t x)
+{
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+/**
+ * @brief Stores an unsigned value with the given width and endianness
+ * @param[out] dst Destination bytes
+ * @param[in] value Value to store
+ * @param[in] size Width in bytes (at most 8)
+ * @param[in] big_endian Non-zero to store big-endian
+ */
+static inline void Gen_store(uint8_t *dst, uint64_t value, size_t size, int big_endian)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        dst[big_endian ? size - 1 - i : i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+/**
+ * @brief Writes the pending bytes of the buffer to the file
+ * @param[in,out] writer Pointer to the writer
+ */
+static void Gen_flush(gen_writer_t *writer)
+{
+    size_t done = 0;
+    while (done < writer->used && !writer->err)
+    {
+        ssize_t ret = write(writer->fd, writer->buf + done, writer->used - done);
+        if (ret < 0 && errno != EINTR)
+        {
+            writer->err = errno;
+        }
+        done += (ret > 0) ? (size_t)ret : 0;
+    }
+    writer->used = 0;
+}
+
+/**
+ * @brief Reserves room for size bytes in the buffer, flushing it if needed
+ * @param[in,out] writer Pointer to the writer
+ * @param[in] size Bytes to reserve (at most GEN_BUF_SIZE)
+ * @return uint8_t* Where to put the bytes; they count as written
+ */
+static inline uint8_t *Gen_reserve(gen_writer_t *writer, size_t size)
+{
+    if (writer->used + size > GEN_BUF_SIZE)
+    {
+        Gen_flush(writer);
+    }
+    uint8_t *dst = writer->buf + writer->used;
+    writer->used += size;
+    writer->off += size;
+    return dst;
+}
+
+/**
+ * @brief Writes zero bytes up to the next multiple of align
+ * @param[in,out] writer Pointer to the writer
+ * @param[in] align Alignment, a power of two
+ */
+static void Gen_align(gen_writer_t *writer, size_t align)
+{
+    size_t pad = (size_t)(-writer->off & (align - 1));
+    memset(Gen_reserve(writer, pad), 0, pad);
+}
+
+/**
+ * @brief Draws the length of the next name
+ * @param[in] config Pointer to the options
+ * @param[in,out] seed Generator state
+ * @return uint32_t Length in [name_min, name_max]
+ */
+static uint32_t Gen_nameLen(const gen_config_t *config, uint64_t *seed)
+{
+    uint32_t lo = config->name_min;
+    uint32_t hi = config->name_max;
+
+    if (config->name_dist == GEN_DIST_LOG && hi > 1)
+    {
+        uint32_t band_lo = 31u - (uint32_t)__builtin_clz(lo ? lo : 1);
+        uint32_t band_hi = 31u - (uint32_t)__builtin_clz(hi);
+        uint32_t band = band_lo + (uint32_t)(Gen_rand(seed) % (band_hi - band_lo + 1u));
+        uint32_t band_min = 1u << band;
+        uint32_t band_max = (band < 31u) ? (1u << (band + 1)) - 1u : UINT32_MAX;
+        lo = (band_min > lo) ? band_min : lo;
+        hi = (band_max < hi) ? band_max : hi;
+    }
+    return lo + (uint32_t)(Gen_rand(seed) % ((uint64_t)hi - lo + 1u));
+}
+
+/**
+ * @brief Writes one new, unique symbol name
+ *
+ * The name is the shared prefix, random identifier characters and a suffix
+ * encoding the unique id; it grows past the drawn length when the prefix and
+ * suffix alone are longer.
+ *
+ * @param[in,out] writer Pointer to the writer
+ * @param[in] config Pointer to the options
+ * @param[in] id Unique id of the name
+ * @param[in,out] seed Generator state
+ * @return size_t Bytes written, including the terminator
+ */
+static size_t Gen_nameWrite(gen_writer_t *writer, const gen_config_t *config, uint64_t id, uint64_t *seed)
+{
+    static const char body_chars[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_";
+    static const char prefix_chars[] = "_ZN4llvm6detail";
+    char suffix[24];
+    size_t suffix_len = 0;
+    uint32_t len = Gen_nameLen(config, seed);
+
+    suffix[suffix_len++] = '.';
+    do
+    {
+        suffix[suffix_len++] = "0123456789abcdefghijklmnopqrstuvwxyz"[id % 36u];
+        id /= 36u;
+    } while (id);
+    size_t body_len = (len > config->prefix_len + suffix_len) ? len - config->prefix_len - suffix_len : 0;
+    size_t total = config->prefix_len + body_len + suffix_len + 1u;
+    uint8_t *dst = Gen_reserve(writer, total);
+
+    for (uint32_t i = 0; i < config->prefix_len; i++)
+    {
+        *dst++ = (uint8_t)prefix_chars[i % (sizeof(prefix_chars) - 1u)];
+    }
+    for (size_t i = 0; i < body_len; i++)
+    {
+        *dst++ = (uint8_t)body_chars[Gen_rand(seed) % (sizeof(body_chars) - 1u)];
+    }
+    memcpy(dst, suffix, suffix_len);
+    dst[suffix_len] = '\0';
+    return total;
+}
+
+/**
+ * @brief Returns the section index of a symbol, derived from its index so later passes can recompute it
+ * @param[in] layout Pointer to the layout
+ * @param[in] config Pointer to the options
+ * @param[in] sym_idx Symbol index
+ * @return uint32_t Section index, ELFPARSER_SYMTABLE_SECT_ABS if there are no filler sections
+ */
+static uint32_t Gen_symSect(const gen_layout_t *layout, const gen_config_t *config, uint64_t sym_idx)
+{
+    uint32_t filler_num = config->sect_num - layout->fixed_num;
+    if (sym_idx == 0)
+    {
+        return ELFPARSER_SYMTABLE_SECT_UNDEF;
+    }
+    return filler_num ? layout->fixed_num + (uint32_t)(Gen_mix(sym_idx) % filler_num) : ELFPARSER_SYMTABLE_SECT_ABS;
+}
+
+/**
+ * @brief Writes .strtab and records the st_name of every symbol
+ * @param[in,out] writer Pointer to the writer
+ * @param[in] config Pointer to the options
+ * @param[out] name_off Array of sym_num st_name values
+ * @return int 0 on success, -1 if the string table outgrows 32-bit offsets
+ */
+static int Gen_strTabWrite(gen_writer_t *writer, const gen_config_t *config, uint32_t *name_off)
+{
+    uint64_t seed = config->seed;
+    uint64_t dup_bound = (config->dup_ratio >= 1.0) ? UINT64_MAX : (uint64_t)(config->dup_ratio * 18446744073709551616.0);
+    uint64_t size = 1;
+    uint64_t distinct = 0;
+
+    *Gen_reserve(writer, 1) = '\0';  // Index 0 is the empty name
+    name_off[0] = 0;
+    for (uint64_t i = 1; i < config->sym_num; i++)
+    {
+        if (i > 1 && Gen_rand(&seed) < dup_bound)
+        {
+            name_off[i] = name_off[1u + Gen_rand(&seed) % (i - 1u)];  // Reuse the name of an earlier symbol
+            continue;
+        }
+        if (size > UINT32_MAX)
+        {
+            return -1;
+        }
+        name_off[i] = (uint32_t)size;
+        size += Gen_nameWrite(writer, config, distinct++, &seed);
+    }
+    return (size > UINT32_MAX) ? -1 : 0;
+}
+
+/**
+ * @brief Writes .symtab
+ * @param[in,out] writer Pointer to the writer
+ * @param[in] layout Pointer to the layout
+ * @param[in] config Pointer to the options
+ * @param[in] name_off Array of sym_num st_name values
+ */
+static void Gen_symTabWrite(gen_writer_t *writer, const gen_layout_t *layout, const gen_config_t *config, const uint32_t *name_off)
+{
+    int be = config->big_endian;
+
+    for (uint64_t i = 0; i < config->sym_num; i++)
+    {
+        uint8_t *dst = Gen_reserve(writer, layout->sym_entry);
+        uint64_t bits = Gen_mix(i ^ config->seed);
+        uint32_t sect = Gen_symSect(layout, config, i);
+        uint64_t value = i ? GEN_ADDR_BASE + i * 16u : 0;
+        uint64_t size = i ? bits % 256u : 0;
+        uint8_t bind = (i < layout->local_num) ? ELFPARSER_SYMTABLE_BIND_LOCAL
+                     : (bits >> 60) ? ELFPARSER_SYMTABLE_BIND_GLOBAL : ELFPARSER_SYMTABLE_BIND_WEAK;
+        uint8_t type = ((bits >> 8) & 1u) ? ELFPARSER_SYMTABLE_TYPE_FUNC : ELFPARSER_SYMTABLE_TYPE_OBJECT;
+        uint8_t info = i ? (uint8_t)((bind << 4) | type) : 0;
+        uint16_t shndx = (layout->extended && sect >= GEN_SECT_RESERVED) ? ELFPARSER_SYMTABLE_SECT_XINDEX : (uint16_t)sect;
+
+        Gen_store(dst, name_off[i], 4, be);                 // st_name
+        if (config->is_64bit)
+        {
+            dst[4] = info;                                  // st_info
+            dst[5] = ELFPARSER_SYMTABLE_VISIBILITY_DEFAULT; // st_other
+            Gen_store(dst + 6, shndx, 2, be);               // st_shndx
+            Gen_store(dst + 8, value, 8, be);               // st_value
+            Gen_store(dst + 16, size, 8, be);               // st_size
+        }
+        else
+        {
+            Gen_store(dst + 4, value, 4, be);               // st_value
+            Gen_store(dst + 8, size, 4, be);                // st_size
+            dst[12] = info;                                 // st_info
+            dst[13] = ELFPARSER_SYMTABLE_VISIBILITY_DEFAULT; // st_other
+            Gen_store(dst + 14, shndx, 2, be);              // st_shndx
+        }
+    }
+}
+
+/**
+ * @brief Writes .symtab_shndx, the full section index of every symbol
+ * @param[in,out] writer Pointer to the writer
+ * @param[in] layout Pointer to the layout
+ * @param[in] config Pointer to the options
+ */
+static void Gen_shndxWrite(gen_writer_t *writer, const gen_layout_t *layout, const gen_config_t *config)
+{
+    for (uint64_t i = 0; i < config->sym_num; i++)
+    {
+        uint32_t sect = Gen_symSect(layout, config, i);
+        Gen_store(Gen_reserve(writer, 4), (sect >= GEN_SECT_RESERVED) ? sect : 0, 4, config->big_endian);  // 0 unless st_shndx escapes
+    }
+}
+
+/**
+ * @brief Writes the name of section idx into dst
+ * @param[out] dst Buffer of GEN_SECT_NAME_MAX bytes
+ * @param[in] layout Pointer to the layout
+ * @param[in] idx Section index
+ * @return size_t Name length including the terminator
+ */
+static size_t Gen_sectName(char *dst, const gen_layout_t *layout, uint32_t idx)
+{
+    static const char *const fixed[] = { "", ".symtab", ".strtab", ".shstrtab", ".symtab_shndx" };
+    if (idx < layout->fixed_num)
+    {
+        return (size_t)snprintf(dst, GEN_SECT_NAME_MAX, "%s", fixed[idx]) + 1u;
+    }
+    return (size_t)snprintf(dst, GEN_SECT_NAME_MAX, ".text.f%" PRIu32, idx - layout->fixed_num) + 1u;
+}
+
+/**
+ * @brief Writes .shstrtab; section names are stored in index order
+ * @param[in,out] writer Pointer to the writer
+ * @param[in] layout Pointer to the layout
+ * @param[in] config Pointer to the options
+ * @return uint64_t Size of .shstrtab
+ */
+static uint64_t Gen_shStrTabWrite(gen_writer_t *writer, const gen_layout_t *layout, const gen_config_t *config)
+{
+    char name[GEN_SECT_NAME_MAX];
+    uint64_t size = 0;
+
+    for (uint32_t i = 0; i < config->sect_num; i++)
+    {
+        size_t len = Gen_sectName(name, layout, i);
+        memcpy(Gen_reserve(writer, len), name, len);
+        size += len;
+    }
+    return size;
+}
+
+/**
+ * @brief Writes one section header entry
+ * @param[in,out] writer Pointer to the writer
+ * @param[in] layout Pointer to the layout
+ * @param[in] config Pointer to the options
+ * @param[in] fields sh_name, sh_type, sh_flags, sh_addr, sh_offset, sh_size, sh_link, sh_info, sh_addralign, sh_entsize
+ */
+static void Gen_sectWrite(gen_writer_t *writer, const gen_layout_t *layout, const gen_config_t *config, const uint64_t fields[10])
+{
+    static const uint8_t wide[10] = { 0, 0, 1, 1, 1, 1, 0, 0, 1, 1 };  // Address-sized fields
+    uint8_t *dst = Gen_reserve(writer, layout->sect_entry);
+
+    for (int i = 0; i < 10; i++)
+    {
+        size_t size = wide[i] ? layout->word : 4u;
+        Gen_store(dst, fields[i], size, config->big_endian);
+        dst += size;
+    }
+}
+
+/**
+ * @brief Writes the section header table
+ * @param[in,out] writer Pointer to the writer
+ * @param[in] layout Pointer to the layout
+ * @param[in] config Pointer to the options
+ */
+static void Gen_sectHeadWrite(gen_writer_t *writer, const gen_layout_t *layout, const gen_config_t *config)
+{
+    char name[GEN_SECT_NAME_MAX];
+    uint64_t name_idx = 0;
+    uint64_t word = layout->word;
+
+    for (uint32_t i = 0; i < config->sect_num; i++)
+    {
+        uint64_t f[10] = { name_idx, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+        name_idx += Gen_sectName(name, layout, i);
+        switch (i)
+        {
+            case 0:
+                f[5] = layout->extended ? config->sect_num : 0;  // Real e_shnum
+                break;
+            case GEN_IDX_SYMTAB:
+                f[1] = ELFPARSER_SECTHEAD_TYPE_SYMTAB;
+                f[4] = layout->symtab_off;
+                f[5] = config->sym_num * layout->sym_entry;
+                f[6] = GEN_IDX_STRTAB;
+                f[7] = layout->local_num;  // First non-local symbol
+                f[8] = word;
+                f[9] = layout->sym_entry;
+                break;
+            case GEN_IDX_STRTAB:
+            case GEN_IDX_SHSTRTAB:
+                f[1] = ELFPARSER_SECTHEAD_TYPE_STRINGTAB;
+                f[4] = (i == GEN_IDX_STRTAB) ? layout->strtab_off : layout->shstrtab_off;
+                f[5] = (i == GEN_IDX_STRTAB) ? layout->strtab_size : layout->shstrtab_size;
+                f[8] = 1;
+                break;
+            default:
+                if (layout->extended && i == GEN_IDX_SHNDX)
+                {
+                    f[1] = ELFPARSER_SECTHEAD_TYPE_SYMTAB_SHNDX;
+                    f[4] = layout->shndx_off;
+                    f[5] = config->sym_num * 4u;
+                    f[6] = GEN_IDX_SYMTAB;
+                    f[8] = 4;
+                    f[9] = 4;
+                }
+                else
+                {
+                    f[1] = ELFPARSER_SECTHEAD_TYPE_NOBITS;  // Empty filler, contents would only cost disk
+                    f[2] = ELFPARSER_SECTHEAD_FLAG_ALLOC | ELFPARSER_SECTHEAD_FLAG_EXECINST;
+                    f[3] = GEN_ADDR_BASE + (uint64_t)(i - layout->fixed_num) * 16u;
+                    f[4] = layout->shdr_off;
+                    f[8] = 16;
+                }
+                break;
+        }
+        Gen_sectWrite(writer, layout, config, f);
+    }
+}
+
+/**
+ * @brief Builds the ELF header
+ * @param[out] dst Buffer of layout->header_size bytes
+ * @param[in] layout Pointer to the layout
+ * @param[in] config Pointer to the options
+ */
+static void Gen_headerBuild(uint8_t *dst, const gen_layout_t *layout, const gen_config_t *config)
+{
+    static const uint16_t machine[2][2] = { { 3, 20 }, { 62, 21 } };  // EM_386, EM_PPC; EM_X86_64, EM_PPC64
+    int be = config->big_endian;
+    size_t word = layout->word;
+    size_t tail = 24u + 3u * word + 4u;  // e_ehsize
+
+    memset(dst, 0, layout->header_size);
+    memcpy(dst, "\x7f" "ELF", 4);
+    dst[4] = config->is_64bit ? ELFPARSER_HEADER_CLASS_64_BIT : ELFPARSER_HEADER_CLASS_32_BIT;
+    dst[5] = be ? ELFPARSER_HEADER_DATA_BIG_ENDIANNESS : ELFPARSER_HEADER_DATA_LITTLE_ENDIANNESS;
+    dst[6] = 1;                                                             // EI_VERSION
+    Gen_store(dst + 16, ELFPARSER_HEADER_TYPE_REL, 2, be);                  // e_type
+    Gen_store(dst + 18, machine[config->is_64bit != 0][be != 0], 2, be);    // e_machine
+    Gen_store(dst + 20, 1, 4, be);                                          // e_version
+    Gen_store(dst + 24 + 2 * word, layout->shdr_off, word, be);             // e_shoff
+    Gen_store(dst + tail, layout->header_size, 2, be);                      // e_ehsize
+    Gen_store(dst + tail + 6, layout->sect_entry, 2, be);                   // e_shentsize
+    Gen_store(dst + tail + 8, layout->extended ? 0 : config->sect_num, 2, be); // e_shnum, 0 escapes to section 0
+    Gen_store(dst + tail + 10, GEN_IDX_SHSTRTAB, 2, be);                    // e_shstrndx
+}
+
+/**
+ * @brief Streams the file contents and writes the ELF header last
+ * @param[in,out] writer Pointer to a writer on the open output file
+ * @param[in,out] layout Pointer to the layout, offsets are filled in as the sections are written
+ * @param[in] config Pointer to the options
+ * @param[out] name_off Array of sym_num st_name values
+ * @return int 0 on success, 1 on failure (reported on stderr)
+ */
+static int Gen_contentsWrite(gen_writer_t *writer, gen_layout_t *layout, const gen_config_t *config, uint32_t *name_off)
+{
+    uint8_t header[ELFPARSER_HEADER_SIZE_64BIT];
+
+    memset(Gen_reserve(writer, layout->header_size), 0, layout->header_size);  // Written for real once the layout is known
+    layout->strtab_off = writer->off;
+    if (Gen_strTabWrite(writer, config, name_off) != 0)
+    {
+        fprintf(stderr, "%s: string table exceeds 4 GiB, use fewer or shorter names\n", config->path);
+        return 1;
+    }
+    layout->strtab_size = writer->off - layout->strtab_off;
+    Gen_align(writer, layout->word);
+    layout->symtab_off = writer->off;
+    Gen_symTabWrite(writer, layout, config, name_off);
+    if (layout->extended)
+    {
+        layout->shndx_off = writer->off;
+        Gen_shndxWrite(writer, layout, config);
+    }
+    layout->shstrtab_off = writer->off;
+    layout->shstrtab_size = Gen_shStrTabWrite(writer, layout, config);
+    Gen_align(writer, layout->word);
+    layout->shdr_off = writer->off;
+    if (!config->is_64bit && layout->shdr_off + (uint64_t)config->sect_num * layout->sect_entry > UINT32_MAX)
+    {
+        fprintf(stderr, "%s: file exceeds 4 GiB, which ELFCLASS32 cannot address\n", config->path);
+        return 1;
+    }
+    Gen_sectHeadWrite(writer, layout, config);
+    Gen_flush(writer);
+
+    Gen_headerBuild(header, layout, config);
+    if (!writer->err && pwrite(writer->fd, header, layout->header_size, 0) != (ssize_t)layout->header_size)
+    {
+        writer->err = errno ? errno : EIO;
+    }
+    if (writer->err)
+    {
+        fprintf(stderr, "%s: %s\n", config->path, strerror(writer->err));
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Generates the file
+ * @param[in] config Pointer to the options
+ * @return int 0 on success, 1 on failure (reported on stderr)
+ */
+static int Gen_fileWrite(const gen_config_t *config)
+{
+    gen_writer_t writer = { -1, NULL, 0, 0, 0 };
+    gen_layout_t layout = { 0 };
+    int ret = 1;
+
+    layout.word = config->is_64bit ? 8u : 4u;
+    layout.header_size = config->is_64bit ? ELFPARSER_HEADER_SIZE_64BIT : ELFPARSER_HEADER_SIZE_32BIT;
+    layout.sym_entry = config->is_64bit ? 24u : 16u;
+    layout.sect_entry = config->is_64bit ? 64u : 40u;
+    layout.extended = config->sect_num >= GEN_SECT_RESERVED;
+    layout.fixed_num = layout.extended ? GEN_IDX_SHNDX + 1u : GEN_IDX_SHSTRTAB + 1u;
+    layout.local_num = (uint32_t)(1u + (config->sym_num - 1u) / GEN_LOCAL_SHARE);
+    if (config->sect_num < layout.fixed_num)
+    {
+        fprintf(stderr, "%s: at least %" PRIu32 " sections are needed\n", config->path, layout.fixed_num);
+        return 1;
+    }
+
+    uint32_t *name_off = malloc(config->sym_num * sizeof(uint32_t));
+    writer.buf = malloc(GEN_BUF_SIZE);
+    if (!name_off || !writer.buf)
+    {
+        fprintf(stderr, "%s: out of memory\n", config->path);
+    }
+    else if ((writer.fd = open(config->path, O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0)
+    {
+        fprintf(stderr, "%s: %s\n", config->path, strerror(errno));
+    }
+    else
+    {
+        ret = Gen_contentsWrite(&writer, &layout, config, name_off);
+        if (close(writer.fd) != 0 && ret == 0)
+        {
+            fprintf(stderr, "%s: %s\n", config->path, strerror(errno));
+            ret = 1;
+        }
+    }
+    if (ret == 0)
+    {
+        printf("%s: %" PRIu64 " bytes, %" PRIu32 " sections, %" PRIu64 " symbols, .strtab %" PRIu64 " bytes\n",
+               config->path, writer.off, config->sect_num, config->sym_num, layout.strtab_size);
+    }
+    free(writer.buf);
+    free(name_off);
+    return ret;
+}
+
+/**
+ * @brief Prints the usage text
+ * @param[in] prog Program name
+ */
+static void Gen_usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [options] output.elf\n"
+            "  -c 32|64          ELF class (default 64)\n"
+            "  -e little|big     endianness (default little)\n"
+            "  -s N              sections, including the null section (default 16)\n"
+            "  -n N              symbols, including the null symbol (default 1000)\n"
+            "  -l MIN:MAX        symbol name length range (default 8:64)\n"
+            "  -d uniform|log    name length distribution (default log)\n"
+            "  -r RATIO          fraction of symbols reusing an earlier name, 0 to 1 (default 0)\n"
+            "  -p N              prefix shared by all names, N characters (default 0)\n"
+            "  -S SEED           generator seed (default 1)\n", prog);
+}
+
+int main(int argc, char **argv)
+{
+    gen_config_t config = { 1, 0, 16u, 1000u, 8u, 64u, GEN_DIST_LOG, 0.0, 0u, 1u, NULL };
+    int opt;
+
+    while ((opt = getopt(argc, argv, "c:e:s:n:l:d:r:p:S:h")) != -1)
+    {
+        char *end = NULL;
+        unsigned long long num = 0;
+        switch (opt)
+        {
+            case 'c':
+                config.is_64bit = (strcmp(optarg, "64") == 0);
+                if (!config.is_64bit && strcmp(optarg, "32") != 0)
+                {
+                    Gen_usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'e':
+                config.big_endian = (strcmp(optarg, "big") == 0);
+                if (!config.big_endian && strcmp(optarg, "little") != 0)
+                {
+                    Gen_usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 's':
+                num = strtoull(optarg, &end, 0);
+                if (*end || num == 0 || num > UINT32_MAX)
+                {
+                    Gen_usage(argv[0]);
+                    return 1;
+                }
+                config.sect_num = (uint32_t)num;
+                break;
+            case 'n':
+                num = strtoull(optarg, &end, 0);
+                if (*end || num == 0 || num > SIZE_MAX / sizeof(uint32_t))
+                {
+                    Gen_usage(argv[0]);
+                    return 1;
+                }
+                config.sym_num = num;
+                break;
+            case 'l':
+                if (sscanf(optarg, "%" SCNu32 ":%" SCNu32, &config.name_min, &config.name_max) != 2 ||
+                    config.name_min > config.name_max || config.name_max > GEN_NAME_MAX)
+                {
+                    Gen_usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'd':
+                config.name_dist = (strcmp(optarg, "uniform") == 0) ? GEN_DIST_UNIFORM : GEN_DIST_LOG;
+                if (config.name_dist == GEN_DIST_LOG && strcmp(optarg, "log") != 0)
+                {
+                    Gen_usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'r':
+                config.dup_ratio = strtod(optarg, &end);
+                if (*end || !(config.dup_ratio >= 0.0 && config.dup_ratio <= 1.0))
+                {
+                    Gen_usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'p':
+                num = strtoull(optarg, &end, 0);
+                if (*end || num > GEN_NAME_MAX)
+                {
+                    Gen_usage(argv[0]);
+                    return 1;
+                }
+                config.prefix_len = (uint32_t)num;
+                break;
+            case 'S':
+                config.seed = strtoull(optarg, &end, 0);
+                config.seed = config.seed ? config.seed : 1u;  // xorshift needs a non-zero state
+                break;
+            default:
+                Gen_usage(argv[0]);
+                return 1;
+        }
+    }
+    if (optind != argc - 1)
+    {
+        Gen_usage(argv[0]);
+        return 1;
+    }
+    config.path = argv[optind];
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    int ret = Gen_fileWrite(&config);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    if (ret == 0)
+    {
+        printf("written in %.2f s\n", (double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) / 1e9);
+    }
+    return ret;
+}